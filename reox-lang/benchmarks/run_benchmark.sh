@@ -78,3 +78,5 @@ echo ""
 echo "========================================"
 echo "       Benchmark Complete"
 echo "========================================"
+echo "Runtime suite (state, layout, bridge, particles, images, strings, FFI):"
+echo "  make -C benchmarks/runtime run"
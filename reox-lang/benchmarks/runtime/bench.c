@@ -0,0 +1,258 @@
+/*
+ * REOX Runtime Benchmarks - Driver
+ * Calibration, sampling, JSON output and baseline comparison
+ *
+ * Usage: reox_bench [--filter TEXT] [--json FILE|-] [--baseline FILE]
+ *                   [--threshold PCT] [--samples N] [--min-time MS] [--list]
+ *
+ * Exits 1 when --baseline is given and a case got slower than the
+ * threshold (default 10%).
+ */
+
+#include "bench.h"
+#include "reox_runloop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_CASES 256
+#define BENCH_NAME_MAX 96
+
+typedef struct bench_case {
+    char name[BENCH_NAME_MAX];
+    int64_t param;
+    rx_bench_fn fn;
+} bench_case;
+
+typedef struct bench_result {
+    const bench_case* c;
+    uint64_t iterations;        /* Ops per sample */
+    uint64_t items;
+    double median_ns;           /* Per op */
+    double min_ns;
+    double max_ns;
+} bench_result;
+
+static bench_case cases[BENCH_MAX_CASES];
+static size_t case_count;
+
+void rx_bench_add(const char* suite, const char* name, int64_t param, rx_bench_fn fn) {
+    if (case_count == BENCH_MAX_CASES) {
+        fprintf(stderr, "reox_bench: too many cases, %s/%s dropped\n", suite, name);
+        return;
+    }
+    bench_case* c = &cases[case_count++];
+    snprintf(c->name, sizeof(c->name), "%s/%s/%lld", suite, name, (long long)param);
+    c->param = param;
+    c->fn = fn;
+}
+
+void rx_bench_start(rx_bench* b) {
+    b->start_ns = rx_clock_ns();
+}
+
+void rx_bench_stop(rx_bench* b) {
+    b->elapsed_ns += rx_clock_ns() - b->start_ns;
+}
+
+/* ============================================================================
+ * Measurement
+ * ============================================================================ */
+
+static uint64_t bench_run(const bench_case* c, uint64_t n, uint64_t* items) {
+    rx_bench b = { n, c->param, 0, 0, 0 };
+    c->fn(&b);
+    if (items) *items = b.items;
+    return b.elapsed_ns;
+}
+
+static int double_cmp(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+static bench_result bench_measure(const bench_case* c, int samples, uint64_t sample_ns) {
+    /* Grow n until one sample takes sample_ns */
+    uint64_t n = 1;
+    uint64_t elapsed = bench_run(c, n, NULL);
+    while (elapsed < sample_ns && n < (1ULL << 40)) {
+        uint64_t grow = elapsed > 0 ? (uint64_t)((double)sample_ns * 1.2 / (double)elapsed) : 100;
+        if (grow < 2) grow = 2;
+        if (grow > 100) grow = 100;
+        n *= grow;
+        elapsed = bench_run(c, n, NULL);
+    }
+
+    double per_op[64];
+    if (samples > 64) samples = 64;
+    bench_result r = { c, n, 0, 0, 0, 0 };
+    for (int i = 0; i < samples; i++) {
+        per_op[i] = (double)bench_run(c, n, &r.items) / (double)n;
+    }
+    qsort(per_op, (size_t)samples, sizeof(double), double_cmp);
+    r.median_ns = per_op[samples / 2];
+    r.min_ns = per_op[0];
+    r.max_ns = per_op[samples - 1];
+    return r;
+}
+
+/* ============================================================================
+ * Output
+ * ============================================================================ */
+
+static void print_row(FILE* out, const bench_result* r) {
+    fprintf(out, "%-44s %14.1f ns/op", r->c->name, r->median_ns);
+    if (r->items > 0) fprintf(out, " %10.2f ns/item", r->median_ns / (double)r->items);
+    fprintf(out, "   (min %.1f, max %.1f)\n", r->min_ns, r->max_ns);
+}
+
+static bool write_json(const char* path, const bench_result* results, size_t count) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out) return false;
+    fprintf(out, "{\n  \"suite\": \"reox-runtime\",\n  \"version\": 1,\n  \"results\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const bench_result* r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f, "
+                     "\"iterations\": %llu, \"items_per_op\": %llu}%s\n",
+                r->c->name, r->median_ns, r->min_ns, r->max_ns,
+                (unsigned long long)r->iterations, (unsigned long long)r->items,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    return out == stdout ? fflush(out) == 0 : fclose(out) == 0;
+}
+
+/* ============================================================================
+ * Baseline Comparison
+ * ============================================================================ */
+
+typedef struct baseline_entry {
+    char name[BENCH_NAME_MAX];
+    double ns_per_op;
+} baseline_entry;
+
+/* Reads the one-result-per-line layout written by write_json */
+static size_t read_baseline(const char* path, baseline_entry* out, size_t max) {
+    FILE* in = fopen(path, "r");
+    if (!in) return 0;
+    char line[512];
+    size_t count = 0;
+    while (count < max && fgets(line, sizeof(line), in)) {
+        const char* name = strstr(line, "\"name\": \"");
+        const char* ns = strstr(line, "\"ns_per_op\": ");
+        if (!name || !ns) continue;
+        name += 9;
+        const char* end = strchr(name, '"');
+        if (!end || (size_t)(end - name) >= BENCH_NAME_MAX) continue;
+        memcpy(out[count].name, name, (size_t)(end - name));
+        out[count].name[end - name] = '\0';
+        out[count].ns_per_op = strtod(ns + 13, NULL);
+        count++;
+    }
+    fclose(in);
+    return count;
+}
+
+static int compare_baseline(const char* path, const bench_result* results, size_t count, double threshold) {
+    static baseline_entry base[BENCH_MAX_CASES];
+    size_t base_count = read_baseline(path, base, BENCH_MAX_CASES);
+    if (base_count == 0) {
+        fprintf(stderr, "reox_bench: no results in %s\n", path);
+        return 1;
+    }
+
+    int regressions = 0;
+    fprintf(stderr, "\n%-44s %14s %14s %9s\n", "Case", "Baseline", "Current", "Change");
+    for (size_t i = 0; i < count; i++) {
+        const bench_result* r = &results[i];
+        const baseline_entry* b = NULL;
+        for (size_t k = 0; k < base_count; k++) {
+            if (strcmp(base[k].name, r->c->name) == 0) { b = &base[k]; break; }
+        }
+        if (!b || b->ns_per_op <= 0) {
+            fprintf(stderr, "%-44s %14s %14.1f %9s\n", r->c->name, "-", r->median_ns, "new");
+            continue;
+        }
+        double change = (r->median_ns - b->ns_per_op) / b->ns_per_op * 100.0;
+        bool slower = change > threshold;
+        regressions += slower;
+        fprintf(stderr, "%-44s %14.1f %14.1f %+8.1f%%%s\n", r->c->name, b->ns_per_op,
+                r->median_ns, change, slower ? "  REGRESSION" : "");
+    }
+    fprintf(stderr, "%d regression(s) beyond %.0f%%\n", regressions, threshold);
+    return regressions > 0;
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+static void usage(void) {
+    fprintf(stderr, "usage: reox_bench [--filter TEXT] [--json FILE|-] [--baseline FILE]\n"
+                    "                  [--threshold PCT] [--samples N] [--min-time MS] [--list]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* filter = NULL;
+    const char* json = NULL;
+    const char* baseline = NULL;
+    double threshold = 10.0;
+    int samples = 7;
+    double min_time_ms = 20.0;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "--list") == 0) { list = true; continue; }
+        if (!v) { usage(); return 2; }
+        if (strcmp(a, "--filter") == 0) filter = v;
+        else if (strcmp(a, "--json") == 0) json = v;
+        else if (strcmp(a, "--baseline") == 0) baseline = v;
+        else if (strcmp(a, "--threshold") == 0) threshold = atof(v);
+        else if (strcmp(a, "--samples") == 0) samples = atoi(v);
+        else if (strcmp(a, "--min-time") == 0) min_time_ms = atof(v);
+        else { usage(); return 2; }
+        i++;
+    }
+    if (samples < 1) samples = 1;
+
+    bench_register_state();
+    bench_register_layout();
+    bench_register_bridge();
+    bench_register_particles();
+    bench_register_image();
+    bench_register_string();
+    bench_register_ffi();
+    bench_register_headless();
+    bench_register_gestures();
+    bench_register_a11y();
+    bench_register_lighting();
+    bench_register_blur();
+    bench_register_transition();
+    bench_register_desktop();
+
+    if (list) {
+        for (size_t i = 0; i < case_count; i++) puts(cases[i].name);
+        return 0;
+    }
+
+    /* The table goes to stderr when JSON takes stdout */
+    FILE* table = json && strcmp(json, "-") == 0 ? stderr : stdout;
+    static bench_result results[BENCH_MAX_CASES];
+    size_t count = 0;
+    for (size_t i = 0; i < case_count; i++) {
+        if (filter && !strstr(cases[i].name, filter)) continue;
+        results[count] = bench_measure(&cases[i], samples, (uint64_t)(min_time_ms * 1e6));
+        print_row(table, &results[count]);
+        fflush(table);
+        count++;
+    }
+
+    if (json && !write_json(json, results, count)) {
+        fprintf(stderr, "reox_bench: cannot write %s\n", json);
+        return 2;
+    }
+    if (baseline) return compare_baseline(baseline, results, count, threshold);
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * REOX Runtime Benchmarks
+ * Harness shared by the benchmark suites
+ *
+ * Features:
+ * - Cases registered by name with an integer parameter (state count, tree
+ *   size, ...); names are "suite/case/param" and never change meaning
+ * - Iteration count calibrated per case, then several timed samples;
+ *   reports the median, fastest and slowest ns per op
+ * - Per-item cost for cases whose op touches many items (a layout pass
+ *   over 10k views, a particle update over 4k particles)
+ * - JSON output with fixed key order, one result per line, and comparison
+ *   against a previous run's JSON
+ *
+ * A case does its setup, brackets the measured loop with
+ * rx_bench_start/rx_bench_stop and runs b->n ops in between:
+ *
+ *     static void bench_get(rx_bench* b) {
+ *         setup(b->param);
+ *         rx_bench_start(b);
+ *         for (uint64_t i = 0; i < b->n; i++) work(i);
+ *         rx_bench_stop(b);
+ *         teardown();
+ *     }
+ */
+
+#ifndef REOX_BENCH_H
+#define REOX_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct rx_bench {
+    uint64_t n;                 /* Ops to run between start and stop */
+    int64_t param;              /* From registration */
+    uint64_t items;             /* Items per op, 0 if not meaningful */
+    uint64_t start_ns;
+    uint64_t elapsed_ns;
+} rx_bench;
+
+typedef void (*rx_bench_fn)(rx_bench* b);
+
+extern void rx_bench_add(const char* suite, const char* name, int64_t param, rx_bench_fn fn);
+
+extern void rx_bench_start(rx_bench* b);
+extern void rx_bench_stop(rx_bench* b);
+
+/* Keep a result alive so the compiler cannot drop the work producing it */
+static inline void rx_bench_keep(const void* p) {
+    __asm__ volatile("" : : "r"(p) : "memory");
+}
+
+static inline void rx_bench_keep_int(int64_t v) {
+    __asm__ volatile("" : : "r"(v) : "memory");
+}
+
+/* Deterministic input data: same sequence on every run */
+static inline uint32_t rx_bench_rand(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/* Suites */
+extern void bench_register_state(void);
+extern void bench_register_layout(void);
+extern void bench_register_bridge(void);
+extern void bench_register_particles(void);
+extern void bench_register_image(void);
+extern void bench_register_string(void);
+extern void bench_register_ffi(void);
+extern void bench_register_headless(void);
+extern void bench_register_gestures(void);
+extern void bench_register_a11y(void);
+extern void bench_register_lighting(void);
+extern void bench_register_blur(void);
+extern void bench_register_transition(void);
+extern void bench_register_desktop(void);
+
+#endif /* REOX_BENCH_H */
@@ -0,0 +1,92 @@
+/*
+ * REOX Runtime Benchmarks - Accessibility
+ * Element tree sync after edits, against rebuilding it, and focus moves
+ */
+
+#include "bench.h"
+#include "reox_accessibility.h"
+
+#define FORM_WIDTH 400.0f
+
+/* A form of `rows` label + input rows */
+static rx_view* form_create(int64_t rows, rx_text_view** first_label) {
+    rx_view* root = view_new(RX_VIEW_BOX);
+    for (int64_t i = 0; i < rows; i++) {
+        rx_view* row = view_new(RX_VIEW_BOX);
+        rx_text_view* label = text_view_new("Field label");
+        view_add_child(row, &label->base);
+        view_add_child(row, &input_view_new("Value")->base);
+        view_add_child(root, row);
+        if (i == 0) *first_label = label;
+    }
+    view_layout(root, size(FORM_WIDTH, 1e6f));
+    return root;
+}
+
+static void on_changes(const rx_a11y_change* changes, size_t count, void* ctx) {
+    (void)ctx;
+    rx_bench_keep(changes);
+    rx_bench_keep_int((int64_t)count);
+}
+
+static const rx_a11y_bridge bridge = { on_changes, NULL, NULL };
+
+/* What every frame cost when the platform tree was rebuilt */
+static void bench_sync_full(rx_bench* b) {
+    rx_text_view* label;
+    rx_view* root = form_create(b->param, &label);
+    b->items = (uint64_t)b->param * 3;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_a11y_tree* tree = rx_a11y_tree_create(root, &bridge);
+        rx_a11y_tree_flush(tree);
+        rx_a11y_tree_destroy(tree);
+    }
+    rx_bench_stop(b);
+    view_free(root);
+}
+
+/* One label edited per frame: layout, sync and flush */
+static void bench_sync_one_change(rx_bench* b) {
+    rx_text_view* label;
+    rx_view* root = form_create(b->param, &label);
+    rx_a11y_tree* tree = rx_a11y_tree_create(root, &bridge);
+    rx_a11y_tree_flush(tree);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        text_view_set_text(label, (i & 1) ? "Field label" : "Field label*");
+        view_layout(root, size(FORM_WIDTH, 1e6f));
+        rx_a11y_tree_flush(tree);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)tree->changes_sent);
+    rx_a11y_tree_destroy(tree);
+    view_free(root);
+}
+
+static void bench_focus_next(rx_bench* b) {
+    rx_text_view* label;
+    rx_view* root = form_create(b->param, &label);
+    rx_a11y_tree* tree = rx_a11y_tree_create(root, &bridge);
+    rx_a11y_tree_flush(tree);
+    rx_focus_system* focus = rx_focus_system_create();
+    rx_focus_system_set_tree(focus, tree);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_focus_next(focus);
+        rx_bench_keep(rx_focus_current(focus));
+    }
+    rx_bench_stop(b);
+    rx_focus_system_destroy(focus);
+    rx_a11y_tree_destroy(tree);
+    view_free(root);
+}
+
+void bench_register_a11y(void) {
+    static const int64_t sizes[] = { 100, 1000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("a11y", "sync_full", sizes[i], bench_sync_full);
+        rx_bench_add("a11y", "sync_one_change", sizes[i], bench_sync_one_change);
+        rx_bench_add("a11y", "focus_next", sizes[i], bench_focus_next);
+    }
+}
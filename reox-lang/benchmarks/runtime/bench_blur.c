@@ -0,0 +1,112 @@
+/*
+ * REOX Runtime Benchmarks - Blur
+ * Mip-chain blur against a full-resolution Gaussian, and the blur cache
+ * for glass panels and glows
+ */
+
+#include "bench.h"
+#include "reox_blur.h"
+#include "reox_image_system.h"
+#include <stdlib.h>
+
+#define REGION_W 480
+#define REGION_H 320
+#define SCREEN_W 1280
+#define SCREEN_H 800
+#define PANEL_RADIUS 24.0f
+
+static rx_image* image_noise(int width, int height) {
+    rx_image* img = rx_image_create(width, height, RX_IMAGE_RGBA8);
+    uint32_t seed = 77;
+    for (int y = 0; y < height; y++) {
+        uint32_t* row = (uint32_t*)(img->data + (size_t)y * img->stride);
+        for (int x = 0; x < width; x++) row[x] = rx_bench_rand(&seed) | 0xff000000u;
+    }
+    return img;
+}
+
+/* One blur of radius `param` through the mip chain */
+static void bench_mip_chain(rx_bench* b) {
+    rx_image* src = image_noise(REGION_W, REGION_H);
+    rx_image* dst = rx_image_create(REGION_W, REGION_H, RX_IMAGE_RGBA8);
+    b->items = (uint64_t)REGION_W * REGION_H;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_blur(dst->data, dst->stride, src->data, src->stride, REGION_W, REGION_H, 4, (float)b->param);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep(dst->data);
+    rx_image_destroy(src);
+    rx_image_destroy(dst);
+}
+
+/* The same blur as a separable Gaussian at full resolution */
+static void bench_gaussian_full(rx_bench* b) {
+    rx_image* src = image_noise(REGION_W, REGION_H);
+    rx_image* dst = rx_image_create(REGION_W, REGION_H, RX_IMAGE_RGBA8);
+    b->items = (uint64_t)REGION_W * REGION_H;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) rx_image_gaussian_blur_into(dst, src, (float)b->param * 0.5f);
+    rx_bench_stop(b);
+    rx_bench_keep(dst->data);
+    rx_image_destroy(src);
+    rx_image_destroy(dst);
+}
+
+/* `param` overlapping glass panels per frame */
+static void run_panels(rx_bench* b, bool changing) {
+    rx_image* screen = image_noise(SCREEN_W, SCREEN_H);
+    rx_blur_cache* cache = rx_blur_cache_create(64u << 20);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        for (int64_t p = 0; p < b->param; p++) {
+            int x = 40 + (int)(p % 4) * 240, y = 60 + (int)(p / 4) * 200;
+            /* Something animates under every panel */
+            if (changing) screen->data[(size_t)(y + 10) * screen->stride + (size_t)(x + 10) * 4] += 1;
+            rx_bench_keep(rx_blur_cache_backdrop(cache, screen->data, SCREEN_W, SCREEN_H, screen->stride,
+                                                 x, y, 320, 240, PANEL_RADIUS));
+        }
+        rx_blur_cache_end_frame(cache);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)cache->misses);
+    rx_blur_cache_destroy(cache);
+    rx_image_destroy(screen);
+}
+
+static void bench_backdrop_changing(rx_bench* b) {
+    run_panels(b, true);
+}
+
+/* Nothing under the panels changes: each is hashed and reused */
+static void bench_backdrop_static(rx_bench* b) {
+    run_panels(b, false);
+}
+
+/* `param` glowing buttons in four sizes */
+static void bench_glow(rx_bench* b) {
+    rx_blur_cache* cache = rx_blur_cache_create(16u << 20);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        for (int64_t v = 0; v < b->param; v++) {
+            int mw, mh, pad;
+            rx_bench_keep(rx_blur_cache_glow(cache, 120.0f + (float)(v & 3) * 20, 40, 8, 12.0f, &mw, &mh, &pad));
+        }
+        rx_blur_cache_end_frame(cache);
+    }
+    rx_bench_stop(b);
+    rx_blur_cache_destroy(cache);
+}
+
+void bench_register_blur(void) {
+    static const int64_t radii[] = { 8, 32 };
+    for (size_t i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        rx_bench_add("blur", "mip_chain", radii[i], bench_mip_chain);
+        rx_bench_add("blur", "gaussian_full", radii[i], bench_gaussian_full);
+    }
+    rx_bench_add("blur", "backdrop_changing", 8, bench_backdrop_changing);
+    rx_bench_add("blur", "backdrop_static", 8, bench_backdrop_static);
+    rx_bench_add("blur", "glow", 64, bench_glow);
+}
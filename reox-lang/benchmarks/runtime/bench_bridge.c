@@ -0,0 +1,129 @@
+/*
+ * REOX Runtime Benchmarks - NXRender Bridge
+ * Hit testing, bridge layout and whole frames on the headless target
+ */
+
+#include "bench.h"
+#include "headless_nx.h"
+#include "reox_nxrender_bridge.h"
+
+#define SCENE_W 1280
+#define SCENE_COLUMNS 10
+#define SCENE_ROW_H 24
+
+/* Scrollable-document height: every row keeps SCENE_ROW_H pixels */
+static uint32_t scene_height(int64_t buttons) {
+    return (uint32_t)((buttons + SCENE_COLUMNS - 1) / SCENE_COLUMNS) * SCENE_ROW_H + 8;
+}
+
+/* A vertical stack of rows, each with SCENE_COLUMNS labelled buttons */
+static RxNode** scene_create(int64_t buttons) {
+    rx_bridge_init(SCENE_W, scene_height(buttons));
+    RxNode** nodes = (RxNode**)malloc(sizeof(RxNode*) * (size_t)buttons);
+    RxNode* root = rx_node_create(RX_NODE_VSTACK);
+    root->width = SCENE_W;
+    root->height = (float)scene_height(buttons);
+    root->padding = 4;
+    root->gap = 1;
+    RxNode* row = NULL;
+    for (int64_t i = 0; i < buttons; i++) {
+        if (i % SCENE_COLUMNS == 0) {
+            row = rx_node_create(RX_NODE_HSTACK);
+            row->gap = 1;
+            rx_node_add_child(root, row);
+        }
+        RxNode* button = rx_node_create(RX_NODE_BUTTON);
+        button->background = (NxColor){ 58, 58, 60, 255 };
+        button->corner_radius = 3;
+        button->text = strdup("Button");
+        rx_node_add_child(row, button);
+        nodes[i] = button;
+    }
+    rx_bridge->root = root;
+    rx_frame();
+    return nodes;
+}
+
+static void scene_destroy(RxNode** nodes) {
+    rx_node_destroy(rx_bridge->root);
+    rx_bridge->root = NULL;
+    rx_bridge_destroy();
+    free(nodes);
+}
+
+static void bench_hit_tree(rx_bench* b) {
+    RxNode** nodes = scene_create(b->param);
+    uint32_t seed = 7;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        float x = (float)(rx_bench_rand(&seed) % SCENE_W);
+        float y = (float)(rx_bench_rand(&seed) % (uint32_t)rx_bridge->root->height);
+        rx_bench_keep(rx_hit_test(rx_bridge->root, x, y));
+    }
+    rx_bench_stop(b);
+    scene_destroy(nodes);
+}
+
+static void bench_hit_indexed(rx_bench* b) {
+    RxNode** nodes = scene_create(b->param);
+    uint32_t seed = 7;
+    rx_bench_keep(rx_hit_test_indexed(0, 0));   /* Build the grid untimed */
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        float x = (float)(rx_bench_rand(&seed) % SCENE_W);
+        float y = (float)(rx_bench_rand(&seed) % (uint32_t)rx_bridge->root->height);
+        rx_bench_keep(rx_hit_test_indexed(x, y));
+    }
+    rx_bench_stop(b);
+    scene_destroy(nodes);
+}
+
+static void bench_layout(rx_bench* b) {
+    RxNode** nodes = scene_create(b->param);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_layout_node(rx_bridge->root, SCENE_W, rx_bridge->root->height);
+    }
+    rx_bench_stop(b);
+    scene_destroy(nodes);
+}
+
+/* Whole tree repainted every frame */
+static void bench_frame_full(rx_bench* b) {
+    RxNode** nodes = scene_create(b->param);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_bridge->needs_redraw = true;
+        rx_frame();
+    }
+    rx_bench_stop(b);
+    scene_destroy(nodes);
+}
+
+/* One button changes per frame; only its damage is repainted */
+static void bench_frame_damage(rx_bench* b) {
+    RxNode** nodes = scene_create(b->param);
+    uint32_t seed = 99;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        RxNode* button = nodes[rx_bench_rand(&seed) % (uint32_t)b->param];
+        button->background.r ^= 1;
+        rx_invalidate(button);
+        rx_frame();
+    }
+    rx_bench_stop(b);
+    scene_destroy(nodes);
+}
+
+void bench_register_bridge(void) {
+    static const int64_t sizes[] = { 100, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("bridge", "hit_test_tree", sizes[i], bench_hit_tree);
+        rx_bench_add("bridge", "hit_test_indexed", sizes[i], bench_hit_indexed);
+        rx_bench_add("bridge", "layout", sizes[i], bench_layout);
+        rx_bench_add("bridge", "frame_full", sizes[i], bench_frame_full);
+        rx_bench_add("bridge", "frame_damage", sizes[i], bench_frame_damage);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * REOX Runtime Benchmarks - Desktop
+ * Desktop frames with live window trees against cached surfaces, and
+ * dragging or raising windows over cached surfaces
+ */
+
+#include "bench.h"
+#include "reox_desktop.h"
+
+#define SCREEN_W 1280
+#define SCREEN_H 800
+#define WINDOW_W 320
+#define WINDOW_H 380
+#define WINDOW_ROWS 20
+
+/* Rendering a window's surface walks its tree; drawing one only counts */
+static void* stub_capture(void* ctx, rx_view* view, rx_size sz) {
+    (void)ctx;
+    (void)sz;
+    view_render_content(view, NULL);
+    return view;
+}
+
+static void stub_draw(void* ctx, void* surface, rx_rect frame, rx_rect clip) {
+    (void)ctx;
+    (void)frame;
+    rx_bench_keep(surface);
+    rx_bench_keep_int((int64_t)clip.width);
+}
+
+static void stub_release(void* ctx, void* surface) {
+    (void)ctx;
+    (void)surface;
+}
+
+static const rx_desktop_surface_backend stub_backend = { stub_capture, stub_draw, stub_release, NULL };
+
+/* A form of label + input rows on an opaque background */
+static rx_view* window_content(void) {
+    rx_view* root = vstack_new(4);
+    root->box.background = color_hex(0x2C2C2E);
+    for (int i = 0; i < WINDOW_ROWS; i++) {
+        rx_view* row = hstack_new(8);
+        view_add_child(row, &text_view_new("Field label")->base);
+        view_add_child(row, &input_view_new("Value")->base);
+        view_add_child(root, row);
+    }
+    return root;
+}
+
+/* `count` windows over four columns and two rows, so later windows land
+ * on earlier ones and hide them */
+static rx_desktop* desktop_with_windows(int64_t count, bool surfaces) {
+    rx_desktop* d = desktop_create(SCREEN_W, SCREEN_H);
+    if (surfaces) desktop_set_surface_backend(d, &stub_backend);
+    for (int64_t i = 0; i < count; i++) {
+        rx_desktop_window* dw = desktop_create_window(d, "Window", WINDOW_W, WINDOW_H);
+        dw->window->root_view = window_content();
+        int slot = (int)(i % 8);
+        dw->window->position = point((float)(slot % 4) * 300 + (float)(i / 8) * 12,
+                                     (float)(slot / 4) * 340 + 30);
+    }
+    desktop_layout(d);
+    desktop_render(d, NULL);
+    return d;
+}
+
+static void run_frames(rx_bench* b, bool surfaces) {
+    rx_desktop* d = desktop_with_windows(b->param, surfaces);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        desktop_layout(d);
+        desktop_render(d, NULL);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)d->stats.windows_culled);
+    desktop_destroy(d);
+}
+
+/* Every visible window's tree rendered each frame */
+static void bench_frame_live(rx_bench* b) {
+    run_frames(b, false);
+}
+
+/* Nothing changed: cached surfaces drawn where visible */
+static void bench_frame_cached(rx_bench* b) {
+    run_frames(b, true);
+}
+
+/* The front window follows the pointer */
+static void bench_drag(rx_bench* b) {
+    rx_desktop* d = desktop_with_windows(b->param, true);
+    rx_desktop_window* front = d->windows[d->window_count - 1];
+    rx_point origin = front->window->position;
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        float offset = (float)(i % 64) * 4;
+        desktop_move_window(d, front, point(origin.x - offset, origin.y + offset / 2));
+        desktop_layout(d);
+        desktop_render(d, NULL);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)d->stats.captures);
+    desktop_destroy(d);
+}
+
+/* A different window comes to the front each frame */
+static void bench_raise(rx_bench* b) {
+    rx_desktop* d = desktop_with_windows(b->param, true);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        desktop_focus_window(d, d->windows[0]);
+        desktop_layout(d);
+        desktop_render(d, NULL);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)d->stats.captures);
+    desktop_destroy(d);
+}
+
+void bench_register_desktop(void) {
+    static const int64_t sizes[] = { 8, 32 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("desktop", "frame_live", sizes[i], bench_frame_live);
+        rx_bench_add("desktop", "frame_cached", sizes[i], bench_frame_cached);
+        rx_bench_add("desktop", "drag", sizes[i], bench_drag);
+        rx_bench_add("desktop", "raise", sizes[i], bench_raise);
+    }
+}
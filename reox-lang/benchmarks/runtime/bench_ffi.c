@@ -0,0 +1,99 @@
+/*
+ * REOX Runtime Benchmarks - FFI Dispatch
+ * Calls through the registry by name, by resolved handle and typed
+ */
+
+#include "bench.h"
+#include "reox_ffi.h"
+#include <stdio.h>
+
+static int64_t ffi_add(int64_t a, int64_t b) { return a + b; }
+static int64_t ffi_sum4(int64_t a, int64_t b, int64_t c, int64_t d) { return a + b + c + d; }
+static double ffi_lerp(double a, double b, double t) { return a + (b - a) * t; }
+
+static void ffi_setup(void) {
+    static bool registered;
+    if (registered) return;
+    /* Enough neighbours that name lookup is not trivially short */
+    static RxFFIFunc filler[64];
+    static char names[64][16];
+    for (int i = 0; i < 64; i++) {
+        snprintf(names[i], sizeof(names[i]), "filler_%d", i);
+        filler[i] = (RxFFIFunc){ names[i], (void*)ffi_add, "ii->i" };
+    }
+    rx_ffi_register(filler, 64);
+    static const RxFFIFunc funcs[] = {
+        { "bench_add", (void*)ffi_add, "ii->i" },
+        { "bench_sum4", (void*)ffi_sum4, "iiii->i" },
+        { "bench_lerp", (void*)ffi_lerp, "ddd->d" },
+    };
+    rx_ffi_register(funcs, sizeof(funcs) / sizeof(funcs[0]));
+    registered = true;
+}
+
+static const char* ffi_name(int64_t argc) {
+    return argc == 2 ? "bench_add" : "bench_sum4";
+}
+
+/* param: argument count */
+static void bench_call_name(rx_bench* b) {
+    ffi_setup();
+    const char* name = ffi_name(b->param);
+    int64_t args[4] = { 1, 2, 3, 4 };
+    int64_t sum = 0;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        args[0] = (int64_t)i;
+        sum += rx_ffi_call(name, args, (size_t)b->param);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int(sum);
+}
+
+static void bench_call_handle(rx_bench* b) {
+    ffi_setup();
+    RxFFIHandle fn = rx_ffi_resolve(ffi_name(b->param));
+    int64_t args[4] = { 1, 2, 3, 4 };
+    int64_t sum = 0;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        args[0] = (int64_t)i;
+        sum += rx_ffi_call_handle(fn, args, (size_t)b->param);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int(sum);
+}
+
+static void bench_invoke_double(rx_bench* b) {
+    ffi_setup();
+    RxFFIHandle fn = rx_ffi_resolve("bench_lerp");
+    RxFFIValue args[3] = { { .d = 0 }, { .d = 10 }, { .d = 0.5 } };
+    RxFFIValue ret;
+    double sum = 0;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        args[0].d = (double)i;
+        rx_ffi_invoke(fn, args, 3, &ret);
+        sum += ret.d;
+    }
+    rx_bench_stop(b);
+    rx_bench_keep(&sum);
+}
+
+static void bench_direct(rx_bench* b) {
+    int64_t (*volatile fn)(int64_t, int64_t) = ffi_add;
+    int64_t sum = 0;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) sum += fn((int64_t)i, 2);
+    rx_bench_stop(b);
+    rx_bench_keep_int(sum);
+}
+
+void bench_register_ffi(void) {
+    rx_bench_add("ffi", "direct_pointer", 2, bench_direct);
+    rx_bench_add("ffi", "call_name", 2, bench_call_name);
+    rx_bench_add("ffi", "call_name", 4, bench_call_name);
+    rx_bench_add("ffi", "call_handle", 2, bench_call_handle);
+    rx_bench_add("ffi", "call_handle", 4, bench_call_handle);
+    rx_bench_add("ffi", "invoke_double", 3, bench_invoke_double);
+}
@@ -0,0 +1,115 @@
+/*
+ * REOX Runtime Benchmarks - Gestures
+ * Touch streams through the gesture system and template matching
+ */
+
+#include "bench.h"
+#include "reox_gestures.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define GRID_COLUMNS 20
+#define CELL 48.0f
+#define MOVES_PER_FRAME 4       /* 240 Hz digitizer, 60 Hz display */
+
+static void on_gesture(rx_gesture_recognizer* r, void* event, void* user_data) {
+    (void)r;
+    (void)user_data;
+    rx_bench_keep(event);
+}
+
+/* `count` pan recognizers on a grid of views, or view-less ones that
+ * every touch reaches */
+static rx_gesture_system* scene_create(int64_t count, bool global, rx_view** root_out) {
+    rx_gesture_system* sys = rx_gesture_system_create();
+    rx_view* root = view_new(RX_VIEW_BOX);
+    int64_t rows = (count + GRID_COLUMNS - 1) / GRID_COLUMNS;
+    root->box.frame = rect(0, 0, GRID_COLUMNS * CELL, (float)rows * CELL);
+    for (int64_t i = 0; i < count; i++) {
+        rx_view* cell = view_new(RX_VIEW_BOX);
+        cell->box.frame = rect((float)(i % GRID_COLUMNS) * CELL, (float)(i / GRID_COLUMNS) * CELL, CELL, CELL);
+        view_add_child(root, cell);
+        rx_pan_recognizer* pan = rx_pan_recognizer_create(on_gesture, NULL);
+        rx_gesture_system_add(sys, &pan->base);
+        pan->base.view = global ? NULL : cell;
+    }
+    rx_gesture_system_invalidate(sys);
+    *root_out = root;
+    return sys;
+}
+
+static void scene_destroy(rx_gesture_system* sys, rx_view* root) {
+    while (sys->recognizers) rx_gesture_destroy(sys->recognizers);
+    rx_gesture_system_destroy(sys);
+    view_free(root);
+}
+
+/* One op is a frame: MOVES_PER_FRAME raw moves of a dragging finger,
+ * delivered every `deliver_every` moves */
+static void run_stream(rx_bench* b, bool global, int deliver_every) {
+    rx_view* root;
+    rx_gesture_system* sys = scene_create(b->param, global, &root);
+    rx_touch touch = { .id = 1, .position = { 24, 24 } };
+    float t = 0;
+    rx_gesture_system_process_touch_began(sys, &touch, 1);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        for (int k = 0; k < MOVES_PER_FRAME; k++) {
+            t += 1.0f / 240.0f;
+            touch.timestamp = t;
+            touch.position.x = 24 + 20 * sinf(t * 3);
+            rx_gesture_system_process_touch_moved(sys, &touch, 1);
+            if ((k + 1) % deliver_every == 0) rx_gesture_system_flush(sys);
+        }
+    }
+    rx_bench_stop(b);
+    rx_gesture_system_process_touch_ended(sys, &touch, 1);
+    rx_bench_keep_int((int64_t)sys->recognizer_updates);
+    scene_destroy(sys, root);
+}
+
+static void bench_stream_coalesced(rx_bench* b) {
+    run_stream(b, false, MOVES_PER_FRAME);
+}
+
+/* Delivery on every raw event, as without coalescing */
+static void bench_stream_per_event(rx_bench* b) {
+    run_stream(b, false, 1);
+}
+
+/* No routing: every recognizer sees every delivery */
+static void bench_stream_global(rx_bench* b) {
+    run_stream(b, true, 1);
+}
+
+/* A circle of param samples against the circle template */
+static void bench_match(rx_bench* b) {
+    rx_custom_gesture_recognizer* circle = rx_custom_gesture_create(rx_gesture_circle(), on_gesture, NULL);
+    size_t n = (size_t)b->param;
+    rx_point* path = (rx_point*)malloc(sizeof(rx_point) * n);
+    uint32_t seed = 11;
+    for (size_t i = 0; i < n; i++) {
+        float a = -1.5707963f + 6.2831853f * (float)i / (float)(n - 1);
+        float jitter = (float)(rx_bench_rand(&seed) % 5) - 2.0f;
+        path[i] = point(200 + 100 * cosf(a) + jitter, 200 + 100 * sinf(a) - jitter);
+    }
+    b->items = n;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_bench_keep_int(rx_custom_gesture_match(circle, path, n));
+    }
+    rx_bench_stop(b);
+    free(path);
+    rx_gesture_destroy(&circle->base);
+}
+
+void bench_register_gestures(void) {
+    static const int64_t sizes[] = { 100, 1000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("gestures", "stream_coalesced", sizes[i], bench_stream_coalesced);
+        rx_bench_add("gestures", "stream_per_event", sizes[i], bench_stream_per_event);
+        rx_bench_add("gestures", "stream_global", sizes[i], bench_stream_global);
+    }
+    rx_bench_add("gestures", "match", 64, bench_match);
+    rx_bench_add("gestures", "match", 512, bench_match);
+}
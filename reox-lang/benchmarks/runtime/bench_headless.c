@@ -0,0 +1,113 @@
+/*
+ * REOX Runtime Benchmarks - Headless Backend
+ * Whole screens and single primitives rasterized in software
+ */
+
+#include "bench.h"
+#include "reox_backend_headless.h"
+#include <stdio.h>
+
+#define SCREEN_W 1280
+#define SCREEN_H 800
+
+/* A settings-style screen: sidebar, toolbar and `rows` list rows */
+static void screen_draw(int rows) {
+    RxBackend* be = &rx_backend_headless;
+    RxColor surface = { 44, 44, 46, 255 }, text = { 235, 235, 245, 255 };
+    RxColor accent = { 10, 132, 255, 255 }, separator = { 84, 84, 88, 160 };
+    char label[32];
+
+    be->begin_frame();
+    be->draw_rect((RxRect){ 0, 0, 260, SCREEN_H }, surface, 0);
+    be->draw_rect((RxRect){ 260, 0, SCREEN_W - 260, 52 }, surface, 0);
+    be->draw_text("Settings", (RxPoint){ 280, 16 }, text, 20);
+    for (int i = 0; i < 12; i++) {
+        float y = 64 + i * 36.0f;
+        if (i == 3) be->draw_rect((RxRect){ 8, y, 244, 32 }, accent, 6);
+        be->draw_circle((RxPoint){ 28, y + 16 }, 9, accent);
+        snprintf(label, sizeof(label), "Section %d", i);
+        be->draw_text(label, (RxPoint){ 46, y + 9 }, text, 14);
+    }
+
+    be->set_clip((RxRect){ 260, 52, SCREEN_W - 260, SCREEN_H - 52 });
+    for (int i = 0; i < rows; i++) {
+        float y = 68 + i * 44.0f;
+        be->draw_rect((RxRect){ 280, y, SCREEN_W - 300, 40 }, surface, 8);
+        snprintf(label, sizeof(label), "Option row %d", i);
+        be->draw_text(label, (RxPoint){ 296, y + 13 }, text, 14);
+        be->draw_rect((RxRect){ SCREEN_W - 72, y + 10, 40, 20 }, accent, 10);
+        be->draw_line((RxPoint){ 296, y + 41.5f }, (RxPoint){ SCREEN_W - 36, y + 41.5f },
+                      separator, 1);
+    }
+    be->push_opacity(0.85f);
+    be->draw_rect((RxRect){ 760, 520, 480, 240 }, (RxColor){ 30, 30, 32, 255 }, 14);
+    be->draw_text("Changes saved", (RxPoint){ 784, 544 }, text, 18);
+    be->pop_opacity();
+    be->clear_clip();
+    be->end_frame();
+}
+
+static void headless_setup(void) {
+    rx_backend_headless.init(SCREEN_W, SCREEN_H, NULL);
+    rx_headless_set_clear_color((RxColor){ 28, 28, 30, 255 });
+}
+
+static void bench_screen(rx_bench* b) {
+    headless_setup();
+    screen_draw((int)b->param);     /* Warm the glyph atlas */
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) screen_draw((int)b->param);
+    rx_bench_stop(b);
+    rx_bench_keep_int((int64_t)rx_headless_checksum());
+    rx_backend_headless.destroy();
+}
+
+/* param x param square per op */
+static void bench_fill_opaque(rx_bench* b) {
+    headless_setup();
+    float side = (float)b->param;
+    b->items = (uint64_t)(side * side);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_backend_headless.draw_rect((RxRect){ 10, 10, side, side },
+                                      (RxColor){ 58, 58, 60, 255 }, 0);
+    }
+    rx_bench_stop(b);
+    rx_backend_headless.destroy();
+}
+
+static void bench_fill_blend(rx_bench* b) {
+    headless_setup();
+    float side = (float)b->param;
+    b->items = (uint64_t)(side * side);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_backend_headless.draw_rect((RxRect){ 10.5f, 10.5f, side, side },
+                                      (RxColor){ 255, 59, 48, 128 }, 12);
+    }
+    rx_bench_stop(b);
+    rx_backend_headless.destroy();
+}
+
+static void bench_text(rx_bench* b) {
+    headless_setup();
+    const char* line = "The quick brown fox jumps over the lazy dog 0123456789";
+    rx_backend_headless.draw_text(line, (RxPoint){ 10, 10 }, (RxColor){ 255, 255, 255, 255 },
+                                  (float)b->param);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_backend_headless.draw_text(line, (RxPoint){ 10, 10 },
+                                      (RxColor){ 255, 255, 255, 255 }, (float)b->param);
+    }
+    rx_bench_stop(b);
+    rx_backend_headless.destroy();
+}
+
+void bench_register_headless(void) {
+    rx_bench_add("headless", "screen", 10, bench_screen);
+    rx_bench_add("headless", "screen", 40, bench_screen);
+    rx_bench_add("headless", "fill_opaque", 256, bench_fill_opaque);
+    rx_bench_add("headless", "fill_blend", 256, bench_fill_blend);
+    rx_bench_add("headless", "text", 14, bench_text);
+    rx_bench_add("headless", "text", 32, bench_text);
+}
@@ -0,0 +1,50 @@
+/*
+ * REOX Runtime Benchmarks - Image Filters
+ * Filters over a square RGBA8 image; each op produces a new image
+ */
+
+#include "bench.h"
+#include "reox_image_system.h"
+
+static rx_image* image_noise(int size) {
+    rx_image* img = rx_image_create(size, size, RX_IMAGE_RGBA8);
+    uint32_t seed = 2024;
+    for (int y = 0; y < size; y++) {
+        uint32_t* row = (uint32_t*)(img->data + (size_t)y * img->stride);
+        for (int x = 0; x < size; x++) row[x] = rx_bench_rand(&seed) | 0xff000000u;
+    }
+    return img;
+}
+
+typedef rx_image* (*filter_fn)(rx_image* img);
+
+static void run_filter(rx_bench* b, filter_fn filter) {
+    rx_image* src = image_noise((int)b->param);
+    b->items = (uint64_t)(b->param * b->param);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_image_destroy(filter(src));
+    }
+    rx_bench_stop(b);
+    rx_image_destroy(src);
+}
+
+static rx_image* box_blur(rx_image* img) { return rx_image_box_blur(img, 4); }
+static rx_image* gaussian_blur(rx_image* img) { return rx_image_gaussian_blur(img, 3.0f); }
+static rx_image* sharpen(rx_image* img) { return rx_image_sharpen(img, 1.0f); }
+static rx_image* edge_detect(rx_image* img) { return rx_image_edge_detect(img); }
+static rx_image* saturation(rx_image* img) { return rx_image_saturation(img, 0.5f); }
+
+static void bench_box_blur(rx_bench* b) { run_filter(b, box_blur); }
+static void bench_gaussian_blur(rx_bench* b) { run_filter(b, gaussian_blur); }
+static void bench_sharpen(rx_bench* b) { run_filter(b, sharpen); }
+static void bench_edge_detect(rx_bench* b) { run_filter(b, edge_detect); }
+static void bench_saturation(rx_bench* b) { run_filter(b, saturation); }
+
+void bench_register_image(void) {
+    rx_bench_add("image", "box_blur", 256, bench_box_blur);
+    rx_bench_add("image", "gaussian_blur", 256, bench_gaussian_blur);
+    rx_bench_add("image", "sharpen", 256, bench_sharpen);
+    rx_bench_add("image", "edge_detect", 256, bench_edge_detect);
+    rx_bench_add("image", "saturation", 512, bench_saturation);
+}
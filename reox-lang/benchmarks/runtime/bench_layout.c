@@ -0,0 +1,166 @@
+/*
+ * REOX Runtime Benchmarks - Layout
+ * Full and incremental view_layout on generated deep and wide trees
+ */
+
+#include "bench.h"
+#include "reox_ui.h"
+#include "reox_grid.h"
+#include <stdlib.h>
+
+typedef struct layout_tree {
+    rx_view* root;
+    rx_view** leaves;
+    size_t leaf_count;
+    size_t node_count;
+} layout_tree;
+
+static rx_view* tree_leaf(layout_tree* t, float height) {
+    rx_view* v = view_new(RX_VIEW_BOX);
+    v->box.height = height;
+    box_set_flex(&v->box, 1, 1, 0);
+    t->leaves[t->leaf_count++] = v;
+    t->node_count++;
+    return v;
+}
+
+static rx_view* tree_box(layout_tree* t, rx_layout layout, float padding) {
+    rx_view* v = view_new(RX_VIEW_BOX);
+    v->layout = layout;
+    v->box.padding = (rx_edge_insets){ padding, padding, padding, padding };
+    t->node_count++;
+    return v;
+}
+
+/* `leaves / 4` rows of four flexible leaves */
+static layout_tree tree_wide(int64_t leaves) {
+    layout_tree t = { 0 };
+    t.leaves = (rx_view**)malloc(sizeof(rx_view*) * (size_t)leaves);
+    t.root = tree_box(&t, vstack(2), 4);
+    for (int64_t r = 0; r < leaves / 4; r++) {
+        rx_view* row = tree_box(&t, hstack(2), 1);
+        for (int k = 0; k < 4; k++) view_add_child(row, tree_leaf(&t, 20));
+        view_add_child(t.root, row);
+    }
+    return t;
+}
+
+/* Nested boxes `depth` levels deep, each with one leaf beside the next level */
+static layout_tree tree_deep(int64_t depth) {
+    layout_tree t = { 0 };
+    t.leaves = (rx_view**)malloc(sizeof(rx_view*) * (size_t)(depth + 1));
+    t.root = tree_box(&t, vstack(1), 1);
+    rx_view* parent = t.root;
+    for (int64_t d = 0; d < depth; d++) {
+        rx_view* level = tree_box(&t, (d & 1) ? vstack(1) : hstack(1), 1);
+        view_add_child(parent, tree_leaf(&t, 10));
+        view_add_child(parent, level);
+        parent = level;
+    }
+    view_add_child(parent, tree_leaf(&t, 10));
+    return t;
+}
+
+static void tree_free(layout_tree* t) {
+    view_free(t->root);
+    free(t->leaves);
+}
+
+static void tree_invalidate(rx_view* v) {
+    v->layout_valid = false;
+    v->measure_valid = false;
+    for (size_t i = 0; i < v->child_count; i++) tree_invalidate(v->children[i]);
+}
+
+static void run_full(rx_bench* b, layout_tree t) {
+    rx_size available = { 1280, 100000 };
+    b->items = t.node_count;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        tree_invalidate(t.root);
+        view_layout(t.root, available);
+    }
+    rx_bench_stop(b);
+    tree_free(&t);
+}
+
+/* One leaf changes per pass; the rest of the tree keeps its layout */
+static void run_incremental(rx_bench* b, layout_tree t) {
+    rx_size available = { 1280, 100000 };
+    view_layout(t.root, available);
+    uint32_t seed = 12345;
+    b->items = t.node_count;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_view* leaf = t.leaves[rx_bench_rand(&seed) % t.leaf_count];
+        leaf->box.height = (leaf->box.height == 20) ? 21 : 20;
+        view_set_needs_layout(leaf);
+        view_layout(t.root, available);
+    }
+    rx_bench_stop(b);
+    tree_free(&t);
+}
+
+static void bench_wide_full(rx_bench* b) { run_full(b, tree_wide(b->param)); }
+static void bench_wide_incremental(rx_bench* b) { run_incremental(b, tree_wide(b->param)); }
+static void bench_deep_full(rx_bench* b) { run_full(b, tree_deep(b->param)); }
+static void bench_deep_incremental(rx_bench* b) { run_incremental(b, tree_deep(b->param)); }
+
+/* Photo grid: eight fr columns of 120px rows, all cells alike */
+static layout_tree tree_grid_uniform(int64_t cells) {
+    layout_tree t = { 0 };
+    t.leaves = (rx_view**)malloc(sizeof(rx_view*) * (size_t)cells);
+    rx_grid_view* grid = grid_view_new(8, 0);
+    grid_view_set_auto_rows(grid, track_px(120));
+    grid_view_set_gap(grid, 4, 4);
+    t.root = &grid->base;
+    t.node_count = 1;
+    for (int64_t i = 0; i < cells; i++) {
+        rx_view* v = view_new(RX_VIEW_BOX);
+        grid_view_add_item(grid, v, grid_auto());
+        t.leaves[t.leaf_count++] = v;
+        t.node_count++;
+    }
+    return t;
+}
+
+/* Auto-sized columns and rows with a spanning item every 16 cells */
+static layout_tree tree_grid_auto(int64_t cells) {
+    layout_tree t = { 0 };
+    t.leaves = (rx_view**)malloc(sizeof(rx_view*) * (size_t)cells);
+    rx_grid_view* grid = grid_view_new(0, 0);
+    rx_track_size cols[4] = { track_auto(), track_fr(1), track_auto(), track_px(80) };
+    grid_view_set_columns(grid, cols, 4);
+    grid_view_set_gap(grid, 2, 2);
+    t.root = &grid->base;
+    t.node_count = 1;
+    for (int64_t i = 0; i < cells; i++) {
+        rx_view* v = view_new(RX_VIEW_BOX);
+        v->box.width = (float)(20 + i % 7);
+        v->box.height = 20;
+        grid_view_add_item(grid, v, i % 16 == 0 ? grid_area(-1, -1, 2, 1) : grid_auto());
+        t.leaves[t.leaf_count++] = v;
+        t.node_count++;
+    }
+    return t;
+}
+
+static void bench_grid_uniform_full(rx_bench* b) { run_full(b, tree_grid_uniform(b->param)); }
+static void bench_grid_uniform_incremental(rx_bench* b) { run_incremental(b, tree_grid_uniform(b->param)); }
+static void bench_grid_auto_full(rx_bench* b) { run_full(b, tree_grid_auto(b->param)); }
+static void bench_grid_auto_incremental(rx_bench* b) { run_incremental(b, tree_grid_auto(b->param)); }
+
+void bench_register_layout(void) {
+    rx_bench_add("layout", "wide_full", 1000, bench_wide_full);
+    rx_bench_add("layout", "wide_full", 10000, bench_wide_full);
+    rx_bench_add("layout", "wide_incremental", 1000, bench_wide_incremental);
+    rx_bench_add("layout", "wide_incremental", 10000, bench_wide_incremental);
+    rx_bench_add("layout", "deep_full", 64, bench_deep_full);
+    rx_bench_add("layout", "deep_full", 512, bench_deep_full);
+    rx_bench_add("layout", "deep_incremental", 64, bench_deep_incremental);
+    rx_bench_add("layout", "deep_incremental", 512, bench_deep_incremental);
+    rx_bench_add("layout", "grid_uniform_full", 50000, bench_grid_uniform_full);
+    rx_bench_add("layout", "grid_uniform_incremental", 50000, bench_grid_uniform_incremental);
+    rx_bench_add("layout", "grid_auto_full", 10000, bench_grid_auto_full);
+    rx_bench_add("layout", "grid_auto_incremental", 10000, bench_grid_auto_incremental);
+}
@@ -0,0 +1,112 @@
+/*
+ * REOX Runtime Benchmarks - Lighting
+ * Tiled shading, per-frame light animation and cached shadow masks
+ */
+
+#include "bench.h"
+#include "reox_lighting.h"
+#include <stdlib.h>
+
+#define SCREEN_W 1280
+#define SCREEN_H 800
+#define SAMPLE_STEP 8           /* Shade every 8th pixel each way */
+#define CASTERS 32
+
+/* `count` flickering neon lights scattered over the screen */
+static rx_lighting_scene* scene_create(int64_t count) {
+    rx_lighting_scene* scene = rx_lighting_scene_create();
+    rx_lighting_setup_neon(scene);
+    uint32_t seed = 5;
+    for (int64_t i = 0; i < count; i++) {
+        rx_point at = point((float)(rx_bench_rand(&seed) % SCREEN_W), (float)(rx_bench_rand(&seed) % SCREEN_H));
+        rx_color color = { (uint8_t)rx_bench_rand(&seed), 40, (uint8_t)rx_bench_rand(&seed), 255 };
+        rx_light* light = rx_light_point(at, color, 1.5f, 80.0f + (float)(rx_bench_rand(&seed) % 80));
+        rx_light_set_flicker(light, 0.2f, 8.0f);
+        rx_light_set_pulse(light, 0.1f, 0.5f);
+        rx_lighting_scene_add_light(scene, light);
+    }
+    rx_lighting_scene_update(scene, 0);
+    return scene;
+}
+
+/* One frame of shading samples */
+static void bench_shade(rx_bench* b) {
+    rx_lighting_scene* scene = scene_create(b->param);
+    rx_material mat = rx_material_glossy((rx_color){ 40, 40, 48, 255 }, 0.6f);
+    b->items = (uint64_t)(SCREEN_W / SAMPLE_STEP) * (SCREEN_H / SAMPLE_STEP);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        uint32_t sum = 0;
+        for (int y = 0; y < SCREEN_H; y += SAMPLE_STEP) {
+            for (int x = 0; x < SCREEN_W; x += SAMPLE_STEP) {
+                sum += rx_lighting_calculate(scene, point((float)x, (float)y), point(0, 0), mat).r;
+            }
+        }
+        rx_bench_keep_int(sum);
+    }
+    rx_bench_stop(b);
+    rx_lighting_scene_destroy(scene);
+}
+
+/* Flicker and pulse for every light, no light moved */
+static void bench_update(rx_bench* b) {
+    rx_lighting_scene* scene = scene_create(b->param);
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) rx_lighting_scene_update(scene, 1.0f / 60.0f);
+    rx_bench_stop(b);
+    rx_bench_keep_int(scene->rebins);
+    rx_lighting_scene_destroy(scene);
+}
+
+static void run_shadows(rx_bench* b, bool moving) {
+    rx_lighting_scene* scene = scene_create(b->param);
+    scene->shadows_enabled = true;
+    int lit = 0;
+    for (rx_light* l = scene->lights; l && lit < 4; l = l->next, lit++) rx_light_enable_shadows(l, true, 6.0f);
+
+    rx_view* root = view_new(RX_VIEW_BOX);
+    rx_shadow_caster* casters[CASTERS];
+    for (int i = 0; i < CASTERS; i++) {
+        rx_view* card = view_new(RX_VIEW_BOX);
+        card->box.frame = rect(40.0f + (float)(i % 8) * 150, 60.0f + (float)(i / 8) * 180, 120, 140);
+        view_add_child(root, card);
+        casters[i] = rx_shadow_caster_create(card, 12.0f);
+    }
+    rx_shadow_update(scene, casters, CASTERS);
+
+    b->items = CASTERS;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        if (moving) {
+            for (int c = 0; c < CASTERS; c++) casters[c]->view->box.frame.y += (i & 1) ? 1.0f : -1.0f;
+        }
+        rx_shadow_update(scene, casters, CASTERS);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int(scene->shadow_rebuilds);
+
+    for (int i = 0; i < CASTERS; i++) free(casters[i]);
+    view_free(root);
+    rx_lighting_scene_destroy(scene);
+}
+
+/* Static cards: every mask comes from the cache */
+static void bench_shadows_static(rx_bench* b) {
+    run_shadows(b, false);
+}
+
+/* Every card moves each frame: every mask is rebuilt */
+static void bench_shadows_moving(rx_bench* b) {
+    run_shadows(b, true);
+}
+
+void bench_register_lighting(void) {
+    static const int64_t sizes[] = { 16, 256 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("lighting", "shade", sizes[i], bench_shade);
+        rx_bench_add("lighting", "update", sizes[i], bench_update);
+    }
+    rx_bench_add("lighting", "shadows_static", 16, bench_shadows_static);
+    rx_bench_add("lighting", "shadows_moving", 16, bench_shadows_moving);
+}
@@ -0,0 +1,59 @@
+/*
+ * REOX Runtime Benchmarks - Particles
+ * One 60 Hz update over a fixed population, array-of-structs and
+ * structure-of-arrays storage
+ */
+
+#include "bench.h"
+#include "reox_transitions.h"
+
+static rx_particle_emitter* emitter_create(rx_particle_storage storage, int count) {
+    rx_particle_emitter_config config = {
+        .storage = storage,
+        .emit_rate = 0,
+        .max_particles = count,
+        .position = { 400, 300 },
+        .emit_area = { 100, 100 },
+        .emit_angle = 90,
+        .emit_spread = 180,
+        .min_speed = 20,
+        .max_speed = 120,
+        /* Nothing dies, so every update touches the whole population */
+        .min_lifetime = 1e9f,
+        .max_lifetime = 1e9f,
+        .min_size = 2,
+        .max_size = 6,
+        .end_size_scale = 0.5f,
+        .start_color = { 255, 200, 80, 255 },
+        .end_color = { 255, 60, 20, 0 },
+        .gravity = { 0, 98 },
+        .drag = 0.1f,
+        .turbulence = 4,
+        .shape = RX_PARTICLE_CIRCLE,
+    };
+    rx_particle_emitter* emitter = rx_particles_create(config);
+    rx_particles_burst(emitter, count);
+    return emitter;
+}
+
+static void run_update(rx_bench* b, rx_particle_storage storage) {
+    rx_particle_emitter* emitter = emitter_create(storage, (int)b->param);
+    b->items = (uint64_t)emitter->particle_count;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_particles_update(emitter, 1.0f / 60.0f);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep(&emitter->bounds);
+    rx_particles_destroy(emitter);
+}
+
+static void bench_update_aos(rx_bench* b) { run_update(b, RX_PARTICLES_AOS); }
+static void bench_update_soa(rx_bench* b) { run_update(b, RX_PARTICLES_SOA); }
+
+void bench_register_particles(void) {
+    rx_bench_add("particles", "update_aos", 1000, bench_update_aos);
+    rx_bench_add("particles", "update_aos", 10000, bench_update_aos);
+    rx_bench_add("particles", "update_soa", 1000, bench_update_soa);
+    rx_bench_add("particles", "update_soa", 10000, bench_update_soa);
+}
@@ -0,0 +1,158 @@
+/*
+ * REOX Runtime Benchmarks - Reactive State
+ * get/set over 1k-100k states, diff collection, computed chains and
+ * effect fan-out
+ */
+
+#include "bench.h"
+
+/* Measure state as apps built on the runtime use it: with frame zones */
+#define RX_STATE_FRAME 1
+#include "reox_state.h"
+
+static RxStateHandle* states_create(int64_t count) {
+    RxStateHandle* h = (RxStateHandle*)malloc(sizeof(RxStateHandle) * (size_t)count);
+    for (int64_t i = 0; i < count; i++) h[i] = rx_state_int_create(i);
+    return h;
+}
+
+static void states_destroy(RxStateHandle* h, int64_t count) {
+    rx_clear_dirty();
+    for (int64_t i = 0; i < count; i++) rx_state_destroy(h[i]);
+    free(h);
+}
+
+/* Random order, so large state tables pay for cache misses */
+static uint32_t* random_indices(int64_t count, size_t n) {
+    uint32_t* idx = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t seed = 0x9e3779b9u;
+    for (size_t i = 0; i < n; i++) idx[i] = rx_bench_rand(&seed) % (uint32_t)count;
+    return idx;
+}
+
+#define INDEX_WINDOW 4096   /* Power of two */
+
+static void bench_get(rx_bench* b) {
+    RxStateHandle* h = states_create(b->param);
+    uint32_t* idx = random_indices(b->param, INDEX_WINDOW);
+    int64_t sum = 0;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        sum += rx_state_int_get(h[idx[i & (INDEX_WINDOW - 1)]]);
+    }
+    rx_bench_stop(b);
+    rx_bench_keep_int(sum);
+    free(idx);
+    states_destroy(h, b->param);
+}
+
+static void bench_set(rx_bench* b) {
+    RxStateHandle* h = states_create(b->param);
+    uint32_t* idx = random_indices(b->param, INDEX_WINDOW);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_state_int_set(h[idx[i & (INDEX_WINDOW - 1)]], (int64_t)i);
+    }
+    rx_bench_stop(b);
+    free(idx);
+    states_destroy(h, b->param);
+}
+
+/* One op: write a tenth of the states, collect the diffs, clear */
+static void bench_diff(rx_bench* b) {
+    RxStateHandle* h = states_create(b->param);
+    int64_t dirty = b->param / 10;
+    rx_diff_batch batch;
+    rx_diff_batch_init(&batch, (int)dirty);
+    b->items = (uint64_t)dirty;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        for (int64_t k = 0; k < dirty; k++) {
+            rx_state_int_set(h[k * 10], (int64_t)(i + 1) * k + 1);
+        }
+        rx_bench_keep_int(rx_collect_diffs_into(&batch));
+        rx_clear_dirty();
+    }
+    rx_bench_stop(b);
+    rx_diff_batch_free(&batch);
+    states_destroy(h, b->param);
+}
+
+/* Computed chain: each link reads the previous one */
+static double chain_link(void* user_data) {
+    return rx_computed_get(*(RxStateHandle*)user_data) + 1.0;
+}
+
+static double chain_root(void* user_data) {
+    return (double)rx_state_int_get(*(RxStateHandle*)user_data);
+}
+
+static void effect_count(void* user_data) {
+    (*(uint64_t*)user_data)++;
+}
+
+/* One op: write the root, run the effect at the end of a chain */
+static void bench_chain(rx_bench* b) {
+    int64_t depth = b->param;
+    RxStateHandle root = rx_state_int_create(0);
+    RxStateHandle* links = (RxStateHandle*)malloc(sizeof(RxStateHandle) * (size_t)depth);
+    links[0] = rx_computed_create(&root, 1, chain_root, &root);
+    for (int64_t i = 1; i < depth; i++) {
+        links[i] = rx_computed_create(&links[i - 1], 1, chain_link, &links[i - 1]);
+    }
+    uint64_t runs = 0;
+    int64_t effect = rx_effect_create(&links[depth - 1], 1, effect_count, &runs);
+    b->items = (uint64_t)depth;
+
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_state_int_set(root, (int64_t)i + 1);
+        rx_run_effects();
+    }
+    rx_bench_stop(b);
+    rx_bench_keep(&runs);
+
+    rx_effect_destroy(effect);
+    for (int64_t i = depth - 1; i >= 0; i--) rx_computed_destroy(links[i]);
+    free(links);
+    rx_clear_dirty();
+    rx_state_destroy(root);
+}
+
+/* One op: write a state observed by `param` effects and run them */
+static void bench_fanout(rx_bench* b) {
+    int64_t count = b->param;
+    RxStateHandle source = rx_state_int_create(0);
+    int64_t* effects = (int64_t*)malloc(sizeof(int64_t) * (size_t)count);
+    uint64_t runs = 0;
+    for (int64_t i = 0; i < count; i++) {
+        effects[i] = rx_effect_create(&source, 1, effect_count, &runs);
+    }
+    b->items = (uint64_t)count;
+
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_state_int_set(source, (int64_t)i + 1);
+        rx_run_effects();
+    }
+    rx_bench_stop(b);
+    rx_bench_keep(&runs);
+
+    for (int64_t i = 0; i < count; i++) rx_effect_destroy(effects[i]);
+    free(effects);
+    rx_clear_dirty();
+    rx_state_destroy(source);
+}
+
+void bench_register_state(void) {
+    static const int64_t sizes[] = { 1000, 10000, 100000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("state", "get", sizes[i], bench_get);
+        rx_bench_add("state", "set", sizes[i], bench_set);
+        rx_bench_add("state", "diff", sizes[i], bench_diff);
+    }
+    rx_bench_add("state", "computed_chain", 16, bench_chain);
+    rx_bench_add("state", "computed_chain", 256, bench_chain);
+    rx_bench_add("state", "effect_fanout", 100, bench_fanout);
+    rx_bench_add("state", "effect_fanout", 1000, bench_fanout);
+}
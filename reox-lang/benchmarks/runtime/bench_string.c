@@ -0,0 +1,92 @@
+/*
+ * REOX Runtime Benchmarks - Strings
+ * Concatenation, appends, splitting, interning and number formatting
+ */
+
+#include "bench.h"
+#include "reox_runtime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* param: length of each operand */
+static void bench_concat(rx_bench* b) {
+    char text[256];
+    memset(text, 'a', sizeof(text));
+    rx_str x = str_from(text, (size_t)b->param);
+    rx_str y = str_from(text, (size_t)b->param);
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_str s = str_concat(&x, &y);
+        rx_bench_keep(&s);
+        str_free(&s);
+    }
+    rx_bench_stop(b);
+    str_free(&x);
+    str_free(&y);
+}
+
+/* One op: build a string from `param` short appends */
+static void bench_append(rx_bench* b) {
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_str s = str_new("");
+        for (int64_t k = 0; k < b->param; k++) str_append(&s, "item, ");
+        rx_bench_keep(&s);
+        str_free(&s);
+    }
+    rx_bench_stop(b);
+}
+
+/* One op: walk the fields of a `param`-field CSV line */
+static void bench_split(rx_bench* b) {
+    rx_str line = str_new("");
+    for (int64_t k = 0; k < b->param; k++) str_append(&line, k ? ",field" : "field");
+    b->items = (uint64_t)b->param;
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_str_split_iter it = str_split_iter(str_view(&line), ',');
+        rx_str_view field;
+        size_t total = 0;
+        while (str_split_next(&it, &field)) total += field.len;
+        rx_bench_keep_int((int64_t)total);
+    }
+    rx_bench_stop(b);
+    str_free(&line);
+}
+
+/* Lookups of `param` distinct strings that are already interned */
+static void bench_intern(rx_bench* b) {
+    char (*names)[24] = malloc(sizeof(*names) * (size_t)b->param);
+    for (int64_t k = 0; k < b->param; k++) {
+        snprintf(names[k], sizeof(names[k]), "name_%lld", (long long)k);
+        str_intern(names[k]);
+    }
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_str s = str_intern(names[i % (uint64_t)b->param]);
+        rx_bench_keep(&s);
+    }
+    rx_bench_stop(b);
+    free(names);
+}
+
+static void bench_int_to_str(rx_bench* b) {
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_str s = int_to_str((rx_int)(i * 2654435761u));
+        rx_bench_keep(&s);
+        str_free(&s);
+    }
+    rx_bench_stop(b);
+}
+
+void bench_register_string(void) {
+    rx_bench_add("string", "concat", 8, bench_concat);
+    rx_bench_add("string", "concat", 128, bench_concat);
+    rx_bench_add("string", "append", 100, bench_append);
+    rx_bench_add("string", "split_iter", 100, bench_split);
+    rx_bench_add("string", "intern", 1000, bench_intern);
+    rx_bench_add("string", "int_to_str", 0, bench_int_to_str);
+}
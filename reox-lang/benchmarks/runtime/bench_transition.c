@@ -0,0 +1,150 @@
+/*
+ * REOX Runtime Benchmarks - Transitions
+ * UI-thread cost of a page transition frame with live trees against
+ * composited snapshots, and of pushing a screen built here or off thread
+ */
+
+#include "bench.h"
+#include "reox_transitions.h"
+#include "reox_compositor.h"
+#include "reox_runloop.h"
+#include <stdlib.h>
+
+#define SCREEN_W 400.0f
+#define SCREEN_H 800.0f
+
+/* A form of `rows` label + input rows */
+static rx_view* screen_build(void* user_data, rx_size available) {
+    (void)available;            /* Laid out by the builder afterwards */
+    int64_t rows = *(const int64_t*)user_data;
+    rx_view* root = view_new(RX_VIEW_BOX);
+    for (int64_t i = 0; i < rows; i++) {
+        rx_view* row = view_new(RX_VIEW_BOX);
+        view_add_child(row, &text_view_new("Field label")->base);
+        view_add_child(row, &input_view_new("Value")->base);
+        view_add_child(root, row);
+    }
+    return root;
+}
+
+static rx_view* screen_ready(int64_t* rows) {
+    rx_view* root = screen_build(rows, size(SCREEN_W, SCREEN_H));
+    view_layout(root, size(SCREEN_W, SCREEN_H));
+    return root;
+}
+
+/* Layer storage is not drawn here: capture and composite only count */
+static void* stub_capture(void* ctx, rx_view* view) {
+    (void)ctx;
+    return view;
+}
+
+static void stub_composite(void* ctx, const rx_layer_snapshot* layers, size_t count) {
+    (void)ctx;
+    rx_bench_keep(layers);
+    rx_bench_keep_int((int64_t)count);
+}
+
+static void stub_release(void* ctx, void* content) {
+    (void)ctx;
+    (void)content;
+}
+
+static const rx_compositor_backend stub_backend = { stub_capture, stub_composite, stub_release, NULL };
+
+static rx_transition_config slide_config(void) {
+    rx_transition_config config = rx_transition_default();
+    config.type = RX_TRANS_SLIDE_LEFT;
+    config.duration = 1e6f;         /* Never finishes inside the loop */
+    return config;
+}
+
+static void run_frames(rx_bench* b, bool composited) {
+    int64_t rows = b->param;
+    rx_view* from = screen_ready(&rows);
+    rx_view* to = screen_ready(&rows);
+    rx_compositor* comp = composited ? rx_compositor_create(&stub_backend, 0) : NULL;
+    rx_compositor_install(comp);
+    rx_page_transition* trans = rx_page_transition_create(from, to, slide_config());
+    rx_page_transition_start(trans);
+
+    rx_bench_start(b);
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_page_transition_update(trans, 1.0f / 60.0f);
+        /* Moved trees are laid out again; layers are not */
+        if (!trans->composited) {
+            view_set_needs_layout(from);
+            view_set_needs_layout(to);
+        }
+        view_layout(from, size(SCREEN_W, SCREEN_H));
+        view_layout(to, size(SCREEN_W, SCREEN_H));
+        if (comp) rx_compositor_collect(comp);
+    }
+    rx_bench_stop(b);
+
+    rx_page_transition_cancel(trans);
+    rx_page_transition_destroy(trans);
+    if (comp) {
+        rx_compositor_demote(comp, from);
+        rx_compositor_demote(comp, to);
+        rx_compositor_collect(comp);
+        rx_compositor_install(NULL);
+        rx_compositor_destroy(comp);
+    }
+    view_free(from);
+    view_free(to);
+}
+
+static void bench_frame_live(rx_bench* b) {
+    run_frames(b, false);
+}
+
+static void bench_frame_composited(rx_bench* b) {
+    run_frames(b, true);
+}
+
+/* The incoming screen is built and laid out inside the push */
+static void bench_push_sync(rx_bench* b) {
+    int64_t rows = b->param;
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_screen_transition_manager* mgr = rx_screen_mgr_create();
+        rx_bench_start(b);
+        rx_view* screen = screen_ready(&rows);
+        rx_screen_mgr_push(mgr, screen, rx_transition_default());
+        rx_bench_stop(b);
+        rx_screen_mgr_destroy(mgr);
+        view_free(screen);
+    }
+}
+
+/* Push plus the frames that poll until the screen arrives; the wait
+ * itself is off the UI thread and not counted */
+static void bench_push_build(rx_bench* b) {
+    int64_t rows = b->param;
+    for (uint64_t i = 0; i < b->n; i++) {
+        rx_screen_transition_manager* mgr = rx_screen_mgr_create();
+        rx_bench_start(b);
+        rx_page_transition* trans = rx_screen_mgr_push_build(mgr, screen_build, &rows,
+                                                             size(SCREEN_W, SCREEN_H), rx_transition_default());
+        rx_bench_stop(b);
+        while (!rx_page_transition_ready(trans)) {
+            rx_clock_sleep_ns(20000);
+            rx_bench_start(b);
+            rx_screen_mgr_update(mgr, 0);
+            rx_bench_stop(b);
+        }
+        rx_view* screen = trans->to_view;
+        rx_screen_mgr_destroy(mgr);
+        view_free(screen);
+    }
+}
+
+void bench_register_transition(void) {
+    static const int64_t sizes[] = { 50, 500 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        rx_bench_add("transition", "frame_live", sizes[i], bench_frame_live);
+        rx_bench_add("transition", "frame_composited", sizes[i], bench_frame_composited);
+        rx_bench_add("transition", "push_sync", sizes[i], bench_push_sync);
+        rx_bench_add("transition", "push_build", sizes[i], bench_push_build);
+    }
+}
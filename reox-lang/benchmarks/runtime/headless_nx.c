@@ -0,0 +1,166 @@
+/*
+ * REOX Runtime Benchmarks - Headless NXRender
+ */
+
+#include "headless_nx.h"
+#include "reox_nxrender_bridge.h"
+
+nx_headless_stats nx_headless;
+
+typedef struct {
+    uint32_t width, height;
+} headless_gpu;
+
+typedef struct {
+    float x, y;
+    bool down[3];
+} headless_mouse;
+
+static int headless_theme;
+static int headless_keyboard;
+
+/* ============================================================================
+ * GPU
+ * ============================================================================ */
+
+NxGpuContext nx_gpu_create(void) {
+    return nx_gpu_create_with_size(1280, 800);
+}
+
+NxGpuContext nx_gpu_create_with_size(uint32_t width, uint32_t height) {
+    headless_gpu* gpu = (headless_gpu*)calloc(1, sizeof(headless_gpu));
+    if (gpu) {
+        gpu->width = width;
+        gpu->height = height;
+    }
+    return gpu;
+}
+
+void nx_gpu_destroy(NxGpuContext ctx) {
+    free(ctx);
+}
+
+void nx_gpu_present(NxGpuContext ctx) {
+    (void)ctx;
+    nx_headless.frames++;
+}
+
+void nx_gpu_resize(NxGpuContext ctx, uint32_t width, uint32_t height) {
+    headless_gpu* gpu = (headless_gpu*)ctx;
+    gpu->width = width;
+    gpu->height = height;
+}
+
+static void headless_fill(NxRect rect) {
+    nx_headless.commands++;
+    nx_headless.covered += (double)rect.width * rect.height;
+}
+
+void nx_gpu_fill_rect(NxGpuContext ctx, NxRect rect, NxColor color) {
+    (void)ctx; (void)color;
+    headless_fill(rect);
+}
+
+void nx_gpu_fill_rounded_rect(NxGpuContext ctx, NxRect rect, NxColor color, float radius) {
+    (void)ctx; (void)color; (void)radius;
+    headless_fill(rect);
+}
+
+void nx_gpu_fill_circle(NxGpuContext ctx, float x, float y, float radius, NxColor color) {
+    (void)ctx; (void)color;
+    headless_fill((NxRect){ x - radius, y - radius, radius * 2, radius * 2 });
+}
+
+void nx_gpu_draw_text(NxGpuContext ctx, const char* text, float x, float y, NxColor color) {
+    (void)ctx; (void)x; (void)y; (void)color;
+    nx_headless.commands++;
+    nx_headless.text_bytes += text ? strlen(text) : 0;
+}
+
+void nx_gpu_clear(NxGpuContext ctx, NxColor color) {
+    headless_gpu* gpu = (headless_gpu*)ctx;
+    (void)color;
+    headless_fill((NxRect){ 0, 0, (float)gpu->width, (float)gpu->height });
+}
+
+void nx_gpu_set_clip(NxGpuContext ctx, NxRect rect) {
+    (void)ctx; (void)rect;
+    nx_headless.commands++;
+}
+
+void nx_gpu_reset_clip(NxGpuContext ctx) {
+    (void)ctx;
+    nx_headless.commands++;
+}
+
+void nx_gpu_submit(NxGpuContext ctx, const NxDrawCmd* cmds, uint32_t count) {
+    (void)ctx;
+    nx_headless.submits++;
+    for (uint32_t i = 0; i < count; i++) {
+        const NxDrawCmd* c = &cmds[i];
+        if (c->kind == NX_DRAW_TEXT) {
+            nx_headless.commands++;
+            nx_headless.text_bytes += c->text ? strlen(c->text) : 0;
+        } else if (c->kind == NX_DRAW_SET_CLIP || c->kind == NX_DRAW_RESET_CLIP) {
+            nx_headless.commands++;
+        } else {
+            headless_fill(c->rect);
+        }
+    }
+}
+
+/* ============================================================================
+ * Theme
+ * ============================================================================ */
+
+NxTheme nx_theme_light(void) { return &headless_theme; }
+NxTheme nx_theme_dark(void) { return &headless_theme; }
+void nx_theme_destroy(NxTheme theme) { (void)theme; }
+NxColor nx_theme_get_primary_color(NxTheme theme) { (void)theme; return (NxColor){ 10, 132, 255, 255 }; }
+NxColor nx_theme_get_background_color(NxTheme theme) { (void)theme; return (NxColor){ 28, 28, 30, 255 }; }
+NxColor nx_theme_get_surface_color(NxTheme theme) { (void)theme; return (NxColor){ 44, 44, 46, 255 }; }
+NxColor nx_theme_get_text_color(NxTheme theme) { (void)theme; return (NxColor){ 255, 255, 255, 255 }; }
+
+/* ============================================================================
+ * Input
+ * ============================================================================ */
+
+NxMouseState nx_mouse_create(void) {
+    return calloc(1, sizeof(headless_mouse));
+}
+
+void nx_mouse_destroy(NxMouseState mouse) {
+    free(mouse);
+}
+
+void nx_mouse_get_position(NxMouseState mouse, float* x, float* y) {
+    headless_mouse* m = (headless_mouse*)mouse;
+    if (x) *x = m->x;
+    if (y) *y = m->y;
+}
+
+bool nx_mouse_is_button_down(NxMouseState mouse, NxMouseButton button) {
+    return ((headless_mouse*)mouse)->down[button];
+}
+
+void nx_mouse_move(NxMouseState mouse, float x, float y) {
+    headless_mouse* m = (headless_mouse*)mouse;
+    m->x = x;
+    m->y = y;
+}
+
+void nx_mouse_button_down(NxMouseState mouse, float x, float y, NxMouseButton button) {
+    nx_mouse_move(mouse, x, y);
+    ((headless_mouse*)mouse)->down[button] = true;
+}
+
+void nx_mouse_button_up(NxMouseState mouse, float x, float y, NxMouseButton button) {
+    nx_mouse_move(mouse, x, y);
+    ((headless_mouse*)mouse)->down[button] = false;
+}
+
+NxKeyboardState nx_keyboard_create(void) { return &headless_keyboard; }
+void nx_keyboard_destroy(NxKeyboardState kb) { (void)kb; }
+bool nx_keyboard_is_ctrl(NxKeyboardState kb) { (void)kb; return false; }
+bool nx_keyboard_is_shift(NxKeyboardState kb) { (void)kb; return false; }
+bool nx_keyboard_is_alt(NxKeyboardState kb) { (void)kb; return false; }
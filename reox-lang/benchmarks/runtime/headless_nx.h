@@ -0,0 +1,25 @@
+/*
+ * REOX Runtime Benchmarks - Headless NXRender
+ * The NXRender FFI used by reox_nxrender_bridge.h, with no window or GPU
+ *
+ * Submitted draw lists are walked and tallied instead of rasterized, so
+ * bridge frames can be timed on machines without a display. Mouse and
+ * keyboard state are plain structs.
+ */
+
+#ifndef REOX_HEADLESS_NX_H
+#define REOX_HEADLESS_NX_H
+
+#include <stdint.h>
+
+typedef struct nx_headless_stats {
+    uint64_t frames;            /* nx_gpu_present calls */
+    uint64_t submits;
+    uint64_t commands;
+    uint64_t text_bytes;
+    double covered;             /* Area of fills, in pixels */
+} nx_headless_stats;
+
+extern nx_headless_stats nx_headless;
+
+#endif /* REOX_HEADLESS_NX_H */
@@ -75,27 +75,25 @@ int main(void) {
     rx_state_int_set(counter, 15);
     rx_state_string_set(username, "Charlie");
     
-    rx_diff_batch diffs = rx_collect_diffs();
+    rx_diff_batch diffs;
+    rx_diff_batch_init(&diffs, 16);   /* Reusable across frames */
+    rx_collect_diffs_into(&diffs);
     printf("   Collected %d diffs:\n", diffs.count);
     for (int i = 0; i < diffs.count; i++) {
         printf("   ");
         rx_print_diff(&diffs.diffs[i]);
     }
     rx_clear_dirty();
-    free(diffs.diffs);
+    rx_diff_batch_free(&diffs);
     printf("\n");
     
     /* No change if value is same */
     printf("6. Setting same value (should NOT trigger change)...\n");
-    int old_count = 0;
-    rx_state* s = rx_state_registry;
-    while (s) { if (s->dirty) old_count++; s = s->next; }
+    int old_count = rx_state_dirty_count();
     
     rx_state_int_set(counter, 15);  /* Same value */
     
-    int new_count = 0;
-    s = rx_state_registry;
-    while (s) { if (s->dirty) new_count++; s = s->next; }
+    int new_count = rx_state_dirty_count();
     
     printf("   Dirty states before: %d, after: %d (should be same)\n\n", old_count, new_count);
     
@@ -0,0 +1,1156 @@
+/*
+ * REOX Accessibility - Implementation
+ * Element tree synced from invalidated views, focus and reading order
+ */
+
+#include "reox_accessibility.h"
+#include "reox_runloop.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+/* Fields set through the element API; sync leaves them alone */
+enum {
+    OVERRIDE_ROLE       = 1 << 0,
+    OVERRIDE_LABEL      = 1 << 1,
+    OVERRIDE_VALUE      = 1 << 2,
+    OVERRIDE_TRAITS     = 1 << 3,
+    OVERRIDE_FOCUSABLE  = 1 << 4,
+    OVERRIDE_HIDDEN     = 1 << 5,
+};
+
+/* Passed down the sync walk */
+enum {
+    SYNC_MOVED          = 1 << 0,     /* Window position may have changed */
+    SYNC_INSERTED       = 1 << 1,     /* Subtree is new to the platform */
+};
+
+/* Queued announcements kept when nothing delivers them */
+#define MAX_ANNOUNCEMENTS 64
+
+static bool grow_array(void** array, size_t* capacity, size_t need, size_t elem) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    void* grown = realloc(*array, cap * elem);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = cap;
+    return true;
+}
+
+/* Replace an owned string; true if the text changed */
+static bool string_set(const char** field, const char* value) {
+    if (*field == value) return false;
+    if (*field && value && strcmp(*field, value) == 0) return false;
+    char* copy = NULL;
+    if (value && !(copy = strdup(value))) return false;
+    free((void*)*field);
+    *field = copy;
+    return true;
+}
+
+/* ============================================================================
+ * Change Batch
+ * ============================================================================ */
+
+static void queue_change(rx_a11y_element* e, uint32_t flags) {
+    rx_a11y_tree* tree = e->tree;
+    if (!tree || !e->attached || !flags) return;
+    if (flags & (RX_A11Y_CREATED | RX_A11Y_REMOVED | RX_A11Y_STATE | RX_A11Y_CHILDREN)) {
+        tree->order_version++;
+    }
+    if (e->change_index) {
+        tree->changes[e->change_index - 1].flags |= flags;
+        return;
+    }
+    if (!grow_array((void**)&tree->changes, &tree->change_capacity, tree->change_count + 1,
+                    sizeof(rx_a11y_change))) {
+        return;
+    }
+    if (tree->change_count == 0) rx_runloop_request_frame(rx_runloop_main());
+    tree->changes[tree->change_count++] = (rx_a11y_change){ e->id, flags, e };
+    e->change_index = (uint32_t)tree->change_count;
+}
+
+/* No longer reported: pending changes below it are moot */
+static void subtree_unattach(rx_a11y_element* e) {
+    e->attached = false;
+    if (e->change_index && e->tree) e->tree->changes[e->change_index - 1].flags = 0;
+    for (size_t i = 0; i < e->child_count; i++) subtree_unattach(e->children[i]);
+}
+
+static void element_detach(rx_a11y_element* e) {
+    if (!e->attached || !e->tree) return;
+    bool created = e->change_index && (e->tree->changes[e->change_index - 1].flags & RX_A11Y_CREATED);
+    uint32_t index = e->change_index;
+    subtree_unattach(e);
+    /* Created and removed within one batch: the platform never saw it */
+    if (created) return;
+    e->attached = true;
+    if (index) e->tree->changes[index - 1].flags = 0;
+    queue_change(e, RX_A11Y_REMOVED);
+    e->attached = false;
+    e->tree->order_version++;
+}
+
+/* ============================================================================
+ * Accessibility Element
+ * ============================================================================ */
+
+static void element_refresh_accessible(rx_a11y_element* e) {
+    bool accessible = e->role != RX_ROLE_NONE || (e->label && e->label[0]);
+    if (e->is_accessible != accessible) {
+        e->is_accessible = accessible;
+        queue_change(e, RX_A11Y_STATE);
+    }
+}
+
+rx_a11y_element* rx_a11y_element_create(rx_view* view) {
+    if (view && view->a11y) return view->a11y;
+    rx_a11y_element* e = (rx_a11y_element*)calloc(1, sizeof(rx_a11y_element));
+    if (!e) return NULL;
+    e->role = RX_ROLE_NONE;
+    e->view = view;
+    if (view) {
+        view->a11y = e;
+        view_set_needs_layout(view);    /* The next sync reaches it */
+    }
+    return e;
+}
+
+void rx_a11y_set_label(rx_a11y_element* elem, const char* label) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_LABEL;
+    if (string_set(&elem->label, label)) queue_change(elem, RX_A11Y_LABEL);
+    element_refresh_accessible(elem);
+}
+
+void rx_a11y_set_hint(rx_a11y_element* elem, const char* hint) {
+    if (elem && string_set(&elem->hint, hint)) queue_change(elem, RX_A11Y_LABEL);
+}
+
+void rx_a11y_set_value(rx_a11y_element* elem, const char* value) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_VALUE;
+    if (string_set(&elem->value, value)) queue_change(elem, RX_A11Y_VALUE);
+}
+
+void rx_a11y_set_role(rx_a11y_element* elem, rx_a11y_role role) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_ROLE;
+    if (elem->role == role) return;
+    elem->role = role;
+    queue_change(elem, RX_A11Y_STATE);
+    element_refresh_accessible(elem);
+}
+
+void rx_a11y_add_trait(rx_a11y_element* elem, rx_a11y_trait trait) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_TRAITS;
+    if ((elem->traits & trait) == (uint32_t)trait) return;
+    elem->traits |= trait;
+    queue_change(elem, RX_A11Y_STATE);
+}
+
+void rx_a11y_remove_trait(rx_a11y_element* elem, rx_a11y_trait trait) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_TRAITS;
+    if (!(elem->traits & trait)) return;
+    elem->traits &= ~(uint32_t)trait;
+    queue_change(elem, RX_A11Y_STATE);
+}
+
+void rx_a11y_set_hidden(rx_a11y_element* elem, bool hidden) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_HIDDEN;
+    if (elem->is_hidden == hidden) return;
+    elem->is_hidden = hidden;
+    queue_change(elem, RX_A11Y_STATE);
+}
+
+void rx_a11y_set_focusable(rx_a11y_element* elem, bool focusable) {
+    if (!elem) return;
+    elem->overrides |= OVERRIDE_FOCUSABLE;
+    if (elem->is_focusable == focusable) return;
+    elem->is_focusable = focusable;
+    queue_change(elem, RX_A11Y_STATE);
+}
+
+void rx_a11y_set_action_handler(rx_a11y_element* elem, rx_a11y_action_handler handler, void* data) {
+    if (!elem) return;
+    elem->action_handler = handler;
+    elem->action_data = data;
+    elem->supported_actions |= 1u << RX_ACTION_ACTIVATE;
+}
+
+void rx_a11y_add_custom_action(rx_a11y_element* elem, const char* name, void (*handler)(void* data), void* data) {
+    if (!elem || !name) return;
+    void* grown = realloc(elem->custom_actions, sizeof(*elem->custom_actions) * (elem->custom_action_count + 1));
+    if (!grown) return;
+    elem->custom_actions = grown;
+    char* copy = strdup(name);
+    if (!copy) return;
+    elem->custom_actions[elem->custom_action_count].name = copy;
+    elem->custom_actions[elem->custom_action_count].handler = handler;
+    elem->custom_actions[elem->custom_action_count].data = data;
+    elem->custom_action_count++;
+    queue_change(elem, RX_A11Y_STATE);
+}
+
+static rx_focus_system* shared_focus;
+static rx_screen_reader* shared_reader;
+
+/* Every live focus system and reader, so a removed element can be dropped
+ * from whichever of them still points at it */
+static rx_focus_system** focus_systems;
+static size_t focus_system_count, focus_system_capacity;
+static rx_screen_reader** readers;
+static size_t reader_count, reader_capacity;
+
+static bool registry_add(void*** list, size_t* count, size_t* capacity, void* item) {
+    if (!grow_array((void**)list, capacity, *count + 1, sizeof(void*))) return false;
+    (*list)[(*count)++] = item;
+    return true;
+}
+
+static void registry_remove(void** list, size_t* count, void* item) {
+    for (size_t i = 0; i < *count; i++) {
+        if (list[i] != item) continue;
+        list[i] = list[--*count];
+        return;
+    }
+}
+
+static void focus_forget(rx_focus_system* sys, const rx_a11y_element* e) {
+    if (sys->focused_element == e) sys->focused_element = NULL;
+    if (sys->trap_container == e) sys->trap_container = NULL;
+    if (sys->focus_ring == e) sys->focus_ring = NULL;
+    sys->order_valid = false;   /* order[] may hold e */
+}
+
+static void reader_forget(rx_screen_reader* sr, const rx_a11y_element* e) {
+    if (sr->current_element == e) sr->current_element = NULL;
+    sr->order_valid = false;
+}
+
+/* Unlink from the element tree and free; the view no longer refers to it */
+static void element_remove(rx_a11y_element* e) {
+    rx_a11y_element* parent = e->parent;
+    if (parent) {
+        for (size_t i = 0; i < parent->child_count; i++) {
+            if (parent->children[i] != e) continue;
+            memmove(&parent->children[i], &parent->children[i + 1],
+                    sizeof(rx_a11y_element*) * (parent->child_count - i - 1));
+            parent->child_count--;
+            queue_change(parent, RX_A11Y_CHILDREN);
+            break;
+        }
+    }
+    element_detach(e);
+    for (size_t i = 0; i < e->child_count; i++) {
+        if (e->children[i]->parent == e) e->children[i]->parent = NULL;
+    }
+
+    rx_a11y_tree* tree = e->tree;
+    if (tree) {
+        if (e->change_index) tree->changes[e->change_index - 1].element = NULL;
+        tree->order_version++;
+    }
+    for (size_t i = 0; i < focus_system_count; i++) focus_forget(focus_systems[i], e);
+    for (size_t i = 0; i < reader_count; i++) reader_forget(readers[i], e);
+
+    free((void*)e->label);
+    free((void*)e->hint);
+    free((void*)e->value);
+    for (size_t i = 0; i < e->custom_action_count; i++) free((void*)e->custom_actions[i].name);
+    free(e->custom_actions);
+    free(e->children);
+    free(e);
+}
+
+void rx_a11y_element_destroy(rx_a11y_element* elem) {
+    if (!elem) return;
+    if (elem->view) {
+        /* A tree recreates a default element at its next sync */
+        elem->view->a11y = NULL;
+        view_set_needs_layout(elem->view);
+    }
+    element_remove(elem);
+}
+
+void rx_a11y_view_released(rx_view* view) {
+    if (!view || !view->a11y) return;
+    rx_a11y_element* e = view->a11y;
+    view->a11y = NULL;
+    e->view = NULL;
+    element_remove(e);
+}
+
+/* ============================================================================
+ * Tree Sync
+ * ============================================================================ */
+
+/* Role, labels and state that follow from the view */
+static uint32_t sync_content(rx_a11y_element* e, rx_view* v) {
+    rx_a11y_role role = RX_ROLE_NONE;
+    uint32_t traits = 0;
+    const char* label = NULL;
+    const char* value = NULL;
+    bool focusable = false;
+
+    switch (v->kind) {
+        case RX_VIEW_TEXT:
+            traits = RX_TRAIT_STATIC_TEXT;
+            label = ((rx_text_view*)v)->text;
+            break;
+        case RX_VIEW_BUTTON:
+            role = RX_ROLE_BUTTON;
+            traits = RX_TRAIT_BUTTON;
+            label = ((rx_button_view*)v)->label;
+            focusable = true;
+            break;
+        case RX_VIEW_INPUT: {
+            rx_input_view* input = (rx_input_view*)v;
+            role = RX_ROLE_TEXTFIELD;
+            label = input->placeholder;
+            value = input->password ? NULL : input->value;
+            focusable = true;
+            break;
+        }
+        case RX_VIEW_IMAGE:
+            role = RX_ROLE_IMAGE;
+            traits = RX_TRAIT_IMAGE;
+            break;
+        case RX_VIEW_SCROLL:
+            role = RX_ROLE_SCROLLAREA;
+            break;
+        case RX_VIEW_LIST:
+            role = RX_ROLE_LIST;
+            break;
+        case RX_VIEW_GRID:
+            role = RX_ROLE_GROUP;
+            break;
+        default:
+            break;
+    }
+    if (!v->enabled) {
+        traits |= RX_TRAIT_DISABLED;
+        focusable = false;
+    }
+
+    uint32_t changed = 0;
+    if (!(e->overrides & OVERRIDE_ROLE) && e->role != role) {
+        e->role = role;
+        changed |= RX_A11Y_STATE;
+    }
+    if (!(e->overrides & OVERRIDE_TRAITS) && e->traits != traits) {
+        e->traits = traits;
+        changed |= RX_A11Y_STATE;
+    }
+    if (!(e->overrides & OVERRIDE_FOCUSABLE) && e->is_focusable != focusable) {
+        e->is_focusable = focusable;
+        changed |= RX_A11Y_STATE;
+    }
+    if (!(e->overrides & OVERRIDE_HIDDEN) && e->is_hidden != !v->visible) {
+        e->is_hidden = !v->visible;
+        changed |= RX_A11Y_STATE;
+    }
+    if (!(e->overrides & OVERRIDE_LABEL) && string_set(&e->label, label)) changed |= RX_A11Y_LABEL;
+    if (!(e->overrides & OVERRIDE_VALUE) && string_set(&e->value, value)) changed |= RX_A11Y_VALUE;
+
+    bool accessible = e->role != RX_ROLE_NONE || (e->label && e->label[0]);
+    if (e->is_accessible != accessible) {
+        e->is_accessible = accessible;
+        changed |= RX_A11Y_STATE;
+    }
+    return changed;
+}
+
+static inline bool rect_same(rx_rect a, rx_rect b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+/*
+ * Visit a view whose parent was visited. Clean subtrees at an unchanged
+ * window position return at once; invalid ones refresh their content and
+ * child list, and a view that moved walks its subtree for frames only.
+ */
+static void sync_view(rx_a11y_tree* tree, rx_view* v, rx_a11y_element* parent, float ox, float oy, unsigned flags) {
+    rx_a11y_element* e = v->a11y;
+    if (!e && !(e = rx_a11y_element_create(v))) return;
+    if (e->tree != tree || !e->attached) flags |= SYNC_INSERTED;
+    e->epoch = tree->epoch;
+    e->parent = parent;
+    tree->elements_visited++;
+
+    bool dirty = !v->a11y_valid || (flags & SYNC_INSERTED) ||
+                 (!(e->overrides & OVERRIDE_HIDDEN) && e->is_hidden != !v->visible);
+    if (!dirty && !(flags & SYNC_MOVED)) return;
+
+    uint32_t changed = 0;
+    if (flags & SYNC_INSERTED) {
+        e->tree = tree;
+        if (!e->id) e->id = ++tree->next_id;
+        e->attached = true;
+        changed |= RX_A11Y_CREATED;
+    }
+
+    rx_rect frame = rect(ox + v->box.frame.x, oy + v->box.frame.y, v->box.frame.width, v->box.frame.height);
+    unsigned child_flags = flags & SYNC_INSERTED;
+    if (!rect_same(frame, e->accessible_frame)) {
+        e->accessible_frame = frame;
+        e->activation_point = point(frame.x + frame.width * 0.5f, frame.y + frame.height * 0.5f);
+        changed |= RX_A11Y_FRAME;
+        child_flags |= SYNC_MOVED;
+    }
+    if (dirty) {
+        changed |= sync_content(e, v);
+        child_flags |= SYNC_MOVED;      /* Children may have moved inside v */
+    }
+    /* A new element is reported whole */
+    queue_change(e, (changed & RX_A11Y_CREATED) ? RX_A11Y_CREATED : changed);
+
+    /* Hidden subtrees wait, still invalid, until the view is shown */
+    if (!v->visible) return;
+
+    if (!dirty) {
+        if (!(child_flags & SYNC_MOVED)) return;
+        for (size_t i = 0; i < v->child_count; i++) {
+            sync_view(tree, v->children[i], e, frame.x, frame.y, child_flags);
+        }
+        return;
+    }
+
+    /* Former children not reached again by the end of the sync are gone */
+    if (e->child_count > 0 &&
+        grow_array((void**)&tree->orphans, &tree->orphan_capacity, tree->orphan_count + e->child_count,
+                   sizeof(rx_a11y_element*))) {
+        memcpy(&tree->orphans[tree->orphan_count], e->children, sizeof(rx_a11y_element*) * e->child_count);
+        tree->orphan_count += e->child_count;
+    }
+    if (!grow_array((void**)&e->children, &e->child_capacity, v->child_count, sizeof(rx_a11y_element*))) {
+        v->a11y_valid = false;
+        return;
+    }
+    size_t old_count = e->child_count, n = 0;
+    bool children_changed = false;
+    for (size_t i = 0; i < v->child_count; i++) {
+        rx_view* child = v->children[i];
+        sync_view(tree, child, e, frame.x, frame.y, child_flags);
+        if (!child->a11y) continue;
+        if (n >= old_count || e->children[n] != child->a11y) children_changed = true;
+        e->children[n++] = child->a11y;
+    }
+    if (n != old_count) children_changed = true;
+    e->child_count = n;
+    if (children_changed && !(changed & RX_A11Y_CREATED)) queue_change(e, RX_A11Y_CHILDREN);
+    v->a11y_valid = true;
+}
+
+rx_a11y_tree* rx_a11y_tree_create(rx_view* root, const rx_a11y_bridge* bridge) {
+    rx_a11y_tree* tree = (rx_a11y_tree*)calloc(1, sizeof(rx_a11y_tree));
+    if (!tree) return NULL;
+    tree->root = root;
+    if (bridge) tree->bridge = *bridge;
+
+    /* Claimed now so the window's layout hook finds the tree */
+    if (root) {
+        rx_a11y_element* e = rx_a11y_element_create(root);
+        if (e) e->tree = tree;
+    }
+    return tree;
+}
+
+void rx_a11y_tree_sync(rx_a11y_tree* tree) {
+    if (!tree || !tree->root) return;
+    tree->syncs++;
+    tree->epoch++;
+    tree->orphan_count = 0;
+
+    sync_view(tree, tree->root, NULL, 0, 0, 0);
+
+    for (size_t i = 0; i < tree->orphan_count; i++) {
+        rx_a11y_element* e = tree->orphans[i];
+        if (e->epoch == tree->epoch) continue;      /* Moved, not removed */
+        element_detach(e);
+        e->parent = NULL;
+    }
+    tree->orphan_count = 0;
+}
+
+void rx_a11y_tree_flush(rx_a11y_tree* tree) {
+    if (!tree) return;
+    rx_a11y_tree_sync(tree);
+
+    size_t n = 0;
+    for (size_t i = 0; i < tree->change_count; i++) {
+        rx_a11y_change c = tree->changes[i];
+        if (c.element) c.element->change_index = 0;
+        if (c.flags) tree->changes[n++] = c;
+    }
+    tree->change_count = 0;
+    if (n > 0 && tree->bridge.apply) tree->bridge.apply(tree->changes, n, tree->bridge.ctx);
+    tree->changes_sent += n;
+
+    rx_screen_reader* sr = tree->reader;
+    if (sr) {
+        for (size_t i = 0; i < sr->announcement_count; i++) {
+            if (tree->bridge.announce) {
+                tree->bridge.announce(sr->announcements[i].text, sr->announcements[i].interrupt,
+                                      tree->bridge.ctx);
+            }
+            free((void*)sr->announcements[i].text);
+        }
+        sr->announcement_count = 0;
+    }
+}
+
+static void tree_release_views(rx_view* v) {
+    v->a11y_valid = false;
+    if (v->a11y) {
+        v->a11y->tree = NULL;
+        v->a11y->attached = false;
+        v->a11y->change_index = 0;
+        v->a11y->parent = NULL;
+        v->a11y->child_count = 0;
+    }
+    for (size_t i = 0; i < v->child_count; i++) tree_release_views(v->children[i]);
+}
+
+void rx_a11y_tree_destroy(rx_a11y_tree* tree) {
+    if (!tree) return;
+    if (tree->root) tree_release_views(tree->root);
+    for (size_t i = 0; i < reader_count; i++) {
+        if (readers[i]->tree == tree) rx_screen_reader_set_tree(readers[i], NULL);
+    }
+    for (size_t i = 0; i < focus_system_count; i++) {
+        if (focus_systems[i]->tree == tree) rx_focus_system_set_tree(focus_systems[i], NULL);
+    }
+    free(tree->changes);
+    free(tree->orphans);
+    free(tree);
+}
+
+void rx_a11y_view_laid_out(rx_view* root) {
+    if (!root || !root->a11y) return;
+    rx_a11y_tree* tree = root->a11y->tree;
+    if (tree && tree->root == root) rx_a11y_tree_flush(tree);
+}
+
+/* ============================================================================
+ * Focus and Reading Order
+ * ============================================================================ */
+
+static bool element_focusable(const rx_a11y_element* e) {
+    return e->is_focusable && !(e->traits & RX_TRAIT_DISABLED) && e->navigation_order >= 0;
+}
+
+static bool element_readable(const rx_a11y_element* e) {
+    return e->is_accessible;
+}
+
+/* Pre-order walk, skipping hidden subtrees */
+static void order_collect(rx_a11y_element* e, bool (*want)(const rx_a11y_element*),
+                          rx_a11y_element*** order, size_t* count, size_t* capacity) {
+    if (e->is_hidden) return;
+    if (want(e) && grow_array((void**)order, capacity, *count + 1, sizeof(rx_a11y_element*))) {
+        (*order)[(*count)++] = e;
+    }
+    for (size_t i = 0; i < e->child_count; i++) order_collect(e->children[i], want, order, count, capacity);
+}
+
+/* Positive navigation_order first, ascending; ties and the rest by tree order */
+static int focus_compare(const void* a, const void* b) {
+    const rx_a11y_element* x = *(rx_a11y_element* const*)a;
+    const rx_a11y_element* y = *(rx_a11y_element* const*)b;
+    unsigned kx = x->navigation_order > 0 ? (unsigned)x->navigation_order : ~0u;
+    unsigned ky = y->navigation_order > 0 ? (unsigned)y->navigation_order : ~0u;
+    if (kx != ky) return kx < ky ? -1 : 1;
+    return x->focus_index < y->focus_index ? -1 : (x->focus_index > y->focus_index);
+}
+
+static rx_a11y_element* tree_root_element(rx_a11y_tree* tree) {
+    return tree && tree->root ? tree->root->a11y : NULL;
+}
+
+static void focus_order_update(rx_focus_system* sys) {
+    uint32_t version = sys->tree ? sys->tree->order_version : 0;
+    if (sys->order_valid && sys->order_version == version) return;
+
+    rx_a11y_element* scope = sys->trap_container ? sys->trap_container : tree_root_element(sys->tree);
+    size_t count = 0;
+    if (scope) order_collect(scope, element_focusable, &sys->order, &count, &sys->order_capacity);
+
+    bool ordered = false;
+    for (size_t i = 0; i < count; i++) {
+        sys->order[i]->focus_index = i;
+        if (sys->order[i]->navigation_order > 0) ordered = true;
+    }
+    if (ordered) {
+        qsort(sys->order, count, sizeof(rx_a11y_element*), focus_compare);
+        for (size_t i = 0; i < count; i++) sys->order[i]->focus_index = i;
+    }
+    sys->focus_count = count;
+    sys->focus_ring = count ? sys->order[0] : NULL;
+    sys->order_version = version;
+    sys->order_valid = true;
+}
+
+/* Position of elem in the focus order, or count if it is not in it */
+static size_t focus_position(rx_focus_system* sys, rx_a11y_element* elem) {
+    if (elem && elem->focus_index < sys->focus_count && sys->order[elem->focus_index] == elem) {
+        return elem->focus_index;
+    }
+    return sys->focus_count;
+}
+
+static void reading_order_update(rx_screen_reader* sr) {
+    uint32_t version = sr->tree ? sr->tree->order_version : 0;
+    if (sr->order_valid && sr->order_version == version) return;
+    rx_a11y_element* root = tree_root_element(sr->tree);
+    sr->order_count = 0;
+    if (root) order_collect(root, element_readable, &sr->order, &sr->order_count, &sr->order_capacity);
+    for (size_t i = 0; i < sr->order_count; i++) sr->order[i]->reading_index = i;
+    sr->order_version = version;
+    sr->order_valid = true;
+}
+
+/* ============================================================================
+ * Focus Management
+ * ============================================================================ */
+
+rx_focus_system* rx_focus_system_create(void) {
+    rx_focus_system* sys = (rx_focus_system*)calloc(1, sizeof(rx_focus_system));
+    if (!sys) return NULL;
+    sys->show_focus_ring = true;
+    sys->focus_ring_color = RX_COLOR_BLUE;
+    sys->focus_ring_width = 2.0f;
+    if (!registry_add((void***)&focus_systems, &focus_system_count, &focus_system_capacity, sys)) {
+        free(sys);
+        return NULL;
+    }
+    return sys;
+}
+
+void rx_focus_system_set_tree(rx_focus_system* sys, rx_a11y_tree* tree) {
+    if (!sys) return;
+    sys->tree = tree;
+    sys->trap_container = NULL;
+    sys->order_valid = false;
+    sys->focused_element = NULL;
+}
+
+void rx_focus_set(rx_focus_system* sys, rx_a11y_element* elem) {
+    if (!sys || sys->focused_element == elem) return;
+    rx_a11y_element* old = sys->focused_element;
+    if (old) {
+        old->is_focused = false;
+        if (old->view) old->view->focused = false;
+        queue_change(old, RX_A11Y_FOCUS);
+    }
+    sys->focused_element = elem;
+    if (elem) {
+        elem->is_focused = true;
+        if (elem->view) elem->view->focused = true;
+        queue_change(elem, RX_A11Y_FOCUS);
+    }
+}
+
+void rx_focus_next(rx_focus_system* sys) {
+    if (!sys) return;
+    focus_order_update(sys);
+    if (sys->focus_count == 0) return;
+    size_t at = focus_position(sys, sys->focused_element);
+    rx_focus_set(sys, sys->order[at < sys->focus_count ? (at + 1) % sys->focus_count : 0]);
+}
+
+void rx_focus_previous(rx_focus_system* sys) {
+    if (!sys) return;
+    focus_order_update(sys);
+    if (sys->focus_count == 0) return;
+    size_t at = focus_position(sys, sys->focused_element);
+    rx_focus_set(sys, sys->order[at < sys->focus_count ? (at + sys->focus_count - 1) % sys->focus_count
+                                                       : sys->focus_count - 1]);
+}
+
+void rx_focus_first(rx_focus_system* sys) {
+    if (!sys) return;
+    focus_order_update(sys);
+    if (sys->focus_count > 0) rx_focus_set(sys, sys->order[0]);
+}
+
+void rx_focus_last(rx_focus_system* sys) {
+    if (!sys) return;
+    focus_order_update(sys);
+    if (sys->focus_count > 0) rx_focus_set(sys, sys->order[sys->focus_count - 1]);
+}
+
+rx_a11y_element* rx_focus_current(rx_focus_system* sys) {
+    return sys ? sys->focused_element : NULL;
+}
+
+void rx_focus_trap(rx_focus_system* sys, rx_a11y_element* container) {
+    if (!sys) return;
+    sys->trap_container = container;
+    sys->order_valid = false;
+    focus_order_update(sys);
+    if (focus_position(sys, sys->focused_element) == sys->focus_count) {
+        rx_focus_set(sys, sys->focus_count ? sys->order[0] : NULL);
+    }
+}
+
+void rx_focus_release_trap(rx_focus_system* sys) {
+    if (!sys) return;
+    sys->trap_container = NULL;
+    sys->order_valid = false;
+}
+
+void rx_focus_system_destroy(rx_focus_system* sys) {
+    if (!sys) return;
+    if (sys == shared_focus) shared_focus = NULL;
+    registry_remove((void**)focus_systems, &focus_system_count, sys);
+    free(sys->order);
+    free(sys);
+}
+
+rx_focus_system* rx_focus_system_shared(void) {
+    if (!shared_focus) shared_focus = rx_focus_system_create();
+    return shared_focus;
+}
+
+/* ============================================================================
+ * Accessibility Preferences
+ * ============================================================================ */
+
+static rx_a11y_preferences prefs;
+static bool prefs_ready;
+
+typedef struct pref_observer {
+    rx_a11y_pref_callback callback;
+    void* user_data;
+} pref_observer;
+
+static pref_observer* observers;
+static size_t observer_count, observer_capacity;
+
+static void prefs_defaults(rx_a11y_preferences* p) {
+    memset(p, 0, sizeof(*p));
+    p->auto_play_animations = true;
+    p->bold_text_scale = 1.0f;
+    p->font_scale = 1.0f;
+    p->speech_rate = 180.0f;
+    p->voice_pitch = 1.0f;
+    p->color_filter_intensity = 1.0f;
+}
+
+static void prefs_notify(void) {
+    for (size_t i = 0; i < observer_count; i++) observers[i].callback(&prefs, observers[i].user_data);
+}
+
+rx_a11y_preferences* rx_a11y_preferences_get(void) {
+    if (!prefs_ready) {
+        prefs_defaults(&prefs);
+        prefs_ready = true;
+    }
+    return &prefs;
+}
+
+void rx_a11y_preferences_set(rx_a11y_preferences* p) {
+    if (!p) return;
+    prefs = *p;
+    prefs_ready = true;
+    prefs_notify();
+}
+
+void rx_a11y_preferences_reset(void) {
+    prefs_defaults(&prefs);
+    prefs_ready = true;
+    prefs_notify();
+}
+
+void rx_a11y_observe_preferences(rx_a11y_pref_callback callback, void* user_data) {
+    if (!callback) return;
+    if (!grow_array((void**)&observers, &observer_capacity, observer_count + 1, sizeof(pref_observer))) return;
+    observers[observer_count++] = (pref_observer){ callback, user_data };
+}
+
+bool rx_a11y_prefers_reduced_motion(void) {
+    return rx_a11y_preferences_get()->reduce_motion;
+}
+
+float rx_a11y_animation_duration(float normal_duration) {
+    return rx_a11y_prefers_reduced_motion() ? 0.0f : normal_duration;
+}
+
+rx_easing rx_a11y_animation_easing(rx_easing normal_easing) {
+    return rx_a11y_prefers_reduced_motion() ? RX_EASE_LINEAR : normal_easing;
+}
+
+bool rx_a11y_should_skip_animation(void) {
+    rx_a11y_preferences* p = rx_a11y_preferences_get();
+    return p->reduce_motion || !p->auto_play_animations;
+}
+
+/* ============================================================================
+ * Screen Reader
+ * ============================================================================ */
+
+rx_screen_reader* rx_screen_reader_create(void) {
+    rx_screen_reader* sr = (rx_screen_reader*)calloc(1, sizeof(rx_screen_reader));
+    if (!sr) return NULL;
+    rx_a11y_preferences* p = rx_a11y_preferences_get();
+    sr->enabled = p->voice_over_enabled;
+    sr->speech_rate = p->speech_rate;
+    if (!registry_add((void***)&readers, &reader_count, &reader_capacity, sr)) {
+        free(sr);
+        return NULL;
+    }
+    return sr;
+}
+
+void rx_screen_reader_set_tree(rx_screen_reader* sr, rx_a11y_tree* tree) {
+    if (!sr) return;
+    if (sr->tree && sr->tree->reader == sr) sr->tree->reader = NULL;
+    sr->tree = tree;
+    if (tree) tree->reader = sr;
+    sr->current_element = NULL;
+    sr->order_valid = false;
+}
+
+static void announcements_clear(rx_screen_reader* sr) {
+    for (size_t i = 0; i < sr->announcement_count; i++) free((void*)sr->announcements[i].text);
+    sr->announcement_count = 0;
+}
+
+static void announce(rx_screen_reader* sr, const char* text, bool interrupt, bool important) {
+    if (!sr || !text) return;
+    if (interrupt) announcements_clear(sr);
+    if (sr->announcement_count == MAX_ANNOUNCEMENTS) {
+        /* Nothing is delivering them: drop the oldest */
+        free((void*)sr->announcements[0].text);
+        memmove(&sr->announcements[0], &sr->announcements[1],
+                sizeof(*sr->announcements) * (sr->announcement_count - 1));
+        sr->announcement_count--;
+    }
+    if (!grow_array((void**)&sr->announcements, &sr->announcement_capacity, sr->announcement_count + 1,
+                    sizeof(*sr->announcements))) {
+        return;
+    }
+    char* copy = strdup(text);
+    if (!copy) return;
+    sr->announcements[sr->announcement_count].text = copy;
+    sr->announcements[sr->announcement_count].interrupt = interrupt;
+    sr->announcements[sr->announcement_count].is_important = important;
+    sr->announcement_count++;
+    if (sr->tree) rx_runloop_request_frame(rx_runloop_main());
+}
+
+void rx_screen_reader_announce(rx_screen_reader* sr, const char* text, bool interrupt) {
+    announce(sr, text, interrupt, false);
+}
+
+void rx_screen_reader_announce_important(rx_screen_reader* sr, const char* text) {
+    announce(sr, text, true, true);
+}
+
+/* "Label, value, hint" for the cursor */
+static void speak_element(rx_screen_reader* sr, rx_a11y_element* e, bool interrupt) {
+    char text[512];
+    int len = snprintf(text, sizeof(text), "%s", e->label ? e->label : "");
+    if (e->value && e->value[0] && len < (int)sizeof(text)) {
+        len += snprintf(text + len, sizeof(text) - (size_t)len, "%s%s", len ? ", " : "", e->value);
+    }
+    if (e->hint && e->hint[0] && len < (int)sizeof(text)) {
+        snprintf(text + len, sizeof(text) - (size_t)len, "%s%s", len ? ", " : "", e->hint);
+    }
+    announce(sr, text, interrupt, false);
+}
+
+static void reader_move(rx_screen_reader* sr, bool forward) {
+    if (!sr) return;
+    reading_order_update(sr);
+    if (sr->order_count == 0) return;
+    rx_a11y_element* cur = sr->current_element;
+    size_t at = cur && cur->reading_index < sr->order_count && sr->order[cur->reading_index] == cur
+              ? cur->reading_index : sr->order_count;
+    size_t next;
+    if (at == sr->order_count) next = forward ? 0 : sr->order_count - 1;
+    else if (forward) next = at + 1 < sr->order_count ? at + 1 : at;    /* Stops at the ends */
+    else next = at > 0 ? at - 1 : 0;
+    sr->current_element = sr->order[next];
+    speak_element(sr, sr->current_element, true);
+}
+
+void rx_screen_reader_move_next(rx_screen_reader* sr) {
+    reader_move(sr, true);
+}
+
+void rx_screen_reader_move_previous(rx_screen_reader* sr) {
+    reader_move(sr, false);
+}
+
+void rx_screen_reader_activate(rx_screen_reader* sr) {
+    if (!sr || !sr->current_element) return;
+    rx_a11y_element* e = sr->current_element;
+    if (e->action_handler && e->action_handler(RX_ACTION_ACTIVATE, e->action_data)) return;
+    if (e->view && e->view->kind == RX_VIEW_BUTTON) {
+        rx_button_view* button = (rx_button_view*)e->view;
+        if (button->on_click) button->on_click(button->callback_data);
+    }
+}
+
+void rx_screen_reader_escape(rx_screen_reader* sr) {
+    if (!sr) return;
+    for (rx_a11y_element* e = sr->current_element; e; e = e->parent) {
+        if (e->action_handler && e->action_handler(RX_ACTION_ESCAPE, e->action_data)) return;
+    }
+}
+
+void rx_screen_reader_read_all(rx_screen_reader* sr) {
+    if (!sr) return;
+    reading_order_update(sr);
+    rx_a11y_element* cur = sr->current_element;
+    size_t from = cur && cur->reading_index < sr->order_count && sr->order[cur->reading_index] == cur
+                ? cur->reading_index : 0;
+    for (size_t i = from; i < sr->order_count; i++) speak_element(sr, sr->order[i], i == from);
+}
+
+void rx_screen_reader_destroy(rx_screen_reader* sr) {
+    if (!sr) return;
+    if (sr == shared_reader) shared_reader = NULL;
+    registry_remove((void**)readers, &reader_count, sr);
+    if (sr->tree && sr->tree->reader == sr) sr->tree->reader = NULL;
+    announcements_clear(sr);
+    free(sr->announcements);
+    free(sr->order);
+    free(sr);
+}
+
+static rx_screen_reader* reader_shared(void) {
+    if (!shared_reader) shared_reader = rx_screen_reader_create();
+    return shared_reader;
+}
+
+void rx_a11y_announce(const char* message) {
+    rx_a11y_announce_polite(message);
+}
+
+void rx_a11y_announce_polite(const char* message) {
+    announce(reader_shared(), message, false, false);
+}
+
+void rx_a11y_announce_assertive(const char* message) {
+    announce(reader_shared(), message, true, true);
+}
+
+/* ============================================================================
+ * Keyboard Navigation
+ * ============================================================================ */
+
+rx_keyboard_nav* rx_keyboard_nav_create(void) {
+    rx_keyboard_nav* nav = (rx_keyboard_nav*)calloc(1, sizeof(rx_keyboard_nav));
+    if (!nav) return NULL;
+    nav->arrow_navigation = true;
+    nav->tab_navigation = true;
+    return nav;
+}
+
+void rx_keyboard_add_shortcut(rx_keyboard_nav* nav, const char* key, uint32_t modifiers, const char* desc,
+                              void (*handler)(void* data), void* data) {
+    if (!nav || !key || !handler) return;
+    rx_keyboard_shortcut* s = (rx_keyboard_shortcut*)realloc(
+        nav->shortcuts, sizeof(rx_keyboard_shortcut) * (nav->shortcut_count + 1));
+    if (!s) return;
+    nav->shortcuts = s;
+    s[nav->shortcut_count++] = (rx_keyboard_shortcut){
+        strdup(key), modifiers, desc ? strdup(desc) : NULL, handler, data
+    };
+}
+
+void rx_keyboard_remove_shortcut(rx_keyboard_nav* nav, const char* key, uint32_t modifiers) {
+    if (!nav || !key) return;
+    for (size_t i = 0; i < nav->shortcut_count; i++) {
+        rx_keyboard_shortcut* s = &nav->shortcuts[i];
+        if (s->modifiers != modifiers || !s->key || strcmp(s->key, key) != 0) continue;
+        free((void*)s->key);
+        free((void*)s->description);
+        memmove(s, s + 1, sizeof(rx_keyboard_shortcut) * (nav->shortcut_count - i - 1));
+        nav->shortcut_count--;
+        return;
+    }
+}
+
+bool rx_keyboard_process_key(rx_keyboard_nav* nav, const char* key, uint32_t modifiers) {
+    if (!nav || !key) return false;
+    for (size_t i = 0; i < nav->shortcut_count; i++) {
+        rx_keyboard_shortcut* s = &nav->shortcuts[i];
+        if (s->modifiers == modifiers && s->key && strcmp(s->key, key) == 0) {
+            s->handler(s->data);
+            return true;
+        }
+    }
+
+    rx_focus_system* focus = rx_focus_system_shared();
+    if (nav->tab_navigation && strcmp(key, "Tab") == 0) {
+        if (modifiers & RX_MOD_SHIFT) rx_focus_previous(focus);
+        else rx_focus_next(focus);
+        return true;
+    }
+    if (nav->arrow_navigation && modifiers == RX_MOD_NONE && focus->focused_element) {
+        if (strcmp(key, "Down") == 0 || strcmp(key, "Right") == 0) {
+            rx_focus_next(focus);
+            return true;
+        }
+        if (strcmp(key, "Up") == 0 || strcmp(key, "Left") == 0) {
+            rx_focus_previous(focus);
+            return true;
+        }
+    }
+    return false;
+}
+
+void rx_keyboard_nav_destroy(rx_keyboard_nav* nav) {
+    if (!nav) return;
+    for (size_t i = 0; i < nav->shortcut_count; i++) {
+        free((void*)nav->shortcuts[i].key);
+        free((void*)nav->shortcuts[i].description);
+    }
+    free(nav->shortcuts);
+    free(nav);
+}
+
+/* ============================================================================
+ * Live Regions
+ * ============================================================================ */
+
+rx_live_region* rx_live_region_create(rx_a11y_element* elem, rx_live_behavior behavior) {
+    rx_live_region* region = (rx_live_region*)calloc(1, sizeof(rx_live_region));
+    if (!region) return NULL;
+    region->element = elem;
+    region->behavior = behavior;
+    region->relevant = "additions text";
+    if (elem) rx_a11y_add_trait(elem, RX_TRAIT_UPDATES_FREQ);
+    return region;
+}
+
+void rx_live_region_update(rx_live_region* region, const char* content) {
+    if (!region) return;
+    if (region->element) rx_a11y_set_value(region->element, content);
+    if (region->behavior == RX_LIVE_OFF || !content) return;
+
+    char text[512];
+    const char* label = region->element ? region->element->label : NULL;
+    if (region->atomic && label && label[0]) {
+        snprintf(text, sizeof(text), "%s, %s", label, content);
+    } else {
+        snprintf(text, sizeof(text), "%s", content);
+    }
+    if (region->behavior == RX_LIVE_ASSERTIVE) rx_a11y_announce_assertive(text);
+    else rx_a11y_announce_polite(text);
+}
+
+void rx_live_region_destroy(rx_live_region* region) {
+    free(region);
+}
+
+/* ============================================================================
+ * Accessibility Auditing
+ * ============================================================================ */
+
+static float channel_luminance(uint8_t c) {
+    float v = c / 255.0f;
+    return v <= 0.03928f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+}
+
+static float color_luminance(rx_color c) {
+    return 0.2126f * channel_luminance(c.r) + 0.7152f * channel_luminance(c.g) + 0.0722f * channel_luminance(c.b);
+}
+
+/* WCAG AA for body text */
+bool rx_a11y_check_contrast(rx_color foreground, rx_color background) {
+    float a = color_luminance(foreground), b = color_luminance(background);
+    float ratio = (fmaxf(a, b) + 0.05f) / (fminf(a, b) + 0.05f);
+    return ratio >= 4.5f;
+}
+
+bool rx_a11y_check_touch_target(rx_rect bounds) {
+    return bounds.width >= 44.0f && bounds.height >= 44.0f;
+}
+
+bool rx_a11y_check_label(rx_a11y_element* elem) {
+    return elem && elem->label && elem->label[0];
+}
+
+static void audit_add(rx_a11y_audit_result* result, size_t* capacity, const char* type, const char* message,
+                      const char* fix, rx_a11y_element* elem, rx_rect bounds) {
+    if (!grow_array((void**)&result->issues, capacity, result->issue_count + 1, sizeof(rx_a11y_issue))) return;
+    result->issues[result->issue_count++] = (rx_a11y_issue){ type, message, fix, elem, bounds };
+    if (strcmp(type, "error") == 0) result->error_count++;
+    else if (strcmp(type, "warning") == 0) result->warning_count++;
+}
+
+static void audit_view(rx_a11y_audit_result* result, size_t* capacity, rx_view* v, float ox, float oy,
+                       rx_color background, bool has_background) {
+    if (!v->visible) return;
+    rx_a11y_element* e = v->a11y;
+    rx_rect bounds = rect(ox + v->box.frame.x, oy + v->box.frame.y, v->box.frame.width, v->box.frame.height);
+    if (v->box.background.a > 0) {
+        background = v->box.background;
+        has_background = true;
+    }
+
+    const char* label = e ? e->label : NULL;
+    bool interactive = v->kind == RX_VIEW_BUTTON || v->kind == RX_VIEW_INPUT || (e && e->is_focusable);
+    if (!e || !(e->overrides & OVERRIDE_LABEL)) {
+        if (v->kind == RX_VIEW_BUTTON) label = ((rx_button_view*)v)->label;
+        else if (v->kind == RX_VIEW_INPUT) label = ((rx_input_view*)v)->placeholder;
+    }
+    if ((interactive || v->kind == RX_VIEW_IMAGE) && !(label && label[0]) && !(e && e->is_hidden)) {
+        audit_add(result, capacity, "error",
+                  v->kind == RX_VIEW_IMAGE ? "Image has no description" : "Control has no label",
+                  "Set a label with rx_a11y_set_label", e, bounds);
+    }
+    if (interactive && !rx_a11y_check_touch_target(bounds)) {
+        audit_add(result, capacity, "warning", "Touch target is smaller than 44x44",
+                  "Increase the size or padding of the control", e, bounds);
+    }
+    if (v->kind == RX_VIEW_TEXT && has_background &&
+        !rx_a11y_check_contrast(((rx_text_view*)v)->color, background)) {
+        audit_add(result, capacity, "warning", "Text contrast is below 4.5:1",
+                  "Darken or lighten the text or its background", e, bounds);
+    }
+
+    for (size_t i = 0; i < v->child_count; i++) {
+        audit_view(result, capacity, v->children[i], bounds.x, bounds.y, background, has_background);
+    }
+}
+
+rx_a11y_audit_result* rx_a11y_audit(rx_view* root) {
+    rx_a11y_audit_result* result = (rx_a11y_audit_result*)calloc(1, sizeof(rx_a11y_audit_result));
+    if (!result) return NULL;
+    size_t capacity = 0;
+    if (root) audit_view(result, &capacity, root, 0, 0, RX_COLOR_WHITE, false);
+    float score = 100.0f - 10.0f * result->error_count - 4.0f * result->warning_count;
+    result->score = score < 0 ? 0 : score;
+    return result;
+}
+
+void rx_a11y_audit_print(rx_a11y_audit_result* result) {
+    if (!result) return;
+    printf("Accessibility audit: score %.0f, %d errors, %d warnings\n",
+           result->score, result->error_count, result->warning_count);
+    for (size_t i = 0; i < result->issue_count; i++) {
+        rx_a11y_issue* issue = &result->issues[i];
+        printf("  [%s] %s at (%.0f, %.0f %.0fx%.0f): %s\n", issue->type, issue->message,
+               issue->highlight_rect.x, issue->highlight_rect.y,
+               issue->highlight_rect.width, issue->highlight_rect.height, issue->fix);
+    }
+}
+
+void rx_a11y_audit_destroy(rx_a11y_audit_result* result) {
+    if (!result) return;
+    free(result->issues);
+    free(result);
+}
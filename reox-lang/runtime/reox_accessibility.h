@@ -9,12 +9,24 @@
  * - High contrast modes
  * - Font scaling
  * - Focus management
+ * - Element tree kept in sync with the view tree incrementally: a sync
+ *   walks only subtrees whose views were invalidated (the same flags as
+ *   layout), and only elements that changed are reported
+ * - Changes batched per frame, one call to the platform bridge
+ * - Focus and reading order precomputed, rebuilt only after changes
+ *
+ * An rx_a11y_tree mirrors a view tree with one element per view, owned
+ * by the view and freed with it. Role, label, value and state follow the
+ * view kind (text, button label, input value, ...) unless set through
+ * the element API. app_run syncs and flushes after each layout; other
+ * hosts call rx_a11y_tree_flush once per frame, after layout.
  */
 
 #ifndef REOX_ACCESSIBILITY_H
 #define REOX_ACCESSIBILITY_H
 
 #include "reox_ui.h"
+#include "reox_animation.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -106,6 +118,8 @@ typedef enum rx_a11y_action {
 
 typedef bool (*rx_a11y_action_handler)(rx_a11y_action action, void* user_data);
 
+struct rx_a11y_tree;
+
 /* ============================================================================
  * Accessibility Element
  * ============================================================================ */
@@ -155,12 +169,24 @@ typedef struct rx_a11y_element {
     rx_view* view;
     
     struct rx_a11y_element* next;
+    
+    /* Tree sync */
+    struct rx_a11y_tree* tree;
+    uint32_t id;              /* Stable id for the platform bridge */
+    uint32_t overrides;       /* Fields set through the API, not derived */
+    uint32_t epoch;           /* Last sync that reached this element */
+    uint32_t change_index;    /* 1 + slot in the pending batch, 0: none */
+    bool attached;            /* Reported to the platform */
+    size_t child_capacity;
+    size_t focus_index;       /* Positions in the cached orders */
+    size_t reading_index;
 } rx_a11y_element;
 
 /* ============================================================================
  * Accessibility Element API
  * ============================================================================ */
 
+/* The view's element, created if it has none */
 extern rx_a11y_element* rx_a11y_element_create(rx_view* view);
 extern void rx_a11y_set_label(rx_a11y_element* elem, const char* label);
 extern void rx_a11y_set_hint(rx_a11y_element* elem, const char* hint);
@@ -180,7 +206,7 @@ extern void rx_a11y_element_destroy(rx_a11y_element* elem);
 
 typedef struct rx_focus_system {
     rx_a11y_element* focused_element;
-    rx_a11y_element* focus_ring;  /* All focusable elements */
+    rx_a11y_element* focus_ring;  /* First element of the focus order */
     size_t focus_count;
     
     /* Focus trap (for modals) */
@@ -190,9 +216,19 @@ typedef struct rx_focus_system {
     bool show_focus_ring;
     rx_color focus_ring_color;
     float focus_ring_width;
+    
+    /* Focusable elements under the trap container or the tree root:
+     * positive navigation_order first, then tree order. Rebuilt when the
+     * tree's order_version moves on, not per step. */
+    struct rx_a11y_tree* tree;
+    rx_a11y_element** order;
+    size_t order_capacity;
+    uint32_t order_version;
+    bool order_valid;
 } rx_focus_system;
 
 extern rx_focus_system* rx_focus_system_create(void);
+extern void rx_focus_system_set_tree(rx_focus_system* sys, struct rx_a11y_tree* tree);
 extern void rx_focus_set(rx_focus_system* sys, rx_a11y_element* elem);
 extern void rx_focus_next(rx_focus_system* sys);
 extern void rx_focus_previous(rx_focus_system* sys);
@@ -267,9 +303,20 @@ typedef struct rx_screen_reader {
         bool is_important;
     }* announcements;
     size_t announcement_count;
+    size_t announcement_capacity;
+    
+    /* Reading order: accessible, visible elements in tree order, cached
+     * like the focus order */
+    struct rx_a11y_tree* tree;
+    rx_a11y_element** order;
+    size_t order_count, order_capacity;
+    uint32_t order_version;
+    bool order_valid;
 } rx_screen_reader;
 
 extern rx_screen_reader* rx_screen_reader_create(void);
+/* Announcements reach the platform with the tree's next flush */
+extern void rx_screen_reader_set_tree(rx_screen_reader* sr, struct rx_a11y_tree* tree);
 extern void rx_screen_reader_announce(rx_screen_reader* sr, const char* text, bool interrupt);
 extern void rx_screen_reader_announce_important(rx_screen_reader* sr, const char* text);
 extern void rx_screen_reader_move_next(rx_screen_reader* sr);
@@ -383,6 +430,70 @@ extern bool rx_a11y_check_contrast(rx_color foreground, rx_color background);
 extern bool rx_a11y_check_touch_target(rx_rect bounds);  /* Min 44x44 */
 extern bool rx_a11y_check_label(rx_a11y_element* elem);
 
+/* ============================================================================
+ * Accessibility Tree
+ * ============================================================================ */
+
+typedef enum rx_a11y_change_flags {
+    RX_A11Y_CREATED     = 1 << 0,
+    RX_A11Y_REMOVED     = 1 << 1,
+    RX_A11Y_LABEL       = 1 << 2,     /* Label or hint */
+    RX_A11Y_VALUE       = 1 << 3,
+    RX_A11Y_STATE       = 1 << 4,     /* Role, traits, hidden, focusable */
+    RX_A11Y_FRAME       = 1 << 5,
+    RX_A11Y_CHILDREN    = 1 << 6,
+    RX_A11Y_FOCUS       = 1 << 7,
+} rx_a11y_change_flags;
+
+/* One entry per element per batch, flags merged */
+typedef struct rx_a11y_change {
+    uint32_t id;
+    uint32_t flags;
+    rx_a11y_element* element;     /* NULL once the element is freed */
+} rx_a11y_change;
+
+typedef struct rx_a11y_bridge {
+    /* Once per flush with every change since the last one */
+    void (*apply)(const rx_a11y_change* changes, size_t count, void* ctx);
+    void (*announce)(const char* text, bool interrupt, void* ctx);
+    void* ctx;
+} rx_a11y_bridge;
+
+typedef struct rx_a11y_tree {
+    rx_view* root;
+    rx_a11y_bridge bridge;
+    rx_screen_reader* reader;     /* Announcements delivered on flush */
+    
+    /* Pending batch */
+    rx_a11y_change* changes;
+    size_t change_count, change_capacity;
+    
+    /* Former children of synced views, removed unless reached again */
+    rx_a11y_element** orphans;
+    size_t orphan_count, orphan_capacity;
+    
+    uint32_t epoch;
+    uint32_t next_id;
+    uint32_t order_version;   /* Moves on when focus or reading order may change */
+    
+    /* Statistics */
+    uint64_t syncs;
+    uint64_t elements_visited;
+    uint64_t changes_sent;
+} rx_a11y_tree;
+
+extern rx_a11y_tree* rx_a11y_tree_create(rx_view* root, const rx_a11y_bridge* bridge);
+/* Bring the elements up to date with the views (after layout) */
+extern void rx_a11y_tree_sync(rx_a11y_tree* tree);
+/* Sync, then hand the pending batch and announcements to the bridge */
+extern void rx_a11y_tree_flush(rx_a11y_tree* tree);
+/* Elements stay with their views, detached */
+extern void rx_a11y_tree_destroy(rx_a11y_tree* tree);
+
+/* View hooks (reox_ui.c): a laid-out window root, a view being freed */
+extern void rx_a11y_view_laid_out(rx_view* root);
+extern void rx_a11y_view_released(rx_view* view);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,9 +4,14 @@
  */
 
 #include "reox_animation.h"
+#include "reox_compositor.h"
+#include "reox_frame_stats.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,35 +21,38 @@
  * Easing Function Implementation
  * ============================================================================ */
 
-/* Helper functions */
+/* Helper functions (integer powers are spelled out; powf is slow) */
+static inline float sq(float x) { return x * x; }
+static inline float cube(float x) { return x * x * x; }
+
 static float ease_in_quad(float t) { return t * t; }
 static float ease_out_quad(float t) { return 1 - (1 - t) * (1 - t); }
 static float ease_in_out_quad(float t) {
-    return t < 0.5f ? 2 * t * t : 1 - powf(-2 * t + 2, 2) / 2;
+    return t < 0.5f ? 2 * t * t : 1 - sq(-2 * t + 2) / 2;
 }
 
 static float ease_in_cubic(float t) { return t * t * t; }
-static float ease_out_cubic(float t) { return 1 - powf(1 - t, 3); }
+static float ease_out_cubic(float t) { return 1 - cube(1 - t); }
 static float ease_in_out_cubic(float t) {
-    return t < 0.5f ? 4 * t * t * t : 1 - powf(-2 * t + 2, 3) / 2;
+    return t < 0.5f ? 4 * t * t * t : 1 - cube(-2 * t + 2) / 2;
 }
 
 static float ease_in_quart(float t) { return t * t * t * t; }
-static float ease_out_quart(float t) { return 1 - powf(1 - t, 4); }
+static float ease_out_quart(float t) { return 1 - sq(sq(1 - t)); }
 static float ease_in_out_quart(float t) {
-    return t < 0.5f ? 8 * t * t * t * t : 1 - powf(-2 * t + 2, 4) / 2;
+    return t < 0.5f ? 8 * t * t * t * t : 1 - sq(sq(-2 * t + 2)) / 2;
 }
 
 static float ease_in_expo(float t) {
-    return t == 0 ? 0 : powf(2, 10 * t - 10);
+    return t == 0 ? 0 : exp2f(10 * t - 10);
 }
 static float ease_out_expo(float t) {
-    return t == 1 ? 1 : 1 - powf(2, -10 * t);
+    return t == 1 ? 1 : 1 - exp2f(-10 * t);
 }
 static float ease_in_out_expo(float t) {
     if (t == 0) return 0;
     if (t == 1) return 1;
-    return t < 0.5f ? powf(2, 20 * t - 10) / 2 : (2 - powf(2, -20 * t + 10)) / 2;
+    return t < 0.5f ? exp2f(20 * t - 10) / 2 : (2 - exp2f(-20 * t + 10)) / 2;
 }
 
 static float ease_in_back(float t) {
@@ -55,35 +63,35 @@ static float ease_in_back(float t) {
 static float ease_out_back(float t) {
     const float c1 = 1.70158f;
     const float c3 = c1 + 1;
-    return 1 + c3 * powf(t - 1, 3) + c1 * powf(t - 1, 2);
+    return 1 + c3 * cube(t - 1) + c1 * sq(t - 1);
 }
 static float ease_in_out_back(float t) {
     const float c1 = 1.70158f;
     const float c2 = c1 * 1.525f;
     return t < 0.5f 
-        ? (powf(2 * t, 2) * ((c2 + 1) * 2 * t - c2)) / 2
-        : (powf(2 * t - 2, 2) * ((c2 + 1) * (t * 2 - 2) + c2) + 2) / 2;
+        ? (sq(2 * t) * ((c2 + 1) * 2 * t - c2)) / 2
+        : (sq(2 * t - 2) * ((c2 + 1) * (t * 2 - 2) + c2) + 2) / 2;
 }
 
 static float ease_in_elastic(float t) {
     const float c4 = (2 * M_PI) / 3;
     if (t == 0) return 0;
     if (t == 1) return 1;
-    return -powf(2, 10 * t - 10) * sinf((t * 10 - 10.75f) * c4);
+    return -exp2f(10 * t - 10) * sinf((t * 10 - 10.75f) * c4);
 }
 static float ease_out_elastic(float t) {
     const float c4 = (2 * M_PI) / 3;
     if (t == 0) return 0;
     if (t == 1) return 1;
-    return powf(2, -10 * t) * sinf((t * 10 - 0.75f) * c4) + 1;
+    return exp2f(-10 * t) * sinf((t * 10 - 0.75f) * c4) + 1;
 }
 static float ease_in_out_elastic(float t) {
     const float c5 = (2 * M_PI) / 4.5f;
     if (t == 0) return 0;
     if (t == 1) return 1;
     return t < 0.5f
-        ? -(powf(2, 20 * t - 10) * sinf((20 * t - 11.125f) * c5)) / 2
-        : (powf(2, -20 * t + 10) * sinf((20 * t - 11.125f) * c5)) / 2 + 1;
+        ? -(exp2f(20 * t - 10) * sinf((20 * t - 11.125f) * c5)) / 2
+        : (exp2f(-20 * t + 10) * sinf((20 * t - 11.125f) * c5)) / 2 + 1;
 }
 
 static float ease_bounce_out(float t) {
@@ -104,63 +112,336 @@ static float ease_bounce_out(float t) {
     }
 }
 
-float rx_ease(rx_easing easing, float t) {
-    /* Clamp t */
-    if (t < 0) t = 0;
-    if (t > 1) t = 1;
-    
-    switch (easing) {
-        case RX_EASE_LINEAR:        return t;
-        case RX_EASE_IN:            return ease_in_cubic(t);
-        case RX_EASE_OUT:           return ease_out_cubic(t);
-        case RX_EASE_IN_OUT:        return ease_in_out_cubic(t);
-        case RX_EASE_IN_QUAD:       return ease_in_quad(t);
-        case RX_EASE_OUT_QUAD:      return ease_out_quad(t);
-        case RX_EASE_IN_OUT_QUAD:   return ease_in_out_quad(t);
-        case RX_EASE_IN_CUBIC:      return ease_in_cubic(t);
-        case RX_EASE_OUT_CUBIC:     return ease_out_cubic(t);
-        case RX_EASE_IN_OUT_CUBIC:  return ease_in_out_cubic(t);
-        case RX_EASE_IN_QUART:      return ease_in_quart(t);
-        case RX_EASE_OUT_QUART:     return ease_out_quart(t);
-        case RX_EASE_IN_OUT_QUART:  return ease_in_out_quart(t);
-        case RX_EASE_IN_EXPO:       return ease_in_expo(t);
-        case RX_EASE_OUT_EXPO:      return ease_out_expo(t);
-        case RX_EASE_IN_OUT_EXPO:   return ease_in_out_expo(t);
-        case RX_EASE_IN_BACK:       return ease_in_back(t);
-        case RX_EASE_OUT_BACK:      return ease_out_back(t);
-        case RX_EASE_IN_OUT_BACK:   return ease_in_out_back(t);
-        case RX_EASE_IN_ELASTIC:    return ease_in_elastic(t);
-        case RX_EASE_OUT_ELASTIC:   return ease_out_elastic(t);
-        case RX_EASE_IN_OUT_ELASTIC: return ease_in_out_elastic(t);
-        case RX_EASE_BOUNCE:        return ease_bounce_out(t);
-        case RX_EASE_SPRING:        return ease_out_elastic(t);  /* Approximation */
-        default:                    return t;
+static float ease_linear(float t) { return t; }
+
+typedef float (*ease_fn)(float t);
+
+/* Indexed by rx_easing; input already clamped to [0, 1] */
+static const ease_fn ease_table[RX_EASING_COUNT] = {
+    [RX_EASE_LINEAR]         = ease_linear,
+    [RX_EASE_IN]             = ease_in_cubic,
+    [RX_EASE_OUT]            = ease_out_cubic,
+    [RX_EASE_IN_OUT]         = ease_in_out_cubic,
+    [RX_EASE_IN_QUAD]        = ease_in_quad,
+    [RX_EASE_OUT_QUAD]       = ease_out_quad,
+    [RX_EASE_IN_OUT_QUAD]    = ease_in_out_quad,
+    [RX_EASE_IN_CUBIC]       = ease_in_cubic,
+    [RX_EASE_OUT_CUBIC]      = ease_out_cubic,
+    [RX_EASE_IN_OUT_CUBIC]   = ease_in_out_cubic,
+    [RX_EASE_IN_QUART]       = ease_in_quart,
+    [RX_EASE_OUT_QUART]      = ease_out_quart,
+    [RX_EASE_IN_OUT_QUART]   = ease_in_out_quart,
+    [RX_EASE_IN_EXPO]        = ease_in_expo,
+    [RX_EASE_OUT_EXPO]       = ease_out_expo,
+    [RX_EASE_IN_OUT_EXPO]    = ease_in_out_expo,
+    [RX_EASE_IN_BACK]        = ease_in_back,
+    [RX_EASE_OUT_BACK]       = ease_out_back,
+    [RX_EASE_IN_OUT_BACK]    = ease_in_out_back,
+    [RX_EASE_IN_ELASTIC]     = ease_in_elastic,
+    [RX_EASE_OUT_ELASTIC]    = ease_out_elastic,
+    [RX_EASE_IN_OUT_ELASTIC] = ease_in_out_elastic,
+    [RX_EASE_BOUNCE]         = ease_bounce_out,
+    [RX_EASE_SPRING]         = ease_out_elastic,  /* Approximation */
+};
+
+/* Unknown easings behave as linear */
+static int ease_index(rx_easing easing) {
+    return ((unsigned)easing < RX_EASING_COUNT) ? (int)easing : RX_EASE_LINEAR;
+}
+
+/* Two selects rather than a nested ternary so batch loops if-convert.
+ * Written so NaN fails the first compare and becomes 0. */
+static inline float clamp01(float t) {
+    t = t > 0 ? t : 0;
+    return t < 1 ? t : 1;
+}
+
+/* ============================================================================
+ * Easing Lookup Tables
+ * ============================================================================ */
+
+/* The sinf/exp2f curves are sampled at size + 1 uniform points and
+ * linearly interpolated. Polynomial easings (back, bounce) are cheaper to
+ * evaluate, and bounce's cusps would interpolate badly anyway.
+ *
+ * rx_ease runs on the UI and compositor threads, so the tables are built
+ * whole before they are published and never change or go away after: a
+ * new size publishes a new set, and sets are kept per size for reuse. */
+typedef struct ease_lut_set {
+    int size;
+    float* tables[RX_EASING_COUNT];
+    struct ease_lut_set* next;  /* Every set ever built */
+} ease_lut_set;
+
+static _Atomic(ease_lut_set*) ease_luts;
+static ease_lut_set* ease_lut_sets;
+static pthread_mutex_t ease_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t ease_luts_once = PTHREAD_ONCE_INIT;
+
+static bool ease_uses_lut(int e) {
+    switch (e) {
+        case RX_EASE_IN_ELASTIC:
+        case RX_EASE_OUT_ELASTIC:
+        case RX_EASE_IN_OUT_ELASTIC:
+        case RX_EASE_SPRING:
+            return true;
+        default:
+            return false;
     }
 }
 
-float rx_ease_bezier(float t, float x1, float y1, float x2, float y2) {
-    /* Cubic bezier approximation */
-    float cx = 3.0f * x1;
-    float bx = 3.0f * (x2 - x1) - cx;
-    float ax = 1.0f - cx - bx;
+/* t must be in [0, 1] (clamp01) */
+static inline float lut_eval(const float* lut, int n, float t) {
+    float f = t * (float)n;
+    int i = (int)f;
+    if (i >= n) return lut[n];
+    float w = f - (float)i;
+    return lut[i] + (lut[i + 1] - lut[i]) * w;
+}
+
+/* Tables for `size` samples, built if new; NULL for size 0 or no memory.
+ * Called with ease_lock held. */
+static ease_lut_set* ease_lut_set_for(int size) {
+    if (size <= 0) return NULL;
+    for (ease_lut_set* set = ease_lut_sets; set; set = set->next) {
+        if (set->size == size) return set;
+    }
     
-    float cy = 3.0f * y1;
-    float by = 3.0f * (y2 - y1) - cy;
-    float ay = 1.0f - cy - by;
+    ease_lut_set* set = (ease_lut_set*)calloc(1, sizeof(ease_lut_set));
+    if (!set) return NULL;
+    set->size = size;
+    for (int e = 0; e < RX_EASING_COUNT; e++) {
+        if (!ease_uses_lut(e)) continue;
+        float* lut = (float*)malloc(sizeof(float) * (size_t)(size + 1));
+        if (!lut) {
+            for (int j = 0; j < e; j++) free(set->tables[j]);
+            free(set);
+            return NULL;
+        }
+        for (int i = 0; i <= size; i++) lut[i] = ease_table[e]((float)i / (float)size);
+        set->tables[e] = lut;
+    }
+    set->next = ease_lut_sets;
+    ease_lut_sets = set;
+    return set;
+}
+
+static void ease_luts_init(void) {
+    pthread_mutex_lock(&ease_lock);
+    atomic_store(&ease_luts, ease_lut_set_for(RX_EASE_LUT_DEFAULT));
+    pthread_mutex_unlock(&ease_lock);
+}
+
+static inline const ease_lut_set* ease_lut_current(void) {
+    pthread_once(&ease_luts_once, ease_luts_init);
+    return atomic_load_explicit(&ease_luts, memory_order_acquire);
+}
+
+static const float* ease_lut(const ease_lut_set* set, int e) {
+    return set ? set->tables[e] : NULL;
+}
+
+void rx_ease_set_lut_size(int samples) {
+    if (samples < 0) samples = 0;
+    if (samples > RX_EASE_LUT_MAX) samples = RX_EASE_LUT_MAX;
+    pthread_once(&ease_luts_once, ease_luts_init);
+    pthread_mutex_lock(&ease_lock);
+    atomic_store_explicit(&ease_luts, ease_lut_set_for(samples), memory_order_release);
+    pthread_mutex_unlock(&ease_lock);
+}
+
+int rx_ease_lut_size(void) {
+    const ease_lut_set* set = ease_lut_current();
+    return set ? set->size : 0;
+}
+
+float rx_ease(rx_easing easing, float t) {
+    t = clamp01(t);
+    int e = ease_index(easing);
+    const ease_lut_set* set = ease_lut_current();
+    const float* lut = ease_lut(set, e);
+    return lut ? lut_eval(lut, set->size, t) : ease_table[e](t);
+}
+
+/* ============================================================================
+ * Batch Easing
+ * ============================================================================ */
+
+/*
+ * Inputs are clamped into out first and transformed in place: a clamp
+ * followed by arithmetic in the same loop has control flow that keeps GCC
+ * from vectorizing (under the default -ftrapping-math), two flat loops don't.
+ */
+static void ease_clamp_batch(const float* restrict t, float* restrict out, size_t count) {
+    for (size_t i = 0; i < count; i++) out[i] = clamp01(t[i]);
+}
+
+#define EASE_LOOP(expr) \
+    ease_clamp_batch(t, out, count); \
+    for (size_t i = 0; i < count; i++) { float x = out[i]; out[i] = (expr); } \
+    return
+
+void rx_ease_batch(rx_easing easing, const float* restrict t, float* restrict out, size_t count) {
+    if (!t || !out) return;
+    int e = ease_index(easing);
     
-    /* Newton-Raphson iteration to find t for x */
+    const ease_lut_set* set = ease_lut_current();
+    const float* lut = ease_lut(set, e);
+    if (lut) {
+        int n = set->size;
+        EASE_LOOP(lut_eval(lut, n, x));
+    }
+    
+    switch (e) {
+        case RX_EASE_LINEAR:       EASE_LOOP(x);
+        case RX_EASE_IN_QUAD:      EASE_LOOP(x * x);
+        case RX_EASE_OUT_QUAD:     EASE_LOOP(1 - (1 - x) * (1 - x));
+        case RX_EASE_IN:
+        case RX_EASE_IN_CUBIC:     EASE_LOOP(x * x * x);
+        case RX_EASE_OUT:
+        case RX_EASE_OUT_CUBIC:    EASE_LOOP(1 - cube(1 - x));
+        case RX_EASE_IN_QUART:     EASE_LOOP(sq(sq(x)));
+        case RX_EASE_OUT_QUART:    EASE_LOOP(1 - sq(sq(1 - x)));
+        case RX_EASE_IN_BACK:      EASE_LOOP(ease_in_back(x));
+        case RX_EASE_OUT_BACK:     EASE_LOOP(ease_out_back(x));
+        default:
+            ease_clamp_batch(t, out, count);
+            for (size_t i = 0; i < count; i++) out[i] = ease_table[e](out[i]);
+            return;
+    }
+}
+
+/* ============================================================================
+ * Cubic Bezier Easing
+ * ============================================================================ */
+
+typedef struct bezier_coeffs {
+    float ax, bx, cx;
+    float ay, by, cy;
+} bezier_coeffs;
+
+static bezier_coeffs bezier_make(float x1, float y1, float x2, float y2) {
+    bezier_coeffs c;
+    c.cx = 3.0f * x1;
+    c.bx = 3.0f * (x2 - x1) - c.cx;
+    c.ax = 1.0f - c.cx - c.bx;
+    c.cy = 3.0f * y1;
+    c.by = 3.0f * (y2 - y1) - c.cy;
+    c.ay = 1.0f - c.cy - c.by;
+    return c;
+}
+
+/* y for the curve parameter whose x is t: Newton-Raphson, bisection fallback */
+static float bezier_solve(const bezier_coeffs* c, float t) {
     float guess = t;
-    for (int i = 0; i < 5; i++) {
-        float x = ((ax * guess + bx) * guess + cx) * guess;
-        float dx = (3.0f * ax * guess + 2.0f * bx) * guess + cx;
+    for (int i = 0; i < 8; i++) {
+        float x = ((c->ax * guess + c->bx) * guess + c->cx) * guess - t;
+        if (fabsf(x) < 1e-6f) goto done;
+        float dx = (3.0f * c->ax * guess + 2.0f * c->bx) * guess + c->cx;
         if (fabsf(dx) < 1e-6f) break;
-        guess -= (x - t) / dx;
+        guess -= x / dx;
+    }
+    
+    {
+        float lo = 0, hi = 1;
+        guess = t;
+        for (int i = 0; i < 32; i++) {
+            float x = ((c->ax * guess + c->bx) * guess + c->cx) * guess;
+            if (fabsf(x - t) < 1e-6f) break;
+            if (x < t) lo = guess; else hi = guess;
+            guess = (lo + hi) * 0.5f;
+        }
+    }
+    
+done:
+    return ((c->ay * guess + c->by) * guess + c->cy) * guess;
+}
+
+/* Small cache of sampled curves keyed by control points. Entries are
+ * rebuilt in place, so lookups and the reads of samples that follow hold
+ * ease_lock. */
+#define BEZIER_CACHE_SIZE 16
+
+typedef struct bezier_lut {
+    float x1, y1, x2, y2;
+    int size;
+    uint64_t last_used;
+    float* samples;
+} bezier_lut;
+
+static bezier_lut bezier_cache[BEZIER_CACHE_SIZE];
+static uint64_t bezier_clock = 0;
+
+static const bezier_lut* bezier_lut_get(int lut_size, float x1, float y1, float x2, float y2) {
+    if (lut_size <= 0) return NULL;
+    
+    bezier_lut* victim = &bezier_cache[0];
+    for (int i = 0; i < BEZIER_CACHE_SIZE; i++) {
+        bezier_lut* e = &bezier_cache[i];
+        if (e->samples && e->x1 == x1 && e->y1 == y1 && e->x2 == x2 && e->y2 == y2) {
+            if (e->size == lut_size) {
+                e->last_used = ++bezier_clock;
+                return e;
+            }
+            victim = e;
+            break;
+        }
+        if (!e->samples) { if (victim->samples) victim = e; }
+        else if (victim->samples && e->last_used < victim->last_used) victim = e;
+    }
+    
+    float* samples = (float*)realloc(victim->samples, sizeof(float) * (size_t)(lut_size + 1));
+    if (!samples) return NULL;
+    bezier_coeffs c = bezier_make(x1, y1, x2, y2);
+    for (int i = 0; i <= lut_size; i++) samples[i] = bezier_solve(&c, (float)i / (float)lut_size);
+    
+    victim->x1 = x1; victim->y1 = y1;
+    victim->x2 = x2; victim->y2 = y2;
+    victim->size = lut_size;
+    victim->samples = samples;
+    victim->last_used = ++bezier_clock;
+    return victim;
+}
+
+float rx_ease_bezier(float t, float x1, float y1, float x2, float y2) {
+    t = clamp01(t);
+    int lut_size = rx_ease_lut_size();
+    pthread_mutex_lock(&ease_lock);
+    const bezier_lut* lut = bezier_lut_get(lut_size, x1, y1, x2, y2);
+    if (lut) {
+        float y = lut_eval(lut->samples, lut->size, t);
+        pthread_mutex_unlock(&ease_lock);
+        return y;
+    }
+    pthread_mutex_unlock(&ease_lock);
+    
+    bezier_coeffs c = bezier_make(x1, y1, x2, y2);
+    return bezier_solve(&c, t);
+}
+
+void rx_ease_bezier_batch(const float* restrict t, float* restrict out, size_t count,
+                          float x1, float y1, float x2, float y2) {
+    if (!t || !out) return;
+    
+    int lut_size = rx_ease_lut_size();
+    pthread_mutex_lock(&ease_lock);
+    const bezier_lut* lut = bezier_lut_get(lut_size, x1, y1, x2, y2);
+    if (lut) {
+        const float* samples = lut->samples;
+        int n = lut->size;
+        ease_clamp_batch(t, out, count);
+        for (size_t i = 0; i < count; i++) out[i] = lut_eval(samples, n, out[i]);
+        pthread_mutex_unlock(&ease_lock);
+        return;
     }
+    pthread_mutex_unlock(&ease_lock);
     
-    /* Return y for found t */
-    return ((ay * guess + by) * guess + cy) * guess;
+    bezier_coeffs c = bezier_make(x1, y1, x2, y2);
+    for (size_t i = 0; i < count; i++) out[i] = bezier_solve(&c, clamp01(t[i]));
 }
 
+#undef EASE_LOOP
+
 /* ============================================================================
  * Spring Physics Implementation
  * ============================================================================ */
@@ -200,28 +481,52 @@ void rx_spring_set_target(rx_spring* spring, float target) {
     spring->settled = false;
 }
 
-float rx_spring_update(rx_spring* spring, float dt) {
-    if (!spring || spring->settled) return spring ? spring->current : 0;
-    
-    /* Spring force: F = -kx - cv */
-    float displacement = spring->current - spring->target;
-    float spring_force = -spring->config.stiffness * displacement;
-    float damping_force = -spring->config.damping * spring->velocity;
-    
-    /* Acceleration: a = F/m */
-    float acceleration = (spring_force + damping_force) / spring->config.mass;
+/* Split dt into equal substeps no longer than RX_SPRING_SUBSTEP */
+static int spring_substeps(float dt, float* h) {
+    if (dt <= 0) return 0;
+    float max_dt = RX_SPRING_SUBSTEP * RX_SPRING_MAX_SUBSTEPS;
+    if (dt > max_dt) dt = max_dt;
+    int steps = (int)ceilf(dt / RX_SPRING_SUBSTEP);
+    *h = dt / (float)steps;
+    return steps;
+}
+
+static void spring_step(rx_spring* spring, int steps, float h) {
+    float inv_mass = 1.0f / spring->config.mass;
+    float k = spring->config.stiffness * inv_mass;
+    float c = spring->config.damping * inv_mass;
+    float x = spring->current - spring->target;
+    float v = spring->velocity;
     
-    /* Semi-implicit Euler integration */
-    spring->velocity += acceleration * dt;
-    spring->current += spring->velocity * dt;
+    /* current is stored as target + x, so near rest x is only known to an
+     * ulp of target; without slack a large target never settles */
+    float rest_x = fmaxf(0.001f, fabsf(spring->target) * 8 * FLT_EPSILON);
+    float rest_v = rest_x * 16;
     
-    /* Check if settled */
-    if (fabsf(displacement) < 0.001f && fabsf(spring->velocity) < 0.001f) {
-        spring->current = spring->target;
-        spring->velocity = 0;
-        spring->settled = true;
+    for (int i = 0; i < steps; i++) {
+        /* Check if settled */
+        if (fabsf(x) < rest_x && fabsf(v) < rest_v) {
+            spring->current = spring->target;
+            spring->velocity = 0;
+            spring->settled = true;
+            return;
+        }
+        
+        /* Spring force: F = -kx - cv, a = F/m; semi-implicit Euler */
+        v += (-k * x - c * v) * h;
+        x += v * h;
     }
     
+    spring->current = spring->target + x;
+    spring->velocity = v;
+}
+
+float rx_spring_update(rx_spring* spring, float dt) {
+    if (!spring || spring->settled) return spring ? spring->current : 0;
+    
+    float h = 0;
+    int steps = spring_substeps(dt, &h);
+    spring_step(spring, steps, h);
     return spring->current;
 }
 
@@ -233,14 +538,171 @@ void rx_spring_destroy(rx_spring* spring) {
     free(spring);
 }
 
+/* ============================================================================
+ * Spring System
+ * ============================================================================ */
+
+rx_spring_system* rx_spring_system_create(size_t capacity) {
+    rx_spring_system* sys = (rx_spring_system*)calloc(1, sizeof(rx_spring_system));
+    if (!sys) return NULL;
+    
+    if (capacity == 0) capacity = 64;
+    sys->springs = (rx_spring*)malloc(sizeof(rx_spring) * capacity);
+    sys->live = (bool*)malloc(sizeof(bool) * capacity);
+    sys->free_ids = (uint32_t*)malloc(sizeof(uint32_t) * capacity);
+    sys->generations = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+    if (!sys->springs || !sys->live || !sys->free_ids || !sys->generations) {
+        rx_spring_system_destroy(sys);
+        return NULL;
+    }
+    sys->capacity = capacity;
+    
+    return sys;
+}
+
+void rx_spring_system_destroy(rx_spring_system* sys) {
+    if (!sys) return;
+    free(sys->springs);
+    free(sys->live);
+    free(sys->free_ids);
+    free(sys->generations);
+    free(sys);
+}
+
+static bool spring_system_grow(rx_spring_system* sys) {
+    size_t cap = sys->capacity * 2;
+    rx_spring* springs = (rx_spring*)realloc(sys->springs, sizeof(rx_spring) * cap);
+    if (!springs) return false;
+    sys->springs = springs;
+    bool* live = (bool*)realloc(sys->live, sizeof(bool) * cap);
+    if (!live) return false;
+    sys->live = live;
+    uint32_t* free_ids = (uint32_t*)realloc(sys->free_ids, sizeof(uint32_t) * cap);
+    if (!free_ids) return false;
+    sys->free_ids = free_ids;
+    uint32_t* generations = (uint32_t*)realloc(sys->generations, sizeof(uint32_t) * cap);
+    if (!generations) return false;
+    memset(generations + sys->capacity, 0, sizeof(uint32_t) * (cap - sys->capacity));
+    sys->generations = generations;
+    sys->capacity = cap;
+    return true;
+}
+
+rx_spring_id rx_spring_system_add(rx_spring_system* sys, float initial, rx_spring_config config) {
+    if (!sys) return RX_SPRING_INVALID;
+    
+    uint32_t index;
+    if (sys->free_count > 0) {
+        index = sys->free_ids[--sys->free_count];
+    } else {
+        if (sys->count == sys->capacity && !spring_system_grow(sys)) return RX_SPRING_INVALID;
+        if (sys->count >= UINT32_MAX) return RX_SPRING_INVALID;
+        index = (uint32_t)sys->count++;
+    }
+    
+    uint32_t generation = sys->generations[index] + 1;
+    if (generation == 0) generation = 1;
+    sys->generations[index] = generation;
+    
+    rx_spring* s = &sys->springs[index];
+    s->current = initial;
+    s->target = initial;
+    s->velocity = config.velocity;
+    s->config = config;
+    s->settled = config.velocity == 0;
+    sys->live[index] = true;
+    
+    return ((rx_spring_id)generation << 32) | index;
+}
+
+rx_spring* rx_spring_system_get(rx_spring_system* sys, rx_spring_id id) {
+    uint32_t index = (uint32_t)id;
+    if (!sys || index >= sys->count || !sys->live[index]) return NULL;
+    if (sys->generations[index] != (uint32_t)(id >> 32)) return NULL;
+    return &sys->springs[index];
+}
+
+void rx_spring_system_remove(rx_spring_system* sys, rx_spring_id id) {
+    rx_spring* s = rx_spring_system_get(sys, id);
+    if (!s) return;
+    uint32_t index = (uint32_t)id;
+    s->settled = true;
+    sys->live[index] = false;
+    sys->free_ids[sys->free_count++] = index;
+}
+
+void rx_spring_system_set_target(rx_spring_system* sys, rx_spring_id id, float target) {
+    rx_spring_set_target(rx_spring_system_get(sys, id), target);
+}
+
+float rx_spring_system_value(rx_spring_system* sys, rx_spring_id id) {
+    rx_spring* s = rx_spring_system_get(sys, id);
+    return s ? s->current : 0;
+}
+
+/*
+ * One linear pass over the array. Settled (and removed) springs are skipped
+ * before touching anything but their flag; the substep count is shared.
+ */
+size_t rx_spring_system_update(rx_spring_system* sys, float dt) {
+    if (!sys) return 0;
+    
+    float h = 0;
+    int steps = spring_substeps(dt, &h);
+    if (steps == 0) return sys->moving;
+    
+    size_t moving = 0;
+    rx_spring* springs = sys->springs;
+    for (size_t i = 0; i < sys->count; i++) {
+        rx_spring* s = &springs[i];
+        if (rx_spring_is_settled(s)) continue;
+        spring_step(s, steps, h);
+        if (!s->settled) moving++;
+    }
+    
+    sys->moving = moving;
+    return moving;
+}
+
 /* ============================================================================
  * Animation Implementation
  * ============================================================================ */
 
 static uint64_t anim_next_id = 1;
 
+/* Records come from slabs and are recycled through a free list, so
+ * starting and finishing animations doesn't touch the allocator */
+#define ANIM_POOL_SLAB 128
+
+typedef struct anim_slab {
+    struct anim_slab* next;
+    rx_animation records[ANIM_POOL_SLAB];
+} anim_slab;
+
+static anim_slab* anim_slabs = NULL;
+static rx_animation* anim_free_list = NULL;
+
+static rx_animation* anim_pool_alloc(void) {
+    if (!anim_free_list) {
+        anim_slab* slab = (anim_slab*)malloc(sizeof(anim_slab));
+        if (!slab) return NULL;
+        slab->next = anim_slabs;
+        anim_slabs = slab;
+        for (int i = ANIM_POOL_SLAB - 1; i >= 0; i--) {
+            slab->records[i].next = anim_free_list;
+            anim_free_list = &slab->records[i];
+        }
+    }
+    
+    rx_animation* anim = anim_free_list;
+    anim_free_list = anim->next;
+    memset(anim, 0, sizeof(*anim));
+    anim->pooled = true;
+    return anim;
+}
+
 rx_animation* rx_animate(float from, float to, float duration) {
-    rx_animation* anim = (rx_animation*)calloc(1, sizeof(rx_animation));
+    rx_animation* anim = anim_pool_alloc();
     if (!anim) return NULL;
     
     anim->id = anim_next_id++;
@@ -334,13 +796,16 @@ void rx_anim_reset(rx_animation* anim) {
     anim->reversed = false;
 }
 
-bool rx_anim_update(rx_animation* anim, float dt) {
-    if (!anim || anim->state != RX_ANIM_RUNNING) return false;
-    
+/*
+ * A running animation advances in two halves so the easing in between can
+ * be evaluated for a whole bucket at once. anim_tick returns the linear
+ * progress, or -1 while the start delay is still counting down.
+ */
+static float anim_tick(rx_animation* anim, float dt) {
     /* Handle delay */
     if (anim->delay > 0) {
         anim->delay -= dt;
-        return true;
+        return -1.0f;
     }
     
     /* Update elapsed time */
@@ -349,10 +814,15 @@ bool rx_anim_update(rx_animation* anim, float dt) {
     /* Calculate progress */
     float progress = anim->duration > 0 ? anim->elapsed / anim->duration : 1.0f;
     if (progress > 1.0f) progress = 1.0f;
-    
-    /* Apply easing */
-    float eased = rx_ease(anim->easing, anim->reversed ? 1.0f - progress : progress);
-    
+    return progress;
+}
+
+static inline float anim_ease_input(const rx_animation* anim, float progress) {
+    return anim->reversed ? 1.0f - progress : progress;
+}
+
+/* Store the eased value, fire callbacks; false once the animation finished */
+static bool anim_apply(rx_animation* anim, float progress, float eased) {
     /* Calculate current value */
     anim->current = anim->from + (anim->to - anim->from) * eased;
     
@@ -382,8 +852,22 @@ bool rx_anim_update(rx_animation* anim, float dt) {
     return true;
 }
 
+bool rx_anim_update(rx_animation* anim, float dt) {
+    if (!anim || anim->state != RX_ANIM_RUNNING) return false;
+    float progress = anim_tick(anim, dt);
+    if (progress < 0) return true;
+    return anim_apply(anim, progress, rx_ease(anim->easing, anim_ease_input(anim, progress)));
+}
+
 void rx_anim_destroy(rx_animation* anim) {
-    free(anim);
+    if (!anim) return;
+    if (anim->pooled) {
+        anim->pooled = false;
+        anim->next = anim_free_list;
+        anim_free_list = anim;
+    } else {
+        free(anim);
+    }
 }
 
 /* ============================================================================
@@ -404,48 +888,120 @@ rx_keyframe_animation* rx_keyframes_create(float duration) {
 void rx_keyframes_add(rx_keyframe_animation* anim, float time, float value, rx_easing easing) {
     if (!anim) return;
     
-    anim->keyframes = (rx_keyframe*)realloc(
-        anim->keyframes,
-        sizeof(rx_keyframe) * (anim->keyframe_count + 1)
-    );
+    if (anim->keyframe_count == anim->keyframe_capacity) {
+        size_t cap = anim->keyframe_capacity ? anim->keyframe_capacity * 2 : 8;
+        rx_keyframe* keyframes = (rx_keyframe*)realloc(anim->keyframes, sizeof(rx_keyframe) * cap);
+        if (!keyframes) return;
+        anim->keyframes = keyframes;
+        anim->keyframe_capacity = cap;
+    }
+    
+    /* Insert after every keyframe at or before time; appends stay O(1) */
+    size_t lo = 0, hi = anim->keyframe_count;
+    if (hi > 0 && anim->keyframes[hi - 1].time <= time) {
+        lo = hi;
+    }
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (anim->keyframes[mid].time <= time) lo = mid + 1;
+        else hi = mid;
+    }
+    memmove(&anim->keyframes[lo + 1], &anim->keyframes[lo],
+            sizeof(rx_keyframe) * (anim->keyframe_count - lo));
     
-    rx_keyframe* kf = &anim->keyframes[anim->keyframe_count];
+    rx_keyframe* kf = &anim->keyframes[lo];
     kf->time = time;
     kf->value = value;
     kf->easing = easing;
     anim->keyframe_count++;
+    anim->baked_stale = anim->baked != NULL;
 }
 
-float rx_keyframes_get_value(rx_keyframe_animation* anim, float t) {
-    if (!anim || anim->keyframe_count == 0) return 0;
+/* Index of the last keyframe at or before t; t must be inside the timeline */
+static size_t keyframes_segment(rx_keyframe_animation* anim, float t) {
+    const rx_keyframe* k = anim->keyframes;
+    size_t n = anim->keyframe_count;
+    size_t s = anim->segment;
     
-    /* Find surrounding keyframes */
-    rx_keyframe* prev = &anim->keyframes[0];
-    rx_keyframe* next = prev;
-    
-    for (size_t i = 0; i < anim->keyframe_count; i++) {
-        if (anim->keyframes[i].time <= t) {
-            prev = &anim->keyframes[i];
-        }
-        if (anim->keyframes[i].time >= t) {
-            next = &anim->keyframes[i];
-            break;
-        }
+    /* Playback moves forward a segment at a time */
+    if (s + 1 < n && k[s].time <= t) {
+        if (t < k[s + 1].time) return s;
+        if (s + 2 < n && t < k[s + 2].time) return anim->segment = s + 1;
     }
     
-    /* Interpolate */
-    if (prev == next || next->time == prev->time) {
-        return prev->value;
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (k[mid].time <= t) lo = mid + 1;
+        else hi = mid;
     }
+    return anim->segment = lo - 1;
+}
+
+static float keyframes_eval(rx_keyframe_animation* anim, float t) {
+    const rx_keyframe* k = anim->keyframes;
+    size_t n = anim->keyframe_count;
+    if (t <= k[0].time) return k[0].value;
+    if (t >= k[n - 1].time) return k[n - 1].value;
     
+    size_t s = keyframes_segment(anim, t);
+    const rx_keyframe* prev = &k[s];
+    const rx_keyframe* next = &k[s + 1];
     float local_t = (t - prev->time) / (next->time - prev->time);
     float eased = rx_ease(next->easing, local_t);
     return prev->value + (next->value - prev->value) * eased;
 }
 
+static void keyframes_rebake(rx_keyframe_animation* anim) {
+    size_t n = anim->keyframe_count;
+    int size = anim->baked_size;
+    float t0 = n ? anim->keyframes[0].time : 0;
+    float span = n ? anim->keyframes[n - 1].time - t0 : 0;
+    for (int i = 0; i <= size; i++) {
+        anim->baked[i] = n ? keyframes_eval(anim, t0 + span * (float)i / (float)size) : 0;
+    }
+    anim->baked_stale = false;
+}
+
+void rx_keyframes_bake(rx_keyframe_animation* anim, int samples) {
+    if (!anim) return;
+    if (samples <= 0) {
+        free(anim->baked);
+        anim->baked = NULL;
+        anim->baked_size = 0;
+        anim->baked_stale = false;
+        return;
+    }
+    if (samples > RX_KEYFRAME_BAKE_MAX) samples = RX_KEYFRAME_BAKE_MAX;
+    
+    float* baked = (float*)realloc(anim->baked, sizeof(float) * (size_t)(samples + 1));
+    if (!baked) return;   /* Keep sampling the keyframes directly */
+    anim->baked = baked;
+    anim->baked_size = samples;
+    keyframes_rebake(anim);
+}
+
+float rx_keyframes_get_value(rx_keyframe_animation* anim, float t) {
+    if (!anim || anim->keyframe_count == 0) return 0;
+    if (t != t) t = anim->keyframes[0].time;   /* NaN would miss every segment */
+    
+    if (anim->baked) {
+        if (anim->baked_stale) keyframes_rebake(anim);
+        const rx_keyframe* k = anim->keyframes;
+        float t0 = k[0].time;
+        float span = k[anim->keyframe_count - 1].time - t0;
+        if (span <= 0 || t <= t0) return k[0].value;
+        float u = (t - t0) / span;
+        return lut_eval(anim->baked, anim->baked_size, u < 1 ? u : 1);
+    }
+    
+    return keyframes_eval(anim, t);
+}
+
 void rx_keyframes_destroy(rx_keyframe_animation* anim) {
     if (anim) {
         free(anim->keyframes);
+        free(anim->baked);
         free(anim);
     }
 }
@@ -504,37 +1060,71 @@ rx_animation* rx_view_animate(rx_view* view, rx_animatable_property prop,
     return rx_animate(from, to, duration);
 }
 
+/*
+ * With a compositor installed, opacity and transform animations also run on
+ * its thread against the view's layer, so the view tree isn't touched per
+ * frame. from/to are layer values (X/Y relative to the laid-out frame). The
+ * returned rx_animation still reports the value to callers that step it.
+ */
+static void view_offload(rx_view* view, rx_animatable_property prop, float from, float to,
+                         const rx_animation* anim) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp || !view || !anim) return;
+    rx_compositor_animate(comp, view, prop, from, to, anim->duration, anim->easing, anim->delay);
+}
+
 rx_animation* rx_view_animate_from(rx_view* view, rx_animatable_property prop,
                                     float from, float to, float duration) {
-    return rx_animate(from, to, duration);
+    rx_animation* anim = rx_animate(from, to, duration);
+    if (view && rx_compositor_can_animate(prop)) {
+        float origin = prop == RX_PROP_X ? view->box.frame.x : (prop == RX_PROP_Y ? view->box.frame.y : 0);
+        view_offload(view, prop, from - origin, to - origin, anim);
+    }
+    return anim;
 }
 
 rx_animation* rx_view_fade_in(rx_view* view, float duration) {
-    return rx_animate(0.0f, 1.0f, duration);
+    rx_animation* anim = rx_animate(0.0f, 1.0f, duration);
+    view_offload(view, RX_PROP_OPACITY, 0.0f, 1.0f, anim);
+    return anim;
 }
 
 rx_animation* rx_view_fade_out(rx_view* view, float duration) {
-    return rx_animate(1.0f, 0.0f, duration);
+    rx_animation* anim = rx_animate(1.0f, 0.0f, duration);
+    view_offload(view, RX_PROP_OPACITY, 1.0f, 0.0f, anim);
+    return anim;
 }
 
 rx_animation* rx_view_slide_in(rx_view* view, float from_x, float from_y, float duration) {
     /* Would return group of X and Y animations */
-    return rx_animate(from_y, view ? view->box.frame.y : 0, duration);
+    rx_animation* anim = rx_animate(from_y, view ? view->box.frame.y : 0, duration);
+    if (view) {
+        view_offload(view, RX_PROP_X, from_x - view->box.frame.x, 0.0f, anim);
+        view_offload(view, RX_PROP_Y, from_y - view->box.frame.y, 0.0f, anim);
+    }
+    return anim;
 }
 
 rx_animation* rx_view_slide_out(rx_view* view, float to_x, float to_y, float duration) {
-    return rx_animate(view ? view->box.frame.y : 0, to_y, duration);
+    rx_animation* anim = rx_animate(view ? view->box.frame.y : 0, to_y, duration);
+    if (view) {
+        view_offload(view, RX_PROP_X, 0.0f, to_x - view->box.frame.x, anim);
+        view_offload(view, RX_PROP_Y, 0.0f, to_y - view->box.frame.y, anim);
+    }
+    return anim;
 }
 
 rx_animation* rx_view_scale_in(rx_view* view, float duration) {
     rx_animation* anim = rx_animate(0.0f, 1.0f, duration);
     if (anim) anim->easing = RX_EASE_OUT_BACK;
+    view_offload(view, RX_PROP_SCALE, 0.0f, 1.0f, anim);
     return anim;
 }
 
 rx_animation* rx_view_scale_out(rx_view* view, float duration) {
     rx_animation* anim = rx_animate(1.0f, 0.0f, duration);
     if (anim) anim->easing = RX_EASE_IN_BACK;
+    view_offload(view, RX_PROP_SCALE, 1.0f, 0.0f, anim);
     return anim;
 }
 
@@ -589,25 +1179,82 @@ rx_animator* rx_animator_create(void) {
     return animator;
 }
 
+static bool bucket_push(rx_anim_bucket* b, rx_animation* anim) {
+    if (b->count == b->capacity) {
+        size_t cap = b->capacity ? b->capacity * 2 : 16;
+        rx_animation** items = (rx_animation**)realloc(b->items, sizeof(rx_animation*) * cap);
+        if (!items) return false;
+        b->items = items;
+        b->capacity = cap;
+    }
+    anim->slot = (int32_t)b->count;
+    b->items[b->count++] = anim;
+    return true;
+}
+
+/* Swap-remove: the last animation takes the freed slot */
+static void bucket_remove_at(rx_anim_bucket* b, size_t index) {
+    rx_animation* last = b->items[--b->count];
+    if (index != b->count) {
+        b->items[index] = last;
+        last->slot = (int32_t)index;
+    }
+}
+
+static void bucket_destroy_all(rx_anim_bucket* b) {
+    for (size_t i = 0; i < b->count; i++) rx_anim_destroy(b->items[i]);
+    b->count = 0;
+}
+
+static bool animator_reserve_batch(rx_animator* animator, size_t count) {
+    if (count <= animator->batch_capacity) return true;
+    size_t cap = animator->batch_capacity ? animator->batch_capacity : 64;
+    while (cap < count) cap *= 2;
+    
+    uint32_t* index = (uint32_t*)realloc(animator->batch_index, sizeof(uint32_t) * cap);
+    if (index) animator->batch_index = index;
+    float* t = (float*)realloc(animator->batch_t, sizeof(float) * cap);
+    if (t) animator->batch_t = t;
+    float* eased = (float*)realloc(animator->batch_eased, sizeof(float) * cap);
+    if (eased) animator->batch_eased = eased;
+    float* progress = (float*)realloc(animator->batch_progress, sizeof(float) * cap);
+    if (progress) animator->batch_progress = progress;
+    if (!index || !t || !eased || !progress) return false;
+    
+    animator->batch_capacity = cap;
+    return true;
+}
+
+static bool animator_schedule(rx_animator* animator, rx_animation* anim) {
+    anim->bucket = (int16_t)ease_index(anim->easing);
+    return bucket_push(&animator->buckets[anim->bucket], anim);
+}
+
 void rx_animator_destroy(rx_animator* animator) {
     if (!animator) return;
     
     /* Free all animations */
-    rx_animation* anim = animator->animations;
-    while (anim) {
-        rx_animation* next = anim->next;
-        rx_anim_destroy(anim);
-        anim = next;
+    for (int e = 0; e < RX_EASING_COUNT; e++) {
+        bucket_destroy_all(&animator->buckets[e]);
+        free(animator->buckets[e].items);
     }
+    bucket_destroy_all(&animator->pending);
+    free(animator->pending.items);
     
+    free(animator->batch_index);
+    free(animator->batch_t);
+    free(animator->batch_eased);
+    free(animator->batch_progress);
     free(animator);
 }
 
 void rx_animator_add(rx_animator* animator, rx_animation* anim) {
     if (!animator || !anim) return;
     
-    anim->next = animator->animations;
-    animator->animations = anim;
+    /* Buckets can't grow under the update loop; park it until the end */
+    bool ok = animator->updating ? bucket_push(&animator->pending, anim)
+                                 : animator_schedule(animator, anim);
+    if (!ok) return;
     animator->animation_count++;
     
     rx_anim_start(anim);
@@ -616,50 +1263,130 @@ void rx_animator_add(rx_animator* animator, rx_animation* anim) {
 void rx_animator_remove(rx_animator* animator, rx_animation* anim) {
     if (!animator || !anim) return;
     
-    rx_animation** ptr = &animator->animations;
-    while (*ptr) {
-        if (*ptr == anim) {
-            *ptr = anim->next;
-            animator->animation_count--;
-            rx_anim_destroy(anim);
-            return;
-        }
-        ptr = &(*ptr)->next;
+    /* During update, stopping it is enough: the loop drops and frees it */
+    if (animator->updating) {
+        anim->state = RX_ANIM_IDLE;
+        return;
     }
+    
+    if (anim->bucket < 0 || anim->bucket >= RX_EASING_COUNT) return;
+    rx_anim_bucket* b = &animator->buckets[anim->bucket];
+    if (anim->slot < 0 || (size_t)anim->slot >= b->count || b->items[anim->slot] != anim) return;
+    
+    bucket_remove_at(b, (size_t)anim->slot);
+    animator->animation_count--;
+    rx_anim_destroy(anim);
 }
 
 void rx_animator_cancel_all(rx_animator* animator) {
     if (!animator) return;
     
-    rx_animation* anim = animator->animations;
-    while (anim) {
-        rx_animation* next = anim->next;
-        rx_anim_destroy(anim);
-        anim = next;
+    if (animator->updating) {
+        for (int e = 0; e < RX_EASING_COUNT; e++) {
+            rx_anim_bucket* b = &animator->buckets[e];
+            for (size_t i = 0; i < b->count; i++) b->items[i]->state = RX_ANIM_IDLE;
+        }
+        for (size_t i = 0; i < animator->pending.count; i++) {
+            animator->pending.items[i]->state = RX_ANIM_IDLE;
+        }
+        return;
     }
     
-    animator->animations = NULL;
+    for (int e = 0; e < RX_EASING_COUNT; e++) bucket_destroy_all(&animator->buckets[e]);
+    bucket_destroy_all(&animator->pending);
     animator->animation_count = 0;
 }
 
+/*
+ * Each easing bucket is processed in phases: advance clocks and gather the
+ * easing inputs, evaluate the bucket's easing in one rx_ease_batch call,
+ * apply values and fire callbacks, then compact. Paused animations stay
+ * scheduled; finished or stopped ones are swap-removed and returned to the
+ * pool.
+ */
 void rx_animator_update(rx_animator* animator, float dt) {
     if (!animator || animator->paused) return;
     
+    RX_ZONE_BEGIN(RX_PHASE_ANIMATION);
     dt *= animator->time_scale;
+    animator->updating = true;
     
-    rx_animation** ptr = &animator->animations;
-    while (*ptr) {
-        rx_animation* anim = *ptr;
+    for (int e = 0; e < RX_EASING_COUNT; e++) {
+        rx_anim_bucket* b = &animator->buckets[e];
+        if (b->count == 0) continue;
         
-        if (!rx_anim_update(anim, dt)) {
+        if (animator_reserve_batch(animator, b->count)) {
+            uint32_t* index = animator->batch_index;
+            float* progress = animator->batch_progress;
+            float* t = animator->batch_t;
+            float* eased = animator->batch_eased;
+            size_t n = 0;
+            
+            for (size_t i = 0; i < b->count; i++) {
+                rx_animation* anim = b->items[i];
+                if (anim->state != RX_ANIM_RUNNING || ease_index(anim->easing) != e) continue;
+                float p = anim_tick(anim, dt);
+                if (p < 0) continue;
+                index[n] = (uint32_t)i;
+                progress[n] = p;
+                t[n] = anim_ease_input(anim, p);
+                n++;
+            }
+            
+            rx_ease_batch((rx_easing)e, t, eased, n);
+            
+            /* Callbacks may stop or remove later animations in the batch */
+            for (size_t k = 0; k < n; k++) {
+                rx_animation* anim = b->items[index[k]];
+                if (anim->state == RX_ANIM_RUNNING) anim_apply(anim, progress[k], eased[k]);
+            }
+        } else {
+            /* Out of scratch memory: step one at a time */
+            for (size_t i = 0; i < b->count; i++) {
+                rx_animation* anim = b->items[i];
+                if (anim->state == RX_ANIM_RUNNING && ease_index(anim->easing) == e) {
+                    rx_anim_update(anim, dt);
+                }
+            }
+        }
+        
+        size_t i = 0;
+        while (i < b->count) {
+            rx_animation* anim = b->items[i];
+            
+            if (anim->state == RX_ANIM_PAUSED) {
+                i++;
+                continue;
+            }
+            if (anim->state == RX_ANIM_RUNNING && ease_index(anim->easing) != e) {
+                /* Easing changed after scheduling: move it over */
+                bucket_remove_at(b, i);
+                bucket_push(&animator->pending, anim);
+                continue;
+            }
+            if (anim->state == RX_ANIM_RUNNING) {
+                i++;
+                continue;
+            }
+            
             /* Animation completed, remove it */
-            *ptr = anim->next;
+            bucket_remove_at(b, i);
             animator->animation_count--;
             rx_anim_destroy(anim);
-        } else {
-            ptr = &anim->next;
         }
     }
+    
+    animator->updating = false;
+    
+    rx_anim_bucket* pending = &animator->pending;
+    for (size_t i = 0; i < pending->count; i++) {
+        if (!animator_schedule(animator, pending->items[i])) {
+            animator->animation_count--;
+            rx_anim_destroy(pending->items[i]);
+        }
+    }
+    pending->count = 0;
+    RX_ZONE_END(RX_PHASE_ANIMATION);
 }
 
 void rx_animator_pause(rx_animator* animator) {
@@ -57,12 +57,31 @@ typedef enum rx_easing {
     RX_EASE_SPRING,       /* Spring physics */
 } rx_easing;
 
+#define RX_EASING_COUNT (RX_EASE_SPRING + 1)
+
 /* Apply easing function to progress (0.0 to 1.0) */
 extern float rx_ease(rx_easing easing, float t);
 
 /* Custom cubic bezier easing */
 extern float rx_ease_bezier(float t, float x1, float y1, float x2, float y2);
 
+/* Evaluate one easing over count progress values; out must not overlap t */
+extern void rx_ease_batch(rx_easing easing, const float* t, float* out, size_t count);
+extern void rx_ease_bezier_batch(const float* t, float* out, size_t count,
+                                 float x1, float y1, float x2, float y2);
+
+/*
+ * Bezier, elastic and spring curves are sampled into lookup tables and
+ * linearly interpolated (bezier tables are cached per control-point set).
+ * samples sets the accuracy: 256 keeps the error under 1e-3; 0 evaluates
+ * every call exactly.
+ */
+#define RX_EASE_LUT_DEFAULT 256
+#define RX_EASE_LUT_MAX 4096
+
+extern void rx_ease_set_lut_size(int samples);
+extern int rx_ease_lut_size(void);
+
 /* ============================================================================
  * Spring Physics
  * ============================================================================ */
@@ -94,6 +113,47 @@ extern float rx_spring_update(rx_spring* spring, float dt);
 extern bool rx_spring_is_settled(rx_spring* spring);
 extern void rx_spring_destroy(rx_spring* spring);
 
+/*
+ * Springs integrate in fixed substeps so a long frame can't blow them up.
+ * Frames longer than RX_SPRING_MAX_SUBSTEPS substeps are clamped (the
+ * spring slows down through a hitch instead of overshooting).
+ */
+#define RX_SPRING_SUBSTEP (1.0f / 240.0f)
+#define RX_SPRING_MAX_SUBSTEPS 32
+
+/*
+ * Spring system: springs stored contiguously and stepped in one call.
+ * An id is the slot index in the low 32 bits and the slot's generation in
+ * the high 32; removing a spring bumps the generation, so stale ids miss
+ * instead of driving whatever spring reuses the slot.
+ */
+typedef uint64_t rx_spring_id;
+#define RX_SPRING_INVALID UINT64_MAX
+
+typedef struct rx_spring_system {
+    rx_spring* springs;       /* Indexed by the low half of rx_spring_id */
+    bool* live;
+    uint32_t* generations;    /* 0 is never a live generation */
+    uint32_t* free_ids;
+    size_t count;             /* Slots in use or freed */
+    size_t capacity;
+    size_t free_count;
+    size_t moving;            /* Unsettled after the last update */
+} rx_spring_system;
+
+extern rx_spring_system* rx_spring_system_create(size_t capacity);
+extern void rx_spring_system_destroy(rx_spring_system* sys);
+extern rx_spring_id rx_spring_system_add(rx_spring_system* sys, float initial, rx_spring_config config);
+extern void rx_spring_system_remove(rx_spring_system* sys, rx_spring_id id);
+
+/* Pointer stays valid until the next add */
+extern rx_spring* rx_spring_system_get(rx_spring_system* sys, rx_spring_id id);
+extern void rx_spring_system_set_target(rx_spring_system* sys, rx_spring_id id, float target);
+extern float rx_spring_system_value(rx_spring_system* sys, rx_spring_id id);
+
+/* Step every unsettled spring; returns how many are still moving */
+extern size_t rx_spring_system_update(rx_spring_system* sys, float dt);
+
 /* ============================================================================
  * Animation State
  * ============================================================================ */
@@ -141,8 +201,11 @@ typedef struct rx_animation {
     rx_anim_complete_callback on_complete;
     void* user_data;
     
-    /* Linked list for animator */
-    struct rx_animation* next;
+    /* Animator bookkeeping */
+    struct rx_animation* next;    /* Free-list link while pooled */
+    int32_t slot;                 /* Index in the animator bucket */
+    int16_t bucket;               /* Easing bucket it was scheduled in */
+    bool pooled;                  /* Allocated by rx_animate */
 } rx_animation;
 
 /* Create animation */
@@ -180,16 +243,31 @@ typedef struct rx_keyframe {
     rx_easing easing;     /* Easing to this keyframe */
 } rx_keyframe;
 
+#define RX_KEYFRAME_BAKE_MAX 65536
+
 typedef struct rx_keyframe_animation {
     rx_animation base;
-    rx_keyframe* keyframes;
+    rx_keyframe* keyframes;   /* Sorted by time; equal times keep insertion order */
     size_t keyframe_count;
+    size_t keyframe_capacity;
+    size_t segment;           /* Last segment sampled, checked first */
     bool use_percentages; /* If true, keyframe times are 0-1 */
+    float* baked;             /* baked_size + 1 samples, first to last keyframe */
+    int baked_size;           /* 0: not baked */
+    bool baked_stale;         /* Keyframes changed since baking */
 } rx_keyframe_animation;
 
 extern rx_keyframe_animation* rx_keyframes_create(float duration);
 extern void rx_keyframes_add(rx_keyframe_animation* anim, float time, float value, rx_easing easing);
+/* Sequential sampling reuses the last segment; seeks binary search */
 extern float rx_keyframes_get_value(rx_keyframe_animation* anim, float t);
+/*
+ * Sample the whole timeline into a table of samples segments, read with
+ * linear interpolation afterwards. Meant for long timelines with many
+ * segments; detail finer than the sample spacing is smoothed over. Adding
+ * keyframes rebakes on the next read. samples <= 0 drops the table.
+ */
+extern void rx_keyframes_bake(rx_keyframe_animation* anim, int samples);
 extern void rx_keyframes_destroy(rx_keyframe_animation* anim);
 
 /* ============================================================================
@@ -249,13 +327,28 @@ extern rx_animation* rx_view_pulse(rx_view* view, float duration);
  * Animation Scheduler
  * ============================================================================ */
 
+/* Dense array of scheduled animations sharing one easing */
+typedef struct rx_anim_bucket {
+    rx_animation** items;
+    size_t count;
+    size_t capacity;
+} rx_anim_bucket;
+
 typedef struct rx_animator {
-    rx_animation* animations;
+    rx_anim_bucket buckets[RX_EASING_COUNT];
+    rx_anim_bucket pending;   /* Added while updating, scheduled afterwards */
+    /* Per-bucket scratch for batched easing */
+    uint32_t* batch_index;
+    float* batch_t;
+    float* batch_eased;
+    float* batch_progress;
+    size_t batch_capacity;
     rx_view_animation* view_animations;
     size_t animation_count;
     uint64_t next_id;
     float time_scale;     /* 1.0 = normal, 0.5 = half speed, 2.0 = double */
     bool paused;
+    bool updating;
 } rx_animator;
 
 /* Global animator */
@@ -0,0 +1,313 @@
+/*
+ * REOX Atlas Packer - Implementation
+ * Skyline bottom-left placement with a guillotine waste map
+ */
+
+#include "reox_atlas_packer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+/* ============================================================================
+ * Page Storage
+ * ============================================================================ */
+
+static bool grow(void** items, int* capacity, int needed, size_t elem) {
+    if (needed <= *capacity) return true;
+    int cap = *capacity ? *capacity * 2 : 16;
+    while (cap < needed) cap *= 2;
+    void* p = realloc(*items, elem * (size_t)cap);
+    if (!p) return false;
+    *items = p;
+    *capacity = cap;
+    return true;
+}
+
+static void page_clear(rx_atlas_packer* packer, rx_pack_page* page) {
+    page->skyline[0] = (rx_skyline_node){ 0, 0, packer->page_width };
+    page->node_count = 1;
+    page->free_count = 0;
+    page->used_area = 0;
+    page->allocations = 0;
+}
+
+static bool pages_open(rx_atlas_packer* packer, int count) {
+    if (count > packer->max_pages) return false;
+    if (count <= packer->page_count) return true;
+
+    rx_pack_page* pages = (rx_pack_page*)realloc(packer->pages, sizeof(rx_pack_page) * (size_t)count);
+    if (!pages) return false;
+    packer->pages = pages;
+    for (int i = packer->page_count; i < count; i++) {
+        rx_pack_page* page = &pages[i];
+        memset(page, 0, sizeof(*page));
+        if (!grow((void**)&page->skyline, &page->node_capacity, 1, sizeof(rx_skyline_node))) {
+            packer->page_count = i;
+            return false;
+        }
+        page_clear(packer, page);
+    }
+    packer->page_count = count;
+    return true;
+}
+
+rx_atlas_packer* rx_packer_create(int page_width, int page_height, int padding, int max_pages) {
+    if (page_width <= 0 || page_height <= 0 || max_pages <= 0) return NULL;
+    rx_atlas_packer* packer = (rx_atlas_packer*)calloc(1, sizeof(rx_atlas_packer));
+    if (!packer) return NULL;
+    packer->page_width = page_width;
+    packer->page_height = page_height;
+    packer->padding = padding > 0 ? padding : 0;
+    packer->max_pages = max_pages;
+    return packer;
+}
+
+void rx_packer_destroy(rx_atlas_packer* packer) {
+    if (!packer) return;
+    for (int i = 0; i < packer->page_count; i++) {
+        free(packer->pages[i].skyline);
+        free(packer->pages[i].free_rects);
+    }
+    free(packer->pages);
+    free(packer);
+}
+
+void rx_packer_reset_page(rx_atlas_packer* packer, int page) {
+    if (!packer || page < 0 || page >= packer->page_count) return;
+    page_clear(packer, &packer->pages[page]);
+}
+
+/* ============================================================================
+ * Waste Map
+ * ============================================================================ */
+
+static void free_add(rx_pack_page* page, rx_pack_rect r) {
+    if (r.width <= 0 || r.height <= 0) return;
+    if (!grow((void**)&page->free_rects, &page->free_capacity, page->free_count + 1, sizeof(rx_pack_rect))) {
+        return;     /* Out of memory: the area is just not reused */
+    }
+    page->free_rects[page->free_count++] = r;
+}
+
+/* Join rectangles that share a whole edge, until none do */
+static void free_merge(rx_pack_page* page) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < page->free_count && !merged; i++) {
+            for (int j = i + 1; j < page->free_count; j++) {
+                rx_pack_rect* a = &page->free_rects[i];
+                rx_pack_rect* b = &page->free_rects[j];
+                if (a->x == b->x && a->width == b->width &&
+                    (a->y + a->height == b->y || b->y + b->height == a->y)) {
+                    if (b->y < a->y) a->y = b->y;
+                    a->height += b->height;
+                } else if (a->y == b->y && a->height == b->height &&
+                           (a->x + a->width == b->x || b->x + b->width == a->x)) {
+                    if (b->x < a->x) a->x = b->x;
+                    a->width += b->width;
+                } else {
+                    continue;
+                }
+                page->free_rects[j] = page->free_rects[--page->free_count];
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+/* Best short side fit among the free rectangles, split along the shorter
+ * leftover axis */
+static bool free_take(rx_pack_page* page, int w, int h, int* x, int* y) {
+    int best = -1, best_short = INT_MAX, best_long = INT_MAX;
+    for (int i = 0; i < page->free_count; i++) {
+        const rx_pack_rect* r = &page->free_rects[i];
+        if (r->width < w || r->height < h) continue;
+        int dw = r->width - w, dh = r->height - h;
+        int s = dw < dh ? dw : dh, l = dw < dh ? dh : dw;
+        if (s < best_short || (s == best_short && l < best_long)) {
+            best = i;
+            best_short = s;
+            best_long = l;
+        }
+    }
+    if (best < 0) return false;
+
+    rx_pack_rect r = page->free_rects[best];
+    page->free_rects[best] = page->free_rects[--page->free_count];
+    *x = r.x;
+    *y = r.y;
+
+    int dw = r.width - w, dh = r.height - h;
+    if (dw < dh) {
+        free_add(page, (rx_pack_rect){ r.x + w, r.y, dw, h });
+        free_add(page, (rx_pack_rect){ r.x, r.y + h, r.width, dh });
+    } else {
+        free_add(page, (rx_pack_rect){ r.x + w, r.y, dw, r.height });
+        free_add(page, (rx_pack_rect){ r.x, r.y + h, w, dh });
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Skyline
+ * ============================================================================ */
+
+/* Lowest y at which a w-wide rectangle starting at node i rests, or -1 */
+static int skyline_fit(const rx_atlas_packer* packer, const rx_pack_page* page, int i, int w, int h) {
+    int x = page->skyline[i].x;
+    if (x + w > packer->page_width) return -1;
+    int y = 0, left = w;
+    while (left > 0) {
+        if (page->skyline[i].y > y) y = page->skyline[i].y;
+        if (y + h > packer->page_height) return -1;
+        left -= page->skyline[i].width;
+        i++;
+    }
+    return y;
+}
+
+static bool skyline_place(rx_atlas_packer* packer, rx_pack_page* page, int w, int h, int* out_x, int* out_y) {
+    int best = -1, best_top = INT_MAX, best_width = INT_MAX, best_y = 0;
+    for (int i = 0; i < page->node_count; i++) {
+        int y = skyline_fit(packer, page, i, w, h);
+        if (y < 0) continue;
+        int top = y + h;
+        if (top < best_top || (top == best_top && page->skyline[i].width < best_width)) {
+            best = i;
+            best_top = top;
+            best_width = page->skyline[i].width;
+            best_y = y;
+        }
+    }
+    if (best < 0) return false;
+    if (!grow((void**)&page->skyline, &page->node_capacity, page->node_count + 1, sizeof(rx_skyline_node))) {
+        return false;
+    }
+
+    int x = page->skyline[best].x;
+    /* Gaps under the new rectangle go to the waste map */
+    for (int i = best; i < page->node_count && page->skyline[i].x < x + w; i++) {
+        const rx_skyline_node* n = &page->skyline[i];
+        int right = n->x + n->width < x + w ? n->x + n->width : x + w;
+        free_add(page, (rx_pack_rect){ n->x, n->y, right - n->x, best_y - n->y });
+    }
+
+    /* Insert the new node and trim the ones it covers */
+    memmove(&page->skyline[best + 1], &page->skyline[best],
+            sizeof(rx_skyline_node) * (size_t)(page->node_count - best));
+    page->skyline[best] = (rx_skyline_node){ x, best_y + h, w };
+    page->node_count++;
+
+    int i = best + 1;
+    while (i < page->node_count) {
+        rx_skyline_node* n = &page->skyline[i];
+        int shrink = x + w - n->x;
+        if (shrink <= 0) break;
+        if (shrink < n->width) {
+            n->x += shrink;
+            n->width -= shrink;
+            break;
+        }
+        memmove(n, n + 1, sizeof(rx_skyline_node) * (size_t)(page->node_count - i - 1));
+        page->node_count--;
+    }
+
+    /* Merge neighbours at the same height */
+    for (i = 0; i + 1 < page->node_count;) {
+        if (page->skyline[i].y == page->skyline[i + 1].y) {
+            page->skyline[i].width += page->skyline[i + 1].width;
+            memmove(&page->skyline[i + 1], &page->skyline[i + 2],
+                    sizeof(rx_skyline_node) * (size_t)(page->node_count - i - 2));
+            page->node_count--;
+        } else {
+            i++;
+        }
+    }
+
+    *out_x = x;
+    *out_y = best_y;
+    return true;
+}
+
+/* ============================================================================
+ * Insertion and Removal
+ * ============================================================================ */
+
+static void dirty_add(rx_pack_page* page, int x, int y, int w, int h) {
+    rx_pack_rect* d = &page->dirty;
+    if (d->width == 0) {
+        *d = (rx_pack_rect){ x, y, w, h };
+        return;
+    }
+    int x1 = d->x + d->width > x + w ? d->x + d->width : x + w;
+    int y1 = d->y + d->height > y + h ? d->y + d->height : y + h;
+    if (x < d->x) d->x = x;
+    if (y < d->y) d->y = y;
+    d->width = x1 - d->x;
+    d->height = y1 - d->y;
+}
+
+bool rx_packer_insert_page(rx_atlas_packer* packer, int page_index, int width, int height,
+                           rx_pack_slot* out) {
+    if (!packer || page_index < 0 || width <= 0 || height <= 0) return false;
+    int w = width + packer->padding, h = height + packer->padding;
+    if (w > packer->page_width || h > packer->page_height) {
+        /* Padding is only needed between rectangles, not at the page edge */
+        if (width > packer->page_width || height > packer->page_height) return false;
+        if (w > packer->page_width) w = packer->page_width;
+        if (h > packer->page_height) h = packer->page_height;
+    }
+    if (!pages_open(packer, page_index + 1)) return false;
+
+    rx_pack_page* page = &packer->pages[page_index];
+    int x, y;
+    if (!free_take(page, w, h, &x, &y) && !skyline_place(packer, page, w, h, &x, &y)) return false;
+
+    page->used_area += (int64_t)w * h;
+    page->allocations++;
+    dirty_add(page, x, y, width, height);
+    if (out) *out = (rx_pack_slot){ page_index, x, y, width, height };
+    return true;
+}
+
+bool rx_packer_insert(rx_atlas_packer* packer, int width, int height, rx_pack_slot* out) {
+    if (!packer) return false;
+    for (int i = 0; i < packer->page_count; i++) {
+        if (rx_packer_insert_page(packer, i, width, height, out)) return true;
+    }
+    return packer->page_count < packer->max_pages &&
+           rx_packer_insert_page(packer, packer->page_count, width, height, out);
+}
+
+void rx_packer_remove(rx_atlas_packer* packer, const rx_pack_slot* slot) {
+    if (!packer || !slot || slot->page < 0 || slot->page >= packer->page_count) return;
+    rx_pack_page* page = &packer->pages[slot->page];
+    int w = slot->width + packer->padding, h = slot->height + packer->padding;
+    if (slot->x + w > packer->page_width) w = packer->page_width - slot->x;
+    if (slot->y + h > packer->page_height) h = packer->page_height - slot->y;
+
+    page->used_area -= (int64_t)w * h;
+    if (--page->allocations <= 0) {
+        page_clear(packer, page);
+        return;
+    }
+    free_add(page, (rx_pack_rect){ slot->x, slot->y, w, h });
+    free_merge(page);
+}
+
+bool rx_packer_take_dirty(rx_atlas_packer* packer, int page, rx_pack_rect* out) {
+    if (!packer || page < 0 || page >= packer->page_count) return false;
+    rx_pack_rect* d = &packer->pages[page].dirty;
+    if (d->width == 0) return false;
+    if (out) *out = *d;
+    *d = (rx_pack_rect){ 0, 0, 0, 0 };
+    return true;
+}
+
+float rx_packer_occupancy(const rx_atlas_packer* packer, int page) {
+    if (!packer || page < 0 || page >= packer->page_count) return 0.0f;
+    return (float)((double)packer->pages[page].used_area /
+                   ((double)packer->page_width * packer->page_height));
+}
@@ -0,0 +1,90 @@
+/*
+ * REOX Atlas Packer
+ * Rectangle allocation for texture atlas pages
+ *
+ * Features:
+ * - Skyline bottom-left placement for high occupancy
+ * - Waste map: gaps left under the skyline and freed rectangles are
+ *   reused (best short side fit, guillotine split) before the skyline
+ *   grows, so removal makes room for later insertions
+ * - Multiple pages, added on demand up to a limit
+ * - Per-page dirty rectangle for partial texture uploads
+ *
+ * The packer only does bookkeeping; owners keep the page pixels. Shared by
+ * the glyph cache and rx_texture_atlas.
+ */
+
+#ifndef REOX_ATLAS_PACKER_H
+#define REOX_ATLAS_PACKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Packer Types
+ * ============================================================================ */
+
+typedef struct rx_pack_rect {
+    int x, y, width, height;
+} rx_pack_rect;
+
+/* Top edge of the used area from x to x + width */
+typedef struct rx_skyline_node {
+    int x, y, width;
+} rx_skyline_node;
+
+typedef struct rx_pack_page {
+    rx_skyline_node* skyline;     /* Sorted by x, spans the page width */
+    int node_count, node_capacity;
+    rx_pack_rect* free_rects;     /* Waste map */
+    int free_count, free_capacity;
+    int64_t used_area;
+    int allocations;
+    rx_pack_rect dirty;           /* width 0: clean */
+} rx_pack_page;
+
+typedef struct rx_atlas_packer {
+    int page_width, page_height;
+    int padding;                  /* Gap right of and below every rectangle */
+    int max_pages;
+    rx_pack_page* pages;
+    int page_count;
+} rx_atlas_packer;
+
+/* An allocation: page and unpadded rectangle */
+typedef struct rx_pack_slot {
+    int page;
+    int x, y, width, height;
+} rx_pack_slot;
+
+/* ============================================================================
+ * Packer API
+ * ============================================================================ */
+
+extern rx_atlas_packer* rx_packer_create(int page_width, int page_height, int padding, int max_pages);
+extern void rx_packer_destroy(rx_atlas_packer* packer);
+
+/* First page with room, opening a new page if all are full */
+extern bool rx_packer_insert(rx_atlas_packer* packer, int width, int height, rx_pack_slot* out);
+/* Only into page; pages up to it are opened as needed */
+extern bool rx_packer_insert_page(rx_atlas_packer* packer, int page, int width, int height,
+                                  rx_pack_slot* out);
+/* Return a slot's area for reuse; a page with no allocations left is reset */
+extern void rx_packer_remove(rx_atlas_packer* packer, const rx_pack_slot* slot);
+extern void rx_packer_reset_page(rx_atlas_packer* packer, int page);
+
+/* Bounds of everything allocated on page since the last call */
+extern bool rx_packer_take_dirty(rx_atlas_packer* packer, int page, rx_pack_rect* out);
+/* Allocated fraction of the page area, padding included */
+extern float rx_packer_occupancy(const rx_atlas_packer* packer, int page);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_ATLAS_PACKER_H */
@@ -0,0 +1,656 @@
+/*
+ * REOX Headless Backend - Implementation
+ * Span rasterizer over an RGBA8 buffer
+ */
+
+#include "reox_backend_headless.h"
+#include "reox_glyph_cache.h"
+#include "reox_blur.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define HL_OPACITY_DEPTH 16
+#define HL_FONT_ID 0
+#define HL_BLUR_BUDGET (16u << 20)   /* Bytes of cached blurs */
+
+typedef struct hl_state {
+    uint8_t* pixels;
+    int width, height, stride;
+    int clip_x0, clip_y0, clip_x1, clip_y1;    /* Half-open, inside the buffer */
+    float opacity[HL_OPACITY_DEPTH];
+    int opacity_idx;
+    RxColor clear;
+    uint64_t frames, frame_limit;
+    RxPoint mouse;
+    bool mouse_down;
+
+    /* Text: 8-bit coverage pages behind the glyph cache */
+    rx_glyph_cache* glyphs;
+    uint8_t* pages[RX_GLYPH_MAX_PAGES];
+    uint8_t* scratch;
+    size_t scratch_size;
+
+    /* Blurred backdrops and glow masks, reused across frames */
+    rx_blur_cache* blur;
+} hl_state;
+
+static _Thread_local hl_state hl = { .clear = { 0, 0, 0, 255 }, .opacity = { 1.0f } };
+
+/* ============================================================================
+ * Blending
+ * ============================================================================ */
+
+/* x / 255 rounded, exact for x <= 255 * 255 */
+static inline uint32_t hl_div255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline uint32_t hl_pack(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    uint8_t bytes[4] = { r, g, b, a };
+    uint32_t v;
+    memcpy(&v, bytes, 4);
+    return v;
+}
+
+/* Color alpha scaled by the current opacity, 0-255 */
+static inline uint32_t hl_alpha(RxColor c) {
+    return (uint32_t)(c.a * hl.opacity[hl.opacity_idx] + 0.5f);
+}
+
+/* Source-over of c at alpha a onto one pixel, premultiplied source */
+static inline void hl_blend(uint8_t* p, RxColor c, uint32_t a) {
+    uint32_t inv = 255 - a;
+    p[0] = (uint8_t)(hl_div255(c.r * a) + hl_div255(p[0] * inv));
+    p[1] = (uint8_t)(hl_div255(c.g * a) + hl_div255(p[1] * inv));
+    p[2] = (uint8_t)(hl_div255(c.b * a) + hl_div255(p[2] * inv));
+    p[3] = (uint8_t)(a + hl_div255(p[3] * inv));
+}
+
+/* Pixels [x0, x1) of row in c at alpha a; the caller clips */
+static void hl_span_fill(uint8_t* row, int x0, int x1, RxColor c, uint32_t a) {
+    if (x0 >= x1 || a == 0) return;
+    int n = x1 - x0;
+
+    if (a >= 255) {
+        uint32_t v = hl_pack(c.r, c.g, c.b, 255);
+        uint32_t* q = (uint32_t*)(row + (size_t)x0 * 4);
+        for (int i = 0; i < n; i++) q[i] = v;
+        return;
+    }
+
+    uint8_t* p = row + (size_t)x0 * 4;
+    uint32_t inv = 255 - a;
+    uint8_t src[4] = {
+        (uint8_t)hl_div255(c.r * a), (uint8_t)hl_div255(c.g * a),
+        (uint8_t)hl_div255(c.b * a), (uint8_t)a
+    };
+
+#if defined(__SSE2__)
+    /* dst * (255 - a) / 255 + src, four pixels per iteration */
+    uint32_t packed;
+    memcpy(&packed, src, 4);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vinv = _mm_set1_epi16((short)inv);
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i vsrc = _mm_set1_epi32((int)packed);
+    for (; n >= 4; n -= 4, p += 16) {
+        __m128i d = _mm_loadu_si128((const __m128i*)p);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), vinv), bias);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), vinv), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)p, _mm_adds_epu8(_mm_packus_epi16(lo, hi), vsrc));
+    }
+#endif
+
+    for (; n > 0; n--, p += 4) {
+        p[0] = (uint8_t)(src[0] + hl_div255(p[0] * inv));
+        p[1] = (uint8_t)(src[1] + hl_div255(p[1] * inv));
+        p[2] = (uint8_t)(src[2] + hl_div255(p[2] * inv));
+        p[3] = (uint8_t)(src[3] + hl_div255(p[3] * inv));
+    }
+}
+
+/* One edge pixel at fractional coverage */
+static inline void hl_pixel(uint8_t* row, int x, RxColor c, float a) {
+    if (x < hl.clip_x0 || x >= hl.clip_x1) return;
+    uint32_t ia = (uint32_t)(a + 0.5f);
+    if (ia) hl_blend(row + (size_t)x * 4, c, ia > 255 ? 255 : ia);
+}
+
+/* Row y covered horizontally from fl to fr; partial end pixels get
+ * coverage proportional to how much of them is inside */
+static void hl_span(int y, float fl, float fr, RxColor c, uint32_t a) {
+    if (y < hl.clip_y0 || y >= hl.clip_y1 || fr <= fl || a == 0) return;
+    if (fr <= hl.clip_x0 || fl >= hl.clip_x1) return;
+    if (fl < hl.clip_x0) fl = (float)hl.clip_x0;
+    if (fr > hl.clip_x1) fr = (float)hl.clip_x1;
+    uint8_t* row = hl.pixels + (size_t)y * hl.stride;
+
+    int ix0 = (int)ceilf(fl);
+    int ix1 = (int)floorf(fr);
+    if (ix1 < ix0) {
+        hl_pixel(row, ix1, c, a * (fr - fl));
+        return;
+    }
+    if ((float)ix0 > fl) hl_pixel(row, ix0 - 1, c, a * ((float)ix0 - fl));
+    hl_span_fill(row, ix0, ix1, c, a);
+    if (fr > (float)ix1) hl_pixel(row, ix1, c, a * (fr - (float)ix1));
+}
+
+/* ============================================================================
+ * Shapes
+ * ============================================================================ */
+
+/* Rect with corners of radius r; a circle is the square with r = side / 2 */
+static void hl_fill_round_rect(float x, float y, float w, float h, float r, RxColor c) {
+    uint32_t a = hl_alpha(c);
+    if (w <= 0 || h <= 0 || a == 0) return;
+    float half = (w < h ? w : h) * 0.5f;
+    if (r > half) r = half;
+    if (r < 0) r = 0;
+
+    float x1 = x + w, y1 = y + h;
+    int row0 = (int)floorf(fmaxf(y, (float)hl.clip_y0));
+    int row1 = (int)ceilf(fminf(y1, (float)hl.clip_y1));
+
+    for (int row = row0; row < row1; row++) {
+        float top = y > (float)row ? y : (float)row;
+        float bot = y1 < (float)(row + 1) ? y1 : (float)(row + 1);
+        float cover = bot - top;
+        if (cover <= 0) continue;
+
+        float inset = 0;
+        if (r > 0) {
+            float yc = (top + bot) * 0.5f, dy = 0;
+            if (yc < y + r) dy = y + r - yc;
+            else if (yc > y1 - r) dy = yc - (y1 - r);
+            if (dy > 0) {
+                float d2 = r * r - dy * dy;
+                inset = r - (d2 > 0 ? sqrtf(d2) : 0);
+            }
+        }
+        hl_span(row, x + inset, x1 - inset, c, (uint32_t)(a * cover + 0.5f));
+    }
+}
+
+/* Convex quad, scanned at pixel-row centres */
+static void hl_fill_quad(const float* px, const float* py, RxColor c, uint32_t a) {
+    float miny = py[0], maxy = py[0];
+    for (int i = 1; i < 4; i++) {
+        if (py[i] < miny) miny = py[i];
+        if (py[i] > maxy) maxy = py[i];
+    }
+    int row0 = (int)floorf(fmaxf(miny, (float)hl.clip_y0));
+    int row1 = (int)ceilf(fminf(maxy, (float)hl.clip_y1));
+
+    for (int row = row0; row < row1; row++) {
+        float yc = (float)row + 0.5f;
+        float xl = INFINITY, xr = -INFINITY;
+        for (int i = 0; i < 4; i++) {
+            int j = (i + 1) & 3;
+            if ((py[i] <= yc) == (py[j] <= yc)) continue;
+            float xi = px[i] + (yc - py[i]) * (px[j] - px[i]) / (py[j] - py[i]);
+            if (xi < xl) xl = xi;
+            if (xi > xr) xr = xi;
+        }
+        if (xl < xr) hl_span(row, xl, xr, c, a);
+    }
+}
+
+/* ============================================================================
+ * Text
+ * ============================================================================ */
+
+/* 5x7 font for ASCII 32-126: five columns, bit 0 is the top row */
+static const uint8_t hl_font[95][5] = {
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00},
+    {0x14,0x7F,0x14,0x7F,0x14}, {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62},
+    {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00}, {0x00,0x1C,0x22,0x41,0x00},
+    {0x00,0x41,0x22,0x1C,0x00}, {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08},
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00},
+    {0x20,0x10,0x08,0x04,0x02}, {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00},
+    {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, {0x18,0x14,0x12,0x7F,0x10},
+    {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00},
+    {0x00,0x56,0x36,0x00,0x00}, {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14},
+    {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, {0x32,0x49,0x79,0x41,0x3E},
+    {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01},
+    {0x3E,0x41,0x49,0x49,0x7A}, {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00},
+    {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, {0x7F,0x40,0x40,0x40,0x40},
+    {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46},
+    {0x46,0x49,0x49,0x49,0x31}, {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F},
+    {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, {0x63,0x14,0x08,0x14,0x63},
+    {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04},
+    {0x40,0x40,0x40,0x40,0x40}, {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78},
+    {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20}, {0x38,0x44,0x44,0x48,0x7F},
+    {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+    {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00},
+    {0x7F,0x10,0x28,0x44,0x00}, {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78},
+    {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, {0x7C,0x14,0x14,0x14,0x08},
+    {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+    {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C},
+    {0x3C,0x40,0x30,0x40,0x3C}, {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C},
+    {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, {0x00,0x00,0x7F,0x00,0x00},
+    {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08}
+};
+
+/* Font cell is 6 x 8 units: one column and one row of spacing */
+static bool hl_glyph_rasterize(void* ctx, uint32_t font_id, int px, uint32_t cp,
+                               rx_glyph_bitmap* out) {
+    if (cp < 32 || cp > 126) cp = '?';
+    float unit = px / 8.0f;
+    memset(out, 0, sizeof(*out));
+    out->advance = unit * 6;
+    if (cp == ' ') return true;
+
+    int w = (int)lroundf(unit * 5), h = (int)lroundf(unit * 7);
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    size_t need = (size_t)w * (size_t)h;
+    if (need > hl.scratch_size) {
+        uint8_t* grown = (uint8_t*)realloc(hl.scratch, need);
+        if (!grown) return false;
+        hl.scratch = grown;
+        hl.scratch_size = need;
+    }
+
+    /* Nearest sampling keeps the strokes crisp at every size */
+    const uint8_t* cols = hl_font[cp - 32];
+    for (int yy = 0; yy < h; yy++) {
+        int bit = yy * 7 / h;
+        for (int xx = 0; xx < w; xx++) {
+            hl.scratch[yy * w + xx] = ((cols[xx * 5 / w] >> bit) & 1) ? 255 : 0;
+        }
+    }
+    out->width = w;
+    out->height = h;
+    out->top = (int)lroundf(unit * 0.5f);
+    out->pixels = hl.scratch;
+    out->pitch = w;
+    return true;
+}
+
+static void hl_glyph_upload(void* ctx, int page, int x, int y, const rx_glyph_bitmap* bitmap) {
+    if (!hl.pages[page]) return;
+    const uint8_t* src = (const uint8_t*)bitmap->pixels;
+    for (int row = 0; row < bitmap->height; row++) {
+        memcpy(hl.pages[page] + (size_t)(y + row) * RX_GLYPH_PAGE_SIZE + x,
+               src + (size_t)row * bitmap->pitch, (size_t)bitmap->width);
+    }
+}
+
+static void hl_glyph_page_created(void* ctx, int page) {
+    size_t size = (size_t)RX_GLYPH_PAGE_SIZE * RX_GLYPH_PAGE_SIZE;
+    if (!hl.pages[page]) hl.pages[page] = (uint8_t*)malloc(size);
+    if (!hl.pages[page]) return;
+    memset(hl.pages[page], 0, size);
+    for (int y = 0; y < RX_GLYPH_WHITE_SIZE; y++) {
+        memset(hl.pages[page] + (size_t)y * RX_GLYPH_PAGE_SIZE, 255, RX_GLYPH_WHITE_SIZE);
+    }
+}
+
+static float hl_glyph_line_height(void* ctx, uint32_t font_id, int px) {
+    return (float)px;
+}
+
+/* Coverage mask at (x, y) in c at alpha a */
+static void hl_blit_mask(const uint8_t* mask, int pitch, int x, int y, int w, int h,
+                         RxColor c, uint32_t a) {
+    int x0 = x < hl.clip_x0 ? hl.clip_x0 : x;
+    int y0 = y < hl.clip_y0 ? hl.clip_y0 : y;
+    int x1 = x + w > hl.clip_x1 ? hl.clip_x1 : x + w;
+    int y1 = y + h > hl.clip_y1 ? hl.clip_y1 : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint32_t opaque = hl_pack(c.r, c.g, c.b, 255);
+    for (int row = y0; row < y1; row++) {
+        const uint8_t* m = mask + (size_t)(row - y) * pitch + (x0 - x);
+        uint8_t* p = hl.pixels + (size_t)row * hl.stride + (size_t)x0 * 4;
+        for (int col = x0; col < x1; col++, m++, p += 4) {
+            if (!*m) continue;
+            uint32_t ma = hl_div255(*m * a);
+            if (ma >= 255) memcpy(p, &opaque, 4);
+            else if (ma) hl_blend(p, c, ma);
+        }
+    }
+}
+
+/* ============================================================================
+ * Backend Implementation
+ * ============================================================================ */
+
+static void hl_reset_clip(void) {
+    hl.clip_x0 = 0;
+    hl.clip_y0 = 0;
+    hl.clip_x1 = hl.width;
+    hl.clip_y1 = hl.height;
+}
+
+static void hl_clear(void) {
+    uint32_t v = hl_pack(hl.clear.r, hl.clear.g, hl.clear.b, hl.clear.a);
+    for (int y = 0; y < hl.height; y++) {
+        uint32_t* row = (uint32_t*)(hl.pixels + (size_t)y * hl.stride);
+        for (int x = 0; x < hl.width; x++) row[x] = v;
+    }
+}
+
+bool rx_headless_resize(int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+    uint8_t* pixels = (uint8_t*)malloc((size_t)width * (size_t)height * 4);
+    if (!pixels) return false;
+    free(hl.pixels);
+    hl.pixels = pixels;
+    hl.width = width;
+    hl.height = height;
+    hl.stride = width * 4;
+    hl_reset_clip();
+    hl_clear();
+    return true;
+}
+
+static bool hl_init(int width, int height, const char* title) {
+    if (!rx_headless_resize(width, height)) return false;
+    if (!hl.glyphs) {
+        rx_glyph_backend backend = {
+            .rasterize = hl_glyph_rasterize,
+            .upload = hl_glyph_upload,
+            .line_height = hl_glyph_line_height,
+            .page_created = hl_glyph_page_created
+        };
+        hl.glyphs = rx_glyph_cache_create(&backend);
+    }
+    if (!hl.blur) hl.blur = rx_blur_cache_create(HL_BLUR_BUDGET);
+    hl.frames = 0;
+    hl.opacity_idx = 0;
+    hl.opacity[0] = 1.0f;
+    return true;
+}
+
+static void hl_destroy(void) {
+    if (hl.glyphs) {
+        rx_glyph_cache_destroy(hl.glyphs);
+        hl.glyphs = NULL;
+    }
+    for (int i = 0; i < RX_GLYPH_MAX_PAGES; i++) {
+        free(hl.pages[i]);
+        hl.pages[i] = NULL;
+    }
+    rx_blur_cache_destroy(hl.blur);
+    hl.blur = NULL;
+    free(hl.scratch);
+    hl.scratch = NULL;
+    hl.scratch_size = 0;
+    free(hl.pixels);
+    hl.pixels = NULL;
+    hl.width = hl.height = hl.stride = 0;
+}
+
+static void hl_begin_frame(void) {
+    hl_reset_clip();
+    hl.opacity_idx = 0;
+    hl.opacity[0] = 1.0f;
+    hl_clear();
+    if (hl.glyphs) rx_glyph_cache_begin_frame(hl.glyphs);
+}
+
+static void hl_end_frame(void) {
+    if (hl.blur) rx_blur_cache_end_frame(hl.blur);
+    hl.frames++;
+}
+
+static bool hl_poll_events(void) {
+    return hl.frame_limit == 0 || hl.frames < hl.frame_limit;
+}
+
+/* Nothing ever arrives, so there is nothing to wait for */
+static bool hl_wait_events(int timeout_ms) {
+    return hl_poll_events();
+}
+
+static void hl_draw_rect(RxRect rect, RxColor color, float radius) {
+    if (!hl.pixels) return;
+    hl_fill_round_rect(rect.x, rect.y, rect.w, rect.h, radius, color);
+}
+
+static void hl_draw_circle(RxPoint center, float radius, RxColor color) {
+    if (!hl.pixels) return;
+    hl_fill_round_rect(center.x - radius, center.y - radius, radius * 2, radius * 2,
+                       radius, color);
+}
+
+static void hl_draw_line(RxPoint p1, RxPoint p2, RxColor color, float width) {
+    if (!hl.pixels) return;
+    float dx = p2.x - p1.x, dy = p2.y - p1.y;
+    float len = sqrtf(dx * dx + dy * dy);
+    uint32_t a = hl_alpha(color);
+    if (len <= 0 || a == 0) return;
+
+    /* Hairlines are drawn one pixel wide at reduced alpha */
+    if (width < 1) {
+        a = (uint32_t)(a * (width > 0 ? width : 0) + 0.5f);
+        width = 1;
+    }
+    float nx = -dy / len * width * 0.5f, ny = dx / len * width * 0.5f;
+    float qx[4] = { p1.x + nx, p2.x + nx, p2.x - nx, p1.x - nx };
+    float qy[4] = { p1.y + ny, p2.y + ny, p2.y - ny, p1.y - ny };
+    hl_fill_quad(qx, qy, color, a);
+}
+
+static void hl_draw_text(const char* text, RxPoint pos, RxColor color, float size) {
+    if (!hl.pixels || !hl.glyphs || !text || !*text) return;
+    uint32_t a = hl_alpha(color);
+    if (a == 0) return;
+    const rx_text_run* run = rx_text_run_get(hl.glyphs, HL_FONT_ID, size, text);
+    if (!run) return;
+
+    int base_y = (int)lroundf(pos.y);
+    for (int i = 0; i < run->glyph_count; i++) {
+        const rx_glyph* g = rx_glyph_cache_get(hl.glyphs, HL_FONT_ID, run->px,
+                                               run->glyphs[i].codepoint);
+        if (!g || g->page < 0 || !hl.pages[g->page]) continue;
+        const uint8_t* mask = hl.pages[g->page] + (size_t)g->y * RX_GLYPH_PAGE_SIZE + g->x;
+        hl_blit_mask(mask, RX_GLYPH_PAGE_SIZE,
+                     (int)lroundf(pos.x + run->glyphs[i].x) + g->left, base_y + g->top,
+                     g->width, g->height, color, a);
+    }
+}
+
+static void hl_set_clip(RxRect rect) {
+    hl_reset_clip();
+    int x0 = (int)floorf(rect.x), y0 = (int)floorf(rect.y);
+    int x1 = (int)ceilf(rect.x + rect.w), y1 = (int)ceilf(rect.y + rect.h);
+    if (x0 > hl.clip_x0) hl.clip_x0 = x0;
+    if (y0 > hl.clip_y0) hl.clip_y0 = y0;
+    if (x1 < hl.clip_x1) hl.clip_x1 = x1;
+    if (y1 < hl.clip_y1) hl.clip_y1 = y1;
+    if (hl.clip_x1 < hl.clip_x0) hl.clip_x1 = hl.clip_x0;
+    if (hl.clip_y1 < hl.clip_y0) hl.clip_y1 = hl.clip_y0;
+}
+
+static void hl_clear_clip(void) {
+    hl_reset_clip();
+}
+
+static void hl_push_opacity(float alpha) {
+    if (hl.opacity_idx < HL_OPACITY_DEPTH - 1) {
+        hl.opacity_idx++;
+        hl.opacity[hl.opacity_idx] = hl.opacity[hl.opacity_idx - 1] * alpha;
+    }
+}
+
+static void hl_pop_opacity(void) {
+    if (hl.opacity_idx > 0) hl.opacity_idx--;
+}
+
+/* The pixels under rect, blurred, written back inside its rounded shape */
+static void hl_blur_backdrop(RxRect rect, float radius, float corner_radius) {
+    if (!hl.pixels || !hl.blur || radius <= 0 || rect.w <= 0 || rect.h <= 0) return;
+    int x0 = (int)floorf(fmaxf(rect.x, (float)hl.clip_x0));
+    int y0 = (int)floorf(fmaxf(rect.y, (float)hl.clip_y0));
+    int x1 = (int)ceilf(fminf(rect.x + rect.w, (float)hl.clip_x1));
+    int y1 = (int)ceilf(fminf(rect.y + rect.h, (float)hl.clip_y1));
+    if (x0 >= x1 || y0 >= y1) return;
+    const uint8_t* blurred = rx_blur_cache_backdrop(hl.blur, hl.pixels, hl.width, hl.height,
+                                                    hl.stride, x0, y0, x1 - x0, y1 - y0, radius);
+    if (!blurred) return;
+
+    float a = 255.0f * hl.opacity[hl.opacity_idx];
+    float half = (rect.w < rect.h ? rect.w : rect.h) * 0.5f;
+    float r = corner_radius > half ? half : (corner_radius < 0 ? 0 : corner_radius);
+    float rx1 = rect.x + rect.w, ry1 = rect.y + rect.h;
+    size_t pitch = (size_t)(x1 - x0) * 4;
+
+    for (int row = y0; row < y1; row++) {
+        float top = fmaxf(rect.y, (float)row), bot = fminf(ry1, (float)(row + 1));
+        float cover = bot - top;
+        if (cover <= 0) continue;
+        float inset = 0;
+        if (r > 0) {
+            float yc = (top + bot) * 0.5f, dy = 0;
+            if (yc < rect.y + r) dy = rect.y + r - yc;
+            else if (yc > ry1 - r) dy = yc - (ry1 - r);
+            if (dy > 0) {
+                float d2 = r * r - dy * dy;
+                inset = r - (d2 > 0 ? sqrtf(d2) : 0);
+            }
+        }
+        float left = rect.x + inset, right = rx1 - inset;
+        int c0 = (int)floorf(left) > x0 ? (int)floorf(left) : x0;
+        int c1 = (int)ceilf(right) < x1 ? (int)ceilf(right) : x1;
+        const uint8_t* b = blurred + (size_t)(row - y0) * pitch + (size_t)(c0 - x0) * 4;
+        uint8_t* p = hl.pixels + (size_t)row * hl.stride + (size_t)c0 * 4;
+        for (int col = c0; col < c1; col++, b += 4, p += 4) {
+            float h = fminf(right, (float)col + 1) - fmaxf(left, (float)col);
+            uint32_t ma = (uint32_t)(a * cover * (h > 1 ? 1 : h) + 0.5f);
+            if (ma >= 255) {
+                memcpy(p, b, 4);
+            } else if (ma) {
+                uint32_t inv = 255 - ma;
+                for (int ch = 0; ch < 4; ch++) p[ch] = (uint8_t)(hl_div255(b[ch] * ma) + hl_div255(p[ch] * inv));
+            }
+        }
+    }
+}
+
+/* Cached blurred mask of the shape in color */
+static void hl_draw_glow(RxRect rect, RxColor color, float radius, float intensity, float corner_radius) {
+    if (!hl.pixels || !hl.blur || intensity <= 0) return;
+    int mw, mh, pad;
+    const uint8_t* mask = rx_blur_cache_glow(hl.blur, rect.w, rect.h, corner_radius, radius, &mw, &mh, &pad);
+    if (!mask) return;
+    /* Intensity above 1 saturates the halo further out */
+    uint32_t a = (uint32_t)(hl_alpha(color) * fminf(intensity, 4.0f) + 0.5f);
+    hl_blit_mask(mask, mw, (int)lroundf(rect.x) - pad, (int)lroundf(rect.y) - pad, mw, mh, color, a);
+}
+
+static RxPoint hl_get_mouse(void) {
+    return hl.mouse;
+}
+
+static bool hl_is_mouse_down(int button) {
+    return button == 0 && hl.mouse_down;
+}
+
+static bool hl_is_key_down(int key) {
+    return false;
+}
+
+RxBackend rx_backend_headless = {
+    .name = "headless",
+    .init = hl_init,
+    .destroy = hl_destroy,
+    .begin_frame = hl_begin_frame,
+    .end_frame = hl_end_frame,
+    .poll_events = hl_poll_events,
+    .wait_events = hl_wait_events,
+    .refresh_rate = NULL,
+    .wake = NULL,
+    .vsync = false,
+    .draw_rect = hl_draw_rect,
+    .draw_circle = hl_draw_circle,
+    .draw_line = hl_draw_line,
+    .draw_text = hl_draw_text,
+    .set_clip = hl_set_clip,
+    .clear_clip = hl_clear_clip,
+    .push_opacity = hl_push_opacity,
+    .pop_opacity = hl_pop_opacity,
+    .blur_backdrop = hl_blur_backdrop,
+    .draw_glow = hl_draw_glow,
+    .get_mouse_pos = hl_get_mouse,
+    .is_mouse_down = hl_is_mouse_down,
+    .is_key_down = hl_is_key_down,
+    .userdata = NULL
+};
+
+/* ============================================================================
+ * Control and Snapshots
+ * ============================================================================ */
+
+const uint8_t* rx_headless_pixels(int* width, int* height, int* stride) {
+    if (width) *width = hl.width;
+    if (height) *height = hl.height;
+    if (stride) *stride = hl.stride;
+    return hl.pixels;
+}
+
+void rx_headless_set_clear_color(RxColor color) {
+    hl.clear = color;
+}
+
+void rx_headless_set_frame_limit(uint64_t frames) {
+    hl.frame_limit = frames;
+}
+
+uint64_t rx_headless_frame_count(void) {
+    return hl.frames;
+}
+
+void rx_headless_set_mouse(RxPoint pos, bool left_down) {
+    hl.mouse = pos;
+    hl.mouse_down = left_down;
+}
+
+uint64_t rx_headless_checksum(void) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int y = 0; y < hl.height; y++) {
+        const uint8_t* row = hl.pixels + (size_t)y * hl.stride;
+        for (int i = 0; i < hl.width * 4; i++) {
+            hash ^= row[i];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+int rx_headless_write_ppm(const char* path) {
+    if (!hl.pixels || !path) return -1;
+    FILE* f = fopen(path, "wb");
+    if (!f) return -1;
+
+    fprintf(f, "P6\n%d %d\n255\n", hl.width, hl.height);
+    uint8_t* rgb = (uint8_t*)malloc((size_t)hl.width * 3);
+    int result = rgb ? 0 : -1;
+    for (int y = 0; y < hl.height && result == 0; y++) {
+        const uint8_t* row = hl.pixels + (size_t)y * hl.stride;
+        for (int x = 0; x < hl.width; x++) {
+            rgb[x * 3 + 0] = row[x * 4 + 0];
+            rgb[x * 3 + 1] = row[x * 4 + 1];
+            rgb[x * 3 + 2] = row[x * 4 + 2];
+        }
+        if (fwrite(rgb, 3, (size_t)hl.width, f) != (size_t)hl.width) result = -1;
+    }
+    free(rgb);
+    if (fclose(f) != 0) result = -1;
+    return result;
+}
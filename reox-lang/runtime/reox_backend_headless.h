@@ -0,0 +1,62 @@
+/*
+ * REOX Headless Backend
+ * Software rasterizer for the RxBackend interface, no window or GPU
+ *
+ * Features:
+ * - Renders into an in-memory RGBA8 buffer (bytes R, G, B, A)
+ * - Shapes are filled a row span at a time, with anti-aliased edges
+ *   for fractional bounds, rounded corners, circles and lines
+ * - Constant-colour spans are stored with wide writes when opaque and
+ *   blended four pixels at a time with SSE2 when translucent
+ * - Text through the shared glyph atlas (reox_glyph_cache), rasterized
+ *   from a built-in 5x7 bitmap font
+ * - Clip rect and opacity stack as in the SDL backend
+ * - Backdrop blur and glows through a per-thread reox_blur cache, so
+ *   unchanged backdrops and repeated glow shapes are not blurred again
+ * - State is per thread, so several threads can render at once
+ * - Snapshot helpers: PPM output and a checksum of the pixels
+ *
+ * With a frame limit set, poll_events reports quit after that many
+ * frames, so rx_app_run renders a fixed number of frames and returns.
+ */
+
+#ifndef REOX_BACKEND_HEADLESS_H
+#define REOX_BACKEND_HEADLESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "reox_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern RxBackend rx_backend_headless;
+
+/* Reallocate the target; the contents become the clear color */
+extern bool rx_headless_resize(int width, int height);
+
+/* The target: width * height pixels, stride bytes per row. NULL before init. */
+extern const uint8_t* rx_headless_pixels(int* width, int* height, int* stride);
+
+/* Color begin_frame clears to (default opaque black) */
+extern void rx_headless_set_clear_color(RxColor color);
+
+/* poll_events returns false once this many frames have ended (0: never) */
+extern void rx_headless_set_frame_limit(uint64_t frames);
+extern uint64_t rx_headless_frame_count(void);
+
+/* Input seen through get_mouse_pos / is_mouse_down */
+extern void rx_headless_set_mouse(RxPoint pos, bool left_down);
+
+/* FNV-1a over the visible pixels, for comparing snapshots */
+extern uint64_t rx_headless_checksum(void);
+
+/* Binary PPM (P6), alpha dropped; 0 on success */
+extern int rx_headless_write_ppm(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_BACKEND_HEADLESS_H */
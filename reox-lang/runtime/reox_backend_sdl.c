@@ -9,11 +9,14 @@
  */
 
 #include "reox_ffi.h"
+#include "reox_runloop.h"
 
 #ifdef REOX_USE_SDL
 
 #include <SDL2/SDL.h>
 #include <math.h>
+#include <string.h>
+#include "reox_sdl_geometry.h"
 
 static SDL_Window* g_window = NULL;
 static SDL_Renderer* g_renderer = NULL;
@@ -24,6 +27,9 @@ static int g_opacity_idx = 0;
 static RxPoint g_mouse = {0, 0};
 static uint32_t g_mouse_state = 0;
 
+/* All filled shapes of a frame, submitted in one SDL_RenderGeometry call */
+static RxGeoBatch g_batch = {0};
+
 /* ============================================================================
  * Backend Implementation
  * ============================================================================ */
@@ -59,6 +65,7 @@ static bool sdl_init(int width, int height, const char* title) {
 }
 
 static void sdl_destroy(void) {
+    rx_geo_free(&g_batch);
     if (g_renderer) { SDL_DestroyRenderer(g_renderer); g_renderer = NULL; }
     if (g_window) { SDL_DestroyWindow(g_window); g_window = NULL; }
     SDL_Quit();
@@ -69,149 +76,132 @@ static void sdl_begin_frame(void) {
     SDL_RenderClear(g_renderer);
     g_opacity_idx = 0;
     g_opacity_stack[0] = 1.0f;
+    g_batch.vert_count = 0;
+    g_batch.index_count = 0;
 }
 
 static void sdl_end_frame(void) {
+    rx_geo_flush(&g_batch, g_renderer);
     SDL_RenderPresent(g_renderer);
 }
 
+/* Handle one event; input and window changes ask the run loop for a frame */
+static bool sdl_handle_event(const SDL_Event* event) {
+    switch (event->type) {
+        case SDL_QUIT:
+            return false;
+        case SDL_KEYDOWN:
+            if (event->key.keysym.sym == SDLK_ESCAPE) return false;
+            rx_runloop_request_frame(rx_runloop_main());
+            break;
+        case SDL_KEYUP:
+        case SDL_TEXTINPUT:
+        case SDL_MOUSEWHEEL:
+            rx_runloop_request_frame(rx_runloop_main());
+            break;
+        case SDL_MOUSEMOTION:
+            g_mouse.x = (float)event->motion.x;
+            g_mouse.y = (float)event->motion.y;
+            rx_runloop_request_frame(rx_runloop_main());
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            g_mouse_state = SDL_GetMouseState(NULL, NULL);
+            rx_runloop_request_frame(rx_runloop_main());
+            break;
+        case SDL_WINDOWEVENT:
+            if (event->window.event == SDL_WINDOWEVENT_RESIZED) {
+                g_width = event->window.data1;
+                g_height = event->window.data2;
+            }
+            if (event->window.event == SDL_WINDOWEVENT_RESIZED ||
+                event->window.event == SDL_WINDOWEVENT_EXPOSED ||
+                event->window.event == SDL_WINDOWEVENT_SHOWN) {
+                rx_runloop_request_frame(rx_runloop_main());
+            }
+            break;
+    }
+    return true;
+}
+
 static bool sdl_poll_events(void) {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                return false;
-            case SDL_KEYDOWN:
-                if (event.key.keysym.sym == SDLK_ESCAPE) return false;
-                break;
-            case SDL_MOUSEMOTION:
-                g_mouse.x = (float)event.motion.x;
-                g_mouse.y = (float)event.motion.y;
-                break;
-            case SDL_MOUSEBUTTONDOWN:
-            case SDL_MOUSEBUTTONUP:
-                g_mouse_state = SDL_GetMouseState(NULL, NULL);
-                break;
-            case SDL_WINDOWEVENT:
-                if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
-                    g_width = event.window.data1;
-                    g_height = event.window.data2;
-                }
-                break;
-        }
+        if (!sdl_handle_event(&event)) return false;
     }
     return true;
 }
 
-static void sdl_draw_rect(RxRect rect, RxColor color, float radius) {
+/* Sleep in SDL until input or the timeout, then drain the queue */
+static bool sdl_wait_events(int timeout_ms) {
+    SDL_Event event;
+    int got = timeout_ms < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, timeout_ms);
+    if (got && !sdl_handle_event(&event)) return false;
+    return sdl_poll_events();
+}
+
+/* Any thread: SDL_PushEvent is thread-safe and ends a blocked SDL_WaitEvent */
+static void sdl_wake(void) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+}
+
+static float sdl_refresh_rate(void) {
+    SDL_DisplayMode mode;
+    int display = g_window ? SDL_GetWindowDisplayIndex(g_window) : 0;
+    if (display < 0 || SDL_GetCurrentDisplayMode(display, &mode) != 0) return 0.0f;
+    return (float)mode.refresh_rate;
+}
+
+static SDL_Color sdl_color(RxColor color) {
     float alpha = g_opacity_stack[g_opacity_idx];
-    uint8_t a = (uint8_t)(color.a * alpha);
-    
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, a);
-    
+    SDL_Color c = { color.r, color.g, color.b, (uint8_t)(color.a * alpha) };
+    return c;
+}
+
+static void sdl_draw_rect(RxRect rect, RxColor color, float radius) {
+    SDL_Color c = sdl_color(color);
     if (radius <= 0) {
-        SDL_FRect r = {rect.x, rect.y, rect.w, rect.h};
-        SDL_RenderFillRectF(g_renderer, &r);
-        return;
-    }
-    
-    /* Rounded rect */
-    float r = fminf(radius, fminf(rect.w/2, rect.h/2));
-    float x = rect.x, y = rect.y, w = rect.w, h = rect.h;
-    
-    /* Center */
-    SDL_FRect center = {x + r, y, w - 2*r, h};
-    SDL_RenderFillRectF(g_renderer, &center);
-    
-    /* Left/Right */
-    SDL_FRect left = {x, y + r, r, h - 2*r};
-    SDL_FRect right = {x + w - r, y + r, r, h - 2*r};
-    SDL_RenderFillRectF(g_renderer, &left);
-    SDL_RenderFillRectF(g_renderer, &right);
-    
-    /* Corners (pixel by pixel for now) */
-    for (int cy = 0; cy < (int)r; cy++) {
-        for (int cx = 0; cx < (int)r; cx++) {
-            float dx = r - cx - 0.5f, dy = r - cy - 0.5f;
-            if (dx*dx + dy*dy <= r*r) {
-                SDL_RenderDrawPointF(g_renderer, x + cx, y + cy);
-                SDL_RenderDrawPointF(g_renderer, x + w - r + cx, y + cy);
-                SDL_RenderDrawPointF(g_renderer, x + cx, y + h - r + cy);
-                SDL_RenderDrawPointF(g_renderer, x + w - r + cx, y + h - r + cy);
-            }
-        }
+        rx_geo_rect(&g_batch, rect.x, rect.y, rect.w, rect.h, c);
+    } else {
+        rx_geo_rounded_rect(&g_batch, rect.x, rect.y, rect.w, rect.h, radius, c);
     }
 }
 
 static void sdl_draw_circle(RxPoint center, float radius, RxColor color) {
-    float alpha = g_opacity_stack[g_opacity_idx];
-    uint8_t a = (uint8_t)(color.a * alpha);
-    
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, a);
-    
-    int r = (int)radius;
-    for (int y = -r; y <= r; y++) {
-        for (int x = -r; x <= r; x++) {
-            if (x*x + y*y <= r*r) {
-                SDL_RenderDrawPointF(g_renderer, center.x + x, center.y + y);
-            }
-        }
-    }
+    rx_geo_circle(&g_batch, center.x, center.y, radius, sdl_color(color));
 }
 
 static void sdl_draw_line(RxPoint p1, RxPoint p2, RxColor color, float width) {
-    float alpha = g_opacity_stack[g_opacity_idx];
-    uint8_t a = (uint8_t)(color.a * alpha);
-    
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, a);
-    
-    /* Simple line - SDL only has 1px lines, so we draw multiple for width */
-    if (width <= 1) {
-        SDL_RenderDrawLineF(g_renderer, p1.x, p1.y, p2.x, p2.y);
-    } else {
-        /* Perpendicular offset for thickness */
-        float dx = p2.x - p1.x, dy = p2.y - p1.y;
-        float len = sqrtf(dx*dx + dy*dy);
-        if (len > 0) {
-            float nx = -dy / len, ny = dx / len;
-            for (float w = -width/2; w <= width/2; w += 1.0f) {
-                SDL_RenderDrawLineF(g_renderer, 
-                    p1.x + nx*w, p1.y + ny*w, 
-                    p2.x + nx*w, p2.y + ny*w);
-            }
-        }
-    }
+    rx_geo_line(&g_batch, p1.x, p1.y, p2.x, p2.y, width, sdl_color(color));
 }
 
 static void sdl_draw_text(const char* text, RxPoint pos, RxColor color, float size) {
     /* Placeholder - SDL2 needs SDL_ttf for real text */
-    float alpha = g_opacity_stack[g_opacity_idx];
-    uint8_t a = (uint8_t)(color.a * alpha);
-    
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, a);
-    
     if (!text) return;
+    SDL_Color c = sdl_color(color);
     
     /* Draw rectangles as placeholder for each character */
     float x = pos.x;
     float char_w = size * 0.6f;
     float char_h = size;
     
-    for (const char* c = text; *c; c++) {
-        if (*c != ' ') {
-            SDL_FRect r = {x, pos.y, char_w - 2, char_h};
-            SDL_RenderFillRectF(g_renderer, &r);
-        }
+    for (const char* ch = text; *ch; ch++) {
+        if (*ch != ' ') rx_geo_rect(&g_batch, x, pos.y, char_w - 2, char_h, c);
         x += char_w;
     }
 }
 
 static void sdl_set_clip(RxRect rect) {
+    rx_geo_flush(&g_batch, g_renderer);
     SDL_Rect r = {(int)rect.x, (int)rect.y, (int)rect.w, (int)rect.h};
     SDL_RenderSetClipRect(g_renderer, &r);
 }
 
 static void sdl_clear_clip(void) {
+    rx_geo_flush(&g_batch, g_renderer);
     SDL_RenderSetClipRect(g_renderer, NULL);
 }
 
@@ -253,6 +243,10 @@ RxBackend rx_backend_sdl = {
     .begin_frame = sdl_begin_frame,
     .end_frame = sdl_end_frame,
     .poll_events = sdl_poll_events,
+    .wait_events = sdl_wait_events,
+    .refresh_rate = sdl_refresh_rate,
+    .wake = sdl_wake,
+    .vsync = true,
     .draw_rect = sdl_draw_rect,
     .draw_circle = sdl_draw_circle,
     .draw_line = sdl_draw_line,
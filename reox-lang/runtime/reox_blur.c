@@ -0,0 +1,486 @@
+/*
+ * REOX Blur - Implementation
+ * Downsample / small kernel / upsample chain and the result cache
+ */
+
+#include "reox_blur.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BLUR_MAX_LEVELS 6
+#define BLUR_KERNEL_SIGMA 1.5f      /* Go down a level while more is left */
+#define BLUR_MIN_SIGMA 0.2f         /* Below this the kernel is a copy */
+#define BLUR_MAX_HALF_TAPS 8
+#define BLUR_MIN_LEVEL_SIZE 4
+#define BLUR_IDLE_FRAMES 120        /* Entries unused this long are dropped */
+
+/*
+ * Variance (in pixels of the finer level) that one trip down and back up
+ * adds: the 2x2 box is 1/4, the bilinear upsample 1/6 of the coarser
+ * level's pixel, which is 4/6 here.
+ */
+#define BLUR_LEVEL_VARIANCE (0.25f + 4.0f / 6.0f)
+
+typedef enum blur_kind {
+    BLUR_BACKDROP,
+    BLUR_GLOW
+} blur_kind;
+
+typedef struct rx_blur_entry {
+    blur_kind kind;
+    int x, y, width, height;    /* Backdrop region, or glow shape size */
+    int corner;                 /* Glow corner radius, quarter pixels */
+    int radius;                 /* Quarter pixels */
+    uint64_t content;           /* Hash of the pixels read (backdrop) */
+    uint8_t* pixels;
+    size_t size;
+    int mask_width, mask_height, pad;
+    uint64_t last_used;
+} rx_blur_entry;
+
+typedef struct blur_plan {
+    int levels;
+    float sigma;                /* Left for the kernel, in pixels of the last level */
+    int w[BLUR_MAX_LEVELS + 1];
+    int h[BLUR_MAX_LEVELS + 1];
+    size_t work;                /* Bytes of working memory */
+} blur_plan;
+
+static bool grow_array(void** array, size_t* capacity, size_t need, size_t elem) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    void* grown = realloc(*array, cap * elem);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = cap;
+    return true;
+}
+
+static inline int clampi(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/* ============================================================================
+ * Passes
+ * ============================================================================ */
+
+/*
+ * The passes take the channel count as a constant so each is compiled
+ * for RGBA and A8 with the channel loop unrolled.
+ */
+
+/* 2x2 box; an odd last row or column is repeated */
+static inline void downsample_c(uint8_t* dst, int dw, int dh, const uint8_t* src, size_t src_stride,
+                                int sw, int sh, const int c) {
+    size_t dst_stride = (size_t)dw * c;
+    int pairs = sw / 2;
+    for (int y = 0; y < dh; y++) {
+        const uint8_t* r0 = src + (size_t)(2 * y) * src_stride;
+        const uint8_t* r1 = 2 * y + 1 < sh ? r0 + src_stride : r0;
+        uint8_t* out = dst + (size_t)y * dst_stride;
+        for (int x = 0; x < pairs; x++) {
+            const uint8_t* a = r0 + 2 * x * c;
+            const uint8_t* b = r1 + 2 * x * c;
+            for (int ch = 0; ch < c; ch++) {
+                out[x * c + ch] = (uint8_t)((a[ch] + a[c + ch] + b[ch] + b[c + ch] + 2) >> 2);
+            }
+        }
+        if (pairs < dw) {
+            const uint8_t* a = r0 + 2 * pairs * c;
+            const uint8_t* b = r1 + 2 * pairs * c;
+            for (int ch = 0; ch < c; ch++) out[pairs * c + ch] = (uint8_t)((a[ch] + b[ch] + 1) >> 1);
+        }
+    }
+}
+
+/* One output pixel: 9:3:3:1 of the nearest input and its neighbours */
+static inline void upsample_pixel(uint8_t* out, const uint8_t* r0, const uint8_t* r1,
+                                  int sx, int nx, const int c) {
+    for (int ch = 0; ch < c; ch++) {
+        uint32_t v = 9u * r0[sx * c + ch] + 3u * r0[nx * c + ch] + 3u * r1[sx * c + ch] + r1[nx * c + ch];
+        out[ch] = (uint8_t)((v + 8) >> 4);
+    }
+}
+
+/* Bilinear 2x; output pixel x sits at x / 2 - 1/4 in the input */
+static inline void upsample_c(uint8_t* dst, size_t dst_stride, int dw, int dh,
+                              const uint8_t* src, int sw, int sh, const int c) {
+    size_t src_stride = (size_t)sw * c;
+    for (int y = 0; y < dh; y++) {
+        int sy = y >> 1;
+        int ny = clampi((y & 1) ? sy + 1 : sy - 1, 0, sh - 1);
+        const uint8_t* r0 = src + (size_t)sy * src_stride;
+        const uint8_t* r1 = src + (size_t)ny * src_stride;
+        uint8_t* out = dst + (size_t)y * dst_stride;
+
+        /* Edges clamp; between them every input pixel gives two outputs */
+        upsample_pixel(out, r0, r1, 0, 0, c);
+        int x = 1;
+        for (int i = 0; i + 1 < sw && x + 1 < dw; i++, x += 2) {
+            for (int ch = 0; ch < c; ch++) {
+                uint32_t a0 = r0[i * c + ch], a1 = r0[(i + 1) * c + ch];
+                uint32_t b0 = r1[i * c + ch], b1 = r1[(i + 1) * c + ch];
+                uint32_t near0 = 3 * a0 + b0, near1 = 3 * a1 + b1;
+                out[x * c + ch] = (uint8_t)((3 * near0 + near1 + 8) >> 4);
+                out[(x + 1) * c + ch] = (uint8_t)((near0 + 3 * near1 + 8) >> 4);
+            }
+        }
+        for (; x < dw; x++) {
+            int sx = x >> 1;
+            upsample_pixel(out + x * c, r0, r1, sx, clampi((x & 1) ? sx + 1 : sx - 1, 0, sw - 1), c);
+        }
+    }
+}
+
+static void downsample(uint8_t* dst, int dw, int dh, const uint8_t* src, size_t src_stride,
+                       int sw, int sh, int c) {
+    if (c == 4) downsample_c(dst, dw, dh, src, src_stride, sw, sh, 4);
+    else downsample_c(dst, dw, dh, src, src_stride, sw, sh, 1);
+}
+
+static void upsample(uint8_t* dst, size_t dst_stride, int dw, int dh,
+                     const uint8_t* src, int sw, int sh, int c) {
+    if (c == 4) upsample_c(dst, dst_stride, dw, dh, src, sw, sh, 4);
+    else upsample_c(dst, dst_stride, dw, dh, src, sw, sh, 1);
+}
+
+/* Gaussian weights summing to 256; returns the half width */
+static int kernel_weights(uint32_t* wt, float sigma) {
+    int r = (int)ceilf(sigma * 2.5f);
+    if (r > BLUR_MAX_HALF_TAPS) r = BLUR_MAX_HALF_TAPS;
+    if (r < 1) r = 1;
+    float f[2 * BLUR_MAX_HALF_TAPS + 1], total = 0;
+    for (int k = -r; k <= r; k++) {
+        f[k + r] = expf(-(float)(k * k) / (2.0f * sigma * sigma));
+        total += f[k + r];
+    }
+    uint32_t sum = 0;
+    for (int k = 0; k <= 2 * r; k++) {
+        wt[k] = (uint32_t)(f[k] * 256.0f / total + 0.5f);
+        sum += wt[k];
+    }
+    wt[r] += 256 - sum;
+    return r;
+}
+
+/* One direction of the kernel: `lines` lines of `len` pixels each */
+static void kernel_pass(uint8_t* dst, size_t d_line, size_t d_step,
+                        const uint8_t* src, size_t s_line, size_t s_step,
+                        int lines, int len, int c, const uint32_t* wt, int r) {
+    for (int line = 0; line < lines; line++) {
+        const uint8_t* in = src + (size_t)line * s_line;
+        uint8_t* out = dst + (size_t)line * d_line;
+        for (int i = 0; i < len; i++) {
+            for (int ch = 0; ch < c; ch++) {
+                uint32_t sum = 128;
+                for (int k = -r; k <= r; k++) {
+                    sum += wt[k + r] * in[(size_t)clampi(i + k, 0, len - 1) * s_step + ch];
+                }
+                out[(size_t)i * d_step + ch] = (uint8_t)(sum >> 8);
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * Chain
+ * ============================================================================ */
+
+/* Levels to go down so the kernel at the bottom stays small */
+static void plan_make(blur_plan* p, int w, int h, int c, float radius) {
+    float sigma = radius * 0.5f;
+    float var = sigma * sigma, used = 0, scale = 1;
+    p->levels = 0;
+    p->w[0] = w;
+    p->h[0] = h;
+    p->work = 0;
+    while (p->levels < BLUR_MAX_LEVELS) {
+        int l = p->levels;
+        float left = sqrtf(fmaxf(var - used, 0)) / (float)(1 << l);
+        if (left <= BLUR_KERNEL_SIGMA || p->w[l] < BLUR_MIN_LEVEL_SIZE || p->h[l] < BLUR_MIN_LEVEL_SIZE) break;
+        used += BLUR_LEVEL_VARIANCE * scale;
+        scale *= 4;
+        p->w[l + 1] = (p->w[l] + 1) / 2;
+        p->h[l + 1] = (p->h[l] + 1) / 2;
+        p->work += (size_t)p->w[l + 1] * p->h[l + 1] * c;
+        p->levels++;
+    }
+    p->sigma = sqrtf(fmaxf(var - used, 0)) / (float)(1 << p->levels);
+    /* Kernel temporary at the bottom level */
+    p->work += (size_t)p->w[p->levels] * p->h[p->levels] * c;
+}
+
+static void chain_run(const blur_plan* p, uint8_t* dst, size_t dst_stride,
+                      const uint8_t* src, size_t src_stride, int c, uint8_t* work) {
+    int L = p->levels;
+    uint8_t* level[BLUR_MAX_LEVELS + 1];
+    size_t stride[BLUR_MAX_LEVELS + 1];
+    level[0] = (uint8_t*)src;
+    stride[0] = src_stride;
+    uint8_t* next = work;
+    for (int l = 1; l <= L; l++) {
+        level[l] = next;
+        stride[l] = (size_t)p->w[l] * c;
+        next += stride[l] * p->h[l];
+        downsample(level[l], p->w[l], p->h[l], level[l - 1], stride[l - 1], p->w[l - 1], p->h[l - 1], c);
+    }
+    uint8_t* tmp = next;
+
+    /* The bottom level ends in dst when there is no chain */
+    uint8_t* bottom = L ? level[L] : dst;
+    size_t bottom_stride = L ? stride[L] : dst_stride;
+    int bw = p->w[L], bh = p->h[L];
+    size_t tmp_stride = (size_t)bw * c;
+    if (p->sigma >= BLUR_MIN_SIGMA) {
+        uint32_t wt[2 * BLUR_MAX_HALF_TAPS + 1];
+        int r = kernel_weights(wt, p->sigma);
+        kernel_pass(tmp, tmp_stride, c, level[L], stride[L], c, bh, bw, c, wt, r);
+        kernel_pass(bottom, c, bottom_stride, tmp, c, tmp_stride, bw, bh, c, wt, r);
+    } else if (!L && dst != src) {
+        for (int y = 0; y < bh; y++) {
+            memcpy(dst + (size_t)y * dst_stride, src + (size_t)y * src_stride, (size_t)bw * c);
+        }
+    }
+
+    for (int l = L; l >= 1; l--) {
+        uint8_t* out = l == 1 ? dst : level[l - 1];
+        size_t out_stride = l == 1 ? dst_stride : stride[l - 1];
+        upsample(out, out_stride, p->w[l - 1], p->h[l - 1], level[l], p->w[l], p->h[l], c);
+    }
+}
+
+int rx_blur_extent(float radius) {
+    return radius > 0 ? (int)ceilf(radius * 1.5f) : 0;
+}
+
+bool rx_blur(uint8_t* dst, int dst_stride, const uint8_t* src, int src_stride,
+             int width, int height, int channels, float radius) {
+    if (!dst || !src || width <= 0 || height <= 0) return false;
+    if (channels != 1 && channels != 4) return false;
+    blur_plan plan;
+    plan_make(&plan, width, height, channels, radius);
+    uint8_t* work = (uint8_t*)malloc(plan.work);
+    if (!work) return false;
+    chain_run(&plan, dst, (size_t)dst_stride, src, (size_t)src_stride, channels, work);
+    free(work);
+    return true;
+}
+
+/* ============================================================================
+ * Blur Cache
+ * ============================================================================ */
+
+rx_blur_cache* rx_blur_cache_create(size_t budget_bytes) {
+    rx_blur_cache* cache = (rx_blur_cache*)calloc(1, sizeof(rx_blur_cache));
+    if (cache) cache->budget = budget_bytes;
+    return cache;
+}
+
+void rx_blur_cache_destroy(rx_blur_cache* cache) {
+    if (!cache) return;
+    for (size_t i = 0; i < cache->count; i++) free(cache->entries[i].pixels);
+    free(cache->entries);
+    free(cache->scratch);
+    free(cache);
+}
+
+static uint8_t* scratch_get(rx_blur_cache* cache, size_t size) {
+    if (size <= cache->scratch_size) return cache->scratch;
+    uint8_t* grown = (uint8_t*)realloc(cache->scratch, size);
+    if (!grown) return NULL;
+    cache->scratch = grown;
+    cache->scratch_size = size;
+    return grown;
+}
+
+/* Entry matching the key, or a new empty one; NULL out of memory */
+static rx_blur_entry* entry_find(rx_blur_cache* cache, blur_kind kind, int x, int y,
+                                 int w, int h, int corner, int radius) {
+    for (size_t i = 0; i < cache->count; i++) {
+        rx_blur_entry* e = &cache->entries[i];
+        if (e->kind == kind && e->x == x && e->y == y && e->width == w && e->height == h &&
+            e->corner == corner && e->radius == radius) {
+            e->last_used = cache->frame;
+            return e;
+        }
+    }
+    if (!grow_array((void**)&cache->entries, &cache->capacity, cache->count + 1, sizeof(rx_blur_entry))) {
+        return NULL;
+    }
+    rx_blur_entry* e = &cache->entries[cache->count++];
+    memset(e, 0, sizeof(*e));
+    e->kind = kind;
+    e->x = x;
+    e->y = y;
+    e->width = w;
+    e->height = h;
+    e->corner = corner;
+    e->radius = radius;
+    e->last_used = cache->frame;
+    return e;
+}
+
+static bool entry_reserve(rx_blur_cache* cache, rx_blur_entry* e, size_t size) {
+    if (e->pixels && e->size == size) return true;
+    uint8_t* pixels = (uint8_t*)realloc(e->pixels, size);
+    if (!pixels) return false;
+    cache->bytes += size - e->size;
+    e->pixels = pixels;
+    e->size = size;
+    return true;
+}
+
+static void entry_remove(rx_blur_cache* cache, size_t i) {
+    cache->bytes -= cache->entries[i].size;
+    free(cache->entries[i].pixels);
+    cache->entries[i] = cache->entries[--cache->count];
+    cache->evictions++;
+}
+
+static inline uint64_t rotl64(uint64_t v, int s) {
+    return (v << s) | (v >> (64 - s));
+}
+
+/*
+ * Two lanes of xor-rotate-multiply over 8-byte words. Every step is a
+ * bijection of the lane, so any single changed word changes the result.
+ */
+static uint64_t hash_rows(const uint8_t* p, size_t stride, size_t row_bytes, int rows) {
+    const uint64_t m = 0x9E3779B97F4A7C15ull;
+    uint64_t h0 = 0x243F6A8885A308D3ull, h1 = 0x13198A2E03707344ull;
+    for (int y = 0; y < rows; y++) {
+        const uint8_t* q = p + (size_t)y * stride;
+        size_t i = 0;
+        for (; i + 16 <= row_bytes; i += 16) {
+            uint64_t a, b;
+            memcpy(&a, q + i, 8);
+            memcpy(&b, q + i + 8, 8);
+            h0 = rotl64(h0 ^ a, 29) * m;
+            h1 = rotl64(h1 ^ b, 31) * m;
+        }
+        for (; i < row_bytes; i++) h0 = rotl64(h0 ^ q[i], 29) * m;
+    }
+    uint64_t h = h0 ^ rotl64(h1, 17) ^ (row_bytes * (uint64_t)rows);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+const uint8_t* rx_blur_cache_backdrop(rx_blur_cache* cache, const uint8_t* surface,
+                                      int surface_width, int surface_height, int stride,
+                                      int x, int y, int width, int height, float radius) {
+    if (!cache || !surface) return NULL;
+    if (width <= 0 || height <= 0 || x < 0 || y < 0) return NULL;
+    if (x + width > surface_width || y + height > surface_height) return NULL;
+    int x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+    int w = width, h = height;
+
+    /* Everything that can blur into the region */
+    int ext = rx_blur_extent(radius);
+    int px0 = clampi(x0 - ext, 0, surface_width), py0 = clampi(y0 - ext, 0, surface_height);
+    int px1 = clampi(x1 + ext, 0, surface_width), py1 = clampi(y1 + ext, 0, surface_height);
+    int pw = px1 - px0, ph = py1 - py0;
+    const uint8_t* read = surface + (size_t)py0 * stride + (size_t)px0 * 4;
+    uint64_t content = hash_rows(read, (size_t)stride, (size_t)pw * 4, ph);
+
+    int radius_q = (int)lroundf(radius * 4.0f);
+    rx_blur_entry* e = entry_find(cache, BLUR_BACKDROP, x0, y0, w, h, 0, radius_q);
+    if (!e) return NULL;
+    if (e->pixels && e->content == content) {
+        cache->hits++;
+        return e->pixels;
+    }
+    cache->misses++;
+
+    blur_plan plan;
+    plan_make(&plan, pw, ph, 4, radius);
+    size_t padded = (size_t)pw * ph * 4;
+    uint8_t* scratch = scratch_get(cache, padded + plan.work);
+    if (!scratch || !entry_reserve(cache, e, (size_t)w * h * 4)) {
+        e->content = 0;
+        return NULL;
+    }
+    chain_run(&plan, scratch, (size_t)pw * 4, read, (size_t)stride, 4, scratch + padded);
+    for (int row = 0; row < h; row++) {
+        memcpy(e->pixels + (size_t)row * w * 4,
+               scratch + ((size_t)(row + y0 - py0) * pw + (size_t)(x0 - px0)) * 4, (size_t)w * 4);
+    }
+    e->content = content;
+    return e->pixels;
+}
+
+/* Coverage of a w x h rect with corners of radius r, at (pad, pad) */
+static void glow_shape(uint8_t* mask, int mw, int mh, int pad, int w, int h, float r) {
+    memset(mask, 0, (size_t)mw * mh);
+    float half = (float)(w < h ? w : h) * 0.5f;
+    if (r > half) r = half;
+    if (r < 0) r = 0;
+    for (int row = 0; row < h; row++) {
+        float inset = 0;
+        float yc = (float)row + 0.5f, dy = 0;
+        if (yc < r) dy = r - yc;
+        else if (yc > (float)h - r) dy = yc - ((float)h - r);
+        if (dy > 0) {
+            float d2 = r * r - dy * dy;
+            inset = r - (d2 > 0 ? sqrtf(d2) : 0);
+        }
+        float left = inset, right = (float)w - inset;
+        uint8_t* out = mask + (size_t)(row + pad) * mw + pad;
+        for (int col = (int)floorf(left); col < (int)ceilf(right); col++) {
+            float cover = fminf(right, (float)col + 1) - fmaxf(left, (float)col);
+            if (cover > 0) out[col] = (uint8_t)(cover * 255.0f + 0.5f);
+        }
+    }
+}
+
+const uint8_t* rx_blur_cache_glow(rx_blur_cache* cache, float width, float height,
+                                  float corner_radius, float radius,
+                                  int* mask_width, int* mask_height, int* pad) {
+    if (!cache) return NULL;
+    int w = (int)lroundf(width), h = (int)lroundf(height);
+    if (w <= 0 || h <= 0) return NULL;
+    int corner_q = (int)lroundf(corner_radius * 4.0f);
+    int radius_q = (int)lroundf(radius * 4.0f);
+
+    rx_blur_entry* e = entry_find(cache, BLUR_GLOW, 0, 0, w, h, corner_q, radius_q);
+    if (!e) return NULL;
+    if (e->pixels) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+        int ext = rx_blur_extent(radius);
+        int mw = w + 2 * ext, mh = h + 2 * ext;
+        blur_plan plan;
+        plan_make(&plan, mw, mh, 1, radius);
+        uint8_t* scratch = scratch_get(cache, plan.work);
+        if (!scratch || !entry_reserve(cache, e, (size_t)mw * mh)) return NULL;
+        glow_shape(e->pixels, mw, mh, ext, w, h, corner_radius);
+        chain_run(&plan, e->pixels, (size_t)mw, e->pixels, (size_t)mw, 1, scratch);
+        e->mask_width = mw;
+        e->mask_height = mh;
+        e->pad = ext;
+    }
+    if (mask_width) *mask_width = e->mask_width;
+    if (mask_height) *mask_height = e->mask_height;
+    if (pad) *pad = e->pad;
+    return e->pixels;
+}
+
+void rx_blur_cache_end_frame(rx_blur_cache* cache) {
+    if (!cache) return;
+    for (size_t i = 0; i < cache->count;) {
+        if (cache->frame - cache->entries[i].last_used > BLUR_IDLE_FRAMES) entry_remove(cache, i);
+        else i++;
+    }
+    while (cache->bytes > cache->budget && cache->count) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < cache->count; i++) {
+            if (cache->entries[i].last_used < cache->entries[oldest].last_used) oldest = i;
+        }
+        entry_remove(cache, oldest);
+    }
+    cache->frame++;
+}
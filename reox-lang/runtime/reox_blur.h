@@ -0,0 +1,103 @@
+/*
+ * REOX Blur
+ * Mip-chain blur for backdrops and glows, with a cache of results
+ *
+ * Features:
+ * - Gaussian-looking blur of any radius for the cost of a small one:
+ *   halve the image until the remaining blur is a few pixels, run a
+ *   small separable Gaussian there, and scale back up bilinearly
+ * - RGBA8 (premultiplied) or A8 pixels
+ * - Backdrop cache keyed by region and radius; a blurred backdrop is
+ *   reused while the pixels underneath hash the same
+ * - Glow masks (blurred rounded rects) keyed by size, corner and radius,
+ *   shared by every view with the same shape
+ * - Byte budget with least-recently-used eviction at end of frame
+ *
+ * Each pass reads a fixed, small neighbourhood, so the same chain maps
+ * directly onto render-target passes in a GPU backend; the CPU version
+ * here is what the headless backend draws with.
+ *
+ * Radius is the visible extent of the blur, about two standard
+ * deviations (as in CSS blur()).
+ */
+
+#ifndef REOX_BLUR_H
+#define REOX_BLUR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Blur
+ * ============================================================================ */
+
+/* How far a blur of `radius` spreads beyond the source, in pixels */
+extern int rx_blur_extent(float radius);
+
+/*
+ * Blur width x height pixels of `channels` bytes (1 or 4) from src into
+ * dst; the two may be the same buffer. Edges clamp. False on bad
+ * arguments or out of memory, dst untouched.
+ */
+extern bool rx_blur(uint8_t* dst, int dst_stride, const uint8_t* src, int src_stride,
+                    int width, int height, int channels, float radius);
+
+/* ============================================================================
+ * Blur Cache
+ * ============================================================================ */
+
+typedef struct rx_blur_cache {
+    struct rx_blur_entry* entries;
+    size_t count;
+    size_t capacity;
+    size_t bytes;             /* Pixels held by entries */
+    size_t budget;            /* Evict down to this at end of frame */
+    uint64_t frame;
+
+    /* Working memory for the mip chain, reused across blurs */
+    uint8_t* scratch;
+    size_t scratch_size;
+
+    /* Stats */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} rx_blur_cache;
+
+extern rx_blur_cache* rx_blur_cache_create(size_t budget_bytes);
+extern void rx_blur_cache_destroy(rx_blur_cache* cache);
+
+/*
+ * Blurred copy of the region (x, y, width, height) of an RGBA8 surface,
+ * width * 4 bytes per row; the region must lie inside the surface.
+ * Pixels up to rx_blur_extent(radius) outside the region (and inside the
+ * surface) blur into it. The result is reused while the region, radius
+ * and the pixels read are unchanged, and stays valid until
+ * rx_blur_cache_end_frame. NULL if the region is empty or outside.
+ */
+extern const uint8_t* rx_blur_cache_backdrop(rx_blur_cache* cache, const uint8_t* surface,
+                                             int surface_width, int surface_height, int stride,
+                                             int x, int y, int width, int height, float radius);
+
+/*
+ * A8 mask of a width x height rounded rect blurred by `radius`, padded by
+ * *pad pixels on every side (mask size *mask_width x *mask_height, one
+ * byte per pixel). Valid until rx_blur_cache_end_frame.
+ */
+extern const uint8_t* rx_blur_cache_glow(rx_blur_cache* cache, float width, float height,
+                                         float corner_radius, float radius,
+                                         int* mask_width, int* mask_height, int* pad);
+
+/* Advance the frame; evict what is over budget, least recently used first */
+extern void rx_blur_cache_end_frame(rx_blur_cache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_BLUR_H */
@@ -17,6 +17,57 @@
 #define MIN3(a, b, c) ((a) < (b) ? ((a) < (c) ? (a) : (c)) : ((b) < (c) ? (b) : (c)))
 #define MAX3(a, b, c) ((a) > (b) ? ((a) > (c) ? (a) : (c)) : ((b) > (c) ? (b) : (c)))
 
+/* ============================================================================
+ * sRGB Transfer Tables
+ * ============================================================================ */
+
+/* 8-bit sRGB to linear light, 0-1 */
+static const float srgb_to_linear_table[256] = {
+    0.0f, 0.000303526984f, 0.000607053967f, 0.000910580951f, 0.00121410793f, 0.00151763492f,
+    0.0018211619f, 0.00212468888f, 0.00242821587f, 0.00273174285f, 0.00303526984f, 0.00334653576f,
+    0.00367650732f, 0.00402471702f, 0.00439144204f, 0.00477695348f, 0.0051815167f, 0.00560539162f,
+    0.00604883302f, 0.00651209079f, 0.00699541019f, 0.00749903204f, 0.00802319299f, 0.00856812562f,
+    0.0091340587f, 0.00972121732f, 0.010329823f, 0.010960094f, 0.0116122452f, 0.0122864884f,
+    0.0129830323f, 0.013702083f, 0.0144438436f, 0.0152085144f, 0.0159962934f, 0.0168073758f,
+    0.0176419545f, 0.0185002201f, 0.019382361f, 0.0202885631f, 0.0212190104f, 0.0221738848f,
+    0.0231533662f, 0.0241576324f, 0.0251868596f, 0.0262412219f, 0.0273208916f, 0.0284260395f,
+    0.0295568344f, 0.0307134437f, 0.0318960331f, 0.0331047666f, 0.0343398068f, 0.0356013149f,
+    0.0368894504f, 0.0382043716f, 0.0395462353f, 0.0409151969f, 0.0423114106f, 0.0437350293f,
+    0.0451862044f, 0.0466650863f, 0.0481718242f, 0.049706566f, 0.0512694584f, 0.052860647f,
+    0.0544802764f, 0.05612849f, 0.0578054302f, 0.0595112382f, 0.0612460542f, 0.0630100177f,
+    0.0648032667f, 0.0666259386f, 0.0684781698f, 0.0703600957f, 0.0722718507f, 0.0742135684f,
+    0.0761853815f, 0.0781874218f, 0.0802198203f, 0.0822827071f, 0.0843762115f, 0.086500462f,
+    0.0886555863f, 0.0908417112f, 0.0930589628f, 0.0953074666f, 0.0975873471f, 0.0998987282f,
+    0.102241733f, 0.104616484f, 0.107023103f, 0.109461711f, 0.111932428f, 0.114435374f,
+    0.116970668f, 0.119538428f, 0.122138772f, 0.124771818f, 0.12743768f, 0.130136477f,
+    0.132868322f, 0.13563333f, 0.138431615f, 0.141263291f, 0.144128471f, 0.147027266f,
+    0.14995979f, 0.152926152f, 0.155926464f, 0.158960835f, 0.162029376f, 0.165132195f,
+    0.1682694f, 0.171441101f, 0.174647404f, 0.177888416f, 0.181164244f, 0.184474995f,
+    0.187820772f, 0.191201683f, 0.19461783f, 0.19806932f, 0.201556254f, 0.205078736f,
+    0.20863687f, 0.212230757f, 0.2158605f, 0.2195262f, 0.223227957f, 0.226965874f,
+    0.230740049f, 0.234550582f, 0.238397574f, 0.242281122f, 0.246201327f, 0.250158285f,
+    0.254152094f, 0.258182853f, 0.262250658f, 0.266355605f, 0.270497791f, 0.274677312f,
+    0.278894263f, 0.28314874f, 0.287440838f, 0.29177065f, 0.296138271f, 0.300543794f,
+    0.304987314f, 0.309468923f, 0.313988713f, 0.318546778f, 0.323143209f, 0.327778098f,
+    0.332451536f, 0.337163615f, 0.341914425f, 0.346704056f, 0.3515326f, 0.356400144f,
+    0.36130678f, 0.366252596f, 0.37123768f, 0.376262123f, 0.381326011f, 0.386429434f,
+    0.391572478f, 0.396755231f, 0.40197778f, 0.407240212f, 0.412542613f, 0.417885071f,
+    0.42326767f, 0.428690497f, 0.434153636f, 0.439657174f, 0.445201195f, 0.450785783f,
+    0.456411023f, 0.462077f, 0.467783796f, 0.473531496f, 0.479320183f, 0.48514994f,
+    0.49102085f, 0.496932995f, 0.502886458f, 0.508881321f, 0.514917665f, 0.520995573f,
+    0.527115126f, 0.533276404f, 0.539479489f, 0.545724461f, 0.552011402f, 0.55834039f,
+    0.564711506f, 0.571124829f, 0.57758044f, 0.584078418f, 0.590618841f, 0.597201788f,
+    0.603827339f, 0.610495571f, 0.617206562f, 0.623960392f, 0.630757136f, 0.637596874f,
+    0.644479682f, 0.651405637f, 0.658374817f, 0.665387298f, 0.672443157f, 0.67954247f,
+    0.686685312f, 0.693871761f, 0.701101892f, 0.70837578f, 0.715693501f, 0.723055129f,
+    0.73046074f, 0.737910409f, 0.74540421f, 0.752942217f, 0.760524505f, 0.768151147f,
+    0.775822218f, 0.783537792f, 0.79129794f, 0.799102738f, 0.806952258f, 0.814846572f,
+    0.822785754f, 0.830769877f, 0.838799012f, 0.846873232f, 0.854992608f, 0.863157213f,
+    0.871367119f, 0.879622397f, 0.887923118f, 0.896269353f, 0.904661174f, 0.913098652f,
+    0.921581856f, 0.930110858f, 0.938685728f, 0.947306537f, 0.955973353f, 0.964686248f,
+    0.97344529f, 0.98225055f, 0.991102097f, 1.0f,
+};
+
 /* ============================================================================
  * Color Space Conversions
  * ============================================================================ */
@@ -134,15 +185,9 @@ rx_color rx_hsv_to_rgb(rx_hsv hsv) {
 
 rx_xyz rx_rgb_to_xyz(rx_color rgb) {
     /* sRGB to linear */
-    float r = rgb.r / 255.0f;
-    float g = rgb.g / 255.0f;
-    float b = rgb.b / 255.0f;
-    
-    r = r > 0.04045f ? powf((r + 0.055f) / 1.055f, 2.4f) : r / 12.92f;
-    g = g > 0.04045f ? powf((g + 0.055f) / 1.055f, 2.4f) : g / 12.92f;
-    b = b > 0.04045f ? powf((b + 0.055f) / 1.055f, 2.4f) : b / 12.92f;
-    
-    r *= 100; g *= 100; b *= 100;
+    float r = srgb_to_linear_table[rgb.r] * 100;
+    float g = srgb_to_linear_table[rgb.g] * 100;
+    float b = srgb_to_linear_table[rgb.b] * 100;
     
     return (rx_xyz){
         r * 0.4124564f + g * 0.3575761f + b * 0.1804375f,
@@ -247,32 +292,222 @@ rx_color rx_lch_to_rgb(rx_lch lch) {
 }
 
 /* ============================================================================
- * Color Manipulation
+ * Bulk Conversions
  * ============================================================================ */
 
-rx_color color_lighten(rx_color c, float amount) {
-    rx_hsl hsl = rx_rgb_to_hsl(c);
-    hsl.l = CLAMP(hsl.l + amount, 0, 1);
-    return rx_hsl_to_rgb(hsl);
+#define BULK_TILE 256
+
+/* a if cond else b. With both sides computed, gcc would sink them into
+ * branches it then cannot vectorize (they may trap); a bit select has no
+ * branch. */
+static inline float select_f(int cond, float a, float b) {
+    union { float f; uint32_t u; } x = { a }, y = { b };
+    uint32_t m = 0u - (uint32_t)cond;
+    x.u = (x.u & m) | (y.u & ~m);
+    return x.f;
 }
 
-rx_color color_darken(rx_color c, float amount) {
-    rx_hsl hsl = rx_rgb_to_hsl(c);
-    hsl.l = CLAMP(hsl.l - amount, 0, 1);
-    return rx_hsl_to_rgb(hsl);
+/* Exponent-divide seed, then Newton steps; two give ~1e-6 */
+static inline float cbrt_approx(float t) {
+    union { float f; uint32_t u; } v = { t };
+    v.u = v.u / 3 + 709921077u;
+    float y = v.f;
+    y = (2.0f * y + t / (y * y)) * (1.0f / 3.0f);
+    y = (2.0f * y + t / (y * y)) * (1.0f / 3.0f);
+    return y;
 }
 
-rx_color color_blend(rx_color a, rx_color b, float t) {
-    return (rx_color){
-        (uint8_t)(a.r + (b.r - a.r) * t),
-        (uint8_t)(a.g + (b.g - a.g) * t),
-        (uint8_t)(a.b + (b.b - a.b) * t),
-        (uint8_t)(a.a + (b.a - a.a) * t)
-    };
+static inline float lab_f(float t) {
+    return select_f(t > 0.008856f, cbrt_approx(t), 7.787f * t + 16.0f / 116);
+}
+
+static inline float lab_f_inv(float f) {
+    float f3 = f * f * f;
+    return select_f(f3 > 0.008856f, f3, (f - 16.0f / 116) * (1.0f / 7.787f));
+}
+
+/* atan2 in degrees, 0-360; minimax polynomial, error under 0.001 degrees */
+static inline float hue_degrees(float y, float x) {
+    float ax = fabsf(x), ay = fabsf(y);
+    float mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+    float t = mx > 0 ? mn / mx : 0;
+    float s = t * t;
+    float r = ((((-0.0134804f * s + 0.0574773f) * s - 0.1212390f) * s + 0.1956359f) * s
+               - 0.3329946f) * s * t + 0.9999956f * t;
+    r *= (float)(180 / M_PI);
+    r = ay > ax ? 90 - r : r;
+    r = x < 0 ? 180 - r : r;
+    r = y < 0 ? 360 - r : r;
+    return r >= 360 ? r - 360 : r;
+}
+
+static inline int unit_to_int255(float v) {
+    v = v * 255 + 0.5f;
+    v = v > 0 ? v : 0;
+    v = v < 255 ? v : 255;
+    return (int)v;
+}
+
+static inline uint8_t unit_to_byte(float v) {
+    return (uint8_t)unit_to_int255(v);
+}
+
+/* Channel from linear light, rounded. x^(1/2.4) = c * c^(1/4) with
+ * c = cbrt(x); the fourth root is three Newton steps from a seed, so the
+ * whole thing vectorizes (sqrtf would not, for errno). */
+static inline int linear_encode(float v) {
+    v = select_f(v > 0, v, 0);    /* Out of gamut would give NaN below */
+    v = select_f(v < 1, v, 1);
+    float c = cbrt_approx(v);
+    union { float f; uint32_t u; } q = { c };
+    q.u = q.u / 4 + 798014912u;
+    float z = q.f;
+    z = (3.0f * z + c / (z * z * z)) * 0.25f;
+    z = (3.0f * z + c / (z * z * z)) * 0.25f;
+    z = (3.0f * z + c / (z * z * z)) * 0.25f;
+    float e = select_f(v > 0.0031308f, 1.055f * c * z - 0.055f, 12.92f * v);
+    return unit_to_int255(e);
+}
+
+float rx_srgb_to_linear(uint8_t v) {
+    return srgb_to_linear_table[v];
+}
+
+uint8_t rx_linear_to_srgb(float v) {
+    return (uint8_t)linear_encode(v);
+}
+
+void rx_rgba8_to_lab(const rx_color* src, size_t count, float* l, float* a, float* b, float* alpha) {
+    float lr[BULK_TILE], lg[BULK_TILE], lb[BULK_TILE];
+    for (size_t base = 0; base < count; base += BULK_TILE) {
+        size_t n = count - base < BULK_TILE ? count - base : BULK_TILE;
+        const rx_color* px = src + base;
+        for (size_t i = 0; i < n; i++) {
+            lr[i] = srgb_to_linear_table[px[i].r];
+            lg[i] = srgb_to_linear_table[px[i].g];
+            lb[i] = srgb_to_linear_table[px[i].b];
+        }
+        if (alpha) {
+            for (size_t i = 0; i < n; i++) alpha[base + i] = px[i].a * (1.0f / 255);
+        }
+        float* ol = l + base;
+        float* oa = a + base;
+        float* ob = b + base;
+        for (size_t i = 0; i < n; i++) {
+            /* XYZ scaled by the D65 white */
+            float x = lr[i] * (0.4124564f / 0.95047f) + lg[i] * (0.3575761f / 0.95047f) + lb[i] * (0.1804375f / 0.95047f);
+            float y = lr[i] * 0.2126729f + lg[i] * 0.7151522f + lb[i] * 0.0721750f;
+            float z = lr[i] * (0.0193339f / 1.08883f) + lg[i] * (0.1191920f / 1.08883f) + lb[i] * (0.9503041f / 1.08883f);
+            float fx = lab_f(x), fy = lab_f(y), fz = lab_f(z);
+            ol[i] = 116 * fy - 16;
+            oa[i] = 500 * (fx - fy);
+            ob[i] = 200 * (fy - fz);
+        }
+    }
+}
+
+void rx_lab_to_rgba8(const float* l, const float* a, const float* b, const float* alpha,
+                     size_t count, rx_color* dst) {
+    float lr[BULK_TILE], lg[BULK_TILE], lb[BULK_TILE];
+    for (size_t base = 0; base < count; base += BULK_TILE) {
+        size_t n = count - base < BULK_TILE ? count - base : BULK_TILE;
+        const float* il = l + base;
+        const float* ia = a + base;
+        const float* ib = b + base;
+        for (size_t i = 0; i < n; i++) {
+            float fy = (il[i] + 16) * (1.0f / 116);
+            float x = lab_f_inv(ia[i] * (1.0f / 500) + fy) * 0.95047f;
+            float y = lab_f_inv(fy);
+            float z = lab_f_inv(fy - ib[i] * (1.0f / 200)) * 1.08883f;
+            lr[i] = x *  3.2404542f + y * -1.5371385f + z * -0.4985314f;
+            lg[i] = x * -0.9692660f + y *  1.8760108f + z *  0.0415560f;
+            lb[i] = x *  0.0556434f + y * -0.2040259f + z *  1.0572252f;
+        }
+        uint8_t* px = (uint8_t*)(dst + base);
+        for (size_t i = 0; i < n; i++) {
+            px[i * 4 + 0] = (uint8_t)linear_encode(lr[i]);
+            px[i * 4 + 1] = (uint8_t)linear_encode(lg[i]);
+            px[i * 4 + 2] = (uint8_t)linear_encode(lb[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            px[i * 4 + 3] = alpha ? (uint8_t)unit_to_int255(alpha[base + i]) : 255;
+        }
+    }
 }
 
-rx_color color_with_alpha(rx_color c, uint8_t alpha) {
-    return (rx_color){ c.r, c.g, c.b, alpha };
+void rx_rgba8_to_lch(const rx_color* src, size_t count, float* l, float* c, float* h, float* alpha) {
+    /* Lab into the output planes, then polar in place */
+    rx_rgba8_to_lab(src, count, l, c, h, alpha);
+    for (size_t i = 0; i < count; i++) {
+        float a = c[i], b = h[i];
+        c[i] = sqrtf(a * a + b * b);
+        h[i] = hue_degrees(b, a);
+    }
+}
+
+void rx_lch_to_rgba8(const float* l, const float* c, const float* h, const float* alpha,
+                     size_t count, rx_color* dst) {
+    float la[BULK_TILE], lb[BULK_TILE];
+    for (size_t base = 0; base < count; base += BULK_TILE) {
+        size_t n = count - base < BULK_TILE ? count - base : BULK_TILE;
+        for (size_t i = 0; i < n; i++) {
+            float rad = h[base + i] * (float)(M_PI / 180);
+            la[i] = c[base + i] * cosf(rad);
+            lb[i] = c[base + i] * sinf(rad);
+        }
+        rx_lab_to_rgba8(l + base, la, lb, alpha ? alpha + base : NULL, n, dst + base);
+    }
+}
+
+void rx_rgba8_to_hsv(const rx_color* src, size_t count, float* h, float* s, float* v, float* alpha) {
+    for (size_t i = 0; i < count; i++) {
+        float r = src[i].r * (1.0f / 255), g = src[i].g * (1.0f / 255), b = src[i].b * (1.0f / 255);
+        float max = MAX3(r, g, b), min = MIN3(r, g, b);
+        float d = max - min;
+        float inv = d > 0 ? 1.0f / d : 0;
+        float hue = max == r ? (g - b) * inv + (g < b ? 6 : 0)
+                  : max == g ? (b - r) * inv + 2
+                  : (r - g) * inv + 4;
+        h[i] = d > 0 ? hue * 60 : 0;
+        s[i] = max > 0 ? d / max : 0;
+        v[i] = max;
+    }
+    if (alpha) {
+        for (size_t i = 0; i < count; i++) alpha[i] = src[i].a * (1.0f / 255);
+    }
+}
+
+void rx_hsv_to_rgba8(const float* h, const float* s, const float* v, const float* alpha,
+                     size_t count, rx_color* dst) {
+    for (size_t i = 0; i < count; i++) {
+        /* channel(n) = v - v*s*clamp(min(k, 4 - k), 0, 1), k = (n + h/60) mod 6 */
+        float hh = h[i] * (1.0f / 60);
+        hh -= 6 * floorf(hh * (1.0f / 6));
+        float vs = v[i] * s[i];
+        float kr = 5 + hh, kg = 3 + hh, kb = 1 + hh;
+        kr = kr >= 6 ? kr - 6 : kr;
+        kg = kg >= 6 ? kg - 6 : kg;
+        kb = kb >= 6 ? kb - 6 : kb;
+        float wr = CLAMP(fminf(kr, 4 - kr), 0.0f, 1.0f);
+        float wg = CLAMP(fminf(kg, 4 - kg), 0.0f, 1.0f);
+        float wb = CLAMP(fminf(kb, 4 - kb), 0.0f, 1.0f);
+        dst[i].r = unit_to_byte(v[i] - vs * wr);
+        dst[i].g = unit_to_byte(v[i] - vs * wg);
+        dst[i].b = unit_to_byte(v[i] - vs * wb);
+        dst[i].a = alpha ? unit_to_byte(alpha[i]) : 255;
+    }
+}
+
+/* ============================================================================
+ * Color Manipulation
+ * ============================================================================ */
+
+/* color_lighten/color_darken/color_blend/color_with_alpha live in reox_ui.c;
+ * lightness here moves in HSL instead of toward white */
+static rx_color hsl_lighten(rx_color c, float amount) {
+    rx_hsl hsl = rx_rgb_to_hsl(c);
+    hsl.l = CLAMP(hsl.l + amount, 0, 1);
+    return rx_hsl_to_rgb(hsl);
 }
 
 rx_color rx_color_adjust_hue(rx_color c, float degrees) {
@@ -289,7 +524,7 @@ rx_color rx_color_adjust_saturation(rx_color c, float amount) {
 }
 
 rx_color rx_color_adjust_lightness(rx_color c, float amount) {
-    return color_lighten(c, amount);
+    return hsl_lighten(c, amount);
 }
 
 rx_color rx_color_adjust_brightness(rx_color c, float amount) {
@@ -511,6 +746,249 @@ rx_color rx_color_blend_alpha(rx_color base, rx_color blend, rx_blend_mode mode,
     return rx_color_mix(base, blended, alpha);
 }
 
+/* ============================================================================
+ * Buffer Blending
+ * ============================================================================ */
+
+/* Separable mix B(backdrop, source) over one channel plane, values 0-1 */
+typedef void (*blend_plane_fn)(float* restrict out, const float* restrict cb,
+                               const float* restrict cs, size_t n);
+
+static void plane_normal(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    (void)cb;
+    memcpy(out, cs, sizeof(float) * n);
+}
+
+static void plane_multiply(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = cb[i] * cs[i];
+}
+
+static void plane_screen(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = cb[i] + cs[i] - cb[i] * cs[i];
+}
+
+static void plane_hard_light(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float lo = 2 * cb[i] * cs[i];
+        float hi = 1 - 2 * (1 - cb[i]) * (1 - cs[i]);
+        out[i] = cs[i] <= 0.5f ? lo : hi;
+    }
+}
+
+static void plane_overlay(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    /* Hard light with the layers swapped */
+    plane_hard_light(out, cs, cb, n);
+}
+
+static void plane_darken(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = cb[i] < cs[i] ? cb[i] : cs[i];
+}
+
+static void plane_lighten(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = cb[i] > cs[i] ? cb[i] : cs[i];
+}
+
+static void plane_color_dodge(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float q = cs[i] < 1 ? cb[i] / (1 - cs[i]) : 1;
+        q = q < 1 ? q : 1;
+        out[i] = cb[i] > 0 ? q : 0;
+    }
+}
+
+static void plane_color_burn(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float q = cs[i] > 0 ? (1 - cb[i]) / cs[i] : 1;
+        q = 1 - (q < 1 ? q : 1);
+        out[i] = cb[i] < 1 ? q : 1;
+    }
+}
+
+static void plane_soft_light(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float b = cb[i], s = cs[i];
+        float d = b <= 0.25f ? ((16 * b - 12) * b + 4) * b : sqrtf(b);
+        out[i] = s <= 0.5f ? b - (1 - 2 * s) * b * (1 - b) : b + (2 * s - 1) * (d - b);
+    }
+}
+
+static void plane_difference(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = fabsf(cb[i] - cs[i]);
+}
+
+static void plane_exclusion(float* restrict out, const float* restrict cb, const float* restrict cs, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = cb[i] + cs[i] - 2 * cb[i] * cs[i];
+}
+
+static blend_plane_fn blend_plane_kernel(rx_blend_mode mode) {
+    switch (mode) {
+        case RX_BLEND_MULTIPLY:    return plane_multiply;
+        case RX_BLEND_SCREEN:      return plane_screen;
+        case RX_BLEND_OVERLAY:     return plane_overlay;
+        case RX_BLEND_DARKEN:      return plane_darken;
+        case RX_BLEND_LIGHTEN:     return plane_lighten;
+        case RX_BLEND_COLOR_DODGE: return plane_color_dodge;
+        case RX_BLEND_COLOR_BURN:  return plane_color_burn;
+        case RX_BLEND_HARD_LIGHT:  return plane_hard_light;
+        case RX_BLEND_SOFT_LIGHT:  return plane_soft_light;
+        case RX_BLEND_DIFFERENCE:  return plane_difference;
+        case RX_BLEND_EXCLUSION:   return plane_exclusion;
+        default:                   return plane_normal;
+    }
+}
+
+/* Non-separable modes (hue, saturation, color, luminosity) per pixel */
+static inline float blend_lum(const float c[3]) {
+    return 0.3f * c[0] + 0.59f * c[1] + 0.11f * c[2];
+}
+
+static void blend_set_lum(float c[3], float l) {
+    float d = l - blend_lum(c);
+    c[0] += d; c[1] += d; c[2] += d;
+    l = blend_lum(c);
+    float n = MIN3(c[0], c[1], c[2]), x = MAX3(c[0], c[1], c[2]);
+    for (int k = 0; k < 3; k++) {
+        if (n < 0) c[k] = l + (c[k] - l) * l / (l - n);
+        if (x > 1) c[k] = l + (c[k] - l) * (1 - l) / (x - l);
+    }
+}
+
+static void blend_set_sat(float c[3], float s) {
+    float n = MIN3(c[0], c[1], c[2]), x = MAX3(c[0], c[1], c[2]);
+    for (int k = 0; k < 3; k++) c[k] = x > n ? (c[k] - n) * s / (x - n) : 0;
+}
+
+static void blend_nonseparable(float out[3], const float b[3], const float s[3], rx_blend_mode mode) {
+    float sat_b = MAX3(b[0], b[1], b[2]) - MIN3(b[0], b[1], b[2]);
+    float sat_s = MAX3(s[0], s[1], s[2]) - MIN3(s[0], s[1], s[2]);
+    switch (mode) {
+        case RX_BLEND_HUE:
+            memcpy(out, s, sizeof(float) * 3);
+            blend_set_sat(out, sat_b);
+            blend_set_lum(out, blend_lum(b));
+            break;
+        case RX_BLEND_SATURATION:
+            memcpy(out, b, sizeof(float) * 3);
+            blend_set_sat(out, sat_s);
+            blend_set_lum(out, blend_lum(b));
+            break;
+        case RX_BLEND_COLOR:
+            memcpy(out, s, sizeof(float) * 3);
+            blend_set_lum(out, blend_lum(b));
+            break;
+        default: /* RX_BLEND_LUMINOSITY */
+            memcpy(out, b, sizeof(float) * 3);
+            blend_set_lum(out, blend_lum(s));
+            break;
+    }
+}
+
+static void blend_span(rx_color* dst, const rx_color* src, size_t count, rx_blend_mode mode,
+                       float opacity, bool premultiplied) {
+    if (!dst || !src || !(opacity > 0)) return;
+    if (opacity > 1) opacity = 1;
+
+    bool additive = mode == RX_BLEND_PLUS_LIGHTER || mode == RX_BLEND_PLUS_DARKER;
+    bool separable = mode < RX_BLEND_HUE || mode > RX_BLEND_LUMINOSITY;
+    blend_plane_fn plane = blend_plane_kernel(mode);
+
+    /* Straight colors and alphas, 0-1; planes[3] holds the mix */
+    float cb[3][BULK_TILE], cs[3][BULK_TILE], mix[3][BULK_TILE];
+    float ab[BULK_TILE], as[BULK_TILE];
+    float inv255 = 1.0f / 255;
+
+    for (size_t base = 0; base < count; base += BULK_TILE) {
+        size_t n = count - base < BULK_TILE ? count - base : BULK_TILE;
+        rx_color* d = dst + base;
+        const rx_color* s = src + base;
+
+        for (size_t i = 0; i < n; i++) {
+            ab[i] = d[i].a * inv255;
+            as[i] = s[i].a * inv255 * opacity;
+            cb[0][i] = d[i].r * inv255; cb[1][i] = d[i].g * inv255; cb[2][i] = d[i].b * inv255;
+            cs[0][i] = s[i].r * inv255; cs[1][i] = s[i].g * inv255; cs[2][i] = s[i].b * inv255;
+        }
+        if (premultiplied) {
+            /* Zero alpha means zero color, so the bias only avoids 0 / 0 */
+            float kb[BULK_TILE], ks[BULK_TILE];
+            for (size_t i = 0; i < n; i++) {
+                kb[i] = 1.0f / (ab[i] + 1e-20f);
+                ks[i] = 1.0f / (s[i].a * inv255 + 1e-20f);
+            }
+            for (int ch = 0; ch < 3; ch++) {
+                for (size_t i = 0; i < n; i++) {
+                    float vb = cb[ch][i] * kb[i], vs = cs[ch][i] * ks[i];
+                    cb[ch][i] = vb < 1 ? vb : 1;
+                    cs[ch][i] = vs < 1 ? vs : 1;
+                }
+            }
+        }
+
+        if (additive) {
+            /* Premultiplied sum, clamped: plus-lighter adds light, plus-darker
+             * adds the distance to white */
+            bool darker = mode == RX_BLEND_PLUS_DARKER;
+            float ao[BULK_TILE];
+            for (size_t i = 0; i < n; i++) {
+                float v = as[i] + ab[i];
+                ao[i] = v < 1 ? v : 1;
+            }
+            for (int ch = 0; ch < 3; ch++) {
+                for (size_t i = 0; i < n; i++) {
+                    float pb = cb[ch][i] * ab[i], ps = cs[ch][i] * as[i];
+                    float v = darker ? ao[i] - ((ab[i] - pb) + (as[i] - ps)) : pb + ps;
+                    v = v > 0 ? v : 0;
+                    mix[ch][i] = v < ao[i] ? v : ao[i];
+                }
+            }
+            memcpy(ab, ao, sizeof(float) * n);
+        } else {
+            if (separable) {
+                for (int ch = 0; ch < 3; ch++) plane(mix[ch], cb[ch], cs[ch], n);
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    float b3[3] = { cb[0][i], cb[1][i], cb[2][i] };
+                    float s3[3] = { cs[0][i], cs[1][i], cs[2][i] };
+                    float o3[3];
+                    blend_nonseparable(o3, b3, s3, mode);
+                    mix[0][i] = o3[0]; mix[1][i] = o3[1]; mix[2][i] = o3[2];
+                }
+            }
+            /* Source-over with the mix where both layers are present:
+             * co = cs*as*(1 - ab) + cb*ab*(1 - as) + as*ab*B, premultiplied */
+            for (int ch = 0; ch < 3; ch++) {
+                for (size_t i = 0; i < n; i++) {
+                    float a_s = as[i], a_b = ab[i];
+                    mix[ch][i] = cs[ch][i] * a_s * (1 - a_b) + cb[ch][i] * a_b * (1 - a_s) + a_s * a_b * mix[ch][i];
+                }
+            }
+            for (size_t i = 0; i < n; i++) ab[i] = as[i] + ab[i] - as[i] * ab[i];
+        }
+
+        if (!premultiplied) {
+            for (size_t i = 0; i < n; i++) {
+                float k = 1.0f / (ab[i] + 1e-20f);
+                mix[0][i] *= k; mix[1][i] *= k; mix[2][i] *= k;
+            }
+        }
+        uint8_t* out = (uint8_t*)d;
+        for (size_t i = 0; i < n; i++) {
+            out[i * 4 + 0] = (uint8_t)unit_to_int255(mix[0][i]);
+            out[i * 4 + 1] = (uint8_t)unit_to_int255(mix[1][i]);
+            out[i * 4 + 2] = (uint8_t)unit_to_int255(mix[2][i]);
+            out[i * 4 + 3] = (uint8_t)unit_to_int255(ab[i]);
+        }
+    }
+}
+
+void rx_blend_span(rx_color* dst, const rx_color* src, size_t count, rx_blend_mode mode, float opacity) {
+    blend_span(dst, src, count, mode, opacity, true);
+}
+
+void rx_blend_span_straight(rx_color* dst, const rx_color* src, size_t count, rx_blend_mode mode, float opacity) {
+    blend_span(dst, src, count, mode, opacity, false);
+}
+
 /* ============================================================================
  * Gradient System
  * ============================================================================ */
@@ -566,12 +1044,19 @@ void rx_gradient_add_stop(rx_gradient* grad, rx_color color, float position) {
     grad->stop_count++;
     
     qsort(grad->stops, grad->stop_count, sizeof(rx_gradient_stop), compare_stops);
+    if (grad->lut) rx_gradient_compile(grad, grad->lut_size, grad->lut_space);
+}
+
+static inline size_t lut_index(const rx_gradient* grad, float position) {
+    float p = CLAMP(position, 0.0f, 1.0f);     /* NaN falls to the first entry */
+    return (size_t)(p * (float)(grad->lut_size - 1) + 0.5f);
 }
 
 rx_color rx_gradient_color_at(rx_gradient* grad, float position) {
     if (!grad || grad->stop_count == 0) {
         return (rx_color){0, 0, 0, 255};
     }
+    if (grad->lut) return grad->lut[lut_index(grad, position)];
     
     if (grad->stop_count == 1) {
         return grad->stops[0].color;
@@ -579,6 +1064,12 @@ rx_color rx_gradient_color_at(rx_gradient* grad, float position) {
     
     position = CLAMP(position, 0, 1);
     
+    /* Outside the stops the end colors extend */
+    if (position <= grad->stops[0].position) return grad->stops[0].color;
+    if (position >= grad->stops[grad->stop_count - 1].position) {
+        return grad->stops[grad->stop_count - 1].color;
+    }
+    
     /* Find surrounding stops */
     rx_gradient_stop* prev = &grad->stops[0];
     rx_gradient_stop* next = &grad->stops[grad->stop_count - 1];
@@ -650,10 +1141,162 @@ rx_color rx_gradient_sample(rx_gradient* grad, rx_point pos, rx_rect bounds) {
 void rx_gradient_destroy(rx_gradient* grad) {
     if (grad) {
         free(grad->stops);
+        free(grad->lut);
         free(grad);
     }
 }
 
+/* ============================================================================
+ * Compiled Gradients
+ * ============================================================================ */
+
+bool rx_gradient_compile(rx_gradient* grad, size_t size, rx_gradient_space space) {
+    if (!grad || grad->stop_count == 0 || size < 2) return false;
+
+    rx_color* lut = grad->lut_size == size ? grad->lut : (rx_color*)malloc(sizeof(rx_color) * size);
+    float* planes = space == RX_GRADIENT_SPACE_SRGB ? NULL : (float*)malloc(sizeof(float) * size * 4);
+    if (!lut || (space != RX_GRADIENT_SPACE_SRGB && !planes)) {
+        if (lut != grad->lut) free(lut);
+        free(planes);
+        return false;
+    }
+
+    /* Stops in the interpolation space */
+    size_t n = grad->stop_count;
+    rx_color stop_colors[16];
+    float stop_values[16][4];
+    rx_color* colors = n <= 16 ? stop_colors : (rx_color*)malloc(sizeof(rx_color) * n);
+    float (*values)[4] = n <= 16 ? stop_values : (float (*)[4])malloc(sizeof(float) * 4 * n);
+    if (!colors || !values) {
+        if (colors != stop_colors) free(colors);
+        if (values != stop_values) free(values);
+        if (lut != grad->lut) free(lut);
+        free(planes);
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        rx_color c = grad->stops[i].color;
+        colors[i] = c;
+        if (space == RX_GRADIENT_SPACE_LAB) {
+            rx_lab lab = rx_rgb_to_lab(c);
+            values[i][0] = lab.l; values[i][1] = lab.a; values[i][2] = lab.b;
+        } else if (space == RX_GRADIENT_SPACE_LCH) {
+            rx_lch lch = rx_rgb_to_lch(c);
+            values[i][0] = lch.l; values[i][1] = lch.c; values[i][2] = lch.h;
+        } else {
+            values[i][0] = c.r; values[i][1] = c.g; values[i][2] = c.b;
+        }
+        values[i][3] = c.a;
+    }
+
+    float* pl = planes;
+    float* pa = planes ? planes + size : NULL;
+    float* pb = planes ? planes + size * 2 : NULL;
+    float* palpha = planes ? planes + size * 3 : NULL;
+    size_t seg = 0;
+    for (size_t i = 0; i < size; i++) {
+        float p = (float)i / (float)(size - 1);
+        while (seg + 1 < n - 1 && p > grad->stops[seg + 1].position) seg++;
+
+        const float* v0 = values[seg];
+        const float* v1 = values[n > 1 ? seg + 1 : seg];
+        float p0 = grad->stops[seg].position, p1 = grad->stops[n > 1 ? seg + 1 : seg].position;
+        float t = p1 > p0 ? CLAMP((p - p0) / (p1 - p0), 0.0f, 1.0f) : (p < p1 ? 0.0f : 1.0f);
+
+        float c0 = v0[0] + (v1[0] - v0[0]) * t;
+        float c1 = v0[1] + (v1[1] - v0[1]) * t;
+        float c2 = v0[2] + (v1[2] - v0[2]) * t;
+        float ca = v0[3] + (v1[3] - v0[3]) * t;
+        if (space == RX_GRADIENT_SPACE_LCH) {
+            float dh = v1[2] - v0[2];
+            if (dh > 180) dh -= 360;
+            if (dh < -180) dh += 360;
+            c2 = v0[2] + dh * t;
+            c2 = c2 < 0 ? c2 + 360 : (c2 >= 360 ? c2 - 360 : c2);
+        }
+        if (!planes) {
+            lut[i] = (rx_color){ (uint8_t)(c0 + 0.5f), (uint8_t)(c1 + 0.5f),
+                                 (uint8_t)(c2 + 0.5f), (uint8_t)(ca + 0.5f) };
+        } else {
+            pl[i] = c0; pa[i] = c1; pb[i] = c2; palpha[i] = ca * (1.0f / 255);
+        }
+    }
+    if (space == RX_GRADIENT_SPACE_LAB) rx_lab_to_rgba8(pl, pa, pb, palpha, size, lut);
+    if (space == RX_GRADIENT_SPACE_LCH) rx_lch_to_rgba8(pl, pa, pb, palpha, size, lut);
+
+    if (colors != stop_colors) free(colors);
+    if (values != stop_values) free(values);
+    free(planes);
+    if (lut != grad->lut) free(grad->lut);
+    grad->lut = lut;
+    grad->lut_size = size;
+    grad->lut_space = space;
+    return true;
+}
+
+void rx_gradient_fill_span(rx_gradient* grad, rx_rect bounds, float x, float y,
+                           size_t count, rx_color* out) {
+    if (!grad || !out || count == 0) return;
+    if (!grad->lut && !rx_gradient_compile(grad, RX_GRADIENT_LUT_SIZE,
+                                           grad->use_oklch ? RX_GRADIENT_SPACE_LCH : RX_GRADIENT_SPACE_SRGB)) {
+        rx_color c = rx_gradient_color_at(grad, 0);
+        for (size_t i = 0; i < count; i++) out[i] = c;
+        return;
+    }
+
+    const rx_color* lut = grad->lut;
+    float scale = (float)(grad->lut_size - 1);
+    uint32_t idx[BULK_TILE];
+
+    for (size_t base = 0; base < count; base += BULK_TILE) {
+        size_t n = count - base < BULK_TILE ? count - base : BULK_TILE;
+        float x0 = x + (float)base;
+
+        switch (grad->type) {
+            case RX_GRADIENT_LINEAR: {
+                /* Position is affine along the row */
+                float angle_rad = grad->angle * M_PI / 180;
+                float dx = cosf(angle_rad) / bounds.width;
+                float dy = sinf(angle_rad) / bounds.height;
+                float p0 = ((x0 - bounds.x) * dx + (y - bounds.y) * dy + 1) * 0.5f;
+                float dp = dx * 0.5f;
+                for (size_t i = 0; i < n; i++) {
+                    float p = CLAMP(p0 + dp * (float)i, 0.0f, 1.0f);
+                    idx[i] = (uint32_t)(p * scale + 0.5f);
+                }
+                break;
+            }
+            case RX_GRADIENT_RADIAL: {
+                float cx = bounds.x + grad->center.x * bounds.width;
+                float ry = y - (bounds.y + grad->center.y * bounds.height);
+                float inv = 1.0f / (grad->radius * bounds.width);
+                for (size_t i = 0; i < n; i++) {
+                    float rx = x0 + (float)i - cx;
+                    float p = CLAMP(sqrtf(rx * rx + ry * ry) * inv, 0.0f, 1.0f);
+                    idx[i] = (uint32_t)(p * scale + 0.5f);
+                }
+                break;
+            }
+            case RX_GRADIENT_ANGULAR:
+            case RX_GRADIENT_CONIC: {
+                float cx = bounds.x + grad->center.x * bounds.width;
+                float ry = y - (bounds.y + grad->center.y * bounds.height);
+                for (size_t i = 0; i < n; i++) {
+                    /* (atan2 + pi) / 2pi from an angle in [0, 360) */
+                    float deg = hue_degrees(ry, x0 + (float)i - cx);
+                    float p = (deg > 180 ? deg - 180 : deg + 180) * (1.0f / 360);
+                    idx[i] = (uint32_t)(CLAMP(p, 0.0f, 1.0f) * scale + 0.5f);
+                }
+                break;
+            }
+            default:
+                memset(idx, 0, sizeof(uint32_t) * n);
+                break;
+        }
+        for (size_t i = 0; i < n; i++) out[base + i] = lut[idx[i]];
+    }
+}
+
 /* ============================================================================
  * Preset Gradients
  * ============================================================================ */
@@ -762,15 +1405,9 @@ void rx_palette_destroy(rx_palette* pal) {
  * ============================================================================ */
 
 float rx_color_luminance(rx_color c) {
-    float r = c.r / 255.0f;
-    float g = c.g / 255.0f;
-    float b = c.b / 255.0f;
-    
-    r = r <= 0.03928f ? r / 12.92f : powf((r + 0.055f) / 1.055f, 2.4f);
-    g = g <= 0.03928f ? g / 12.92f : powf((g + 0.055f) / 1.055f, 2.4f);
-    b = b <= 0.03928f ? b / 12.92f : powf((b + 0.055f) / 1.055f, 2.4f);
-    
-    return 0.2126f * r + 0.7152f * g + 0.0722f * b;
+    return 0.2126f * srgb_to_linear_table[c.r] +
+           0.7152f * srgb_to_linear_table[c.g] +
+           0.0722f * srgb_to_linear_table[c.b];
 }
 
 float rx_color_contrast_ratio(rx_color c1, rx_color c2) {
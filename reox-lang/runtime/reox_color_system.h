@@ -4,9 +4,10 @@
  * 
  * Features:
  * - Multiple color spaces (RGB, HSL, HSV, LAB, LCH, XYZ)
- * - Blend modes (overlay, multiply, screen, etc.)
+ * - Bulk span conversions between RGBA8 and float planes
+ * - Blend modes (overlay, multiply, screen, etc.), per color or over buffers
  * - Color palette generation
- * - Gradient system
+ * - Gradient system with baked lookup tables and span fills
  * - Color accessibility checking
  */
 
@@ -87,6 +88,31 @@ extern rx_xyz rx_lab_to_xyz(rx_lab lab);
 extern rx_lch rx_lab_to_lch(rx_lab lab);
 extern rx_lab rx_lch_to_lab(rx_lch lch);
 
+/* ============================================================================
+ * Bulk Conversions
+ * ============================================================================ */
+
+/*
+ * Span conversions between rx_color pixels (or RGBA8 image rows) and float
+ * planes, for image filters and colour pickers that redraw whole planes.
+ * sRGB decoding is a 256-entry table; encoding and the Lab cube root are
+ * seeded Newton iterations, so they vectorize too. Loops run in
+ * tiles the compiler vectorizes. Planes use the units of the rx_lab,
+ * rx_lch and rx_hsv fields; alpha is 0-1 and may be NULL (opaque output).
+ */
+extern float rx_srgb_to_linear(uint8_t v);
+extern uint8_t rx_linear_to_srgb(float v);     /* Rounded */
+
+extern void rx_rgba8_to_lab(const rx_color* src, size_t count, float* l, float* a, float* b, float* alpha);
+extern void rx_lab_to_rgba8(const float* l, const float* a, const float* b, const float* alpha,
+                            size_t count, rx_color* dst);
+extern void rx_rgba8_to_lch(const rx_color* src, size_t count, float* l, float* c, float* h, float* alpha);
+extern void rx_lch_to_rgba8(const float* l, const float* c, const float* h, const float* alpha,
+                            size_t count, rx_color* dst);
+extern void rx_rgba8_to_hsv(const rx_color* src, size_t count, float* h, float* s, float* v, float* alpha);
+extern void rx_hsv_to_rgba8(const float* h, const float* s, const float* v, const float* alpha,
+                            size_t count, rx_color* dst);
+
 /* ============================================================================
  * Color Manipulation
  * ============================================================================ */
@@ -139,6 +165,16 @@ typedef enum rx_blend_mode {
 extern rx_color rx_color_blend(rx_color base, rx_color blend, rx_blend_mode mode);
 extern rx_color rx_color_blend_alpha(rx_color base, rx_color blend, rx_blend_mode mode, float alpha);
 
+/*
+ * Blend count src pixels onto dst in place (W3C compositing: source-over,
+ * with the mode's mix where both layers cover). opacity scales src alpha.
+ * The mode is resolved once per call and the work runs over float tiles.
+ * rx_blend_span takes premultiplied pixels; _straight takes and writes
+ * non-premultiplied ones.
+ */
+extern void rx_blend_span(rx_color* dst, const rx_color* src, size_t count, rx_blend_mode mode, float opacity);
+extern void rx_blend_span_straight(rx_color* dst, const rx_color* src, size_t count, rx_blend_mode mode, float opacity);
+
 /* ============================================================================
  * Gradient System
  * ============================================================================ */
@@ -151,6 +187,14 @@ typedef enum rx_gradient_type {
     RX_GRADIENT_CONIC,
 } rx_gradient_type;
 
+typedef enum rx_gradient_space {
+    RX_GRADIENT_SPACE_SRGB,
+    RX_GRADIENT_SPACE_LAB,
+    RX_GRADIENT_SPACE_LCH,    /* Shorter way round the hue circle */
+} rx_gradient_space;
+
+#define RX_GRADIENT_LUT_SIZE 256
+
 typedef struct rx_gradient_stop {
     rx_color color;
     float position;           /* 0.0 - 1.0 */
@@ -173,6 +217,10 @@ typedef struct rx_gradient {
     /* Color space for interpolation */
     bool use_oklch;           /* Modern perceptual interpolation */
     
+    /* Baked colors from rx_gradient_compile, rebuilt when stops change */
+    rx_color* lut;
+    size_t lut_size;
+    rx_gradient_space lut_space;
 } rx_gradient;
 
 extern rx_gradient* rx_gradient_linear(float angle, rx_gradient_stop* stops, size_t count);
@@ -183,6 +231,16 @@ extern rx_color rx_gradient_color_at(rx_gradient* grad, float position);
 extern rx_color rx_gradient_sample(rx_gradient* grad, rx_point pos, rx_rect bounds);
 extern void rx_gradient_destroy(rx_gradient* grad);
 
+/*
+ * Bake the gradient into size colors (256 or 1024 are typical) interpolated
+ * in space. Afterwards color_at and sample are a table lookup.
+ */
+extern bool rx_gradient_compile(rx_gradient* grad, size_t size, rx_gradient_space space);
+/* Write count pixels of the row at y starting at x, as rx_gradient_sample
+ * would; compiles the gradient first if needed */
+extern void rx_gradient_fill_span(rx_gradient* grad, rx_rect bounds, float x, float y,
+                                  size_t count, rx_color* out);
+
 /* Preset gradients */
 extern rx_gradient* rx_gradient_sunset(void);
 extern rx_gradient* rx_gradient_ocean(void);
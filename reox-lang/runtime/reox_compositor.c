@@ -0,0 +1,612 @@
+/*
+ * REOX Compositor - Implementation
+ * Off-main-thread animation of cached view layers
+ */
+
+#include "reox_compositor.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+static rx_compositor* active_compositor = NULL;
+
+static const rx_layer_props identity_props = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+
+/* ============================================================================
+ * Clock
+ * ============================================================================ */
+
+static double comp_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static struct timespec comp_deadline(double t) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)t;
+    ts.tv_nsec = (long)((t - (double)ts.tv_sec) * 1e9);
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+/* ============================================================================
+ * Layer Helpers (lock held)
+ * ============================================================================ */
+
+static rx_layer* layer_for_view(rx_compositor* comp, const rx_view* view) {
+    for (size_t i = 0; i < comp->layer_count; i++) {
+        if (comp->layers[i].view == view) return &comp->layers[i];
+    }
+    return NULL;
+}
+
+static rx_layer* layer_for_id(rx_compositor* comp, rx_layer_id id) {
+    for (size_t i = 0; i < comp->layer_count; i++) {
+        if (comp->layers[i].id == id) return &comp->layers[i];
+    }
+    return NULL;
+}
+
+/* Layer frames are in window space: view frames are relative to the parent */
+static rx_rect window_frame(const rx_view* view) {
+    rx_rect f = view->box.frame;
+    for (const rx_view* p = view->parent; p; p = p->parent) {
+        f.x += p->box.frame.x;
+        f.y += p->box.frame.y;
+    }
+    return f;
+}
+
+static bool props_identity(const rx_layer_props* p) {
+    return p->opacity == 1.0f && p->translate_x == 0.0f && p->translate_y == 0.0f &&
+           p->scale == 1.0f && p->rotation == 0.0f;
+}
+
+static void layer_set_prop(rx_layer* layer, rx_animatable_property prop, float value) {
+    switch (prop) {
+        case RX_PROP_OPACITY:  layer->props.opacity = value; break;
+        case RX_PROP_X:        layer->props.translate_x = value; break;
+        case RX_PROP_Y:        layer->props.translate_y = value; break;
+        case RX_PROP_SCALE:    layer->props.scale = value; break;
+        case RX_PROP_ROTATION: layer->props.rotation = value; break;
+        default: break;
+    }
+}
+
+/* Old content may still be on screen: release after the frame in flight */
+static void retire_content(rx_compositor* comp, void* content) {
+    if (!content) return;
+    if (comp->retired_count == comp->retired_capacity) {
+        size_t cap = comp->retired_capacity ? comp->retired_capacity * 2 : 8;
+        rx_retired_content* r = (rx_retired_content*)realloc(comp->retired, sizeof(rx_retired_content) * cap);
+        if (!r) return;  /* Leak rather than free content a frame may use */
+        comp->retired = r;
+        comp->retired_capacity = cap;
+    }
+    comp->retired[comp->retired_count].content = content;
+    comp->retired[comp->retired_count].frame = comp->frames_started;
+    comp->retired_count++;
+}
+
+static void remove_layer_animations(rx_compositor* comp, rx_layer_id id) {
+    size_t out = 0;
+    for (size_t i = 0; i < comp->animation_count; i++) {
+        if (comp->animations[i].layer != id) comp->animations[out++] = comp->animations[i];
+    }
+    comp->animation_count = out;
+}
+
+/*
+ * An idle layer left off identity by an exit animation (fade, slide or
+ * scale out) moves its end state onto the view so the layer can go: a
+ * vanished layer hides the view, a translation moves its frame. Other end
+ * states can't be expressed on the view and stay layered.
+ */
+static bool layer_snap(rx_layer* layer) {
+    rx_layer_props* p = &layer->props;
+    if (p->opacity <= 0.0f || p->scale <= 0.0f) {
+        view_set_visible(layer->view, false);
+        return true;
+    }
+    if (p->opacity != 1.0f || p->scale != 1.0f || p->rotation != 0.0f) return false;
+    layer->view->box.frame.x += p->translate_x;
+    layer->view->box.frame.y += p->translate_y;
+    return true;
+}
+
+/* Keeps z order */
+static void remove_layer_at(rx_compositor* comp, size_t index) {
+    rx_layer* layer = &comp->layers[index];
+    layer->view->layered = false;
+    retire_content(comp, layer->content);
+    remove_layer_animations(comp, layer->id);
+    memmove(layer, layer + 1, sizeof(rx_layer) * (comp->layer_count - index - 1));
+    comp->layer_count--;
+    comp->dirty = true;
+}
+
+/* ============================================================================
+ * Compositor Thread
+ * ============================================================================ */
+
+static bool compositor_busy(const rx_compositor* comp) {
+    if (comp->dirty) return true;
+    for (size_t i = 0; i < comp->animation_count; i++) {
+        if (!comp->animations[i].finished) return true;
+    }
+    return false;
+}
+
+static void compositor_tick(rx_compositor* comp, float dt) {
+    for (size_t i = 0; i < comp->animation_count; i++) {
+        rx_layer_animation* a = &comp->animations[i];
+        if (a->finished) continue;
+
+        if (a->delay > 0) {
+            a->delay -= dt;
+            continue;
+        }
+        a->elapsed += dt;
+
+        float progress = a->duration > 0 ? a->elapsed / a->duration : 1.0f;
+        if (progress > 1.0f) progress = 1.0f;
+
+        rx_layer* layer = layer_for_id(comp, a->layer);
+        if (!layer) {
+            a->finished = true;
+            continue;
+        }
+        layer_set_prop(layer, a->property, a->from + (a->to - a->from) * rx_ease(a->easing, progress));
+
+        if (progress >= 1.0f) {
+            a->finished = true;
+            layer->animations--;
+        }
+    }
+}
+
+static size_t compositor_snapshot(rx_compositor* comp) {
+    if (comp->layer_count > comp->snapshot_capacity) {
+        size_t cap = comp->snapshot_capacity ? comp->snapshot_capacity : 16;
+        while (cap < comp->layer_count) cap *= 2;
+        rx_layer_snapshot* s = (rx_layer_snapshot*)realloc(comp->snapshot, sizeof(rx_layer_snapshot) * cap);
+        if (!s) return 0;
+        comp->snapshot = s;
+        comp->snapshot_capacity = cap;
+    }
+
+    for (size_t i = 0; i < comp->layer_count; i++) {
+        const rx_layer* layer = &comp->layers[i];
+        comp->snapshot[i].id = layer->id;
+        comp->snapshot[i].content = layer->content;
+        comp->snapshot[i].frame = layer->frame;
+        comp->snapshot[i].props = layer->props;
+    }
+    return comp->layer_count;
+}
+
+/*
+ * Sleeps on the condition variable while nothing animates. Otherwise ticks
+ * and snapshots under the lock, composites outside it, then waits out the
+ * rest of the frame interval.
+ */
+static void* compositor_main(void* arg) {
+    rx_compositor* comp = (rx_compositor*)arg;
+    double last = comp_now();
+
+    pthread_mutex_lock(&comp->lock);
+    while (!comp->quit) {
+        if (!compositor_busy(comp)) {
+            pthread_cond_wait(&comp->wake, &comp->lock);
+            last = comp_now();
+            continue;
+        }
+
+        double start = comp_now();
+        compositor_tick(comp, (float)(start - last));
+        last = start;
+
+        size_t count = compositor_snapshot(comp);
+        comp->dirty = false;
+        uint64_t frame = ++comp->frames_started;
+        pthread_mutex_unlock(&comp->lock);
+
+        if (comp->backend.composite) {
+            comp->backend.composite(comp->backend.ctx, comp->snapshot, count);
+        }
+
+        pthread_mutex_lock(&comp->lock);
+        comp->frames_completed = frame;
+
+        struct timespec deadline = comp_deadline(start + comp->frame_interval);
+        while (!comp->quit) {
+            if (pthread_cond_timedwait(&comp->wake, &comp->lock, &deadline) == ETIMEDOUT) break;
+        }
+    }
+    pthread_mutex_unlock(&comp->lock);
+
+    return NULL;
+}
+
+/* ============================================================================
+ * Compositor Lifecycle
+ * ============================================================================ */
+
+rx_compositor* rx_compositor_create(const rx_compositor_backend* backend, float fps) {
+    rx_compositor* comp = (rx_compositor*)calloc(1, sizeof(rx_compositor));
+    if (!comp) return NULL;
+
+    if (backend) comp->backend = *backend;
+    comp->frame_interval = 1.0f / (fps > 0 ? fps : RX_COMPOSITOR_DEFAULT_FPS);
+    comp->next_id = 1;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&comp->lock, NULL);
+    pthread_cond_init(&comp->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    if (pthread_create(&comp->thread, NULL, compositor_main, comp) != 0) {
+        pthread_cond_destroy(&comp->wake);
+        pthread_mutex_destroy(&comp->lock);
+        free(comp);
+        return NULL;
+    }
+    comp->running = true;
+
+    return comp;
+}
+
+void rx_compositor_destroy(rx_compositor* comp) {
+    if (!comp) return;
+
+    if (comp->running) {
+        pthread_mutex_lock(&comp->lock);
+        comp->quit = true;
+        pthread_cond_signal(&comp->wake);
+        pthread_mutex_unlock(&comp->lock);
+        pthread_join(comp->thread, NULL);
+    }
+    if (active_compositor == comp) active_compositor = NULL;
+
+    /* Thread is gone: nothing references content any more */
+    for (size_t i = 0; i < comp->layer_count; i++) {
+        comp->layers[i].view->layered = false;
+        if (comp->backend.release) comp->backend.release(comp->backend.ctx, comp->layers[i].content);
+    }
+    for (size_t i = 0; i < comp->retired_count; i++) {
+        if (comp->backend.release) comp->backend.release(comp->backend.ctx, comp->retired[i].content);
+    }
+
+    pthread_cond_destroy(&comp->wake);
+    pthread_mutex_destroy(&comp->lock);
+    free(comp->layers);
+    free(comp->animations);
+    free(comp->retired);
+    free(comp->snapshot);
+    free(comp);
+}
+
+void rx_compositor_install(rx_compositor* comp) {
+    active_compositor = comp;
+}
+
+rx_compositor* rx_compositor_active(void) {
+    return active_compositor;
+}
+
+bool rx_compositor_can_animate(rx_animatable_property prop) {
+    switch (prop) {
+        case RX_PROP_X:
+        case RX_PROP_Y:
+        case RX_PROP_OPACITY:
+        case RX_PROP_SCALE:
+        case RX_PROP_ROTATION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* ============================================================================
+ * Layers
+ * ============================================================================ */
+
+static rx_layer_id layer_promote(rx_compositor* comp, rx_view* view, bool pinned) {
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* existing = layer_for_view(comp, view);
+    rx_layer_id id = RX_LAYER_INVALID;
+    if (existing) {
+        existing->pinned |= pinned;
+        id = existing->id;
+    }
+    pthread_mutex_unlock(&comp->lock);
+    if (id != RX_LAYER_INVALID) return id;
+
+    /* Capture on this thread without holding the compositor up */
+    void* content = comp->backend.capture ? comp->backend.capture(comp->backend.ctx, view) : NULL;
+
+    pthread_mutex_lock(&comp->lock);
+    if (comp->layer_count == comp->layer_capacity) {
+        size_t cap = comp->layer_capacity ? comp->layer_capacity * 2 : 8;
+        rx_layer* layers = (rx_layer*)realloc(comp->layers, sizeof(rx_layer) * cap);
+        if (!layers) {
+            pthread_mutex_unlock(&comp->lock);
+            if (comp->backend.release) comp->backend.release(comp->backend.ctx, content);
+            return RX_LAYER_INVALID;
+        }
+        comp->layers = layers;
+        comp->layer_capacity = cap;
+    }
+
+    rx_layer* layer = &comp->layers[comp->layer_count++];
+    layer->id = comp->next_id++;
+    layer->view = view;
+    layer->content = content;
+    layer->frame = window_frame(view);
+    layer->props = identity_props;
+    layer->animations = 0;
+    layer->pinned = pinned;
+    view->layered = true;
+    id = layer->id;
+
+    comp->dirty = true;
+    pthread_cond_signal(&comp->wake);
+    pthread_mutex_unlock(&comp->lock);
+
+    return id;
+}
+
+rx_layer_id rx_compositor_promote(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view) return RX_LAYER_INVALID;
+    return layer_promote(comp, view, true);
+}
+
+void rx_compositor_demote(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view) return;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) {
+        remove_layer_at(comp, (size_t)(layer - comp->layers));
+        pthread_cond_signal(&comp->wake);
+    }
+    pthread_mutex_unlock(&comp->lock);
+}
+
+void rx_compositor_invalidate(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view || !view->layered || !comp->backend.capture) return;
+
+    void* content = comp->backend.capture(comp->backend.ctx, view);
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) {
+        retire_content(comp, layer->content);
+        layer->content = content;
+        layer->frame = window_frame(view);
+        comp->dirty = true;
+        pthread_cond_signal(&comp->wake);
+        content = NULL;
+    }
+    pthread_mutex_unlock(&comp->lock);
+
+    /* Demoted meanwhile */
+    if (content && comp->backend.release) comp->backend.release(comp->backend.ctx, content);
+}
+
+void rx_compositor_unpin(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view) return;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) layer->pinned = false;
+    pthread_mutex_unlock(&comp->lock);
+}
+
+void rx_compositor_lower(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view) return;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) {
+        rx_layer bottom = *layer;
+        memmove(comp->layers + 1, comp->layers, sizeof(rx_layer) * (size_t)(layer - comp->layers));
+        comp->layers[0] = bottom;
+        comp->dirty = true;
+        pthread_cond_signal(&comp->wake);
+    }
+    pthread_mutex_unlock(&comp->lock);
+}
+
+bool rx_compositor_get_props(rx_compositor* comp, rx_view* view, rx_layer_props* out) {
+    if (!comp || !view || !out) return false;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) *out = layer->props;
+    pthread_mutex_unlock(&comp->lock);
+
+    return layer != NULL;
+}
+
+/* ============================================================================
+ * Layer Animations
+ * ============================================================================ */
+
+bool rx_compositor_animate(rx_compositor* comp, rx_view* view, rx_animatable_property prop,
+                           float from, float to, float duration, rx_easing easing, float delay) {
+    if (!comp || !view || !rx_compositor_can_animate(prop)) return false;
+
+    rx_layer_id id = layer_promote(comp, view, false);
+    if (id == RX_LAYER_INVALID) return false;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_id(comp, id);
+    if (!layer) {
+        pthread_mutex_unlock(&comp->lock);
+        return false;
+    }
+
+    rx_layer_animation* anim = NULL;
+    for (size_t i = 0; i < comp->animation_count; i++) {
+        rx_layer_animation* a = &comp->animations[i];
+        if (a->layer == id && a->property == prop) {
+            if (!a->finished) layer->animations--;
+            anim = a;
+            break;
+        }
+    }
+    if (!anim) {
+        if (comp->animation_count == comp->animation_capacity) {
+            size_t cap = comp->animation_capacity ? comp->animation_capacity * 2 : 16;
+            rx_layer_animation* a = (rx_layer_animation*)realloc(comp->animations,
+                                                                 sizeof(rx_layer_animation) * cap);
+            if (!a) {
+                pthread_mutex_unlock(&comp->lock);
+                return false;
+            }
+            comp->animations = a;
+            comp->animation_capacity = cap;
+        }
+        anim = &comp->animations[comp->animation_count++];
+    }
+
+    anim->layer = id;
+    anim->property = prop;
+    anim->from = from;
+    anim->to = to;
+    anim->duration = duration;
+    anim->delay = delay;
+    anim->elapsed = 0;
+    anim->easing = easing;
+    anim->finished = false;
+    anim->on_finished = NULL;
+    anim->user_data = NULL;
+    layer->animations++;
+
+    /* First composited frame shows the start value */
+    layer_set_prop(layer, prop, from);
+    comp->dirty = true;
+    pthread_cond_signal(&comp->wake);
+    pthread_mutex_unlock(&comp->lock);
+
+    return true;
+}
+
+void rx_compositor_set_finished(rx_compositor* comp, rx_view* view,
+                                rx_layer_finished_fn fn, void* user_data) {
+    if (!comp || !view) return;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    for (size_t i = 0; layer && i < comp->animation_count; i++) {
+        rx_layer_animation* a = &comp->animations[i];
+        if (a->layer == layer->id) {
+            a->on_finished = fn;
+            a->user_data = user_data;
+        }
+    }
+    pthread_mutex_unlock(&comp->lock);
+}
+
+void rx_compositor_cancel(rx_compositor* comp, rx_view* view) {
+    if (!comp || !view) return;
+
+    pthread_mutex_lock(&comp->lock);
+    rx_layer* layer = layer_for_view(comp, view);
+    if (layer) {
+        remove_layer_animations(comp, layer->id);
+        layer->animations = 0;
+        layer->props = identity_props;
+        comp->dirty = true;
+        pthread_cond_signal(&comp->wake);
+    }
+    pthread_mutex_unlock(&comp->lock);
+}
+
+/* ============================================================================
+ * UI Thread Collection
+ * ============================================================================ */
+
+typedef struct finished_call {
+    rx_layer_finished_fn fn;
+    rx_view* view;
+    rx_animatable_property property;
+    void* user_data;
+} finished_call;
+
+size_t rx_compositor_collect(rx_compositor* comp) {
+    if (!comp) return 0;
+
+    finished_call* calls = NULL;
+    size_t call_count = 0;
+    void** releases = NULL;
+    size_t release_count = 0;
+    size_t running = 0;
+
+    pthread_mutex_lock(&comp->lock);
+
+    /* Finished animations, in order */
+    size_t out = 0;
+    for (size_t i = 0; i < comp->animation_count; i++) {
+        rx_layer_animation* a = &comp->animations[i];
+        if (!a->finished) {
+            comp->animations[out++] = *a;
+            running++;
+            continue;
+        }
+        if (!a->on_finished) continue;
+        rx_layer* layer = layer_for_id(comp, a->layer);
+        if (!layer) continue;
+        if (!calls) calls = (finished_call*)malloc(sizeof(finished_call) * comp->animation_count);
+        if (calls) {
+            calls[call_count++] = (finished_call){ a->on_finished, layer->view, a->property, a->user_data };
+        }
+    }
+    comp->animation_count = out;
+
+    /* Idle layers back at identity look exactly like the view */
+    for (size_t i = comp->layer_count; i-- > 0;) {
+        rx_layer* layer = &comp->layers[i];
+        if (layer->animations == 0 && !layer->pinned &&
+            (props_identity(&layer->props) || layer_snap(layer))) {
+            remove_layer_at(comp, i);
+        }
+    }
+
+    /* Content no frame can still be drawing */
+    size_t keep = 0;
+    for (size_t i = 0; i < comp->retired_count; i++) {
+        rx_retired_content* r = &comp->retired[i];
+        if (comp->frames_completed >= r->frame) {
+            if (!releases) releases = (void**)malloc(sizeof(void*) * comp->retired_count);
+            if (releases) {
+                releases[release_count++] = r->content;
+                continue;
+            }
+        }
+        comp->retired[keep++] = *r;
+    }
+    comp->retired_count = keep;
+
+    if (comp->dirty) pthread_cond_signal(&comp->wake);
+    pthread_mutex_unlock(&comp->lock);
+
+    for (size_t i = 0; i < release_count; i++) {
+        if (comp->backend.release) comp->backend.release(comp->backend.ctx, releases[i]);
+    }
+    for (size_t i = 0; i < call_count; i++) {
+        calls[i].fn(calls[i].view, calls[i].property, calls[i].user_data);
+    }
+    free(releases);
+    free(calls);
+
+    return running;
+}
@@ -0,0 +1,180 @@
+/*
+ * REOX Compositor
+ * Off-main-thread animation of cached view layers
+ *
+ * Features:
+ * - Views animated only on opacity or transform are promoted to layers
+ * - Layer content is captured once on the UI thread and then reused
+ * - A compositor thread ticks layer animations and re-composites the
+ *   layers without layout, repaint or touching the view tree
+ * - Finished animations are reported back on the UI thread
+ *
+ * The compositor does not draw. Capturing a view into layer storage and
+ * compositing layers onto the screen are done through an
+ * rx_compositor_backend supplied by the renderer.
+ *
+ * Link with -pthread.
+ */
+
+#ifndef REOX_COMPOSITOR_H
+#define REOX_COMPOSITOR_H
+
+#include "reox_animation.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Layer Types
+ * ============================================================================ */
+
+#define RX_COMPOSITOR_DEFAULT_FPS 60
+
+typedef uint32_t rx_layer_id;
+#define RX_LAYER_INVALID 0
+
+/* Offset from the view's laid-out frame; identity is {1, 0, 0, 1, 0} */
+typedef struct rx_layer_props {
+    float opacity;
+    float translate_x, translate_y;
+    float scale;              /* Around the frame center */
+    float rotation;           /* Radians, around the frame center */
+} rx_layer_props;
+
+/* What the compositor thread hands to the backend, back to front */
+typedef struct rx_layer_snapshot {
+    rx_layer_id id;
+    void* content;            /* From rx_compositor_backend.capture */
+    rx_rect frame;            /* Window-space view frame at capture */
+    rx_layer_props props;
+} rx_layer_snapshot;
+
+typedef struct rx_compositor_backend {
+    /* UI thread: render view's subtree (view_render_content) into new
+     * layer storage; the old content is released once no frame uses it */
+    void* (*capture)(void* ctx, rx_view* view);
+    /* Compositor thread: draw the main scene plus layers and present */
+    void (*composite)(void* ctx, const rx_layer_snapshot* layers, size_t count);
+    /* UI thread: content is no longer referenced by any frame */
+    void (*release)(void* ctx, void* content);
+    void* ctx;
+} rx_compositor_backend;
+
+/* UI thread callback when a compositor animation finishes */
+typedef void (*rx_layer_finished_fn)(rx_view* view, rx_animatable_property prop, void* user_data);
+
+typedef struct rx_layer {
+    rx_layer_id id;
+    rx_view* view;            /* Only dereferenced on the UI thread */
+    void* content;
+    rx_rect frame;            /* Window space */
+    rx_layer_props props;
+    int animations;           /* Running compositor animations */
+    bool pinned;              /* Promoted explicitly: kept while idle */
+} rx_layer;
+
+typedef struct rx_layer_animation {
+    rx_layer_id layer;
+    rx_animatable_property property;
+    float from, to;
+    float duration, delay, elapsed;
+    rx_easing easing;
+    bool finished;            /* Waiting for rx_compositor_collect */
+    rx_layer_finished_fn on_finished;
+    void* user_data;
+} rx_layer_animation;
+
+typedef struct rx_retired_content {
+    void* content;
+    uint64_t frame;           /* Safe to release once this frame completed */
+} rx_retired_content;
+
+typedef struct rx_compositor {
+    rx_compositor_backend backend;
+
+    /* Everything below is guarded by lock unless noted */
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool running;
+    bool quit;
+    bool dirty;               /* Layers changed: composite once more */
+    float frame_interval;
+
+    rx_layer* layers;         /* z order: promotion order */
+    size_t layer_count, layer_capacity;
+    rx_layer_id next_id;
+
+    rx_layer_animation* animations;
+    size_t animation_count, animation_capacity;
+
+    rx_retired_content* retired;
+    size_t retired_count, retired_capacity;
+
+    uint64_t frames_started;
+    uint64_t frames_completed;
+
+    /* Compositor thread only */
+    rx_layer_snapshot* snapshot;
+    size_t snapshot_capacity;
+} rx_compositor;
+
+/* ============================================================================
+ * Compositor API
+ * ============================================================================ */
+
+/* Starts the compositor thread; fps <= 0 uses RX_COMPOSITOR_DEFAULT_FPS */
+extern rx_compositor* rx_compositor_create(const rx_compositor_backend* backend, float fps);
+extern void rx_compositor_destroy(rx_compositor* comp);
+
+/* Compositor used by rx_view_fade_in & co. and page transitions (NULL: off) */
+extern void rx_compositor_install(rx_compositor* comp);
+extern rx_compositor* rx_compositor_active(void);
+
+/* True for properties the compositor can animate without layout */
+extern bool rx_compositor_can_animate(rx_animatable_property prop);
+
+/* Layers (UI thread). Promoting captures the view's current content; an
+ * explicitly promoted view stays layered until demoted. view_free demotes
+ * from the active compositor; views layered in another one must be demoted
+ * before they are freed. */
+extern rx_layer_id rx_compositor_promote(rx_compositor* comp, rx_view* view);
+extern void rx_compositor_demote(rx_compositor* comp, rx_view* view);
+extern void rx_compositor_invalidate(rx_compositor* comp, rx_view* view);
+/* Drop an explicit promotion; the layer goes once idle at identity */
+extern void rx_compositor_unpin(rx_compositor* comp, rx_view* view);
+/* Move the view's layer below all others (page layers under the rest) */
+extern void rx_compositor_lower(rx_compositor* comp, rx_view* view);
+extern bool rx_compositor_get_props(rx_compositor* comp, rx_view* view, rx_layer_props* out);
+
+/*
+ * Animate a layer property on the compositor thread, promoting the view if
+ * needed. from/to are layer values: opacity, scale and rotation as-is, X/Y
+ * as translation from the laid-out frame. A running animation of the same
+ * property is replaced. Returns false for properties that need layout.
+ */
+extern bool rx_compositor_animate(rx_compositor* comp, rx_view* view, rx_animatable_property prop,
+                                  float from, float to, float duration, rx_easing easing, float delay);
+extern void rx_compositor_set_finished(rx_compositor* comp, rx_view* view,
+                                       rx_layer_finished_fn fn, void* user_data);
+
+/* Stop the view's animations and reset its layer to identity */
+extern void rx_compositor_cancel(rx_compositor* comp, rx_view* view);
+
+/*
+ * UI thread, once per frame: fires finished callbacks, releases retired
+ * content and demotes idle layers, snapping exit animations onto the view
+ * (hidden, or moved by the final translation). Returns the number of
+ * animations still running.
+ */
+extern size_t rx_compositor_collect(rx_compositor* comp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_COMPOSITOR_H */
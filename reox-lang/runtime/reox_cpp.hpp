@@ -1,33 +1,57 @@
 /**
  * @file reox_cpp.hpp
  * @brief REOX C++ Declarative UI Builder
- * 
+ *
  * SwiftUI-like declarative syntax for C++ applications.
  * Cross-platform, no SDL, no Vulkan - pure NXRender backend.
- * 
+ *
  * Copyright (c) 2025 KetiveeAI - Open Source (MIT License)
- * 
+ *
  * Example:
  *   #include "reox_cpp.hpp"
- *   
- *   auto ui = RX::VStack(
+ *
+ *   auto ui = RX::VStackT(
  *       RX::Text("Hello, REOX!"),
  *       RX::Button("Click Me").onClick([]{ printf("Clicked!"); }),
- *       RX::HStack(
+ *       RX::HStackT(
  *           RX::TextField().placeholder("Enter name..."),
  *           RX::Spacer()
  *       )
  *   );
+ *   RxNode* root = RX::buildTree(ui);
+ *
+ * Builders are move-only values. VStackT/HStackT/ZStackT hold their
+ * children by value, so a static layout is one object whose type spells
+ * out the tree: building it makes no virtual calls and no intermediate
+ * allocations. VStack/HStack/ZStack take children at run time through
+ * add(), for lists whose length is not known up front. (As with
+ * std::tuple, VStackT(VStackT(...)) with a single child deduces a copy;
+ * spell out VStackT<VStackT<...>> there.)
+ *
+ * Strings are taken as std::string_view and copied only when the tree is
+ * built; they must outlive the builder, not the nodes.
+ *
+ * buildTree() measures the tree first and puts every RxNode and its text
+ * in one allocation, owned by the root: rx_node_destroy(root) frees it.
+ * Rebuilding a whole panel every frame costs one malloc and one free.
  */
 
 #ifndef REOX_CPP_HPP
 #define REOX_CPP_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <tuple>
 #include <functional>
 #include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
 
 // Include C bridge
 extern "C" {
@@ -40,9 +64,11 @@ namespace RX {
 // Forward Declarations
 // ============================================================================
 
-struct Widget;
-template<typename... Children> struct VStackT;
-template<typename... Children> struct HStackT;
+class Widget;
+class Arena;
+template<typename... Children> class VStackT;
+template<typename... Children> class HStackT;
+template<typename... Children> class ZStackT;
 
 // ============================================================================
 // Color
@@ -50,14 +76,14 @@ template<typename... Children> struct HStackT;
 
 struct Color {
     uint8_t r, g, b, a;
-    
+
     constexpr Color() : r(0), g(0), b(0), a(255) {}
     constexpr Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) : r(r), g(g), b(b), a(a) {}
-    constexpr Color(uint32_t hex) 
+    constexpr Color(uint32_t hex)
         : r((hex >> 16) & 0xFF), g((hex >> 8) & 0xFF), b(hex & 0xFF), a(255) {}
-    
+
     NxColor toNx() const { return {r, g, b, a}; }
-    
+
     // NeolyxOS design system colors
     static constexpr Color primary() { return {88, 166, 255}; }
     static constexpr Color secondary() { return {99, 102, 241}; }
@@ -73,60 +99,173 @@ struct Color {
 };
 
 // ============================================================================
-// Widget Base
+// Node Arena
 // ============================================================================
 
-class Widget {
+/**
+ * One allocation holding every node of a tree, then all their text.
+ * Sized by a measure pass over the builders; nodes are handed out in
+ * build order, so the first one is the root and owns the block.
+ */
+class Arena {
 public:
-    virtual ~Widget() = default;
-    virtual RxNode* build() const = 0;
-    
-    // Modifiers (chainable)
-    Widget& background(Color c) { bg_ = c; return *this; }
-    Widget& foreground(Color c) { fg_ = c; return *this; }
-    Widget& padding(float p) { padding_ = p; return *this; }
-    Widget& cornerRadius(float r) { radius_ = r; return *this; }
-    Widget& frame(float w, float h) { width_ = w; height_ = h; return *this; }
-    
-protected:
-    Color bg_ = Color::clear();
-    Color fg_ = Color::text();
-    float padding_ = 0;
-    float radius_ = 0;
-    float width_ = -1;
-    float height_ = -1;
-    
-    void applyStyle(RxNode* node) const {
-        if (!node) return;
-        node->background = bg_.toNx();
-        node->foreground = fg_.toNx();
-        node->padding = padding_;
-        node->corner_radius = radius_;
-        if (width_ > 0) node->width = width_;
-        if (height_ > 0) node->height = height_;
+    struct Size {
+        size_t nodes = 0;
+        size_t text = 0;        // Bytes, terminators included
+
+        void node() { nodes++; }
+        void node(std::string_view s) { nodes++; text += s.size() + 1; }
+    };
+
+    explicit Arena(const Size& size) : size_(size) {
+        block_ = static_cast<char*>(calloc(1, size.nodes * sizeof(RxNode) + size.text));
+        if (!block_) throw std::bad_alloc();
+        text_ = block_ + size.nodes * sizeof(RxNode);
     }
+
+    // Unreleased nodes were never linked into a live tree
+    ~Arena() { free(block_); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    RxNode* node(RxNodeType type) {
+        assert(used_ < size_.nodes && "builder measured fewer nodes than it built");
+        RxNode* node = reinterpret_cast<RxNode*>(block_) + used_;
+        rx_node_init(node, type);
+        node->state |= RX_STATE_ARENA | (used_ == 0 ? RX_STATE_ARENA_ROOT : 0);
+        used_++;
+        return node;
+    }
+
+    RxNode* node(RxNodeType type, std::string_view text) {
+        assert(text_ + text.size() + 1 <= block_ + size_.nodes * sizeof(RxNode) + size_.text);
+        RxNode* n = node(type);
+        memcpy(text_, text.data(), text.size());
+        text_[text.size()] = '\0';
+        n->text = text_;
+        n->state |= RX_STATE_ARENA_TEXT;
+        text_ += text.size() + 1;
+        return n;
+    }
+
+    // Append a freshly built child; children arrive in order, so no walk
+    static void append(RxNode* parent, RxNode*& last, RxNode* child) {
+        child->parent = parent;
+        if (last) last->next_sibling = child;
+        else parent->first_child = child;
+        last = child;
+    }
+
+    // Hand the tree over; the caller frees it with rx_node_destroy()
+    RxNode* release() {
+        assert(used_ == size_.nodes && "builder measured more nodes than it built");
+        RxNode* r = root();
+        block_ = nullptr;
+        return r;
+    }
+
+private:
+    RxNode* root() { return reinterpret_cast<RxNode*>(block_); }
+
+    Size size_;
+    char* block_ = nullptr;
+    char* text_ = nullptr;
+    size_t used_ = 0;
+};
+
+/**
+ * Build any builder into an arena tree. The root is returned dirty and
+ * unparented; rx_node_destroy() on it frees the whole tree.
+ */
+template<typename WidgetT>
+RxNode* buildTree(const WidgetT& widget) {
+    Arena::Size size;
+    widget.measure(size);
+    Arena arena(size);
+    widget.build(arena);
+    return arena.release();
+}
+
+// ============================================================================
+// Modifiers
+// ============================================================================
+
+struct Style {
+    Color bg = Color::clear();
+    Color fg = Color::text();
+    float padding = 0;
+    float radius = 0;
+    float width = -1;
+    float height = -1;
+
+    void apply(RxNode* node) const {
+        node->background = bg.toNx();
+        node->foreground = fg.toNx();
+        node->padding = padding;
+        node->corner_radius = radius;
+        if (width > 0) node->width = width;
+        if (height > 0) node->height = height;
+    }
+};
+
+/**
+ * Base of every builder: move-only, with chainable modifiers that keep
+ * the concrete type. On a temporary they return it as an rvalue, so
+ * Text("a").bold() moves straight into the enclosing stack.
+ */
+template<typename Self>
+class Modifiers {
+public:
+    Modifiers() = default;
+    Modifiers(Modifiers&&) = default;
+    Modifiers& operator=(Modifiers&&) = default;
+    Modifiers(const Modifiers&) = delete;
+    Modifiers& operator=(const Modifiers&) = delete;
+
+    Self& background(Color c) & { style_.bg = c; return self(); }
+    Self& foreground(Color c) & { style_.fg = c; return self(); }
+    Self& padding(float p) & { style_.padding = p; return self(); }
+    Self& cornerRadius(float r) & { style_.radius = r; return self(); }
+    Self& frame(float w, float h) & { style_.width = w; style_.height = h; return self(); }
+
+    Self&& background(Color c) && { return std::move(background(c)); }
+    Self&& foreground(Color c) && { return std::move(foreground(c)); }
+    Self&& padding(float p) && { return std::move(padding(p)); }
+    Self&& cornerRadius(float r) && { return std::move(cornerRadius(r)); }
+    Self&& frame(float w, float h) && { return std::move(frame(w, h)); }
+
+protected:
+    ~Modifiers() = default;
+
+    Self& self() { return static_cast<Self&>(*this); }
+
+    Style style_;
 };
 
 // ============================================================================
 // Text Widget
 // ============================================================================
 
-class Text : public Widget {
+class Text : public Modifiers<Text> {
 public:
-    Text(const std::string& text) : text_(text) {}
-    
-    Text& fontSize(float size) { fontSize_ = size; return *this; }
-    Text& bold() { bold_ = true; return *this; }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_TEXT);
-        node->text = strdup(text_.c_str());
-        applyStyle(node);
+    Text(std::string_view text) : text_(text) {}
+
+    Text& fontSize(float size) & { fontSize_ = size; return *this; }
+    Text& bold() & { bold_ = true; return *this; }
+    Text&& fontSize(float size) && { return std::move(fontSize(size)); }
+    Text&& bold() && { return std::move(bold()); }
+
+    void measure(Arena::Size& size) const { size.node(text_); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_TEXT, text_);
+        style_.apply(node);
         return node;
     }
-    
+
 private:
-    std::string text_;
+    std::string_view text_;
     float fontSize_ = 14;
     bool bold_ = false;
 };
@@ -135,27 +274,31 @@ private:
 // Button Widget
 // ============================================================================
 
-class Button : public Widget {
+class Button : public Modifiers<Button> {
 public:
-    Button(const std::string& label) : label_(label) {
-        bg_ = Color::primary();
-        radius_ = 8;
-        padding_ = 12;
+    Button(std::string_view label) : label_(label) {
+        style_.bg = Color::primary();
+        style_.radius = 8;
+        style_.padding = 12;
     }
-    
-    Button& onClick(std::function<void()> cb) { onClick_ = cb; return *this; }
-    Button& destructive() { bg_ = Color::error(); return *this; }
-    Button& secondary() { bg_ = Color::surface(); return *this; }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_BUTTON);
-        node->text = strdup(label_.c_str());
-        applyStyle(node);
+
+    Button& onClick(std::function<void()> cb) & { onClick_ = std::move(cb); return *this; }
+    Button& destructive() & { style_.bg = Color::error(); return *this; }
+    Button& secondary() & { style_.bg = Color::surface(); return *this; }
+    Button&& onClick(std::function<void()> cb) && { return std::move(onClick(std::move(cb))); }
+    Button&& destructive() && { return std::move(destructive()); }
+    Button&& secondary() && { return std::move(secondary()); }
+
+    void measure(Arena::Size& size) const { size.node(label_); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_BUTTON, label_);
+        style_.apply(node);
         return node;
     }
-    
+
 private:
-    std::string label_;
+    std::string_view label_;
     std::function<void()> onClick_;
 };
 
@@ -163,28 +306,34 @@ private:
 // TextField Widget
 // ============================================================================
 
-class TextField : public Widget {
+class TextField : public Modifiers<TextField> {
 public:
     TextField() {
-        bg_ = Color::surface();
-        radius_ = 8;
-        padding_ = 12;
+        style_.bg = Color::surface();
+        style_.radius = 8;
+        style_.padding = 12;
     }
-    
-    TextField& placeholder(const std::string& p) { placeholder_ = p; return *this; }
-    TextField& text(const std::string& t) { text_ = t; return *this; }
-    TextField& onChange(std::function<void(const std::string&)> cb) { onChange_ = cb; return *this; }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_TEXTFIELD);
-        node->text = strdup(text_.empty() ? placeholder_.c_str() : text_.c_str());
-        applyStyle(node);
+
+    TextField& placeholder(std::string_view p) & { placeholder_ = p; return *this; }
+    TextField& text(std::string_view t) & { text_ = t; return *this; }
+    TextField& onChange(std::function<void(const std::string&)> cb) & { onChange_ = std::move(cb); return *this; }
+    TextField&& placeholder(std::string_view p) && { return std::move(placeholder(p)); }
+    TextField&& text(std::string_view t) && { return std::move(text(t)); }
+    TextField&& onChange(std::function<void(const std::string&)> cb) && { return std::move(onChange(std::move(cb))); }
+
+    void measure(Arena::Size& size) const { size.node(shown()); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_TEXTFIELD, shown());
+        style_.apply(node);
         return node;
     }
-    
+
 private:
-    std::string placeholder_;
-    std::string text_;
+    std::string_view shown() const { return text_.empty() ? placeholder_ : text_; }
+
+    std::string_view placeholder_;
+    std::string_view text_;
     std::function<void(const std::string&)> onChange_;
 };
 
@@ -192,15 +341,18 @@ private:
 // Spacer & Divider
 // ============================================================================
 
-class Spacer : public Widget {
+class Spacer : public Modifiers<Spacer> {
 public:
-    RxNode* build() const override { return rx_node_create(RX_NODE_SPACER); }
+    void measure(Arena::Size& size) const { size.node(); }
+    RxNode* build(Arena& arena) const { return arena.node(RX_NODE_SPACER); }
 };
 
-class Divider : public Widget {
+class Divider : public Modifiers<Divider> {
 public:
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_DIVIDER);
+    void measure(Arena::Size& size) const { size.node(); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_DIVIDER);
         node->height = 1;
         return node;
     }
@@ -210,23 +362,26 @@ public:
 // Checkbox Widget
 // ============================================================================
 
-class Checkbox : public Widget {
+class Checkbox : public Modifiers<Checkbox> {
 public:
-    Checkbox(const std::string& label = "") : label_(label) {}
-    
-    Checkbox& checked(bool c) { checked_ = c; return *this; }
-    Checkbox& onToggle(std::function<void(bool)> cb) { onToggle_ = cb; return *this; }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_CHECKBOX);
-        node->text = strdup(label_.c_str());
+    Checkbox(std::string_view label = {}) : label_(label) {}
+
+    Checkbox& checked(bool c) & { checked_ = c; return *this; }
+    Checkbox& onToggle(std::function<void(bool)> cb) & { onToggle_ = std::move(cb); return *this; }
+    Checkbox&& checked(bool c) && { return std::move(checked(c)); }
+    Checkbox&& onToggle(std::function<void(bool)> cb) && { return std::move(onToggle(std::move(cb))); }
+
+    void measure(Arena::Size& size) const { size.node(label_); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_CHECKBOX, label_);
         node->value = checked_ ? 1.0f : 0.0f;
-        applyStyle(node);
+        style_.apply(node);
         return node;
     }
-    
+
 private:
-    std::string label_;
+    std::string_view label_;
     bool checked_ = false;
     std::function<void(bool)> onToggle_;
 };
@@ -235,20 +390,24 @@ private:
 // Slider Widget
 // ============================================================================
 
-class Slider : public Widget {
+class Slider : public Modifiers<Slider> {
 public:
     Slider(float min = 0, float max = 1) : min_(min), max_(max) {}
-    
-    Slider& value(float v) { value_ = v; return *this; }
-    Slider& onChange(std::function<void(float)> cb) { onChange_ = cb; return *this; }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_SLIDER);
+
+    Slider& value(float v) & { value_ = v; return *this; }
+    Slider& onChange(std::function<void(float)> cb) & { onChange_ = std::move(cb); return *this; }
+    Slider&& value(float v) && { return std::move(value(v)); }
+    Slider&& onChange(std::function<void(float)> cb) && { return std::move(onChange(std::move(cb))); }
+
+    void measure(Arena::Size& size) const { size.node(); }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(RX_NODE_SLIDER);
         node->value = (value_ - min_) / (max_ - min_);
-        applyStyle(node);
+        style_.apply(node);
         return node;
     }
-    
+
 private:
     float min_, max_;
     float value_ = 0;
@@ -256,81 +415,142 @@ private:
 };
 
 // ============================================================================
-// Container Widgets (VStack, HStack)
+// Static Containers (VStackT, HStackT, ZStackT)
 // ============================================================================
 
-class VStack : public Widget {
+/**
+ * Children held in a tuple and visited by fold expressions: the layout's
+ * shape is fixed at compile time and each child's build() is a direct call.
+ */
+template<typename Self, RxNodeType Type, typename... Children>
+class StackT : public Modifiers<Self> {
 public:
-    VStack(float gap = 8) : gap_(gap) {}
-    
-    template<typename T>
-    VStack& add(T&& widget) {
-        children_.push_back(std::make_unique<std::decay_t<T>>(std::forward<T>(widget)));
-        return *this;
+    explicit StackT(Children&&... children) : children_(std::move(children)...) {}
+
+    Self& gap(float g) & { gap_ = g; return this->self(); }
+    Self&& gap(float g) && { return std::move(gap(g)); }
+
+    void measure(Arena::Size& size) const {
+        size.node();
+        std::apply([&](const Children&... child) { (child.measure(size), ...); }, children_);
     }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_VSTACK);
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(Type);
         node->gap = gap_;
-        applyStyle(node);
-        
-        for (const auto& child : children_) {
-            rx_node_add_child(node, child->build());
-        }
+        this->style_.apply(node);
+
+        RxNode* last = nullptr;
+        std::apply([&](const Children&... child) {
+            (Arena::append(node, last, child.build(arena)), ...);
+        }, children_);
         return node;
     }
-    
+
 private:
-    float gap_;
-    std::vector<std::unique_ptr<Widget>> children_;
+    std::tuple<Children...> children_;
+    float gap_ = Type == RX_NODE_ZSTACK ? 0 : 8;
+};
+
+template<typename... Children>
+class VStackT : public StackT<VStackT<Children...>, RX_NODE_VSTACK, Children...> {
+public:
+    using StackT<VStackT, RX_NODE_VSTACK, Children...>::StackT;
+};
+
+template<typename... Children>
+class HStackT : public StackT<HStackT<Children...>, RX_NODE_HSTACK, Children...> {
+public:
+    using StackT<HStackT, RX_NODE_HSTACK, Children...>::StackT;
+};
+
+template<typename... Children>
+class ZStackT : public StackT<ZStackT<Children...>, RX_NODE_ZSTACK, Children...> {
+public:
+    using StackT<ZStackT, RX_NODE_ZSTACK, Children...>::StackT;
+};
+
+template<typename... C> VStackT(C&&...) -> VStackT<std::decay_t<C>...>;
+template<typename... C> HStackT(C&&...) -> HStackT<std::decay_t<C>...>;
+template<typename... C> ZStackT(C&&...) -> ZStackT<std::decay_t<C>...>;
+
+// ============================================================================
+// Dynamic Containers (VStack, HStack, ZStack)
+// ============================================================================
+
+/**
+ * Type-erased builder, for children added at run time. Only the dynamic
+ * containers go through it; static layouts never see a vtable.
+ */
+class Widget {
+public:
+    virtual ~Widget() = default;
+    virtual void measure(Arena::Size& size) const = 0;
+    virtual RxNode* build(Arena& arena) const = 0;
+};
+
+template<typename WidgetT>
+class WidgetBox final : public Widget {
+public:
+    explicit WidgetBox(WidgetT&& widget) : widget_(std::move(widget)) {}
+    void measure(Arena::Size& size) const override { widget_.measure(size); }
+    RxNode* build(Arena& arena) const override { return widget_.build(arena); }
+
+private:
+    WidgetT widget_;
 };
 
-class HStack : public Widget {
+template<typename Self, RxNodeType Type>
+class Stack : public Modifiers<Self> {
 public:
-    HStack(float gap = 8) : gap_(gap) {}
-    
     template<typename T>
-    HStack& add(T&& widget) {
-        children_.push_back(std::make_unique<std::decay_t<T>>(std::forward<T>(widget)));
-        return *this;
+    Self& add(T&& widget) & {
+        static_assert(!std::is_lvalue_reference_v<T>, "builders are move-only; pass a temporary or std::move");
+        children_.push_back(std::make_unique<WidgetBox<std::decay_t<T>>>(std::move(widget)));
+        return this->self();
     }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_HSTACK);
+
+    template<typename T>
+    Self&& add(T&& widget) && { return std::move(add(std::forward<T>(widget))); }
+
+    void measure(Arena::Size& size) const {
+        size.node();
+        for (const auto& child : children_) child->measure(size);
+    }
+
+    RxNode* build(Arena& arena) const {
+        RxNode* node = arena.node(Type);
         node->gap = gap_;
-        applyStyle(node);
-        
+        this->style_.apply(node);
+
+        RxNode* last = nullptr;
         for (const auto& child : children_) {
-            rx_node_add_child(node, child->build());
+            Arena::append(node, last, child->build(arena));
         }
         return node;
     }
-    
+
+protected:
+    explicit Stack(float gap) : gap_(gap) {}
+
 private:
     float gap_;
     std::vector<std::unique_ptr<Widget>> children_;
 };
 
-class ZStack : public Widget {
+class VStack : public Stack<VStack, RX_NODE_VSTACK> {
 public:
-    template<typename T>
-    ZStack& add(T&& widget) {
-        children_.push_back(std::make_unique<std::decay_t<T>>(std::forward<T>(widget)));
-        return *this;
-    }
-    
-    RxNode* build() const override {
-        RxNode* node = rx_node_create(RX_NODE_ZSTACK);
-        applyStyle(node);
-        
-        for (const auto& child : children_) {
-            rx_node_add_child(node, child->build());
-        }
-        return node;
-    }
-    
-private:
-    std::vector<std::unique_ptr<Widget>> children_;
+    explicit VStack(float gap = 8) : Stack(gap) {}
+};
+
+class HStack : public Stack<HStack, RX_NODE_HSTACK> {
+public:
+    explicit HStack(float gap = 8) : Stack(gap) {}
+};
+
+class ZStack : public Stack<ZStack, RX_NODE_ZSTACK> {
+public:
+    ZStack() : Stack(0) {}
 };
 
 // ============================================================================
@@ -339,43 +559,43 @@ private:
 
 class App {
 public:
-    App(uint32_t width, uint32_t height, const std::string& title = "REOX App")
+    App(uint32_t width, uint32_t height, std::string_view title = "REOX App")
         : width_(width), height_(height), title_(title) {}
-    
+
     ~App() {
         if (initialized_) rx_bridge_destroy();
     }
-    
+
     bool init() {
         rx_bridge_init(width_, height_);
         initialized_ = true;
         return true;
     }
-    
+
     template<typename WidgetT>
-    void setContent(WidgetT&& root) {
+    void setContent(const WidgetT& root) {
         if (!initialized_) return;
-        
+
         if (rx_bridge->root) rx_node_destroy(rx_bridge->root);
-        
-        RxNode* rootNode = root.build();
+
+        RxNode* rootNode = buildTree(root);
         rootNode->x = 0;
         rootNode->y = 0;
         rootNode->width = static_cast<float>(width_);
         rootNode->height = static_cast<float>(height_);
         rootNode->state |= RX_STATE_DIRTY;
-        
+
         rx_bridge->root = rootNode;
         rx_bridge->needs_redraw = true;
     }
-    
+
     void mouseMove(float x, float y) { rx_handle_mouse_move(x, y); }
     void mouseDown(float x, float y) { rx_handle_mouse_down(x, y); }
     void mouseUp(float x, float y) { rx_handle_mouse_up(x, y); }
-    
+
     void frame() { rx_frame(); }
     bool needsRedraw() const { return rx_bridge && rx_bridge->needs_redraw; }
-    
+
 private:
     uint32_t width_, height_;
     std::string title_;
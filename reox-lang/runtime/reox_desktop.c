@@ -6,6 +6,7 @@
 #include "reox_desktop.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 /* ============================================================================
  * Taskbar Implementation
@@ -254,10 +255,130 @@ void menu_bar_set_app(rx_menu_bar* bar, const char* name, const char* icon) {
     bar->app_icon = icon ? strdup(icon) : NULL;
 }
 
+/* ============================================================================
+ * Occlusion
+ * ============================================================================ */
+
+/* Disjoint rects. Past the cap a rect is kept whole instead of split,
+ * which only means drawing a little more than is visible. */
+#define RX_DESKTOP_REGION_MAX 64
+
+typedef struct rx_desktop_region {
+    rx_rect rects[RX_DESKTOP_REGION_MAX];
+    int count;
+} rx_desktop_region;
+
+static bool rect_empty(rx_rect r) {
+    return r.width <= 0 || r.height <= 0;
+}
+
+static rx_rect rect_intersect(rx_rect a, rx_rect b) {
+    float x0 = fmaxf(a.x, b.x), y0 = fmaxf(a.y, b.y);
+    float x1 = fminf(a.x + a.width, b.x + b.width);
+    float y1 = fminf(a.y + a.height, b.y + b.height);
+    return rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+static float region_area(const rx_desktop_region* r) {
+    float area = 0;
+    for (int i = 0; i < r->count; i++) area += r->rects[i].width * r->rects[i].height;
+    return area;
+}
+
+/* The parts of r inside clip */
+static void region_clip(rx_desktop_region* out, const rx_desktop_region* r, rx_rect clip) {
+    out->count = 0;
+    for (int i = 0; i < r->count; i++) {
+        rx_rect c = rect_intersect(r->rects[i], clip);
+        if (!rect_empty(c)) out->rects[out->count++] = c;
+    }
+}
+
+/* Remove hole: each rect it cuts splits into bands above and below and
+ * pieces left and right of it */
+static void region_subtract(rx_desktop_region* r, rx_rect hole) {
+    rx_desktop_region out;
+    out.count = 0;
+    for (int i = 0; i < r->count; i++) {
+        rx_rect a = r->rects[i];
+        rx_rect h = rect_intersect(a, hole);
+        if (rect_empty(h)) {
+            out.rects[out.count++] = a;
+            continue;
+        }
+        
+        rx_rect pieces[4];
+        int n = 0;
+        float a_bottom = a.y + a.height, h_bottom = h.y + h.height;
+        float a_right = a.x + a.width, h_right = h.x + h.width;
+        if (h.y > a.y) pieces[n++] = rect(a.x, a.y, a.width, h.y - a.y);
+        if (h_bottom < a_bottom) pieces[n++] = rect(a.x, h_bottom, a.width, a_bottom - h_bottom);
+        if (h.x > a.x) pieces[n++] = rect(a.x, h.y, h.x - a.x, h.height);
+        if (h_right < a_right) pieces[n++] = rect(h_right, h.y, a_right - h_right, h.height);
+        
+        /* Leave a slot for every rect still to come */
+        if (out.count + n + (r->count - i - 1) > RX_DESKTOP_REGION_MAX) {
+            out.rects[out.count++] = a;
+            continue;
+        }
+        for (int k = 0; k < n; k++) out.rects[out.count++] = pieces[k];
+    }
+    *r = out;
+}
+
+/* What an opaque box certainly covers of frame. Rounded corners leave
+ * their corner squares open, so only the band between them counts. */
+static bool box_occluder(const rx_box* box, rx_rect frame, rx_rect* out) {
+    if (box->background.a != 255) return false;
+    rx_corner_radii c = box->corner_radius;
+    float top = fmaxf(c.top_left, c.top_right);
+    float bottom = fmaxf(c.bottom_left, c.bottom_right);
+    *out = rect(frame.x, frame.y + top, frame.width, frame.height - top - bottom);
+    return !rect_empty(*out);
+}
+
 /* ============================================================================
  * Desktop Implementation
  * ============================================================================ */
 
+static rx_rect desktop_window_frame(const rx_desktop_window* dw) {
+    return rect(dw->window->position.x, dw->window->position.y,
+                dw->window->size.width, dw->window->size.height);
+}
+
+static bool desktop_window_drawable(const rx_desktop_window* dw) {
+    return dw->visible && dw->window && dw->window->root_view && dw->window->root_view->visible;
+}
+
+static void desktop_release_surface(rx_desktop* d, void** surface) {
+    if (*surface && d->has_surfaces) d->surfaces.release(d->surfaces.ctx, *surface);
+    *surface = NULL;
+}
+
+static void desktop_release_surfaces(rx_desktop* d) {
+    for (size_t i = 0; i < d->window_count; i++) {
+        desktop_release_surface(d, &d->windows[i]->surface);
+        d->windows[i]->surface_valid = false;
+    }
+    desktop_release_surface(d, &d->wallpaper_surface);
+    d->wallpaper_valid = false;
+}
+
+/* Move window to the front; z_order follows the array */
+static void desktop_raise(rx_desktop* d, rx_desktop_window* window) {
+    size_t at = d->window_count;
+    for (size_t i = 0; i < d->window_count; i++) {
+        if (d->windows[i] == window) at = i;
+    }
+    if (at == d->window_count) return;
+    for (size_t i = at; i + 1 < d->window_count; i++) {
+        d->windows[i] = d->windows[i + 1];
+        d->windows[i]->z_order = (int)i;
+    }
+    d->windows[d->window_count - 1] = window;
+    window->z_order = (int)d->window_count - 1;
+}
+
 rx_desktop* desktop_create(int width, int height) {
     rx_desktop* d = (rx_desktop*)calloc(1, sizeof(rx_desktop));
     if (!d) return NULL;
@@ -297,6 +418,9 @@ rx_desktop* desktop_create(int width, int height) {
 void desktop_destroy(rx_desktop* desktop) {
     if (!desktop) return;
     
+    desktop_release_surfaces(desktop);
+    free(desktop->regions);
+    
     /* Free windows */
     for (size_t i = 0; i < desktop->window_count; i++) {
         if (desktop->windows[i]->window) {
@@ -353,12 +477,14 @@ void desktop_close_window(rx_desktop* d, rx_desktop_window* window) {
     
     /* Remove from taskbar */
     taskbar_remove_window(d->taskbar, window);
+    desktop_release_surface(d, &window->surface);
     
     /* Remove from windows list */
     for (size_t i = 0; i < d->window_count; i++) {
         if (d->windows[i] == window) {
             for (size_t j = i; j < d->window_count - 1; j++) {
                 d->windows[j] = d->windows[j + 1];
+                d->windows[j]->z_order = (int)j;
             }
             d->window_count--;
             break;
@@ -388,7 +514,7 @@ void desktop_focus_window(rx_desktop* d, rx_desktop_window* window) {
     
     /* Focus new */
     window->focused = true;
-    window->z_order = 999;  /* Bring to front */
+    desktop_raise(d, window);
     d->focused_window = window;
     
     /* Update taskbar */
@@ -401,9 +527,10 @@ void desktop_focus_window(rx_desktop* d, rx_desktop_window* window) {
 }
 
 void desktop_minimize_window(rx_desktop* d, rx_desktop_window* window) {
+    (void)d;
     if (!window) return;
-    window->restore_frame = window->window->root_view ? 
-        window->window->root_view->box.frame : (rx_rect){0,0,0,0};
+    /* The surface is kept, so restoring shows it without a render */
+    window->restore_frame = desktop_window_frame(window);
     window->state = RX_WINDOW_MINIMIZED;
     window->visible = false;
 }
@@ -412,8 +539,7 @@ void desktop_maximize_window(rx_desktop* d, rx_desktop_window* window) {
     if (!d || !window) return;
     
     if (window->state != RX_WINDOW_MAXIMIZED) {
-        window->restore_frame = window->window->root_view ?
-            window->window->root_view->box.frame : (rx_rect){0,0,0,0};
+        window->restore_frame = desktop_window_frame(window);
     }
     
     window->state = RX_WINDOW_MAXIMIZED;
@@ -425,6 +551,7 @@ void desktop_maximize_window(rx_desktop* d, rx_desktop_window* window) {
 }
 
 void desktop_restore_window(rx_desktop* d, rx_desktop_window* window) {
+    (void)d;
     if (!window) return;
     
     window->state = RX_WINDOW_NORMAL;
@@ -442,6 +569,17 @@ void desktop_restore_window(rx_desktop* d, rx_desktop_window* window) {
     }
 }
 
+void desktop_move_window(rx_desktop* d, rx_desktop_window* window, rx_point position) {
+    (void)d;
+    if (!window || !window->window) return;
+    window->window->position = position;
+}
+
+void desktop_invalidate_window(rx_desktop* d, rx_desktop_window* window) {
+    (void)d;
+    if (window) window->surface_valid = false;
+}
+
 void desktop_show_all(rx_desktop* d) {
     if (!d) return;
     for (size_t i = 0; i < d->window_count; i++) {
@@ -493,6 +631,7 @@ void desktop_tile_windows(rx_desktop* d, bool horizontal) {
 void desktop_set_wallpaper(rx_desktop* d, const char* path) {
     if (!d) return;
     d->wallpaper_path = path ? strdup(path) : NULL;
+    d->wallpaper_valid = false;
     /* TODO: Load image */
 }
 
@@ -502,11 +641,22 @@ void desktop_set_wallpaper_color(rx_desktop* d, rx_color color) {
     if (d->wallpaper) {
         d->wallpaper->box.background = color;
     }
+    d->wallpaper_valid = false;
+}
+
+void desktop_set_surface_backend(rx_desktop* d, const rx_desktop_surface_backend* backend) {
+    if (!d) return;
+    desktop_release_surfaces(d);
+    d->has_surfaces = backend != NULL;
+    if (backend) d->surfaces = *backend;
 }
 
 void desktop_layout(rx_desktop* d) {
     if (!d) return;
     
+    if (view_needs_layout(d->wallpaper)) d->wallpaper_valid = false;
+    view_layout(d->wallpaper, size((float)d->screen_width, (float)d->screen_height));
+    
     /* Layout taskbar at bottom */
     if (d->taskbar) {
         d->taskbar->base.box.frame = rect(
@@ -539,40 +689,134 @@ void desktop_layout(rx_desktop* d) {
     for (size_t i = 0; i < d->window_count; i++) {
         rx_desktop_window* dw = d->windows[i];
         if (dw->window && dw->window->root_view) {
+            /* A relayout may change anything drawn; a move changes nothing */
+            if (view_needs_layout(dw->window->root_view)) dw->surface_valid = false;
             view_layout(dw->window->root_view, dw->window->size);
         }
     }
 }
 
+/* Surface for view at size, rendered again if stale; NULL without one */
+static void* desktop_surface(rx_desktop* d, void** surface, bool* valid, rx_view* view, rx_size sz) {
+    if (*surface && *valid) return *surface;
+    void* fresh = d->surfaces.capture(d->surfaces.ctx, view, sz);
+    desktop_release_surface(d, surface);
+    *surface = fresh;
+    *valid = fresh != NULL;
+    d->stats.captures++;
+    return fresh;
+}
+
+/* Draw a surface (or, without one, the live tree) where it can be seen */
+static void desktop_draw(rx_desktop* d, void* surface, rx_view* view, rx_rect frame,
+                         const rx_desktop_region* visible, void* context) {
+    if (!surface) {
+        view_render(view, context);
+        return;
+    }
+    for (int i = 0; i < visible->count; i++) {
+        d->surfaces.draw(d->surfaces.ctx, surface, frame, visible->rects[i]);
+        d->stats.draws++;
+    }
+}
+
+static bool desktop_reserve_regions(rx_desktop* d) {
+    if (d->window_count <= d->region_capacity) return true;
+    size_t cap = d->region_capacity ? d->region_capacity : 8;
+    while (cap < d->window_count) cap *= 2;
+    rx_desktop_region* regions = (rx_desktop_region*)realloc(d->regions, sizeof(rx_desktop_region) * cap);
+    if (!regions) return false;
+    d->regions = regions;
+    d->region_capacity = cap;
+    return true;
+}
+
 void desktop_render(rx_desktop* d, void* context) {
-    if (!d) return;
+    if (!d || !desktop_reserve_regions(d)) return;
+    memset(&d->stats, 0, sizeof(d->stats));
+    
+    rx_rect screen = rect(0, 0, (float)d->screen_width, (float)d->screen_height);
+    rx_view* chrome[3] = {
+        d->menu_bar ? &d->menu_bar->base : NULL,
+        d->taskbar ? &d->taskbar->base : NULL,
+        d->dock && d->dock->visible ? &d->dock->base : NULL,
+    };
     
-    /* Render wallpaper */
-    view_render(d->wallpaper, context);
+    /* Front to back: what each window shows, and what is left uncovered
+     * for the wallpaper. Chrome is always on top. */
+    rx_desktop_region uncovered = { .rects = { screen }, .count = 1 };
+    rx_rect occluder;
+    for (int i = 0; i < 3; i++) {
+        if (chrome[i] && chrome[i]->visible &&
+            box_occluder(&chrome[i]->box, chrome[i]->box.frame, &occluder)) {
+            region_subtract(&uncovered, occluder);
+        }
+    }
+    for (size_t i = d->window_count; i-- > 0;) {
+        rx_desktop_window* dw = d->windows[i];
+        rx_desktop_region* visible = &d->regions[i];
+        visible->count = 0;
+        if (!desktop_window_drawable(dw)) continue;
+        
+        rx_rect frame = desktop_window_frame(dw);
+        region_clip(visible, &uncovered, frame);
+        if (visible->count == 0) {
+            d->stats.windows_culled++;
+            continue;
+        }
+        /* Only the root's laid-out frame is painted, not the whole window */
+        const rx_box* root = &dw->window->root_view->box;
+        rx_rect painted = rect_intersect(rect(frame.x + root->frame.x, frame.y + root->frame.y,
+                                              root->frame.width, root->frame.height), frame);
+        if (box_occluder(root, painted, &occluder)) {
+            region_subtract(&uncovered, occluder);
+        }
+    }
     
-    /* Render desktop icons */
-    view_render(d->icons_container, context);
+    /* Back to front, each clipped to its visible part */
+    float screen_area = screen.width * screen.height;
+    d->stats.wallpaper_visible = screen_area > 0 ? region_area(&uncovered) / screen_area : 0;
+    if (uncovered.count > 0) {
+        void* surface = d->has_surfaces ?
+            desktop_surface(d, &d->wallpaper_surface, &d->wallpaper_valid, d->wallpaper, size(screen.width, screen.height)) :
+            NULL;
+        desktop_draw(d, surface, d->wallpaper, screen, &uncovered, context);
+        
+        /* Render desktop icons */
+        view_render(d->icons_container, context);
+    }
     
-    /* Render windows (sorted by z-order) */
     for (size_t i = 0; i < d->window_count; i++) {
-        if (d->windows[i]->visible && d->windows[i]->window) {
-            view_render(d->windows[i]->window->root_view, context);
+        if (d->regions[i].count == 0) continue;
+        rx_desktop_window* dw = d->windows[i];
+        rx_window* win = dw->window;
+        
+        /* Stale after a resize even if the layout pass left it valid */
+        if (dw->surface_size.width != win->size.width || dw->surface_size.height != win->size.height) {
+            dw->surface_valid = false;
         }
+        void* surface = NULL;
+        if (d->has_surfaces) {
+            surface = desktop_surface(d, &dw->surface, &dw->surface_valid, win->root_view, win->size);
+            dw->surface_size = win->size;
+        }
+        desktop_draw(d, surface, win->root_view, desktop_window_frame(dw), &d->regions[i], context);
+        d->stats.windows_drawn++;
     }
     
     /* Render dock */
-    if (d->dock && d->dock->visible) {
-        view_render(&d->dock->base, context);
+    if (chrome[2]) {
+        view_render(chrome[2], context);
     }
     
     /* Render taskbar */
-    if (d->taskbar) {
-        view_render(&d->taskbar->base, context);
+    if (chrome[1]) {
+        view_render(chrome[1], context);
     }
     
     /* Render menu bar */
-    if (d->menu_bar) {
-        view_render(&d->menu_bar->base, context);
+    if (chrome[0]) {
+        view_render(chrome[0], context);
     }
 }
 
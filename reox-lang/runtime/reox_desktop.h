@@ -1,9 +1,21 @@
-
+/*
  * REOX Desktop Environment
  * Window Manager, Taskbar, Dock for NeolyxOS
  * 
  * This provides the core desktop UI components that REOX apps
  * are displayed within.
+ * 
+ * Compositing:
+ * - Each window's tree is rendered into its own surface and kept there;
+ *   it is rendered again only after a relayout, a resize or
+ *   desktop_invalidate_window(), so moving, raising or tiling windows
+ *   of unchanged size only recomposites
+ * - Occlusion is worked out front to back: windows hidden behind opaque
+ *   windows and chrome are skipped, and the rest (and the wallpaper)
+ *   are drawn clipped to the parts that can be seen
+ * - Surfaces are made and drawn through an rx_desktop_surface_backend
+ *   supplied by the renderer; without one, visible windows are rendered
+ *   directly every frame and only fully covered ones are skipped
  */
 
 #ifndef REOX_DESKTOP_H
@@ -53,7 +65,12 @@ typedef struct rx_desktop_window {
     const char* icon_path;
     bool focused;
     bool visible;
-    int z_order;
+    int z_order;                /* Index in the desktop's stack, 0 = back */
+    
+    /* Cached rendering of window->root_view */
+    void* surface;
+    rx_size surface_size;       /* Window size it was rendered at */
+    bool surface_valid;
 } rx_desktop_window;
 
 /* Window chrome (title bar, buttons) */
@@ -177,6 +194,26 @@ extern void menu_bar_set_app(rx_menu_bar* bar, const char* name, const char* ico
 
 typedef void (*rx_window_callback)(rx_desktop_window* window, void* user_data);
 
+typedef struct rx_desktop_surface_backend {
+    /* Render view's subtree (view_render_content) into new surface storage
+     * of `size`, the view frame's origin at the top-left */
+    void* (*capture)(void* ctx, rx_view* view, rx_size size);
+    /* Draw surface with its top-left at frame's origin, only inside clip
+     * (screen space, within frame) */
+    void (*draw)(void* ctx, void* surface, rx_rect frame, rx_rect clip);
+    void (*release)(void* ctx, void* surface);
+    void* ctx;
+} rx_desktop_surface_backend;
+
+/* What the last desktop_render did */
+typedef struct rx_desktop_render_stats {
+    size_t captures;            /* Surfaces rendered from their trees */
+    size_t draws;               /* Clipped surface draws */
+    size_t windows_drawn;
+    size_t windows_culled;      /* Fully covered, skipped */
+    float wallpaper_visible;    /* Fraction of the screen */
+} rx_desktop_render_stats;
+
 typedef struct rx_desktop {
     /* Screen info */
     int screen_width;
@@ -192,7 +229,7 @@ typedef struct rx_desktop {
     rx_dock* dock;
     rx_menu_bar* menu_bar;
     
-    /* Windows */
+    /* Windows, back to front */
     rx_desktop_window** windows;
     size_t window_count;
     rx_desktop_window* focused_window;
@@ -204,6 +241,15 @@ typedef struct rx_desktop {
     bool show_desktop;          /* All windows minimized */
     int next_window_id;
     
+    /* Compositing */
+    rx_desktop_surface_backend surfaces;
+    bool has_surfaces;
+    void* wallpaper_surface;
+    bool wallpaper_valid;
+    rx_desktop_render_stats stats;
+    struct rx_desktop_region* regions;  /* Per-window scratch, reused */
+    size_t region_capacity;
+    
     /* Callbacks */
     rx_window_callback on_window_focus;
     rx_window_callback on_window_close;
@@ -222,6 +268,10 @@ extern void desktop_focus_window(rx_desktop* d, rx_desktop_window* window);
 extern void desktop_minimize_window(rx_desktop* d, rx_desktop_window* window);
 extern void desktop_maximize_window(rx_desktop* d, rx_desktop_window* window);
 extern void desktop_restore_window(rx_desktop* d, rx_desktop_window* window);
+/* Window drag: recomposites the cached surface, the tree is not rendered */
+extern void desktop_move_window(rx_desktop* d, rx_desktop_window* window, rx_point position);
+/* Content changed without a relayout: render the window's tree again */
+extern void desktop_invalidate_window(rx_desktop* d, rx_desktop_window* window);
 
 /* Desktop actions */
 extern void desktop_show_all(rx_desktop* d);
@@ -232,7 +282,8 @@ extern void desktop_tile_windows(rx_desktop* d, bool horizontal);
 extern void desktop_set_wallpaper(rx_desktop* d, const char* path);
 extern void desktop_set_wallpaper_color(rx_desktop* d, rx_color color);
 
-/* Rendering */
+/* Rendering. The backend is copied; existing surfaces are released. */
+extern void desktop_set_surface_backend(rx_desktop* d, const rx_desktop_surface_backend* backend);
 extern void desktop_layout(rx_desktop* d);
 extern void desktop_render(rx_desktop* d, void* context);
 extern void desktop_handle_event(rx_desktop* d, void* event);
@@ -6,6 +6,7 @@
  */
 
 #include "reox_ffi.h"
+#include "reox_runloop.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -14,47 +15,279 @@
  * FFI Function Registry
  * ============================================================================ */
 
-#define MAX_FFI_FUNCS 256
+enum {
+    FFI_VOID,
+    FFI_INT,        /* i b p s: integer registers */
+    FFI_BOOL,
+    FFI_FLOAT,      /* f d: floating-point registers */
+    FFI_DOUBLE
+};
+
+struct RxFFIEntry {
+    char* name;
+    void* func_ptr;
+    char* signature;
+    uint64_t hash;
+    bool typed;                     /* Signature parsed */
+    uint8_t argc;
+    uint8_t ret;
+    uint8_t args[RX_FFI_MAX_ARGS];
+};
 
+/* Open addressing over entry pointers; entries themselves never move, so
+ * handles stay valid as the table grows */
 static struct {
-    RxFFIFunc funcs[MAX_FFI_FUNCS];
+    struct RxFFIEntry** slots;
+    size_t capacity;                /* Power of two */
     size_t count;
 } g_ffi_registry = {0};
 
+static uint64_t ffi_hash(const char* s) {
+    uint64_t h = 14695981039346656037ull;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static int ffi_kind(char c) {
+    switch (c) {
+        case 'i': case 'p': case 's': return FFI_INT;
+        case 'b': return FFI_BOOL;
+        case 'f': return FFI_FLOAT;
+        case 'd': return FFI_DOUBLE;
+        case 'v': return FFI_VOID;
+        default:  return -1;
+    }
+}
+
+static bool ffi_parse(struct RxFFIEntry* e, const char* sig) {
+    const char* arrow = sig ? strstr(sig, "->") : NULL;
+    if (!arrow || arrow[2] == '\0' || arrow[3] != '\0') return false;
+    int ret = ffi_kind(arrow[2]);
+    if (ret < 0) return false;
+
+    size_t argc = 0;
+    int ints = 0, floats = 0;
+    for (const char* c = sig; c < arrow; c++) {
+        int kind = ffi_kind(*c);
+        if (kind < 0) return false;
+        if (kind == FFI_VOID) {
+            if (arrow - sig != 1) return false;   /* "v->i" only */
+            continue;
+        }
+        if (kind == FFI_FLOAT || kind == FFI_DOUBLE) floats++;
+        else ints++;
+        /* Check before writing: args[] only holds RX_FFI_MAX_ARGS */
+        if (argc >= RX_FFI_MAX_ARGS || ints > RX_FFI_MAX_INT_ARGS ||
+            floats > RX_FFI_MAX_FLOAT_ARGS) return false;
+        e->args[argc++] = (uint8_t)kind;
+    }
+    e->argc = (uint8_t)argc;
+    e->ret = (uint8_t)ret;
+    return true;
+}
+
+static struct RxFFIEntry** ffi_slot(const char* name, uint64_t hash) {
+    size_t mask = g_ffi_registry.capacity - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        struct RxFFIEntry** slot = &g_ffi_registry.slots[i];
+        if (!*slot || ((*slot)->hash == hash && strcmp((*slot)->name, name) == 0)) return slot;
+    }
+}
+
+static bool ffi_grow(void) {
+    size_t capacity = g_ffi_registry.capacity ? g_ffi_registry.capacity * 2 : 64;
+    struct RxFFIEntry** old = g_ffi_registry.slots;
+    size_t old_capacity = g_ffi_registry.capacity;
+    struct RxFFIEntry** slots = (struct RxFFIEntry**)calloc(capacity, sizeof(*slots));
+    if (!slots) return false;
+
+    g_ffi_registry.slots = slots;
+    g_ffi_registry.capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i]) *ffi_slot(old[i]->name, old[i]->hash) = old[i];
+    }
+    free(old);
+    return true;
+}
+
+static void ffi_add(const RxFFIFunc* func) {
+    if (!func->name) return;
+    if ((g_ffi_registry.count + 1) * 4 > g_ffi_registry.capacity * 3 && !ffi_grow()) return;
+
+    uint64_t hash = ffi_hash(func->name);
+    struct RxFFIEntry** slot = ffi_slot(func->name, hash);
+    struct RxFFIEntry* e = *slot;
+    if (!e) {
+        e = (struct RxFFIEntry*)calloc(1, sizeof(*e));
+        if (!e) return;
+        e->name = rx_strdup(func->name);
+        if (!e->name) {
+            free(e);
+            return;
+        }
+        e->hash = hash;
+        *slot = e;
+        g_ffi_registry.count++;
+    }
+    free(e->signature);
+    e->signature = rx_strdup(func->signature);
+    e->func_ptr = func->func_ptr;
+    e->typed = ffi_parse(e, func->signature);
+}
+
 void rx_ffi_register(const RxFFIFunc* funcs, size_t count) {
-    for (size_t i = 0; i < count && g_ffi_registry.count < MAX_FFI_FUNCS; i++) {
-        g_ffi_registry.funcs[g_ffi_registry.count++] = funcs[i];
+    for (size_t i = 0; funcs && i < count; i++) {
+        ffi_add(&funcs[i]);
+    }
+}
+
+RxFFIHandle rx_ffi_resolve(const char* name) {
+    if (!name || g_ffi_registry.count == 0) return NULL;
+    return *ffi_slot(name, ffi_hash(name));
+}
+
+/* ============================================================================
+ * FFI Dispatch
+ * ============================================================================ */
+
+#if (defined(__x86_64__) && !defined(_WIN32)) || defined(__aarch64__)
+#define FFI_REGISTER_CLASSES 1
+#endif
+
+#ifdef FFI_REGISTER_CLASSES
+/*
+ * Both ABIs assign integer and floating-point arguments to separate
+ * register files in order, and a callee ignores registers past its own
+ * parameters. So one call that loads every argument register reaches any
+ * function within the limits. A float travels in the low half of its
+ * register, as does a float return.
+ */
+typedef uint64_t (*ffi_int_fn)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+                               double, double, double, double, double, double, double, double);
+typedef double (*ffi_float_fn)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+                               double, double, double, double, double, double, double, double);
+
+static double ffi_float_bits(float f) {
+    union { double d; uint64_t u; } out = { 0 };
+    union { float f; uint32_t u; } in = { f };
+    out.u = in.u;
+    return out.d;
+}
+
+static float ffi_bits_float(double d) {
+    union { double d; uint64_t u; } in = { d };
+    union { float f; uint32_t u; } out;
+    out.u = (uint32_t)in.u;
+    return out.f;
+}
+
+static void ffi_dispatch(const struct RxFFIEntry* e, const uint64_t* ints, const double* floats,
+                         RxFFIValue* ret) {
+    const uint64_t* g = ints;
+    const double* x = floats;
+    RxFFIValue r;
+    r.i = 0;
+    if (e->ret == FFI_FLOAT || e->ret == FFI_DOUBLE) {
+        double d = ((ffi_float_fn)e->func_ptr)(g[0], g[1], g[2], g[3], g[4], g[5],
+                                               x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]);
+        if (e->ret == FFI_FLOAT) r.f = ffi_bits_float(d);
+        else r.d = d;
+    } else {
+        uint64_t v = ((ffi_int_fn)e->func_ptr)(g[0], g[1], g[2], g[3], g[4], g[5],
+                                               x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]);
+        if (e->ret == FFI_BOOL) r.b = (v & 0xFF) != 0;
+        else if (e->ret == FFI_INT) r.i = (int64_t)v;
+    }
+    if (ret) *ret = r;
+}
+#else
+typedef uint64_t (*ffi_int_fn)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+
+static void ffi_dispatch(const struct RxFFIEntry* e, const uint64_t* g, const double* floats,
+                         RxFFIValue* ret) {
+    (void)floats;
+    uint64_t v = ((ffi_int_fn)e->func_ptr)(g[0], g[1], g[2], g[3], g[4], g[5]);
+    if (ret) {
+        ret->i = 0;
+        if (e->ret == FFI_BOOL) ret->b = (v & 0xFF) != 0;
+        else if (e->ret == FFI_INT) ret->i = (int64_t)v;
+    }
+}
+#endif
+
+static bool ffi_callable(const struct RxFFIEntry* e) {
+#ifndef FFI_REGISTER_CLASSES
+    if (e->ret == FFI_FLOAT || e->ret == FFI_DOUBLE) return false;
+    for (size_t i = 0; i < e->argc; i++) {
+        if (e->args[i] == FFI_FLOAT || e->args[i] == FFI_DOUBLE) return false;
     }
+#endif
+    return e->typed && e->func_ptr;
 }
 
-static RxFFIFunc* rx_ffi_find(const char* name) {
-    for (size_t i = 0; i < g_ffi_registry.count; i++) {
-        if (strcmp(g_ffi_registry.funcs[i].name, name) == 0) {
-            return &g_ffi_registry.funcs[i];
+bool rx_ffi_invoke(RxFFIHandle fn, const RxFFIValue* args, size_t argc, RxFFIValue* ret) {
+    if (!fn || !ffi_callable(fn) || argc != fn->argc || (argc && !args)) return false;
+
+    uint64_t ints[RX_FFI_MAX_INT_ARGS] = {0};
+    double floats[RX_FFI_MAX_FLOAT_ARGS] = {0};
+    size_t gi = 0, fi = 0;
+    for (size_t i = 0; i < argc; i++) {
+        switch (fn->args[i]) {
+            case FFI_INT:    ints[gi++] = (uint64_t)args[i].i; break;
+            case FFI_BOOL:   ints[gi++] = args[i].b ? 1 : 0; break;
+#ifdef FFI_REGISTER_CLASSES
+            case FFI_FLOAT:  floats[fi++] = ffi_float_bits(args[i].f); break;
+#endif
+            case FFI_DOUBLE: floats[fi++] = args[i].d; break;
+            default: break;
         }
     }
-    return NULL;
+    ffi_dispatch(fn, ints, floats, ret);
+    return true;
 }
 
-int64_t rx_ffi_call(const char* name, int64_t* args, size_t argc) {
-    RxFFIFunc* f = rx_ffi_find(name);
-    if (!f || !f->func_ptr) return 0;
-    
-    /* Call based on signature */
-    typedef int64_t (*fn0)(void);
-    typedef int64_t (*fn1)(int64_t);
-    typedef int64_t (*fn2)(int64_t,int64_t);
-    typedef int64_t (*fn3)(int64_t,int64_t,int64_t);
-    typedef int64_t (*fn4)(int64_t,int64_t,int64_t,int64_t);
-    
-    switch (argc) {
-        case 0: return ((fn0)f->func_ptr)();
-        case 1: return ((fn1)f->func_ptr)(args[0]);
-        case 2: return ((fn2)f->func_ptr)(args[0], args[1]);
-        case 3: return ((fn3)f->func_ptr)(args[0], args[1], args[2]);
-        case 4: return ((fn4)f->func_ptr)(args[0], args[1], args[2], args[3]);
-        default: return 0;
+int64_t rx_ffi_call_handle(RxFFIHandle fn, int64_t* args, size_t argc) {
+    if (!fn || !fn->func_ptr || argc > RX_FFI_MAX_ARGS || (argc && !args)) return 0;
+
+    /* No usable signature: every argument is an int64, as before */
+    if (!fn->typed) {
+        if (argc > RX_FFI_MAX_INT_ARGS) return 0;
+        struct RxFFIEntry untyped = *fn;
+        untyped.argc = (uint8_t)argc;
+        untyped.ret = FFI_INT;
+        uint64_t ints[RX_FFI_MAX_INT_ARGS] = {0};
+        double floats[RX_FFI_MAX_FLOAT_ARGS] = {0};
+        for (size_t i = 0; i < argc; i++) ints[i] = (uint64_t)args[i];
+        RxFFIValue ret;
+        ffi_dispatch(&untyped, ints, floats, &ret);
+        return ret.i;
     }
+
+    RxFFIValue values[RX_FFI_MAX_ARGS];
+    for (size_t i = 0; i < argc && i < fn->argc; i++) {
+        switch (fn->args[i]) {
+            case FFI_FLOAT:  values[i].f = (float)args[i]; break;
+            case FFI_DOUBLE: values[i].d = (double)args[i]; break;
+            case FFI_BOOL:   values[i].b = args[i] != 0; break;
+            default:         values[i].i = args[i]; break;
+        }
+    }
+    RxFFIValue ret;
+    if (!rx_ffi_invoke(fn, values, argc, &ret)) return 0;
+    switch (fn->ret) {
+        case FFI_FLOAT:  return (int64_t)ret.f;
+        case FFI_DOUBLE: return (int64_t)ret.d;
+        case FFI_BOOL:   return ret.b;
+        case FFI_INT:    return ret.i;
+        default:         return 0;
+    }
+}
+
+int64_t rx_ffi_call(const char* name, int64_t* args, size_t argc) {
+    return rx_ffi_call_handle(rx_ffi_resolve(name), args, argc);
 }
 
 /* ============================================================================
@@ -131,31 +364,80 @@ void rx_app_set_root(RxApp* app, RxViewRef root) {
     if (app) app->root = root;
 }
 
+/* Poll-only backends: cap the sleep so input is still picked up promptly */
+#define RX_APP_POLL_INTERVAL_MS 8
+
+static bool app_wait_events(void* ctx, int timeout_ms) {
+    RxApp* app = (RxApp*)ctx;
+    RxBackend* b = app->backend;
+    if (!app->running) return false;
+
+    if (b->wait_events) {
+        if (!b->wait_events(timeout_ms)) app->running = false;
+        return app->running;
+    }
+
+    if (b->poll_events && !b->poll_events()) {
+        app->running = false;
+        return false;
+    }
+    if (timeout_ms < 0 || timeout_ms > RX_APP_POLL_INTERVAL_MS) timeout_ms = RX_APP_POLL_INTERVAL_MS;
+    if (timeout_ms > 0) rx_clock_sleep_ns((uint64_t)timeout_ms * 1000000ull);
+    return app->running;
+}
+
+static void app_frame(void* ctx, float dt) {
+    RxApp* app = (RxApp*)ctx;
+    RxBackend* b = app->backend;
+    (void)dt;
+
+    if (b->begin_frame) b->begin_frame();
+
+    /* Render root view tree */
+    /* TODO: Hook into actual view rendering */
+
+    if (b->end_frame) b->end_frame();
+}
+
+static float app_refresh_rate(void* ctx) {
+    RxApp* app = (RxApp*)ctx;
+    return app->backend->refresh_rate ? app->backend->refresh_rate() : 0.0f;
+}
+
+static void app_wake(void* ctx) {
+    RxApp* app = (RxApp*)ctx;
+    if (app->backend->wake) app->backend->wake();
+}
+
 int rx_app_run(RxApp* app) {
     if (!app || !app->backend) return -1;
     
     app->running = true;
     RxBackend* b = app->backend;
     
-    while (app->running) {
-        if (b->poll_events && !b->poll_events()) {
-            app->running = false;
-            break;
-        }
-        
-        if (b->begin_frame) b->begin_frame();
-        
-        /* Render root view tree */
-        /* TODO: Hook into actual view rendering */
-        
-        if (b->end_frame) b->end_frame();
-    }
+    /* Frames are drawn only when something changed or is animating; in
+     * between the loop blocks in the backend until input or a timer */
+    rx_runloop* loop = rx_runloop_main();
+    rx_runloop_hooks hooks = {
+        .wait_events = app_wait_events,
+        .frame = app_frame,
+        .refresh_rate = app_refresh_rate,
+        .wake = app_wake,
+        .ctx = app
+    };
+    rx_runloop_config config = { .max_fps = 0, .vsync = b->vsync };
+    rx_runloop_configure(loop, &hooks, &config);
+    rx_runloop_request_frame(loop);
+    rx_runloop_run(loop);
     
+    app->running = false;
     return 0;
 }
 
 void rx_app_quit(RxApp* app) {
-    if (app) app->running = false;
+    if (!app) return;
+    app->running = false;
+    rx_runloop_stop(rx_runloop_main());
 }
 
 void rx_app_destroy(RxApp* app) {
@@ -173,17 +455,7 @@ void rx_app_destroy(RxApp* app) {
  * Memory Helpers
  * ============================================================================ */
 
-void* rx_alloc(size_t size) {
-    return calloc(1, size);
-}
-
-void* rx_realloc(void* ptr, size_t size) {
-    return realloc(ptr, size);
-}
-
-void rx_free(void* ptr) {
-    free(ptr);
-}
+/* rx_alloc, rx_realloc and rx_free are defined in reox_runtime.c */
 
 char* rx_strdup(const char* s) {
     if (!s) return NULL;
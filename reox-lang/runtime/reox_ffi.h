@@ -56,6 +56,14 @@ typedef struct RxBackend {
     void (*end_frame)(void);
     bool (*poll_events)(void);
     
+    /* Pacing (optional). wait_events blocks up to timeout_ms (-1: until an
+     * event) and handles what arrived; false to quit. Without it the app
+     * polls and sleeps between frames. */
+    bool (*wait_events)(int timeout_ms);
+    float (*refresh_rate)(void);    /* Hz, 0 if unknown */
+    void (*wake)(void);             /* Any thread: end a blocked wait_events */
+    bool vsync;                     /* end_frame blocks on vblank */
+    
     /* Drawing primitives */
     void (*draw_rect)(RxRect rect, RxColor color, float radius);
     void (*draw_circle)(RxPoint center, float radius, RxColor color);
@@ -68,6 +76,12 @@ typedef struct RxBackend {
     void (*push_opacity)(float alpha);
     void (*pop_opacity)(void);
     
+    /* Blur (optional). blur_backdrop blurs what is already drawn inside
+     * rect (rounded by corner_radius); draw_glow draws a blurred halo of
+     * rect's shape. Radius is the visible blur extent. */
+    void (*blur_backdrop)(RxRect rect, float radius, float corner_radius);
+    void (*draw_glow)(RxRect rect, RxColor color, float radius, float intensity, float corner_radius);
+    
     /* Input state */
     RxPoint (*get_mouse_pos)(void);
     bool (*is_mouse_down)(int button);
@@ -81,19 +95,70 @@ typedef struct RxBackend {
  * FFI Registration - Connect C functions to REOX
  * ============================================================================ */
 
-/* Register a C function callable from REOX */
+/*
+ * Register a C function callable from REOX.
+ * Signature letters: i int64, b bool, p pointer, s string, f float,
+ * d double, v void (return only). Arguments, "->", return:
+ * "ii->i" = int64 (int64, int64), "sd->v" = void (const char*, double).
+ */
 typedef struct RxFFIFunc {
     const char* name;
     void* func_ptr;
     const char* signature;  /* e.g., "ii->v" = (int,int)->void */
 } RxFFIFunc;
 
-/* Register multiple FFI functions */
+/* Register multiple FFI functions. Names and signatures are copied; a name
+ * registered again replaces the earlier function in place. */
 void rx_ffi_register(const RxFFIFunc* funcs, size_t count);
 
-/* Call an FFI function by name */
+/* Call an FFI function by name; args are int64, and float/double
+ * parameters receive them converted */
 int64_t rx_ffi_call(const char* name, int64_t* args, size_t argc);
 
+/* ============================================================================
+ * Resolved Calls - Look up once, call many times
+ * ============================================================================ */
+
+/*
+ * Typed calls put integer-class arguments (i b p s) and floating-point
+ * arguments (f d) in their own registers, so any mix works up to
+ * RX_FFI_MAX_INT_ARGS of the first kind and RX_FFI_MAX_FLOAT_ARGS of the
+ * second on x86-64 System V and AArch64. Elsewhere only integer-class
+ * signatures of up to RX_FFI_MAX_INT_ARGS arguments can be called.
+ */
+#define RX_FFI_MAX_INT_ARGS   6
+#define RX_FFI_MAX_FLOAT_ARGS 8
+#define RX_FFI_MAX_ARGS       (RX_FFI_MAX_INT_ARGS + RX_FFI_MAX_FLOAT_ARGS)
+
+typedef union RxFFIValue {
+    int64_t i;
+    bool b;
+    void* p;
+    const char* s;
+    float f;
+    double d;
+} RxFFIValue;
+
+/* Registry entry; stays valid for the program's lifetime */
+typedef struct RxFFIEntry* RxFFIHandle;
+
+/* NULL if no function has that name */
+RxFFIHandle rx_ffi_resolve(const char* name);
+
+/* Call with one value per signature argument; ret may be NULL. False if
+ * argc does not match or the signature cannot be called here. */
+bool rx_ffi_invoke(RxFFIHandle fn, const RxFFIValue* args, size_t argc, RxFFIValue* ret);
+
+/* rx_ffi_call without the lookup */
+int64_t rx_ffi_call_handle(RxFFIHandle fn, int64_t* args, size_t argc);
+
+/* Resolve on first use and keep the handle in *slot (a static at the call
+ * site): `static RxFFIHandle h; rx_ffi_invoke(rx_ffi_cached(&h, "f"), ...)` */
+static inline RxFFIHandle rx_ffi_cached(RxFFIHandle* slot, const char* name) {
+    if (!*slot) *slot = rx_ffi_resolve(name);
+    return *slot;
+}
+
 /* ============================================================================
  * View Export - Get REOX views as C data
  * ============================================================================ */
@@ -215,7 +280,7 @@ void rx_app_destroy(RxApp* app);
  * Memory Helpers
  * ============================================================================ */
 
-/* Allocate memory that can be freed by REOX */
+/* Allocate zeroed memory that can be freed by REOX */
 void* rx_alloc(size_t size);
 void* rx_realloc(void* ptr, size_t size);
 void  rx_free(void* ptr);
@@ -0,0 +1,162 @@
+/*
+ * REOX Frame Stats - Implementation
+ * Frame ring, summaries and text formatting
+ */
+
+#include "reox_frame_stats.h"
+#include <stdio.h>
+#include <string.h>
+
+rx_frame_stats_live rx_frame_live;
+RX_FRAME_THREAD_LOCAL bool rx_frame_ui_thread;
+
+static rx_frame_record frame_ring[RX_FRAME_HISTORY];
+static uint64_t frame_head;             /* Frames ever finished */
+static uint64_t frame_seq;
+
+static rx_frame_hook frame_hooks[RX_FRAME_HOOKS_MAX];
+static int frame_hook_count;
+
+static const char* const phase_names[RX_PHASE_COUNT] = {
+    "state diff", "effects", "layout", "render", "animation", "particles", "present",
+};
+
+static const char* const counter_names[RX_COUNTER_COUNT] = {
+    "nodes laid out", "draw calls", "allocations",
+};
+
+/* ============================================================================
+ * Recording
+ * ============================================================================ */
+
+void rx_frame_stats_begin(void) {
+    rx_frame_ui_thread = true;
+    if (!rx_frame_live.enabled) return;
+    if (rx_frame_live.frame_depth++ > 0) return;
+    memset(&rx_frame_live.current, 0, sizeof(rx_frame_record));
+    rx_frame_live.current.frame = frame_seq++;
+    rx_frame_live.current.start_ns = rx_frame_stats_now();
+}
+
+void rx_frame_stats_end(void) {
+    if (!rx_frame_live.enabled || rx_frame_live.frame_depth == 0) return;
+    if (--rx_frame_live.frame_depth > 0) return;
+    rx_frame_record* cur = &rx_frame_live.current;
+    cur->total_ns = rx_frame_stats_now() - cur->start_ns;
+    frame_ring[frame_head++ & (RX_FRAME_HISTORY - 1)] = *cur;
+}
+
+/* ============================================================================
+ * Frame Hooks
+ * ============================================================================ */
+
+bool rx_frame_add_hook(rx_frame_hook hook) {
+    for (int i = 0; i < frame_hook_count; i++) {
+        if (frame_hooks[i] == hook) return true;
+    }
+    if (!hook || frame_hook_count == RX_FRAME_HOOKS_MAX) return false;
+    frame_hooks[frame_hook_count++] = hook;
+    return true;
+}
+
+void rx_frame_run_hooks(void) {
+    for (int i = 0; i < frame_hook_count; i++) frame_hooks[i]();
+}
+
+/* ============================================================================
+ * Control
+ * ============================================================================ */
+
+void rx_frame_stats_enable(bool enabled) {
+    rx_frame_ui_thread = true;
+    if (enabled == rx_frame_live.enabled) return;
+    /* Zones open across the switch would otherwise never close */
+    memset(rx_frame_live.zone_depth, 0, sizeof(rx_frame_live.zone_depth));
+    rx_frame_live.frame_depth = 0;
+    rx_frame_live.enabled = enabled;
+}
+
+bool rx_frame_stats_enabled(void) {
+    return rx_frame_live.enabled;
+}
+
+void rx_frame_stats_set_overlay(bool visible) {
+    rx_frame_live.overlay = visible;
+}
+
+void rx_frame_stats_clear(void) {
+    frame_head = 0;
+}
+
+/* ============================================================================
+ * Queries
+ * ============================================================================ */
+
+uint32_t rx_frame_stats_count(void) {
+    return frame_head < RX_FRAME_HISTORY ? (uint32_t)frame_head : RX_FRAME_HISTORY;
+}
+
+bool rx_frame_stats_get(uint32_t ago, rx_frame_record* out) {
+    if (ago >= rx_frame_stats_count()) return false;
+    *out = frame_ring[(frame_head - 1 - ago) & (RX_FRAME_HISTORY - 1)];
+    return true;
+}
+
+uint32_t rx_frame_stats_summary(uint32_t frames, rx_frame_record* mean, rx_frame_record* worst) {
+    uint32_t n = rx_frame_stats_count();
+    if (frames < n) n = frames;
+
+    rx_frame_record sum = {0}, max = {0};
+    for (uint32_t i = 0; i < n; i++) {
+        const rx_frame_record* r = &frame_ring[(frame_head - 1 - i) & (RX_FRAME_HISTORY - 1)];
+        sum.total_ns += r->total_ns;
+        if (r->total_ns > max.total_ns) max.total_ns = r->total_ns;
+        for (int p = 0; p < RX_PHASE_COUNT; p++) {
+            sum.phase_ns[p] += r->phase_ns[p];
+            if (r->phase_ns[p] > max.phase_ns[p]) max.phase_ns[p] = r->phase_ns[p];
+        }
+        for (int c = 0; c < RX_COUNTER_COUNT; c++) {
+            sum.counters[c] += r->counters[c];
+            if (r->counters[c] > max.counters[c]) max.counters[c] = r->counters[c];
+        }
+    }
+
+    if (n > 0) {
+        sum.total_ns /= n;
+        for (int p = 0; p < RX_PHASE_COUNT; p++) sum.phase_ns[p] /= n;
+        for (int c = 0; c < RX_COUNTER_COUNT; c++) sum.counters[c] /= n;
+        sum.frame = max.frame = frame_ring[(frame_head - 1) & (RX_FRAME_HISTORY - 1)].frame;
+    }
+    if (mean) *mean = sum;
+    if (worst) *worst = max;
+    return n;
+}
+
+const char* rx_frame_phase_name(rx_frame_phase phase) {
+    return (unsigned)phase < RX_PHASE_COUNT ? phase_names[phase] : "?";
+}
+
+const char* rx_frame_counter_name(rx_frame_counter counter) {
+    return (unsigned)counter < RX_COUNTER_COUNT ? counter_names[counter] : "?";
+}
+
+size_t rx_frame_stats_format(const rx_frame_record* record, char* buf, size_t size) {
+    size_t len = 0;
+#define FS_APPEND(...) do {                                                     \
+        int w = snprintf(buf + (len < size ? len : size),                       \
+                         len < size ? size - len : 0, __VA_ARGS__);             \
+        if (w > 0) len += (size_t)w;                                            \
+    } while (0)
+
+    FS_APPEND("frame %llu: %.2f ms\n", (unsigned long long)record->frame,
+              (double)record->total_ns * 1e-6);
+    for (int p = 0; p < RX_PHASE_COUNT; p++) {
+        FS_APPEND("  %-12s %8.3f ms\n", phase_names[p], (double)record->phase_ns[p] * 1e-6);
+    }
+    for (int c = 0; c < RX_COUNTER_COUNT; c++) {
+        FS_APPEND("  %-14s %6llu\n", counter_names[c], (unsigned long long)record->counters[c]);
+    }
+
+#undef FS_APPEND
+    return len;
+}
@@ -0,0 +1,187 @@
+/*
+ * REOX Frame Stats
+ * Where each frame's time went: per-phase timings and counters
+ *
+ * Features:
+ * - Zones around the frame phases (state diffing, effects, layout, render
+ *   traversal, animation, particles, present); nested zones of one phase
+ *   are timed once
+ * - Per-frame counters for nodes laid out, draw commands and allocations
+ * - Ring of the last RX_FRAME_HISTORY frames with mean/worst summaries
+ * - Text formatting for logs, and an overlay drawn by the NXRender bridge
+ *
+ * Recording is off until rx_frame_stats_enable(true); while off a zone
+ * costs one load and branch. With RX_FRAME_STATS=0 zones and counters
+ * compile to nothing. Records belong to the UI thread, the one that calls
+ * rx_frame_stats_enable or begins frames; zones and counters reached on
+ * other threads (screens built off the UI thread) are not recorded.
+ */
+
+#ifndef REOX_FRAME_STATS_H
+#define REOX_FRAME_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RX_FRAME_STATS
+#define RX_FRAME_STATS 1
+#endif
+
+#define RX_FRAME_HISTORY 256            /* Power of two */
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+typedef enum {
+    RX_PHASE_STATE_DIFF,                /* rx_collect_diffs */
+    RX_PHASE_EFFECTS,                   /* rx_run_effects */
+    RX_PHASE_LAYOUT,                    /* view_layout, bridge layout */
+    RX_PHASE_RENDER,                    /* Render traversal */
+    RX_PHASE_ANIMATION,                 /* rx_animator_update */
+    RX_PHASE_PARTICLES,                 /* rx_particles_update */
+    RX_PHASE_PRESENT,                   /* Draw submit and nx_gpu_present */
+    RX_PHASE_COUNT
+} rx_frame_phase;
+
+typedef enum {
+    RX_COUNTER_NODES_LAID_OUT,
+    RX_COUNTER_DRAW_CALLS,              /* Commands submitted to the GPU */
+    RX_COUNTER_ALLOCATIONS,             /* rx_alloc/rx_calloc/rx_realloc */
+    RX_COUNTER_COUNT
+} rx_frame_counter;
+
+typedef struct rx_frame_record {
+    uint64_t frame;                     /* Sequence number */
+    uint64_t start_ns;                  /* CLOCK_MONOTONIC */
+    uint64_t total_ns;
+    uint64_t phase_ns[RX_PHASE_COUNT];  /* Outermost zones only */
+    uint64_t counters[RX_COUNTER_COUNT];
+} rx_frame_record;
+
+/* Recording state, shared by the inline zone functions */
+typedef struct rx_frame_stats_live {
+    bool enabled;
+    bool overlay;
+    uint32_t frame_depth;               /* Nested frame begins */
+    uint32_t zone_depth[RX_PHASE_COUNT];
+    uint64_t zone_start[RX_PHASE_COUNT];
+    rx_frame_record current;
+} rx_frame_stats_live;
+
+extern rx_frame_stats_live rx_frame_live;
+
+#ifdef __cplusplus
+#define RX_FRAME_THREAD_LOCAL thread_local
+#else
+#define RX_FRAME_THREAD_LOCAL _Thread_local
+#endif
+
+/* Set on the thread that records */
+extern RX_FRAME_THREAD_LOCAL bool rx_frame_ui_thread;
+
+/* ============================================================================
+ * Recording
+ * ============================================================================ */
+
+static inline uint64_t rx_frame_stats_now(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    /* Strict C11 hides POSIX clocks; fall back to the standard one */
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Zones nest: a phase reached again from inside itself counts once */
+static inline void rx_zone_begin(rx_frame_phase phase) {
+    if (!rx_frame_live.enabled || !rx_frame_ui_thread) return;
+    if (rx_frame_live.zone_depth[phase]++ == 0) {
+        rx_frame_live.zone_start[phase] = rx_frame_stats_now();
+    }
+}
+
+static inline void rx_zone_end(rx_frame_phase phase) {
+    if (!rx_frame_live.enabled || !rx_frame_ui_thread || rx_frame_live.zone_depth[phase] == 0) return;
+    if (--rx_frame_live.zone_depth[phase] == 0) {
+        rx_frame_live.current.phase_ns[phase] +=
+            rx_frame_stats_now() - rx_frame_live.zone_start[phase];
+    }
+}
+
+static inline void rx_frame_count(rx_frame_counter counter, uint64_t n) {
+    if (rx_frame_live.enabled && rx_frame_ui_thread) rx_frame_live.current.counters[counter] += n;
+}
+
+/* Start and finish a frame record. Nested calls join the outer frame, so
+ * the run loop and the bridge can both bracket their work. */
+extern void rx_frame_stats_begin(void);
+extern void rx_frame_stats_end(void);
+
+#if RX_FRAME_STATS
+#define RX_ZONE_BEGIN(phase)        rx_zone_begin(phase)
+#define RX_ZONE_END(phase)          rx_zone_end(phase)
+#define RX_FRAME_COUNT(counter, n)  rx_frame_count(counter, n)
+#define RX_FRAME_BEGIN()            rx_frame_stats_begin()
+#define RX_FRAME_END()              rx_frame_stats_end()
+#else
+#define RX_ZONE_BEGIN(phase)        ((void)0)
+#define RX_ZONE_END(phase)          ((void)0)
+#define RX_FRAME_COUNT(counter, n)  ((void)0)
+#define RX_FRAME_BEGIN()            ((void)0)
+#define RX_FRAME_END()              ((void)0)
+#endif
+
+/*
+ * Work run at the start of every rx_frame, before layout. Modules register
+ * their own (reox_state.h built with RX_STATE_FRAME=1 applies posted updates
+ * this way), so the bridge needs no knowledge of them and header order does
+ * not matter. Register on the UI thread; adding a hook twice keeps one.
+ */
+#define RX_FRAME_HOOKS_MAX 8
+typedef void (*rx_frame_hook)(void);
+extern bool rx_frame_add_hook(rx_frame_hook hook);
+extern void rx_frame_run_hooks(void);
+
+/* ============================================================================
+ * Control and Queries
+ * ============================================================================ */
+
+extern void rx_frame_stats_enable(bool enabled);
+extern bool rx_frame_stats_enabled(void);
+
+/* Ask the NXRender bridge to draw the stats over the UI */
+extern void rx_frame_stats_set_overlay(bool visible);
+
+/* Drop recorded frames */
+extern void rx_frame_stats_clear(void);
+
+/* Frames held in the ring (at most RX_FRAME_HISTORY) */
+extern uint32_t rx_frame_stats_count(void);
+
+/* A finished frame: 0 is the most recent. False if there is none. */
+extern bool rx_frame_stats_get(uint32_t ago, rx_frame_record* out);
+
+/* Mean and worst of the last `frames` frames; returns how many were used */
+extern uint32_t rx_frame_stats_summary(uint32_t frames, rx_frame_record* mean, rx_frame_record* worst);
+
+extern const char* rx_frame_phase_name(rx_frame_phase phase);
+extern const char* rx_frame_counter_name(rx_frame_counter counter);
+
+/* One line of text per phase and counter for a record; returns the
+ * length that fit (snprintf rules) */
+extern size_t rx_frame_stats_format(const rx_frame_record* record, char* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_FRAME_STATS_H */
@@ -0,0 +1,1471 @@
+/*
+ * REOX Gesture Recognition - Implementation
+ * Per-frame touch delivery to the recognizers under each touch
+ */
+
+#include "reox_gestures.h"
+#include "reox_runloop.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define GESTURE_PI 3.14159265358979f
+
+/* Movement before a continuous gesture begins */
+#define PINCH_BEGIN_SCALE 0.05f
+#define ROTATION_BEGIN_ANGLE 0.1f
+
+typedef enum gesture_phase {
+    PHASE_BEGAN,
+    PHASE_MOVED,
+    PHASE_ENDED,
+    PHASE_CANCELLED,
+    PHASE_TICK,
+} gesture_phase;
+
+static inline float clampf(float v, float lo, float hi) {
+    if (v > hi) v = hi;
+    if (v < lo) v = lo;
+    return v;
+}
+
+static inline float point_distance(rx_point a, rx_point b) {
+    return hypotf(a.x - b.x, a.y - b.y);
+}
+
+static bool grow_array(void** array, size_t* capacity, size_t need, size_t elem) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    void* grown = realloc(*array, cap * elem);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = cap;
+    return true;
+}
+
+/* ============================================================================
+ * Touch History
+ * ============================================================================ */
+
+static void history_push(rx_touch_history* h, rx_point position, float timestamp) {
+    h->samples[h->head] = (rx_touch_sample){ position, timestamp };
+    h->head = (h->head + 1) % RX_GESTURE_HISTORY;
+    if (h->count < RX_GESTURE_HISTORY) h->count++;
+    if (h->fresh < RX_GESTURE_HISTORY) h->fresh++;
+}
+
+/* i-th most recent sample, 0 is the latest */
+static inline const rx_touch_sample* history_at(const rx_touch_history* h, uint32_t i) {
+    return &h->samples[(h->head + RX_GESTURE_HISTORY - 1 - i) % RX_GESTURE_HISTORY];
+}
+
+rx_point rx_touch_history_velocity(const rx_touch_history* history) {
+    if (!history || history->count < 2) return point(0, 0);
+
+    /* Fit x(t) and y(t) with lines, relative to the latest sample so the
+     * sums stay small */
+    const rx_touch_sample* last = history_at(history, 0);
+    float st = 0, sx = 0, sy = 0, stt = 0, stx = 0, sty = 0;
+    int n = 0;
+    for (uint32_t i = 0; i < history->count; i++) {
+        const rx_touch_sample* s = history_at(history, i);
+        float t = s->timestamp - last->timestamp;
+        if (t < -RX_GESTURE_VELOCITY_WINDOW) break;
+        float x = s->position.x - last->position.x;
+        float y = s->position.y - last->position.y;
+        st += t;
+        sx += x;
+        sy += y;
+        stt += t * t;
+        stx += t * x;
+        sty += t * y;
+        n++;
+    }
+    float den = n * stt - st * st;
+    if (n < 2 || den <= 1e-12f) return point(0, 0);
+    return point((n * stx - st * sx) / den, (n * sty - st * sy) / den);
+}
+
+/* ============================================================================
+ * Haptic Feedback
+ * ============================================================================ */
+
+static rx_haptic_driver haptic_driver;
+static void* haptic_ctx;
+
+void rx_haptic_set_driver(rx_haptic_driver driver, void* ctx) {
+    haptic_driver = driver;
+    haptic_ctx = ctx;
+}
+
+static void haptic_play(float intensity, float duration) {
+    if (!haptic_driver || intensity <= 0) return;
+    haptic_driver(clampf(intensity, 0, 1), duration, haptic_ctx);
+}
+
+void rx_haptic_generate(rx_haptic_type type) {
+    switch (type) {
+        case RX_HAPTIC_SELECTION:     haptic_play(0.3f, 0.01f); break;
+        case RX_HAPTIC_IMPACT_LIGHT:  haptic_play(0.4f, 0.015f); break;
+        case RX_HAPTIC_IMPACT_MEDIUM: haptic_play(0.7f, 0.02f); break;
+        case RX_HAPTIC_IMPACT_HEAVY:  haptic_play(1.0f, 0.025f); break;
+        case RX_HAPTIC_SUCCESS:
+            haptic_play(0.5f, 0.015f);
+            haptic_play(0.8f, 0.02f);
+            break;
+        case RX_HAPTIC_WARNING:
+            haptic_play(0.8f, 0.02f);
+            haptic_play(0.5f, 0.015f);
+            break;
+        case RX_HAPTIC_ERROR:
+            haptic_play(0.9f, 0.02f);
+            haptic_play(0.9f, 0.02f);
+            haptic_play(0.9f, 0.02f);
+            break;
+        case RX_HAPTIC_CLICK:         haptic_play(0.6f, 0.01f); break;
+        case RX_HAPTIC_DOUBLE_CLICK:
+            haptic_play(0.6f, 0.01f);
+            haptic_play(0.6f, 0.01f);
+            break;
+        case RX_HAPTIC_PATTERN:       break;    /* Needs rx_haptic_pattern_play */
+    }
+}
+
+void rx_haptic_impact(float intensity) {
+    haptic_play(intensity, 0.015f);
+}
+
+void rx_haptic_pattern_play(rx_haptic_pattern* pattern) {
+    if (!pattern) return;
+    for (size_t i = 0; i < pattern->count; i++) {
+        haptic_play(pattern->intensities[i], pattern->durations[i]);
+    }
+}
+
+rx_haptic_pattern* rx_haptic_pattern_create(float* intensities, float* durations, size_t count) {
+    rx_haptic_pattern* p = (rx_haptic_pattern*)calloc(1, sizeof(rx_haptic_pattern));
+    if (!p) return NULL;
+    if (count > 0) {
+        p->intensities = (float*)malloc(sizeof(float) * count);
+        p->durations = (float*)malloc(sizeof(float) * count);
+        if (!p->intensities || !p->durations) {
+            rx_haptic_pattern_destroy(p);
+            return NULL;
+        }
+        memcpy(p->intensities, intensities, sizeof(float) * count);
+        memcpy(p->durations, durations, sizeof(float) * count);
+        p->count = count;
+    }
+    return p;
+}
+
+void rx_haptic_pattern_destroy(rx_haptic_pattern* pattern) {
+    if (!pattern) return;
+    free(pattern->intensities);
+    free(pattern->durations);
+    free(pattern);
+}
+
+void rx_gesture_set_haptic(rx_gesture_recognizer* recognizer, rx_haptic_type type) {
+    if (recognizer) recognizer->haptic = (int)type;
+}
+
+/* ============================================================================
+ * Recognizers
+ * ============================================================================ */
+
+static void recognizer_init(rx_gesture_recognizer* r, rx_gesture_type type, int touches,
+                            rx_gesture_callback cb, void* data) {
+    r->type = type;
+    r->state = RX_GESTURE_POSSIBLE;
+    r->enabled = true;
+    r->required_touches = touches;
+    r->callback = cb;
+    r->user_data = data;
+    r->haptic = -1;
+}
+
+rx_tap_recognizer* rx_tap_recognizer_create(int taps, rx_gesture_callback cb, void* data) {
+    rx_tap_recognizer* r = (rx_tap_recognizer*)calloc(1, sizeof(rx_tap_recognizer));
+    if (!r) return NULL;
+    if (taps < 1) taps = 1;
+    recognizer_init(&r->base, taps == 2 ? RX_GESTURE_DOUBLE_TAP : RX_GESTURE_TAP, 1, cb, data);
+    r->number_of_taps = taps;
+    r->number_of_touches = 1;
+    r->max_duration = 0.3f;
+    r->max_distance = 12.0f;
+    return r;
+}
+
+rx_pan_recognizer* rx_pan_recognizer_create(rx_gesture_callback cb, void* data) {
+    rx_pan_recognizer* r = (rx_pan_recognizer*)calloc(1, sizeof(rx_pan_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_PAN, 1, cb, data);
+    r->minimum_touches = 1;
+    r->maximum_touches = 10;
+    r->minimum_distance = 10.0f;
+    return r;
+}
+
+rx_swipe_recognizer* rx_swipe_recognizer_create(rx_swipe_direction dir, rx_gesture_callback cb, void* data) {
+    rx_swipe_recognizer* r = (rx_swipe_recognizer*)calloc(1, sizeof(rx_swipe_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_SWIPE, 1, cb, data);
+    r->allowed_directions = dir;
+    r->minimum_velocity = 300.0f;
+    r->minimum_distance = 40.0f;
+    return r;
+}
+
+rx_pinch_recognizer* rx_pinch_recognizer_create(rx_gesture_callback cb, void* data) {
+    rx_pinch_recognizer* r = (rx_pinch_recognizer*)calloc(1, sizeof(rx_pinch_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_PINCH, 2, cb, data);
+    r->scale = 1.0f;
+    return r;
+}
+
+rx_rotation_recognizer* rx_rotation_recognizer_create(rx_gesture_callback cb, void* data) {
+    rx_rotation_recognizer* r = (rx_rotation_recognizer*)calloc(1, sizeof(rx_rotation_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_ROTATE, 2, cb, data);
+    return r;
+}
+
+rx_long_press_recognizer* rx_long_press_recognizer_create(float duration, rx_gesture_callback cb, void* data) {
+    rx_long_press_recognizer* r = (rx_long_press_recognizer*)calloc(1, sizeof(rx_long_press_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_LONG_PRESS, 1, cb, data);
+    r->minimum_duration = duration > 0 ? duration : 0.5f;
+    r->allowed_movement = 10.0f;
+    return r;
+}
+
+rx_edge_swipe_recognizer* rx_edge_swipe_recognizer_create(rx_edge_type edge, rx_gesture_callback cb, void* data) {
+    rx_edge_swipe_recognizer* r = (rx_edge_swipe_recognizer*)calloc(1, sizeof(rx_edge_swipe_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_EDGE_SWIPE, 1, cb, data);
+    r->edges = edge;
+    r->edge_width = 20.0f;
+    r->minimum_distance = 16.0f;
+    return r;
+}
+
+rx_custom_gesture_recognizer* rx_custom_gesture_create(rx_custom_gesture_config config, rx_gesture_callback cb, void* data) {
+    rx_custom_gesture_recognizer* r = (rx_custom_gesture_recognizer*)calloc(1, sizeof(rx_custom_gesture_recognizer));
+    if (!r) return NULL;
+    recognizer_init(&r->base, RX_GESTURE_CUSTOM, 1, cb, data);
+    if (config.required_points <= 0) config.required_points = 8;
+    if (config.tolerance <= 0) config.tolerance = 0.2f;
+    r->config = config;
+    r->template_ready = rx_gesture_template_prepare(config.path, config.path_length, r->template_points);
+    return r;
+}
+
+/* Back to POSSIBLE with no per-attempt state */
+static void recognizer_clear(rx_gesture_recognizer* r) {
+    r->state = RX_GESTURE_POSSIBLE;
+    r->has_deferred = false;
+    switch (r->type) {
+        case RX_GESTURE_TAP:
+        case RX_GESTURE_DOUBLE_TAP: {
+            rx_tap_recognizer* t = (rx_tap_recognizer*)r;
+            t->taps_seen = 0;
+            break;
+        }
+        case RX_GESTURE_PAN: {
+            rx_pan_recognizer* p = (rx_pan_recognizer*)r;
+            p->translation = point(0, 0);
+            p->velocity = point(0, 0);
+            p->origin_touches = 0;
+            break;
+        }
+        case RX_GESTURE_PINCH: {
+            rx_pinch_recognizer* p = (rx_pinch_recognizer*)r;
+            p->scale = 1.0f;
+            p->initial_distance = 0;
+            p->velocity = 0;
+            break;
+        }
+        case RX_GESTURE_ROTATE: {
+            rx_rotation_recognizer* p = (rx_rotation_recognizer*)r;
+            p->rotation = 0;
+            p->initial_angle = 0;
+            p->velocity = 0;
+            break;
+        }
+        case RX_GESTURE_EDGE_SWIPE:
+            ((rx_edge_swipe_recognizer*)r)->translation = point(0, 0);
+            break;
+        case RX_GESTURE_CUSTOM:
+            ((rx_custom_gesture_recognizer*)r)->recorded_length = 0;
+            break;
+        default:
+            break;
+    }
+}
+
+void rx_gesture_attach(rx_gesture_recognizer* recognizer, rx_view* view) {
+    if (!recognizer) return;
+    recognizer->view = view;
+    if (recognizer->system) recognizer->system->route_dirty = true;
+    else rx_gesture_system_add(rx_gesture_system_shared(), recognizer);
+}
+
+void rx_gesture_detach(rx_gesture_recognizer* recognizer) {
+    if (!recognizer) return;
+    if (recognizer->system) rx_gesture_system_remove(recognizer->system, recognizer);
+    recognizer->view = NULL;
+}
+
+void rx_gesture_set_enabled(rx_gesture_recognizer* recognizer, bool enabled) {
+    if (!recognizer || recognizer->enabled == enabled) return;
+    recognizer->enabled = enabled;
+    if (recognizer->system) recognizer->system->route_dirty = true;
+    if (!enabled && recognizer->state != RX_GESTURE_POSSIBLE) {
+        recognizer->state = RX_GESTURE_CANCELLED;
+    }
+    recognizer->has_deferred = false;
+}
+
+void rx_gesture_require_failure(rx_gesture_recognizer* recognizer, rx_gesture_recognizer* other) {
+    if (!recognizer || !other || recognizer == other) return;
+    rx_gesture_recognizer** list = (rx_gesture_recognizer**)realloc(
+        recognizer->require_failure, sizeof(rx_gesture_recognizer*) * (recognizer->require_failure_count + 1));
+    if (!list) return;
+    list[recognizer->require_failure_count++] = other;
+    recognizer->require_failure = list;
+}
+
+void rx_gesture_reset(rx_gesture_recognizer* recognizer) {
+    if (recognizer) recognizer_clear(recognizer);
+}
+
+void rx_gesture_destroy(rx_gesture_recognizer* recognizer) {
+    if (!recognizer) return;
+    rx_gesture_system* sys = recognizer->system;
+    if (sys) {
+        rx_gesture_system_remove(sys, recognizer);
+        /* Drop references from recognizers still in the system */
+        for (rx_gesture_recognizer* r = sys->recognizers; r; r = r->next) {
+            size_t kept = 0;
+            for (size_t i = 0; i < r->require_failure_count; i++) {
+                if (r->require_failure[i] != recognizer) r->require_failure[kept++] = r->require_failure[i];
+            }
+            r->require_failure_count = kept;
+        }
+    }
+    if (recognizer->type == RX_GESTURE_CUSTOM) {
+        free(((rx_custom_gesture_recognizer*)recognizer)->recorded_path);
+    }
+    free(recognizer->require_failure);
+    free(recognizer);
+}
+
+rx_rect rx_view_window_frame(rx_view* view) {
+    if (!view) return rect(0, 0, 0, 0);
+    rx_rect frame = view->box.frame;
+    for (rx_view* p = view->parent; p; p = p->parent) {
+        frame.x += p->box.frame.x;
+        frame.y += p->box.frame.y;
+    }
+    return frame;
+}
+
+/* ============================================================================
+ * Template Matching
+ * ============================================================================ */
+
+bool rx_gesture_template_prepare(const rx_point* path, size_t length, rx_point* out) {
+    if (!path || !out || length < 2) return false;
+
+    float total = 0;
+    for (size_t i = 1; i < length; i++) total += point_distance(path[i - 1], path[i]);
+    if (total <= 1e-6f) return false;
+
+    /* Equidistant points along the polyline */
+    const int n = RX_GESTURE_TEMPLATE_POINTS;
+    float step = total / (float)(n - 1);
+    float carried = 0;
+    rx_point prev = path[0];
+    int count = 0;
+    out[count++] = prev;
+    for (size_t i = 1; i < length && count < n; ) {
+        float d = point_distance(prev, path[i]);
+        if (d > 0 && carried + d >= step) {
+            float t = (step - carried) / d;
+            prev = point(prev.x + (path[i].x - prev.x) * t, prev.y + (path[i].y - prev.y) * t);
+            out[count++] = prev;
+            carried = 0;
+        } else {
+            carried += d;
+            prev = path[i];
+            i++;
+        }
+    }
+    while (count < n) out[count++] = path[length - 1];   /* Rounding at the end */
+
+    /* Centroid to the origin, larger bounding-box side to 1 */
+    float cx = 0, cy = 0;
+    float min_x = out[0].x, max_x = out[0].x, min_y = out[0].y, max_y = out[0].y;
+    for (int i = 0; i < n; i++) {
+        cx += out[i].x;
+        cy += out[i].y;
+        if (out[i].x < min_x) min_x = out[i].x;
+        if (out[i].x > max_x) max_x = out[i].x;
+        if (out[i].y < min_y) min_y = out[i].y;
+        if (out[i].y > max_y) max_y = out[i].y;
+    }
+    cx /= n;
+    cy /= n;
+    float extent = fmaxf(max_x - min_x, max_y - min_y);
+    if (extent <= 1e-6f) return false;
+    float inv = 1.0f / extent;
+    for (int i = 0; i < n; i++) {
+        out[i] = point((out[i].x - cx) * inv, (out[i].y - cy) * inv);
+    }
+    return true;
+}
+
+/* Mean point distance, abandoned once it cannot come in under limit */
+static float template_distance(const rx_point* a, const rx_point* b, bool reversed, float limit) {
+    const int n = RX_GESTURE_TEMPLATE_POINTS;
+    float budget = limit * n;
+    float sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += point_distance(a[i], b[reversed ? n - 1 - i : i]);
+        if (sum > budget) return INFINITY;
+    }
+    return sum / n;
+}
+
+bool rx_custom_gesture_match(rx_custom_gesture_recognizer* recognizer, rx_point* path, size_t length) {
+    if (!recognizer) return false;
+    recognizer->match_score = 0;
+    if (!recognizer->template_ready || length < (size_t)recognizer->config.required_points) return false;
+
+    rx_point candidate[RX_GESTURE_TEMPLATE_POINTS];
+    if (!rx_gesture_template_prepare(path, length, candidate)) return false;
+
+    /* Either drawing direction; the reverse pass only has to beat the first */
+    float tolerance = recognizer->config.tolerance;
+    float d = template_distance(candidate, recognizer->template_points, false, tolerance);
+    float back = template_distance(candidate, recognizer->template_points, true, fminf(d, tolerance));
+    if (back < d) d = back;
+    if (!isfinite(d)) return false;
+
+    /* Normalized points are at most half a diagonal from the centroid */
+    recognizer->match_score = clampf(1.0f - d / (0.5f * sqrtf(2.0f)), 0, 1);
+    return d <= tolerance;
+}
+
+/* ============================================================================
+ * Preset Gestures
+ * ============================================================================ */
+
+static rx_custom_gesture_config preset(const char* name, rx_point* path, size_t length) {
+    return (rx_custom_gesture_config){ name, 10, 0.2f, path, length };
+}
+
+rx_custom_gesture_config rx_gesture_circle(void) {
+    /* Clockwise on screen from the top */
+    static rx_point path[33];
+    if (path[0].x == 0) {
+        for (int i = 0; i < 33; i++) {
+            float a = -GESTURE_PI * 0.5f + 2.0f * GESTURE_PI * (float)i / 32.0f;
+            path[i] = point(0.5f + 0.5f * cosf(a), 0.5f + 0.5f * sinf(a));
+        }
+    }
+    return preset("circle", path, 33);
+}
+
+rx_custom_gesture_config rx_gesture_check(void) {
+    static rx_point path[] = { { 0.0f, 0.55f }, { 0.35f, 0.9f }, { 1.0f, 0.1f } };
+    return preset("check", path, 3);
+}
+
+rx_custom_gesture_config rx_gesture_cross(void) {
+    /* One stroke: down-right diagonal, up the right side, down-left */
+    static rx_point path[] = { { 0, 0 }, { 1, 1 }, { 1, 0 }, { 0, 1 } };
+    return preset("cross", path, 4);
+}
+
+rx_custom_gesture_config rx_gesture_triangle(void) {
+    static rx_point path[] = { { 0.5f, 0 }, { 1, 1 }, { 0, 1 }, { 0.5f, 0 } };
+    return preset("triangle", path, 4);
+}
+
+rx_custom_gesture_config rx_gesture_square(void) {
+    static rx_point path[] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { 0, 0 } };
+    return preset("square", path, 5);
+}
+
+/* ============================================================================
+ * Routing
+ * ============================================================================ */
+
+/* Window rect of a view clipped by its ancestors; false if nothing of it
+ * can be touched */
+static bool route_view_rect(rx_view* view, rx_rect* out) {
+    if (!view->visible) return false;
+    rx_rect r = rx_view_window_frame(view);
+    float x0 = r.x, y0 = r.y, x1 = r.x + r.width, y1 = r.y + r.height;
+
+    /* (ox, oy): window position of p, walking up from the parent */
+    float ox = r.x - view->box.frame.x, oy = r.y - view->box.frame.y;
+    for (rx_view* p = view->parent; p; p = p->parent) {
+        if (!p->visible) return false;
+        x0 = fmaxf(x0, ox);
+        y0 = fmaxf(y0, oy);
+        x1 = fminf(x1, ox + p->box.frame.width);
+        y1 = fminf(y1, oy + p->box.frame.height);
+        ox -= p->box.frame.x;
+        oy -= p->box.frame.y;
+    }
+    if (x1 <= x0 || y1 <= y0) return false;
+    *out = rect(x0, y0, x1 - x0, y1 - y0);
+    return true;
+}
+
+static void route_cell_range(rx_gesture_system* sys, rx_rect r, int* c0, int* r0, int* c1, int* r1) {
+    rx_rect area = sys->route_area;
+    float cw = area.width / sys->route_cols;
+    float ch = area.height / sys->route_rows;
+    *c0 = (int)((r.x - area.x) / cw);
+    *r0 = (int)((r.y - area.y) / ch);
+    *c1 = (int)((r.x + r.width - area.x) / cw);
+    *r1 = (int)((r.y + r.height - area.y) / ch);
+    if (*c0 < 0) *c0 = 0;
+    if (*r0 < 0) *r0 = 0;
+    if (*c1 >= sys->route_cols) *c1 = sys->route_cols - 1;
+    if (*r1 >= sys->route_rows) *r1 = sys->route_rows - 1;
+}
+
+static bool route_push(rx_gesture_system* sys, rx_gesture_recognizer* r, rx_rect rect) {
+    if (!grow_array((void**)&sys->route_entries, &sys->route_capacity, sys->route_count + 1,
+                    sizeof(rx_gesture_route_entry))) {
+        return false;
+    }
+    sys->route_entries[sys->route_count++] = (rx_gesture_route_entry){ r, rect };
+    return true;
+}
+
+/* Same layout as the bridge's hit index: entries bucketed into a uniform
+ * grid over their bounds, one prefix-summed cell list */
+static void route_rebuild(rx_gesture_system* sys) {
+    sys->route_dirty = false;
+    sys->route_count = 0;
+    sys->route_cols = sys->route_rows = 0;
+
+    for (rx_gesture_recognizer* r = sys->recognizers; r; r = r->next) {
+        if (r->enabled && !r->view) route_push(sys, r, rect(0, 0, 0, 0));
+    }
+    sys->global_count = sys->route_count;
+
+    float x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+    for (rx_gesture_recognizer* r = sys->recognizers; r; r = r->next) {
+        rx_rect rr;
+        if (!r->enabled || !r->view || !route_view_rect(r->view, &rr)) continue;
+        if (!route_push(sys, r, rr)) break;
+        x0 = fminf(x0, rr.x);
+        y0 = fminf(y0, rr.y);
+        x1 = fmaxf(x1, rr.x + rr.width);
+        y1 = fmaxf(y1, rr.y + rr.height);
+    }
+    if (sys->route_count == sys->global_count) return;
+
+    rx_rect area = rect(x0, y0, x1 - x0, y1 - y0);
+    int cols = (int)(area.width / RX_GESTURE_ROUTE_CELL) + 1;
+    int rows = (int)(area.height / RX_GESTURE_ROUTE_CELL) + 1;
+    if (cols > RX_GESTURE_ROUTE_MAX_CELLS) cols = RX_GESTURE_ROUTE_MAX_CELLS;
+    if (rows > RX_GESTURE_ROUTE_MAX_CELLS) rows = RX_GESTURE_ROUTE_MAX_CELLS;
+    size_t cells = (size_t)cols * rows;
+    if (!grow_array((void**)&sys->route_cell_start, &sys->route_start_capacity, cells + 1, sizeof(uint32_t))) {
+        return;
+    }
+    sys->route_area = area;
+    sys->route_cols = cols;
+    sys->route_rows = rows;
+
+    /* Count entries per cell, prefix-sum, then fill */
+    uint32_t* start = sys->route_cell_start;
+    memset(start, 0, sizeof(uint32_t) * (cells + 1));
+    int c0, r0, c1, r1;
+    for (size_t i = sys->global_count; i < sys->route_count; i++) {
+        route_cell_range(sys, sys->route_entries[i].rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++) start[r * cols + c + 1]++;
+    }
+    for (size_t c = 0; c < cells; c++) start[c + 1] += start[c];
+
+    if (!grow_array((void**)&sys->route_cells, &sys->route_cells_capacity, start[cells], sizeof(uint32_t))) {
+        sys->route_cols = sys->route_rows = 0;
+        return;
+    }
+
+    /* start[c] doubles as the fill cursor, then is shifted back */
+    for (size_t i = sys->global_count; i < sys->route_count; i++) {
+        route_cell_range(sys, sys->route_entries[i].rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++) sys->route_cells[start[r * cols + c]++] = (uint32_t)i;
+    }
+    for (size_t c = cells; c > 0; c--) start[c] = start[c - 1];
+    start[0] = 0;
+}
+
+/* Into the live prefix, after recognizers of equal or higher priority */
+static void route_add(rx_gesture_system* sys, rx_gesture_recognizer* r) {
+    if (r->routed || !r->enabled) return;
+    if (!grow_array((void**)&sys->routed, &sys->routed_capacity, sys->routed_count + 1,
+                    sizeof(rx_gesture_recognizer*))) {
+        return;
+    }
+    size_t at = 0;
+    while (at < sys->live_count && (!sys->routed[at] || sys->routed[at]->priority >= r->priority)) at++;
+    memmove(&sys->routed[at + 1], &sys->routed[at], sizeof(rx_gesture_recognizer*) * (sys->routed_count - at));
+    sys->routed[at] = r;
+    sys->routed_count++;
+    sys->live_count++;
+    r->routed = true;
+    r->began_at = sys->now;
+}
+
+/* Route every recognizer whose view is under (x, y) */
+static void route_touch(rx_gesture_system* sys, rx_point p) {
+    if (sys->route_dirty) route_rebuild(sys);
+    for (size_t i = 0; i < sys->global_count; i++) route_add(sys, sys->route_entries[i].recognizer);
+    if (sys->route_cols == 0) return;
+
+    rx_rect area = sys->route_area;
+    if (p.x < area.x || p.y < area.y || p.x >= area.x + area.width || p.y >= area.y + area.height) return;
+    int col = (int)((p.x - area.x) / (area.width / sys->route_cols));
+    int row = (int)((p.y - area.y) / (area.height / sys->route_rows));
+    if (col >= sys->route_cols) col = sys->route_cols - 1;
+    if (row >= sys->route_rows) row = sys->route_rows - 1;
+
+    size_t cell = (size_t)row * sys->route_cols + col;
+    for (uint32_t i = sys->route_cell_start[cell]; i < sys->route_cell_start[cell + 1]; i++) {
+        rx_gesture_route_entry* e = &sys->route_entries[sys->route_cells[i]];
+        if (p.x >= e->rect.x && p.x < e->rect.x + e->rect.width &&
+            p.y >= e->rect.y && p.y < e->rect.y + e->rect.height) {
+            route_add(sys, e->recognizer);
+        }
+    }
+}
+
+/* ============================================================================
+ * State Machine
+ * ============================================================================ */
+
+static inline bool state_live(rx_gesture_state s) {
+    return s == RX_GESTURE_POSSIBLE || s == RX_GESTURE_BEGAN || s == RX_GESTURE_CHANGED;
+}
+
+static inline bool state_active(rx_gesture_state s) {
+    return s == RX_GESTURE_BEGAN || s == RX_GESTURE_CHANGED;
+}
+
+/* 0: free to recognize, 1: a required recognizer may still succeed,
+ * -1: one of them has */
+static int failure_requirements(rx_gesture_recognizer* r) {
+    int wait = 0;
+    for (size_t i = 0; i < r->require_failure_count; i++) {
+        rx_gesture_recognizer* o = r->require_failure[i];
+        if (!o->enabled) continue;
+        switch (o->state) {
+            case RX_GESTURE_FAILED:
+            case RX_GESTURE_CANCELLED:
+                break;
+            case RX_GESTURE_POSSIBLE:
+                /* An unrouted recognizer is not seeing this sequence */
+                if (o->routed) wait = 1;
+                break;
+            default:
+                return -1;
+        }
+    }
+    return wait;
+}
+
+static void gesture_emit(rx_gesture_recognizer* r, void* event) {
+    if (r->callback) r->callback(r, event, r->user_data);
+}
+
+static void gesture_fail(rx_gesture_recognizer* r) {
+    r->state = RX_GESTURE_FAILED;
+    r->has_deferred = false;
+}
+
+/* Discrete gestures end with one callback, held back while a required
+ * recognizer is undecided */
+static void gesture_recognize(rx_gesture_recognizer* r, const rx_gesture_event* event) {
+    int req = failure_requirements(r);
+    if (req < 0) {
+        gesture_fail(r);
+        return;
+    }
+    if (req > 0) {
+        r->has_deferred = true;
+        r->deferred = *event;
+        return;
+    }
+    r->state = RX_GESTURE_ENDED;
+    if (r->haptic >= 0) rx_haptic_generate((rx_haptic_type)r->haptic);
+    gesture_emit(r, (void*)event);
+}
+
+/* Continuous gestures: false while blocked (retried next delivery) */
+static bool gesture_begin(rx_gesture_recognizer* r) {
+    int req = failure_requirements(r);
+    if (req < 0) gesture_fail(r);
+    if (req != 0) return false;
+    r->state = RX_GESTURE_BEGAN;
+    if (r->haptic >= 0) rx_haptic_generate((rx_haptic_type)r->haptic);
+    return true;
+}
+
+/* Ended or cancelled: report the active gesture, fail a possible one */
+static bool gesture_finish(rx_gesture_recognizer* r, gesture_phase phase) {
+    if (!state_active(r->state)) {
+        gesture_fail(r);
+        return false;
+    }
+    r->state = phase == PHASE_CANCELLED ? RX_GESTURE_CANCELLED : RX_GESTURE_ENDED;
+    return true;
+}
+
+static rx_point touch_centroid(rx_gesture_system* sys) {
+    rx_point c = point(0, 0);
+    if (sys->touch_count == 0) return c;
+    for (size_t i = 0; i < sys->touch_count; i++) {
+        c.x += sys->active_touches[i].position.x;
+        c.y += sys->active_touches[i].position.y;
+    }
+    return point(c.x / sys->touch_count, c.y / sys->touch_count);
+}
+
+static void handle_tap(rx_gesture_system* sys, rx_tap_recognizer* t, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &t->base;
+    bool expired = t->taps_seen > 0 && sys->now - t->last_tap_at > t->max_duration;
+
+    switch (phase) {
+        case PHASE_BEGAN:
+            if (expired || sys->touch_count > (size_t)t->number_of_touches) {
+                gesture_fail(r);
+            } else if (t->taps_seen > 0 &&
+                       point_distance(sys->active_touches[sys->touch_count - 1].position, t->tap_location) >
+                       t->max_distance * 2) {
+                gesture_fail(r);
+            }
+            break;
+        case PHASE_MOVED:
+            for (size_t i = 0; i < sys->touch_count; i++) {
+                rx_touch* touch = &sys->active_touches[i];
+                if (point_distance(touch->position, touch->initial) > t->max_distance) {
+                    gesture_fail(r);
+                    return;
+                }
+            }
+            break;
+        case PHASE_ENDED:
+            if (remaining > 0) break;
+            if (sys->sequence_peak < (size_t)t->number_of_touches || sys->now - r->began_at > t->max_duration) {
+                gesture_fail(r);
+                break;
+            }
+            t->taps_seen++;
+            t->last_tap_at = sys->now;
+            t->tap_location = sys->active_touches[0].position;
+            if (t->taps_seen >= t->number_of_taps) {
+                rx_gesture_event event = { .tap = { t->tap_location, t->taps_seen, 0 } };
+                gesture_recognize(r, &event);
+            }
+            break;
+        case PHASE_CANCELLED:
+            gesture_fail(r);
+            break;
+        case PHASE_TICK:
+            if (expired && sys->touch_count == 0) gesture_fail(r);
+            break;
+    }
+}
+
+static void handle_long_press(rx_gesture_system* sys, rx_long_press_recognizer* lp, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &lp->base;
+    lp->location = touch_centroid(sys);
+    rx_long_press_event event = { lp->location, sys->now - r->began_at, RX_GESTURE_POSSIBLE };
+
+    if (phase == PHASE_ENDED || phase == PHASE_CANCELLED) {
+        if (phase == PHASE_ENDED && remaining > 0) return;
+        if (gesture_finish(r, phase)) {
+            event.state = r->state;
+            gesture_emit(r, &event);
+        }
+        return;
+    }
+    if (r->state == RX_GESTURE_POSSIBLE) {
+        if (sys->touch_count > (size_t)r->required_touches) {
+            gesture_fail(r);
+            return;
+        }
+        for (size_t i = 0; i < sys->touch_count; i++) {
+            rx_touch* touch = &sys->active_touches[i];
+            if (point_distance(touch->position, touch->initial) > lp->allowed_movement) {
+                gesture_fail(r);
+                return;
+            }
+        }
+        if (sys->touch_count == (size_t)r->required_touches && event.duration >= lp->minimum_duration &&
+            gesture_begin(r)) {
+            event.state = RX_GESTURE_BEGAN;
+            gesture_emit(r, &event);
+        }
+    } else if (phase == PHASE_MOVED) {
+        r->state = RX_GESTURE_CHANGED;
+        event.state = RX_GESTURE_CHANGED;
+        gesture_emit(r, &event);
+    }
+}
+
+static void handle_pan(rx_gesture_system* sys, rx_pan_recognizer* p, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &p->base;
+    size_t n = sys->touch_count;
+
+    if (phase == PHASE_ENDED || phase == PHASE_CANCELLED) {
+        if (phase == PHASE_ENDED && remaining > 0) return;
+        if (gesture_finish(r, phase)) {
+            rx_pan_event event = { touch_centroid(sys), p->translation, p->velocity, r->state };
+            gesture_emit(r, &event);
+        }
+        return;
+    }
+    if (phase != PHASE_MOVED || n < (size_t)p->minimum_touches || n > (size_t)p->maximum_touches) return;
+
+    /* Measured from the initial centroid, re-based when fingers join or
+     * lift so the translation stays continuous */
+    rx_point c = touch_centroid(sys);
+    if (p->origin_touches == 0) {
+        rx_point o = point(0, 0);
+        for (size_t i = 0; i < n; i++) {
+            o.x += sys->active_touches[i].initial.x;
+            o.y += sys->active_touches[i].initial.y;
+        }
+        p->origin = point(o.x / n, o.y / n);
+        p->origin_touches = n;
+    } else if (p->origin_touches != n) {
+        p->origin = point(c.x - p->translation.x, c.y - p->translation.y);
+        p->origin_touches = n;
+    }
+    p->translation = point(c.x - p->origin.x, c.y - p->origin.y);
+
+    rx_point v = point(0, 0);
+    for (size_t i = 0; i < n; i++) {
+        rx_point tv = rx_touch_history_velocity(&sys->history[i]);
+        v.x += tv.x;
+        v.y += tv.y;
+    }
+    p->velocity = point(v.x / n, v.y / n);
+
+    if (r->state == RX_GESTURE_POSSIBLE) {
+        if (hypotf(p->translation.x, p->translation.y) < p->minimum_distance || !gesture_begin(r)) return;
+    } else {
+        r->state = RX_GESTURE_CHANGED;
+    }
+    rx_pan_event event = { c, p->translation, p->velocity, r->state };
+    gesture_emit(r, &event);
+}
+
+static rx_swipe_direction swipe_direction(rx_point d) {
+    if (fabsf(d.x) >= fabsf(d.y)) return d.x < 0 ? RX_SWIPE_LEFT : RX_SWIPE_RIGHT;
+    return d.y < 0 ? RX_SWIPE_UP : RX_SWIPE_DOWN;
+}
+
+static void handle_swipe(rx_gesture_system* sys, rx_swipe_recognizer* s, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &s->base;
+    if (phase == PHASE_TICK) return;
+    if (phase == PHASE_CANCELLED || sys->touch_count > (size_t)r->required_touches) {
+        gesture_fail(r);
+        return;
+    }
+
+    rx_touch* touch = &sys->active_touches[0];
+    rx_point d = point(touch->position.x - touch->initial.x, touch->position.y - touch->initial.y);
+    float distance = hypotf(d.x, d.y);
+    rx_swipe_direction dir = swipe_direction(d);
+
+    if (phase == PHASE_MOVED) {
+        /* Heading the wrong way: give up before the finger lifts */
+        if (distance >= s->minimum_distance && !(dir & s->allowed_directions)) gesture_fail(r);
+    } else if (phase == PHASE_ENDED && remaining == 0) {
+        rx_point v = rx_touch_history_velocity(&sys->history[0]);
+        float speed = (dir == RX_SWIPE_LEFT || dir == RX_SWIPE_RIGHT) ? fabsf(v.x) : fabsf(v.y);
+        if (!(dir & s->allowed_directions) || distance < s->minimum_distance || speed < s->minimum_velocity) {
+            gesture_fail(r);
+            return;
+        }
+        rx_gesture_event event = { .swipe = { touch->position, dir, v } };
+        gesture_recognize(r, &event);
+    }
+}
+
+static void handle_pinch(rx_gesture_system* sys, rx_pinch_recognizer* p, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &p->base;
+    rx_point center = point(0, 0);
+    if (sys->touch_count >= 2) {
+        rx_point a = sys->active_touches[0].position, b = sys->active_touches[1].position;
+        center = point((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f);
+    }
+
+    if (phase == PHASE_CANCELLED || (phase == PHASE_ENDED && remaining < 2)) {
+        if (gesture_finish(r, phase)) {
+            rx_pinch_event event = { center, p->scale, p->velocity, r->state };
+            gesture_emit(r, &event);
+        }
+        return;
+    }
+    if (sys->touch_count < 2 || phase == PHASE_TICK || phase == PHASE_ENDED) return;
+
+    float d = point_distance(sys->active_touches[0].position, sys->active_touches[1].position);
+    if (p->initial_distance <= 0) {
+        if (d <= 0) return;
+        p->initial_distance = d;
+        p->last_scale = 1.0f;
+        p->last_time = sys->now;
+    }
+    if (phase == PHASE_BEGAN) return;
+
+    p->scale = d / p->initial_distance;
+    float dt = sys->now - p->last_time;
+    if (dt > 0) p->velocity = (p->scale - p->last_scale) / dt;
+    p->last_scale = p->scale;
+    p->last_time = sys->now;
+
+    if (r->state == RX_GESTURE_POSSIBLE) {
+        if (fabsf(p->scale - 1.0f) < PINCH_BEGIN_SCALE || !gesture_begin(r)) return;
+    } else {
+        r->state = RX_GESTURE_CHANGED;
+    }
+    rx_pinch_event event = { center, p->scale, p->velocity, r->state };
+    gesture_emit(r, &event);
+}
+
+static void handle_rotation(rx_gesture_system* sys, rx_rotation_recognizer* p, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &p->base;
+    rx_point center = point(0, 0);
+    float angle = 0;
+    if (sys->touch_count >= 2) {
+        rx_point a = sys->active_touches[0].position, b = sys->active_touches[1].position;
+        center = point((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f);
+        angle = atan2f(b.y - a.y, b.x - a.x);
+    }
+
+    if (phase == PHASE_CANCELLED || (phase == PHASE_ENDED && remaining < 2)) {
+        if (gesture_finish(r, phase)) {
+            rx_rotate_event event = { center, p->rotation, p->velocity, r->state };
+            gesture_emit(r, &event);
+        }
+        return;
+    }
+    if (sys->touch_count < 2 || phase == PHASE_TICK || phase == PHASE_ENDED) return;
+
+    if (phase == PHASE_BEGAN) {
+        if (p->rotation == 0 && r->state == RX_GESTURE_POSSIBLE) {
+            p->initial_angle = p->last_angle = angle;
+            p->last_rotation = 0;
+            p->last_time = sys->now;
+        }
+        return;
+    }
+
+    /* Unwrap across the atan2 seam */
+    float delta = angle - p->last_angle;
+    if (delta > GESTURE_PI) delta -= 2 * GESTURE_PI;
+    if (delta < -GESTURE_PI) delta += 2 * GESTURE_PI;
+    p->rotation += delta;
+    p->last_angle = angle;
+    float dt = sys->now - p->last_time;
+    if (dt > 0) p->velocity = (p->rotation - p->last_rotation) / dt;
+    p->last_rotation = p->rotation;
+    p->last_time = sys->now;
+
+    if (r->state == RX_GESTURE_POSSIBLE) {
+        if (fabsf(p->rotation) < ROTATION_BEGIN_ANGLE || !gesture_begin(r)) return;
+    } else {
+        r->state = RX_GESTURE_CHANGED;
+    }
+    rx_rotate_event event = { center, p->rotation, p->velocity, r->state };
+    gesture_emit(r, &event);
+}
+
+static void handle_edge_swipe(rx_gesture_system* sys, rx_edge_swipe_recognizer* e, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &e->base;
+    if (phase == PHASE_TICK) return;
+    rx_edge_swipe_event event = { e->edges, 0, e->translation, r->state };
+    float extent = (e->edges == RX_EDGE_LEFT || e->edges == RX_EDGE_RIGHT) ? e->bounds.width : e->bounds.height;
+
+    if (phase == PHASE_ENDED || phase == PHASE_CANCELLED) {
+        if (phase == PHASE_ENDED && remaining > 0) return;
+        if (gesture_finish(r, phase)) {
+            float inward = 0;
+            switch (e->edges) {
+                case RX_EDGE_LEFT:   inward = e->translation.x; break;
+                case RX_EDGE_RIGHT:  inward = -e->translation.x; break;
+                case RX_EDGE_TOP:    inward = e->translation.y; break;
+                case RX_EDGE_BOTTOM: inward = -e->translation.y; break;
+            }
+            event.progress = extent > 0 ? clampf(inward / extent, 0, 1) : 0;
+            event.state = r->state;
+            gesture_emit(r, &event);
+        }
+        return;
+    }
+    if (sys->touch_count > (size_t)r->required_touches) {
+        gesture_fail(r);
+        return;
+    }
+
+    rx_touch* touch = &sys->active_touches[0];
+    if (phase == PHASE_BEGAN) {
+        e->bounds = rx_view_window_frame(r->view);
+        rx_rect b = e->bounds;
+        float from_edge = 0;
+        switch (e->edges) {
+            case RX_EDGE_LEFT:   from_edge = touch->initial.x - b.x; break;
+            case RX_EDGE_RIGHT:  from_edge = b.x + b.width - touch->initial.x; break;
+            case RX_EDGE_TOP:    from_edge = touch->initial.y - b.y; break;
+            case RX_EDGE_BOTTOM: from_edge = b.y + b.height - touch->initial.y; break;
+        }
+        if (!r->view || from_edge < 0 || from_edge > e->edge_width) gesture_fail(r);
+        return;
+    }
+
+    e->translation = point(touch->position.x - touch->initial.x, touch->position.y - touch->initial.y);
+    float inward = 0;
+    switch (e->edges) {
+        case RX_EDGE_LEFT:   inward = e->translation.x; break;
+        case RX_EDGE_RIGHT:  inward = -e->translation.x; break;
+        case RX_EDGE_TOP:    inward = e->translation.y; break;
+        case RX_EDGE_BOTTOM: inward = -e->translation.y; break;
+    }
+    if (r->state == RX_GESTURE_POSSIBLE) {
+        if (inward < e->minimum_distance || !gesture_begin(r)) return;
+    } else {
+        r->state = RX_GESTURE_CHANGED;
+    }
+    event.translation = e->translation;
+    event.progress = extent > 0 ? clampf(inward / extent, 0, 1) : 0;
+    event.state = r->state;
+    gesture_emit(r, &event);
+}
+
+static void custom_record(rx_custom_gesture_recognizer* c, const rx_touch_history* h) {
+    size_t need = c->recorded_length + h->fresh;
+    if (!grow_array((void**)&c->recorded_path, &c->recorded_capacity, need, sizeof(rx_point))) return;
+    for (uint32_t i = h->fresh; i > 0; i--) {
+        c->recorded_path[c->recorded_length++] = history_at(h, i - 1)->position;
+    }
+}
+
+static void handle_custom(rx_gesture_system* sys, rx_custom_gesture_recognizer* c, gesture_phase phase, size_t remaining) {
+    rx_gesture_recognizer* r = &c->base;
+    if (phase == PHASE_TICK) return;
+    if (phase == PHASE_CANCELLED || sys->touch_count > 1) {
+        gesture_fail(r);
+        return;
+    }
+    if (phase == PHASE_BEGAN) c->recorded_length = 0;
+    custom_record(c, &sys->history[0]);
+
+    if (phase == PHASE_ENDED && remaining == 0) {
+        if (!rx_custom_gesture_match(c, c->recorded_path, c->recorded_length)) {
+            gesture_fail(r);
+            return;
+        }
+        rx_gesture_event event = { .custom = { c->config.name, sys->active_touches[0].position, c->match_score } };
+        gesture_recognize(r, &event);
+    }
+}
+
+/* Run the live routed recognizers for one delivery. Finished ones are
+ * skipped and moved out of the live prefix afterwards. */
+static void dispatch(rx_gesture_system* sys, gesture_phase phase, size_t remaining) {
+    sys->processing = true;
+    for (size_t i = 0; i < sys->live_count; i++) {
+        rx_gesture_recognizer* r = sys->routed[i];
+        if (!r || !r->enabled || r->has_deferred || !state_live(r->state)) continue;
+        sys->recognizer_updates++;
+        switch (r->type) {
+            case RX_GESTURE_TAP:
+            case RX_GESTURE_DOUBLE_TAP:
+                handle_tap(sys, (rx_tap_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_LONG_PRESS:
+                handle_long_press(sys, (rx_long_press_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_PAN:
+                handle_pan(sys, (rx_pan_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_SWIPE:
+                handle_swipe(sys, (rx_swipe_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_PINCH:
+                handle_pinch(sys, (rx_pinch_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_ROTATE:
+                handle_rotation(sys, (rx_rotation_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_EDGE_SWIPE:
+                handle_edge_swipe(sys, (rx_edge_swipe_recognizer*)r, phase, remaining);
+                break;
+            case RX_GESTURE_CUSTOM:
+                handle_custom(sys, (rx_custom_gesture_recognizer*)r, phase, remaining);
+                break;
+            default:
+                gesture_fail(r);    /* No recognizer for this type */
+                break;
+        }
+    }
+    sys->processing = false;
+
+    for (size_t i = 0; i < sys->touch_count; i++) {
+        sys->active_touches[i].previous = sys->active_touches[i].position;
+        sys->history[i].fresh = 0;
+    }
+}
+
+/* Waiting on a later sequence: a multi-tap between taps, or a recognized
+ * gesture held for its require_failure recognizers */
+static bool recognizer_waiting(rx_gesture_recognizer* r) {
+    if (!r->enabled) return false;
+    if (r->has_deferred) return true;
+    return r->state == RX_GESTURE_POSSIBLE &&
+           (r->type == RX_GESTURE_TAP || r->type == RX_GESTURE_DOUBLE_TAP) &&
+           ((rx_tap_recognizer*)r)->taps_seen > 0;
+}
+
+static void resolve_deferred(rx_gesture_system* sys) {
+    /* A delivery can unblock another deferred recognizer; repeat until quiet */
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < sys->routed_count; i++) {
+            rx_gesture_recognizer* r = sys->routed[i];
+            if (!r || !r->has_deferred) continue;
+            int req = failure_requirements(r);
+            if (req > 0) continue;
+            r->has_deferred = false;
+            changed = true;
+            if (req < 0) {
+                r->state = RX_GESTURE_FAILED;
+                continue;
+            }
+            r->state = RX_GESTURE_ENDED;
+            if (r->haptic >= 0) rx_haptic_generate((rx_haptic_type)r->haptic);
+            gesture_emit(r, &r->deferred);
+        }
+    }
+}
+
+static void schedule_tick(rx_gesture_system* sys);
+
+/* After a delivery: settle deferred recognizers, release everything at
+ * the end of a sequence, keep live recognizers first */
+static void settle(rx_gesture_system* sys) {
+    resolve_deferred(sys);
+
+    size_t n = 0;
+    for (size_t i = 0; i < sys->routed_count; i++) {
+        rx_gesture_recognizer* r = sys->routed[i];
+        if (!r) continue;
+        if (sys->touch_count == 0 && !recognizer_waiting(r)) {
+            recognizer_clear(r);
+            r->routed = false;
+            continue;
+        }
+        sys->routed[n++] = r;
+    }
+    sys->routed_count = n;
+
+    /* Stable for the live recognizers, which keeps priority order */
+    size_t live = 0;
+    for (size_t i = 0; i < n; i++) {
+        rx_gesture_recognizer* r = sys->routed[i];
+        if (!r->enabled || !state_live(r->state)) continue;
+        sys->routed[i] = sys->routed[live];
+        sys->routed[live++] = r;
+    }
+    sys->live_count = live;
+    schedule_tick(sys);
+}
+
+/* ============================================================================
+ * Gesture System
+ * ============================================================================ */
+
+rx_gesture_system* rx_gesture_system_create(void) {
+    return (rx_gesture_system*)calloc(1, sizeof(rx_gesture_system));
+}
+
+void rx_gesture_system_add(rx_gesture_system* sys, rx_gesture_recognizer* recognizer) {
+    if (!sys || !recognizer || recognizer->system == sys) return;
+    if (recognizer->system) rx_gesture_system_remove(recognizer->system, recognizer);
+    recognizer->system = sys;
+    recognizer->next = sys->recognizers;
+    sys->recognizers = recognizer;
+    sys->recognizer_count++;
+    sys->route_dirty = true;
+}
+
+void rx_gesture_system_remove(rx_gesture_system* sys, rx_gesture_recognizer* recognizer) {
+    if (!sys || !recognizer || recognizer->system != sys) return;
+    for (rx_gesture_recognizer** link = &sys->recognizers; *link; link = &(*link)->next) {
+        if (*link == recognizer) {
+            *link = recognizer->next;
+            sys->recognizer_count--;
+            break;
+        }
+    }
+    /* Cleared slots are skipped and dropped by the next settle, so this is
+     * safe from a callback */
+    for (size_t i = 0; i < sys->routed_count; i++) {
+        if (sys->routed[i] == recognizer) sys->routed[i] = NULL;
+    }
+    recognizer->routed = false;
+    recognizer->system = NULL;
+    recognizer->next = NULL;
+    recognizer_clear(recognizer);
+    sys->route_dirty = true;
+}
+
+void rx_gesture_system_invalidate(rx_gesture_system* sys) {
+    if (sys) sys->route_dirty = true;
+}
+
+static int touch_index(rx_gesture_system* sys, uint32_t id) {
+    for (size_t i = 0; i < sys->touch_count; i++) {
+        if (sys->active_touches[i].id == id) return (int)i;
+    }
+    return -1;
+}
+
+static void note_time(rx_gesture_system* sys, float timestamp) {
+    if (timestamp >= sys->now) {
+        sys->now = timestamp;
+        sys->now_ns = rx_clock_ns();
+    }
+}
+
+/* Latest event time advanced by the wall time since it arrived */
+static float current_time(rx_gesture_system* sys) {
+    if (sys->now_ns == 0) return sys->now;
+    return sys->now + (float)((double)(rx_clock_ns() - sys->now_ns) * 1e-9);
+}
+
+static void gesture_frame(void* user_data, float dt);
+
+void rx_gesture_system_process_touch_began(rx_gesture_system* sys, rx_touch* touches, size_t count) {
+    if (!sys || !touches || count == 0) return;
+    rx_gesture_system_flush(sys);
+
+    if (!grow_array((void**)&sys->active_touches, &sys->touch_capacity, sys->touch_count + count, sizeof(rx_touch))) {
+        return;
+    }
+    /* active_touches and history share touch_capacity */
+    rx_touch_history* h = (rx_touch_history*)realloc(sys->history, sizeof(rx_touch_history) * sys->touch_capacity);
+    if (!h) return;
+    sys->history = h;
+
+    bool sequence_start = sys->touch_count == 0;
+    if (sequence_start) sys->sequence_peak = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (touch_index(sys, touches[i].id) >= 0) continue;
+        rx_touch t = touches[i];
+        t.previous = t.initial = t.position;
+        t.is_primary = sys->touch_count == 0;
+        note_time(sys, t.timestamp);
+        size_t at = sys->touch_count++;
+        sys->active_touches[at] = t;
+        sys->history[at].head = sys->history[at].count = sys->history[at].fresh = 0;
+        history_push(&sys->history[at], t.position, t.timestamp);
+    }
+    if (sys->touch_count > sys->sequence_peak) sys->sequence_peak = sys->touch_count;
+
+    /* Recognizers kept from the last sequence start a new attempt too */
+    if (sequence_start) {
+        for (size_t i = 0; i < sys->routed_count; i++) {
+            if (sys->routed[i]) sys->routed[i]->began_at = sys->now;
+        }
+    }
+    for (size_t i = 0; i < count; i++) route_touch(sys, touches[i].position);
+
+    dispatch(sys, PHASE_BEGAN, sys->touch_count);
+    settle(sys);
+}
+
+void rx_gesture_system_process_touch_moved(rx_gesture_system* sys, rx_touch* touches, size_t count) {
+    if (!sys || !touches) return;
+    /* Recorded only: recognizers see the latest positions at the flush */
+    for (size_t i = 0; i < count; i++) {
+        int at = touch_index(sys, touches[i].id);
+        if (at < 0) continue;
+        rx_touch* t = &sys->active_touches[at];
+        t->position = touches[i].position;
+        t->pressure = touches[i].pressure;
+        t->radius = touches[i].radius;
+        t->timestamp = touches[i].timestamp;
+        history_push(&sys->history[at], t->position, t->timestamp);
+        note_time(sys, t->timestamp);
+        sys->moves_pending = true;
+    }
+    sys->moves_received += count;
+
+    if (sys->moves_pending && sys->loop && !sys->flush_scheduled) {
+        sys->flush_scheduled = rx_runloop_on_next_frame(sys->loop, gesture_frame, sys);
+        rx_runloop_request_frame(sys->loop);
+    }
+}
+
+static void touches_finished(rx_gesture_system* sys, rx_touch* touches, size_t count, gesture_phase phase) {
+    if (!sys || !touches || count == 0) return;
+    rx_gesture_system_flush(sys);
+
+    /* Final positions go into the history before the recognizers look */
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        int at = touch_index(sys, touches[i].id);
+        if (at < 0) continue;
+        rx_touch* t = &sys->active_touches[at];
+        t->position = touches[i].position;
+        t->timestamp = touches[i].timestamp;
+        history_push(&sys->history[at], t->position, t->timestamp);
+        note_time(sys, t->timestamp);
+        found++;
+    }
+    if (found == 0) return;
+
+    dispatch(sys, phase, sys->touch_count - found);
+
+    /* Stable removal keeps the remaining touches' order for pinch/rotate */
+    for (size_t i = 0; i < count; i++) {
+        int at = touch_index(sys, touches[i].id);
+        if (at < 0) continue;
+        size_t tail = sys->touch_count - (size_t)at - 1;
+        memmove(&sys->active_touches[at], &sys->active_touches[at + 1], sizeof(rx_touch) * tail);
+        memmove(&sys->history[at], &sys->history[at + 1], sizeof(rx_touch_history) * tail);
+        sys->touch_count--;
+    }
+    settle(sys);
+}
+
+void rx_gesture_system_process_touch_ended(rx_gesture_system* sys, rx_touch* touches, size_t count) {
+    touches_finished(sys, touches, count, PHASE_ENDED);
+}
+
+void rx_gesture_system_process_touch_cancelled(rx_gesture_system* sys, rx_touch* touches, size_t count) {
+    touches_finished(sys, touches, count, PHASE_CANCELLED);
+}
+
+void rx_gesture_system_flush(rx_gesture_system* sys) {
+    if (!sys || !sys->moves_pending) return;
+    sys->moves_pending = false;
+    sys->flushes++;
+    dispatch(sys, PHASE_MOVED, sys->touch_count);
+    settle(sys);
+}
+
+void rx_gesture_system_tick(rx_gesture_system* sys, float now) {
+    if (!sys) return;
+    note_time(sys, now);
+    dispatch(sys, PHASE_TICK, sys->touch_count);
+    settle(sys);
+}
+
+/* ============================================================================
+ * Run Loop Delivery
+ * ============================================================================ */
+
+static void system_free(rx_gesture_system* sys) {
+    free(sys->active_touches);
+    free(sys->history);
+    free(sys->routed);
+    free(sys->route_entries);
+    free(sys->route_cell_start);
+    free(sys->route_cells);
+    free(sys);
+}
+
+static void gesture_frame(void* user_data, float dt) {
+    rx_gesture_system* sys = (rx_gesture_system*)user_data;
+    sys->flush_scheduled = false;
+    if (sys->destroy_pending) {
+        system_free(sys);
+        return;
+    }
+    rx_gesture_system_flush(sys);
+}
+
+static void gesture_timer(void* user_data) {
+    rx_gesture_system* sys = (rx_gesture_system*)user_data;
+    sys->tick_timer = 0;
+    rx_gesture_system_tick(sys, current_time(sys));
+}
+
+/* Earliest long-press or multi-tap deadline among live recognizers */
+static void schedule_tick(rx_gesture_system* sys) {
+    if (!sys->loop) return;
+    float deadline = INFINITY;
+    for (size_t i = 0; i < sys->live_count; i++) {
+        rx_gesture_recognizer* r = sys->routed[i];
+        if (!r || r->state != RX_GESTURE_POSSIBLE) continue;
+        if (r->type == RX_GESTURE_LONG_PRESS && sys->touch_count > 0) {
+            deadline = fminf(deadline, r->began_at + ((rx_long_press_recognizer*)r)->minimum_duration);
+        } else if ((r->type == RX_GESTURE_TAP || r->type == RX_GESTURE_DOUBLE_TAP) &&
+                   ((rx_tap_recognizer*)r)->taps_seen > 0 && sys->touch_count == 0) {
+            rx_tap_recognizer* t = (rx_tap_recognizer*)r;
+            deadline = fminf(deadline, t->last_tap_at + t->max_duration);
+        }
+    }
+    if (sys->tick_timer && deadline == sys->tick_at) return;
+    if (sys->tick_timer) {
+        rx_runloop_cancel_timer(sys->loop, sys->tick_timer);
+        sys->tick_timer = 0;
+    }
+    if (!isfinite(deadline)) return;
+    sys->tick_at = deadline;
+    float wait = deadline - current_time(sys);
+    uint64_t ms = wait > 0 ? (uint64_t)ceilf(wait * 1000.0f) + 1 : 1;
+    sys->tick_timer = rx_runloop_add_timer(sys->loop, ms, 0, gesture_timer, sys);
+}
+
+void rx_gesture_system_set_runloop(rx_gesture_system* sys, struct rx_runloop* loop) {
+    if (!sys || sys->loop == loop) return;
+    if (sys->tick_timer) rx_runloop_cancel_timer(sys->loop, sys->tick_timer);
+    sys->tick_timer = 0;
+    /* A frame callback already queued on the old loop still flushes */
+    sys->loop = loop;
+    schedule_tick(sys);
+}
+
+/* Recognizers are detached, not destroyed; they belong to their views */
+void rx_gesture_system_destroy(rx_gesture_system* sys) {
+    if (!sys) return;
+    while (sys->recognizers) rx_gesture_system_remove(sys, sys->recognizers);
+    if (sys->tick_timer) rx_runloop_cancel_timer(sys->loop, sys->tick_timer);
+    sys->tick_timer = 0;
+    if (sys->flush_scheduled) {
+        sys->destroy_pending = true;    /* Freed by the queued frame callback */
+        return;
+    }
+    system_free(sys);
+}
+
+static rx_gesture_system* shared_system;
+
+rx_gesture_system* rx_gesture_system_shared(void) {
+    if (!shared_system) {
+        shared_system = rx_gesture_system_create();
+        rx_gesture_system_set_runloop(shared_system, rx_runloop_main());
+    }
+    return shared_system;
+}
@@ -7,6 +7,23 @@
  * - Custom gesture recognition
  * - Gesture priority and conflict resolution
  * - Haptic feedback integration
+ * - Touch moves coalesced per frame, with a short sample history per
+ *   touch for velocity estimation
+ * - Touches routed through a grid index of recognizer view frames, so
+ *   only recognizers under a touch see its sequence
+ * - Recognizers that fail, end or are cancelled drop out of the routed
+ *   set until the sequence is over
+ * - Custom gestures matched against resampled, normalized templates
+ *   computed once when the recognizer is created
+ *
+ * Moves are recorded by process_touch_moved and delivered once per frame
+ * by rx_gesture_system_flush (the system schedules it on its run loop when
+ * it has one). Began, ended and cancelled flush pending moves first, then
+ * are delivered immediately. Timestamps are seconds from an origin
+ * recent enough for float precision (app start, not boot); deadlines
+ * between events advance the latest one by the elapsed rx_clock_ns.
+ * The route index is rebuilt when recognizers change; call
+ * rx_gesture_system_invalidate after a layout moves their views.
  */
 
 #ifndef REOX_GESTURES_H
@@ -18,6 +35,8 @@
 extern "C" {
 #endif
 
+struct rx_runloop;
+
 /* ============================================================================
  * Gesture Types
  * ============================================================================ */
@@ -75,6 +94,25 @@ typedef struct rx_touch {
     bool is_primary;          /* Primary touch in multi-touch */
 } rx_touch;
 
+/* Raw samples kept per touch: enough for the velocity window at 240 Hz+ */
+#define RX_GESTURE_HISTORY 32
+#define RX_GESTURE_VELOCITY_WINDOW 0.1f     /* Seconds of samples in a fit */
+
+typedef struct rx_touch_sample {
+    rx_point position;
+    float timestamp;
+} rx_touch_sample;
+
+typedef struct rx_touch_history {
+    rx_touch_sample samples[RX_GESTURE_HISTORY];   /* Ring */
+    uint32_t head;            /* Next slot to write */
+    uint32_t count;
+    uint32_t fresh;           /* Samples not yet delivered */
+} rx_touch_history;
+
+/* Least-squares velocity over the samples in the last window, px/s */
+extern rx_point rx_touch_history_velocity(const rx_touch_history* history);
+
 /* ============================================================================
  * Gesture Events
  * ============================================================================ */
@@ -139,11 +177,29 @@ typedef struct rx_hover_event {
     bool exited;
 } rx_hover_event;
 
+typedef struct rx_custom_gesture_event {
+    const char* name;
+    rx_point location;        /* Where the stroke ended */
+    float score;              /* 1.0: identical to the template */
+} rx_custom_gesture_event;
+
+typedef union rx_gesture_event {
+    rx_tap_event tap;
+    rx_pan_event pan;
+    rx_swipe_event swipe;
+    rx_pinch_event pinch;
+    rx_rotate_event rotate;
+    rx_long_press_event long_press;
+    rx_edge_swipe_event edge_swipe;
+    rx_custom_gesture_event custom;
+} rx_gesture_event;
+
 /* ============================================================================
  * Gesture Recognizer Base
  * ============================================================================ */
 
 typedef struct rx_gesture_recognizer rx_gesture_recognizer;
+typedef struct rx_gesture_system rx_gesture_system;
 
 typedef void (*rx_gesture_callback)(rx_gesture_recognizer* recognizer, void* event, void* user_data);
 
@@ -169,6 +225,15 @@ struct rx_gesture_recognizer {
     
     /* Internal */
     struct rx_gesture_recognizer* next;
+    rx_gesture_system* system;
+    bool routed;              /* In the system's routed set */
+    float began_at;           /* First touch of the current attempt */
+    int haptic;               /* rx_haptic_type on recognition, -1: none */
+    
+    /* Recognized while a require_failure recognizer was still possible:
+     * delivered once they all fail, dropped if one succeeds */
+    bool has_deferred;
+    rx_gesture_event deferred;
 };
 
 /* ============================================================================
@@ -182,6 +247,9 @@ typedef struct rx_tap_recognizer {
     int number_of_touches;    /* Required simultaneous touches */
     float max_duration;       /* Max time between taps */
     float max_distance;       /* Max movement allowed */
+    int taps_seen;
+    float last_tap_at;
+    rx_point tap_location;
 } rx_tap_recognizer;
 
 extern rx_tap_recognizer* rx_tap_recognizer_create(int taps, rx_gesture_callback cb, void* data);
@@ -194,6 +262,8 @@ typedef struct rx_pan_recognizer {
     float minimum_distance;   /* Distance before recognition */
     rx_point translation;
     rx_point velocity;
+    rx_point origin;          /* Centroid the translation is measured from */
+    size_t origin_touches;    /* Touch count origin was taken with */
 } rx_pan_recognizer;
 
 extern rx_pan_recognizer* rx_pan_recognizer_create(rx_gesture_callback cb, void* data);
@@ -213,6 +283,9 @@ typedef struct rx_pinch_recognizer {
     rx_gesture_recognizer base;
     float scale;
     float initial_distance;
+    float velocity;
+    float last_scale;         /* At the previous flush, for velocity */
+    float last_time;
 } rx_pinch_recognizer;
 
 extern rx_pinch_recognizer* rx_pinch_recognizer_create(rx_gesture_callback cb, void* data);
@@ -222,6 +295,10 @@ typedef struct rx_rotation_recognizer {
     rx_gesture_recognizer base;
     float rotation;
     float initial_angle;
+    float velocity;
+    float last_angle;         /* Unwrapped against this each flush */
+    float last_rotation;
+    float last_time;
 } rx_rotation_recognizer;
 
 extern rx_rotation_recognizer* rx_rotation_recognizer_create(rx_gesture_callback cb, void* data);
@@ -231,6 +308,7 @@ typedef struct rx_long_press_recognizer {
     rx_gesture_recognizer base;
     float minimum_duration;
     float allowed_movement;
+    rx_point location;
 } rx_long_press_recognizer;
 
 extern rx_long_press_recognizer* rx_long_press_recognizer_create(float duration, rx_gesture_callback cb, void* data);
@@ -241,6 +319,8 @@ typedef struct rx_edge_swipe_recognizer {
     rx_edge_type edges;
     float edge_width;         /* Detection zone size */
     float minimum_distance;
+    rx_rect bounds;           /* View frame when the touch began */
+    rx_point translation;
 } rx_edge_swipe_recognizer;
 
 extern rx_edge_swipe_recognizer* rx_edge_swipe_recognizer_create(rx_edge_type edge, rx_gesture_callback cb, void* data);
@@ -256,6 +336,9 @@ extern void rx_gesture_require_failure(rx_gesture_recognizer* recognizer, rx_ges
 extern void rx_gesture_reset(rx_gesture_recognizer* recognizer);
 extern void rx_gesture_destroy(rx_gesture_recognizer* recognizer);
 
+/* Current frame of a view in window coordinates */
+extern rx_rect rx_view_window_frame(rx_view* view);
+
 /* ============================================================================
  * Custom Gesture Recognizer
  * ============================================================================ */
@@ -270,17 +353,29 @@ typedef struct rx_custom_gesture_config {
     size_t path_length;
 } rx_custom_gesture_config;
 
+/* Paths are resampled to this many equidistant points, centred on their
+ * centroid and scaled so the larger side of the bounding box is 1 */
+#define RX_GESTURE_TEMPLATE_POINTS 48
+
 typedef struct rx_custom_gesture_recognizer {
     rx_gesture_recognizer base;
     rx_custom_gesture_config config;
     rx_point* recorded_path;
     size_t recorded_length;
+    size_t recorded_capacity;
     float match_score;
+    
+    /* config.path, prepared at creation */
+    rx_point template_points[RX_GESTURE_TEMPLATE_POINTS];
+    bool template_ready;
 } rx_custom_gesture_recognizer;
 
 extern rx_custom_gesture_recognizer* rx_custom_gesture_create(rx_custom_gesture_config config, rx_gesture_callback cb, void* data);
 extern bool rx_custom_gesture_match(rx_custom_gesture_recognizer* recognizer, rx_point* path, size_t length);
 
+/* Resample and normalize a path into RX_GESTURE_TEMPLATE_POINTS points */
+extern bool rx_gesture_template_prepare(const rx_point* path, size_t length, rx_point* out);
+
 /* Preset custom gestures */
 extern rx_custom_gesture_config rx_gesture_circle(void);
 extern rx_custom_gesture_config rx_gesture_check(void);
@@ -292,15 +387,70 @@ extern rx_custom_gesture_config rx_gesture_square(void);
  * Gesture Event Dispatch
  * ============================================================================ */
 
-typedef struct rx_gesture_system {
+#define RX_GESTURE_ROUTE_CELL 64.0f
+#define RX_GESTURE_ROUTE_MAX_CELLS 256
+
+typedef struct rx_gesture_route_entry {
+    rx_gesture_recognizer* recognizer;
+    rx_rect rect;             /* View frame clipped by its ancestors */
+} rx_gesture_route_entry;
+
+struct rx_gesture_system {
     rx_gesture_recognizer* recognizers;
     size_t recognizer_count;
     rx_touch* active_touches;
     size_t touch_count;
     bool processing;
-} rx_gesture_system;
+    
+    /* Per touch, parallel to active_touches */
+    rx_touch_history* history;
+    size_t touch_capacity;
+    size_t sequence_peak;     /* Most touches down at once this sequence */
+    bool moves_pending;       /* Moves recorded since the last flush */
+    float now;                /* Latest timestamp seen */
+    uint64_t now_ns;          /* rx_clock_ns when it was seen */
+    
+    /* Recognizers receiving the current sequence, by priority; the first
+     * live_count are still evaluated, the rest have finished */
+    rx_gesture_recognizer** routed;
+    size_t routed_count, routed_capacity;
+    size_t live_count;
+    
+    /* Route index: view-less recognizers first (global_count), then a
+     * uniform grid over the other entries' rects */
+    rx_gesture_route_entry* route_entries;
+    size_t route_count, route_capacity;
+    size_t global_count;
+    uint32_t* route_cell_start;
+    size_t route_start_capacity;
+    uint32_t* route_cells;
+    size_t route_cells_capacity;
+    rx_rect route_area;
+    int route_cols, route_rows;
+    bool route_dirty;
+    
+    /* Frame delivery */
+    struct rx_runloop* loop;
+    bool flush_scheduled;
+    bool destroy_pending;     /* Destroyed while a flush was scheduled */
+    uint64_t tick_timer;      /* Long press / multi-tap deadline */
+    float tick_at;            /* When tick_timer fires, event time */
+    
+    /* Statistics */
+    uint64_t moves_received;
+    uint64_t flushes;
+    uint64_t recognizer_updates;
+};
 
 extern rx_gesture_system* rx_gesture_system_create(void);
+extern void rx_gesture_system_add(rx_gesture_system* sys, rx_gesture_recognizer* recognizer);
+extern void rx_gesture_system_remove(rx_gesture_system* sys, rx_gesture_recognizer* recognizer);
+/* Deliver coalesced moves and expire timed recognizers (NULL loop: the
+ * caller flushes once per frame) */
+extern void rx_gesture_system_set_runloop(rx_gesture_system* sys, struct rx_runloop* loop);
+extern void rx_gesture_system_flush(rx_gesture_system* sys);
+extern void rx_gesture_system_tick(rx_gesture_system* sys, float now);
+extern void rx_gesture_system_invalidate(rx_gesture_system* sys);
 extern void rx_gesture_system_process_touch_began(rx_gesture_system* sys, rx_touch* touches, size_t count);
 extern void rx_gesture_system_process_touch_moved(rx_gesture_system* sys, rx_touch* touches, size_t count);
 extern void rx_gesture_system_process_touch_ended(rx_gesture_system* sys, rx_touch* touches, size_t count);
@@ -339,6 +489,10 @@ extern void rx_haptic_pattern_play(rx_haptic_pattern* pattern);
 extern rx_haptic_pattern* rx_haptic_pattern_create(float* intensities, float* durations, size_t count);
 extern void rx_haptic_pattern_destroy(rx_haptic_pattern* pattern);
 
+/* Platform haptic engine; without one, feedback is dropped */
+typedef void (*rx_haptic_driver)(float intensity, float duration, void* ctx);
+extern void rx_haptic_set_driver(rx_haptic_driver driver, void* ctx);
+
 /* Haptic integration with gestures */
 extern void rx_gesture_set_haptic(rx_gesture_recognizer* recognizer, rx_haptic_type type);
 
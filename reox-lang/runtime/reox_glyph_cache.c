@@ -0,0 +1,364 @@
+/*
+ * REOX Glyph Cache - Implementation
+ * Glyph atlas and shaped-run cache shared by the text renderers
+ */
+
+#include "reox_glyph_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Hashing
+ * ============================================================================ */
+
+static uint64_t hash_bytes(const char* s, size_t len) {
+    /* FNV-1a */
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static uint32_t hash_glyph(uint32_t font_id, int px, uint32_t codepoint) {
+    uint32_t h = codepoint * 0x9E3779B1u;
+    h ^= (font_id + 0x7F4A7C15u) * 0x85EBCA77u;
+    h ^= (uint32_t)px * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    return h;
+}
+
+/* ============================================================================
+ * UTF-8
+ * ============================================================================ */
+
+uint32_t rx_utf8_next(const char** s) {
+    const uint8_t* p = (const uint8_t*)*s;
+    uint32_t cp;
+    int extra;
+
+    if (p[0] < 0x80) { *s += 1; return p[0]; }
+    if ((p[0] & 0xE0) == 0xC0) { cp = p[0] & 0x1F; extra = 1; }
+    else if ((p[0] & 0xF0) == 0xE0) { cp = p[0] & 0x0F; extra = 2; }
+    else if ((p[0] & 0xF8) == 0xF0) { cp = p[0] & 0x07; extra = 3; }
+    else { *s += 1; return 0xFFFD; }
+
+    for (int i = 1; i <= extra; i++) {
+        if ((p[i] & 0xC0) != 0x80) { *s += i; return 0xFFFD; }
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    *s += extra + 1;
+    return cp;
+}
+
+/* ============================================================================
+ * Atlas Pages
+ * ============================================================================ */
+
+static void page_reset(rx_glyph_cache* cache, int index) {
+    rx_glyph_page* page = &cache->pages[index];
+    rx_packer_reset_page(cache->packer, index);
+    /* An empty page places the first rectangle at the origin */
+    rx_packer_insert_page(cache->packer, index, RX_GLYPH_WHITE_SIZE, RX_GLYPH_WHITE_SIZE, NULL);
+    page->glyph_count = 0;
+    page->last_used = cache->frame;
+    page->live = true;
+    if (cache->backend.page_created) cache->backend.page_created(cache->backend.ctx, index);
+}
+
+static bool page_alloc(rx_glyph_cache* cache, int index, int w, int h, int* x, int* y) {
+    rx_pack_slot slot;
+    if (!rx_packer_insert_page(cache->packer, index, w, h, &slot)) return false;
+    *x = slot.x;
+    *y = slot.y;
+    return true;
+}
+
+static bool glyph_table_grow(rx_glyph_cache* cache, int capacity);
+
+/* Rebuild the glyph table without the glyphs stored on page */
+static void page_evict(rx_glyph_cache* cache, int index) {
+    if (cache->backend.evict) cache->backend.evict(cache->backend.ctx, index);
+
+    for (int i = 0; i < cache->glyph_capacity; i++) {
+        if (cache->glyph_used[i] && cache->glyphs[i].page == index) {
+            cache->glyph_used[i] = false;
+            cache->glyph_count--;
+        }
+    }
+    /* Re-insert the survivors so probe chains stay intact */
+    glyph_table_grow(cache, cache->glyph_capacity);
+    cache->page_evictions++;
+    page_reset(cache, index);
+}
+
+/* Find room for a w x h bitmap, evicting the least recently used page if needed */
+static int atlas_alloc(rx_glyph_cache* cache, int w, int h, int* x, int* y) {
+    int free_page = -1;
+    for (int i = 0; i < RX_GLYPH_MAX_PAGES; i++) {
+        rx_glyph_page* page = &cache->pages[i];
+        if (!page->live) {
+            if (free_page < 0) free_page = i;
+            continue;
+        }
+        if (page_alloc(cache, i, w, h, x, y)) return i;
+    }
+
+    if (free_page < 0) {
+        free_page = 0;
+        for (int i = 1; i < RX_GLYPH_MAX_PAGES; i++) {
+            if (cache->pages[i].last_used < cache->pages[free_page].last_used) free_page = i;
+        }
+        page_evict(cache, free_page);
+    } else {
+        page_reset(cache, free_page);
+    }
+    return page_alloc(cache, free_page, w, h, x, y) ? free_page : -2;
+}
+
+/* ============================================================================
+ * Glyph Table
+ * ============================================================================ */
+
+static bool glyph_table_grow(rx_glyph_cache* cache, int capacity) {
+    rx_glyph* glyphs = (rx_glyph*)calloc((size_t)capacity, sizeof(rx_glyph));
+    bool* used = (bool*)calloc((size_t)capacity, sizeof(bool));
+    if (!glyphs || !used) {
+        free(glyphs);
+        free(used);
+        return false;
+    }
+
+    uint32_t mask = (uint32_t)capacity - 1;
+    for (int i = 0; i < cache->glyph_capacity; i++) {
+        if (!cache->glyph_used[i]) continue;
+        rx_glyph* g = &cache->glyphs[i];
+        uint32_t slot = hash_glyph(g->font_id, g->px, g->codepoint) & mask;
+        while (used[slot]) slot = (slot + 1) & mask;
+        glyphs[slot] = *g;
+        used[slot] = true;
+    }
+
+    free(cache->glyphs);
+    free(cache->glyph_used);
+    cache->glyphs = glyphs;
+    cache->glyph_used = used;
+    cache->glyph_capacity = capacity;
+    return true;
+}
+
+static rx_glyph* glyph_lookup(rx_glyph_cache* cache, uint32_t font_id, int px,
+                              uint32_t codepoint, uint32_t* empty_slot) {
+    uint32_t mask = (uint32_t)cache->glyph_capacity - 1;
+    uint32_t slot = hash_glyph(font_id, px, codepoint) & mask;
+    while (cache->glyph_used[slot]) {
+        rx_glyph* g = &cache->glyphs[slot];
+        if (g->codepoint == codepoint && g->font_id == font_id && g->px == px) return g;
+        slot = (slot + 1) & mask;
+    }
+    *empty_slot = slot;
+    return NULL;
+}
+
+const rx_glyph* rx_glyph_cache_get(rx_glyph_cache* cache, uint32_t font_id, int px,
+                                   uint32_t codepoint) {
+    if (!cache) return NULL;
+
+    uint32_t slot = 0;
+    rx_glyph* g = glyph_lookup(cache, font_id, px, codepoint, &slot);
+    if (g) {
+        cache->glyph_hits++;
+        if (g->page >= 0) cache->pages[g->page].last_used = cache->frame;
+        return g;
+    }
+    cache->glyph_misses++;
+
+    rx_glyph_bitmap bitmap = {0};
+    if (!cache->backend.rasterize ||
+        !cache->backend.rasterize(cache->backend.ctx, font_id, px, codepoint, &bitmap)) {
+        return NULL;
+    }
+
+    rx_glyph glyph = {
+        .font_id = font_id, .codepoint = codepoint, .px = px, .page = -1,
+        .width = bitmap.width, .height = bitmap.height,
+        .left = bitmap.left, .top = bitmap.top, .advance = bitmap.advance
+    };
+    if (bitmap.width > 0 && bitmap.height > 0) {
+        glyph.page = atlas_alloc(cache, bitmap.width, bitmap.height, &glyph.x, &glyph.y);
+        if (glyph.page < 0) return NULL;
+        if (cache->backend.upload) {
+            cache->backend.upload(cache->backend.ctx, glyph.page, glyph.x, glyph.y, &bitmap);
+        }
+        cache->pages[glyph.page].glyph_count++;
+        cache->pages[glyph.page].last_used = cache->frame;
+    }
+
+    /* Keep load under 1/2; eviction may also have reshuffled the table */
+    if ((cache->glyph_count + 1) * 2 > cache->glyph_capacity) {
+        if (!glyph_table_grow(cache, cache->glyph_capacity * 2)) return NULL;
+    }
+    if (glyph_lookup(cache, font_id, px, codepoint, &slot)) return NULL;
+
+    cache->glyphs[slot] = glyph;
+    cache->glyph_used[slot] = true;
+    cache->glyph_count++;
+    return &cache->glyphs[slot];
+}
+
+/* ============================================================================
+ * Shaped Runs
+ * ============================================================================ */
+
+static void run_release(rx_text_run* run) {
+    free(run->text);
+    free(run->glyphs);
+    memset(run, 0, sizeof(*run));
+}
+
+static bool run_shape(rx_glyph_cache* cache, rx_text_run* run, const char* text, size_t len) {
+    rx_run_glyph* glyphs = (rx_run_glyph*)malloc(sizeof(rx_run_glyph) * (len ? len : 1));
+    char* copy = (char*)malloc(len + 1);
+    if (!glyphs || !copy) {
+        free(glyphs);
+        free(copy);
+        return false;
+    }
+    memcpy(copy, text, len + 1);
+
+    float pen = 0;
+    uint32_t prev = 0;
+    int count = 0;
+    const char* s = text;
+    while (*s) {
+        uint32_t cp = rx_utf8_next(&s);
+        if (prev && cache->backend.kerning) {
+            pen += cache->backend.kerning(cache->backend.ctx, run->font_id, run->px, prev, cp);
+        }
+        const rx_glyph* g = rx_glyph_cache_get(cache, run->font_id, run->px, cp);
+        if (!g && cp != 0xFFFD) {
+            cp = 0xFFFD;
+            g = rx_glyph_cache_get(cache, run->font_id, run->px, cp);
+        }
+        glyphs[count].codepoint = cp;
+        glyphs[count].x = pen;
+        count++;
+        pen += g ? g->advance : run->px * 0.5f;
+        prev = cp;
+    }
+
+    run->text = copy;
+    run->length = len;
+    run->glyphs = glyphs;
+    run->glyph_count = count;
+    run->width = pen;
+    run->height = cache->backend.line_height
+        ? cache->backend.line_height(cache->backend.ctx, run->font_id, run->px)
+        : run->px * 1.2f;
+    return true;
+}
+
+const rx_text_run* rx_text_run_get(rx_glyph_cache* cache, uint32_t font_id, float size,
+                                   const char* text) {
+    if (!cache || !text) return NULL;
+
+    int px = rx_glyph_cache_pixel_size(cache, size);
+    size_t len = strlen(text);
+    uint64_t hash = hash_bytes(text, len) ^ ((uint64_t)font_id << 32) ^ (uint64_t)px;
+    rx_text_run* set = cache->runs[hash % RX_TEXT_RUN_SETS];
+
+    rx_text_run* victim = &set[0];
+    for (int i = 0; i < RX_TEXT_RUN_WAYS; i++) {
+        rx_text_run* run = &set[i];
+        if (run->text && run->hash == hash && run->font_id == font_id && run->px == px &&
+            run->length == len && memcmp(run->text, text, len) == 0) {
+            cache->run_hits++;
+            run->last_used = cache->frame;
+            return run;
+        }
+        if (!run->text) victim = run;
+        else if (victim->text && run->last_used < victim->last_used) victim = run;
+    }
+    cache->run_misses++;
+
+    run_release(victim);
+    victim->hash = hash;
+    victim->font_id = font_id;
+    victim->px = px;
+    victim->last_used = cache->frame;
+    if (!run_shape(cache, victim, text, len)) {
+        run_release(victim);
+        return NULL;
+    }
+    return victim;
+}
+
+void rx_text_run_measure(rx_glyph_cache* cache, uint32_t font_id, float size,
+                         const char* text, float* width, float* height) {
+    const rx_text_run* run = rx_text_run_get(cache, font_id, size, text);
+    float scale = (cache && cache->scale > 0) ? cache->scale : 1.0f;
+    if (width) *width = run ? run->width / scale : 0;
+    if (height) *height = run ? run->height / scale : size * 1.2f;
+}
+
+/* ============================================================================
+ * Cache Lifecycle
+ * ============================================================================ */
+
+rx_glyph_cache* rx_glyph_cache_create(const rx_glyph_backend* backend) {
+    rx_glyph_cache* cache = (rx_glyph_cache*)calloc(1, sizeof(rx_glyph_cache));
+    if (!cache) return NULL;
+    if (backend) cache->backend = *backend;
+    cache->scale = 1.0f;
+    cache->frame = 1;
+    cache->packer = rx_packer_create(RX_GLYPH_PAGE_SIZE, RX_GLYPH_PAGE_SIZE,
+                                     RX_GLYPH_PADDING, RX_GLYPH_MAX_PAGES);
+    if (!cache->packer || !glyph_table_grow(cache, 256)) {
+        rx_packer_destroy(cache->packer);
+        free(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void rx_glyph_cache_destroy(rx_glyph_cache* cache) {
+    if (!cache) return;
+    for (int s = 0; s < RX_TEXT_RUN_SETS; s++) {
+        for (int w = 0; w < RX_TEXT_RUN_WAYS; w++) run_release(&cache->runs[s][w]);
+    }
+    rx_packer_destroy(cache->packer);
+    free(cache->glyphs);
+    free(cache->glyph_used);
+    free(cache);
+}
+
+void rx_glyph_cache_begin_frame(rx_glyph_cache* cache) {
+    if (cache) cache->frame++;
+}
+
+void rx_glyph_cache_clear(rx_glyph_cache* cache) {
+    if (!cache) return;
+    for (int s = 0; s < RX_TEXT_RUN_SETS; s++) {
+        for (int w = 0; w < RX_TEXT_RUN_WAYS; w++) run_release(&cache->runs[s][w]);
+    }
+    for (int i = 0; i < RX_GLYPH_MAX_PAGES; i++) {
+        if (cache->pages[i].live && cache->backend.evict) cache->backend.evict(cache->backend.ctx, i);
+        cache->pages[i].live = false;
+    }
+    memset(cache->glyph_used, 0, sizeof(bool) * (size_t)cache->glyph_capacity);
+    cache->glyph_count = 0;
+}
+
+void rx_glyph_cache_set_scale(rx_glyph_cache* cache, float scale) {
+    if (!cache || scale <= 0 || scale == cache->scale) return;
+    rx_glyph_cache_clear(cache);
+    cache->scale = scale;
+}
+
+int rx_glyph_cache_pixel_size(const rx_glyph_cache* cache, float size) {
+    float scale = (cache && cache->scale > 0) ? cache->scale : 1.0f;
+    int px = (int)lroundf(size * scale);
+    return px < 1 ? 1 : px;
+}
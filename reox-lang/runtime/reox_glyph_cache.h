@@ -0,0 +1,170 @@
+/*
+ * REOX Glyph Cache
+ * Glyph atlas and shaped-run cache shared by the text renderers
+ *
+ * Features:
+ * - Glyphs rasterized once per (font, pixel size) into atlas pages
+ * - Pixel size includes the display scale factor
+ * - Skyline packing within pages (reox_atlas_packer)
+ * - LRU page eviction when the atlas is full
+ * - Shaped-run cache keyed by (string hash, font, size) so measuring
+ *   and re-drawing a label is a lookup
+ *
+ * The cache only does bookkeeping. Rasterizing glyphs and storing page
+ * pixels are done through an rx_glyph_backend supplied by the renderer
+ * (SDL_ttf, software, ...).
+ */
+
+#ifndef REOX_GLYPH_CACHE_H
+#define REOX_GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "reox_atlas_packer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Cache Constants
+ * ============================================================================ */
+
+#define RX_GLYPH_PAGE_SIZE 512      /* Atlas page width/height in pixels */
+#define RX_GLYPH_MAX_PAGES 8
+#define RX_GLYPH_PADDING 1          /* Gap between glyphs (no bleeding) */
+#define RX_GLYPH_WHITE_SIZE 2       /* Opaque block at page origin */
+#define RX_TEXT_RUN_SETS 256        /* Run cache: sets x ways entries */
+#define RX_TEXT_RUN_WAYS 4
+
+/* ============================================================================
+ * Backend Interface
+ * ============================================================================ */
+
+/* Coverage bitmap produced by the backend for a single glyph */
+typedef struct rx_glyph_bitmap {
+    int width, height;
+    int left, top;              /* Offset of the bitmap from pen x / line top */
+    float advance;              /* Pen advance in pixels */
+    const void* pixels;         /* Backend-defined format */
+    int pitch;
+} rx_glyph_bitmap;
+
+typedef struct rx_glyph_backend {
+    /* Rasterize codepoint at px. Return false if the font can't draw it. */
+    bool (*rasterize)(void* ctx, uint32_t font_id, int px, uint32_t codepoint,
+                      rx_glyph_bitmap* out);
+    /* Copy a rasterized bitmap into page at (x, y) */
+    void (*upload)(void* ctx, int page, int x, int y, const rx_glyph_bitmap* bitmap);
+    /* Page is about to be reused: flush anything drawn from it (optional) */
+    void (*evict)(void* ctx, int page);
+    /* Kerning between two codepoints in pixels (optional) */
+    float (*kerning)(void* ctx, uint32_t font_id, int px, uint32_t left, uint32_t right);
+    /* Line height in pixels (optional, defaults to 1.2 * px) */
+    float (*line_height)(void* ctx, uint32_t font_id, int px);
+    /* Page storage is needed (first use or after eviction): allocate or
+     * clear it and fill the RX_GLYPH_WHITE_SIZE block at (0, 0) opaque */
+    void (*page_created)(void* ctx, int page);
+    void* ctx;
+} rx_glyph_backend;
+
+/* ============================================================================
+ * Glyphs and Runs
+ * ============================================================================ */
+
+typedef struct rx_glyph {
+    uint32_t font_id;
+    uint32_t codepoint;
+    int px;
+    int page;                   /* -1: empty bitmap (spaces) */
+    int x, y, width, height;    /* Location in the atlas page */
+    int left, top;
+    float advance;
+} rx_glyph;
+
+typedef struct rx_run_glyph {
+    uint32_t codepoint;
+    float x;                    /* Pen position in pixels from run start */
+} rx_run_glyph;
+
+typedef struct rx_text_run {
+    uint64_t hash;
+    uint32_t font_id;
+    int px;
+    char* text;
+    size_t length;
+    rx_run_glyph* glyphs;
+    int glyph_count;
+    float width, height;        /* Pixels at px */
+    uint64_t last_used;
+} rx_text_run;
+
+typedef struct rx_glyph_page {
+    int glyph_count;
+    uint64_t last_used;
+    bool live;
+} rx_glyph_page;
+
+typedef struct rx_glyph_cache {
+    rx_glyph_backend backend;
+    float scale;                /* Display scale (1.0 = 96 DPI) */
+    uint64_t frame;
+
+    rx_glyph_page pages[RX_GLYPH_MAX_PAGES];
+    rx_atlas_packer* packer;    /* Skyline allocation within pages */
+
+    /* Open-addressing glyph table, capacity is a power of two */
+    rx_glyph* glyphs;
+    bool* glyph_used;
+    int glyph_count;
+    int glyph_capacity;
+
+    rx_text_run runs[RX_TEXT_RUN_SETS][RX_TEXT_RUN_WAYS];
+
+    /* Statistics */
+    uint64_t glyph_hits, glyph_misses;
+    uint64_t run_hits, run_misses;
+    uint64_t page_evictions;
+} rx_glyph_cache;
+
+/* ============================================================================
+ * Cache API
+ * ============================================================================ */
+
+rx_glyph_cache* rx_glyph_cache_create(const rx_glyph_backend* backend);
+void rx_glyph_cache_destroy(rx_glyph_cache* cache);
+
+/* Advance the LRU clock; call once per rendered frame */
+void rx_glyph_cache_begin_frame(rx_glyph_cache* cache);
+
+/* Set display scale (e.g. rx_display_get_primary()->scale / 100.0f).
+ * A new scale drops every cached glyph and run. */
+void rx_glyph_cache_set_scale(rx_glyph_cache* cache, float scale);
+
+/* Drop all glyphs and runs (font reload, theme change) */
+void rx_glyph_cache_clear(rx_glyph_cache* cache);
+
+/* Device pixel size used for a logical point size */
+int rx_glyph_cache_pixel_size(const rx_glyph_cache* cache, float size);
+
+/* Glyph lookup; rasterizes and packs on a miss. NULL if unsupported. */
+const rx_glyph* rx_glyph_cache_get(rx_glyph_cache* cache, uint32_t font_id, int px,
+                                   uint32_t codepoint);
+
+/* Shaped run for UTF-8 text at logical size; cached by content */
+const rx_text_run* rx_text_run_get(rx_glyph_cache* cache, uint32_t font_id, float size,
+                                   const char* text);
+
+/* Logical size of text (device pixels divided by scale) */
+void rx_text_run_measure(rx_glyph_cache* cache, uint32_t font_id, float size,
+                         const char* text, float* width, float* height);
+
+/* Decode one UTF-8 codepoint, advancing *s. Invalid bytes give U+FFFD. */
+uint32_t rx_utf8_next(const char** s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_GLYPH_CACHE_H */
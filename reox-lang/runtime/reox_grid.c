@@ -0,0 +1,855 @@
+/*
+ * REOX Grid Layout - Implementation
+ * Grid placement and track sizing, cached between layout passes
+ */
+
+#include "reox_grid.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static inline float clampf(float v, float lo, float hi) {
+    if (v > hi) v = hi;
+    if (v < lo) v = lo;
+    return v;
+}
+
+static bool grow_array(void** array, size_t* capacity, size_t need, size_t elem) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    void* grown = realloc(*array, cap * elem);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = cap;
+    return true;
+}
+
+/* Sizes and positions of one axis share a capacity */
+static bool reserve_tracks(float** sizes, float** pos, size_t* capacity, size_t need) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    float* s = (float*)realloc(*sizes, sizeof(float) * cap);
+    if (s) *sizes = s;
+    float* p = (float*)realloc(*pos, sizeof(float) * cap);
+    if (p) *pos = p;
+    if (!s || !p) return false;
+    *capacity = cap;
+    return true;
+}
+
+/* ============================================================================
+ * Grid View
+ * ============================================================================ */
+
+rx_grid_view* grid_view_new(int columns, int rows) {
+    rx_grid_view* g = (rx_grid_view*)calloc(1, sizeof(rx_grid_view));
+    if (!g) return NULL;
+
+    g->base.kind = RX_VIEW_GRID;
+    g->base.box = box_new();
+    g->base.layout = vstack(0);
+    g->base.visible = true;
+    g->base.enabled = true;
+
+    rx_grid_layout* l = &g->layout;
+    l->justify_items = RX_ALIGN_STRETCH;
+    l->align_items = RX_ALIGN_STRETCH;
+    l->justify_content = RX_ALIGN_START;
+    l->align_content = RX_ALIGN_START;
+    l->auto_flow_row = true;
+    l->auto_rows = track_auto();
+    l->auto_columns = track_auto();
+
+    if (columns > 0) {
+        l->columns = (rx_track_size*)malloc(sizeof(rx_track_size) * (size_t)columns);
+        if (l->columns) {
+            for (int i = 0; i < columns; i++) l->columns[i] = track_fr(1);
+            l->column_count = columns;
+        }
+    }
+    if (rows > 0) {
+        l->rows = (rx_track_size*)malloc(sizeof(rx_track_size) * (size_t)rows);
+        if (l->rows) {
+            for (int i = 0; i < rows; i++) l->rows[i] = track_auto();
+            l->row_count = rows;
+        }
+    }
+    return g;
+}
+
+void grid_view_invalidate(rx_grid_view* grid) {
+    if (!grid) return;
+    grid->placement_valid = false;
+    grid->tracks_valid = false;
+    grid->content_valid = false;
+    view_set_needs_layout(&grid->base);
+}
+
+void grid_view_add_item(rx_grid_view* grid, rx_view* item, rx_grid_placement placement) {
+    if (!grid || !item) return;
+    size_t index = grid->base.child_count;
+    if (!grow_array((void**)&grid->placements, &grid->placement_capacity, index + 1,
+                    sizeof(rx_grid_placement))) {
+        return;
+    }
+    /* Children added with view_add_child are auto-placed */
+    for (size_t i = grid->placement_count; i < index; i++) grid->placements[i] = grid_auto();
+    grid->placements[index] = placement;
+    grid->placement_count = index + 1;
+
+    view_add_child(&grid->base, item);
+    grid_view_invalidate(grid);
+}
+
+void grid_view_remove_item_at(rx_grid_view* grid, size_t index) {
+    if (!grid) return;
+    /* Later children keep their own placements and cached sizes */
+    if (index < grid->placement_count) {
+        memmove(&grid->placements[index], &grid->placements[index + 1],
+                sizeof(rx_grid_placement) * (grid->placement_count - index - 1));
+        grid->placement_count--;
+    }
+    if (index < grid->item_count) {
+        size_t tail = grid->item_count - index - 1;
+        memmove(&grid->cells[index], &grid->cells[index + 1], sizeof(rx_grid_cell) * tail);
+        memmove(&grid->contributions[index], &grid->contributions[index + 1], sizeof(rx_size) * tail);
+        grid->item_count--;
+    }
+    grid_view_invalidate(grid);
+}
+
+void grid_view_set_gap(rx_grid_view* grid, float column_gap, float row_gap) {
+    if (!grid) return;
+    grid->layout.column_gap = column_gap;
+    grid->layout.row_gap = row_gap;
+    grid_view_invalidate(grid);
+}
+
+static void set_tracks(rx_track_size** tracks, int* count, const rx_track_size* src, int n) {
+    free(*tracks);
+    *tracks = NULL;
+    *count = 0;
+    if (!src || n <= 0) return;
+    *tracks = (rx_track_size*)malloc(sizeof(rx_track_size) * (size_t)n);
+    if (!*tracks) return;
+    memcpy(*tracks, src, sizeof(rx_track_size) * (size_t)n);
+    *count = n;
+}
+
+void grid_view_set_columns(rx_grid_view* grid, rx_track_size* cols, int count) {
+    if (!grid) return;
+    set_tracks(&grid->layout.columns, &grid->layout.column_count, cols, count);
+    grid_view_invalidate(grid);
+}
+
+void grid_view_set_rows(rx_grid_view* grid, rx_track_size* rows, int count) {
+    if (!grid) return;
+    set_tracks(&grid->layout.rows, &grid->layout.row_count, rows, count);
+    grid_view_invalidate(grid);
+}
+
+void grid_view_set_auto_rows(rx_grid_view* grid, rx_track_size size) {
+    if (!grid) return;
+    grid->layout.auto_rows = size;
+    grid_view_invalidate(grid);
+}
+
+void grid_view_release(rx_grid_view* grid) {
+    free(grid->layout.columns);
+    free(grid->layout.rows);
+    free(grid->placements);
+    free(grid->cells);
+    free(grid->contributions);
+    free(grid->occupancy);
+    free(grid->column_sizes);
+    free(grid->column_pos);
+    free(grid->row_sizes);
+    free(grid->row_pos);
+}
+
+/* ============================================================================
+ * Items
+ * ============================================================================ */
+
+static rx_grid_placement item_placement(const rx_grid_view* g, size_t i) {
+    if (i < g->placement_count) return g->placements[i];
+    rx_grid_placement p = grid_auto();
+    p.justify_self = g->layout.justify_items;
+    p.align_self = g->layout.align_items;
+    return p;
+}
+
+static bool track_same(rx_track_size a, rx_track_size b) {
+    return a.type == b.type && a.value == b.value && a.min == b.min && a.max == b.max;
+}
+
+static bool track_is_range(rx_track_size t) {
+    return t.type == RX_TRACK_FIXED && (t.min > 0 || t.max > 0);
+}
+
+static bool track_is_intrinsic(rx_track_size t) {
+    return t.type != RX_TRACK_FIXED && t.type != RX_TRACK_FR;
+}
+
+/* Every cell the same size and every item a single auto-placed cell */
+static bool grid_is_uniform(const rx_grid_view* g) {
+    const rx_grid_layout* l = &g->layout;
+    if (!l->auto_flow_row || l->column_count < 1) return false;
+
+    rx_track_size col = l->columns[0];
+    if (track_is_range(col) || (col.type != RX_TRACK_FIXED && col.type != RX_TRACK_FR)) return false;
+    for (int i = 1; i < l->column_count; i++) {
+        if (!track_same(l->columns[i], col)) return false;
+    }
+    rx_track_size row = l->auto_rows;
+    if (row.type != RX_TRACK_FIXED || track_is_range(row)) return false;
+    for (int i = 0; i < l->row_count; i++) {
+        if (!track_same(l->rows[i], row)) return false;
+    }
+    for (size_t i = 0; i < g->placement_count; i++) {
+        rx_grid_placement p = g->placements[i];
+        if (p.column_start >= 0 || p.row_start >= 0 || p.column_end != -1 || p.row_end != -1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Match the cache to the children; false if out of memory */
+static bool grid_sync(rx_grid_view* g) {
+    size_t n = g->base.child_count;
+    if (n > g->item_capacity) {
+        size_t cap = g->item_capacity ? g->item_capacity : 16;
+        while (cap < n) cap *= 2;
+        rx_grid_cell* cells = (rx_grid_cell*)realloc(g->cells, sizeof(rx_grid_cell) * cap);
+        if (cells) g->cells = cells;
+        rx_size* contributions = (rx_size*)realloc(g->contributions, sizeof(rx_size) * cap);
+        if (contributions) g->contributions = contributions;
+        if (!cells || !contributions) return false;
+        g->item_capacity = cap;
+    }
+    if (n != g->item_count) {
+        for (size_t i = g->item_count; i < n; i++) {
+            memset(&g->cells[i], 0, sizeof(rx_grid_cell));
+            g->contributions[i] = size(-1, -1);
+        }
+        g->item_count = n;
+        g->placement_valid = false;
+    }
+    if (!g->placement_valid) {
+        g->uniform = grid_is_uniform(g);
+        g->tracks_valid = false;
+        g->content_valid = false;
+        /* Uniform grids place by index and keep no cells */
+        g->placement_valid = g->uniform;
+    }
+    return true;
+}
+
+/* Whether any track on either axis is sized from its items */
+static bool grid_sizes_from_items(const rx_grid_view* g) {
+    const rx_grid_layout* l = &g->layout;
+    if (track_is_intrinsic(l->auto_columns) || track_is_intrinsic(l->auto_rows)) return true;
+    for (int i = 0; i < l->column_count; i++) {
+        if (track_is_intrinsic(l->columns[i])) return true;
+    }
+    for (int i = 0; i < l->row_count; i++) {
+        if (track_is_intrinsic(l->rows[i])) return true;
+    }
+    return false;
+}
+
+/* Re-read each item's visibility and measured size. Measurement is
+ * cached per view, so only items changed since the last pass do work;
+ * tracks are re-sized only if a contribution actually moved. */
+static void grid_refresh_items(rx_grid_view* g) {
+    bool changed = false;
+    for (size_t i = 0; i < g->item_count; i++) {
+        rx_view* child = g->base.children[i];
+        if (child->visible != g->cells[i].visible) {
+            g->cells[i].visible = child->visible;
+            g->placement_valid = false;
+        }
+        if (!child->visible) continue;
+
+        rx_size m = view_preferred_size(child);
+        rx_edge_insets mg = child->box.margin;
+        m.width += mg.left + mg.right;
+        m.height += mg.top + mg.bottom;
+        if (m.width != g->contributions[i].width || m.height != g->contributions[i].height) {
+            g->contributions[i] = m;
+            changed = true;
+        }
+    }
+    if (!g->placement_valid) {
+        g->tracks_valid = false;
+        g->content_valid = false;
+    } else if (changed) {
+        g->content_valid = false;
+        if (grid_sizes_from_items(g)) g->tracks_valid = false;
+    }
+}
+
+/* ============================================================================
+ * Placement
+ * ============================================================================ */
+
+/* Occupancy is stored flow-major: one row of minor_count cells per
+ * row (or per column in column flow) */
+typedef struct grid_flow {
+    int minor_count;
+    int majors;         /* Rows with storage */
+    int used;           /* Rows in use, at least the defined ones */
+    bool failed;
+} grid_flow;
+
+static bool flow_reserve(rx_grid_view* g, grid_flow* f, int majors) {
+    if (majors <= f->majors || f->failed) return !f->failed;
+    size_t have = (size_t)f->majors * f->minor_count;
+    size_t need = (size_t)majors * f->minor_count;
+    if (!grow_array((void**)&g->occupancy, &g->occupancy_capacity, need, sizeof(int))) {
+        f->failed = true;
+        return false;
+    }
+    memset(g->occupancy + have, 0, (need - have) * sizeof(int));
+    f->majors = majors;
+    return true;
+}
+
+/* Area free; also true after an allocation failure so searches end */
+static bool flow_free(rx_grid_view* g, grid_flow* f, int minor, int major,
+                      int minor_span, int major_span) {
+    if (!flow_reserve(g, f, major + major_span)) return true;
+    for (int r = major; r < major + major_span; r++) {
+        const int* row = g->occupancy + (size_t)r * f->minor_count;
+        for (int c = minor; c < minor + minor_span; c++) {
+            if (row[c]) return false;
+        }
+    }
+    return true;
+}
+
+static void flow_mark(rx_grid_view* g, grid_flow* f, int minor, int major,
+                      int minor_span, int major_span, size_t item) {
+    if (!flow_reserve(g, f, major + major_span)) return;
+    for (int r = major; r < major + major_span; r++) {
+        int* row = g->occupancy + (size_t)r * f->minor_count;
+        for (int c = minor; c < minor + minor_span; c++) row[c] = (int)item + 1;
+    }
+    if (major + major_span > f->used) f->used = major + major_span;
+}
+
+/* Start track (-1: auto) and span of one axis of a placement */
+static void placement_axis(int start, int end, int* out_start, int* out_span) {
+    int span = 1;
+    if (end < 0) {
+        span = -end;
+    } else if (start >= 0) {
+        span = end - start;
+    } else {
+        start = end > 0 ? end - 1 : 0;
+    }
+    *out_start = start;
+    *out_span = span < 1 ? 1 : span;
+}
+
+/* Items fixed on both axes first, then those fixed on the flow axis,
+ * then the rest in order behind a cursor (from the start for dense) */
+static void grid_place_items(rx_grid_view* g) {
+    const rx_grid_layout* l = &g->layout;
+    bool by_row = l->auto_flow_row;
+    grid_flow f = { by_row ? l->column_count : l->row_count, 0,
+                    by_row ? l->row_count : l->column_count, false };
+    if (f.minor_count < 1) f.minor_count = 1;
+
+    for (int pass = 1; pass <= 3; pass++) {
+        int cursor_minor = 0, cursor_major = 0;
+        for (size_t i = 0; i < g->item_count; i++) {
+            rx_grid_cell* cell = &g->cells[i];
+            if (!cell->visible) continue;
+
+            rx_grid_placement p = item_placement(g, i);
+            int c0, cs, r0, rs;
+            placement_axis(p.column_start, p.column_end, &c0, &cs);
+            placement_axis(p.row_start, p.row_end, &r0, &rs);
+            int minor = by_row ? c0 : r0, minor_span = by_row ? cs : rs;
+            int major = by_row ? r0 : c0, major_span = by_row ? rs : cs;
+            if (minor_span > f.minor_count) minor_span = f.minor_count;
+            if (minor >= 0 && minor + minor_span > f.minor_count) minor = f.minor_count - minor_span;
+
+            int kind = minor >= 0 && major >= 0 ? 1 : (major >= 0 ? 2 : 3);
+            if (kind != pass) continue;
+
+            if (pass == 2) {
+                minor = 0;
+                while (minor + minor_span < f.minor_count &&
+                       !flow_free(g, &f, minor, major, minor_span, major_span)) {
+                    minor++;
+                }
+            } else if (pass == 3) {
+                if (l->auto_flow_dense) {
+                    cursor_minor = 0;
+                    cursor_major = 0;
+                }
+                if (minor >= 0) {
+                    if (minor < cursor_minor) cursor_major++;
+                    while (!flow_free(g, &f, minor, cursor_major, minor_span, major_span)) {
+                        cursor_major++;
+                    }
+                } else {
+                    for (;;) {
+                        if (cursor_minor + minor_span > f.minor_count) {
+                            cursor_major++;
+                            cursor_minor = 0;
+                        } else if (flow_free(g, &f, cursor_minor, cursor_major,
+                                             minor_span, major_span)) {
+                            break;
+                        } else {
+                            cursor_minor++;
+                        }
+                    }
+                    minor = cursor_minor;
+                }
+                major = cursor_major;
+                cursor_minor = minor + minor_span;
+            }
+
+            flow_mark(g, &f, minor, major, minor_span, major_span, i);
+            cell->column = by_row ? minor : major;
+            cell->row = by_row ? major : minor;
+            cell->column_end = cell->column + (by_row ? minor_span : major_span);
+            cell->row_end = cell->row + (by_row ? major_span : minor_span);
+        }
+    }
+
+    /* Storage for every cell, so grid_view_item_at can index it */
+    flow_reserve(g, &f, f.used);
+    g->column_count = by_row ? f.minor_count : f.used;
+    g->row_count = by_row ? f.used : f.minor_count;
+    g->placement_valid = true;
+    g->placements_run++;
+}
+
+/* ============================================================================
+ * Track Sizing
+ * ============================================================================ */
+
+static rx_track_size grid_track(const rx_grid_view* g, bool columns, int i) {
+    const rx_grid_layout* l = &g->layout;
+    if (columns) return i < l->column_count ? l->columns[i] : l->auto_columns;
+    return i < l->row_count ? l->rows[i] : l->auto_rows;
+}
+
+/*
+ * Size count tracks of one axis into sizes. available < 0 sizes to
+ * content: fr tracks then get the share needed by their largest item.
+ * Steps follow CSS grid: fixed bases, intrinsic tracks from single-track
+ * items, spanning items spread over the intrinsic tracks they cross,
+ * minmax tracks grown toward their maximum, then fr tracks share the
+ * remaining space. Returns the tracks plus gaps.
+ */
+static float grid_size_tracks(rx_grid_view* g, bool columns, float available,
+                              float* sizes, int count) {
+    float gap = columns ? g->layout.column_gap : g->layout.row_gap;
+    rx_alignment content_align = columns ? g->layout.justify_content : g->layout.align_content;
+    float fr_total = 0, flex_unit = 0;
+    int intrinsic = 0;
+
+    for (int i = 0; i < count; i++) {
+        rx_track_size t = grid_track(g, columns, i);
+        sizes[i] = 0;
+        if (t.type == RX_TRACK_FIXED) sizes[i] = track_is_range(t) ? t.min : t.value;
+        else if (t.type == RX_TRACK_FR) fr_total += t.value;
+        else intrinsic++;
+    }
+
+    if (intrinsic > 0 || (available < 0 && fr_total > 0)) {
+        bool spanning = false;
+        for (size_t i = 0; i < g->item_count; i++) {
+            const rx_grid_cell* c = &g->cells[i];
+            if (!c->visible) continue;
+            int start = columns ? c->column : c->row;
+            int end = columns ? c->column_end : c->row_end;
+            float contrib = columns ? g->contributions[i].width : g->contributions[i].height;
+            if (end - start != 1) {
+                spanning = true;
+                continue;
+            }
+
+            rx_track_size t = grid_track(g, columns, start);
+            if (track_is_intrinsic(t)) {
+                float limit = t.value > 0 ? t.value : t.max;
+                if (t.type == RX_TRACK_FIT_CONTENT && limit > 0 && contrib > limit) contrib = limit;
+                if (contrib > sizes[start]) sizes[start] = contrib;
+            } else if (t.type == RX_TRACK_FR && available < 0 && t.value > 0) {
+                if (contrib / t.value > flex_unit) flex_unit = contrib / t.value;
+            }
+        }
+
+        for (size_t i = 0; spanning && intrinsic > 0 && i < g->item_count; i++) {
+            const rx_grid_cell* c = &g->cells[i];
+            int start = columns ? c->column : c->row;
+            int end = columns ? c->column_end : c->row_end;
+            if (!c->visible || end - start == 1) continue;
+
+            /* Items crossing a flexible track leave the sizing to it */
+            float spanned = gap * (end - start - 1);
+            int grow = 0;
+            bool flexible = false;
+            for (int k = start; k < end; k++) {
+                rx_track_size t = grid_track(g, columns, k);
+                spanned += sizes[k];
+                if (t.type == RX_TRACK_FR) flexible = true;
+                if (track_is_intrinsic(t)) grow++;
+            }
+            float contrib = columns ? g->contributions[i].width : g->contributions[i].height;
+            if (flexible || grow == 0 || contrib <= spanned) continue;
+
+            float extra = (contrib - spanned) / grow;
+            for (int k = start; k < end; k++) {
+                if (track_is_intrinsic(grid_track(g, columns, k))) sizes[k] += extra;
+            }
+        }
+    }
+
+    float used = count > 1 ? gap * (count - 1) : 0;
+    for (int i = 0; i < count; i++) used += sizes[i];
+
+    if (available >= 0) {
+        float free = available - used;
+        while (free > 0.01f) {
+            int growable = 0;
+            for (int i = 0; i < count; i++) {
+                rx_track_size t = grid_track(g, columns, i);
+                if (track_is_range(t) && (t.max <= 0 || sizes[i] < t.max)) growable++;
+            }
+            if (growable == 0) break;
+            float share = free / growable;
+            for (int i = 0; i < count; i++) {
+                rx_track_size t = grid_track(g, columns, i);
+                if (!track_is_range(t) || (t.max > 0 && sizes[i] >= t.max)) continue;
+                float add = t.max > 0 && sizes[i] + share > t.max ? t.max - sizes[i] : share;
+                sizes[i] += add;
+                free -= add;
+            }
+        }
+
+        if (fr_total > 0) {
+            /* Fractions summing below 1 take only that part of the space */
+            float unit = free > 0 ? free / (fr_total > 1 ? fr_total : 1) : 0;
+            for (int i = 0; i < count; i++) {
+                rx_track_size t = grid_track(g, columns, i);
+                if (t.type == RX_TRACK_FR) sizes[i] = unit * t.value;
+            }
+        } else if (free > 0 && intrinsic > 0 && content_align == RX_ALIGN_STRETCH) {
+            for (int i = 0; i < count; i++) {
+                if (track_is_intrinsic(grid_track(g, columns, i))) sizes[i] += free / intrinsic;
+            }
+        }
+    } else if (fr_total > 0) {
+        for (int i = 0; i < count; i++) {
+            rx_track_size t = grid_track(g, columns, i);
+            if (t.type == RX_TRACK_FR) sizes[i] = flex_unit * t.value;
+        }
+    }
+
+    used = count > 1 ? gap * (count - 1) : 0;
+    for (int i = 0; i < count; i++) used += sizes[i];
+    return used;
+}
+
+/* Leading offset and extra spacing between tracks for content alignment */
+static void grid_distribute(rx_alignment align, float leftover, int count,
+                            float* start, float* between) {
+    *start = 0;
+    *between = 0;
+    if (leftover <= 0 || count <= 0) return;
+    switch (align) {
+        case RX_ALIGN_CENTER: *start = leftover * 0.5f; break;
+        case RX_ALIGN_END: *start = leftover; break;
+        case RX_ALIGN_SPACE_BETWEEN:
+            if (count > 1) *between = leftover / (count - 1);
+            break;
+        case RX_ALIGN_SPACE_AROUND:
+            *between = leftover / count;
+            *start = *between * 0.5f;
+            break;
+        case RX_ALIGN_SPACE_EVENLY:
+            *between = leftover / (count + 1);
+            *start = *between;
+            break;
+        default:
+            break;
+    }
+}
+
+static void grid_positions(const float* sizes, float* pos, int count, float gap,
+                           float available, float used, rx_alignment align) {
+    float p, between;
+    grid_distribute(align, available - used, count, &p, &between);
+    for (int i = 0; i < count; i++) {
+        pos[i] = p;
+        p += sizes[i] + gap + between;
+    }
+}
+
+/* ============================================================================
+ * Measure and Arrange
+ * ============================================================================ */
+
+/* Frame of child in a cell; margins are inside the cell */
+static void grid_place(rx_view* child, float x, float y, float w, float h,
+                       rx_alignment justify, rx_alignment align) {
+    rx_box* b = &child->box;
+    rx_edge_insets m = b->margin;
+    float cw = w - m.left - m.right;
+    float ch = h - m.top - m.bottom;
+    float fw, fh;
+
+    if (justify == RX_ALIGN_STRETCH && b->width < 0) fw = clampf(cw, b->min_width, b->max_width);
+    else fw = view_preferred_size(child).width;
+    if (align == RX_ALIGN_STRETCH && b->height < 0) fh = clampf(ch, b->min_height, b->max_height);
+    else fh = view_preferred_size(child).height;
+
+    float dx = justify == RX_ALIGN_CENTER ? (cw - fw) * 0.5f : justify == RX_ALIGN_END ? cw - fw : 0;
+    float dy = align == RX_ALIGN_CENTER ? (ch - fh) * 0.5f : align == RX_ALIGN_END ? ch - fh : 0;
+    b->frame.x = x + m.left + dx;
+    b->frame.y = y + m.top + dy;
+    b->frame.width = fw;
+    b->frame.height = fh;
+}
+
+static size_t grid_visible_count(const rx_grid_view* g) {
+    size_t n = 0;
+    for (size_t i = 0; i < g->base.child_count; i++) {
+        if (g->base.children[i]->visible) n++;
+    }
+    return n;
+}
+
+/* Column width of a uniform grid; fr columns need the available width */
+static float uniform_column_width(const rx_grid_view* g, float inner_w) {
+    const rx_grid_layout* l = &g->layout;
+    if (l->columns[0].type == RX_TRACK_FIXED) return l->columns[0].value;
+    float w = (inner_w - l->column_gap * (l->column_count - 1)) / l->column_count;
+    return w > 0 ? w : 0;
+}
+
+static rx_size grid_measure_uniform(rx_grid_view* g) {
+    const rx_grid_layout* l = &g->layout;
+    int cols = l->column_count;
+    size_t rows = (grid_visible_count(g) + cols - 1) / cols;
+    if ((int)rows < l->row_count) rows = (size_t)l->row_count;
+
+    float col_w = l->columns[0].value;
+    if (l->columns[0].type == RX_TRACK_FR) {
+        /* Content size: every column as wide as the widest item */
+        grid_refresh_items(g);
+        float widest = 0;
+        for (size_t i = 0; i < g->item_count; i++) {
+            if (g->cells[i].visible && g->contributions[i].width > widest) {
+                widest = g->contributions[i].width;
+            }
+        }
+        col_w = widest;
+    }
+    float w = cols * col_w + (cols - 1) * l->column_gap;
+    float h = rows ? rows * l->auto_rows.value + (rows - 1) * l->row_gap : 0;
+    return size(w, h);
+}
+
+rx_size grid_view_measure(rx_grid_view* grid) {
+    if (!grid || !grid_sync(grid)) return size(0, 0);
+    if (grid->uniform) return grid_measure_uniform(grid);
+
+    grid_refresh_items(grid);
+    if (!grid->placement_valid) grid_place_items(grid);
+    if (grid->content_valid) return grid->content;
+
+    if (!reserve_tracks(&grid->column_sizes, &grid->column_pos, &grid->column_capacity,
+                        (size_t)grid->column_count) ||
+        !reserve_tracks(&grid->row_sizes, &grid->row_pos, &grid->row_capacity,
+                        (size_t)grid->row_count)) {
+        return size(0, 0);
+    }
+    /* Content sizing overwrites the tracks the last arrange left */
+    grid->content.width = grid_size_tracks(grid, true, -1, grid->column_sizes, grid->column_count);
+    grid->content.height = grid_size_tracks(grid, false, -1, grid->row_sizes, grid->row_count);
+    grid->content_valid = true;
+    grid->tracks_valid = false;
+    return grid->content;
+}
+
+/* Equal cells: positions are index arithmetic, nothing is measured
+ * unless an item is aligned rather than stretched */
+static void grid_arrange_uniform(rx_grid_view* g, float inner_w, float inner_h) {
+    const rx_grid_layout* l = &g->layout;
+    int cols = l->column_count;
+    size_t visible = 0;
+    bool reflow = !g->tracks_valid ||
+                  g->tracks_for.width != inner_w || g->tracks_for.height != inner_h;
+    for (size_t i = 0; i < g->item_count; i++) {
+        bool shown = g->base.children[i]->visible;
+        if (shown != g->cells[i].visible) {
+            g->cells[i].visible = shown;
+            reflow = true;
+        }
+        visible += shown;
+    }
+    float col_w = uniform_column_width(g, inner_w);
+    float row_h = l->auto_rows.value;
+
+    /* Same cells as last time: only items whose own layout changed move */
+    if (reflow) {
+        int rows = (int)((visible + cols - 1) / cols);
+        if (rows < l->row_count) rows = l->row_count;
+        if (!reserve_tracks(&g->column_sizes, &g->column_pos, &g->column_capacity, (size_t)cols) ||
+            !reserve_tracks(&g->row_sizes, &g->row_pos, &g->row_capacity, (size_t)rows)) {
+            return;
+        }
+        float x0, x_step, y0, y_step;
+        grid_distribute(l->justify_content, inner_w - cols * col_w - (cols - 1) * l->column_gap,
+                        cols, &x0, &x_step);
+        grid_distribute(l->align_content, inner_h - rows * row_h - (rows - 1) * l->row_gap,
+                        rows, &y0, &y_step);
+        x_step += col_w + l->column_gap;
+        y_step += row_h + l->row_gap;
+        for (int c = 0; c < cols; c++) {
+            g->column_sizes[c] = col_w;
+            g->column_pos[c] = x0 + c * x_step;
+        }
+        for (int r = 0; r < rows; r++) {
+            g->row_sizes[r] = row_h;
+            g->row_pos[r] = y0 + r * y_step;
+        }
+        g->column_count = cols;
+        g->row_count = rows;
+        g->tracks_for = size(inner_w, inner_h);
+        g->tracks_valid = true;
+    }
+
+    rx_edge_insets pad = g->base.box.padding;
+    size_t k = 0;
+    for (size_t i = 0; i < g->base.child_count; i++) {
+        rx_view* child = g->base.children[i];
+        if (!child->visible) continue;
+        if (!reflow && child->layout_valid) {
+            k++;
+            continue;
+        }
+        rx_grid_placement p = item_placement(g, i);
+        int c = (int)(k % (size_t)cols), r = (int)(k / (size_t)cols);
+        grid_place(child, pad.left + g->column_pos[c], pad.top + g->row_pos[r],
+                   col_w, row_h, p.justify_self, p.align_self);
+        k++;
+    }
+}
+
+void grid_view_arrange(rx_grid_view* grid, float inner_w, float inner_h) {
+    if (!grid || !grid_sync(grid)) return;
+    if (grid->uniform) {
+        grid_arrange_uniform(grid, inner_w, inner_h);
+        return;
+    }
+
+    grid_refresh_items(grid);
+    if (!grid->placement_valid) grid_place_items(grid);
+    int cols = grid->column_count, rows = grid->row_count;
+    if (!reserve_tracks(&grid->column_sizes, &grid->column_pos, &grid->column_capacity,
+                        (size_t)cols) ||
+        !reserve_tracks(&grid->row_sizes, &grid->row_pos, &grid->row_capacity, (size_t)rows)) {
+        return;
+    }
+
+    /* Tracks depend on the inner size and the contributions only */
+    if (!grid->tracks_valid ||
+        grid->tracks_for.width != inner_w || grid->tracks_for.height != inner_h) {
+        const rx_grid_layout* l = &grid->layout;
+        float used_w = grid_size_tracks(grid, true, inner_w, grid->column_sizes, cols);
+        float used_h = grid_size_tracks(grid, false, inner_h, grid->row_sizes, rows);
+        grid_positions(grid->column_sizes, grid->column_pos, cols, l->column_gap,
+                       inner_w, used_w, l->justify_content);
+        grid_positions(grid->row_sizes, grid->row_pos, rows, l->row_gap,
+                       inner_h, used_h, l->align_content);
+        grid->tracks_for = size(inner_w, inner_h);
+        grid->tracks_valid = true;
+        grid->track_resolves++;
+    }
+
+    rx_edge_insets pad = grid->base.box.padding;
+    for (size_t i = 0; i < grid->item_count; i++) {
+        const rx_grid_cell* c = &grid->cells[i];
+        if (!c->visible) continue;
+        rx_grid_placement p = item_placement(grid, i);
+        float x = grid->column_pos[c->column];
+        float y = grid->row_pos[c->row];
+        float w = grid->column_pos[c->column_end - 1] + grid->column_sizes[c->column_end - 1] - x;
+        float h = grid->row_pos[c->row_end - 1] + grid->row_sizes[c->row_end - 1] - y;
+        grid_place(grid->base.children[i], pad.left + x, pad.top + y, w, h,
+                   p.justify_self, p.align_self);
+    }
+}
+
+/* ============================================================================
+ * Queries
+ * ============================================================================ */
+
+/* Track containing v, -1 if v falls in a gap or outside */
+static int track_at(const float* pos, const float* sizes, int count, float v) {
+    if (count <= 0 || v < pos[0]) return -1;
+    int lo = 0, hi = count;
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        if (pos[mid] <= v) lo = mid;
+        else hi = mid;
+    }
+    return v < pos[lo] + sizes[lo] ? lo : -1;
+}
+
+int grid_view_item_at(rx_grid_view* grid, rx_point pos) {
+    if (!grid || !grid->tracks_valid) return -1;
+    rx_edge_insets pad = grid->base.box.padding;
+    int c = track_at(grid->column_pos, grid->column_sizes, grid->column_count, pos.x - pad.left);
+    int r = track_at(grid->row_pos, grid->row_sizes, grid->row_count, pos.y - pad.top);
+    if (c < 0 || r < 0) return -1;
+
+    if (grid->uniform) {
+        size_t k = (size_t)r * (size_t)grid->column_count + (size_t)c;
+        if (grid_visible_count(grid) == grid->base.child_count) {
+            return k < grid->base.child_count ? (int)k : -1;
+        }
+        for (size_t i = 0; i < grid->base.child_count; i++) {
+            if (!grid->base.children[i]->visible) continue;
+            if (k-- == 0) return (int)i;
+        }
+        return -1;
+    }
+
+    size_t cell = grid->layout.auto_flow_row
+        ? (size_t)r * (size_t)grid->column_count + (size_t)c
+        : (size_t)c * (size_t)grid->row_count + (size_t)r;
+    return grid->occupancy ? grid->occupancy[cell] - 1 : -1;
+}
+
+bool grid_view_items_in(rx_grid_view* grid, float top, float bottom, int* first, int* last) {
+    if (!grid || !grid->uniform || !grid->tracks_valid || grid->row_count == 0) return false;
+    if (grid_visible_count(grid) != grid->base.child_count) return false;
+
+    float origin = grid->base.box.padding.top + grid->row_pos[0];
+    float step = grid->row_count > 1 ? grid->row_pos[1] - grid->row_pos[0]
+                                     : grid->row_sizes[0] + grid->layout.row_gap;
+    if (step <= 0) return false;
+
+    int r0 = (int)floorf((top - origin) / step);
+    int r1 = (int)floorf((bottom - origin) / step);
+    if (r0 < 0) r0 = 0;
+    if (r1 >= grid->row_count) r1 = grid->row_count - 1;
+    int cols = grid->column_count;
+    int n = (int)grid->base.child_count;
+    *first = r0 * cols;
+    *last = (r1 + 1) * cols - 1;
+    if (*last >= n) *last = n - 1;
+    return *first <= *last;
+}
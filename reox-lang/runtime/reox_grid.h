@@ -85,7 +85,9 @@ typedef struct rx_grid_layout {
     rx_track_size auto_columns;   /* Size for implicitly created columns */
 } rx_grid_layout;
 
-/* Grid item placement */
+/* Grid item placement. Tracks are numbered from 0; a start of -1 is
+ * auto-placed, an end >= 0 is the exclusive end track and an end < 0
+ * spans -end tracks. */
 typedef struct rx_grid_placement {
     int column_start;
     int column_end;           /* -1 = span 1 */
@@ -95,6 +97,20 @@ typedef struct rx_grid_placement {
     rx_alignment align_self;
 } rx_grid_placement;
 
+RX_INLINE rx_grid_placement grid_auto(void) {
+    return (rx_grid_placement){ -1, -1, -1, -1, RX_ALIGN_STRETCH, RX_ALIGN_STRETCH };
+}
+
+RX_INLINE rx_grid_placement grid_cell(int column, int row) {
+    return (rx_grid_placement){ column, -1, row, -1, RX_ALIGN_STRETCH, RX_ALIGN_STRETCH };
+}
+
+/* column/row may be -1 to auto-place an item of the given span */
+RX_INLINE rx_grid_placement grid_area(int column, int row, int column_span, int row_span) {
+    return (rx_grid_placement){ column, -column_span, row, -row_span,
+                                RX_ALIGN_STRETCH, RX_ALIGN_STRETCH };
+}
+
 /* ============================================================================
  * Responsive Grid
  * ============================================================================ */
@@ -116,21 +132,86 @@ float rx_rgrid_get_gap(rx_responsive_grid *grid);
  * Grid View
  * ============================================================================ */
 
+/* Resolved area of one item in tracks, ends exclusive */
+typedef struct rx_grid_cell {
+    int column, row;
+    int column_end, row_end;
+    bool visible;
+} rx_grid_cell;
+
+/*
+ * Items are placed along the flow axis (rows with auto_flow_row): the
+ * other axis has the defined track count and the flow axis grows
+ * implicit tracks. Views added with view_add_child instead of
+ * grid_view_add_item are auto-placed and aligned by justify_items /
+ * align_items.
+ *
+ * Layout keeps its work between passes: placement is redone only when
+ * items or track definitions change, and track sizes only when the grid
+ * size or some item's measured size changes. A grid whose cells are all
+ * the same size (one px or fr value for every column, one px value for
+ * every row, auto-placed single cells) skips both and places items by
+ * index arithmetic.
+ */
 typedef struct rx_grid_view {
     rx_view base;
     rx_grid_layout layout;
     rx_grid_placement *placements;  /* Placement per child */
+    size_t placement_count;
+    size_t placement_capacity;
     rx_responsive_grid responsive;
     bool use_responsive;
+
+    /* Layout cache */
+    rx_grid_cell *cells;            /* Per child */
+    rx_size *contributions;         /* Per child: measured size plus margins */
+    size_t item_count;              /* Children the cache describes */
+    size_t item_capacity;
+    int *occupancy;                 /* Child index + 1 per cell, 0 = empty */
+    size_t occupancy_capacity;
+    float *column_sizes, *column_pos;
+    float *row_sizes, *row_pos;
+    size_t column_capacity, row_capacity;
+    int column_count, row_count;    /* Resolved, implicit tracks included */
+    rx_size tracks_for;             /* Inner size the tracks were sized for */
+    rx_size content;                /* Content size from grid_view_measure */
+    bool placement_valid;
+    bool tracks_valid;
+    bool content_valid;
+    bool uniform;
+
+    /* Statistics */
+    uint64_t placements_run;
+    uint64_t track_resolves;
 } rx_grid_view;
 
 /* Grid view functions */
 extern rx_grid_view *grid_view_new(int columns, int rows);
 extern rx_grid_view *grid_view_responsive(rx_responsive_grid grid);
 extern void grid_view_add_item(rx_grid_view *grid, rx_view *item, rx_grid_placement placement);
+/* Drop the placement of the child at index; view_remove_child calls it */
+extern void grid_view_remove_item_at(rx_grid_view *grid, size_t index);
 extern void grid_view_set_gap(rx_grid_view *grid, float column_gap, float row_gap);
 extern void grid_view_set_columns(rx_grid_view *grid, rx_track_size *cols, int count);
 extern void grid_view_set_rows(rx_grid_view *grid, rx_track_size *rows, int count);
+extern void grid_view_set_auto_rows(rx_grid_view *grid, rx_track_size size);
+
+/* Code that writes layout or placements directly must call this */
+extern void grid_view_invalidate(rx_grid_view *grid);
+
+/* Child index at a point relative to the grid's frame, -1 if none.
+ * Valid after layout. */
+extern int grid_view_item_at(rx_grid_view *grid, rx_point pos);
+
+/* Children whose rows intersect [top, bottom) in grid coordinates, for
+ * virtualized drawing. Uniform grids only; false otherwise. */
+extern bool grid_view_items_in(rx_grid_view *grid, float top, float bottom,
+                               int *first, int *last);
+
+/* Layout hooks used by view_measure / view_arrange / view_free */
+extern rx_size grid_view_measure(rx_grid_view *grid);
+extern void grid_view_arrange(rx_grid_view *grid, float inner_w, float inner_h);
+extern void grid_view_release(rx_grid_view *grid);
 
 /* ============================================================================
  * Flex Container
@@ -0,0 +1,832 @@
+/*
+ * REOX Image Atlas - Implementation
+ * Sprite sheets: JSON and memory-mapped binary atlases, packing, lookup
+ */
+
+#include "reox_image_system.h"
+#include "reox_atlas_packer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Binary atlas layout (little-endian, offsets from the start of the file):
+ *
+ *   rx_atlas_file_header
+ *   rx_atlas_file_sprite[sprite_count]   sorted by name (strcmp order)
+ *   name strings, each NUL-terminated
+ *   texture rows, stride bytes apart, starting on a page boundary
+ *
+ * Mapping the file builds the rx_sprite table and nothing else: names and
+ * pixels are used in place.
+ */
+
+#define ATLAS_VERSION 1
+#define ATLAS_BYTE_ORDER 0x01020304u
+#define ATLAS_PIXEL_ALIGN 4096
+#define ATLAS_PADDING 1               /* Transparent pixels between packed sprites */
+
+typedef struct rx_atlas_file_header {
+    char magic[8];                    /* RX_ATLAS_MAGIC */
+    uint32_t version;
+    uint32_t byte_order;              /* ATLAS_BYTE_ORDER as written */
+    uint32_t width, height;
+    uint32_t format;                  /* rx_image_format */
+    uint32_t stride;
+    uint32_t sprite_count;
+    uint32_t sprites_offset;
+    uint32_t names_offset;
+    uint32_t names_size;
+    uint64_t pixels_offset;
+    uint64_t pixels_size;
+} rx_atlas_file_header;
+
+#define ATLAS_SPRITE_ROTATED 1u
+
+typedef struct rx_atlas_file_sprite {
+    uint32_t name_offset;             /* Into the name strings */
+    uint32_t name_length;
+    float x, y, w, h;
+    float pivot_x, pivot_y;
+    uint32_t flags;
+    uint32_t reserved;
+} rx_atlas_file_sprite;
+
+static int pixel_bytes(rx_image_format format) {
+    switch (format) {
+        case RX_IMAGE_RGBA8: return 4;
+        case RX_IMAGE_RGB8: return 3;
+        case RX_IMAGE_GRAY8: return 1;
+        case RX_IMAGE_GRAY16: return 2;
+        case RX_IMAGE_RGBA16F: return 8;
+        case RX_IMAGE_RGBA32F: return 16;
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * Atlas Storage and Lookup
+ * ============================================================================ */
+
+static int sprite_compare(const void* a, const void* b) {
+    return strcmp(((const rx_sprite*)a)->name, ((const rx_sprite*)b)->name);
+}
+
+/* Sprites are kept sorted by name so lookups are a binary search */
+static void atlas_sort(rx_texture_atlas* atlas) {
+    if (atlas->sprite_count > 1) {
+        qsort(atlas->sprites, atlas->sprite_count, sizeof(rx_sprite), sprite_compare);
+    }
+}
+
+rx_sprite* rx_atlas_get_sprite(rx_texture_atlas* atlas, const char* name) {
+    if (!atlas || !name) return NULL;
+    size_t lo = 0, hi = atlas->sprite_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(atlas->sprites[mid].name, name);
+        if (cmp == 0) return &atlas->sprites[mid];
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
+
+rx_image* rx_atlas_page(rx_texture_atlas* atlas, int page) {
+    if (!atlas || page < 0) return NULL;
+    if (atlas->pages) return page < atlas->page_count ? atlas->pages[page] : NULL;
+    return page == 0 ? atlas->texture : NULL;
+}
+
+void rx_atlas_destroy(rx_texture_atlas* atlas) {
+    if (!atlas) return;
+    if (atlas->mapping) {
+        munmap(atlas->mapping, atlas->mapping_size);
+    } else {
+        for (size_t i = 0; i < atlas->sprite_count; i++) free((void*)atlas->sprites[i].name);
+    }
+    if (atlas->pages) {
+        for (int i = 0; i < atlas->page_count; i++) rx_image_destroy(atlas->pages[i]);
+        free(atlas->pages);
+    } else {
+        rx_image_destroy(atlas->texture);
+    }
+    rx_packer_destroy(atlas->packer);
+    free(atlas->sprites);
+    free(atlas);
+}
+
+/* ============================================================================
+ * Binary Atlas
+ * ============================================================================ */
+
+static bool atlas_header_valid(const rx_atlas_file_header* h, size_t size) {
+    if (memcmp(h->magic, RX_ATLAS_MAGIC, sizeof(h->magic)) != 0) return false;
+    if (h->version != ATLAS_VERSION || h->byte_order != ATLAS_BYTE_ORDER) return false;
+
+    int bpp = pixel_bytes((rx_image_format)h->format);
+    if (!bpp || h->width == 0 || h->height == 0 || h->width > 0x7FFFFFFF / (uint32_t)bpp) return false;
+    if (h->stride < h->width * (uint32_t)bpp) return false;
+
+    uint64_t sprites_end = (uint64_t)h->sprites_offset + (uint64_t)h->sprite_count * sizeof(rx_atlas_file_sprite);
+    uint64_t names_end = (uint64_t)h->names_offset + h->names_size;
+    uint64_t pixels_needed = (uint64_t)h->stride * h->height;
+    return sprites_end <= size && names_end <= size && h->sprites_offset % 4 == 0 &&
+           h->pixels_size >= pixels_needed && h->pixels_offset <= size &&
+           h->pixels_size <= size - h->pixels_offset;
+}
+
+rx_texture_atlas* rx_atlas_map(const char* path) {
+    if (!path) return NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void* map = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(rx_atlas_file_header)) {
+        size = (size_t)st.st_size;
+        /* Private and writable: pixels are copied only if someone writes */
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    const uint8_t* base = (const uint8_t*)map;
+    const rx_atlas_file_header* h = (const rx_atlas_file_header*)map;
+    rx_texture_atlas* atlas = NULL;
+    if (!atlas_header_valid(h, size)) goto fail;
+
+    atlas = (rx_texture_atlas*)calloc(1, sizeof(rx_texture_atlas));
+    if (!atlas) goto fail;
+    atlas->mapping = map;
+    atlas->mapping_size = size;
+    atlas->sprites = h->sprite_count ? (rx_sprite*)calloc(h->sprite_count, sizeof(rx_sprite)) : NULL;
+    if (h->sprite_count && !atlas->sprites) goto fail;
+
+    const rx_atlas_file_sprite* records = (const rx_atlas_file_sprite*)(base + h->sprites_offset);
+    const char* names = (const char*)(base + h->names_offset);
+    for (uint32_t i = 0; i < h->sprite_count; i++) {
+        const rx_atlas_file_sprite* r = &records[i];
+        if ((uint64_t)r->name_offset + r->name_length >= h->names_size || names[r->name_offset + r->name_length] != '\0') {
+            goto fail;
+        }
+        rx_sprite* s = &atlas->sprites[i];
+        s->name = names + r->name_offset;
+        s->frame = (rx_rect){ r->x, r->y, r->w, r->h };
+        s->pivot = (rx_point){ r->pivot_x, r->pivot_y };
+        s->rotated = (r->flags & ATLAS_SPRITE_ROTATED) != 0;
+        /* The table must be sorted for binary search */
+        if (i > 0 && strcmp(atlas->sprites[i - 1].name, s->name) > 0) goto fail;
+    }
+    atlas->sprite_count = h->sprite_count;
+
+    uint8_t* pixels = (uint8_t*)map + h->pixels_offset;
+    atlas->texture = rx_image_create_with_data((int)h->width, (int)h->height, (rx_image_format)h->format, pixels);
+    if (!atlas->texture) goto fail;
+    atlas->texture->stride = (int)h->stride;
+    madvise(pixels, (size_t)h->pixels_size, MADV_WILLNEED);
+    return atlas;
+
+fail:
+    if (atlas) {
+        free(atlas->sprites);
+        free(atlas);
+    }
+    munmap(map, size);
+    return NULL;
+}
+
+static bool write_zeros(FILE* f, size_t count) {
+    static const uint8_t zeros[256];
+    while (count > 0) {
+        size_t n = count < sizeof(zeros) ? count : sizeof(zeros);
+        if (fwrite(zeros, 1, n, f) != n) return false;
+        count -= n;
+    }
+    return true;
+}
+
+bool rx_atlas_save(rx_texture_atlas* atlas, const char* path) {
+    if (!atlas || !atlas->texture || !path || atlas->page_count > 1) return false;
+    rx_image* tex = atlas->texture;
+    int bpp = pixel_bytes(tex->format);
+    if (!bpp || !tex->data) return false;
+
+    /* Rows are written 16-byte aligned, as rx_image_create lays them out */
+    uint32_t stride = ((uint32_t)tex->width * (uint32_t)bpp + 15) & ~15u;
+    size_t names_size = 0;
+    for (size_t i = 0; i < atlas->sprite_count; i++) names_size += strlen(atlas->sprites[i].name) + 1;
+
+    rx_atlas_file_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, RX_ATLAS_MAGIC, sizeof(h.magic));
+    h.version = ATLAS_VERSION;
+    h.byte_order = ATLAS_BYTE_ORDER;
+    h.width = (uint32_t)tex->width;
+    h.height = (uint32_t)tex->height;
+    h.format = (uint32_t)tex->format;
+    h.stride = stride;
+    h.sprite_count = (uint32_t)atlas->sprite_count;
+    h.sprites_offset = sizeof(h);
+    h.names_offset = h.sprites_offset + h.sprite_count * (uint32_t)sizeof(rx_atlas_file_sprite);
+    h.names_size = (uint32_t)names_size;
+    h.pixels_offset = ((uint64_t)h.names_offset + names_size + ATLAS_PIXEL_ALIGN - 1) & ~(uint64_t)(ATLAS_PIXEL_ALIGN - 1);
+    h.pixels_size = (uint64_t)stride * h.height;
+
+    /* Records must be in name order; a mapped atlas is already sorted */
+    rx_sprite* sorted = (rx_sprite*)malloc(sizeof(rx_sprite) * (atlas->sprite_count ? atlas->sprite_count : 1));
+    if (!sorted) return false;
+    memcpy(sorted, atlas->sprites, sizeof(rx_sprite) * atlas->sprite_count);
+    if (atlas->sprite_count > 1) qsort(sorted, atlas->sprite_count, sizeof(rx_sprite), sprite_compare);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        free(sorted);
+        return false;
+    }
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+    uint32_t name_offset = 0;
+    for (size_t i = 0; ok && i < atlas->sprite_count; i++) {
+        const rx_sprite* s = &sorted[i];
+        rx_atlas_file_sprite r = {
+            .name_offset = name_offset,
+            .name_length = (uint32_t)strlen(s->name),
+            .x = s->frame.x, .y = s->frame.y, .w = s->frame.width, .h = s->frame.height,
+            .pivot_x = s->pivot.x, .pivot_y = s->pivot.y,
+            .flags = s->rotated ? ATLAS_SPRITE_ROTATED : 0,
+        };
+        name_offset += r.name_length + 1;
+        ok = fwrite(&r, sizeof(r), 1, f) == 1;
+    }
+    for (size_t i = 0; ok && i < atlas->sprite_count; i++) {
+        size_t len = strlen(sorted[i].name) + 1;
+        ok = fwrite(sorted[i].name, 1, len, f) == len;
+    }
+    ok = ok && write_zeros(f, (size_t)(h.pixels_offset - h.names_offset - names_size));
+
+    size_t row_bytes = (size_t)tex->width * (size_t)bpp;
+    for (int y = 0; ok && y < tex->height; y++) {
+        ok = fwrite(tex->data + (size_t)y * (size_t)tex->stride, 1, row_bytes, f) == row_bytes &&
+             write_zeros(f, stride - row_bytes);
+    }
+    free(sorted);
+    if (fclose(f) != 0) ok = false;
+    if (!ok) remove(path);
+    return ok;
+}
+
+/* ============================================================================
+ * JSON Atlas (TexturePacker hash and array formats)
+ * ============================================================================ */
+
+typedef struct json_cursor {
+    const char* p;
+    const char* end;
+} json_cursor;
+
+static void json_ws(json_cursor* c) {
+    while (c->p < c->end && (*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r')) c->p++;
+}
+
+static bool json_peek(json_cursor* c, char ch) {
+    json_ws(c);
+    return c->p < c->end && *c->p == ch;
+}
+
+static bool json_eat(json_cursor* c, char ch) {
+    if (!json_peek(c, ch)) return false;
+    c->p++;
+    return true;
+}
+
+/* String into a new buffer; escapes other than \uXXXX are decoded */
+static char* json_string(json_cursor* c) {
+    if (!json_eat(c, '"')) return NULL;
+    const char* start = c->p;
+    size_t len = 0;
+    while (c->p < c->end && *c->p != '"') {
+        if (*c->p == '\\') c->p++;
+        c->p++;
+        len++;
+    }
+    if (c->p >= c->end) return NULL;
+    char* out = (char*)malloc(len + 1);
+    if (!out) return NULL;
+
+    size_t n = 0;
+    for (const char* s = start; s < c->p; s++) {
+        char ch = *s;
+        if (ch == '\\') {
+            ch = *++s;
+            if (ch == 'n') ch = '\n';
+            else if (ch == 't') ch = '\t';
+        }
+        out[n++] = ch;
+    }
+    out[n] = '\0';
+    c->p++;
+    return out;
+}
+
+static bool json_skip(json_cursor* c);
+
+static bool json_skip_container(json_cursor* c, char close) {
+    c->p++;
+    if (json_eat(c, close)) return true;
+    do {
+        if (close == '}') {
+            char* key = json_string(c);
+            if (!key) return false;
+            free(key);
+            if (!json_eat(c, ':')) return false;
+        }
+        if (!json_skip(c)) return false;
+    } while (json_eat(c, ','));
+    return json_eat(c, close);
+}
+
+static bool json_skip(json_cursor* c) {
+    json_ws(c);
+    if (c->p >= c->end) return false;
+    if (*c->p == '{') return json_skip_container(c, '}');
+    if (*c->p == '[') return json_skip_container(c, ']');
+    if (*c->p == '"') {
+        char* s = json_string(c);
+        free(s);
+        return s != NULL;
+    }
+    while (c->p < c->end && *c->p != ',' && *c->p != '}' && *c->p != ']' &&
+           *c->p != ' ' && *c->p != '\n' && *c->p != '\r' && *c->p != '\t') c->p++;
+    return true;
+}
+
+static bool json_number(json_cursor* c, float* out) {
+    json_ws(c);
+    char* end = NULL;
+    double v = strtod(c->p, &end);
+    if (end == c->p || end > c->end) return false;
+    c->p = end;
+    *out = (float)v;
+    return true;
+}
+
+static bool json_bool(json_cursor* c, bool* out) {
+    json_ws(c);
+    if ((size_t)(c->end - c->p) >= 4 && strncmp(c->p, "true", 4) == 0) { c->p += 4; *out = true; return true; }
+    if ((size_t)(c->end - c->p) >= 5 && strncmp(c->p, "false", 5) == 0) { c->p += 5; *out = false; return true; }
+    return false;
+}
+
+/* Object of numbers; unknown keys are skipped */
+static bool json_rect(json_cursor* c, float* x, float* y, float* w, float* h) {
+    if (!json_eat(c, '{')) return false;
+    if (json_eat(c, '}')) return true;
+    do {
+        char* key = json_string(c);
+        if (!key || !json_eat(c, ':')) { free(key); return false; }
+        float* dst = NULL;
+        if (strcmp(key, "x") == 0) dst = x;
+        else if (strcmp(key, "y") == 0) dst = y;
+        else if (strcmp(key, "w") == 0) dst = w;
+        else if (strcmp(key, "h") == 0) dst = h;
+        free(key);
+        if (dst ? !json_number(c, dst) : !json_skip(c)) return false;
+    } while (json_eat(c, ','));
+    return json_eat(c, '}');
+}
+
+static bool atlas_push(rx_texture_atlas* atlas, size_t* capacity, rx_sprite sprite) {
+    if (atlas->sprite_count == *capacity) {
+        size_t cap = *capacity ? *capacity * 2 : 32;
+        rx_sprite* s = (rx_sprite*)realloc(atlas->sprites, sizeof(rx_sprite) * cap);
+        if (!s) return false;
+        atlas->sprites = s;
+        *capacity = cap;
+    }
+    atlas->sprites[atlas->sprite_count++] = sprite;
+    return true;
+}
+
+/* One frame object; name comes from the hash key or its "filename" */
+static bool json_frame(json_cursor* c, rx_texture_atlas* atlas, size_t* capacity, char* name) {
+    rx_sprite s = { NULL, { 0, 0, 0, 0 }, { 0.5f, 0.5f }, false, 0 };
+    if (!json_eat(c, '{')) { free(name); return false; }
+    if (!json_eat(c, '}')) {
+        do {
+            char* key = json_string(c);
+            bool ok = key && json_eat(c, ':');
+            if (ok) {
+                if (strcmp(key, "filename") == 0) {
+                    free(name);
+                    name = json_string(c);
+                    ok = name != NULL;
+                } else if (strcmp(key, "frame") == 0) {
+                    ok = json_rect(c, &s.frame.x, &s.frame.y, &s.frame.width, &s.frame.height);
+                } else if (strcmp(key, "pivot") == 0) {
+                    float unused_w, unused_h;
+                    ok = json_rect(c, &s.pivot.x, &s.pivot.y, &unused_w, &unused_h);
+                } else if (strcmp(key, "rotated") == 0) {
+                    ok = json_bool(c, &s.rotated);
+                } else {
+                    ok = json_skip(c);
+                }
+            }
+            free(key);
+            if (!ok) { free(name); return false; }
+        } while (json_eat(c, ','));
+        if (!json_eat(c, '}')) { free(name); return false; }
+    }
+    if (!name) return false;
+    /* TexturePacker gives the unrotated size; store the rect as laid out */
+    if (s.rotated) {
+        float w = s.frame.width;
+        s.frame.width = s.frame.height;
+        s.frame.height = w;
+    }
+    s.name = name;
+    if (!atlas_push(atlas, capacity, s)) { free(name); return false; }
+    return true;
+}
+
+static char* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    char* data = NULL;
+    long len = 0;
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        data = (char*)malloc((size_t)len + 1);
+        if (data && fread(data, 1, (size_t)len, f) != (size_t)len) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    if (data) {
+        data[len] = '\0';
+        *size = (size_t)len;
+    }
+    return data;
+}
+
+/* meta.image, relative to the JSON file */
+static char* texture_beside(const char* json_path, const char* image) {
+    const char* slash = strrchr(json_path, '/');
+    size_t dir = slash ? (size_t)(slash - json_path + 1) : 0;
+    char* path = (char*)malloc(dir + strlen(image) + 1);
+    if (!path) return NULL;
+    memcpy(path, json_path, dir);
+    strcpy(path + dir, image);
+    return path;
+}
+
+static rx_texture_atlas* atlas_load_json(const char* atlas_json, const char* texture_path) {
+    size_t size = 0;
+    char* text = read_file(atlas_json, &size);
+    if (!text) return NULL;
+
+    rx_texture_atlas* atlas = (rx_texture_atlas*)calloc(1, sizeof(rx_texture_atlas));
+    size_t capacity = 0;
+    char* meta_image = NULL;
+    json_cursor c = { text, text + size };
+    bool ok = atlas && json_eat(&c, '{');
+
+    if (ok && !json_eat(&c, '}')) {
+        do {
+            char* key = json_string(&c);
+            ok = key && json_eat(&c, ':');
+            if (ok && strcmp(key, "frames") == 0) {
+                if (json_eat(&c, '[')) {
+                    if (!json_eat(&c, ']')) {
+                        do ok = json_frame(&c, atlas, &capacity, NULL);
+                        while (ok && json_eat(&c, ','));
+                        ok = ok && json_eat(&c, ']');
+                    }
+                } else if (json_eat(&c, '{')) {
+                    if (!json_eat(&c, '}')) {
+                        do {
+                            char* name = json_string(&c);
+                            if (name && json_eat(&c, ':')) {
+                                ok = json_frame(&c, atlas, &capacity, name);
+                            } else {
+                                free(name);
+                                ok = false;
+                            }
+                        } while (ok && json_eat(&c, ','));
+                        ok = ok && json_eat(&c, '}');
+                    }
+                } else {
+                    ok = false;
+                }
+            } else if (ok && strcmp(key, "meta") == 0 && json_eat(&c, '{')) {
+                if (!json_eat(&c, '}')) {
+                    do {
+                        char* mkey = json_string(&c);
+                        ok = mkey && json_eat(&c, ':');
+                        if (ok && strcmp(mkey, "image") == 0 && json_peek(&c, '"')) {
+                            free(meta_image);
+                            meta_image = json_string(&c);
+                        } else if (ok) {
+                            ok = json_skip(&c);
+                        }
+                        free(mkey);
+                    } while (ok && json_eat(&c, ','));
+                    ok = ok && json_eat(&c, '}');
+                }
+            } else if (ok) {
+                ok = json_skip(&c);
+            }
+            free(key);
+        } while (ok && json_eat(&c, ','));
+    }
+    free(text);
+
+    if (ok) {
+        char* beside = !texture_path && meta_image ? texture_beside(atlas_json, meta_image) : NULL;
+        const char* tex = texture_path ? texture_path : beside;
+        atlas->texture = tex ? rx_image_load(tex) : NULL;
+        free(beside);
+        ok = atlas->texture != NULL;
+    }
+    free(meta_image);
+    if (!ok) {
+        rx_atlas_destroy(atlas);
+        return NULL;
+    }
+    atlas_sort(atlas);
+    return atlas;
+}
+
+/* Binary atlases are detected by their magic; texture_path is then unused */
+rx_texture_atlas* rx_atlas_load(const char* atlas_json, const char* texture_path) {
+    if (!atlas_json) return NULL;
+    char magic[8] = { 0 };
+    FILE* f = fopen(atlas_json, "rb");
+    if (!f) return NULL;
+    size_t n = fread(magic, 1, sizeof(magic), f);
+    fclose(f);
+    if (n == sizeof(magic) && memcmp(magic, RX_ATLAS_MAGIC, sizeof(magic)) == 0) {
+        return rx_atlas_map(atlas_json);
+    }
+    return atlas_load_json(atlas_json, texture_path);
+}
+
+/* ============================================================================
+ * Packing
+ * ============================================================================ */
+
+static rx_texture_atlas* atlas_create_empty(int page_size, rx_image_format format, int max_pages) {
+    if (page_size <= 0 || max_pages <= 0 || !pixel_bytes(format)) return NULL;
+    rx_texture_atlas* atlas = (rx_texture_atlas*)calloc(1, sizeof(rx_texture_atlas));
+    if (!atlas) return NULL;
+    atlas->packer = rx_packer_create(page_size, page_size, ATLAS_PADDING, max_pages);
+    atlas->pages = (rx_image**)calloc((size_t)max_pages, sizeof(rx_image*));
+    if (atlas->pages) atlas->pages[0] = rx_image_create(page_size, page_size, format);
+    if (!atlas->packer || !atlas->pages || !atlas->pages[0]) {
+        rx_atlas_destroy(atlas);
+        return NULL;
+    }
+    atlas->page_count = 1;
+    atlas->texture = atlas->pages[0];
+    return atlas;
+}
+
+/* Page images follow the packer's pages; new ones start transparent */
+static rx_image* atlas_page_open(rx_texture_atlas* atlas, int page) {
+    while (atlas->page_count <= page) {
+        rx_image* tex = atlas->texture;
+        rx_image* img = rx_image_create(tex->width, tex->height, tex->format);
+        if (!img) return NULL;
+        atlas->pages[atlas->page_count++] = img;
+    }
+    return atlas->pages[page];
+}
+
+/* Clear the slot and its padding, since freed areas hold old pixels, then
+ * copy img in */
+static void atlas_blit(rx_texture_atlas* atlas, const rx_pack_slot* slot, const rx_image* img) {
+    rx_image* page = atlas->pages[slot->page];
+    size_t bpp = (size_t)pixel_bytes(page->format);
+    int w = slot->width + ATLAS_PADDING, h = slot->height + ATLAS_PADDING;
+    if (slot->x + w > page->width) w = page->width - slot->x;
+    if (slot->y + h > page->height) h = page->height - slot->y;
+
+    for (int y = 0; y < h; y++) {
+        uint8_t* row = page->data + (size_t)(slot->y + y) * (size_t)page->stride + (size_t)slot->x * bpp;
+        if (y < slot->height) {
+            memcpy(row, img->data + (size_t)y * (size_t)img->stride, (size_t)slot->width * bpp);
+            memset(row + (size_t)slot->width * bpp, 0, (size_t)(w - slot->width) * bpp);
+        } else {
+            memset(row, 0, (size_t)w * bpp);
+        }
+    }
+}
+
+static size_t sprite_lower_bound(const rx_texture_atlas* atlas, const char* name) {
+    size_t lo = 0, hi = atlas->sprite_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(atlas->sprites[mid].name, name) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static rx_pack_slot sprite_slot(const rx_sprite* s) {
+    return (rx_pack_slot){ s->page, (int)s->frame.x, (int)s->frame.y,
+                           (int)s->frame.width, (int)s->frame.height };
+}
+
+rx_texture_atlas* rx_atlas_create(int page_size, rx_image_format format, int max_pages) {
+    return atlas_create_empty(page_size, format, max_pages);
+}
+
+rx_sprite* rx_atlas_add(rx_texture_atlas* atlas, const char* name, const rx_image* img) {
+    if (!atlas || !atlas->packer || !name || !img || !img->data) return NULL;
+    if (img->format != atlas->texture->format) return NULL;
+
+    rx_atlas_remove(atlas, name);
+    if (atlas->sprite_count == atlas->sprite_capacity) {
+        size_t cap = atlas->sprite_capacity ? atlas->sprite_capacity * 2 : 32;
+        rx_sprite* sprites = (rx_sprite*)realloc(atlas->sprites, sizeof(rx_sprite) * cap);
+        if (!sprites) return NULL;
+        atlas->sprites = sprites;
+        atlas->sprite_capacity = cap;
+    }
+    char* copy = strdup(name);
+    if (!copy) return NULL;
+
+    rx_pack_slot slot;
+    if (!rx_packer_insert(atlas->packer, img->width, img->height, &slot)) {
+        free(copy);
+        return NULL;
+    }
+    if (!atlas_page_open(atlas, slot.page)) {
+        rx_packer_remove(atlas->packer, &slot);
+        free(copy);
+        return NULL;
+    }
+    atlas_blit(atlas, &slot, img);
+
+    size_t at = sprite_lower_bound(atlas, name);
+    memmove(&atlas->sprites[at + 1], &atlas->sprites[at], sizeof(rx_sprite) * (atlas->sprite_count - at));
+    atlas->sprites[at] = (rx_sprite){
+        copy,
+        { (float)slot.x, (float)slot.y, (float)slot.width, (float)slot.height },
+        { 0.5f, 0.5f }, false, slot.page
+    };
+    atlas->sprite_count++;
+    return &atlas->sprites[at];
+}
+
+bool rx_atlas_remove(rx_texture_atlas* atlas, const char* name) {
+    if (!atlas || !atlas->packer || !name) return false;
+    rx_sprite* s = rx_atlas_get_sprite(atlas, name);
+    if (!s) return false;
+
+    rx_pack_slot slot = sprite_slot(s);
+    rx_packer_remove(atlas->packer, &slot);
+    free((void*)s->name);
+    size_t at = (size_t)(s - atlas->sprites);
+    memmove(s, s + 1, sizeof(rx_sprite) * (atlas->sprite_count - at - 1));
+    atlas->sprite_count--;
+    return true;
+}
+
+bool rx_atlas_take_dirty(rx_texture_atlas* atlas, int page, rx_rect* out) {
+    rx_pack_rect r;
+    if (!atlas || !rx_packer_take_dirty(atlas->packer, page, &r)) return false;
+    if (out) *out = (rx_rect){ (float)r.x, (float)r.y, (float)r.width, (float)r.height };
+    return true;
+}
+
+typedef struct pack_item {
+    size_t index;
+    int w, h;
+} pack_item;
+
+static int pack_compare(const void* a, const void* b) {
+    const pack_item* pa = (const pack_item*)a;
+    const pack_item* pb = (const pack_item*)b;
+    if (pa->h != pb->h) return pb->h - pa->h;
+    return pb->w - pa->w;
+}
+
+/* Tallest first into the smallest power-of-two page up to max_size that
+ * takes them all. The result stays open for rx_atlas_add. */
+rx_texture_atlas* rx_atlas_pack(rx_image** images, const char** names, size_t count, int max_size) {
+    if (!images || !names || count == 0 || max_size <= 0 || !images[0]) return NULL;
+    rx_image_format format = images[0]->format;
+
+    pack_item* items = (pack_item*)malloc(sizeof(pack_item) * count);
+    rx_pack_slot* placed = (rx_pack_slot*)malloc(sizeof(rx_pack_slot) * count);
+    if (!items || !placed) {
+        free(items);
+        free(placed);
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!images[i] || !names[i] || images[i]->format != format) {
+            free(items);
+            free(placed);
+            return NULL;
+        }
+        items[i] = (pack_item){ i, images[i]->width, images[i]->height };
+    }
+    qsort(items, count, sizeof(pack_item), pack_compare);
+
+    int side = 64;
+    bool fits = false;
+    rx_atlas_packer* packer = NULL;
+    for (;;) {
+        if (side > max_size) side = max_size;
+        packer = rx_packer_create(side, side, ATLAS_PADDING, RX_ATLAS_MAX_PAGES);
+        if (!packer) break;
+        fits = true;
+        for (size_t i = 0; i < count && fits; i++) {
+            fits = rx_packer_insert_page(packer, 0, items[i].w, items[i].h, &placed[items[i].index]);
+        }
+        if (fits || side == max_size) break;
+        rx_packer_destroy(packer);
+        packer = NULL;
+        side *= 2;
+    }
+    free(items);
+    if (!fits) {
+        rx_packer_destroy(packer);
+        free(placed);
+        return NULL;
+    }
+
+    rx_texture_atlas* atlas = atlas_create_empty(side, format, RX_ATLAS_MAX_PAGES);
+    if (atlas) {
+        rx_packer_destroy(atlas->packer);
+        atlas->packer = packer;
+        packer = NULL;
+        atlas->sprites = (rx_sprite*)calloc(count, sizeof(rx_sprite));
+        atlas->sprite_capacity = count;
+    }
+    rx_packer_destroy(packer);
+    if (!atlas || !atlas->sprites) {
+        rx_atlas_destroy(atlas);
+        free(placed);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const rx_pack_slot* slot = &placed[i];
+        atlas_blit(atlas, slot, images[i]);
+        atlas->sprites[i] = (rx_sprite){
+            strdup(names[i]),
+            { (float)slot->x, (float)slot->y, (float)slot->width, (float)slot->height },
+            { 0.5f, 0.5f }, false, 0
+        };
+        if (!atlas->sprites[i].name) {
+            atlas->sprite_count = i;
+            rx_atlas_destroy(atlas);
+            free(placed);
+            return NULL;
+        }
+    }
+    atlas->sprite_count = count;
+    free(placed);
+    atlas_sort(atlas);
+    return atlas;
+}
+
+/* ============================================================================
+ * Sprite Extraction
+ * ============================================================================ */
+
+rx_image* rx_atlas_extract_sprite(rx_texture_atlas* atlas, const char* name) {
+    rx_sprite* s = rx_atlas_get_sprite(atlas, name);
+    rx_image* tex = s ? rx_atlas_page(atlas, s->page) : NULL;
+    if (!tex) return NULL;
+    int bpp = pixel_bytes(tex->format);
+
+    int fx = (int)s->frame.x, fy = (int)s->frame.y;
+    int fw = (int)s->frame.width, fh = (int)s->frame.height;
+    if (fx < 0 || fy < 0 || fw <= 0 || fh <= 0 || fx + fw > tex->width || fy + fh > tex->height) return NULL;
+
+    /* Rotated sprites are stored turned 90 degrees clockwise */
+    rx_image* out = s->rotated ? rx_image_create(fh, fw, tex->format) : rx_image_create(fw, fh, tex->format);
+    if (!out) return NULL;
+    for (int y = 0; y < fh; y++) {
+        const uint8_t* src = tex->data + (size_t)(fy + y) * (size_t)tex->stride + (size_t)fx * (size_t)bpp;
+        if (!s->rotated) {
+            memcpy(out->data + (size_t)y * (size_t)out->stride, src, (size_t)fw * (size_t)bpp);
+            continue;
+        }
+        for (int x = 0; x < fw; x++) {
+            /* Stored (x, y) holds original (y, fw - 1 - x) */
+            uint8_t* dst = out->data + (size_t)(fw - 1 - x) * (size_t)out->stride + (size_t)y * (size_t)bpp;
+            memcpy(dst, src + (size_t)x * (size_t)bpp, (size_t)bpp);
+        }
+    }
+    return out;
+}
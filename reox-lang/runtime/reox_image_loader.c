@@ -0,0 +1,794 @@
+/*
+ * REOX Image Loader - Implementation
+ * Decoders, the downsampling decode target and the background load queue
+ */
+
+#include "reox_image_loader.h"
+#include "reox_runloop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define LOAD_BUCKETS 256              /* Dedup table for in-flight requests */
+#define LOAD_NONE 0xFFFFFFFFu
+
+/* ============================================================================
+ * Decode Target
+ * ============================================================================ */
+
+static int target_channels(rx_image_format format) {
+    switch (format) {
+        case RX_IMAGE_RGBA8: return 4;
+        case RX_IMAGE_RGB8:  return 3;
+        case RX_IMAGE_GRAY8: return 1;
+        default:             return 0;
+    }
+}
+
+/* Largest size within max (0: unconstrained) keeping the aspect ratio */
+static void fit_size(int w, int h, int max_w, int max_h, int* out_w, int* out_h) {
+    double scale = 1.0;
+    if (max_w > 0 && w > max_w) scale = (double)max_w / w;
+    if (max_h > 0 && h > max_h && (double)max_h / h < scale) scale = (double)max_h / h;
+    *out_w = (int)(w * scale + 0.5);
+    *out_h = (int)(h * scale + 0.5);
+    if (*out_w < 1) *out_w = 1;
+    if (*out_h < 1) *out_h = 1;
+    if (*out_w > w) *out_w = w;
+    if (*out_h > h) *out_h = h;
+}
+
+bool rx_decode_target_init(rx_decode_target* target, int src_width, int src_height,
+                           rx_image_format format, int max_width, int max_height) {
+    if (!target) return false;
+    memset(target, 0, sizeof(*target));
+    int c = target_channels(format);
+    if (!c || src_width <= 0 || src_height <= 0) return false;
+
+    int out_w, out_h;
+    fit_size(src_width, src_height, max_width, max_height, &out_w, &out_h);
+    target->image = rx_image_create(out_w, out_h, format);
+    if (!target->image) return false;
+    target->src_width = src_width;
+    target->src_height = src_height;
+    target->channels = c;
+    if (out_w == src_width && out_h == src_height) return true;
+
+    target->column_map = (int*)malloc(sizeof(int) * (size_t)src_width);
+    target->column_count = (uint32_t*)calloc((size_t)out_w, sizeof(uint32_t));
+    target->sums = (uint64_t*)calloc((size_t)out_w * (size_t)c, sizeof(uint64_t));
+    if (!target->column_map || !target->column_count || !target->sums) {
+        free(target->column_map);
+        free(target->column_count);
+        free(target->sums);
+        rx_image_destroy(target->image);
+        memset(target, 0, sizeof(*target));
+        return false;
+    }
+    for (int x = 0; x < src_width; x++) {
+        int ox = (int)((int64_t)x * out_w / src_width);
+        target->column_map[x] = ox;
+        target->column_count[ox]++;
+    }
+    return true;
+}
+
+/* Average the accumulated source rows into output row out_row */
+static void target_flush(rx_decode_target* t) {
+    if (t->band_rows == 0) return;
+    rx_image* img = t->image;
+    int c = t->channels;
+    uint8_t* out = img->data + (size_t)t->out_row * (size_t)img->stride;
+    for (int ox = 0; ox < img->width; ox++) {
+        uint64_t area = (uint64_t)t->band_rows * t->column_count[ox];
+        for (int k = 0; k < c; k++) {
+            out[ox * c + k] = (uint8_t)((t->sums[ox * c + k] + area / 2) / area);
+        }
+    }
+    memset(t->sums, 0, sizeof(uint64_t) * (size_t)img->width * (size_t)c);
+    t->band_rows = 0;
+}
+
+void rx_decode_target_row(rx_decode_target* t, const uint8_t* row) {
+    if (!t || !t->image || t->src_row >= t->src_height) return;
+    rx_image* img = t->image;
+    int c = t->channels;
+
+    if (!t->sums) {
+        memcpy(img->data + (size_t)t->src_row * (size_t)img->stride, row, (size_t)t->src_width * (size_t)c);
+        t->src_row++;
+        return;
+    }
+
+    int oy = (int)((int64_t)t->src_row * img->height / t->src_height);
+    if (oy != t->out_row) {
+        target_flush(t);
+        t->out_row = oy;
+    }
+    uint64_t* sums = t->sums;
+    const int* map = t->column_map;
+    for (int x = 0; x < t->src_width; x++) {
+        uint64_t* s = sums + (size_t)map[x] * (size_t)c;
+        const uint8_t* p = row + (size_t)x * (size_t)c;
+        for (int k = 0; k < c; k++) s[k] += p[k];
+    }
+    t->band_rows++;
+    t->src_row++;
+}
+
+rx_image* rx_decode_target_finish(rx_decode_target* t) {
+    if (!t) return NULL;
+    rx_image* img = t->image;
+    if (img && t->sums) target_flush(t);
+    bool complete = t->src_row == t->src_height;
+    free(t->column_map);
+    free(t->column_count);
+    free(t->sums);
+    memset(t, 0, sizeof(*t));
+    if (!complete) {
+        rx_image_destroy(img);
+        return NULL;
+    }
+    return img;
+}
+
+/* ============================================================================
+ * PNM Decoder (binary PGM / PPM)
+ * ============================================================================ */
+
+static bool pnm_probe(const uint8_t* data, size_t size) {
+    return size >= 2 && data[0] == 'P' && (data[1] == '5' || data[1] == '6');
+}
+
+/* Header integer, skipping whitespace and # comments */
+static bool pnm_int(const uint8_t* data, size_t size, size_t* pos, int* out) {
+    size_t p = *pos;
+    for (;;) {
+        while (p < size && (data[p] == ' ' || data[p] == '\t' || data[p] == '\r' || data[p] == '\n')) p++;
+        if (p < size && data[p] == '#') {
+            while (p < size && data[p] != '\n') p++;
+            continue;
+        }
+        break;
+    }
+    if (p >= size || data[p] < '0' || data[p] > '9') return false;
+    int64_t v = 0;
+    while (p < size && data[p] >= '0' && data[p] <= '9') {
+        v = v * 10 + (data[p++] - '0');
+        if (v > 0x7FFFFFFF) return false;
+    }
+    *out = (int)v;
+    *pos = p;
+    return true;
+}
+
+static rx_image* pnm_decode(const uint8_t* data, size_t size, int max_width, int max_height) {
+    bool rgb = data[1] == '6';
+    size_t pos = 2;
+    int w, h, maxval;
+    if (!pnm_int(data, size, &pos, &w) || !pnm_int(data, size, &pos, &h) ||
+        !pnm_int(data, size, &pos, &maxval)) return NULL;
+    if (w <= 0 || h <= 0 || maxval <= 0 || maxval > 65535 || pos >= size) return NULL;
+    pos++;      /* Single whitespace before the raster */
+
+    int samples = rgb ? 3 : 1;
+    int sample_bytes = maxval > 255 ? 2 : 1;
+    size_t row_bytes = (size_t)w * (size_t)samples * (size_t)sample_bytes;
+    if ((size - pos) / row_bytes < (size_t)h) return NULL;
+
+    int c = rgb ? 4 : 1;
+    rx_decode_target target;
+    if (!rx_decode_target_init(&target, w, h, rgb ? RX_IMAGE_RGBA8 : RX_IMAGE_GRAY8, max_width, max_height)) {
+        return NULL;
+    }
+    uint8_t* row = (uint8_t*)malloc((size_t)w * (size_t)c);
+    if (!row) {
+        rx_image_destroy(rx_decode_target_finish(&target));
+        return NULL;
+    }
+
+    for (int y = 0; y < h; y++) {
+        const uint8_t* src = data + pos + (size_t)y * row_bytes;
+        for (int x = 0; x < w; x++) {
+            for (int k = 0; k < samples; k++) {
+                const uint8_t* s = src + ((size_t)x * samples + k) * sample_bytes;
+                unsigned v = sample_bytes == 2 ? ((unsigned)s[0] << 8 | s[1]) : s[0];
+                if (maxval != 255) v = (v > (unsigned)maxval ? 255u : (v * 255u + (unsigned)maxval / 2) / (unsigned)maxval);
+                row[x * c + k] = (uint8_t)v;
+            }
+            if (rgb) row[x * c + 3] = 255;
+        }
+        rx_decode_target_row(&target, row);
+    }
+    free(row);
+    return rx_decode_target_finish(&target);
+}
+
+/* ============================================================================
+ * BMP Decoder (uncompressed 24/32-bit)
+ * ============================================================================ */
+
+static uint32_t read_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t read_le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static bool bmp_probe(const uint8_t* data, size_t size) {
+    return size >= 54 && data[0] == 'B' && data[1] == 'M';
+}
+
+static rx_image* bmp_decode(const uint8_t* data, size_t size, int max_width, int max_height) {
+    uint32_t offset = read_le32(data + 10);
+    uint32_t header = read_le32(data + 14);
+    int32_t w = (int32_t)read_le32(data + 18);
+    int32_t h = (int32_t)read_le32(data + 22);
+    uint16_t bpp = read_le16(data + 28);
+    uint32_t compression = read_le32(data + 30);
+
+    if (header < 40 || w <= 0 || h == 0 || h == INT32_MIN) return NULL;
+    if (!(bpp == 24 && compression == 0) && !(bpp == 32 && (compression == 0 || compression == 3))) return NULL;
+
+    bool top_down = h < 0;
+    if (top_down) h = -h;
+    /* BI_BITFIELDS with an alpha mask carries real alpha; BI_RGB does not */
+    bool alpha = bpp == 32 && compression == 3 && header >= 56 && 14 + 56 <= (size_t)size &&
+                 read_le32(data + 14 + 52) == 0xFF000000u;
+
+    size_t row_bytes = (((size_t)bpp * (size_t)w + 31) / 32) * 4;
+    if (offset > size || (size - offset) / row_bytes < (size_t)h) return NULL;
+
+    rx_decode_target target;
+    if (!rx_decode_target_init(&target, w, h, RX_IMAGE_RGBA8, max_width, max_height)) return NULL;
+    uint8_t* row = (uint8_t*)malloc((size_t)w * 4);
+    if (!row) {
+        rx_image_destroy(rx_decode_target_finish(&target));
+        return NULL;
+    }
+
+    int step = bpp / 8;
+    for (int y = 0; y < h; y++) {
+        int file_row = top_down ? y : h - 1 - y;
+        const uint8_t* src = data + offset + (size_t)file_row * row_bytes;
+        for (int x = 0; x < w; x++) {
+            const uint8_t* p = src + (size_t)x * step;
+            row[x * 4 + 0] = p[2];
+            row[x * 4 + 1] = p[1];
+            row[x * 4 + 2] = p[0];
+            row[x * 4 + 3] = alpha ? p[3] : 255;
+        }
+        rx_decode_target_row(&target, row);
+    }
+    free(row);
+    return rx_decode_target_finish(&target);
+}
+
+/* ============================================================================
+ * Decoder Registry and Loading
+ * ============================================================================ */
+
+static pthread_mutex_t decoder_lock = PTHREAD_MUTEX_INITIALIZER;
+static rx_image_decoder decoders[RX_IMAGE_MAX_DECODERS] = {
+    { "pnm", pnm_probe, pnm_decode },
+    { "bmp", bmp_probe, bmp_decode },
+};
+static int decoder_count = 2;
+
+bool rx_image_register_decoder(const rx_image_decoder* decoder) {
+    if (!decoder || !decoder->probe || !decoder->decode) return false;
+    pthread_mutex_lock(&decoder_lock);
+    bool ok = decoder_count < RX_IMAGE_MAX_DECODERS;
+    if (ok) decoders[decoder_count++] = *decoder;
+    pthread_mutex_unlock(&decoder_lock);
+    return ok;
+}
+
+rx_image* rx_image_load_from_memory_sized(const void* data, size_t size, int max_width, int max_height) {
+    if (!data || size == 0) return NULL;
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    rx_image_decoder decoder = { 0 };
+    pthread_mutex_lock(&decoder_lock);
+    for (int i = decoder_count - 1; i >= 0; i--) {
+        if (decoders[i].probe(bytes, size)) {
+            decoder = decoders[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&decoder_lock);
+    return decoder.decode ? decoder.decode(bytes, size, max_width, max_height) : NULL;
+}
+
+rx_image* rx_image_load_sized(const char* path, int max_width, int max_height) {
+    if (!path) return NULL;
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    rx_image* img = NULL;
+    if (fseek(f, 0, SEEK_END) == 0) {
+        long len = ftell(f);
+        uint8_t* data = len > 0 ? (uint8_t*)malloc((size_t)len) : NULL;
+        if (data && fseek(f, 0, SEEK_SET) == 0 && fread(data, 1, (size_t)len, f) == (size_t)len) {
+            img = rx_image_load_from_memory_sized(data, (size_t)len, max_width, max_height);
+        }
+        free(data);
+    }
+    fclose(f);
+    return img;
+}
+
+rx_image* rx_image_load(const char* path) {
+    return rx_image_load_sized(path, 0, 0);
+}
+
+rx_image* rx_image_load_from_memory(const void* data, size_t size) {
+    return rx_image_load_from_memory_sized(data, size, 0, 0);
+}
+
+/* ============================================================================
+ * Load Queue
+ * ============================================================================ */
+
+typedef enum load_state {
+    LOAD_QUEUED,
+    LOAD_RUNNING,
+    LOAD_DONE,                  /* Posted to the run loop for delivery */
+} load_state;
+
+typedef struct load_job {
+    char* key;                  /* Cache key, also the dedup key */
+    char* path;
+    int max_width, max_height;
+    uint32_t hash;
+    load_state state;
+    uint32_t waiters;           /* First waiter slot or LOAD_NONE */
+    rx_image* image;            /* Pinned result */
+    rx_runloop* loop;           /* Held until delivery */
+    struct load_job* prev;      /* Queue, newest at head */
+    struct load_job* next;
+    struct load_job* chain;     /* Dedup bucket */
+} load_job;
+
+typedef struct load_waiter {
+    uint32_t generation;
+    uint32_t next;              /* Next waiter of the job, or free list link */
+    load_job* job;              /* NULL while free */
+    rx_image_loaded_fn fn;
+    void* user_data;
+} load_waiter;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_t threads[RX_IMAGE_LOADER_MAX_THREADS];
+    int thread_count;
+    int wanted_threads;
+    bool quit;
+
+    load_job* head;
+    load_job* tail;
+    load_job* buckets[LOAD_BUCKETS];
+    size_t pending;
+
+    load_waiter* waiters;
+    uint32_t waiter_count, waiter_capacity;
+    uint32_t free_waiter;
+} loader = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .free_waiter = LOAD_NONE,
+};
+
+static uint32_t key_hash(const char* key) {
+    /* FNV-1a */
+    uint32_t h = 2166136261u;
+    for (const char* p = key; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static char* load_key(const char* path, int max_width, int max_height) {
+    size_t len = strlen(path) + 32;
+    char* key = (char*)malloc(len);
+    if (key) snprintf(key, len, "%s@%dx%d", path, max_width, max_height);
+    return key;
+}
+
+static load_job* job_find(const char* key, uint32_t hash) {
+    for (load_job* j = loader.buckets[hash % LOAD_BUCKETS]; j; j = j->chain) {
+        if (j->hash == hash && strcmp(j->key, key) == 0) return j;
+    }
+    return NULL;
+}
+
+static void job_unindex(load_job* job) {
+    load_job** link = &loader.buckets[job->hash % LOAD_BUCKETS];
+    while (*link && *link != job) link = &(*link)->chain;
+    if (*link) *link = job->chain;
+    job->chain = NULL;
+}
+
+static void queue_push(load_job* job) {
+    job->prev = NULL;
+    job->next = loader.head;
+    if (loader.head) loader.head->prev = job;
+    loader.head = job;
+    if (!loader.tail) loader.tail = job;
+}
+
+static void queue_unlink(load_job* job) {
+    if (job->prev) job->prev->next = job->next;
+    else loader.head = job->next;
+    if (job->next) job->next->prev = job->prev;
+    else loader.tail = job->prev;
+    job->prev = job->next = NULL;
+}
+
+static void job_free(load_job* job) {
+    free(job->key);
+    free(job->path);
+    free(job);
+}
+
+static uint32_t waiter_alloc(void) {
+    if (loader.free_waiter != LOAD_NONE) {
+        uint32_t i = loader.free_waiter;
+        loader.free_waiter = loader.waiters[i].next;
+        return i;
+    }
+    if (loader.waiter_count == loader.waiter_capacity) {
+        uint32_t cap = loader.waiter_capacity ? loader.waiter_capacity * 2 : 64;
+        load_waiter* w = (load_waiter*)realloc(loader.waiters, sizeof(load_waiter) * cap);
+        if (!w) return LOAD_NONE;
+        loader.waiters = w;
+        loader.waiter_capacity = cap;
+    }
+    loader.waiters[loader.waiter_count].generation = 0;
+    return loader.waiter_count++;
+}
+
+static void waiter_free(uint32_t i) {
+    load_waiter* w = &loader.waiters[i];
+    w->job = NULL;
+    w->generation++;
+    w->next = loader.free_waiter;
+    loader.free_waiter = i;
+}
+
+static inline rx_image_request_id request_id(uint32_t slot) {
+    return ((uint64_t)loader.waiters[slot].generation << 32) | (uint64_t)(slot + 1);
+}
+
+static load_waiter* waiter_lookup(rx_image_request_id id, uint32_t* slot) {
+    uint32_t i = (uint32_t)(id & 0xFFFFFFFFu);
+    if (i == 0 || i > loader.waiter_count) return NULL;
+    load_waiter* w = &loader.waiters[i - 1];
+    if (!w->job || w->generation != (uint32_t)(id >> 32)) return NULL;
+    *slot = i - 1;
+    return w;
+}
+
+typedef struct load_delivery {
+    rx_image_loaded_fn fn;
+    void* user_data;
+} load_delivery;
+
+/* Run loop thread: hand the result to every waiter still attached */
+static void load_deliver(void* user_data) {
+    load_job* job = (load_job*)user_data;
+
+    pthread_mutex_lock(&loader.lock);
+    size_t count = 0;
+    for (uint32_t i = job->waiters; i != LOAD_NONE; i = loader.waiters[i].next) count++;
+    load_delivery* calls = count ? (load_delivery*)malloc(sizeof(load_delivery) * count) : NULL;
+    size_t n = 0;
+    for (uint32_t i = job->waiters; i != LOAD_NONE;) {
+        uint32_t next = loader.waiters[i].next;
+        if (calls) calls[n++] = (load_delivery){ loader.waiters[i].fn, loader.waiters[i].user_data };
+        waiter_free(i);
+        i = next;
+    }
+    job->waiters = LOAD_NONE;
+    loader.pending--;
+    pthread_mutex_unlock(&loader.lock);
+
+    /* Callbacks may queue or cancel loads, so they run unlocked */
+    for (size_t i = 0; i < n; i++) {
+        if (job->image) rx_image_cache_retain(job->image);
+        calls[i].fn(job->image, calls[i].user_data);
+    }
+    free(calls);
+    rx_image_cache_release(job->image);
+    rx_runloop_unhold(job->loop);
+    job_free(job);
+}
+
+static void* load_worker(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&loader.lock);
+    for (;;) {
+        while (!loader.quit && !loader.head) pthread_cond_wait(&loader.work, &loader.lock);
+        if (loader.quit) break;
+
+        load_job* job = loader.head;
+        queue_unlink(job);
+        job->state = LOAD_RUNNING;
+        pthread_mutex_unlock(&loader.lock);
+
+        rx_image* img = rx_image_load_sized(job->path, job->max_width, job->max_height);
+        rx_image* pinned = NULL;
+        if (img) {
+            rx_image_cache* cache = rx_image_cache_shared();
+            rx_image_cache_put(cache, job->key, img);
+            pinned = rx_image_cache_acquire(cache, job->key);
+        }
+
+        pthread_mutex_lock(&loader.lock);
+        job_unindex(job);
+        job->image = pinned;
+        job->state = LOAD_DONE;
+        pthread_mutex_unlock(&loader.lock);
+
+        if (!rx_runloop_post(job->loop, load_deliver, job)) {
+            /* Out of memory: nobody will be told, but don't leak the hold */
+            pthread_mutex_lock(&loader.lock);
+            for (uint32_t i = job->waiters; i != LOAD_NONE;) {
+                uint32_t next = loader.waiters[i].next;
+                waiter_free(i);
+                i = next;
+            }
+            loader.pending--;
+            pthread_mutex_unlock(&loader.lock);
+            rx_image_cache_release(pinned);
+            rx_runloop_unhold(job->loop);
+            job_free(job);
+        }
+        pthread_mutex_lock(&loader.lock);
+    }
+    pthread_mutex_unlock(&loader.lock);
+    return NULL;
+}
+
+/* Lock held */
+static bool loader_start(void) {
+    if (loader.thread_count > 0) return true;
+    int count = loader.wanted_threads;
+    if (count <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        count = cores > 0 ? (int)cores : 1;
+    }
+    if (count > RX_IMAGE_LOADER_MAX_THREADS) count = RX_IMAGE_LOADER_MAX_THREADS;
+    loader.quit = false;
+    for (int i = 0; i < count; i++) {
+        if (pthread_create(&loader.threads[loader.thread_count], NULL, load_worker, NULL) != 0) break;
+        loader.thread_count++;
+    }
+    return loader.thread_count > 0;
+}
+
+void rx_image_loader_set_threads(int count) {
+    pthread_mutex_lock(&loader.lock);
+    loader.wanted_threads = count < 0 ? 0 : count;
+    pthread_mutex_unlock(&loader.lock);
+}
+
+rx_image_request_id rx_image_load_async(const char* path, int max_width, int max_height,
+                                        rx_image_loaded_fn fn, void* user_data) {
+    if (!path || !fn) return 0;
+    if (max_width < 0) max_width = 0;
+    if (max_height < 0) max_height = 0;
+    char* key = load_key(path, max_width, max_height);
+    if (!key) return 0;
+
+    rx_image* cached = rx_image_cache_acquire(rx_image_cache_shared(), key);
+    if (cached) {
+        free(key);
+        fn(cached, user_data);
+        return 0;
+    }
+
+    uint32_t hash = key_hash(key);
+    pthread_mutex_lock(&loader.lock);
+    if (!loader_start()) {
+        pthread_mutex_unlock(&loader.lock);
+        free(key);
+        return 0;
+    }
+
+    load_job* job = job_find(key, hash);
+    if (job) {
+        free(key);
+        /* Asked for again: it is likely on screen now, so decode it next */
+        if (job->state == LOAD_QUEUED) {
+            queue_unlink(job);
+            queue_push(job);
+        }
+    } else {
+        job = (load_job*)calloc(1, sizeof(load_job));
+        char* path_copy = job ? strdup(path) : NULL;
+        if (!path_copy) {
+            pthread_mutex_unlock(&loader.lock);
+            free(job);
+            free(key);
+            return 0;
+        }
+        job->key = key;
+        job->path = path_copy;
+        job->max_width = max_width;
+        job->max_height = max_height;
+        job->hash = hash;
+        job->state = LOAD_QUEUED;
+        job->waiters = LOAD_NONE;
+        job->loop = rx_runloop_main();
+        job->chain = loader.buckets[hash % LOAD_BUCKETS];
+        loader.buckets[hash % LOAD_BUCKETS] = job;
+        queue_push(job);
+        loader.pending++;
+        rx_runloop_hold(job->loop);
+        pthread_cond_signal(&loader.work);
+    }
+
+    uint32_t slot = waiter_alloc();
+    rx_image_request_id id = 0;
+    if (slot != LOAD_NONE) {
+        load_waiter* w = &loader.waiters[slot];
+        w->job = job;
+        w->fn = fn;
+        w->user_data = user_data;
+        w->next = job->waiters;
+        job->waiters = slot;
+        id = request_id(slot);
+    }
+    /* A job nobody waits for is left to finish; its result is still cached */
+    pthread_mutex_unlock(&loader.lock);
+    return id;
+}
+
+bool rx_image_load_cancel(rx_image_request_id id) {
+    if (id == 0) return false;
+    pthread_mutex_lock(&loader.lock);
+    uint32_t slot;
+    load_waiter* w = waiter_lookup(id, &slot);
+    if (!w) {
+        pthread_mutex_unlock(&loader.lock);
+        return false;
+    }
+
+    load_job* job = w->job;
+    uint32_t* link = &job->waiters;
+    while (*link != slot) link = &loader.waiters[*link].next;
+    *link = w->next;
+    waiter_free(slot);
+
+    /* Last waiter gone before decoding started: drop the job */
+    load_job* dropped = NULL;
+    if (job->waiters == LOAD_NONE && job->state == LOAD_QUEUED) {
+        queue_unlink(job);
+        job_unindex(job);
+        loader.pending--;
+        dropped = job;
+    }
+    pthread_mutex_unlock(&loader.lock);
+
+    if (dropped) {
+        rx_runloop_unhold(dropped->loop);
+        job_free(dropped);
+    }
+    return true;
+}
+
+size_t rx_image_loader_pending(void) {
+    pthread_mutex_lock(&loader.lock);
+    size_t pending = loader.pending;
+    pthread_mutex_unlock(&loader.lock);
+    return pending;
+}
+
+void rx_image_loader_shutdown(void) {
+    pthread_mutex_lock(&loader.lock);
+    loader.quit = true;
+    pthread_cond_broadcast(&loader.work);
+    int count = loader.thread_count;
+    pthread_mutex_unlock(&loader.lock);
+
+    for (int i = 0; i < count; i++) pthread_join(loader.threads[i], NULL);
+
+    /* Jobs already posted still deliver; queued ones are dropped */
+    pthread_mutex_lock(&loader.lock);
+    loader.thread_count = 0;
+    loader.quit = false;
+    while (loader.head) {
+        load_job* job = loader.head;
+        queue_unlink(job);
+        job_unindex(job);
+        for (uint32_t i = job->waiters; i != LOAD_NONE;) {
+            uint32_t next = loader.waiters[i].next;
+            waiter_free(i);
+            i = next;
+        }
+        loader.pending--;
+        rx_runloop_unhold(job->loop);
+        job_free(job);
+    }
+    pthread_mutex_unlock(&loader.lock);
+}
+
+/* ============================================================================
+ * Image View Loading
+ * ============================================================================ */
+
+static void image_view_show(rx_image_view* view, rx_image* img) {
+    if (!img) return;       /* Failed: keep the placeholder */
+    if (view->image) rx_image_cache_release((rx_image*)view->image);
+    view->image = img;
+    view->texture_handle = NULL;
+
+    if (view->natural_size.width <= 0 && view->natural_size.height <= 0) {
+        view->natural_size = size((float)img->width, (float)img->height);
+        view_set_needs_layout(&view->base);
+    }
+    rx_runloop_request_frame(rx_runloop_main());
+}
+
+static void image_view_loaded(rx_image* img, void* user_data) {
+    rx_image_view* view = (rx_image_view*)user_data;
+    view->load_request = 0;
+    image_view_show(view, img);
+}
+
+static void image_view_release(rx_image_view* view) {
+    rx_image_view_cancel_load(view);
+    if (view->image) {
+        rx_image_cache_release((rx_image*)view->image);
+        view->image = NULL;
+    }
+}
+
+bool rx_image_view_load(rx_image_view* view, int max_width, int max_height) {
+    if (!view || !view->source) return false;
+    rx_image_view_cancel_load(view);
+    view->release_image = image_view_release;
+
+    if (max_width <= 0 && max_height <= 0) {
+        max_width = (int)(view->base.box.frame.width + 0.5f);
+        max_height = (int)(view->base.box.frame.height + 0.5f);
+    }
+
+    char* key = load_key(view->source, max_width > 0 ? max_width : 0, max_height > 0 ? max_height : 0);
+    rx_image* cached = key ? rx_image_cache_acquire(rx_image_cache_shared(), key) : NULL;
+    free(key);
+    if (cached) {
+        image_view_show(view, cached);
+        return true;
+    }
+
+    view->load_request = rx_image_load_async(view->source, max_width, max_height, image_view_loaded, view);
+    return view->load_request != 0;
+}
+
+bool rx_image_view_set_source(rx_image_view* view, const char* source, int max_width, int max_height) {
+    if (!view) return false;
+    if (!source || !view->source || strcmp(source, view->source) != 0) {
+        rx_image_view_cancel_load(view);
+        if (view->image) {
+            rx_image_cache_release((rx_image*)view->image);
+            view->image = NULL;
+        }
+        free((void*)view->source);
+        view->source = source ? strdup(source) : NULL;
+        view->natural_size = size(0, 0);
+    }
+    return rx_image_view_load(view, max_width, max_height);
+}
+
+void rx_image_view_cancel_load(rx_image_view* view) {
+    if (!view || !view->load_request) return;
+    rx_image_load_cancel(view->load_request);
+    view->load_request = 0;
+}
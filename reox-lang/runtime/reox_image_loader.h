@@ -0,0 +1,125 @@
+/*
+ * REOX Image Loader
+ * Image decoding and background loading for image views
+ *
+ * Features:
+ * - Pluggable decoders; binary PNM (PGM/PPM) and BMP are built in
+ * - Decode to a target size: rows are box-filtered into the output as they
+ *   are decoded, so a thumbnail never holds the full-size image
+ * - Pool of decode threads fed newest-first, so the rows that just
+ *   scrolled into view decode before ones requested earlier
+ * - Requests for the same path and size share one decode
+ * - Cancellation of requests whose view scrolled away
+ * - Results land in the shared image cache and are delivered on the UI
+ *   thread through rx_runloop_post
+ * - image_view loading: placeholder first, image swapped in on arrival
+ *
+ * Link with -pthread.
+ */
+
+#ifndef REOX_IMAGE_LOADER_H
+#define REOX_IMAGE_LOADER_H
+
+#include "reox_image_system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Decoders
+ * ============================================================================ */
+
+#define RX_IMAGE_MAX_DECODERS 16
+#define RX_IMAGE_LOADER_MAX_THREADS 8
+
+typedef struct rx_image_decoder {
+    const char* name;
+    bool (*probe)(const uint8_t* data, size_t size);
+    /* Decode fitting within max_width x max_height (0: unconstrained),
+     * preserving aspect ratio; decoders feed an rx_decode_target */
+    rx_image* (*decode)(const uint8_t* data, size_t size, int max_width, int max_height);
+} rx_image_decoder;
+
+/* Later registrations are probed first, so they can override built-ins */
+extern bool rx_image_register_decoder(const rx_image_decoder* decoder);
+
+extern rx_image* rx_image_load_sized(const char* path, int max_width, int max_height);
+extern rx_image* rx_image_load_from_memory_sized(const void* data, size_t size,
+                                                 int max_width, int max_height);
+
+/*
+ * Downsampling sink for decoders. Feed source rows top to bottom; each
+ * output pixel is the average of the source pixels that map onto it. Only
+ * 8-bit formats.
+ */
+typedef struct rx_decode_target {
+    rx_image* image;
+    int src_width, src_height;
+    int channels;
+    int src_row;
+    int out_row;
+    int* column_map;          /* Source column -> output column */
+    uint32_t* column_count;   /* Source columns per output column */
+    uint64_t* sums;           /* Accumulated output row */
+    uint32_t band_rows;       /* Source rows in sums */
+} rx_decode_target;
+
+extern bool rx_decode_target_init(rx_decode_target* target, int src_width, int src_height,
+                                  rx_image_format format, int max_width, int max_height);
+extern void rx_decode_target_row(rx_decode_target* target, const uint8_t* row);
+/* Returns the image (NULL if rows are missing) and frees the scratch */
+extern rx_image* rx_decode_target_finish(rx_decode_target* target);
+
+/* ============================================================================
+ * Background Loading
+ * ============================================================================ */
+
+typedef uint64_t rx_image_request_id;    /* 0: none */
+
+/* UI thread. img is pinned in rx_image_cache_shared(); release it with
+ * rx_image_cache_release. NULL if the image could not be decoded. */
+typedef void (*rx_image_loaded_fn)(rx_image* img, void* user_data);
+
+/* Decode threads; call before the first request (0: one per core, at most
+ * RX_IMAGE_LOADER_MAX_THREADS) */
+extern void rx_image_loader_set_threads(int count);
+
+/*
+ * UI thread. Decode path at most max_width x max_height in the background
+ * and call fn from rx_runloop_main() once done. A cached image is
+ * delivered before this returns and 0 is returned.
+ */
+extern rx_image_request_id rx_image_load_async(const char* path, int max_width, int max_height,
+                                               rx_image_loaded_fn fn, void* user_data);
+/* UI thread. fn will not be called; false if already delivered */
+extern bool rx_image_load_cancel(rx_image_request_id id);
+
+/* Requests queued or decoding */
+extern size_t rx_image_loader_pending(void);
+
+/* Stops the decode threads; queued requests are dropped undelivered */
+extern void rx_image_loader_shutdown(void);
+
+/* ============================================================================
+ * Image View Loading
+ * ============================================================================ */
+
+/*
+ * Load view->source in the background, sized to max_width x max_height
+ * (0 x 0: the view's current frame, or full size before layout). The view
+ * keeps its placeholder until the image arrives; a cached image is shown
+ * at once. Replaces the view's previous image and pending load.
+ */
+extern bool rx_image_view_load(rx_image_view* view, int max_width, int max_height);
+/* For recycled list rows: new source, then load */
+extern bool rx_image_view_set_source(rx_image_view* view, const char* source,
+                                     int max_width, int max_height);
+/* Row scrolled out of a virtualized list: drop the pending load */
+extern void rx_image_view_cancel_load(rx_image_view* view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_IMAGE_LOADER_H */
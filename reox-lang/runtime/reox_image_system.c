@@ -0,0 +1,1801 @@
+/*
+ * REOX Image System - Implementation
+ * Image storage, filters and compositing
+ *
+ * Filters are tiled row kernels written so the compiler vectorizes the
+ * inner loops for the target (SSE/AVX on x86, NEON on ARM, scalar
+ * elsewhere), split into row bands across a small pool of filter threads.
+ */
+
+#include "reox_image_system.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RX_IMAGE_TILE 1024              /* Elements per inner-loop tile */
+#define RX_IMAGE_MAX_THREADS 16
+#define RX_IMAGE_MIN_PARALLEL 16384     /* Pixels below which a filter stays on one thread */
+#define RX_IMAGE_BOX_MAX_RADIUS 1000    /* Keeps box sums inside 32 bits */
+#define RX_IMAGE_GAUSS_BOX_SIGMA 4.0f   /* Larger sigmas use three box passes */
+
+/* ============================================================================
+ * Formats
+ * ============================================================================ */
+
+static int format_bytes(rx_image_format format) {
+    switch (format) {
+        case RX_IMAGE_RGBA8: return 4;
+        case RX_IMAGE_RGB8: return 3;
+        case RX_IMAGE_GRAY8: return 1;
+        case RX_IMAGE_GRAY16: return 2;
+        case RX_IMAGE_RGBA16F: return 8;
+        case RX_IMAGE_RGBA32F: return 16;
+    }
+    return 0;
+}
+
+/* Channels of an 8-bit format, 0 for formats the filters don't handle */
+static int filter_channels(const rx_image* img) {
+    if (!img || !img->data) return 0;
+    switch (img->format) {
+        case RX_IMAGE_RGBA8: return 4;
+        case RX_IMAGE_RGB8: return 3;
+        case RX_IMAGE_GRAY8: return 1;
+        default: return 0;
+    }
+}
+
+static bool same_shape(const rx_image* a, const rx_image* b) {
+    return a && b && a->width == b->width && a->height == b->height && a->format == b->format;
+}
+
+static inline uint8_t* image_row(const rx_image* img, int y) {
+    return img->data + (size_t)y * (size_t)img->stride;
+}
+
+static inline int clamp_index(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/* ============================================================================
+ * Image Creation
+ * ============================================================================ */
+
+rx_image* rx_image_create(int width, int height, rx_image_format format) {
+    int bytes = format_bytes(format);
+    if (width <= 0 || height <= 0 || bytes == 0) return NULL;
+
+    rx_image* img = (rx_image*)calloc(1, sizeof(rx_image));
+    if (!img) return NULL;
+
+    /* Rows start on 16-byte boundaries for the vector loops */
+    img->stride = (width * bytes + 15) & ~15;
+    img->data = (uint8_t*)calloc((size_t)img->stride, (size_t)height);
+    if (!img->data) {
+        free(img);
+        return NULL;
+    }
+    img->width = width;
+    img->height = height;
+    img->format = format;
+    img->owns_data = true;
+    img->texture_dirty = true;
+    img->dpi = 72.0f;
+    return img;
+}
+
+rx_image* rx_image_create_with_data(int width, int height, rx_image_format format, void* data) {
+    int bytes = format_bytes(format);
+    if (width <= 0 || height <= 0 || bytes == 0 || !data) return NULL;
+
+    rx_image* img = (rx_image*)calloc(1, sizeof(rx_image));
+    if (!img) return NULL;
+    img->data = (uint8_t*)data;
+    img->width = width;
+    img->height = height;
+    img->format = format;
+    img->stride = width * bytes;
+    img->owns_data = false;
+    img->texture_dirty = true;
+    img->dpi = 72.0f;
+    return img;
+}
+
+rx_image* rx_image_copy(rx_image* src) {
+    if (!src || !src->data) return NULL;
+    rx_image* img = rx_image_create(src->width, src->height, src->format);
+    if (!img) return NULL;
+
+    size_t row_bytes = (size_t)src->width * (size_t)format_bytes(src->format);
+    for (int y = 0; y < src->height; y++) {
+        memcpy(image_row(img, y), image_row(src, y), row_bytes);
+    }
+    img->source_path = src->source_path;
+    img->dpi = src->dpi;
+    return img;
+}
+
+void rx_image_destroy(rx_image* img) {
+    if (!img) return;
+    if (img->owns_data) free(img->data);
+    free(img);
+}
+
+/* Output image (or in-place scratch) with src's size and format */
+static rx_image* image_like(const rx_image* src) {
+    return rx_image_create(src->width, src->height, src->format);
+}
+
+/* ============================================================================
+ * Pixel Access
+ * ============================================================================ */
+
+rx_color rx_image_get_pixel(rx_image* img, int x, int y) {
+    rx_color c = { 0, 0, 0, 0 };
+    if (!filter_channels(img) || x < 0 || y < 0 || x >= img->width || y >= img->height) return c;
+
+    const uint8_t* p = image_row(img, y) + x * filter_channels(img);
+    switch (img->format) {
+        case RX_IMAGE_RGBA8: c = (rx_color){ p[0], p[1], p[2], p[3] }; break;
+        case RX_IMAGE_RGB8: c = (rx_color){ p[0], p[1], p[2], 255 }; break;
+        default: c = (rx_color){ p[0], p[0], p[0], 255 }; break;
+    }
+    return c;
+}
+
+void rx_image_set_pixel(rx_image* img, int x, int y, rx_color color) {
+    if (!filter_channels(img) || x < 0 || y < 0 || x >= img->width || y >= img->height) return;
+
+    uint8_t* p = image_row(img, y) + x * filter_channels(img);
+    switch (img->format) {
+        case RX_IMAGE_RGBA8: p[0] = color.r; p[1] = color.g; p[2] = color.b; p[3] = color.a; break;
+        case RX_IMAGE_RGB8: p[0] = color.r; p[1] = color.g; p[2] = color.b; break;
+        default: p[0] = (uint8_t)(0.2126f * color.r + 0.7152f * color.g + 0.0722f * color.b + 0.5f); break;
+    }
+    img->texture_dirty = true;
+}
+
+void rx_image_fill_rect(rx_image* img, rx_rect rect, rx_color color) {
+    int c = filter_channels(img);
+    if (!c) return;
+
+    int x0 = clamp_index((int)floorf(rect.x), 0, img->width);
+    int y0 = clamp_index((int)floorf(rect.y), 0, img->height);
+    int x1 = clamp_index((int)ceilf(rect.x + rect.width), 0, img->width);
+    int y1 = clamp_index((int)ceilf(rect.y + rect.height), 0, img->height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    /* Fill the first row pixel by pixel, then copy it down */
+    for (int x = x0; x < x1; x++) rx_image_set_pixel(img, x, y0, color);
+    size_t bytes = (size_t)(x1 - x0) * (size_t)c;
+    const uint8_t* first = image_row(img, y0) + x0 * c;
+    for (int y = y0 + 1; y < y1; y++) {
+        memcpy(image_row(img, y) + x0 * c, first, bytes);
+    }
+    img->texture_dirty = true;
+}
+
+void rx_image_fill(rx_image* img, rx_color color) {
+    if (!img) return;
+    rx_image_fill_rect(img, (rx_rect){ 0, 0, (float)img->width, (float)img->height }, color);
+}
+
+/* ============================================================================
+ * Filter Threads
+ * ============================================================================ */
+
+/* Processes output rows [y0, y1) */
+typedef void (*image_band_fn)(void* ctx, int y0, int y1);
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    pthread_mutex_t submit;     /* One banded job at a time; others run inline */
+    pthread_t threads[RX_IMAGE_MAX_THREADS];
+    int started;
+    int limit;                  /* rx_image_set_threads, 0: auto */
+
+    /* Current job, guarded by lock */
+    image_band_fn fn;
+    void* ctx;
+    int rows, band_rows;
+    int band_count, next_band, bands_done;
+    int workers;                /* Pool threads allowed to take bands */
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .submit = PTHREAD_MUTEX_INITIALIZER,
+};
+
+void rx_image_set_threads(int count) {
+    pthread_mutex_lock(&pool.lock);
+    pool.limit = count < 0 ? 0 : (count > RX_IMAGE_MAX_THREADS ? RX_IMAGE_MAX_THREADS : count);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static int threads_wanted(void) {
+    if (pool.limit > 0) return pool.limit;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    return cores > RX_IMAGE_MAX_THREADS ? RX_IMAGE_MAX_THREADS : (int)cores;
+}
+
+int rx_image_threads(void) {
+    pthread_mutex_lock(&pool.lock);
+    int n = threads_wanted();
+    pthread_mutex_unlock(&pool.lock);
+    return n;
+}
+
+/* Take the next band of the current job; called with lock held */
+static bool pool_claim(image_band_fn* fn, void** ctx, int* y0, int* y1) {
+    if (!pool.fn || pool.next_band >= pool.band_count) return false;
+    int band = pool.next_band++;
+    *fn = pool.fn;
+    *ctx = pool.ctx;
+    *y0 = band * pool.band_rows;
+    *y1 = *y0 + pool.band_rows < pool.rows ? *y0 + pool.band_rows : pool.rows;
+    return true;
+}
+
+static void pool_finish_band(void) {
+    if (++pool.bands_done == pool.band_count) pthread_cond_broadcast(&pool.done);
+}
+
+static void* pool_worker(void* arg) {
+    int index = (int)(intptr_t)arg;
+    image_band_fn fn;
+    void* ctx;
+    int y0, y1;
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (index >= pool.workers || !pool_claim(&fn, &ctx, &y0, &y1)) {
+            pthread_cond_wait(&pool.work, &pool.lock);
+        }
+        pthread_mutex_unlock(&pool.lock);
+        fn(ctx, y0, y1);
+        pthread_mutex_lock(&pool.lock);
+        pool_finish_band();
+    }
+    return NULL;
+}
+
+/* Called with lock held; returns how many pool threads are running */
+static int pool_start(int wanted) {
+    while (pool.started < wanted) {
+        if (pthread_create(&pool.threads[pool.started], NULL, pool_worker,
+                           (void*)(intptr_t)pool.started) != 0) {
+            break;
+        }
+        pthread_detach(pool.threads[pool.started]);
+        pool.started++;
+    }
+    return pool.started < wanted ? pool.started : wanted;
+}
+
+/*
+ * Run fn over rows in bands. The calling thread takes bands too; if another
+ * banded job is already running (a filter from a decode thread, say) the
+ * call simply runs inline.
+ */
+static void image_parallel(int rows, size_t pixels, image_band_fn fn, void* ctx) {
+    if (rows <= 0) return;
+    if (pixels < RX_IMAGE_MIN_PARALLEL || rows < 16 || pthread_mutex_trylock(&pool.submit) != 0) {
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    int threads = threads_wanted();
+    int helpers = threads > 1 ? pool_start(threads - 1) : 0;
+    if (helpers == 0) {
+        pthread_mutex_unlock(&pool.lock);
+        pthread_mutex_unlock(&pool.submit);
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    /* A few bands per thread evens out uneven progress */
+    int band_rows = rows / ((helpers + 1) * 4);
+    if (band_rows < 8) band_rows = 8;
+    pool.fn = fn;
+    pool.ctx = ctx;
+    pool.rows = rows;
+    pool.band_rows = band_rows;
+    pool.band_count = (rows + band_rows - 1) / band_rows;
+    pool.next_band = 0;
+    pool.bands_done = 0;
+    pool.workers = helpers;
+    pthread_cond_broadcast(&pool.work);
+
+    image_band_fn band_fn;
+    void* band_ctx;
+    int y0, y1;
+    while (pool_claim(&band_fn, &band_ctx, &y0, &y1)) {
+        pthread_mutex_unlock(&pool.lock);
+        band_fn(band_ctx, y0, y1);
+        pthread_mutex_lock(&pool.lock);
+        pool_finish_band();
+    }
+    while (pool.bands_done < pool.band_count) pthread_cond_wait(&pool.done, &pool.lock);
+    pool.fn = NULL;
+    pool.workers = 0;
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.submit);
+}
+
+/* ============================================================================
+ * Row Kernels
+ * ============================================================================ */
+
+/* acc[i] = w * src[i] */
+static void row_scale_u8(float* restrict acc, const uint8_t* restrict src, float w, int n) {
+    for (int i = 0; i < n; i++) acc[i] = w * (float)src[i];
+}
+
+/* acc[i] += w * src[i] */
+static void row_madd_u8(float* restrict acc, const uint8_t* restrict src, float w, int n) {
+    for (int i = 0; i < n; i++) acc[i] += w * (float)src[i];
+}
+
+static void row_madd_f32(float* restrict acc, const float* restrict src, float w, int n) {
+    for (int i = 0; i < n; i++) acc[i] += w * src[i];
+}
+
+static void row_to_f32(float* restrict dst, const uint8_t* restrict src, int n) {
+    for (int i = 0; i < n; i++) dst[i] = (float)src[i];
+}
+
+/* Round and saturate; the clamp is kept apart from the math loops so both
+ * vectorize */
+static void row_store_u8(uint8_t* restrict dst, float* restrict acc, float bias, int n) {
+    for (int i = 0; i < n; i++) {
+        float v = acc[i] + bias;
+        v = v > 0.0f ? v : 0.0f;
+        v = v < 255.0f ? v : 255.0f;
+        acc[i] = v;
+    }
+    for (int i = 0; i < n; i++) dst[i] = (uint8_t)acc[i];
+}
+
+/* Replicate the edge pixels of a row into pad elements on either side */
+static void row_pad_f32(float* row, int n, int c, int pad) {
+    for (int i = 0; i < pad; i++) {
+        row[i] = row[pad + i % c];
+        row[pad + n + i] = row[pad + n - c + i % c];
+    }
+}
+
+static void row_copy_alpha(uint8_t* restrict dst, const uint8_t* restrict src, int width) {
+    for (int x = 0; x < width; x++) dst[x * 4 + 3] = src[x * 4 + 3];
+}
+
+/* ============================================================================
+ * Separable Convolution
+ * ============================================================================ */
+
+typedef struct separable_job {
+    const rx_image* src;
+    rx_image* dst;
+    int channels;
+    const float* wx;            /* Horizontal taps, centered on kx */
+    const float* wy;            /* Vertical taps, centered on ky */
+    int kw, kh, cx, cy;
+    float bias;
+    bool keep_alpha;
+} separable_job;
+
+/*
+ * Vertical pass straight from the 8-bit rows into a padded float row, then
+ * the horizontal pass from that row into the output, one tile of each at a
+ * time. No full-size intermediate is needed.
+ */
+static void separable_band(void* ctx, int y0, int y1) {
+    const separable_job* job = (const separable_job*)ctx;
+    const rx_image* src = job->src;
+    int c = job->channels;
+    int n = src->width * c;
+    int pad_l = job->cx * c, pad_r = (job->kw - 1 - job->cx) * c;
+    int pad = pad_l > pad_r ? pad_l : pad_r;
+
+    float* row = (float*)malloc(sizeof(float) * (size_t)(n + 2 * pad));
+    float* acc = (float*)malloc(sizeof(float) * RX_IMAGE_TILE);
+    if (!row || !acc) { free(row); free(acc); return; }
+
+    for (int y = y0; y < y1; y++) {
+        for (int x0 = 0; x0 < n; x0 += RX_IMAGE_TILE) {
+            int len = n - x0 < RX_IMAGE_TILE ? n - x0 : RX_IMAGE_TILE;
+            float* out = row + pad + x0;
+            for (int k = 0; k < job->kh; k++) {
+                int sy = clamp_index(y + k - job->cy, 0, src->height - 1);
+                const uint8_t* in = image_row(src, sy) + x0;
+                if (k == 0) row_scale_u8(out, in, job->wy[k], len);
+                else row_madd_u8(out, in, job->wy[k], len);
+            }
+        }
+        row_pad_f32(row, n, c, pad);
+
+        uint8_t* dst = image_row(job->dst, y);
+        for (int x0 = 0; x0 < n; x0 += RX_IMAGE_TILE) {
+            int len = n - x0 < RX_IMAGE_TILE ? n - x0 : RX_IMAGE_TILE;
+            const float* in = row + pad + x0 - pad_l;
+            memset(acc, 0, sizeof(float) * (size_t)len);
+            for (int k = 0; k < job->kw; k++) {
+                row_madd_f32(acc, in + k * c, job->wx[k], len);
+            }
+            row_store_u8(dst + x0, acc, job->bias, len);
+        }
+        if (job->keep_alpha) row_copy_alpha(dst, image_row(src, y), src->width);
+    }
+    free(row);
+    free(acc);
+}
+
+static void run_separable(separable_job* job) {
+    image_parallel(job->src->height, (size_t)job->src->width * (size_t)job->src->height,
+                   separable_band, job);
+}
+
+/* ============================================================================
+ * Box Blur
+ * ============================================================================ */
+
+typedef struct box_job {
+    const rx_image* src;
+    rx_image* dst;
+    int channels;
+    int radius;
+} box_job;
+
+/*
+ * Exact box blur with running sums: a sliding vertical window sum per
+ * column (vectorized across the row), then a prefix sum along the row so
+ * each output is one subtraction. Cost is independent of the radius.
+ * Sums wrap modulo 2^32, which leaves the window differences exact.
+ */
+static void box_band(void* ctx, int y0, int y1) {
+    const box_job* job = (const box_job*)ctx;
+    const rx_image* src = job->src;
+    int c = job->channels, r = job->radius;
+    int n = src->width * c;
+    int pad = r * c;
+    int window = (2 * r + 1) * c;
+    int last = src->height - 1;
+
+    uint32_t* col = (uint32_t*)calloc((size_t)n, sizeof(uint32_t));
+    uint32_t* prefix = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(n + 2 * pad + c));
+    float* acc = (float*)malloc(sizeof(float) * (size_t)n);
+    if (!col || !prefix || !acc) { free(col); free(prefix); free(acc); return; }
+
+    for (int k = -r; k <= r; k++) {
+        const uint8_t* in = image_row(src, clamp_index(y0 + k, 0, last));
+        for (int i = 0; i < n; i++) col[i] += in[i];
+    }
+
+    float inv = 1.0f / (float)((2 * r + 1) * (2 * r + 1));
+    for (int y = y0; y < y1; y++) {
+        if (y > y0) {
+            const uint8_t* add = image_row(src, clamp_index(y + r, 0, last));
+            const uint8_t* sub = image_row(src, clamp_index(y - r - 1, 0, last));
+            for (int i = 0; i < n; i++) col[i] += (uint32_t)add[i] - (uint32_t)sub[i];
+        }
+
+        /* prefix[j + c] = prefix[j] + padded[j], per channel */
+        for (int j = 0; j < c; j++) prefix[j] = 0;
+        uint32_t* p = prefix + c;
+        for (int j = 0; j < pad; j++) p[j] = p[j - c] + col[j % c];
+        p += pad;
+        for (int j = 0; j < n; j++) p[j] = p[j - c] + col[j];
+        p += n;
+        for (int j = 0; j < pad; j++) p[j] = p[j - c] + col[n - c + j % c];
+
+        for (int i = 0; i < n; i++) acc[i] = (float)(prefix[i + window] - prefix[i]) * inv;
+        row_store_u8(image_row(job->dst, y), acc, 0.5f, n);
+    }
+    free(col);
+    free(prefix);
+    free(acc);
+}
+
+/* Neighbourhood filters read rows other bands write: in place needs a copy */
+static rx_image* filter_source(rx_image* dst, rx_image* src) {
+    return dst->data == src->data ? rx_image_copy(src) : src;
+}
+
+static void filter_done(rx_image* dst, rx_image* src, rx_image* used) {
+    if (used != src) rx_image_destroy(used);
+    dst->texture_dirty = true;
+}
+
+bool rx_image_box_blur_into(rx_image* dst, rx_image* src, int radius) {
+    int c = filter_channels(src);
+    if (!c || !same_shape(dst, src)) return false;
+
+    rx_image* in = filter_source(dst, src);
+    if (!in) return false;
+    if (radius > RX_IMAGE_BOX_MAX_RADIUS) radius = RX_IMAGE_BOX_MAX_RADIUS;
+
+    if (radius <= 0) {
+        size_t bytes = (size_t)src->width * (size_t)c;
+        for (int y = 0; y < src->height; y++) memcpy(image_row(dst, y), image_row(in, y), bytes);
+    } else {
+        box_job job = { in, dst, c, radius };
+        image_parallel(src->height, (size_t)src->width * (size_t)src->height, box_band, &job);
+    }
+    filter_done(dst, src, in);
+    return true;
+}
+
+rx_image* rx_image_box_blur(rx_image* img, int radius) {
+    if (!filter_channels(img)) return NULL;
+    rx_image* out = image_like(img);
+    if (out && !rx_image_box_blur_into(out, img, radius)) {
+        rx_image_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+/* ============================================================================
+ * Gaussian Blur
+ * ============================================================================ */
+
+/* Box radii whose three passes approximate a Gaussian of sigma */
+static void gauss_boxes(float sigma, int radii[3]) {
+    float ideal = sqrtf(12.0f * sigma * sigma / 3.0f + 1.0f);
+    int lower = (int)floorf(ideal);
+    if (lower % 2 == 0) lower--;
+    int upper = lower + 2;
+    float m_ideal = (12.0f * sigma * sigma - 3.0f * lower * lower - 12.0f * lower - 9.0f) /
+                    (-4.0f * lower - 4.0f);
+    int m = (int)roundf(m_ideal);
+    for (int i = 0; i < 3; i++) radii[i] = ((i < m ? lower : upper) - 1) / 2;
+}
+
+bool rx_image_gaussian_blur_into(rx_image* dst, rx_image* src, float sigma) {
+    int c = filter_channels(src);
+    if (!c || !same_shape(dst, src)) return false;
+    if (!(sigma > 0.0f)) return rx_image_box_blur_into(dst, src, 0);
+
+    if (sigma > RX_IMAGE_GAUSS_BOX_SIGMA) {
+        int radii[3];
+        gauss_boxes(sigma, radii);
+        rx_image* tmp = image_like(src);
+        if (!tmp) return false;
+        bool ok = rx_image_box_blur_into(dst, src, radii[0]) &&
+                  rx_image_box_blur_into(tmp, dst, radii[1]) &&
+                  rx_image_box_blur_into(dst, tmp, radii[2]);
+        rx_image_destroy(tmp);
+        dst->texture_dirty = true;
+        return ok;
+    }
+
+    int r = (int)ceilf(3.0f * sigma);
+    int taps = 2 * r + 1;
+    float* w = (float*)malloc(sizeof(float) * (size_t)taps);
+    if (!w) return false;
+    float sum = 0;
+    for (int i = 0; i < taps; i++) {
+        float d = (float)(i - r);
+        w[i] = expf(-d * d / (2.0f * sigma * sigma));
+        sum += w[i];
+    }
+    for (int i = 0; i < taps; i++) w[i] /= sum;
+
+    rx_image* in = filter_source(dst, src);
+    if (!in) { free(w); return false; }
+    separable_job job = { in, dst, c, w, w, taps, taps, r, r, 0.5f, false };
+    run_separable(&job);
+    filter_done(dst, src, in);
+    free(w);
+    return true;
+}
+
+rx_image* rx_image_gaussian_blur(rx_image* img, float sigma) {
+    if (!filter_channels(img)) return NULL;
+    rx_image* out = image_like(img);
+    if (out && !rx_image_gaussian_blur_into(out, img, sigma)) {
+        rx_image_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+/* Radius is the CSS blur() standard deviation */
+rx_image* rx_image_blur(rx_image* img, float radius) {
+    return rx_image_gaussian_blur(img, radius);
+}
+
+/* ============================================================================
+ * Convolution Kernels
+ * ============================================================================ */
+
+rx_kernel* rx_kernel_create(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+    rx_kernel* k = (rx_kernel*)calloc(1, sizeof(rx_kernel));
+    if (!k) return NULL;
+    k->values = (float*)calloc((size_t)width * (size_t)height, sizeof(float));
+    if (!k->values) {
+        free(k);
+        return NULL;
+    }
+    k->width = width;
+    k->height = height;
+    k->divisor = 1.0f;
+    return k;
+}
+
+rx_kernel* rx_kernel_gaussian(int size, float sigma) {
+    if (size < 1) size = 1;
+    if (size % 2 == 0) size++;
+    rx_kernel* k = rx_kernel_create(size, size);
+    if (!k) return NULL;
+
+    int r = size / 2;
+    float sum = 0;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float dx = (float)(x - r), dy = (float)(y - r);
+            float v = sigma > 0 ? expf(-(dx * dx + dy * dy) / (2.0f * sigma * sigma)) : (x == r && y == r);
+            k->values[y * size + x] = v;
+            sum += v;
+        }
+    }
+    for (int i = 0; i < size * size; i++) k->values[i] /= sum;
+    return k;
+}
+
+static rx_kernel* kernel_3x3(const float values[9]) {
+    rx_kernel* k = rx_kernel_create(3, 3);
+    if (k) memcpy(k->values, values, sizeof(float) * 9);
+    return k;
+}
+
+rx_kernel* rx_kernel_sharpen(void) {
+    static const float v[9] = { 0, -1, 0, -1, 5, -1, 0, -1, 0 };
+    return kernel_3x3(v);
+}
+
+rx_kernel* rx_kernel_edge_detect(void) {
+    static const float v[9] = { -1, -1, -1, -1, 8, -1, -1, -1, -1 };
+    return kernel_3x3(v);
+}
+
+rx_kernel* rx_kernel_emboss(void) {
+    static const float v[9] = { -2, -1, 0, -1, 1, 1, 0, 1, 2 };
+    return kernel_3x3(v);
+}
+
+void rx_kernel_destroy(rx_kernel* kernel) {
+    if (!kernel) return;
+    free(kernel->values);
+    free(kernel);
+}
+
+/* ============================================================================
+ * General Convolution
+ * ============================================================================ */
+
+/*
+ * Split a rank-1 kernel into column and row taps (u * v^T), which turns a
+ * kw*kh kernel into kw + kh taps per pixel. Box, Gaussian and Sobel-style
+ * kernels all qualify.
+ */
+static bool kernel_separate(const rx_kernel* k, float* u, float* v) {
+    const float* m = k->values;
+    int pr = 0, pc = 0;
+    float peak = 0;
+    for (int i = 0; i < k->width * k->height; i++) {
+        if (fabsf(m[i]) > peak) { peak = fabsf(m[i]); pr = i / k->width; pc = i % k->width; }
+    }
+    if (peak == 0) return false;
+
+    float pivot = m[pr * k->width + pc];
+    for (int y = 0; y < k->height; y++) u[y] = m[y * k->width + pc];
+    for (int x = 0; x < k->width; x++) v[x] = m[pr * k->width + x] / pivot;
+
+    float tolerance = peak * 1e-5f;
+    for (int y = 0; y < k->height; y++) {
+        for (int x = 0; x < k->width; x++) {
+            if (fabsf(u[y] * v[x] - m[y * k->width + x]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+typedef struct convolve_job {
+    const rx_image* src;
+    rx_image* dst;
+    int channels;
+    const float* values;        /* Scaled by 1 / divisor */
+    int kw, kh, cx, cy;
+    float bias;
+} convolve_job;
+
+/* Full 2D kernel: a ring of kh padded float rows, each converted once */
+static void convolve_band(void* ctx, int y0, int y1) {
+    const convolve_job* job = (const convolve_job*)ctx;
+    const rx_image* src = job->src;
+    int c = job->channels;
+    int n = src->width * c;
+    int pad_l = job->cx * c, pad_r = (job->kw - 1 - job->cx) * c;
+    int pad = pad_l > pad_r ? pad_l : pad_r;
+    size_t row_len = (size_t)(n + 2 * pad);
+
+    float* ring = (float*)malloc(sizeof(float) * row_len * (size_t)job->kh);
+    int* ring_y = (int*)malloc(sizeof(int) * (size_t)job->kh);
+    float* acc = (float*)malloc(sizeof(float) * RX_IMAGE_TILE);
+    if (!ring || !ring_y || !acc) { free(ring); free(ring_y); free(acc); return; }
+    for (int k = 0; k < job->kh; k++) ring_y[k] = -1;
+
+    for (int y = y0; y < y1; y++) {
+        const float* rows[64];      /* kh <= 64 */
+        for (int k = 0; k < job->kh; k++) {
+            int sy = clamp_index(y + k - job->cy, 0, src->height - 1);
+            int slot = (y + k) % job->kh;
+            float* row = ring + row_len * (size_t)slot;
+            if (ring_y[slot] != y + k) {
+                row_to_f32(row + pad, image_row(src, sy), n);
+                row_pad_f32(row, n, c, pad);
+                ring_y[slot] = y + k;
+            }
+            rows[k] = row + pad - pad_l;
+        }
+
+        uint8_t* dst = image_row(job->dst, y);
+        for (int x0 = 0; x0 < n; x0 += RX_IMAGE_TILE) {
+            int len = n - x0 < RX_IMAGE_TILE ? n - x0 : RX_IMAGE_TILE;
+            memset(acc, 0, sizeof(float) * (size_t)len);
+            for (int ky = 0; ky < job->kh; ky++) {
+                const float* taps = job->values + ky * job->kw;
+                for (int kx = 0; kx < job->kw; kx++) {
+                    if (taps[kx] != 0.0f) row_madd_f32(acc, rows[ky] + x0 + kx * c, taps[kx], len);
+                }
+            }
+            row_store_u8(dst + x0, acc, job->bias, len);
+        }
+        if (c == 4) row_copy_alpha(dst, image_row(src, y), src->width);
+    }
+    free(ring);
+    free(ring_y);
+    free(acc);
+}
+
+bool rx_image_convolve_into(rx_image* dst, rx_image* src, rx_kernel* kernel) {
+    int c = filter_channels(src);
+    if (!c || !same_shape(dst, src) || !kernel || !kernel->values) return false;
+
+    int kw = kernel->width, kh = kernel->height;
+    float scale = kernel->divisor != 0.0f ? 1.0f / kernel->divisor : 1.0f;
+    float bias = kernel->offset + 0.5f;
+
+    float* taps = (float*)malloc(sizeof(float) * (size_t)(kw * kh + kw + kh));
+    if (!taps) return false;
+    float* u = taps + kw * kh;
+    float* v = u + kh;
+
+    rx_image* in = filter_source(dst, src);
+    if (!in) { free(taps); return false; }
+
+    if (kernel_separate(kernel, u, v)) {
+        for (int y = 0; y < kh; y++) u[y] *= scale;
+        separable_job job = { in, dst, c, v, u, kw, kh, kw / 2, kh / 2, bias, c == 4 };
+        run_separable(&job);
+    } else if (kh <= 64) {
+        for (int i = 0; i < kw * kh; i++) taps[i] = kernel->values[i] * scale;
+        convolve_job job = { in, dst, c, taps, kw, kh, kw / 2, kh / 2, bias };
+        image_parallel(src->height, (size_t)src->width * (size_t)src->height, convolve_band, &job);
+    } else {
+        filter_done(dst, src, in);
+        free(taps);
+        return false;
+    }
+    filter_done(dst, src, in);
+    free(taps);
+    return true;
+}
+
+rx_image* rx_image_convolve(rx_image* img, rx_kernel* kernel) {
+    if (!filter_channels(img)) return NULL;
+    rx_image* out = image_like(img);
+    if (out && !rx_image_convolve_into(out, img, kernel)) {
+        rx_image_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+rx_image* rx_image_sharpen(rx_image* img, float amount) {
+    rx_kernel* k = rx_kernel_create(3, 3);
+    if (!k) return NULL;
+    float v[9] = { 0, -amount, 0, -amount, 1 + 4 * amount, -amount, 0, -amount, 0 };
+    memcpy(k->values, v, sizeof(v));
+    rx_image* out = rx_image_convolve(img, k);
+    rx_kernel_destroy(k);
+    return out;
+}
+
+rx_image* rx_image_edge_detect(rx_image* img) {
+    rx_kernel* k = rx_kernel_edge_detect();
+    rx_image* out = rx_image_convolve(img, k);
+    rx_kernel_destroy(k);
+    return out;
+}
+
+/* ============================================================================
+ * Color Matrix Kernel
+ * ============================================================================ */
+
+typedef struct matrix_job {
+    const rx_image* src;
+    rx_image* dst;
+    int channels;
+    float m[20];                /* Offsets pre-scaled to 0-255 */
+} matrix_job;
+
+/*
+ * De-interleave a tile into channel planes, run the 4x5 matrix as plain
+ * vector loops over the planes, then saturate and interleave back.
+ */
+static void matrix_band(void* ctx, int y0, int y1) {
+    const matrix_job* job = (const matrix_job*)ctx;
+    const float* m = job->m;
+    int c = job->channels;
+    int width = job->src->width;
+    enum { T = RX_IMAGE_TILE / 4 };
+    float in[4][T], out[4][T];
+
+    for (int y = y0; y < y1; y++) {
+        const uint8_t* s = image_row(job->src, y);
+        uint8_t* d = image_row(job->dst, y);
+        for (int x0 = 0; x0 < width; x0 += T) {
+            int len = width - x0 < T ? width - x0 : T;
+            const uint8_t* sp = s + x0 * c;
+            if (c == 4) {
+                for (int i = 0; i < len; i++) {
+                    in[0][i] = sp[i * 4]; in[1][i] = sp[i * 4 + 1];
+                    in[2][i] = sp[i * 4 + 2]; in[3][i] = sp[i * 4 + 3];
+                }
+            } else {
+                for (int i = 0; i < len; i++) {
+                    in[0][i] = sp[i * 3]; in[1][i] = sp[i * 3 + 1];
+                    in[2][i] = sp[i * 3 + 2]; in[3][i] = 255.0f;
+                }
+            }
+            for (int ch = 0; ch < c; ch++) {
+                const float* row = m + ch * 5;
+                float* o = out[ch];
+                for (int i = 0; i < len; i++) {
+                    o[i] = row[0] * in[0][i] + row[1] * in[1][i] + row[2] * in[2][i] +
+                           row[3] * in[3][i] + row[4];
+                }
+                for (int i = 0; i < len; i++) {
+                    float v = o[i] > 0.0f ? o[i] : 0.0f;
+                    o[i] = v < 255.0f ? v : 255.0f;
+                }
+            }
+            uint8_t* dp = d + x0 * c;
+            if (c == 4) {
+                for (int i = 0; i < len; i++) {
+                    dp[i * 4] = (uint8_t)(out[0][i] + 0.5f); dp[i * 4 + 1] = (uint8_t)(out[1][i] + 0.5f);
+                    dp[i * 4 + 2] = (uint8_t)(out[2][i] + 0.5f); dp[i * 4 + 3] = (uint8_t)(out[3][i] + 0.5f);
+                }
+            } else {
+                for (int i = 0; i < len; i++) {
+                    dp[i * 3] = (uint8_t)(out[0][i] + 0.5f); dp[i * 3 + 1] = (uint8_t)(out[1][i] + 0.5f);
+                    dp[i * 3 + 2] = (uint8_t)(out[2][i] + 0.5f);
+                }
+            }
+        }
+    }
+}
+
+bool rx_image_color_matrix_into(rx_image* dst, rx_image* src, const float matrix[20]) {
+    int c = filter_channels(src);
+    if (c < 3 || !same_shape(dst, src) || !matrix) return false;
+
+    /* Point-wise: in place works without a copy */
+    matrix_job job = { src, dst, c, { 0 } };
+    memcpy(job.m, matrix, sizeof(job.m));
+    for (int ch = 0; ch < 4; ch++) job.m[ch * 5 + 4] *= 255.0f;
+    image_parallel(src->height, (size_t)src->width * (size_t)src->height, matrix_band, &job);
+    dst->texture_dirty = true;
+    return true;
+}
+
+rx_image* rx_image_color_matrix(rx_image* img, float matrix[20]) {
+    if (filter_channels(img) < 3) return NULL;
+    rx_image* out = image_like(img);
+    if (out && !rx_image_color_matrix_into(out, img, matrix)) {
+        rx_image_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+/* ============================================================================
+ * Color Matrices
+ * ============================================================================ */
+
+/* Rec. 709 luma, as rx_color_grayscale */
+#define LUMA_R 0.2126f
+#define LUMA_G 0.7152f
+#define LUMA_B 0.0722f
+
+void rx_color_matrix_identity(float m[20]) {
+    memset(m, 0, sizeof(float) * 20);
+    m[0] = m[6] = m[12] = m[18] = 1.0f;
+}
+
+void rx_color_matrix_concat(float out[20], const float first[20], const float then[20]) {
+    float c[20];
+    for (int r = 0; r < 4; r++) {
+        for (int k = 0; k < 5; k++) {
+            float v = k == 4 ? then[r * 5 + 4] : 0.0f;
+            for (int j = 0; j < 4; j++) v += then[r * 5 + j] * first[j * 5 + k];
+            c[r * 5 + k] = v;
+        }
+    }
+    memcpy(out, c, sizeof(c));
+}
+
+void rx_color_matrix_brightness(float m[20], float amount) {
+    rx_color_matrix_identity(m);
+    m[4] = m[9] = m[14] = amount;
+}
+
+void rx_color_matrix_contrast(float m[20], float amount) {
+    /* Same curve as rx_color_adjust_contrast, pivoting on mid-gray */
+    float f = (259.0f * (amount * 255.0f + 255.0f)) / (255.0f * (259.0f - amount * 255.0f));
+    rx_color_matrix_identity(m);
+    m[0] = m[6] = m[12] = f;
+    m[4] = m[9] = m[14] = (128.0f / 255.0f) * (1.0f - f);
+}
+
+void rx_color_matrix_saturation(float m[20], float amount) {
+    /* amount as rx_color_saturate: 0 keeps, -1 grays out */
+    float s = 1.0f + amount;
+    float l[3] = { LUMA_R * (1 - s), LUMA_G * (1 - s), LUMA_B * (1 - s) };
+    rx_color_matrix_identity(m);
+    for (int ch = 0; ch < 3; ch++) {
+        for (int k = 0; k < 3; k++) m[ch * 5 + k] = l[k] + (ch == k ? s : 0.0f);
+    }
+}
+
+void rx_color_matrix_sepia(float m[20], float amount) {
+    static const float sepia[9] = {
+        0.393f, 0.769f, 0.189f,
+        0.349f, 0.686f, 0.168f,
+        0.272f, 0.534f, 0.131f,
+    };
+    float t = amount < 0 ? 0 : (amount > 1 ? 1 : amount);
+    rx_color_matrix_identity(m);
+    for (int ch = 0; ch < 3; ch++) {
+        for (int k = 0; k < 3; k++) {
+            m[ch * 5 + k] = (ch == k ? 1.0f - t : 0.0f) + t * sepia[ch * 3 + k];
+        }
+    }
+}
+
+void rx_color_matrix_invert(float m[20]) {
+    rx_color_matrix_identity(m);
+    m[0] = m[6] = m[12] = -1.0f;
+    m[4] = m[9] = m[14] = 1.0f;
+}
+
+void rx_color_matrix_tint(float m[20], rx_color color, float amount) {
+    float t = amount < 0 ? 0 : (amount > 1 ? 1 : amount);
+    rx_color_matrix_identity(m);
+    m[0] = m[6] = m[12] = 1.0f - t;
+    m[4] = t * color.r / 255.0f;
+    m[9] = t * color.g / 255.0f;
+    m[14] = t * color.b / 255.0f;
+}
+
+void rx_color_matrix_hue_rotate(float m[20], float degrees) {
+    /* Luma-preserving rotation (SVG feColorMatrix hueRotate) */
+    float a = degrees * (float)M_PI / 180.0f;
+    float cs = cosf(a), sn = sinf(a);
+    rx_color_matrix_identity(m);
+    m[0] = 0.213f + cs * 0.787f - sn * 0.213f;
+    m[1] = 0.715f - cs * 0.715f - sn * 0.715f;
+    m[2] = 0.072f - cs * 0.072f + sn * 0.928f;
+    m[5] = 0.213f - cs * 0.213f + sn * 0.143f;
+    m[6] = 0.715f + cs * 0.285f + sn * 0.140f;
+    m[7] = 0.072f - cs * 0.072f - sn * 0.283f;
+    m[10] = 0.213f - cs * 0.213f - sn * 0.787f;
+    m[11] = 0.715f - cs * 0.715f + sn * 0.715f;
+    m[12] = 0.072f + cs * 0.928f + sn * 0.072f;
+}
+
+rx_image* rx_image_brightness(rx_image* img, float amount) {
+    float m[20];
+    rx_color_matrix_brightness(m, amount);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_contrast(rx_image* img, float amount) {
+    float m[20];
+    rx_color_matrix_contrast(m, amount);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_saturation(rx_image* img, float amount) {
+    float m[20];
+    rx_color_matrix_saturation(m, amount);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_grayscale(rx_image* img) {
+    return rx_image_saturation(img, -1.0f);
+}
+
+rx_image* rx_image_sepia(rx_image* img, float amount) {
+    float m[20];
+    rx_color_matrix_sepia(m, amount);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_invert(rx_image* img) {
+    float m[20];
+    rx_color_matrix_invert(m);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_tint(rx_image* img, rx_color color, float amount) {
+    float m[20];
+    rx_color_matrix_tint(m, color, amount);
+    return rx_image_color_matrix(img, m);
+}
+
+rx_image* rx_image_hue_rotate(rx_image* img, float degrees) {
+    float m[20];
+    rx_color_matrix_hue_rotate(m, degrees);
+    return rx_image_color_matrix(img, m);
+}
+
+/* ============================================================================
+ * Compositing
+ * ============================================================================ */
+
+/*
+ * Source-over with a blend mode, both images RGBA8 with straight alpha:
+ * each clipped row goes through rx_blend_span_straight.
+ */
+void rx_image_blend(rx_image* dst, rx_image* src, int x, int y, rx_blend_mode mode, float opacity) {
+    if (!dst || !src || dst->format != RX_IMAGE_RGBA8 || src->format != RX_IMAGE_RGBA8) return;
+    if (!dst->data || !src->data || !(opacity > 0.0f)) return;
+
+    int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int x1 = x + src->width < dst->width ? x + src->width : dst->width;
+    int y1 = y + src->height < dst->height ? y + src->height : dst->height;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int row = y0; row < y1; row++) {
+        rx_color* d = (rx_color*)image_row(dst, row) + x0;
+        const rx_color* s = (const rx_color*)image_row(src, row - y) + (x0 - x);
+        rx_blend_span_straight(d, s, (size_t)(x1 - x0), mode, opacity);
+    }
+    dst->texture_dirty = true;
+}
+
+rx_image* rx_image_composite(rx_image* base, rx_image* overlay, rx_blend_mode mode) {
+    rx_image* out = rx_image_copy(base);
+    if (out) rx_image_blend(out, overlay, 0, 0, mode, 1.0f);
+    return out;
+}
+
+/* ============================================================================
+ * Filter Graph
+ * ============================================================================ */
+
+typedef struct image_rect {
+    int x, y, w, h;
+} image_rect;
+
+static image_rect rect_expand_clip(image_rect r, int mx, int my, int width, int height) {
+    int x0 = clamp_index(r.x - mx, 0, width), y0 = clamp_index(r.y - my, 0, height);
+    int x1 = clamp_index(r.x + r.w + mx, 0, width), y1 = clamp_index(r.y + r.h + my, 0, height);
+    return (image_rect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/* Sub-image sharing img's pixels */
+static rx_image image_view(const rx_image* img, int x, int y, int w, int h) {
+    rx_image view = *img;
+    view.data = image_row(img, y) + x * format_bytes(img->format);
+    view.width = w;
+    view.height = h;
+    view.owns_data = false;
+    return view;
+}
+
+rx_filter_graph* rx_filter_graph_create(rx_image* source) {
+    rx_filter_graph* graph = (rx_filter_graph*)calloc(1, sizeof(rx_filter_graph));
+    if (graph) graph->source = source;
+    return graph;
+}
+
+void rx_filter_graph_clear(rx_filter_graph* graph) {
+    if (!graph) return;
+    for (size_t i = 0; i < graph->op_count; i++) rx_kernel_destroy(graph->ops[i].kernel);
+    graph->op_count = 0;
+}
+
+void rx_filter_graph_destroy(rx_filter_graph* graph) {
+    if (!graph) return;
+    rx_filter_graph_clear(graph);
+    free(graph->ops);
+    free(graph);
+}
+
+void rx_filter_graph_set_source(rx_filter_graph* graph, rx_image* source) {
+    if (graph) graph->source = source;
+}
+
+static rx_filter_op* graph_append(rx_filter_graph* graph, rx_filter_op_type type) {
+    if (!graph) return NULL;
+    if (graph->op_count == graph->op_capacity) {
+        size_t cap = graph->op_capacity ? graph->op_capacity * 2 : 8;
+        rx_filter_op* ops = (rx_filter_op*)realloc(graph->ops, sizeof(rx_filter_op) * cap);
+        if (!ops) return NULL;
+        graph->ops = ops;
+        graph->op_capacity = cap;
+    }
+    rx_filter_op* op = &graph->ops[graph->op_count++];
+    memset(op, 0, sizeof(*op));
+    op->type = type;
+    return op;
+}
+
+bool rx_filter_graph_color_matrix(rx_filter_graph* graph, const float matrix[20]) {
+    if (!graph || !matrix) return false;
+
+    /* Fuse into the previous color op */
+    if (graph->op_count > 0 && graph->ops[graph->op_count - 1].type == RX_FILTER_OP_COLOR_MATRIX) {
+        float* m = graph->ops[graph->op_count - 1].matrix;
+        rx_color_matrix_concat(m, m, matrix);
+        return true;
+    }
+    rx_filter_op* op = graph_append(graph, RX_FILTER_OP_COLOR_MATRIX);
+    if (!op) return false;
+    memcpy(op->matrix, matrix, sizeof(op->matrix));
+    return true;
+}
+
+bool rx_filter_graph_brightness(rx_filter_graph* graph, float amount) {
+    float m[20];
+    rx_color_matrix_brightness(m, amount);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_contrast(rx_filter_graph* graph, float amount) {
+    float m[20];
+    rx_color_matrix_contrast(m, amount);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_saturation(rx_filter_graph* graph, float amount) {
+    float m[20];
+    rx_color_matrix_saturation(m, amount);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_hue_rotate(rx_filter_graph* graph, float degrees) {
+    float m[20];
+    rx_color_matrix_hue_rotate(m, degrees);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_grayscale(rx_filter_graph* graph) {
+    return rx_filter_graph_saturation(graph, -1.0f);
+}
+
+bool rx_filter_graph_sepia(rx_filter_graph* graph, float amount) {
+    float m[20];
+    rx_color_matrix_sepia(m, amount);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_invert(rx_filter_graph* graph) {
+    float m[20];
+    rx_color_matrix_invert(m);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_tint(rx_filter_graph* graph, rx_color color, float amount) {
+    float m[20];
+    rx_color_matrix_tint(m, color, amount);
+    return rx_filter_graph_color_matrix(graph, m);
+}
+
+bool rx_filter_graph_gaussian_blur(rx_filter_graph* graph, float sigma) {
+    if (!(sigma > 0.0f)) return graph != NULL;
+    rx_filter_op* op = graph_append(graph, RX_FILTER_OP_GAUSSIAN_BLUR);
+    if (!op) return false;
+    op->sigma = sigma;
+    return true;
+}
+
+bool rx_filter_graph_box_blur(rx_filter_graph* graph, int radius) {
+    if (radius <= 0) return graph != NULL;
+    rx_filter_op* op = graph_append(graph, RX_FILTER_OP_BOX_BLUR);
+    if (!op) return false;
+    op->radius = radius > RX_IMAGE_BOX_MAX_RADIUS ? RX_IMAGE_BOX_MAX_RADIUS : radius;
+    return true;
+}
+
+bool rx_filter_graph_convolve(rx_filter_graph* graph, rx_kernel* kernel) {
+    if (!graph || !kernel || !kernel->values) return false;
+    rx_kernel* copy = rx_kernel_create(kernel->width, kernel->height);
+    if (!copy) return false;
+    memcpy(copy->values, kernel->values, sizeof(float) * (size_t)(kernel->width * kernel->height));
+    copy->divisor = kernel->divisor;
+    copy->offset = kernel->offset;
+
+    rx_filter_op* op = graph_append(graph, RX_FILTER_OP_CONVOLVE);
+    if (!op) {
+        rx_kernel_destroy(copy);
+        return false;
+    }
+    op->kernel = copy;
+    return true;
+}
+
+/* Pixels an op reads beyond each output pixel */
+static void op_margin(const rx_filter_op* op, int* mx, int* my) {
+    *mx = *my = 0;
+    switch (op->type) {
+        case RX_FILTER_OP_GAUSSIAN_BLUR:
+            if (op->sigma > RX_IMAGE_GAUSS_BOX_SIGMA) {
+                int radii[3];
+                gauss_boxes(op->sigma, radii);
+                *mx = *my = radii[0] + radii[1] + radii[2];
+            } else {
+                *mx = *my = (int)ceilf(3.0f * op->sigma);
+            }
+            break;
+        case RX_FILTER_OP_BOX_BLUR:
+            *mx = *my = op->radius;
+            break;
+        case RX_FILTER_OP_CONVOLVE: {
+            int kw = op->kernel->width, kh = op->kernel->height;
+            *mx = kw / 2 > kw - 1 - kw / 2 ? kw / 2 : kw - 1 - kw / 2;
+            *my = kh / 2 > kh - 1 - kh / 2 ? kh / 2 : kh - 1 - kh / 2;
+            break;
+        }
+        case RX_FILTER_OP_COLOR_MATRIX:
+            break;
+    }
+}
+
+static bool op_apply(const rx_filter_op* op, rx_image* dst, rx_image* src) {
+    switch (op->type) {
+        case RX_FILTER_OP_COLOR_MATRIX: return rx_image_color_matrix_into(dst, src, op->matrix);
+        case RX_FILTER_OP_GAUSSIAN_BLUR: return rx_image_gaussian_blur_into(dst, src, op->sigma);
+        case RX_FILTER_OP_BOX_BLUR: return rx_image_box_blur_into(dst, src, op->radius);
+        case RX_FILTER_OP_CONVOLVE: return rx_image_convolve_into(dst, src, op->kernel);
+    }
+    return false;
+}
+
+static bool image_copy_rows(rx_image* dst, const rx_image* src) {
+    size_t bytes = (size_t)src->width * (size_t)format_bytes(src->format);
+    for (int y = 0; y < src->height; y++) memcpy(image_row(dst, y), image_row(src, y), bytes);
+    return true;
+}
+
+/*
+ * Walk the ops backwards to find the area each one has to produce, then
+ * run them forwards over just those areas. Each op's output is the input
+ * area of the next; buffers are sized for the first (largest) area and
+ * ping-ponged, and color ops run in place. Image edges still clamp like
+ * the whole-image filters because areas only stop early at the edges.
+ */
+bool rx_filter_graph_render_region(rx_filter_graph* graph, rx_rect region, rx_image* dst) {
+    if (!graph || !graph->source || !dst) return false;
+    rx_image* src = graph->source;
+    int c = filter_channels(src);
+    if (!c || dst->format != src->format || !dst->data) return false;
+
+    image_rect out = { (int)floorf(region.x), (int)floorf(region.y), 0, 0 };
+    out.w = (int)ceilf(region.x + region.width) - out.x;
+    out.h = (int)ceilf(region.y + region.height) - out.y;
+    out = rect_expand_clip(out, 0, 0, src->width, src->height);
+    if (out.w <= 0 || out.h <= 0 || dst->width < out.w || dst->height < out.h) return false;
+
+    size_t n = graph->op_count;
+    rx_image target = image_view(dst, 0, 0, out.w, out.h);
+    rx_image whole = image_view(src, out.x, out.y, out.w, out.h);
+    if (n == 0) return image_copy_rows(&target, &whole);
+
+    image_rect* need = (image_rect*)malloc(sizeof(image_rect) * (n + 1));
+    if (!need) return false;
+    need[n] = out;
+    for (size_t i = n; i-- > 0;) {
+        int mx, my;
+        op_margin(&graph->ops[i], &mx, &my);
+        need[i] = rect_expand_clip(need[i + 1], mx, my, src->width, src->height);
+    }
+
+    rx_image* buffers[2] = { NULL, NULL };
+    rx_image cur = image_view(src, need[0].x, need[0].y, need[0].w, need[0].h);
+    image_rect cur_rect = need[0];
+    int cur_buffer = -1;            /* -1: cur is the source */
+    bool ok = true;
+
+    for (size_t i = 0; i < n && ok; i++) {
+        const rx_filter_op* op = &graph->ops[i];
+        image_rect r = need[i];
+        rx_image in = image_view(&cur, r.x - cur_rect.x, r.y - cur_rect.y, r.w, r.h);
+        bool last = i + 1 == n;
+
+        /* A trailing color op has no margin: write straight into dst */
+        if (last && op->type == RX_FILTER_OP_COLOR_MATRIX) {
+            ok = op_apply(op, &target, &in);
+            cur_buffer = -2;
+            break;
+        }
+
+        rx_image out_view;
+        if (op->type == RX_FILTER_OP_COLOR_MATRIX && cur_buffer >= 0) {
+            out_view = in;
+        } else {
+            int next = cur_buffer == 0 ? 1 : 0;
+            if (!buffers[next]) {
+                buffers[next] = rx_image_create(need[0].w, need[0].h, src->format);
+                if (!buffers[next]) { ok = false; break; }
+            }
+            out_view = image_view(buffers[next], 0, 0, r.w, r.h);
+            cur_buffer = next;
+        }
+        ok = op_apply(op, &out_view, &in);
+        cur = out_view;
+        cur_rect = r;
+    }
+
+    if (ok && cur_buffer != -2) {
+        rx_image result = image_view(&cur, out.x - cur_rect.x, out.y - cur_rect.y, out.w, out.h);
+        image_copy_rows(&target, &result);
+    }
+    rx_image_destroy(buffers[0]);
+    rx_image_destroy(buffers[1]);
+    free(need);
+    dst->texture_dirty = true;
+    return ok;
+}
+
+rx_image* rx_filter_graph_render(rx_filter_graph* graph) {
+    if (!graph || !filter_channels(graph->source)) return NULL;
+    rx_image* src = graph->source;
+    rx_image* out = image_like(src);
+    if (out && !rx_filter_graph_render_region(graph, (rx_rect){ 0, 0, (float)src->width, (float)src->height }, out)) {
+        rx_image_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+/* ============================================================================
+ * Image Cache
+ * ============================================================================ */
+
+#define CACHE_INITIAL_SLOTS 64
+
+typedef struct rx_cache_entry {
+    char* key;
+    uint64_t hash;
+    rx_image* image;
+    size_t bytes;
+    uint64_t last_used;         /* cache_clock tick */
+    int pins;
+    bool doomed;                /* Removed while pinned: freed on last release */
+    struct rx_cache_shard* shard;
+    struct rx_cache_entry* prev;    /* Towards most recently used */
+    struct rx_cache_entry* next;
+} rx_cache_entry;
+
+typedef struct rx_cache_shard {
+    pthread_mutex_t lock;
+    rx_cache_entry** slots;     /* Linear probing, power-of-two capacity */
+    size_t capacity;
+    rx_cache_entry* head;       /* Most recently used */
+    rx_cache_entry* tail;
+    _Atomic size_t count;
+    _Atomic size_t bytes;
+} rx_cache_shard;
+
+static _Atomic uint64_t cache_clock = 1;
+
+static uint64_t cache_hash(const char* key) {
+    /* FNV-1a */
+    uint64_t h = 1469598103934665603ULL;
+    for (const char* p = key; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* Low bits pick the shard, the rest the slot */
+static rx_cache_shard* cache_shard(rx_image_cache* cache, uint64_t hash) {
+    return &cache->shards[hash & (RX_IMAGE_CACHE_SHARDS - 1)];
+}
+
+static size_t slot_home(const rx_cache_shard* shard, uint64_t hash) {
+    return (size_t)(hash >> 4) & (shard->capacity - 1);
+}
+
+static size_t image_bytes(const rx_image* img) {
+    return (size_t)img->stride * (size_t)img->height;
+}
+
+static rx_cache_entry* shard_find(rx_cache_shard* shard, const char* key, uint64_t hash) {
+    size_t mask = shard->capacity - 1;
+    for (size_t i = slot_home(shard, hash);; i = (i + 1) & mask) {
+        rx_cache_entry* e = shard->slots[i];
+        if (!e) return NULL;
+        if (e->hash == hash && strcmp(e->key, key) == 0) return e;
+    }
+}
+
+static void slots_place(rx_cache_entry** slots, size_t capacity, rx_cache_entry* e) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)(e->hash >> 4) & mask;
+    while (slots[i]) i = (i + 1) & mask;
+    slots[i] = e;
+}
+
+static bool shard_grow(rx_cache_shard* shard) {
+    size_t capacity = shard->capacity * 2;
+    rx_cache_entry** slots = (rx_cache_entry**)calloc(capacity, sizeof(rx_cache_entry*));
+    if (!slots) return false;
+    for (size_t i = 0; i < shard->capacity; i++) {
+        if (shard->slots[i]) slots_place(slots, capacity, shard->slots[i]);
+    }
+    free(shard->slots);
+    shard->slots = slots;
+    shard->capacity = capacity;
+    return true;
+}
+
+/* Backward-shift deletion keeps probe chains intact without tombstones */
+static void slots_remove(rx_cache_shard* shard, rx_cache_entry* entry) {
+    size_t mask = shard->capacity - 1;
+    size_t i = slot_home(shard, entry->hash);
+    while (shard->slots[i] != entry) i = (i + 1) & mask;
+
+    for (size_t j = (i + 1) & mask; shard->slots[j]; j = (j + 1) & mask) {
+        size_t home = slot_home(shard, shard->slots[j]->hash);
+        /* Move j into the hole unless its home lies in (i, j] */
+        bool stays = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays) {
+            shard->slots[i] = shard->slots[j];
+            i = j;
+        }
+    }
+    shard->slots[i] = NULL;
+}
+
+static void lru_unlink(rx_cache_shard* shard, rx_cache_entry* e) {
+    if (e->prev) e->prev->next = e->next;
+    else shard->head = e->next;
+    if (e->next) e->next->prev = e->prev;
+    else shard->tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void lru_push_front(rx_cache_shard* shard, rx_cache_entry* e) {
+    e->prev = NULL;
+    e->next = shard->head;
+    if (shard->head) shard->head->prev = e;
+    shard->head = e;
+    if (!shard->tail) shard->tail = e;
+}
+
+static void entry_touch(rx_cache_shard* shard, rx_cache_entry* e) {
+    e->last_used = atomic_fetch_add_explicit(&cache_clock, 1, memory_order_relaxed);
+    if (shard->head != e) {
+        lru_unlink(shard, e);
+        lru_push_front(shard, e);
+    }
+}
+
+static void entry_free(rx_cache_entry* e) {
+    if (e->image) {
+        e->image->cache_entry = NULL;
+        rx_image_destroy(e->image);
+    }
+    free(e->key);
+    free(e);
+}
+
+/*
+ * Take the entry out of the shard (lock held). Returns the entry if the
+ * caller should free it once the lock is dropped, NULL if it is pinned and
+ * the last release frees it.
+ */
+static rx_cache_entry* shard_detach(rx_cache_shard* shard, rx_cache_entry* e) {
+    slots_remove(shard, e);
+    lru_unlink(shard, e);
+    atomic_fetch_sub_explicit(&shard->count, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&shard->bytes, e->bytes, memory_order_relaxed);
+    if (e->pins > 0) {
+        e->doomed = true;
+        return NULL;
+    }
+    return e;
+}
+
+/* Least recently used entry that may be evicted (lock held) */
+static rx_cache_entry* shard_victim(rx_cache_shard* shard) {
+    rx_cache_entry* e = shard->tail;
+    while (e && e->pins > 0) e = e->prev;
+    return e;
+}
+
+size_t rx_image_cache_bytes(rx_image_cache* cache) {
+    if (!cache) return 0;
+    size_t total = 0;
+    for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+        total += atomic_load_explicit(&cache->shards[i].bytes, memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t rx_image_cache_count(rx_image_cache* cache) {
+    if (!cache) return 0;
+    size_t total = 0;
+    for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+        total += atomic_load_explicit(&cache->shards[i].count, memory_order_relaxed);
+    }
+    return total;
+}
+
+/* Evict the globally least recently used unpinned entries until both limits hold */
+static void cache_evict(rx_image_cache* cache, size_t max_bytes, size_t max_entries) {
+    pthread_mutex_lock(&cache->evict_lock);
+    while (rx_image_cache_bytes(cache) > max_bytes ||
+           (max_entries && rx_image_cache_count(cache) > max_entries)) {
+        /* Oldest tail across shards; the tick may move on before we lock
+         * the shard again, which only makes the choice slightly stale */
+        rx_cache_shard* oldest = NULL;
+        uint64_t oldest_tick = UINT64_MAX;
+        for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+            rx_cache_shard* shard = &cache->shards[i];
+            pthread_mutex_lock(&shard->lock);
+            rx_cache_entry* v = shard_victim(shard);
+            if (v && v->last_used < oldest_tick) {
+                oldest_tick = v->last_used;
+                oldest = shard;
+            }
+            pthread_mutex_unlock(&shard->lock);
+        }
+        if (!oldest) break;     /* Everything left is pinned */
+
+        pthread_mutex_lock(&oldest->lock);
+        rx_cache_entry* v = shard_victim(oldest);
+        rx_cache_entry* dead = v ? shard_detach(oldest, v) : NULL;
+        pthread_mutex_unlock(&oldest->lock);
+        if (dead) entry_free(dead);
+    }
+    pthread_mutex_unlock(&cache->evict_lock);
+}
+
+/* Drop every unpinned entry shard by shard; pinned ones are detached */
+static void cache_drop_all(rx_image_cache* cache, bool pinned_too) {
+    for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+        rx_cache_shard* shard = &cache->shards[i];
+        rx_cache_entry* dead = NULL;
+
+        pthread_mutex_lock(&shard->lock);
+        for (rx_cache_entry* e = shard->head; e;) {
+            rx_cache_entry* next = e->next;
+            if (pinned_too || e->pins == 0) {
+                rx_cache_entry* d = shard_detach(shard, e);
+                if (d) {
+                    d->next = dead;
+                    dead = d;
+                }
+            }
+            e = next;
+        }
+        pthread_mutex_unlock(&shard->lock);
+
+        while (dead) {
+            rx_cache_entry* next = dead->next;
+            entry_free(dead);
+            dead = next;
+        }
+    }
+}
+
+rx_image_cache* rx_image_cache_create(size_t max_bytes) {
+    rx_image_cache* cache = (rx_image_cache*)calloc(1, sizeof(rx_image_cache));
+    if (!cache) return NULL;
+    cache->shards = (rx_cache_shard*)calloc(RX_IMAGE_CACHE_SHARDS, sizeof(rx_cache_shard));
+    if (!cache->shards) {
+        free(cache);
+        return NULL;
+    }
+    for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+        rx_cache_shard* shard = &cache->shards[i];
+        shard->capacity = CACHE_INITIAL_SLOTS;
+        shard->slots = (rx_cache_entry**)calloc(shard->capacity, sizeof(rx_cache_entry*));
+        if (!shard->slots) {
+            for (int j = 0; j < i; j++) free(cache->shards[j].slots);
+            free(cache->shards);
+            free(cache);
+            return NULL;
+        }
+        pthread_mutex_init(&shard->lock, NULL);
+    }
+    pthread_mutex_init(&cache->evict_lock, NULL);
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+static rx_image* cache_lookup(rx_image_cache* cache, const char* key, bool pin) {
+    if (!cache || !key) return NULL;
+    uint64_t hash = cache_hash(key);
+    rx_cache_shard* shard = cache_shard(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    rx_cache_entry* e = shard_find(shard, key, hash);
+    rx_image* img = NULL;
+    if (e) {
+        entry_touch(shard, e);
+        if (pin) e->pins++;
+        img = e->image;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return img;
+}
+
+rx_image* rx_image_cache_get(rx_image_cache* cache, const char* key) {
+    return cache_lookup(cache, key, false);
+}
+
+rx_image* rx_image_cache_acquire(rx_image_cache* cache, const char* key) {
+    return cache_lookup(cache, key, true);
+}
+
+void rx_image_cache_release(rx_image* img) {
+    if (!img || !img->cache_entry) return;
+    rx_cache_entry* e = img->cache_entry;
+    rx_cache_shard* shard = e->shard;
+
+    pthread_mutex_lock(&shard->lock);
+    bool dead = --e->pins == 0 && e->doomed;
+    pthread_mutex_unlock(&shard->lock);
+    if (dead) entry_free(e);
+}
+
+void rx_image_cache_retain(rx_image* img) {
+    if (!img || !img->cache_entry) return;
+    rx_cache_entry* e = img->cache_entry;
+    pthread_mutex_lock(&e->shard->lock);
+    e->pins++;
+    pthread_mutex_unlock(&e->shard->lock);
+}
+
+void rx_image_cache_put(rx_image_cache* cache, const char* key, rx_image* img) {
+    if (!cache || !key || !img || img->cache_entry) return;
+
+    rx_cache_entry* e = (rx_cache_entry*)calloc(1, sizeof(rx_cache_entry));
+    if (!e) return;
+    e->key = strdup(key);
+    if (!e->key) {
+        free(e);
+        return;
+    }
+    e->hash = cache_hash(key);
+    e->image = img;
+    e->bytes = image_bytes(img);
+    e->shard = cache_shard(cache, e->hash);
+    rx_cache_shard* shard = e->shard;
+
+    pthread_mutex_lock(&shard->lock);
+    rx_cache_entry* old = shard_find(shard, key, e->hash);
+    rx_cache_entry* dead = old ? shard_detach(shard, old) : NULL;
+    /* Keep the load factor at or below one half */
+    if ((atomic_load_explicit(&shard->count, memory_order_relaxed) + 1) * 2 > shard->capacity &&
+        !shard_grow(shard)) {
+        pthread_mutex_unlock(&shard->lock);
+        if (dead) entry_free(dead);
+        e->image = NULL;
+        entry_free(e);
+        return;
+    }
+    slots_place(shard->slots, shard->capacity, e);
+    lru_push_front(shard, e);
+    e->last_used = atomic_fetch_add_explicit(&cache_clock, 1, memory_order_relaxed);
+    img->cache_entry = e;
+    atomic_fetch_add_explicit(&shard->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->bytes, e->bytes, memory_order_relaxed);
+    pthread_mutex_unlock(&shard->lock);
+    if (dead) entry_free(dead);
+
+    if (rx_image_cache_bytes(cache) > cache->max_bytes ||
+        (cache->max_entries && rx_image_cache_count(cache) > cache->max_entries)) {
+        cache_evict(cache, cache->max_bytes, cache->max_entries);
+    }
+}
+
+void rx_image_cache_remove(rx_image_cache* cache, const char* key) {
+    if (!cache || !key) return;
+    uint64_t hash = cache_hash(key);
+    rx_cache_shard* shard = cache_shard(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    rx_cache_entry* e = shard_find(shard, key, hash);
+    rx_cache_entry* dead = e ? shard_detach(shard, e) : NULL;
+    pthread_mutex_unlock(&shard->lock);
+    if (dead) entry_free(dead);
+}
+
+void rx_image_cache_clear(rx_image_cache* cache) {
+    if (cache) cache_drop_all(cache, true);
+}
+
+void rx_image_cache_trim(rx_image_cache* cache, size_t target_bytes) {
+    if (!cache) return;
+    if (target_bytes == 0) cache_drop_all(cache, false);
+    else cache_evict(cache, target_bytes, 0);
+}
+
+void rx_image_cache_memory_pressure(rx_image_cache* cache, rx_memory_pressure level) {
+    switch (level) {
+        case RX_MEMORY_PRESSURE_MODERATE:
+            rx_image_cache_trim(cache, cache ? cache->max_bytes / 2 : 0);
+            break;
+        case RX_MEMORY_PRESSURE_CRITICAL:
+            rx_image_cache_trim(cache, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+/* Pinned entries must have been released */
+void rx_image_cache_destroy(rx_image_cache* cache) {
+    if (!cache) return;
+    cache_drop_all(cache, true);
+    for (int i = 0; i < RX_IMAGE_CACHE_SHARDS; i++) {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+        free(cache->shards[i].slots);
+    }
+    pthread_mutex_destroy(&cache->evict_lock);
+    free(cache->shards);
+    free(cache);
+}
+
+static pthread_mutex_t shared_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic(rx_image_cache*) shared_cache = NULL;
+
+rx_image_cache* rx_image_cache_shared(void) {
+    rx_image_cache* cache = atomic_load_explicit(&shared_cache, memory_order_acquire);
+    if (cache) return cache;
+
+    pthread_mutex_lock(&shared_cache_lock);
+    cache = atomic_load_explicit(&shared_cache, memory_order_relaxed);
+    if (!cache) {
+        cache = rx_image_cache_create(RX_IMAGE_CACHE_DEFAULT_BYTES);
+        atomic_store_explicit(&shared_cache, cache, memory_order_release);
+    }
+    pthread_mutex_unlock(&shared_cache_lock);
+    return cache;
+}
+
+void rx_image_memory_pressure(rx_memory_pressure level) {
+    rx_image_cache_memory_pressure(atomic_load_explicit(&shared_cache, memory_order_acquire), level);
+}
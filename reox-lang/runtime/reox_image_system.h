@@ -7,7 +7,7 @@
  * - Real-time filters (blur, sharpen, etc.)
  * - Image transformations
  * - Texture management
- * - Sprite sheets and atlases
+ * - Sprite sheets and atlases, with incremental multi-page packing
  */
 
 #ifndef REOX_IMAGE_SYSTEM_H
@@ -15,6 +15,7 @@
 
 #include "reox_ui.h"
 #include "reox_color_system.h"
+#include <pthread.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +60,9 @@ typedef struct rx_image {
     /* Metadata */
     const char* source_path;
     float dpi;
+
+    /* Entry that owns the image while it is in an rx_image_cache */
+    struct rx_cache_entry* cache_entry;
 } rx_image;
 
 /* ============================================================================
@@ -162,6 +166,7 @@ extern rx_image* rx_image_invert(rx_image* img);
 extern rx_image* rx_image_threshold(rx_image* img, float level);
 extern rx_image* rx_image_tint(rx_image* img, rx_color color, float amount);
 extern rx_image* rx_image_duotone(rx_image* img, rx_color shadow, rx_color highlight);
+/* Row-major 4x5: out = M * (r, g, b, a, 1), channels and offsets in 0-1 */
 extern rx_image* rx_image_color_matrix(rx_image* img, float matrix[20]);
 
 /* ============================================================================
@@ -218,48 +223,229 @@ extern rx_kernel* rx_kernel_emboss(void);
 extern rx_image* rx_image_convolve(rx_image* img, rx_kernel* kernel);
 extern void rx_kernel_destroy(rx_kernel* kernel);
 
+/* ============================================================================
+ * Filter Targets and Threads
+ * ============================================================================ */
+
+/*
+ * Filters work on 8-bit formats (RGBA8, RGB8, GRAY8) and run in row bands
+ * on the filter threads. The _into variants write into a caller-provided
+ * image of the same size and format, which avoids an allocation per frame;
+ * dst may be src. They return false on a size or format mismatch.
+ *
+ * Blurs filter every channel independently, so use premultiplied alpha to
+ * avoid dark fringes around transparent edges. Convolution keeps alpha.
+ */
+extern bool rx_image_gaussian_blur_into(rx_image* dst, rx_image* src, float sigma);
+extern bool rx_image_box_blur_into(rx_image* dst, rx_image* src, int radius);
+extern bool rx_image_convolve_into(rx_image* dst, rx_image* src, rx_kernel* kernel);
+extern bool rx_image_color_matrix_into(rx_image* dst, rx_image* src, const float matrix[20]);
+
+/* 0: one thread per core (default), 1: filters run on the calling thread */
+extern void rx_image_set_threads(int count);
+extern int rx_image_threads(void);
+
+/* ============================================================================
+ * Color Matrices
+ * ============================================================================ */
+
+/* Builders in the rx_image_color_matrix layout; amounts as the rx_image_*
+ * adjustments of the same name */
+extern void rx_color_matrix_identity(float m[20]);
+extern void rx_color_matrix_brightness(float m[20], float amount);
+extern void rx_color_matrix_contrast(float m[20], float amount);
+extern void rx_color_matrix_saturation(float m[20], float amount);
+extern void rx_color_matrix_sepia(float m[20], float amount);
+extern void rx_color_matrix_invert(float m[20]);
+extern void rx_color_matrix_tint(float m[20], rx_color color, float amount);
+extern void rx_color_matrix_hue_rotate(float m[20], float degrees);
+
+/* out = first followed by then; out may alias either input */
+extern void rx_color_matrix_concat(float out[20], const float first[20], const float then[20]);
+
+/* ============================================================================
+ * Filter Graph
+ * ============================================================================ */
+
+/*
+ * A deferred filter chain over a source image. Nothing is computed until a
+ * render call. Adjacent color adjustments are fused into one color matrix
+ * (one pass, no intermediate image), and rendering a region reads only the
+ * source pixels that region depends on, plus blur and kernel margins.
+ *
+ * Fused adjustments skip the 8-bit rounding and clamping between steps, so
+ * a chain can differ slightly from the same rx_image_* calls where an
+ * intermediate step would have saturated.
+ */
+typedef enum rx_filter_op_type {
+    RX_FILTER_OP_COLOR_MATRIX,
+    RX_FILTER_OP_GAUSSIAN_BLUR,
+    RX_FILTER_OP_BOX_BLUR,
+    RX_FILTER_OP_CONVOLVE,
+} rx_filter_op_type;
+
+typedef struct rx_filter_op {
+    rx_filter_op_type type;
+    float matrix[20];         /* COLOR_MATRIX */
+    float sigma;              /* GAUSSIAN_BLUR */
+    int radius;               /* BOX_BLUR */
+    rx_kernel* kernel;        /* CONVOLVE (owned copy) */
+} rx_filter_op;
+
+typedef struct rx_filter_graph {
+    rx_image* source;         /* Not owned */
+    rx_filter_op* ops;
+    size_t op_count;
+    size_t op_capacity;
+} rx_filter_graph;
+
+extern rx_filter_graph* rx_filter_graph_create(rx_image* source);
+extern void rx_filter_graph_destroy(rx_filter_graph* graph);
+extern void rx_filter_graph_set_source(rx_filter_graph* graph, rx_image* source);
+extern void rx_filter_graph_clear(rx_filter_graph* graph);
+
+/* Appending an op returns false if it could not be stored */
+extern bool rx_filter_graph_color_matrix(rx_filter_graph* graph, const float matrix[20]);
+extern bool rx_filter_graph_brightness(rx_filter_graph* graph, float amount);
+extern bool rx_filter_graph_contrast(rx_filter_graph* graph, float amount);
+extern bool rx_filter_graph_saturation(rx_filter_graph* graph, float amount);
+extern bool rx_filter_graph_hue_rotate(rx_filter_graph* graph, float degrees);
+extern bool rx_filter_graph_grayscale(rx_filter_graph* graph);
+extern bool rx_filter_graph_sepia(rx_filter_graph* graph, float amount);
+extern bool rx_filter_graph_invert(rx_filter_graph* graph);
+extern bool rx_filter_graph_tint(rx_filter_graph* graph, rx_color color, float amount);
+extern bool rx_filter_graph_gaussian_blur(rx_filter_graph* graph, float sigma);
+extern bool rx_filter_graph_box_blur(rx_filter_graph* graph, int radius);
+extern bool rx_filter_graph_convolve(rx_filter_graph* graph, rx_kernel* kernel);
+
+/* Whole output as a new image */
+extern rx_image* rx_filter_graph_render(rx_filter_graph* graph);
+
+/*
+ * Output pixels inside region (clipped to the source) into the top-left of
+ * dst, which must have the source format and be at least the clipped
+ * region's size. Returns false if there is nothing to render.
+ */
+extern bool rx_filter_graph_render_region(rx_filter_graph* graph, rx_rect region, rx_image* dst);
+
 /* ============================================================================
  * Image Cache System
  * ============================================================================ */
 
+/*
+ * Keys hash to one of RX_IMAGE_CACHE_SHARDS shards, each with its own lock,
+ * open-addressed index and LRU list, so lookups from several threads do not
+ * contend on one lock. Eviction is by global recency across shards and
+ * counts stride * height bytes per image.
+ */
+#define RX_IMAGE_CACHE_SHARDS 16
+#define RX_IMAGE_CACHE_DEFAULT_BYTES (64u << 20)    /* Budget of the shared cache */
+
+typedef enum rx_memory_pressure {
+    RX_MEMORY_PRESSURE_NORMAL,
+    RX_MEMORY_PRESSURE_MODERATE,    /* Trim to half the budget */
+    RX_MEMORY_PRESSURE_CRITICAL,    /* Drop everything not pinned */
+} rx_memory_pressure;
+
 typedef struct rx_image_cache {
-    struct rx_cache_entry* entries;
-    size_t entry_count;
-    size_t max_entries;
+    struct rx_cache_shard* shards;
+    pthread_mutex_t evict_lock;     /* Serializes cross-shard eviction */
+    size_t max_entries;             /* 0: no entry limit */
     size_t max_bytes;
-    size_t current_bytes;
 } rx_image_cache;
 
 extern rx_image_cache* rx_image_cache_create(size_t max_bytes);
+/* Borrowed; valid until the entry is evicted, replaced or removed */
 extern rx_image* rx_image_cache_get(rx_image_cache* cache, const char* key);
+/* The cache takes ownership of img; an image under the same key is replaced */
 extern void rx_image_cache_put(rx_image_cache* cache, const char* key, rx_image* img);
 extern void rx_image_cache_remove(rx_image_cache* cache, const char* key);
 extern void rx_image_cache_clear(rx_image_cache* cache);
+/* Evict least recently used images until at most target_bytes remain */
 extern void rx_image_cache_trim(rx_image_cache* cache, size_t target_bytes);
 extern void rx_image_cache_destroy(rx_image_cache* cache);
 
+/* Like get, but the image is not evicted or freed until released. Use
+ * from threads that race with puts and trims. */
+extern rx_image* rx_image_cache_acquire(rx_image_cache* cache, const char* key);
+extern void rx_image_cache_release(rx_image* img);
+/* Add a pin to an image that is already pinned */
+extern void rx_image_cache_retain(rx_image* img);
+
+extern size_t rx_image_cache_bytes(rx_image_cache* cache);
+extern size_t rx_image_cache_count(rx_image_cache* cache);
+
+extern void rx_image_cache_memory_pressure(rx_image_cache* cache, rx_memory_pressure level);
+
 /* Global cache */
 extern rx_image_cache* rx_image_cache_shared(void);
 
+/* Memory-pressure hook for the display manager: trims the shared cache */
+extern void rx_image_memory_pressure(rx_memory_pressure level);
+
 /* ============================================================================
  * Texture Atlas / Sprite Sheet
  * ============================================================================ */
 
 typedef struct rx_sprite {
     const char* name;
-    rx_rect frame;            /* Position in atlas */
+    rx_rect frame;            /* Position in atlas, as stored */
     rx_point pivot;           /* Rotation center */
-    bool rotated;             /* 90 degree rotation in atlas */
+    bool rotated;             /* Stored turned 90 degrees clockwise */
+    int page;                 /* Index into the atlas pages */
 } rx_sprite;
 
+#define RX_ATLAS_MAX_PAGES 8
+
+/* Sprites are sorted by name */
 typedef struct rx_texture_atlas {
-    rx_image* texture;
+    rx_image* texture;        /* Page 0 */
     rx_sprite* sprites;
     size_t sprite_count;
+
+    /* Binary atlases: names and texture pixels live in the mapping */
+    void* mapping;
+    size_t mapping_size;
+
+    /* Atlases from rx_atlas_create and rx_atlas_pack can grow */
+    rx_image** pages;
+    int page_count;
+    size_t sprite_capacity;
+    struct rx_atlas_packer* packer;
 } rx_texture_atlas;
 
+/*
+ * Binary atlas (.rxatlas): a header, sprite records sorted by name, the
+ * names, then texture rows on a page boundary in the texture's own format,
+ * ready to upload. rx_atlas_map maps the file and copies nothing; writes to
+ * the texture stay private to the process.
+ */
+#define RX_ATLAS_MAGIC "RXATLAS"
+
+/* TexturePacker JSON, or a binary atlas (texture_path unused) */
 extern rx_texture_atlas* rx_atlas_load(const char* atlas_json, const char* texture_path);
+extern rx_texture_atlas* rx_atlas_map(const char* path);
+/* Offline step: write a single-page atlas, e.g. from rx_atlas_pack, as a binary atlas */
+extern bool rx_atlas_save(rx_texture_atlas* atlas, const char* path);
+/* Skyline packing into the smallest power-of-two square page that fits */
 extern rx_texture_atlas* rx_atlas_pack(rx_image** images, const char** names, size_t count, int max_size);
+
+/*
+ * Incremental atlas: sprites are added and removed at runtime (icons,
+ * decoded thumbnails), opening pages of page_size x page_size as needed up
+ * to max_pages. Removed areas are reused. Sprite pointers are invalidated by
+ * the next add or remove.
+ */
+extern rx_texture_atlas* rx_atlas_create(int page_size, rx_image_format format, int max_pages);
+/* Copies img in under name, replacing a sprite of that name; NULL if full
+ * or the atlas cannot grow (mapped and JSON atlases) */
+extern rx_sprite* rx_atlas_add(rx_texture_atlas* atlas, const char* name, const rx_image* img);
+extern bool rx_atlas_remove(rx_texture_atlas* atlas, const char* name);
+extern rx_image* rx_atlas_page(rx_texture_atlas* atlas, int page);
+/* Area of page written since the last call, for a partial texture upload */
+extern bool rx_atlas_take_dirty(rx_texture_atlas* atlas, int page, rx_rect* out);
+
+/* Binary search by name */
 extern rx_sprite* rx_atlas_get_sprite(rx_texture_atlas* atlas, const char* name);
 extern rx_image* rx_atlas_extract_sprite(rx_texture_atlas* atlas, const char* name);
 extern void rx_atlas_destroy(rx_texture_atlas* atlas);
@@ -0,0 +1,1235 @@
+/*
+ * REOX Lighting - Implementation
+ * Tiled light culling, batched light animation and cached shadow masks
+ */
+
+#include "reox_lighting.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TILE_SIZE 64.0f
+#define MAX_TILES_PER_AXIS 64       /* Wider extents get larger tiles */
+#define SHADOW_CELL 4.0f            /* Mask texel, px */
+#define SHADOW_MAX_TEXELS 256       /* Per axis */
+#define SHADOW_KEY 10
+#define PI_F 3.14159265f
+
+static uint64_t next_light_id = 1;
+
+static bool grow_array(void** array, size_t* capacity, size_t need, size_t elem) {
+    if (need <= *capacity) return true;
+    size_t cap = *capacity ? *capacity : 16;
+    while (cap < need) cap *= 2;
+    void* grown = realloc(*array, cap * elem);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = cap;
+    return true;
+}
+
+static inline float clamp01(float v) {
+    return v < 0 ? 0 : (v > 1 ? 1 : v);
+}
+
+/* Window-space frame: view frames are relative to the parent */
+static rx_rect view_window_frame(const rx_view* view) {
+    rx_rect f = view->box.frame;
+    for (const rx_view* p = view->parent; p; p = p->parent) {
+        f.x += p->box.frame.x;
+        f.y += p->box.frame.y;
+    }
+    return f;
+}
+
+/* ============================================================================
+ * Scene Cache
+ * ============================================================================ */
+
+/* A light's contribution for this frame */
+typedef struct light_term {
+    rx_light_type type;
+    float x, y, z;
+    float r, g, b;              /* Linear color x intensity x animation */
+    float radius, inv_radius;
+    float falloff_start;
+    rx_light_falloff falloff;
+    float dir_x, dir_y;         /* Spot axis, or direction of the rays */
+    float cos_inner, cos_outer;
+    float half_w, half_h;       /* Area light extent */
+} light_term;
+
+/* Items binned by the screen tiles their bounds overlap, CSR layout */
+typedef struct tile_grid {
+    float x, y, tile;
+    int cols, rows;
+    uint32_t* start;            /* cols * rows + 1 */
+    size_t start_capacity;
+    uint32_t* items;
+    size_t item_capacity;
+} tile_grid;
+
+typedef struct shadow_mask {
+    rx_shadow_caster* caster;
+    rx_light* light;
+    uint32_t id;
+    uint32_t epoch;
+    float key[SHADOW_KEY];      /* Geometry it was built for */
+    rx_rect bounds;
+    int width, height;
+    uint8_t* coverage;
+} shadow_mask;
+
+struct rx_lighting_cache {
+    bool valid;                 /* Cleared when lights are added or removed */
+
+    light_term* terms;          /* Point, spot and area lights */
+    rx_light** term_lights;
+    rx_rect* term_bounds;
+    size_t term_count, term_capacity, term_lights_capacity, term_bounds_capacity;
+    light_term* globals;        /* Directional lights */
+    size_t global_count, global_capacity;
+    float ambient_r, ambient_g, ambient_b;
+    float env_r, env_g, env_b;
+
+    /* What the light grid was binned from */
+    rx_light** binned_lights;
+    rx_rect* binned_bounds;
+    size_t binned_count, binned_lights_capacity, binned_bounds_capacity;
+    tile_grid lights;
+
+    shadow_mask* masks;
+    size_t mask_count, mask_capacity;
+    rx_rect* mask_bounds;
+    size_t mask_bounds_capacity;
+    uint32_t mask_epoch, next_mask_id;
+    tile_grid shadows;
+    rx_shadow_driver driver;
+};
+
+static void grid_free(tile_grid* g) {
+    free(g->start);
+    free(g->items);
+}
+
+static void grid_range(const tile_grid* g, rx_rect b, int* c0, int* r0, int* c1, int* r1) {
+    *c0 = (int)((b.x - g->x) / g->tile);
+    *r0 = (int)((b.y - g->y) / g->tile);
+    *c1 = (int)((b.x + b.width - g->x) / g->tile);
+    *r1 = (int)((b.y + b.height - g->y) / g->tile);
+    if (*c0 < 0) *c0 = 0;
+    if (*r0 < 0) *r0 = 0;
+    if (*c1 >= g->cols) *c1 = g->cols - 1;
+    if (*r1 >= g->rows) *r1 = g->rows - 1;
+}
+
+static inline int grid_cell(const tile_grid* g, float x, float y) {
+    if (g->cols == 0) return -1;
+    float fx = (x - g->x) / g->tile, fy = (y - g->y) / g->tile;
+    if (fx < 0 || fy < 0 || fx >= (float)g->cols || fy >= (float)g->rows) return -1;
+    return (int)fy * g->cols + (int)fx;
+}
+
+/* Bin items over the union of their bounds */
+static bool grid_build(tile_grid* g, const rx_rect* bounds, size_t count) {
+    g->cols = g->rows = 0;
+    if (count == 0) return true;
+
+    float x0 = bounds[0].x, y0 = bounds[0].y;
+    float x1 = x0 + bounds[0].width, y1 = y0 + bounds[0].height;
+    for (size_t i = 1; i < count; i++) {
+        x0 = fminf(x0, bounds[i].x);
+        y0 = fminf(y0, bounds[i].y);
+        x1 = fmaxf(x1, bounds[i].x + bounds[i].width);
+        y1 = fmaxf(y1, bounds[i].y + bounds[i].height);
+    }
+    float tile = TILE_SIZE;
+    while ((x1 - x0) / tile >= MAX_TILES_PER_AXIS || (y1 - y0) / tile >= MAX_TILES_PER_AXIS) tile *= 2;
+    int cols = (int)((x1 - x0) / tile) + 1, rows = (int)((y1 - y0) / tile) + 1;
+    size_t cells = (size_t)cols * (size_t)rows;
+    if (!grow_array((void**)&g->start, &g->start_capacity, cells + 1, sizeof(uint32_t))) return false;
+    g->x = x0;
+    g->y = y0;
+    g->tile = tile;
+    g->cols = cols;
+    g->rows = rows;
+
+    /* Count into start[cell + 1], prefix-sum, then fill with start[cell]
+     * as the cursor and shift back */
+    memset(g->start, 0, sizeof(uint32_t) * (cells + 1));
+    int c0, r0, c1, r1;
+    for (size_t i = 0; i < count; i++) {
+        grid_range(g, bounds[i], &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) g->start[r * cols + c + 1]++;
+        }
+    }
+    for (size_t c = 0; c < cells; c++) g->start[c + 1] += g->start[c];
+    if (!grow_array((void**)&g->items, &g->item_capacity, g->start[cells] + 1, sizeof(uint32_t))) {
+        g->cols = g->rows = 0;
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        grid_range(g, bounds[i], &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) g->items[g->start[r * cols + c]++] = (uint32_t)i;
+        }
+    }
+    for (size_t c = cells; c > 0; c--) g->start[c] = g->start[c - 1];
+    g->start[0] = 0;
+    return true;
+}
+
+static struct rx_lighting_cache* scene_cache(rx_lighting_scene* scene) {
+    if (!scene->_cache) scene->_cache = (struct rx_lighting_cache*)calloc(1, sizeof(struct rx_lighting_cache));
+    return scene->_cache;
+}
+
+/* ============================================================================
+ * Light Evaluation
+ * ============================================================================ */
+
+static float falloff(float t, float start, rx_light_falloff mode) {
+    if (t >= 1.0f) return 0;
+    if (mode == RX_FALLOFF_NONE || t <= start || start >= 1.0f) return 1.0f;
+    float u = (t - start) / (1.0f - start);
+    switch (mode) {
+        case RX_FALLOFF_LINEAR:    return 1.0f - u;
+        case RX_FALLOFF_QUADRATIC: return (1.0f - u) * (1.0f - u);
+        case RX_FALLOFF_SMOOTH:    return 1.0f - u * u * (3.0f - 2.0f * u);
+        default:                   return 1.0f;
+    }
+}
+
+/* Smooth value noise in [0, 1] */
+static float flicker_noise(float phase) {
+    float i = floorf(phase), f = phase - i;
+    uint32_t a = (uint32_t)(int32_t)i * 0x9E3779B1u, b = a + 0x9E3779B1u;
+    a ^= a >> 15; a *= 0x85EBCA77u; a ^= a >> 13;
+    b ^= b >> 15; b *= 0x85EBCA77u; b ^= b >> 13;
+    float na = (float)(a & 0xFFFF) / 65535.0f, nb = (float)(b & 0xFFFF) / 65535.0f;
+    f = f * f * (3.0f - 2.0f * f);
+    return na + (nb - na) * f;
+}
+
+static void light_animate(rx_light* light, float dt) {
+    if (!light->animated) {
+        light->_factor = 1.0f;
+        return;
+    }
+    float factor = 1.0f;
+    if (light->flicker_amount > 0) {
+        light->_flicker_phase = fmodf(light->_flicker_phase + dt * light->flicker_speed, 65536.0f);
+        factor *= 1.0f - light->flicker_amount * flicker_noise(light->_flicker_phase);
+    }
+    if (light->pulse_amount > 0) {
+        light->_pulse_phase += dt * light->pulse_speed;
+        light->_pulse_phase -= floorf(light->_pulse_phase);
+        factor *= 1.0f + light->pulse_amount * sinf(2.0f * PI_F * light->_pulse_phase);
+    }
+    light->_factor = factor > 0 ? factor : 0;
+}
+
+static light_term light_term_make(const rx_light* light) {
+    light_term t;
+    memset(&t, 0, sizeof(t));
+    float k = light->intensity * light->_factor;
+    t.type = light->type;
+    t.x = light->position.x;
+    t.y = light->position.y;
+    t.z = light->z_height > 1.0f ? light->z_height : 1.0f;
+    t.r = rx_srgb_to_linear(light->color.r) * k;
+    t.g = rx_srgb_to_linear(light->color.g) * k;
+    t.b = rx_srgb_to_linear(light->color.b) * k;
+    t.radius = light->radius;
+    t.inv_radius = light->radius > 0 ? 1.0f / light->radius : 0;
+    t.falloff = light->falloff;
+    t.falloff_start = light->falloff_start;
+    float len = sqrtf(light->direction.x * light->direction.x + light->direction.y * light->direction.y);
+    t.dir_x = len > 0 ? light->direction.x / len : 0;
+    t.dir_y = len > 0 ? light->direction.y / len : 1.0f;
+    t.cos_inner = cosf(light->inner_angle * PI_F / 180.0f);
+    t.cos_outer = cosf(light->outer_angle * PI_F / 180.0f);
+    t.half_w = light->area_size.width * 0.5f;
+    t.half_h = light->area_size.height * 0.5f;
+    return t;
+}
+
+static rx_rect light_term_bounds(const light_term* t) {
+    float w = t->half_w + t->radius, h = t->half_h + t->radius;
+    return rect(t->x - w, t->y - h, 2 * w, 2 * h);
+}
+
+/* Falloff-weighted brightness at (x, y), for ranking a tile's lights */
+static float light_term_reach(const light_term* t, float x, float y) {
+    float dx = fmaxf(fabsf(t->x - x) - t->half_w, 0), dy = fmaxf(fabsf(t->y - y) - t->half_h, 0);
+    float d = sqrtf(dx * dx + dy * dy);
+    return (0.2126f * t->r + 0.7152f * t->g + 0.0722f * t->b) * falloff(d * t->inv_radius, 0, RX_FALLOFF_LINEAR);
+}
+
+/* Keep the max strongest lights of each tile, compacting in place */
+static void grid_limit_lights(tile_grid* g, const light_term* terms, int max) {
+    uint32_t write = 0;
+    for (int cell = 0; cell < g->cols * g->rows; cell++) {
+        uint32_t begin = g->start[cell], end = g->start[cell + 1];
+        uint32_t n = end - begin;
+        if (n > (uint32_t)max) {
+            float cx = g->x + ((float)(cell % g->cols) + 0.5f) * g->tile;
+            float cy = g->y + ((float)(cell / g->cols) + 0.5f) * g->tile;
+            for (uint32_t k = 0; k < (uint32_t)max; k++) {
+                uint32_t best = begin + k;
+                float best_reach = light_term_reach(&terms[g->items[best]], cx, cy);
+                for (uint32_t j = best + 1; j < end; j++) {
+                    float reach = light_term_reach(&terms[g->items[j]], cx, cy);
+                    if (reach > best_reach) {
+                        best = j;
+                        best_reach = reach;
+                    }
+                }
+                uint32_t tmp = g->items[begin + k];
+                g->items[begin + k] = g->items[best];
+                g->items[best] = tmp;
+            }
+            n = (uint32_t)max;
+        }
+        memmove(&g->items[write], &g->items[begin], sizeof(uint32_t) * n);
+        g->start[cell] = write;
+        write += n;
+    }
+    g->start[g->cols * g->rows] = write;
+}
+
+/*
+ * Once per frame: advance flicker and pulse, follow attached views, and
+ * turn enabled lights into terms. The tile grid is rebinned only when a
+ * light was added, removed, moved or resized.
+ */
+static void scene_prepare(rx_lighting_scene* scene, float dt) {
+    struct rx_lighting_cache* cache = scene_cache(scene);
+    if (!cache) return;
+
+    size_t count = 0;
+    for (rx_light* l = scene->lights; l; l = l->next) count++;
+    if (!grow_array((void**)&cache->terms, &cache->term_capacity, count, sizeof(light_term)) ||
+        !grow_array((void**)&cache->term_lights, &cache->term_lights_capacity, count, sizeof(rx_light*)) ||
+        !grow_array((void**)&cache->term_bounds, &cache->term_bounds_capacity, count, sizeof(rx_rect)) ||
+        !grow_array((void**)&cache->globals, &cache->global_capacity, count, sizeof(light_term))) {
+        return;
+    }
+
+    float ambient = scene->ambient_intensity;
+    cache->ambient_r = rx_srgb_to_linear(scene->ambient_color.r) * ambient;
+    cache->ambient_g = rx_srgb_to_linear(scene->ambient_color.g) * ambient;
+    cache->ambient_b = rx_srgb_to_linear(scene->ambient_color.b) * ambient;
+    float env = scene->environment_intensity;
+    cache->env_r = rx_srgb_to_linear(scene->environment_color.r) * env;
+    cache->env_g = rx_srgb_to_linear(scene->environment_color.g) * env;
+    cache->env_b = rx_srgb_to_linear(scene->environment_color.b) * env;
+    cache->term_count = 0;
+    cache->global_count = 0;
+
+    for (rx_light* l = scene->lights; l; l = l->next) {
+        if (l->_attached) {
+            rx_rect f = view_window_frame(l->_attached);
+            l->position = point(f.x + f.width * 0.5f, f.y + f.height * 0.5f);
+        }
+        light_animate(l, dt);
+        if (!l->enabled) continue;
+
+        light_term t = light_term_make(l);
+        if (l->ambient_strength > 0 || l->type == RX_LIGHT_AMBIENT) {
+            float s = l->type == RX_LIGHT_AMBIENT ? 1.0f : l->ambient_strength;
+            cache->ambient_r += t.r * s;
+            cache->ambient_g += t.g * s;
+            cache->ambient_b += t.b * s;
+        }
+        if (l->type == RX_LIGHT_AMBIENT) continue;
+        if (l->type == RX_LIGHT_DIRECTIONAL) {
+            cache->globals[cache->global_count++] = t;
+            continue;
+        }
+        if (t.radius <= 0) continue;
+        cache->term_lights[cache->term_count] = l;
+        cache->term_bounds[cache->term_count] = light_term_bounds(&t);
+        cache->terms[cache->term_count++] = t;
+    }
+
+    /* Nothing binned yet means NULL arrays: compare only with terms */
+    bool rebin = cache->binned_count != cache->term_count ||
+                 (cache->term_count > 0 &&
+                  (memcmp(cache->binned_lights, cache->term_lights, sizeof(rx_light*) * cache->term_count) != 0 ||
+                   memcmp(cache->binned_bounds, cache->term_bounds, sizeof(rx_rect) * cache->term_count) != 0));
+    if (rebin &&
+        grow_array((void**)&cache->binned_lights, &cache->binned_lights_capacity, cache->term_count,
+                   sizeof(rx_light*)) &&
+        grow_array((void**)&cache->binned_bounds, &cache->binned_bounds_capacity, cache->term_count,
+                   sizeof(rx_rect)) &&
+        grid_build(&cache->lights, cache->term_bounds, cache->term_count)) {
+        if (scene->max_lights_per_pixel > 0) {
+            grid_limit_lights(&cache->lights, cache->terms, scene->max_lights_per_pixel);
+        }
+        if (cache->term_count > 0) {
+            memcpy(cache->binned_lights, cache->term_lights, sizeof(rx_light*) * cache->term_count);
+            memcpy(cache->binned_bounds, cache->term_bounds, sizeof(rx_rect) * cache->term_count);
+        }
+        cache->binned_count = cache->term_count;
+        scene->rebins++;
+    }
+    cache->valid = true;
+}
+
+/* ============================================================================
+ * Light Creation and Control
+ * ============================================================================ */
+
+static rx_light* light_new(rx_light_type type, rx_color color, float intensity) {
+    rx_light* light = (rx_light*)calloc(1, sizeof(rx_light));
+    if (!light) return NULL;
+    light->id = next_light_id++;
+    light->type = type;
+    light->enabled = true;
+    light->z_height = 40.0f;
+    light->direction = point(0, 1);
+    light->color = color;
+    light->intensity = intensity;
+    light->radius = 200.0f;
+    light->falloff = RX_FALLOFF_SMOOTH;
+    light->inner_angle = 30.0f;
+    light->outer_angle = 45.0f;
+    light->shadow_softness = 8.0f;
+    light->shadow_color = (rx_color){ 0, 0, 0, 160 };
+    light->_factor = 1.0f;
+    return light;
+}
+
+rx_light* rx_light_point(rx_point position, rx_color color, float intensity, float radius) {
+    rx_light* light = light_new(RX_LIGHT_POINT, color, intensity);
+    if (!light) return NULL;
+    light->position = position;
+    light->radius = radius;
+    return light;
+}
+
+rx_light* rx_light_directional(rx_point direction, rx_color color, float intensity) {
+    rx_light* light = light_new(RX_LIGHT_DIRECTIONAL, color, intensity);
+    if (!light) return NULL;
+    light->direction = direction;
+    light->radius = 0;
+    return light;
+}
+
+rx_light* rx_light_spot(rx_point position, rx_point direction, rx_color color, float intensity, float angle) {
+    rx_light* light = light_new(RX_LIGHT_SPOT, color, intensity);
+    if (!light) return NULL;
+    light->position = position;
+    light->direction = direction;
+    light->radius = 400.0f;
+    light->outer_angle = angle;
+    light->inner_angle = angle * 0.75f;
+    return light;
+}
+
+rx_light* rx_light_area(rx_point position, rx_size size, rx_color color, float intensity) {
+    rx_light* light = light_new(RX_LIGHT_AREA, color, intensity);
+    if (!light) return NULL;
+    light->position = position;
+    light->area_size = size;
+    light->radius = fmaxf(size.width, size.height);
+    return light;
+}
+
+rx_light* rx_light_ambient(rx_color color, float intensity) {
+    rx_light* light = light_new(RX_LIGHT_AMBIENT, color, intensity);
+    if (!light) return NULL;
+    light->radius = 0;
+    return light;
+}
+
+void rx_light_set_position(rx_light* light, rx_point pos) {
+    if (light) light->position = pos;
+}
+
+void rx_light_set_color(rx_light* light, rx_color color) {
+    if (light) light->color = color;
+}
+
+void rx_light_set_intensity(rx_light* light, float intensity) {
+    if (light) light->intensity = intensity < 0 ? 0 : (intensity > 10.0f ? 10.0f : intensity);
+}
+
+void rx_light_set_radius(rx_light* light, float radius) {
+    if (light) light->radius = radius > 0 ? radius : 0;
+}
+
+void rx_light_enable_shadows(rx_light* light, bool enable, float softness) {
+    if (!light) return;
+    light->cast_shadows = enable;
+    light->shadow_softness = softness > 0 ? softness : 0;
+}
+
+void rx_light_set_flicker(rx_light* light, float amount, float speed) {
+    if (!light) return;
+    light->flicker_amount = clamp01(amount);
+    light->flicker_speed = speed;
+    light->animated = light->flicker_amount > 0 || light->pulse_amount > 0;
+}
+
+void rx_light_set_pulse(rx_light* light, float amount, float speed) {
+    if (!light) return;
+    light->pulse_amount = clamp01(amount);
+    light->pulse_speed = speed;
+    light->animated = light->flicker_amount > 0 || light->pulse_amount > 0;
+}
+
+/* Remove it from its scene first */
+void rx_light_destroy(rx_light* light) {
+    free(light);
+}
+
+/* ============================================================================
+ * Glow Effect System
+ * ============================================================================ */
+
+rx_glow* rx_glow_create(rx_view* view, rx_glow_config config) {
+    rx_glow* glow = (rx_glow*)calloc(1, sizeof(rx_glow));
+    if (!glow) return NULL;
+    glow->target = view;
+    glow->config = config;
+    glow->enabled = true;
+    glow->intensity = config.intensity;
+    return glow;
+}
+
+rx_glow* rx_glow_simple(rx_view* view, rx_color color, float radius) {
+    return rx_glow_create(view, (rx_glow_config){ color, radius, 1.0f, 0.0f, false, true });
+}
+
+void rx_glow_set_color(rx_glow* glow, rx_color color) {
+    if (glow) glow->config.color = color;
+}
+
+void rx_glow_set_radius(rx_glow* glow, float radius) {
+    if (glow) glow->config.radius = radius > 0 ? radius : 0;
+}
+
+void rx_glow_animate(rx_glow* glow, float pulse_speed, float pulse_amount) {
+    if (!glow) return;
+    glow->pulse_speed = pulse_speed;
+    glow->pulse_amount = clamp01(pulse_amount);
+    glow->animated = pulse_amount > 0;
+}
+
+void rx_glow_update(rx_glow* glow, float dt) {
+    if (!glow) return;
+    if (!glow->animated) {
+        glow->intensity = glow->config.intensity;
+        return;
+    }
+    glow->_phase += dt * glow->pulse_speed;
+    glow->_phase -= floorf(glow->_phase);
+    glow->intensity = glow->config.intensity * (1.0f + glow->pulse_amount * sinf(2.0f * PI_F * glow->_phase));
+}
+
+void rx_glow_render(const rx_glow* glow, rx_glow_draw_fn draw, void* ctx) {
+    if (!glow || !glow->enabled || !glow->target || glow->config.inner_glow || !draw) return;
+    const rx_corner_radii* cr = &glow->target->box.corner_radius;
+    float corner = fmaxf(fmaxf(cr->top_left, cr->top_right), fmaxf(cr->bottom_right, cr->bottom_left));
+    draw(ctx, view_window_frame(glow->target), glow->config.color, glow->config.radius,
+         glow->intensity, corner);
+}
+
+void rx_glow_destroy(rx_glow* glow) {
+    free(glow);
+}
+
+rx_glow* rx_glow_neon(rx_view* view, rx_color color) {
+    rx_glow* glow = rx_glow_create(view, (rx_glow_config){ color, 12.0f, 1.6f, 0.0f, false, true });
+    rx_glow_animate(glow, 0.5f, 0.08f);
+    return glow;
+}
+
+rx_glow* rx_glow_fire(rx_view* view) {
+    rx_glow* glow = rx_glow_create(view, (rx_glow_config){ { 255, 120, 20, 255 }, 16.0f, 1.3f, 0.0f, false, true });
+    rx_glow_animate(glow, 2.0f, 0.2f);
+    return glow;
+}
+
+rx_glow* rx_glow_ice(rx_view* view) {
+    return rx_glow_create(view, (rx_glow_config){ { 150, 220, 255, 255 }, 10.0f, 0.9f, 0.0f, false, true });
+}
+
+rx_glow* rx_glow_magic(rx_view* view, rx_color color) {
+    rx_glow* glow = rx_glow_create(view, (rx_glow_config){ color, 14.0f, 1.2f, 0.0f, false, true });
+    rx_glow_animate(glow, 1.0f, 0.3f);
+    return glow;
+}
+
+rx_glow* rx_glow_pulse(rx_view* view, rx_color color, float speed) {
+    rx_glow* glow = rx_glow_simple(view, color, 10.0f);
+    rx_glow_animate(glow, speed, 0.5f);
+    return glow;
+}
+
+/* ============================================================================
+ * Material System
+ * ============================================================================ */
+
+rx_material rx_material_default(void) {
+    rx_material m;
+    memset(&m, 0, sizeof(m));
+    m.base_color = RX_COLOR_WHITE;
+    m.roughness = 0.5f;
+    m.emissive_color = RX_COLOR_BLACK;
+    m.opacity = 1.0f;
+    m.receive_shadows = true;
+    m.fresnel_power = 5.0f;
+    m.fresnel_color = RX_COLOR_WHITE;
+    return m;
+}
+
+rx_material rx_material_matte(rx_color color) {
+    rx_material m = rx_material_default();
+    m.base_color = color;
+    m.roughness = 1.0f;
+    return m;
+}
+
+rx_material rx_material_metallic(rx_color color) {
+    rx_material m = rx_material_default();
+    m.base_color = color;
+    m.roughness = 0.3f;
+    m.metallic = 1.0f;
+    m.reflectivity = 0.6f;
+    return m;
+}
+
+rx_material rx_material_glass(rx_color tint) {
+    rx_material m = rx_material_default();
+    m.base_color = tint;
+    m.roughness = 0.05f;
+    m.reflectivity = 0.5f;
+    m.opacity = 0.3f;
+    m.fresnel_enabled = true;
+    m.fresnel_power = 3.0f;
+    return m;
+}
+
+rx_material rx_material_emissive(rx_color color, float intensity) {
+    rx_material m = rx_material_default();
+    m.base_color = color;
+    m.emissive_color = color;
+    m.emissive_intensity = intensity;
+    return m;
+}
+
+rx_material rx_material_glossy(rx_color color, float gloss) {
+    rx_material m = rx_material_default();
+    m.base_color = color;
+    m.roughness = 1.0f - clamp01(gloss);
+    m.reflectivity = clamp01(gloss) * 0.3f;
+    return m;
+}
+
+void rx_view_set_material(rx_view* view, rx_material mat) {
+    if (!view) return;
+    if (!view->material && !(view->material = (rx_material*)malloc(sizeof(rx_material)))) return;
+    *view->material = mat;
+}
+
+rx_material* rx_view_get_material(rx_view* view) {
+    return view ? view->material : NULL;
+}
+
+/* ============================================================================
+ * Lighting Scene
+ * ============================================================================ */
+
+static rx_lighting_scene* shared_scene;
+static rx_lighting_scene* current_scene;
+
+rx_lighting_scene* rx_lighting_scene_create(void) {
+    rx_lighting_scene* scene = (rx_lighting_scene*)calloc(1, sizeof(rx_lighting_scene));
+    if (!scene) return NULL;
+    scene->ambient_color = RX_COLOR_WHITE;
+    scene->ambient_intensity = 0.35f;
+    scene->environment_color = RX_COLOR_BLACK;
+    scene->shadows_enabled = true;
+    scene->shadow_intensity = 0.5f;
+    scene->shadow_color = (rx_color){ 0, 0, 0, 128 };
+    scene->max_lights_per_pixel = 8;
+    return scene;
+}
+
+void rx_lighting_scene_add_light(rx_lighting_scene* scene, rx_light* light) {
+    if (!scene || !light) return;
+    rx_light** tail = &scene->lights;
+    while (*tail) tail = &(*tail)->next;
+    light->next = NULL;
+    *tail = light;
+    scene->light_count++;
+    if (scene->_cache) scene->_cache->valid = false;
+}
+
+static void mask_release(struct rx_lighting_cache* cache, shadow_mask* m) {
+    if (cache->driver.release) cache->driver.release(cache->driver.ctx, m->id);
+    free(m->coverage);
+}
+
+static void shadow_grid_rebuild(struct rx_lighting_cache* cache) {
+    if (!grow_array((void**)&cache->mask_bounds, &cache->mask_bounds_capacity, cache->mask_count,
+                    sizeof(rx_rect))) {
+        cache->shadows.cols = cache->shadows.rows = 0;
+        return;
+    }
+    for (size_t i = 0; i < cache->mask_count; i++) cache->mask_bounds[i] = cache->masks[i].bounds;
+    grid_build(&cache->shadows, cache->mask_bounds, cache->mask_count);
+}
+
+void rx_lighting_scene_remove_light(rx_lighting_scene* scene, rx_light* light) {
+    if (!scene || !light) return;
+    for (rx_light** link = &scene->lights; *link; link = &(*link)->next) {
+        if (*link != light) continue;
+        *link = light->next;
+        light->next = NULL;
+        scene->light_count--;
+        break;
+    }
+
+    struct rx_lighting_cache* cache = scene->_cache;
+    if (!cache) return;
+    cache->valid = false;
+    size_t n = 0;
+    for (size_t i = 0; i < cache->mask_count; i++) {
+        if (cache->masks[i].light == light) mask_release(cache, &cache->masks[i]);
+        else cache->masks[n++] = cache->masks[i];
+    }
+    if (n != cache->mask_count) {
+        cache->mask_count = n;
+        shadow_grid_rebuild(cache);
+    }
+}
+
+void rx_lighting_scene_set_ambient(rx_lighting_scene* scene, rx_color color, float intensity) {
+    if (!scene) return;
+    scene->ambient_color = color;
+    scene->ambient_intensity = intensity;
+}
+
+void rx_lighting_scene_update(rx_lighting_scene* scene, float dt) {
+    if (scene) scene_prepare(scene, dt);
+}
+
+void rx_lighting_scene_destroy(rx_lighting_scene* scene) {
+    if (!scene) return;
+    if (scene == shared_scene) shared_scene = NULL;
+    if (scene == current_scene) current_scene = NULL;
+
+    rx_light* l = scene->lights;
+    while (l) {
+        rx_light* next = l->next;
+        free(l);
+        l = next;
+    }
+    struct rx_lighting_cache* cache = scene->_cache;
+    if (cache) {
+        for (size_t i = 0; i < cache->mask_count; i++) mask_release(cache, &cache->masks[i]);
+        free(cache->masks);
+        free(cache->mask_bounds);
+        free(cache->terms);
+        free(cache->term_lights);
+        free(cache->term_bounds);
+        free(cache->globals);
+        free(cache->binned_lights);
+        free(cache->binned_bounds);
+        grid_free(&cache->lights);
+        grid_free(&cache->shadows);
+        free(cache);
+    }
+    free(scene);
+}
+
+typedef struct surface {
+    float nx, ny, nz;
+    float shininess, specular;
+    float sr, sg, sb;           /* Specular tint */
+    float dr, dg, db;           /* Diffuse sum */
+    float pr, pg, pb;           /* Specular sum */
+} surface;
+
+/* Lambert plus Blinn-Phong, viewer straight above */
+static inline void surface_add(surface* s, const light_term* t, float lx, float ly, float lz, float atten) {
+    float inv = 1.0f / sqrtf(lx * lx + ly * ly + lz * lz);
+    lx *= inv;
+    ly *= inv;
+    lz *= inv;
+    float ndotl = s->nx * lx + s->ny * ly + s->nz * lz;
+    if (ndotl <= 0) return;
+    float d = ndotl * atten;
+    s->dr += t->r * d;
+    s->dg += t->g * d;
+    s->db += t->b * d;
+
+    float hz = lz + 1.0f;
+    float hinv = 1.0f / sqrtf(lx * lx + ly * ly + hz * hz);
+    float ndoth = (s->nx * lx + s->ny * ly + s->nz * hz) * hinv;
+    if (ndoth <= 0 || s->specular <= 0) return;
+    float spec = powf(ndoth, s->shininess) * s->specular * atten;
+    s->pr += t->r * spec;
+    s->pg += t->g * spec;
+    s->pb += t->b * spec;
+}
+
+rx_color rx_lighting_calculate(rx_lighting_scene* scene, rx_point position, rx_point normal, rx_material mat) {
+    if (!scene) return mat.base_color;
+    struct rx_lighting_cache* cache = scene_cache(scene);
+    if (!cache) return mat.base_color;
+    if (!cache->valid) scene_prepare(scene, 0);
+
+    surface s;
+    memset(&s, 0, sizeof(s));
+    float nz2 = 1.0f - normal.x * normal.x - normal.y * normal.y;
+    s.nx = normal.x;
+    s.ny = normal.y;
+    s.nz = nz2 > 0 ? sqrtf(nz2) : 0;
+    float smooth = 1.0f - clamp01(mat.roughness);
+    s.shininess = 2.0f + smooth * smooth * 126.0f;
+    s.specular = (0.04f + 0.96f * clamp01(mat.metallic)) * smooth;
+
+    float br = rx_srgb_to_linear(mat.base_color.r);
+    float bg = rx_srgb_to_linear(mat.base_color.g);
+    float bb = rx_srgb_to_linear(mat.base_color.b);
+    float m = clamp01(mat.metallic);
+    s.sr = 1.0f - m + m * br;
+    s.sg = 1.0f - m + m * bg;
+    s.sb = 1.0f - m + m * bb;
+
+    for (size_t i = 0; i < cache->global_count; i++) {
+        const light_term* t = &cache->globals[i];
+        surface_add(&s, t, -t->dir_x, -t->dir_y, 1.0f, 1.0f);
+    }
+
+    int cell = grid_cell(&cache->lights, position.x, position.y);
+    if (cell >= 0) {
+        const tile_grid* g = &cache->lights;
+        for (uint32_t k = g->start[cell]; k < g->start[cell + 1]; k++) {
+            const light_term* t = &cache->terms[g->items[k]];
+            float dx = t->x - position.x, dy = t->y - position.y;
+            float ex = dx, ey = dy;
+            if (t->type == RX_LIGHT_AREA) {
+                /* Nearest point of the rectangle */
+                ex = dx > t->half_w ? dx - t->half_w : (dx < -t->half_w ? dx + t->half_w : 0);
+                ey = dy > t->half_h ? dy - t->half_h : (dy < -t->half_h ? dy + t->half_h : 0);
+            }
+            float dist2 = ex * ex + ey * ey;
+            if (dist2 >= t->radius * t->radius) continue;
+            float dist = sqrtf(dist2);
+            float atten = falloff(dist * t->inv_radius, t->falloff_start, t->falloff);
+            if (t->type == RX_LIGHT_SPOT && dist > 0) {
+                float cosang = -(dx * t->dir_x + dy * t->dir_y) / dist;
+                if (cosang <= t->cos_outer) continue;
+                if (cosang < t->cos_inner) {
+                    float u = (cosang - t->cos_outer) / (t->cos_inner - t->cos_outer);
+                    atten *= u * u * (3.0f - 2.0f * u);
+                }
+            }
+            if (atten <= 0) continue;
+            surface_add(&s, t, ex, ey, t->z, atten);
+            scene->lights_evaluated++;
+        }
+    }
+
+    float lit = 1.0f;
+    if (mat.receive_shadows) lit -= rx_lighting_shadow_at(scene, position);
+    float diffuse = 1.0f - 0.9f * m;
+    float refl = clamp01(mat.reflectivity);
+    float er = rx_srgb_to_linear(mat.emissive_color.r) * mat.emissive_intensity;
+    float eg = rx_srgb_to_linear(mat.emissive_color.g) * mat.emissive_intensity;
+    float eb = rx_srgb_to_linear(mat.emissive_color.b) * mat.emissive_intensity;
+
+    float r = br * (cache->ambient_r + s.dr * diffuse * lit) + s.pr * s.sr * lit + cache->env_r * refl + er;
+    float g = bg * (cache->ambient_g + s.dg * diffuse * lit) + s.pg * s.sg * lit + cache->env_g * refl + eg;
+    float b = bb * (cache->ambient_b + s.db * diffuse * lit) + s.pb * s.sb * lit + cache->env_b * refl + eb;
+
+    if (mat.fresnel_enabled) {
+        float f = powf(1.0f - s.nz, mat.fresnel_power > 0 ? mat.fresnel_power : 5.0f);
+        r += rx_srgb_to_linear(mat.fresnel_color.r) * f;
+        g += rx_srgb_to_linear(mat.fresnel_color.g) * f;
+        b += rx_srgb_to_linear(mat.fresnel_color.b) * f;
+    }
+
+    float alpha = mat.base_color.a * clamp01(mat.opacity);
+    return (rx_color){ rx_linear_to_srgb(r), rx_linear_to_srgb(g), rx_linear_to_srgb(b), (uint8_t)(alpha + 0.5f) };
+}
+
+float rx_lighting_shadow_at(rx_lighting_scene* scene, rx_point position) {
+    if (!scene || !scene->shadows_enabled || !scene->_cache) return 0;
+    struct rx_lighting_cache* cache = scene->_cache;
+    int cell = grid_cell(&cache->shadows, position.x, position.y);
+    if (cell < 0) return 0;
+
+    float lit = 1.0f;
+    const tile_grid* g = &cache->shadows;
+    for (uint32_t k = g->start[cell]; k < g->start[cell + 1]; k++) {
+        const shadow_mask* mk = &cache->masks[g->items[k]];
+        float u = (position.x - mk->bounds.x) / mk->bounds.width;
+        float v = (position.y - mk->bounds.y) / mk->bounds.height;
+        if (u < 0 || v < 0 || u >= 1.0f || v >= 1.0f) continue;
+        uint8_t c = mk->coverage[(int)(v * mk->height) * mk->width + (int)(u * mk->width)];
+        lit *= 1.0f - c / 255.0f;
+    }
+    return (1.0f - lit) * clamp01(scene->shadow_intensity);
+}
+
+rx_lighting_scene* rx_lighting_scene_shared(void) {
+    if (!shared_scene) shared_scene = rx_lighting_scene_create();
+    return shared_scene;
+}
+
+void rx_lighting_set_scene(rx_lighting_scene* scene) {
+    current_scene = scene;
+}
+
+/* ============================================================================
+ * Dynamic Shadow System
+ * ============================================================================ */
+
+rx_shadow_caster* rx_shadow_caster_create(rx_view* view, float height) {
+    rx_shadow_caster* caster = (rx_shadow_caster*)calloc(1, sizeof(rx_shadow_caster));
+    if (!caster) return NULL;
+    caster->view = view;
+    caster->height = height;
+    caster->soft_shadow = true;
+    caster->softness = 6.0f;
+    return caster;
+}
+
+rx_shadow_receiver* rx_shadow_receiver_create(rx_view* view) {
+    rx_shadow_receiver* receiver = (rx_shadow_receiver*)calloc(1, sizeof(rx_shadow_receiver));
+    if (!receiver) return NULL;
+    receiver->view = view;
+    receiver->opacity = 1.0f;
+    receiver->tint = RX_COLOR_BLACK;
+    return receiver;
+}
+
+void rx_shadow_set_driver(rx_lighting_scene* scene, const rx_shadow_driver* driver) {
+    struct rx_lighting_cache* cache = scene ? scene_cache(scene) : NULL;
+    if (!cache) return;
+    if (driver) cache->driver = *driver;
+    else memset(&cache->driver, 0, sizeof(cache->driver));
+    /* The new driver has none of the masks */
+    for (size_t i = 0; i < cache->mask_count; i++) cache->masks[i].key[0] = NAN;
+}
+
+/* Geometry the mask depends on; NaN never compares equal, forcing a build */
+static void shadow_key(const rx_shadow_caster* caster, const rx_light* light, float key[SHADOW_KEY]) {
+    rx_rect f = view_window_frame(caster->view);
+    bool directional = light->type == RX_LIGHT_DIRECTIONAL;
+    key[0] = f.x;
+    key[1] = f.y;
+    key[2] = f.width;
+    key[3] = f.height;
+    key[4] = caster->height;
+    key[5] = caster->soft_shadow ? caster->softness : 0;
+    key[6] = light->shadow_softness;
+    key[7] = directional ? light->direction.x : light->position.x;
+    key[8] = directional ? light->direction.y : light->position.y;
+    key[9] = directional ? -1.0f : light->z_height;
+}
+
+/* 1D coverage of [a, b] blurred by a penumbra of half-width r */
+static inline float coverage_1d(float x, float a, float b, float r) {
+    if (r <= 0) return (x >= a && x < b) ? 1.0f : 0;
+    return clamp01((x - a) / (2 * r) + 0.5f) * clamp01((b - x) / (2 * r) + 0.5f);
+}
+
+/* Caster rect projected from the light onto the surface, as a separable
+ * soft rectangle */
+static bool shadow_build(shadow_mask* m) {
+    const float* k = m->key;
+    float x = k[0], y = k[1], w = k[2], h = k[3], height = k[4];
+    float blur = k[5] + k[6];
+    if (k[9] < 0) {
+        float len = sqrtf(k[7] * k[7] + k[8] * k[8]);
+        if (len > 0) {
+            x += k[7] / len * height;
+            y += k[8] / len * height;
+        }
+    } else {
+        /* Similar triangles; a caster near the light's height is capped at 4x */
+        float lz = fmaxf(k[9], 1.0f);
+        float scale = lz / fmaxf(lz - height, lz * 0.25f);
+        x = k[7] + (x - k[7]) * scale;
+        y = k[8] + (y - k[8]) * scale;
+        w *= scale;
+        h *= scale;
+        blur += height * 0.1f;
+    }
+
+    m->bounds = rect(x - blur, y - blur, w + 2 * blur, h + 2 * blur);
+    int tw = (int)ceilf(m->bounds.width / SHADOW_CELL), th = (int)ceilf(m->bounds.height / SHADOW_CELL);
+    tw = tw < 1 ? 1 : (tw > SHADOW_MAX_TEXELS ? SHADOW_MAX_TEXELS : tw);
+    th = th < 1 ? 1 : (th > SHADOW_MAX_TEXELS ? SHADOW_MAX_TEXELS : th);
+    if (!m->coverage || tw * th > m->width * m->height) {
+        uint8_t* grown = (uint8_t*)realloc(m->coverage, (size_t)tw * (size_t)th);
+        if (!grown) return false;
+        m->coverage = grown;
+    }
+    m->width = tw;
+    m->height = th;
+
+    float cx[SHADOW_MAX_TEXELS], cy[SHADOW_MAX_TEXELS];
+    float sx = m->bounds.width / (float)tw, sy = m->bounds.height / (float)th;
+    for (int i = 0; i < tw; i++) cx[i] = coverage_1d(m->bounds.x + (i + 0.5f) * sx, x, x + w, blur * 0.5f);
+    for (int j = 0; j < th; j++) cy[j] = coverage_1d(m->bounds.y + (j + 0.5f) * sy, y, y + h, blur * 0.5f);
+    for (int j = 0; j < th; j++) {
+        uint8_t* row = m->coverage + (size_t)j * (size_t)tw;
+        for (int i = 0; i < tw; i++) row[i] = (uint8_t)(cx[i] * cy[j] * 255.0f + 0.5f);
+    }
+    return true;
+}
+
+/*
+ * Masks are kept in caster-then-light order, so a frame with the same
+ * casters finds each one at the next index. Only masks whose key changed
+ * are rasterized and uploaded; ones not reached are released.
+ */
+void rx_shadow_update(rx_lighting_scene* scene, rx_shadow_caster** casters, size_t caster_count) {
+    if (!scene) return;
+    struct rx_lighting_cache* cache = scene_cache(scene);
+    if (!cache) return;
+    uint32_t epoch = ++cache->mask_epoch;
+    bool changed = false;
+    size_t hint = 0;
+
+    for (size_t c = 0; scene->shadows_enabled && c < caster_count; c++) {
+        rx_shadow_caster* caster = casters[c];
+        if (!caster || !caster->view || !caster->view->visible) continue;
+        for (rx_light* light = scene->lights; light; light = light->next) {
+            if (!light->enabled || !light->cast_shadows || light->type == RX_LIGHT_AMBIENT) continue;
+
+            /* Masks before hint are claimed this frame; look from there */
+            size_t index = hint;
+            while (index < cache->mask_count &&
+                   (cache->masks[index].caster != caster || cache->masks[index].light != light)) {
+                index++;
+            }
+            if (index == cache->mask_count) {
+                if (!grow_array((void**)&cache->masks, &cache->mask_capacity, cache->mask_count + 1,
+                                sizeof(shadow_mask))) {
+                    continue;
+                }
+                shadow_mask* fresh = &cache->masks[cache->mask_count++];
+                memset(fresh, 0, sizeof(*fresh));
+                fresh->caster = caster;
+                fresh->light = light;
+                fresh->id = ++cache->next_mask_id;
+                fresh->key[0] = NAN;
+            }
+            if (index != hint) {
+                shadow_mask tmp = cache->masks[hint];
+                cache->masks[hint] = cache->masks[index];
+                cache->masks[index] = tmp;
+                index = hint;
+            }
+
+            shadow_mask* m = &cache->masks[index];
+            m->epoch = epoch;
+            float key[SHADOW_KEY];
+            shadow_key(caster, light, key);
+            if (memcmp(key, m->key, sizeof(key)) != 0) {
+                memcpy(m->key, key, sizeof(key));
+                if (shadow_build(m)) {
+                    scene->shadow_rebuilds++;
+                    if (cache->driver.upload) {
+                        cache->driver.upload(cache->driver.ctx, m->id, m->coverage, m->width, m->height);
+                    }
+                } else {
+                    m->key[0] = NAN;
+                    m->width = m->height = 0;
+                }
+                changed = true;
+            }
+            hint++;
+        }
+    }
+
+    size_t n = 0;
+    rx_shadow_caster* last = NULL;
+    for (size_t i = 0; i < cache->mask_count; i++) {
+        shadow_mask* m = &cache->masks[i];
+        if (m->epoch != epoch || m->width == 0) {
+            mask_release(cache, m);
+            changed = true;
+            continue;
+        }
+        if (m->caster != last) {
+            m->caster->_first_mask = (uint32_t)n;
+            last = m->caster;
+        }
+        cache->masks[n++] = *m;
+    }
+    cache->mask_count = n;
+    if (changed) shadow_grid_rebuild(cache);
+}
+
+void rx_shadow_render(void* context, rx_shadow_caster* caster, rx_light* light) {
+    rx_lighting_scene* scene = current_scene ? current_scene : shared_scene;
+    if (!scene || !caster || !light || !scene->_cache) return;
+    struct rx_lighting_cache* cache = scene->_cache;
+    if (!cache->driver.draw) return;
+
+    for (size_t i = caster->_first_mask; i < cache->mask_count && cache->masks[i].caster == caster; i++) {
+        shadow_mask* m = &cache->masks[i];
+        if (m->light != light) continue;
+        rx_color color = light->shadow_color;
+        color.a = (uint8_t)(color.a * clamp01(scene->shadow_intensity) + 0.5f);
+        cache->driver.draw(cache->driver.ctx, context, m->id, m->bounds, color);
+        return;
+    }
+}
+
+/* ============================================================================
+ * Light Animation
+ * ============================================================================ */
+
+static void light_anim_apply(float value, void* data) {
+    rx_light_animation* la = (rx_light_animation*)data;
+    rx_light* light = la->light;
+    switch (la->anim_type) {
+        case RX_LIGHT_ANIM_INTENSITY:
+            light->intensity = value;
+            break;
+        case RX_LIGHT_ANIM_RADIUS:
+            light->radius = value;
+            break;
+        case RX_LIGHT_ANIM_COLOR:
+            light->color = rx_color_mix(la->from_color, la->to_color, value);
+            break;
+        case RX_LIGHT_ANIM_POSITION:
+            light->position = point(la->from_position.x + (la->to_position.x - la->from_position.x) * value,
+                                    la->from_position.y + (la->to_position.y - la->from_position.y) * value);
+            break;
+    }
+}
+
+/* Defaults and id come from rx_animate; the record is heap-owned, so
+ * rx_anim_destroy frees the whole rx_light_animation */
+static rx_light_animation* light_animation(rx_light* light, rx_light_anim_type type, float from, float to,
+                                           float duration) {
+    if (!light) return NULL;
+    rx_animation* defaults = rx_animate(from, to, duration);
+    if (!defaults) return NULL;
+    rx_light_animation* la = (rx_light_animation*)calloc(1, sizeof(rx_light_animation));
+    if (la) {
+        la->base = *defaults;
+        la->base.pooled = false;
+        la->base.next = NULL;
+        la->light = light;
+        la->anim_type = type;
+        rx_anim_on_update(&la->base, light_anim_apply, la);
+    }
+    rx_anim_destroy(defaults);
+    return la;
+}
+
+rx_animation* rx_light_animate_intensity(rx_light* light, float to, float duration) {
+    rx_light_animation* la = light ? light_animation(light, RX_LIGHT_ANIM_INTENSITY, light->intensity, to, duration)
+                                   : NULL;
+    return la ? &la->base : NULL;
+}
+
+rx_animation* rx_light_animate_color(rx_light* light, rx_color to, float duration) {
+    rx_light_animation* la = light_animation(light, RX_LIGHT_ANIM_COLOR, 0, 1.0f, duration);
+    if (!la) return NULL;
+    la->from_color = light->color;
+    la->to_color = to;
+    return &la->base;
+}
+
+rx_animation* rx_light_animate_position(rx_light* light, rx_point to, float duration) {
+    rx_light_animation* la = light_animation(light, RX_LIGHT_ANIM_POSITION, 0, 1.0f, duration);
+    if (!la) return NULL;
+    la->from_position = light->position;
+    la->to_position = to;
+    return &la->base;
+}
+
+rx_animation* rx_light_animate_radius(rx_light* light, float to, float duration) {
+    rx_light_animation* la = light ? light_animation(light, RX_LIGHT_ANIM_RADIUS, light->radius, to, duration)
+                                   : NULL;
+    return la ? &la->base : NULL;
+}
+
+/* ============================================================================
+ * Effect Presets
+ * ============================================================================ */
+
+static void scene_mood(rx_lighting_scene* scene, rx_color ambient, float ambient_intensity,
+                       rx_color environment, float environment_intensity, bool shadows, float shadow_intensity) {
+    if (!scene) return;
+    scene->ambient_color = ambient;
+    scene->ambient_intensity = ambient_intensity;
+    scene->environment_color = environment;
+    scene->environment_intensity = environment_intensity;
+    scene->shadows_enabled = shadows;
+    scene->shadow_intensity = shadow_intensity;
+}
+
+void rx_lighting_setup_day(rx_lighting_scene* scene) {
+    scene_mood(scene, (rx_color){ 255, 250, 240, 255 }, 0.7f, (rx_color){ 135, 206, 235, 255 }, 0.2f, true, 0.3f);
+}
+
+void rx_lighting_setup_night(rx_lighting_scene* scene) {
+    scene_mood(scene, (rx_color){ 40, 50, 90, 255 }, 0.25f, (rx_color){ 20, 24, 48, 255 }, 0.15f, true, 0.5f);
+}
+
+void rx_lighting_setup_sunset(rx_lighting_scene* scene) {
+    scene_mood(scene, (rx_color){ 255, 140, 90, 255 }, 0.45f, (rx_color){ 250, 110, 80, 255 }, 0.25f, true, 0.45f);
+}
+
+void rx_lighting_setup_neon(rx_lighting_scene* scene) {
+    scene_mood(scene, (rx_color){ 20, 10, 40, 255 }, 0.2f, (rx_color){ 60, 0, 90, 255 }, 0.3f, false, 0);
+}
+
+void rx_lighting_setup_dramatic(rx_lighting_scene* scene) {
+    scene_mood(scene, (rx_color){ 20, 20, 25, 255 }, 0.1f, RX_COLOR_BLACK, 0, true, 0.8f);
+}
+
+void rx_lighting_setup_soft(rx_lighting_scene* scene) {
+    scene_mood(scene, RX_COLOR_WHITE, 0.8f, RX_COLOR_WHITE, 0.1f, true, 0.15f);
+}
+
+rx_light* rx_cursor_light_create(rx_color color, float radius) {
+    rx_light* light = rx_light_point(point(0, 0), color, 0.8f, radius);
+    if (light) light->z_height = 30.0f;
+    return light;
+}
+
+void rx_cursor_light_update(rx_light* light, rx_point cursor_pos) {
+    if (light) light->position = cursor_pos;
+}
+
+/* Follows the view's center at each scene update; detach before freeing
+ * the view */
+rx_light* rx_focus_light_create(rx_view* view, rx_color color) {
+    float extent = view ? fmaxf(view->box.frame.width, view->box.frame.height) : 0;
+    rx_light* light = rx_light_point(point(0, 0), color, 1.2f, extent * 0.75f + 40.0f);
+    if (!light) return NULL;
+    light->z_height = 20.0f;
+    rx_focus_light_attach(light, view);
+    return light;
+}
+
+void rx_focus_light_attach(rx_light* light, rx_view* view) {
+    if (!light) return;
+    light->_attached = view;
+    if (view) {
+        rx_rect f = view_window_frame(view);
+        light->position = point(f.x + f.width * 0.5f, f.y + f.height * 0.5f);
+    }
+}
+
+void rx_focus_light_detach(rx_light* light) {
+    if (light) light->_attached = NULL;
+}
@@ -9,6 +9,16 @@
  * - Dynamic shadows
  * - Material system (reflectivity, emission)
  * - Light animation
+ * 
+ * rx_lighting_scene_update() does the per-frame work once: flicker and
+ * pulse factors, lights attached to views, and a screen-space tile grid
+ * of the lights that reach each 64px tile. rx_lighting_calculate() then
+ * looks only at its tile's lights, at most max_lights_per_pixel of the
+ * strongest. Light changes take effect at the next update.
+ * 
+ * Shadow masks are cached per caster and light and rebuilt only when the
+ * caster's view moves or resizes or the light moves; the shadow driver
+ * uploads a mask when it is built and draws it from then on.
  */
 
 #ifndef REOX_LIGHTING_H
@@ -66,8 +76,8 @@ typedef struct rx_light {
     float falloff_start;      /* Where falloff begins (0-1) */
     
     /* Spot light specific */
-    float inner_angle;        /* Full intensity cone */
-    float outer_angle;        /* Falloff cone edge */
+    float inner_angle;        /* Full intensity cone (half-angle, degrees) */
+    float outer_angle;        /* Falloff cone edge (half-angle, degrees) */
     
     /* Area light specific */
     rx_size area_size;
@@ -87,6 +97,8 @@ typedef struct rx_light {
     /* Internal state */
     float _flicker_phase;
     float _pulse_phase;
+    float _factor;            /* Flicker x pulse for this frame */
+    rx_view* _attached;       /* Followed by a focus light */
     
     struct rx_light* next;
 } rx_light;
@@ -130,6 +142,7 @@ typedef struct rx_glow {
     bool animated;
     float pulse_speed;
     float pulse_amount;
+    float intensity;          /* config.intensity with the pulse applied */
     float _phase;
 } rx_glow;
 
@@ -139,6 +152,11 @@ extern void rx_glow_set_color(rx_glow* glow, rx_color color);
 extern void rx_glow_set_radius(rx_glow* glow, float radius);
 extern void rx_glow_animate(rx_glow* glow, float pulse_speed, float pulse_amount);
 extern void rx_glow_update(rx_glow* glow, float dt);
+/* Draw a halo around the target's window frame (outer glows only); a
+ * backend's draw_glow has this shape once ctx is bound */
+typedef void (*rx_glow_draw_fn)(void* ctx, rx_rect frame, rx_color color, float radius,
+                                float intensity, float corner_radius);
+extern void rx_glow_render(const rx_glow* glow, rx_glow_draw_fn draw, void* ctx);
 extern void rx_glow_destroy(rx_glow* glow);
 
 /* Preset glows */
@@ -211,6 +229,14 @@ typedef struct rx_lighting_scene {
     
     /* Performance */
     int max_lights_per_pixel;
+    
+    /* Statistics */
+    uint64_t lights_evaluated;    /* Light terms summed by rx_lighting_calculate */
+    uint32_t rebins;              /* Tile grid rebuilds */
+    uint32_t shadow_rebuilds;     /* Shadow masks rasterized */
+    
+    /* Tile grid, per-frame light terms and shadow masks */
+    struct rx_lighting_cache* _cache;
 } rx_lighting_scene;
 
 extern rx_lighting_scene* rx_lighting_scene_create(void);
@@ -220,7 +246,8 @@ extern void rx_lighting_scene_set_ambient(rx_lighting_scene* scene, rx_color col
 extern void rx_lighting_scene_update(rx_lighting_scene* scene, float dt);
 extern void rx_lighting_scene_destroy(rx_lighting_scene* scene);
 
-/* Calculate lighting at a point */
+/* Calculate lighting at a point. The scene owns lights added to it until
+ * they are removed. */
 extern rx_color rx_lighting_calculate(rx_lighting_scene* scene, rx_point position, rx_point normal, rx_material mat);
 extern float rx_lighting_shadow_at(rx_lighting_scene* scene, rx_point position);
 
@@ -237,6 +264,7 @@ typedef struct rx_shadow_caster {
     float height;             /* Object height for shadow offset */
     bool soft_shadow;
     float softness;
+    uint32_t _first_mask;     /* Its first mask in the scene's cache */
 } rx_shadow_caster;
 
 typedef struct rx_shadow_receiver {
@@ -245,8 +273,22 @@ typedef struct rx_shadow_receiver {
     rx_color tint;
 } rx_shadow_receiver;
 
+/* Masks live on the backend: upload when one is built or rebuilt (coverage,
+ * width x height, row-major), release when dropped, draw stretched over
+ * bounds in the shadow color */
+typedef struct rx_shadow_driver {
+    void (*upload)(void* ctx, uint32_t mask_id, const uint8_t* coverage, int width, int height);
+    void (*release)(void* ctx, uint32_t mask_id);
+    void (*draw)(void* ctx, void* context, uint32_t mask_id, rx_rect bounds, rx_color color);
+    void* ctx;
+} rx_shadow_driver;
+
 extern rx_shadow_caster* rx_shadow_caster_create(rx_view* view, float height);
 extern rx_shadow_receiver* rx_shadow_receiver_create(rx_view* view);
+extern void rx_shadow_set_driver(rx_lighting_scene* scene, const rx_shadow_driver* driver);
+
+/* Bring the masks of these casters up to date; masks of casters left out
+ * are dropped. Call once per frame after layout. */
 extern void rx_shadow_update(rx_lighting_scene* scene, rx_shadow_caster** casters, size_t caster_count);
 extern void rx_shadow_render(void* context, rx_shadow_caster* caster, rx_light* light);
 
@@ -269,6 +311,10 @@ typedef struct rx_light_animation {
     /* Color animation */
     rx_color from_color;
     rx_color to_color;
+    
+    /* Position animation */
+    rx_point from_position;
+    rx_point to_position;
 } rx_light_animation;
 
 extern rx_animation* rx_light_animate_intensity(rx_light* light, float to, float duration);
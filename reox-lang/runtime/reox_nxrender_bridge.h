@@ -10,6 +10,19 @@
  * └─────────────┘     └─────────────┘     └─────────────┘
  * 
  * SCOPE: Layout + Input + Redraw (no animations yet)
+ * 
+ * REDRAW: rx_invalidate() queues a node; each frame repaints only the
+ * merged damage rects under a clip. Setting needs_redraw, or a layout
+ * pass, repaints the whole tree. Draws are recorded into a per-frame
+ * list, grouped by kind and replayed through the per-shape nx_gpu_* calls.
+ * Define RX_DRAW_BATCHED to hand the list to nx_gpu_submit() in one call
+ * instead; the NXRender FFI does not export it yet, so it is opt-in.
+ * Subtrees that stay unchanged, or are flagged RX_STATE_CACHE, keep their
+ * recorded commands and replay them instead of being walked again.
+ *
+ * STATS: rx_frame() brackets a frame record (reox_frame_stats.h) with
+ * layout, render and present zones; rx_frame_stats_set_overlay(true)
+ * draws the recent averages and a frame-time graph in the top-left.
  */
 
 #ifndef REOX_NXRENDER_BRIDGE_H
@@ -17,6 +30,10 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reox_runtime.h"
+#include "reox_frame_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +62,31 @@ void nx_gpu_fill_rounded_rect(NxGpuContext ctx, NxRect rect, NxColor color, floa
 void nx_gpu_fill_circle(NxGpuContext ctx, float x, float y, float radius, NxColor color);
 void nx_gpu_draw_text(NxGpuContext ctx, const char* text, float x, float y, NxColor color);
 void nx_gpu_clear(NxGpuContext ctx, NxColor color);
+void nx_gpu_set_clip(NxGpuContext ctx, NxRect rect);
+void nx_gpu_reset_clip(NxGpuContext ctx);
+
+/* Batched drawing: one call per frame. Consecutive commands of the same
+ * kind form one batch and can be drawn instanced. */
+typedef enum {
+    NX_DRAW_FILL_RECT = 0,
+    NX_DRAW_FILL_ROUNDED_RECT = 1,
+    NX_DRAW_FILL_CIRCLE = 2,      /* rect is the bounding square */
+    NX_DRAW_TEXT = 3,             /* rect.x/y is the text origin */
+    NX_DRAW_SET_CLIP = 4,
+    NX_DRAW_RESET_CLIP = 5,
+} NxDrawKind;
+
+typedef struct {
+    uint8_t kind;
+    NxColor color;
+    float radius;
+    NxRect rect;
+    const char* text;             /* Valid until the list is submitted */
+} NxDrawCmd;
+
+#ifdef RX_DRAW_BATCHED
+void nx_gpu_submit(NxGpuContext ctx, const NxDrawCmd* cmds, uint32_t count);
+#endif
 
 /* Theme */
 typedef void* NxTheme;
@@ -106,8 +148,16 @@ typedef enum {
     RX_STATE_DISABLED = 1 << 3,
     RX_STATE_HIDDEN = 1 << 4,
     RX_STATE_DIRTY = 1 << 5,    /* Needs redraw */
+    RX_STATE_DAMAGED = 1 << 6,  /* Queued for damage collection */
+    RX_STATE_CACHE = 1 << 7,    /* Always keep a display list */
+    RX_STATE_ARENA = 1 << 8,    /* Node lives in its tree's single allocation */
+    RX_STATE_ARENA_TEXT = 1 << 9, /* So does its text */
+    RX_STATE_ARENA_ROOT = 1 << 10, /* First node of that allocation; frees it */
 } RxNodeState;
 
+/* Recorded draws of a subtree, replayed while nothing inside changes */
+typedef struct RxDisplayList RxDisplayList;
+
 /* UI Node - the core building block */
 typedef struct RxNode {
     uint64_t id;                /* Unique node ID */
@@ -116,6 +166,13 @@ typedef struct RxNode {
     
     /* Bounds (computed by layout) */
     float x, y, width, height;
+    NxRect painted;             /* Bounds when last rendered */
+    NxRect indexed;             /* Bounds when last put in the hit grid */
+    bool indexed_hidden;
+    
+    /* Display-list cache (see RX_STATE_CACHE) */
+    RxDisplayList* display_list;
+    uint16_t stable_frames;     /* Renders since the subtree last changed */
     
     /* Style */
     NxColor background;
@@ -143,6 +200,66 @@ typedef struct RxNode {
  * These functions connect REOX code to NXRender
  * ============================================================================ */
 
+/* Dirty rects kept per frame; more damage is merged into these */
+#define RX_DAMAGE_MAX 8
+
+/* Hit-test grid cell size in pixels, and a cap on cells per axis */
+#define RX_HIT_CELL 64
+#define RX_HIT_MAX_CELLS 256
+
+/* Interactive node in the hit grid. rect is its bounds clipped by its
+ * ancestors; order is its pre-order index, so higher means on top. */
+typedef struct {
+    RxNode* node;
+    NxRect rect;
+    uint32_t order;
+} RxHitEntry;
+
+/* How many batches back a command may be hoisted to join its kind */
+#define RX_DRAW_LOOKBACK 32
+
+/* NXRender cannot measure text, so batching bounds it from above: no glyph
+ * wider than RX_TEXT_MAX_ADVANCE per byte of UTF-8, none reaching further
+ * than the ascent/descent from the baseline. Generous for UI font sizes;
+ * rx_bridge_set_text_metrics tightens them for a known font. */
+#define RX_TEXT_MAX_ADVANCE 24.0f
+#define RX_TEXT_MAX_ASCENT 32.0f
+#define RX_TEXT_MAX_DESCENT 12.0f
+
+typedef struct {
+    uint8_t kind;
+    NxRect bounds;                /* Union of member bounds */
+    uint32_t count;
+} RxDrawBatch;
+
+/* Subtrees unchanged this many renders get a display list automatically,
+ * provided they record at least RX_CACHE_MIN_CMDS commands */
+#define RX_CACHE_STABLE_FRAMES 3
+#define RX_CACHE_MIN_CMDS 8
+
+struct RxDisplayList {
+    NxDrawCmd* cmds;
+    NxRect* bounds;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t epoch;               /* rx_bridge->cache_epoch when recorded */
+    bool valid;
+};
+
+/* Per-frame command buffer; storage is kept between frames */
+typedef struct {
+    NxDrawCmd* cmds;
+    NxRect* bounds;
+    uint32_t* batch_of;
+    size_t count;
+    size_t capacity;
+    NxDrawCmd* sorted;
+    size_t sorted_capacity;
+    RxDrawBatch* batches;
+    size_t batch_count;
+    size_t batch_capacity;
+} RxDrawList;
+
 /* Global bridge state */
 typedef struct {
     NxGpuContext gpu;
@@ -153,7 +270,35 @@ typedef struct {
     RxNode* focused;
     RxNode* hovered;
     uint64_t next_node_id;
-    bool needs_redraw;
+    bool needs_redraw;          /* Full repaint */
+    
+    /* Partial repaint: invalidated nodes and the merged damage rects */
+    RxNode** damaged_nodes;
+    size_t damaged_count;
+    size_t damaged_capacity;
+    NxRect damage[RX_DAMAGE_MAX];
+    int damage_count;
+    
+    /* Hit-test grid: cell c lists hit_cells[hit_cell_start[c] ..
+     * hit_cell_start[c + 1]) as indices into hit_entries */
+    RxHitEntry* hit_entries;
+    size_t hit_count;
+    size_t hit_capacity;
+    uint32_t* hit_cells;
+    size_t hit_cells_capacity;
+    uint32_t* hit_cell_start;
+    size_t hit_start_capacity;
+    NxRect hit_area;
+    int hit_cols, hit_rows;
+    bool hit_dirty;
+    
+    /* Pointer motion since the last frame, resolved once per frame */
+    bool mouse_move_pending;
+    float mouse_x, mouse_y;
+    
+    RxDrawList draw_list;
+    uint32_t cache_epoch;         /* Bumped when every display list goes stale */
+    float text_advance, text_ascent, text_descent;
 } RxBridge;
 
 /* Initialize bridge */
@@ -167,6 +312,21 @@ static inline void rx_bridge_init(uint32_t width, uint32_t height) {
     rx_bridge->keyboard = nx_keyboard_create();
     rx_bridge->next_node_id = 1;
     rx_bridge->needs_redraw = true;
+    rx_bridge->hit_dirty = true;
+    rx_bridge->cache_epoch = 1;
+    rx_bridge->text_advance = RX_TEXT_MAX_ADVANCE;
+    rx_bridge->text_ascent = RX_TEXT_MAX_ASCENT;
+    rx_bridge->text_descent = RX_TEXT_MAX_DESCENT;
+}
+
+/* Upper bounds for the backend's font; they only have to hold for every
+ * glyph it draws. Recorded display lists are re-recorded with them. */
+static inline void rx_bridge_set_text_metrics(float max_advance, float ascent, float descent) {
+    if (!rx_bridge) return;
+    rx_bridge->text_advance = max_advance;
+    rx_bridge->text_ascent = ascent;
+    rx_bridge->text_descent = descent;
+    rx_bridge->cache_epoch++;
 }
 
 static inline void rx_bridge_destroy(void) {
@@ -175,24 +335,157 @@ static inline void rx_bridge_destroy(void) {
     nx_theme_destroy(rx_bridge->theme);
     nx_mouse_destroy(rx_bridge->mouse);
     nx_keyboard_destroy(rx_bridge->keyboard);
+    free(rx_bridge->damaged_nodes);
+    free(rx_bridge->hit_entries);
+    free(rx_bridge->hit_cells);
+    free(rx_bridge->hit_cell_start);
+    free(rx_bridge->draw_list.cmds);
+    free(rx_bridge->draw_list.bounds);
+    free(rx_bridge->draw_list.batch_of);
+    free(rx_bridge->draw_list.sorted);
+    free(rx_bridge->draw_list.batches);
     free(rx_bridge);
     rx_bridge = NULL;
 }
 
+/* ============================================================================
+ * Damage Tracking
+ * ============================================================================ */
+
+static inline bool rx_rect_empty(NxRect r) {
+    return r.width <= 0 || r.height <= 0;
+}
+
+static inline bool rx_rect_intersects(NxRect a, NxRect b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static inline NxRect rx_rect_union(NxRect a, NxRect b) {
+    if (rx_rect_empty(a)) return b;
+    if (rx_rect_empty(b)) return a;
+    float x0 = a.x < b.x ? a.x : b.x;
+    float y0 = a.y < b.y ? a.y : b.y;
+    float x1 = a.x + a.width > b.x + b.width ? a.x + a.width : b.x + b.width;
+    float y1 = a.y + a.height > b.y + b.height ? a.y + a.height : b.y + b.height;
+    return (NxRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/* Add a rect to the damage set, merging overlaps. When the set is full the
+ * rect joins whichever existing rect grows the least. */
+static inline void rx_damage_add(NxRect r) {
+    if (!rx_bridge || rx_rect_empty(r)) return;
+    
+    int i = 0;
+    while (i < rx_bridge->damage_count) {
+        if (rx_rect_intersects(rx_bridge->damage[i], r)) {
+            r = rx_rect_union(rx_bridge->damage[i], r);
+            rx_bridge->damage[i] = rx_bridge->damage[--rx_bridge->damage_count];
+            i = 0;  /* The union may now touch an earlier rect */
+        } else {
+            i++;
+        }
+    }
+    
+    if (rx_bridge->damage_count < RX_DAMAGE_MAX) {
+        rx_bridge->damage[rx_bridge->damage_count++] = r;
+        return;
+    }
+    
+    int best = 0;
+    float best_growth = 0;
+    for (i = 0; i < rx_bridge->damage_count; i++) {
+        NxRect d = rx_bridge->damage[i];
+        NxRect u = rx_rect_union(d, r);
+        float growth = u.width * u.height - d.width * d.height;
+        if (i == 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    NxRect merged = rx_rect_union(rx_bridge->damage[best], r);
+    rx_bridge->damage[best] = rx_bridge->damage[--rx_bridge->damage_count];
+    rx_damage_add(merged);
+}
+
+/* Damage for each invalidated node: where it was drawn plus where it is now */
+static inline void rx_damage_collect(void) {
+    for (size_t i = 0; i < rx_bridge->damaged_count; i++) {
+        RxNode* node = rx_bridge->damaged_nodes[i];
+        node->state &= ~RX_STATE_DAMAGED;
+        NxRect now = { node->x, node->y, node->width, node->height };
+        rx_damage_add(rx_rect_union(node->painted, now));
+    }
+    rx_bridge->damaged_count = 0;
+}
+
+static inline void rx_damage_forget(RxNode* node) {
+    if (!rx_bridge || !(node->state & RX_STATE_DAMAGED)) return;
+    for (size_t i = 0; i < rx_bridge->damaged_count; i++) {
+        if (rx_bridge->damaged_nodes[i] == node) {
+            rx_bridge->damaged_nodes[i] = rx_bridge->damaged_nodes[--rx_bridge->damaged_count];
+            break;
+        }
+    }
+}
+
+/* Something inside changed: no cache on the path to the root still holds */
+static inline void rx_display_list_invalidate_path(RxNode* node) {
+    for (; node; node = node->parent) {
+        node->stable_frames = 0;
+        if (node->display_list) node->display_list->valid = false;
+    }
+}
+
+static inline void rx_display_list_free(RxNode* node) {
+    if (!node->display_list) return;
+    free(node->display_list->cmds);
+    free(node->display_list->bounds);
+    free(node->display_list);
+    node->display_list = NULL;
+}
+
 /* ============================================================================
  * Node Creation
  * ============================================================================ */
 
-static inline RxNode* rx_node_create(RxNodeType type) {
-    RxNode* node = (RxNode*)calloc(1, sizeof(RxNode));
+/* Set up a zeroed node; also used for nodes placed in an arena (reox_cpp.hpp) */
+static inline void rx_node_init(RxNode* node, RxNodeType type) {
     node->id = rx_bridge->next_node_id++;
     node->type = type;
     node->state = RX_STATE_DIRTY;
     node->background = (NxColor){0, 0, 0, 0};
     node->foreground = nx_theme_get_text_color(rx_bridge->theme);
+}
+
+static inline RxNode* rx_node_create(RxNodeType type) {
+    RxNode* node = (RxNode*)calloc(1, sizeof(RxNode));
+    rx_node_init(node, type);
     return node;
 }
 
+/* strdup is POSIX, and generated C is built as plain C11 */
+static inline char* rx_text_copy(const char* text) {
+    size_t size = strlen(text) + 1;
+    char* copy = (char*)malloc(size);
+    if (copy) memcpy(copy, text, size);
+    return copy;
+}
+
+/* Replace the node's text with a copy; NULL clears it */
+static inline void rx_node_set_text(RxNode* node, const char* text) {
+    /* Cached display lists point at the old text */
+    rx_display_list_invalidate_path(node);
+    if (node->text && !(node->state & RX_STATE_ARENA_TEXT)) free(node->text);
+    node->text = text ? rx_text_copy(text) : NULL;
+    node->state &= ~RX_STATE_ARENA_TEXT;
+}
+
+/*
+ * Arena trees are freed in one go with their root: children go first, so
+ * the block is released only after every node in it has been unhooked.
+ * Destroying a node inside an arena tree on its own is not supported.
+ */
 static inline void rx_node_destroy(RxNode* node) {
     if (!node) return;
     
@@ -204,8 +497,19 @@ static inline void rx_node_destroy(RxNode* node) {
         child = next;
     }
     
-    if (node->text) free(node->text);
-    free(node);
+    /* Whatever the node covered on screen has to be repainted */
+    rx_damage_forget(node);
+    rx_damage_add(node->painted);
+    rx_display_list_invalidate_path(node->parent);
+    rx_display_list_free(node);
+    if (rx_bridge) {
+        if (rx_bridge->hovered == node) rx_bridge->hovered = NULL;
+        if (rx_bridge->focused == node) rx_bridge->focused = NULL;
+        rx_bridge->hit_dirty = true;
+    }
+    
+    if (node->text && !(node->state & RX_STATE_ARENA_TEXT)) free(node->text);
+    if (!(node->state & RX_STATE_ARENA) || (node->state & RX_STATE_ARENA_ROOT)) free(node);
 }
 
 /* Node hierarchy */
@@ -222,6 +526,11 @@ static inline void rx_node_add_child(RxNode* parent, RxNode* child) {
         while (last->next_sibling) last = last->next_sibling;
         last->next_sibling = child;
     }
+    
+    /* Structure changed: relayout from the top on the next frame */
+    RxNode* top = parent;
+    while (top->parent) top = top->parent;
+    top->state |= RX_STATE_DIRTY;
 }
 
 /* ============================================================================
@@ -230,6 +539,7 @@ static inline void rx_node_add_child(RxNode* parent, RxNode* child) {
 
 static inline void rx_layout_node(RxNode* node, float available_w, float available_h) {
     if (!node) return;
+    RX_FRAME_COUNT(RX_COUNTER_NODES_LAID_OUT, 1);
     
     float padding = node->padding;
     float inner_w = available_w - padding * 2;
@@ -311,21 +621,264 @@ static inline void rx_layout_node(RxNode* node, float available_w, float availab
     }
 }
 
+/* ============================================================================
+ * Draw List
+ * Rendering records commands; rx_draw_list_submit() groups them by kind
+ * without changing what overlapping draws look like, then hands the
+ * whole frame to NXRender at once.
+ * ============================================================================ */
+
+static inline void rx_draw_push(uint8_t kind, NxRect rect, NxRect bounds,
+                                NxColor color, float radius, const char* text) {
+    RxDrawList* dl = &rx_bridge->draw_list;
+    if (dl->count >= dl->capacity) {
+        size_t cap = dl->capacity ? dl->capacity * 2 : 256;
+        NxDrawCmd* cmds = (NxDrawCmd*)realloc(dl->cmds, sizeof(NxDrawCmd) * cap);
+        if (cmds) dl->cmds = cmds;
+        NxRect* b = (NxRect*)realloc(dl->bounds, sizeof(NxRect) * cap);
+        if (b) dl->bounds = b;
+        uint32_t* batch_of = (uint32_t*)realloc(dl->batch_of, sizeof(uint32_t) * cap);
+        if (batch_of) dl->batch_of = batch_of;
+        if (!cmds || !b || !batch_of) return;
+        dl->capacity = cap;
+    }
+    dl->cmds[dl->count] = (NxDrawCmd){ kind, color, radius, rect, text };
+    dl->bounds[dl->count] = bounds;
+    dl->count++;
+}
+
+static inline void rx_draw_rect(NxRect rect, NxColor color) {
+    rx_draw_push(NX_DRAW_FILL_RECT, rect, rect, color, 0, NULL);
+}
+
+static inline void rx_draw_rounded_rect(NxRect rect, NxColor color, float radius) {
+    rx_draw_push(NX_DRAW_FILL_ROUNDED_RECT, rect, rect, color, radius, NULL);
+}
+
+static inline void rx_draw_circle(float x, float y, float radius, NxColor color) {
+    NxRect r = { x - radius, y - radius, radius * 2, radius * 2 };
+    rx_draw_push(NX_DRAW_FILL_CIRCLE, r, r, color, radius, NULL);
+}
+
+static inline void rx_draw_text(const char* text, float x, float y, NxColor color) {
+    /* Upper bound of the ink around the baseline; see RX_TEXT_MAX_ADVANCE */
+    NxRect bounds = { x, y - rx_bridge->text_ascent,
+                      rx_bridge->text_advance * (float)strlen(text),
+                      rx_bridge->text_ascent + rx_bridge->text_descent };
+    rx_draw_push(NX_DRAW_TEXT, (NxRect){ x, y, 0, 0 }, bounds, color, 0, text);
+}
+
+static inline void rx_draw_set_clip(NxRect rect) {
+    rx_draw_push(NX_DRAW_SET_CLIP, rect, rect, (NxColor){0, 0, 0, 0}, 0, NULL);
+}
+
+static inline void rx_draw_reset_clip(void) {
+    NxRect none = { 0, 0, 0, 0 };
+    rx_draw_push(NX_DRAW_RESET_CLIP, none, none, (NxColor){0, 0, 0, 0}, 0, NULL);
+}
+
+static inline bool rx_draw_is_barrier(uint8_t kind) {
+    return kind == NX_DRAW_SET_CLIP || kind == NX_DRAW_RESET_CLIP;
+}
+
+/* Assign each command to a batch. A command joins the earliest same-kind
+ * batch it can reach without passing an overlapping draw; clip changes
+ * are barriers nothing moves across. */
+static inline bool rx_draw_list_batch(RxDrawList* dl) {
+    dl->batch_count = 0;
+    size_t floor = 0;  /* First batch after the last barrier */
+    
+    for (size_t i = 0; i < dl->count; i++) {
+        uint8_t kind = dl->cmds[i].kind;
+        NxRect b = dl->bounds[i];
+        size_t target = SIZE_MAX;
+        
+        if (!rx_draw_is_barrier(kind)) {
+            size_t lowest = dl->batch_count > floor + RX_DRAW_LOOKBACK
+                          ? dl->batch_count - RX_DRAW_LOOKBACK : floor;
+            for (size_t k = dl->batch_count; k > lowest; k--) {
+                RxDrawBatch* batch = &dl->batches[k - 1];
+                bool overlaps = rx_rect_intersects(batch->bounds, b);
+                if (batch->kind == kind) target = k - 1;
+                if (overlaps) break;
+            }
+        }
+        
+        if (target == SIZE_MAX) {
+            if (dl->batch_count >= dl->batch_capacity) {
+                size_t cap = dl->batch_capacity ? dl->batch_capacity * 2 : 32;
+                RxDrawBatch* batches = (RxDrawBatch*)realloc(dl->batches, sizeof(RxDrawBatch) * cap);
+                if (!batches) return false;
+                dl->batches = batches;
+                dl->batch_capacity = cap;
+            }
+            target = dl->batch_count++;
+            dl->batches[target] = (RxDrawBatch){ kind, b, 0 };
+            if (rx_draw_is_barrier(kind)) floor = dl->batch_count;
+        } else {
+            dl->batches[target].bounds = rx_rect_union(dl->batches[target].bounds, b);
+        }
+        dl->batches[target].count++;
+        dl->batch_of[i] = (uint32_t)target;
+    }
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+ * Display-list cache
+ * ---------------------------------------------------------------------------- */
+
+/* Drop every cached display list, e.g. after layout or a theme change */
+static inline void rx_display_cache_flush(void) {
+    if (rx_bridge) rx_bridge->cache_epoch++;
+}
+
+static inline bool rx_display_list_usable(const RxNode* node) {
+    const RxDisplayList* cache = node->display_list;
+    return cache && cache->valid && cache->epoch == rx_bridge->cache_epoch;
+}
+
+/* Keep commands [start, end of list) as node's display list */
+static inline void rx_display_list_store(RxNode* node, size_t start) {
+    RxDrawList* dl = &rx_bridge->draw_list;
+    uint32_t n = (uint32_t)(dl->count - start);
+    if (!(node->state & RX_STATE_CACHE) && n < RX_CACHE_MIN_CMDS) return;
+    
+    RxDisplayList* cache = node->display_list;
+    if (!cache) {
+        cache = (RxDisplayList*)calloc(1, sizeof(RxDisplayList));
+        if (!cache) return;
+        node->display_list = cache;
+    }
+    if (n > cache->capacity) {
+        NxDrawCmd* cmds = (NxDrawCmd*)realloc(cache->cmds, sizeof(NxDrawCmd) * n);
+        if (cmds) cache->cmds = cmds;
+        NxRect* bounds = (NxRect*)realloc(cache->bounds, sizeof(NxRect) * n);
+        if (bounds) cache->bounds = bounds;
+        if (!cmds || !bounds) {
+            cache->valid = false;
+            return;
+        }
+        cache->capacity = n;
+    }
+    memcpy(cache->cmds, dl->cmds + start, sizeof(NxDrawCmd) * n);
+    memcpy(cache->bounds, dl->bounds + start, sizeof(NxRect) * n);
+    cache->count = n;
+    cache->epoch = rx_bridge->cache_epoch;
+    cache->valid = true;
+}
+
+static inline void rx_display_list_replay(const RxDisplayList* cache) {
+    for (uint32_t i = 0; i < cache->count; i++) {
+        const NxDrawCmd* c = &cache->cmds[i];
+        rx_draw_push(c->kind, c->rect, cache->bounds[i], c->color, c->radius, c->text);
+    }
+}
+
+#ifndef RX_DRAW_BATCHED
+/* One per-shape call per command, for NXRender builds without nx_gpu_submit */
+static inline void rx_draw_list_replay(const NxDrawCmd* cmds, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const NxDrawCmd* c = &cmds[i];
+        switch (c->kind) {
+            case NX_DRAW_FILL_RECT:
+                nx_gpu_fill_rect(rx_bridge->gpu, c->rect, c->color);
+                break;
+            case NX_DRAW_FILL_ROUNDED_RECT:
+                nx_gpu_fill_rounded_rect(rx_bridge->gpu, c->rect, c->color, c->radius);
+                break;
+            case NX_DRAW_FILL_CIRCLE:
+                nx_gpu_fill_circle(rx_bridge->gpu, c->rect.x + c->radius, c->rect.y + c->radius,
+                                   c->radius, c->color);
+                break;
+            case NX_DRAW_TEXT:
+                nx_gpu_draw_text(rx_bridge->gpu, c->text, c->rect.x, c->rect.y, c->color);
+                break;
+            case NX_DRAW_SET_CLIP:
+                nx_gpu_set_clip(rx_bridge->gpu, c->rect);
+                break;
+            case NX_DRAW_RESET_CLIP:
+                nx_gpu_reset_clip(rx_bridge->gpu);
+                break;
+        }
+    }
+}
+#endif
+
+/* Emit the frame's commands in batch order and reset the list */
+static inline void rx_draw_list_submit(void) {
+    RxDrawList* dl = &rx_bridge->draw_list;
+    if (dl->count == 0) return;
+    RX_FRAME_COUNT(RX_COUNTER_DRAW_CALLS, dl->count);
+    
+    const NxDrawCmd* out = dl->cmds;
+    if (dl->sorted_capacity < dl->count) {
+        NxDrawCmd* sorted = (NxDrawCmd*)realloc(dl->sorted, sizeof(NxDrawCmd) * dl->capacity);
+        if (sorted) {
+            dl->sorted = sorted;
+            dl->sorted_capacity = dl->capacity;
+        }
+    }
+    
+    /* Counting sort by batch; on failure submit in recorded order */
+    if (dl->sorted_capacity >= dl->count && rx_draw_list_batch(dl)) {
+        uint32_t offset = 0;
+        for (size_t k = 0; k < dl->batch_count; k++) {
+            uint32_t n = dl->batches[k].count;
+            dl->batches[k].count = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < dl->count; i++) {
+            dl->sorted[dl->batches[dl->batch_of[i]].count++] = dl->cmds[i];
+        }
+        out = dl->sorted;
+    }
+    
+#ifdef RX_DRAW_BATCHED
+    nx_gpu_submit(rx_bridge->gpu, out, (uint32_t)dl->count);
+#else
+    rx_draw_list_replay(out, dl->count);
+#endif
+    dl->count = 0;
+}
+
 /* ============================================================================
  * Rendering
  * ============================================================================ */
 
-static inline void rx_render_node(RxNode* node) {
+static inline void rx_render_node_clipped(RxNode* node, const NxRect* clip) {
     if (!node || !rx_bridge || (node->state & RX_STATE_HIDDEN)) return;
     
     NxRect rect = { node->x, node->y, node->width, node->height };
     
+    /* Children lie inside their parent, so a miss prunes the subtree */
+    if (clip && !rx_rect_intersects(rect, *clip)) return;
+    
+    /* Unchanged subtree: replay what it drew last time */
+    if (rx_display_list_usable(node)) {
+        rx_display_list_replay(node->display_list);
+        return;
+    }
+    
+    /* Only a complete, unclipped pass may be recorded */
+    bool whole = !clip ||
+        (rect.x >= clip->x && rect.y >= clip->y &&
+         rect.x + rect.width <= clip->x + clip->width &&
+         rect.y + rect.height <= clip->y + clip->height);
+    bool record = whole && node->first_child &&
+        ((node->state & RX_STATE_CACHE) || node->stable_frames >= RX_CACHE_STABLE_FRAMES);
+    size_t record_start = rx_bridge->draw_list.count;
+    if (node->stable_frames < UINT16_MAX) node->stable_frames++;
+    
+    node->painted = rect;
+    node->state &= ~RX_STATE_DIRTY;
+    
     /* Draw background */
     if (node->background.a > 0) {
         if (node->corner_radius > 0) {
-            nx_gpu_fill_rounded_rect(rx_bridge->gpu, rect, node->background, node->corner_radius);
+            rx_draw_rounded_rect(rect, node->background, node->corner_radius);
         } else {
-            nx_gpu_fill_rect(rx_bridge->gpu, rect, node->background);
+            rx_draw_rect(rect, node->background);
         }
     }
     
@@ -348,14 +901,14 @@ static inline void rx_render_node(RxNode* node) {
                         btn_bg.g = btn_bg.g < 230 ? btn_bg.g + 25 : 255;
                         btn_bg.b = btn_bg.b < 230 ? btn_bg.b + 25 : 255;
                     }
-                    nx_gpu_fill_rounded_rect(rx_bridge->gpu, rect, btn_bg, 6.0f);
+                    rx_draw_rounded_rect(rect, btn_bg, 6.0f);
                     text_color = (NxColor){255, 255, 255, 255};
                 }
                 
                 /* Center text (approximate) */
                 float tx = node->x + node->width / 2 - 4 * strlen(node->text);
                 float ty = node->y + node->height / 2 + 5;
-                nx_gpu_draw_text(rx_bridge->gpu, node->text, tx, ty, text_color);
+                rx_draw_text(node->text, tx, ty, text_color);
             }
             break;
             
@@ -364,10 +917,10 @@ static inline void rx_render_node(RxNode* node) {
             NxColor box_color = node->value > 0.5 ? 
                 nx_theme_get_primary_color(rx_bridge->theme) : 
                 (NxColor){60, 60, 62, 255};
-            nx_gpu_fill_rounded_rect(rx_bridge->gpu, box, box_color, 4);
+            rx_draw_rounded_rect(box, box_color, 4);
             
             if (node->text) {
-                nx_gpu_draw_text(rx_bridge->gpu, node->text, 
+                rx_draw_text(node->text, 
                     node->x + 32, node->y + node->height / 2 + 5, node->foreground);
             }
             break;
@@ -376,22 +929,22 @@ static inline void rx_render_node(RxNode* node) {
         case RX_NODE_SLIDER: {
             /* Track */
             NxRect track = { node->x + 8, node->y + node->height / 2 - 2, node->width - 16, 4 };
-            nx_gpu_fill_rounded_rect(rx_bridge->gpu, track, (NxColor){60, 60, 62, 255}, 2);
+            rx_draw_rounded_rect(track, (NxColor){60, 60, 62, 255}, 2);
             
             /* Fill */
             float fill_w = (node->width - 16) * node->value;
             NxRect fill = { node->x + 8, node->y + node->height / 2 - 2, fill_w, 4 };
-            nx_gpu_fill_rounded_rect(rx_bridge->gpu, fill, nx_theme_get_primary_color(rx_bridge->theme), 2);
+            rx_draw_rounded_rect(fill, nx_theme_get_primary_color(rx_bridge->theme), 2);
             
             /* Thumb */
             float thumb_x = node->x + 8 + fill_w;
-            nx_gpu_fill_circle(rx_bridge->gpu, thumb_x, node->y + node->height / 2, 8, (NxColor){255, 255, 255, 255});
+            rx_draw_circle(thumb_x, node->y + node->height / 2, 8, (NxColor){255, 255, 255, 255});
             break;
         }
         
         case RX_NODE_DIVIDER: {
             NxRect line = { node->x, node->y + node->height / 2, node->width, 1 };
-            nx_gpu_fill_rect(rx_bridge->gpu, line, (NxColor){60, 60, 62, 255});
+            rx_draw_rect(line, (NxColor){60, 60, 62, 255});
             break;
         }
         
@@ -402,7 +955,61 @@ static inline void rx_render_node(RxNode* node) {
     /* Render children */
     RxNode* child = node->first_child;
     while (child) {
-        rx_render_node(child);
+        rx_render_node_clipped(child, clip);
+        child = child->next_sibling;
+    }
+    
+    if (record) rx_display_list_store(node, record_start);
+}
+
+static inline void rx_render_node(RxNode* node) {
+    rx_render_node_clipped(node, NULL);
+}
+
+/* ============================================================================
+ * State Invalidation
+ * Mark nodes dirty when state changes
+ * ============================================================================ */
+
+/* Queue node for partial repaint. Its damage (old painted bounds plus
+ * current bounds) is taken at the next frame, so bounds may still change
+ * after this call. */
+static inline void rx_invalidate(RxNode* node) {
+    if (!node) return;
+    node->state |= RX_STATE_DIRTY;
+    if (!rx_bridge) return;
+    
+    rx_display_list_invalidate_path(node);
+    
+    /* Moved, resized, shown or hidden: the hit grid is stale */
+    bool hidden = (node->state & RX_STATE_HIDDEN) != 0;
+    if (hidden != node->indexed_hidden ||
+        node->x != node->indexed.x || node->y != node->indexed.y ||
+        node->width != node->indexed.width || node->height != node->indexed.height) {
+        rx_bridge->hit_dirty = true;
+    }
+    if (node->state & RX_STATE_DAMAGED) return;
+    
+    if (rx_bridge->damaged_count >= rx_bridge->damaged_capacity) {
+        size_t cap = rx_bridge->damaged_capacity ? rx_bridge->damaged_capacity * 2 : 16;
+        RxNode** nodes = (RxNode**)realloc(rx_bridge->damaged_nodes, sizeof(RxNode*) * cap);
+        if (!nodes) {
+            rx_bridge->needs_redraw = true;  /* Fall back to a full repaint */
+            return;
+        }
+        rx_bridge->damaged_nodes = nodes;
+        rx_bridge->damaged_capacity = cap;
+    }
+    node->state |= RX_STATE_DAMAGED;
+    rx_bridge->damaged_nodes[rx_bridge->damaged_count++] = node;
+}
+
+static inline void rx_invalidate_tree(RxNode* node) {
+    if (!node) return;
+    rx_invalidate(node);
+    RxNode* child = node->first_child;
+    while (child) {
+        rx_invalidate_tree(child);
         child = child->next_sibling;
     }
 }
@@ -443,51 +1050,209 @@ static inline RxNode* rx_hit_test(RxNode* node, float x, float y) {
     return NULL;
 }
 
-static inline void rx_handle_mouse_move(float x, float y) {
-    if (!rx_bridge || !rx_bridge->root) return;
+static inline bool rx_node_interactive(const RxNode* node) {
+    return node->type == RX_NODE_BUTTON ||
+           node->type == RX_NODE_CHECKBOX ||
+           node->type == RX_NODE_SLIDER ||
+           node->type == RX_NODE_TEXTFIELD;
+}
+
+static inline NxRect rx_rect_intersect(NxRect a, NxRect b) {
+    float x0 = a.x > b.x ? a.x : b.x;
+    float y0 = a.y > b.y ? a.y : b.y;
+    float x1 = a.x + a.width < b.x + b.width ? a.x + a.width : b.x + b.width;
+    float y1 = a.y + a.height < b.y + b.height ? a.y + a.height : b.y + b.height;
+    return (NxRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+static inline void rx_hit_collect(RxNode* node, NxRect clip, uint32_t* order) {
+    bool hidden = (node->state & RX_STATE_HIDDEN) != 0;
+    node->indexed = (NxRect){ node->x, node->y, node->width, node->height };
+    node->indexed_hidden = hidden;
+    if (hidden) return;
+    
+    clip = rx_rect_intersect(clip, node->indexed);
+    if (rx_rect_empty(clip)) return;  /* Nothing below can be hit */
+    
+    uint32_t my_order = (*order)++;
+    if (rx_node_interactive(node)) {
+        if (rx_bridge->hit_count >= rx_bridge->hit_capacity) {
+            size_t cap = rx_bridge->hit_capacity ? rx_bridge->hit_capacity * 2 : 64;
+            RxHitEntry* entries = (RxHitEntry*)realloc(rx_bridge->hit_entries, sizeof(RxHitEntry) * cap);
+            if (!entries) return;
+            rx_bridge->hit_entries = entries;
+            rx_bridge->hit_capacity = cap;
+        }
+        rx_bridge->hit_entries[rx_bridge->hit_count++] = (RxHitEntry){ node, clip, my_order };
+    }
+    
+    for (RxNode* child = node->first_child; child; child = child->next_sibling) {
+        rx_hit_collect(child, clip, order);
+    }
+}
+
+static inline void rx_hit_cell_range(NxRect r, int* c0, int* r0, int* c1, int* r1) {
+    NxRect area = rx_bridge->hit_area;
+    float cw = area.width / rx_bridge->hit_cols;
+    float ch = area.height / rx_bridge->hit_rows;
+    *c0 = (int)((r.x - area.x) / cw);
+    *r0 = (int)((r.y - area.y) / ch);
+    *c1 = (int)((r.x + r.width - area.x) / cw);
+    *r1 = (int)((r.y + r.height - area.y) / ch);
+    if (*c0 < 0) *c0 = 0;
+    if (*r0 < 0) *r0 = 0;
+    if (*c1 >= rx_bridge->hit_cols) *c1 = rx_bridge->hit_cols - 1;
+    if (*r1 >= rx_bridge->hit_rows) *r1 = rx_bridge->hit_rows - 1;
+}
+
+/* Rebuild the uniform grid of interactive nodes over the root's bounds */
+static inline void rx_hit_index_rebuild(void) {
+    RxNode* root = rx_bridge->root;
+    rx_bridge->hit_dirty = false;
+    rx_bridge->hit_count = 0;
+    rx_bridge->hit_cols = rx_bridge->hit_rows = 0;
+    if (!root) return;
+    
+    NxRect area = { root->x, root->y, root->width, root->height };
+    uint32_t order = 0;
+    rx_hit_collect(root, area, &order);
+    if (rx_rect_empty(area)) return;
+    
+    int cols = (int)(area.width / RX_HIT_CELL) + 1;
+    int rows = (int)(area.height / RX_HIT_CELL) + 1;
+    if (cols > RX_HIT_MAX_CELLS) cols = RX_HIT_MAX_CELLS;
+    if (rows > RX_HIT_MAX_CELLS) rows = RX_HIT_MAX_CELLS;
+    size_t cells = (size_t)cols * rows;
+    
+    if (cells + 1 > rx_bridge->hit_start_capacity) {
+        uint32_t* start = (uint32_t*)realloc(rx_bridge->hit_cell_start, sizeof(uint32_t) * (cells + 1));
+        if (!start) return;
+        rx_bridge->hit_cell_start = start;
+        rx_bridge->hit_start_capacity = cells + 1;
+    }
+    rx_bridge->hit_area = area;
+    rx_bridge->hit_cols = cols;
+    rx_bridge->hit_rows = rows;
+    
+    /* Count entries per cell, prefix-sum, then fill */
+    uint32_t* start = rx_bridge->hit_cell_start;
+    memset(start, 0, sizeof(uint32_t) * (cells + 1));
+    int c0, r0, c1, r1;
+    for (size_t i = 0; i < rx_bridge->hit_count; i++) {
+        rx_hit_cell_range(rx_bridge->hit_entries[i].rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++) start[r * cols + c + 1]++;
+    }
+    for (size_t c = 0; c < cells; c++) start[c + 1] += start[c];
+    
+    size_t total = start[cells];
+    if (total > rx_bridge->hit_cells_capacity) {
+        uint32_t* list = (uint32_t*)realloc(rx_bridge->hit_cells, sizeof(uint32_t) * total);
+        if (!list) {
+            rx_bridge->hit_cols = rx_bridge->hit_rows = 0;
+            return;
+        }
+        rx_bridge->hit_cells = list;
+        rx_bridge->hit_cells_capacity = total;
+    }
+    
+    /* start[c] doubles as the fill cursor, then is shifted back */
+    for (size_t i = 0; i < rx_bridge->hit_count; i++) {
+        rx_hit_cell_range(rx_bridge->hit_entries[i].rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++) rx_bridge->hit_cells[start[r * cols + c]++] = (uint32_t)i;
+    }
+    for (size_t c = cells; c > 0; c--) start[c] = start[c - 1];
+    start[0] = 0;
+}
+
+/* Same result as rx_hit_test(root, x, y), answered from the grid */
+static inline RxNode* rx_hit_test_indexed(float x, float y) {
+    if (!rx_bridge || !rx_bridge->root) return NULL;
+    if (rx_bridge->hit_dirty) rx_hit_index_rebuild();
+    if (rx_bridge->hit_cols == 0) return NULL;
     
+    NxRect area = rx_bridge->hit_area;
+    if (x < area.x || y < area.y || x >= area.x + area.width || y >= area.y + area.height) {
+        return NULL;
+    }
+    int col = (int)((x - area.x) / (area.width / rx_bridge->hit_cols));
+    int row = (int)((y - area.y) / (area.height / rx_bridge->hit_rows));
+    if (col >= rx_bridge->hit_cols) col = rx_bridge->hit_cols - 1;
+    if (row >= rx_bridge->hit_rows) row = rx_bridge->hit_rows - 1;
+    
+    size_t cell = (size_t)row * rx_bridge->hit_cols + col;
+    RxHitEntry* best = NULL;
+    for (uint32_t i = rx_bridge->hit_cell_start[cell]; i < rx_bridge->hit_cell_start[cell + 1]; i++) {
+        RxHitEntry* e = &rx_bridge->hit_entries[rx_bridge->hit_cells[i]];
+        if (x >= e->rect.x && x < e->rect.x + e->rect.width &&
+            y >= e->rect.y && y < e->rect.y + e->rect.height &&
+            (!best || e->order > best->order)) {
+            best = e;
+        }
+    }
+    return best ? best->node : NULL;
+}
+
+/* Resolve hover for the latest pointer position */
+static inline void rx_flush_mouse_move(void) {
+    if (!rx_bridge || !rx_bridge->mouse_move_pending) return;
+    rx_bridge->mouse_move_pending = false;
+    
+    float x = rx_bridge->mouse_x, y = rx_bridge->mouse_y;
     nx_mouse_move(rx_bridge->mouse, x, y);
     
-    RxNode* hit = rx_hit_test(rx_bridge->root, x, y);
+    RxNode* hit = rx_hit_test_indexed(x, y);
     
     /* Update hover state */
     if (rx_bridge->hovered != hit) {
         if (rx_bridge->hovered) {
             rx_bridge->hovered->state &= ~RX_STATE_HOVERED;
-            rx_bridge->hovered->state |= RX_STATE_DIRTY;
+            rx_invalidate(rx_bridge->hovered);
         }
         if (hit) {
-            hit->state |= RX_STATE_HOVERED | RX_STATE_DIRTY;
+            hit->state |= RX_STATE_HOVERED;
+            rx_invalidate(hit);
         }
         rx_bridge->hovered = hit;
-        rx_bridge->needs_redraw = true;
     }
 }
 
+/* Motion is coalesced: only the last position before a frame, button
+ * event or explicit flush is hit-tested. */
+static inline void rx_handle_mouse_move(float x, float y) {
+    if (!rx_bridge || !rx_bridge->root) return;
+    rx_bridge->mouse_x = x;
+    rx_bridge->mouse_y = y;
+    rx_bridge->mouse_move_pending = true;
+}
+
 static inline void rx_handle_mouse_down(float x, float y) {
     if (!rx_bridge || !rx_bridge->root) return;
     
+    rx_flush_mouse_move();
     nx_mouse_button_down(rx_bridge->mouse, x, y, NX_MOUSE_LEFT);
     
-    RxNode* hit = rx_hit_test(rx_bridge->root, x, y);
+    RxNode* hit = rx_hit_test_indexed(x, y);
     if (hit) {
-        hit->state |= RX_STATE_PRESSED | RX_STATE_DIRTY;
+        hit->state |= RX_STATE_PRESSED;
         rx_bridge->focused = hit;
-        rx_bridge->needs_redraw = true;
+        rx_invalidate(hit);
     }
 }
 
 static inline void rx_handle_mouse_up(float x, float y) {
     if (!rx_bridge || !rx_bridge->root) return;
     
+    rx_flush_mouse_move();
     nx_mouse_button_up(rx_bridge->mouse, x, y, NX_MOUSE_LEFT);
     
-    RxNode* hit = rx_hit_test(rx_bridge->root, x, y);
+    RxNode* hit = rx_hit_test_indexed(x, y);
     
     /* Trigger click if released on same node that was pressed */
     if (rx_bridge->focused && (rx_bridge->focused->state & RX_STATE_PRESSED)) {
         rx_bridge->focused->state &= ~RX_STATE_PRESSED;
-        rx_bridge->focused->state |= RX_STATE_DIRTY;
+        rx_invalidate(rx_bridge->focused);
         
         if (hit == rx_bridge->focused) {
             /* Click! */
@@ -501,8 +1266,65 @@ static inline void rx_handle_mouse_up(float x, float y) {
                 rx_bridge->focused->on_click(rx_bridge->focused);
             }
         }
-        
-        rx_bridge->needs_redraw = true;
+    }
+}
+
+/* ============================================================================
+ * Frame Stats Overlay
+ * ============================================================================ */
+
+#define RX_STATS_OVERLAY_FRAMES 60      /* Averaged, and bars in the graph */
+#define RX_STATS_OVERLAY_LINE 16
+#define RX_STATS_OVERLAY_GRAPH 40
+#define RX_STATS_OVERLAY_BUDGET_NS 33333333ULL  /* Graph full height: two 60 Hz frames */
+
+static inline bool rx_stats_overlay_visible(void) {
+    return rx_frame_live.overlay && rx_frame_live.enabled;
+}
+
+static inline NxRect rx_stats_overlay_rect(void) {
+    int lines = 1 + RX_PHASE_COUNT + RX_COUNTER_COUNT;
+    return (NxRect){ 8, 8, 3 * RX_STATS_OVERLAY_FRAMES + 16,
+                     (float)(lines * RX_STATS_OVERLAY_LINE + RX_STATS_OVERLAY_GRAPH + 16) };
+}
+
+static inline void rx_stats_overlay_line(float x, float* y, const char* text) {
+    if (text) rx_draw_text(text, x, *y, (NxColor){ 230, 230, 230, 255 });
+    *y += RX_STATS_OVERLAY_LINE;
+}
+
+/* Drawn last so it sits above the UI; strings live in the frame arena,
+ * which outlives the submit */
+static inline void rx_stats_overlay_draw(void) {
+    rx_frame_record mean, worst;
+    uint32_t n = rx_frame_stats_summary(RX_STATS_OVERLAY_FRAMES, &mean, &worst);
+    NxRect panel = rx_stats_overlay_rect();
+    rx_draw_rect(panel, (NxColor){ 0, 0, 0, 190 });
+    if (n == 0) return;
+    
+    float x = panel.x + 8;
+    float y = panel.y + 8 + RX_STATS_OVERLAY_LINE;
+    rx_stats_overlay_line(x, &y, rx_frame_printf("%.2f ms  (worst %.2f)",
+                                                 mean.total_ns * 1e-6, worst.total_ns * 1e-6));
+    for (int p = 0; p < RX_PHASE_COUNT; p++) {
+        rx_stats_overlay_line(x, &y, rx_frame_printf("%-10s %6.2f", rx_frame_phase_name((rx_frame_phase)p),
+                                                     mean.phase_ns[p] * 1e-6));
+    }
+    for (int c = 0; c < RX_COUNTER_COUNT; c++) {
+        rx_stats_overlay_line(x, &y, rx_frame_printf("%-14s %5llu", rx_frame_counter_name((rx_frame_counter)c),
+                                                     (unsigned long long)mean.counters[c]));
+    }
+    
+    /* Oldest frame on the left; red past one 60 Hz frame */
+    float base = panel.y + panel.height - 8;
+    for (uint32_t i = 0; i < n; i++) {
+        rx_frame_record r;
+        if (!rx_frame_stats_get(n - 1 - i, &r)) break;
+        uint64_t ns = r.total_ns < RX_STATS_OVERLAY_BUDGET_NS ? r.total_ns : RX_STATS_OVERLAY_BUDGET_NS;
+        float h = (float)ns / RX_STATS_OVERLAY_BUDGET_NS * RX_STATS_OVERLAY_GRAPH;
+        NxColor color = r.total_ns > RX_STATS_OVERLAY_BUDGET_NS / 2
+            ? (NxColor){ 230, 80, 70, 255 } : (NxColor){ 90, 200, 120, 255 };
+        rx_draw_rect((NxRect){ x + 3.0f * i, base - h, 2, h }, color);
     }
 }
 
@@ -512,45 +1334,69 @@ static inline void rx_handle_mouse_up(float x, float y) {
 
 static inline void rx_frame(void) {
     if (!rx_bridge) return;
+    RX_FRAME_BEGIN();
+    
+    /* Registered per-frame work, e.g. state writes posted from workers */
+    rx_frame_run_hooks();
     
-    /* Layout if needed */
+    /* Layout if needed; it can move anything, so repaint everything */
     if (rx_bridge->root && (rx_bridge->root->state & RX_STATE_DIRTY)) {
+        RX_ZONE_BEGIN(RX_PHASE_LAYOUT);
         rx_layout_node(rx_bridge->root, rx_bridge->root->width, rx_bridge->root->height);
+        RX_ZONE_END(RX_PHASE_LAYOUT);
+        rx_bridge->needs_redraw = true;
+        rx_bridge->hit_dirty = true;
+        rx_display_cache_flush();
     }
     
-    /* Render if needed */
+    /* Hover sees the post-layout tree */
+    rx_flush_mouse_move();
+    
+    rx_damage_collect();
+    bool overlay = rx_stats_overlay_visible();
+    if (overlay) rx_damage_add(rx_stats_overlay_rect());
+    NxColor bg = nx_theme_get_background_color(rx_bridge->theme);
+    
     if (rx_bridge->needs_redraw) {
-        NxColor bg = nx_theme_get_background_color(rx_bridge->theme);
         nx_gpu_clear(rx_bridge->gpu, bg);
         
+        RX_ZONE_BEGIN(RX_PHASE_RENDER);
         if (rx_bridge->root) {
             rx_render_node(rx_bridge->root);
         }
+        if (overlay) rx_stats_overlay_draw();
+        RX_ZONE_END(RX_PHASE_RENDER);
         
+        RX_ZONE_BEGIN(RX_PHASE_PRESENT);
+        rx_draw_list_submit();
         nx_gpu_present(rx_bridge->gpu);
+        RX_ZONE_END(RX_PHASE_PRESENT);
         rx_bridge->needs_redraw = false;
+    } else if (rx_bridge->damage_count > 0) {
+        /* Repaint only the damaged rects, each under its own clip */
+        RX_ZONE_BEGIN(RX_PHASE_RENDER);
+        for (int i = 0; i < rx_bridge->damage_count; i++) {
+            NxRect r = rx_bridge->damage[i];
+            rx_draw_set_clip(r);
+            rx_draw_rect(r, bg);
+            if (rx_bridge->root) {
+                rx_render_node_clipped(rx_bridge->root, &r);
+            }
+        }
+        rx_draw_reset_clip();
+        if (overlay) rx_stats_overlay_draw();
+        RX_ZONE_END(RX_PHASE_RENDER);
+        
+        RX_ZONE_BEGIN(RX_PHASE_PRESENT);
+        rx_draw_list_submit();
+        nx_gpu_present(rx_bridge->gpu);
+        RX_ZONE_END(RX_PHASE_PRESENT);
     }
-}
-
-/* ============================================================================
- * State Invalidation
- * Mark nodes dirty when state changes
- * ============================================================================ */
-
-static inline void rx_invalidate(RxNode* node) {
-    if (!node) return;
-    node->state |= RX_STATE_DIRTY;
-    if (rx_bridge) rx_bridge->needs_redraw = true;
-}
-
-static inline void rx_invalidate_tree(RxNode* node) {
-    if (!node) return;
-    rx_invalidate(node);
-    RxNode* child = node->first_child;
-    while (child) {
-        rx_invalidate_tree(child);
-        child = child->next_sibling;
-    }
+    rx_bridge->damage_count = 0;
+    
+    /* Frame scratch dies with the frame */
+    rx_frame_arena_reset();
+    RX_FRAME_END();
 }
 
 #ifdef __cplusplus
@@ -245,8 +245,7 @@ static inline void nx_widget_set_bounds_rx(int64_t handle, int64_t x, int64_t y,
 static inline void nx_button_set_label_rx(int64_t handle, const char* label) {
     RxNode* btn = (RxNode*)(uintptr_t)handle;
     if (btn) {
-        if (btn->text) free(btn->text);
-        btn->text = label ? strdup(label) : NULL;
+        rx_node_set_text(btn, label);
         rx_invalidate(btn);
     }
 }
@@ -255,8 +254,7 @@ static inline void nx_button_set_label_rx(int64_t handle, const char* label) {
 static inline void nx_label_set_text_rx(int64_t handle, const char* text) {
     RxNode* label = (RxNode*)(uintptr_t)handle;
     if (label) {
-        if (label->text) free(label->text);
-        label->text = text ? strdup(text) : NULL;
+        rx_node_set_text(label, text);
         rx_invalidate(label);
     }
 }
@@ -312,6 +310,7 @@ static inline void nx_theme_set_rx(int64_t theme) {
     }
     rx_bridge->theme = (theme == 1) ? nx_theme_light() : nx_theme_dark();
     rx_bridge->needs_redraw = true;
+    rx_display_cache_flush();  /* Cached draws carry old theme colors */
 }
 
 /* nx_theme_get() -> int */
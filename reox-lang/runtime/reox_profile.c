@@ -0,0 +1,213 @@
+/*
+ * REOX Profiler - Implementation
+ * Site registry, per-thread buffers and report writers
+ */
+
+#include "reox_profile.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+_Thread_local rx_prof_thread* rx_prof_tls;
+
+static pthread_mutex_t prof_lock = PTHREAD_MUTEX_INITIALIZER;
+static const rx_prof_site* prof_sites[RX_PROF_MAX_SITES];
+static uint32_t prof_site_count;
+static rx_prof_thread* prof_threads;
+static uint32_t prof_next_tid = 1;
+
+/* Tick and clock readings taken together, to convert ticks to time */
+static uint64_t prof_origin_ticks;
+static uint64_t prof_origin_ns;
+
+static uint64_t prof_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Lock held */
+static void prof_set_origin(void) {
+    if (prof_origin_ns) return;
+    prof_origin_ns = prof_clock_ns();
+    prof_origin_ticks = rx_prof_ticks();
+}
+
+/* Nanoseconds per tick, measured from the origin to now */
+static double prof_ns_per_tick(void) {
+    uint64_t ns = prof_clock_ns();
+    uint64_t ticks = rx_prof_ticks();
+    if (ticks <= prof_origin_ticks || ns <= prof_origin_ns) return 1.0;
+    return (double)(ns - prof_origin_ns) / (double)(ticks - prof_origin_ticks);
+}
+
+/* ============================================================================
+ * Registration
+ * ============================================================================ */
+
+uint32_t rx_prof_register(const rx_prof_site* sites, uint32_t count) {
+    pthread_mutex_lock(&prof_lock);
+    prof_set_origin();
+    uint32_t base = prof_site_count;
+    if (base + count > RX_PROF_MAX_SITES) {
+        /* Ids wrap, so the excess shares slots with earlier sites */
+        fprintf(stderr, "reox profile: more than %d sites, some totals merged\n",
+                RX_PROF_MAX_SITES);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        prof_sites[(base + i) & (RX_PROF_MAX_SITES - 1)] = &sites[i];
+    }
+    prof_site_count = base + count;
+    pthread_mutex_unlock(&prof_lock);
+    return base;
+}
+
+rx_prof_thread* rx_prof_thread_init(void) {
+    rx_prof_thread* t = calloc(1, sizeof(rx_prof_thread));
+    rx_prof_event* ring = calloc(RX_PROF_RING_EVENTS, sizeof(rx_prof_event));
+    if (!t || !ring) {
+        fprintf(stderr, "reox profile: out of memory\n");
+        abort();
+    }
+    t->ring = ring;
+
+    /* Kept on the list after the thread exits so its data is reported */
+    pthread_mutex_lock(&prof_lock);
+    prof_set_origin();
+    t->tid = prof_next_tid++;
+    t->next = prof_threads;
+    prof_threads = t;
+    pthread_mutex_unlock(&prof_lock);
+
+    rx_prof_tls = t;
+    return t;
+}
+
+void rx_prof_reset(void) {
+    pthread_mutex_lock(&prof_lock);
+    for (rx_prof_thread* t = prof_threads; t; t = t->next) {
+        memset(t->stats, 0, sizeof(t->stats));
+        t->head = 0;
+    }
+    pthread_mutex_unlock(&prof_lock);
+}
+
+/* ============================================================================
+ * Text Report
+ * ============================================================================ */
+
+typedef struct prof_row {
+    const rx_prof_site* site;
+    rx_prof_stat stat;
+} prof_row;
+
+static int prof_row_cmp(const void* a, const void* b) {
+    uint64_t ta = ((const prof_row*)a)->stat.ticks;
+    uint64_t tb = ((const prof_row*)b)->stat.ticks;
+    return ta < tb ? 1 : ta > tb ? -1 : 0;
+}
+
+void rx_prof_write_report(FILE* out) {
+    pthread_mutex_lock(&prof_lock);
+    uint32_t n = prof_site_count < RX_PROF_MAX_SITES ? prof_site_count : RX_PROF_MAX_SITES;
+    prof_row* rows = calloc(n ? n : 1, sizeof(prof_row));
+    if (!rows) {
+        pthread_mutex_unlock(&prof_lock);
+        return;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        rows[i].site = prof_sites[i];
+        for (rx_prof_thread* t = prof_threads; t; t = t->next) {
+            rows[i].stat.calls += t->stats[i].calls;
+            rows[i].stat.ticks += t->stats[i].ticks;
+        }
+    }
+    double ms_per_tick = prof_ns_per_tick() * 1e-6;
+    pthread_mutex_unlock(&prof_lock);
+
+    qsort(rows, n, sizeof(prof_row), prof_row_cmp);
+
+    fprintf(out, "\n=== REOX Profile Report ===\n");
+    fprintf(out, "%-30s %10s %12s %12s\n", "Function", "Calls", "Total (ms)", "Avg (ms)");
+    fprintf(out, "%-30s %10s %12s %12s\n", "--------", "-----", "----------", "--------");
+    for (uint32_t i = 0; i < n; i++) {
+        if (rows[i].stat.calls == 0) continue;
+        double total_ms = (double)rows[i].stat.ticks * ms_per_tick;
+        fprintf(out, "%-30s %10llu %12.3f %12.6f\n",
+                rows[i].site->name,
+                (unsigned long long)rows[i].stat.calls,
+                total_ms,
+                total_ms / (double)rows[i].stat.calls);
+    }
+    fprintf(out, "===========================\n");
+    free(rows);
+}
+
+/* ============================================================================
+ * Chrome Trace
+ * ============================================================================ */
+
+static void prof_json_string(FILE* out, const char* s) {
+    fputc('"', out);
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+        else if (c < 0x20) fprintf(out, "\\u%04x", c);
+        else fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+int rx_prof_write_trace(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) return -1;
+
+    pthread_mutex_lock(&prof_lock);
+    double us_per_tick = prof_ns_per_tick() * 1e-3;
+    bool first = true;
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (rx_prof_thread* t = prof_threads; t; t = t->next) {
+        uint64_t from = t->head > RX_PROF_RING_EVENTS ? t->head - RX_PROF_RING_EVENTS : 0;
+        /* Ends whose begin was overwritten would close the wrong slice */
+        int64_t depth = 0;
+        for (uint64_t i = from; i < t->head; i++) {
+            const rx_prof_event* e = &t->ring[i & (RX_PROF_RING_EVENTS - 1)];
+            if (e->end && depth == 0) continue;
+            depth += e->end ? -1 : 1;
+
+            const rx_prof_site* site = prof_sites[e->site];
+            double ts = (double)(int64_t)(e->ticks - prof_origin_ticks) * us_per_tick;
+            fprintf(out, "%s\n{\"name\":", first ? "" : ",");
+            prof_json_string(out, site ? site->name : "?");
+            fprintf(out, ",\"cat\":\"reox\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                    e->end ? 'E' : 'B', ts, t->tid);
+            if (!e->end && site && site->file) {
+                fprintf(out, ",\"args\":{\"file\":");
+                prof_json_string(out, site->file);
+                fprintf(out, ",\"line\":%u}", site->line);
+            }
+            fputc('}', out);
+            first = false;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    pthread_mutex_unlock(&prof_lock);
+
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+/* ============================================================================
+ * Exit
+ * ============================================================================ */
+
+__attribute__((destructor))
+static void prof_shutdown(void) {
+    if (!prof_threads) return;
+    const char* trace = getenv("RX_PROFILE_TRACE");
+    if (trace && *trace && rx_prof_write_trace(trace) != 0) {
+        fprintf(stderr, "reox profile: cannot write %s\n", trace);
+    }
+    rx_prof_write_report(stderr);
+}
@@ -0,0 +1,166 @@
+/*
+ * REOX Profiler
+ * Low-overhead function timing for instrumented REOX builds
+ *
+ * Features:
+ * - Call sites are numbered by the compiler; entering and leaving one
+ *   indexes an array, never searches a table
+ * - Timestamps from the TSC on x86, CLOCK_MONOTONIC elsewhere; ticks are
+ *   converted to nanoseconds only when a report is written
+ * - Per-thread ring buffers of begin/end events and per-thread totals, so
+ *   recording takes no locks and threads share no counters
+ * - Text report and Chrome trace / Perfetto JSON output
+ *
+ * Generated code declares its sites once with RX_PROFILE_SITES and wraps
+ * function bodies in RX_PROFILE_ENTER/RX_PROFILE_EXIT. With
+ * RX_PROFILE_ENABLED=0 every macro compiles to nothing.
+ *
+ * At exit the text report goes to stderr, and a trace is written to
+ * $RX_PROFILE_TRACE if it is set.
+ */
+
+#ifndef REOX_PROFILE_H
+#define REOX_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RX_PROFILE_ENABLED
+#define RX_PROFILE_ENABLED 1
+#endif
+
+#define RX_PROF_MAX_SITES 4096          /* Power of two; ids wrap past it */
+#ifndef RX_PROF_RING_EVENTS
+#define RX_PROF_RING_EVENTS 65536       /* Per thread, power of two */
+#endif
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+typedef struct rx_prof_site {
+    const char* name;
+    const char* file;
+    uint32_t line;
+} rx_prof_site;
+
+typedef struct rx_prof_event {
+    uint64_t ticks;
+    uint32_t site;
+    uint32_t end;                       /* 0: begin, 1: end */
+} rx_prof_event;
+
+typedef struct rx_prof_stat {
+    uint64_t calls;
+    uint64_t ticks;                     /* Inclusive */
+} rx_prof_stat;
+
+/* One per recording thread, owned by it; only read when writing reports */
+typedef struct rx_prof_thread {
+    rx_prof_event* ring;
+    uint64_t head;                      /* Events ever written */
+    rx_prof_stat stats[RX_PROF_MAX_SITES];
+    uint32_t tid;
+    struct rx_prof_thread* next;
+} rx_prof_thread;
+
+/* ============================================================================
+ * Recording
+ * ============================================================================ */
+
+extern _Thread_local rx_prof_thread* rx_prof_tls;
+
+/* Allocate and register the calling thread's buffers */
+extern rx_prof_thread* rx_prof_thread_init(void);
+
+/* Register a translation unit's sites; returns the id of the first */
+extern uint32_t rx_prof_register(const rx_prof_site* sites, uint32_t count);
+
+static inline uint64_t rx_prof_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline void rx_prof_record(rx_prof_thread* t, uint64_t now, uint32_t site, uint32_t end) {
+    rx_prof_event* e = &t->ring[t->head++ & (RX_PROF_RING_EVENTS - 1)];
+    e->ticks = now;
+    e->site = site;
+    e->end = end;
+}
+
+static inline uint64_t rx_prof_begin(uint32_t site) {
+    rx_prof_thread* t = rx_prof_tls;
+    if (__builtin_expect(t == NULL, 0)) t = rx_prof_thread_init();
+    uint64_t now = rx_prof_ticks();
+    rx_prof_record(t, now, site & (RX_PROF_MAX_SITES - 1), 0);
+    return now;
+}
+
+static inline void rx_prof_end(uint32_t site, uint64_t start) {
+    uint64_t now = rx_prof_ticks();
+    rx_prof_thread* t = rx_prof_tls;
+    site &= RX_PROF_MAX_SITES - 1;
+    rx_prof_record(t, now, site, 1);
+    t->stats[site].calls++;
+    t->stats[site].ticks += now - start;
+}
+
+/* ============================================================================
+ * Reports
+ * Call while no other thread is recording (e.g. at exit).
+ * ============================================================================ */
+
+/* Per-site totals over all threads, slowest first */
+extern void rx_prof_write_report(FILE* out);
+
+/* Chrome trace / Perfetto JSON of the events still in the rings */
+extern int rx_prof_write_trace(const char* path);
+
+/* Forget all totals and events */
+extern void rx_prof_reset(void);
+
+/* ============================================================================
+ * Instrumentation Macros
+ * ============================================================================ */
+
+#if RX_PROFILE_ENABLED
+
+/* Site table of one generated C file: RX_PROFILE_SITES({"fib", "fib.rx", 3}, ...) */
+#define RX_PROFILE_SITES(...)                                                   \
+    static const rx_prof_site rx_prof_sites[] = { __VA_ARGS__ };                \
+    static uint32_t rx_prof_base;                                               \
+    __attribute__((constructor)) static void rx_prof_register_sites(void) {     \
+        rx_prof_base = rx_prof_register(rx_prof_sites,                          \
+            (uint32_t)(sizeof(rx_prof_sites) / sizeof(rx_prof_sites[0])));      \
+    }
+
+#define RX_PROFILE_ENTER(site) \
+    uint64_t _rx_prof_start = rx_prof_begin(rx_prof_base + (site))
+
+#define RX_PROFILE_EXIT(site) \
+    rx_prof_end(rx_prof_base + (site), _rx_prof_start)
+
+#else
+#define RX_PROFILE_SITES(...)
+#define RX_PROFILE_ENTER(site)
+#define RX_PROFILE_EXIT(site)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_PROFILE_H */
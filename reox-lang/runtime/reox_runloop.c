@@ -0,0 +1,492 @@
+/*
+ * REOX Run Loop - Implementation
+ * Frame scheduling, timers and idle sleep for the UI thread
+ */
+
+#include "reox_runloop.h"
+#include "reox_animation.h"
+#include "reox_compositor.h"
+#include "reox_frame_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+
+#define NS_PER_SEC 1000000000ULL
+#define NS_PER_MS 1000000ULL
+
+static rx_runloop* main_loop = NULL;
+
+/* ============================================================================
+ * Clock
+ * ============================================================================ */
+
+uint64_t rx_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+double rx_clock_seconds(void) {
+    return (double)rx_clock_ns() * 1e-9;
+}
+
+void rx_clock_sleep_ns(uint64_t ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / NS_PER_SEC);
+    ts.tv_nsec = (long)(ns % NS_PER_SEC);
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+}
+
+/* ============================================================================
+ * Timer Heap
+ * ============================================================================ */
+
+static inline uint64_t heap_deadline(const rx_runloop* loop, size_t i) {
+    return loop->slots[loop->heap[i]].deadline;
+}
+
+static inline void heap_set(rx_runloop* loop, size_t i, uint32_t slot) {
+    loop->heap[i] = slot;
+    loop->slots[slot].heap_index = (int32_t)i;
+}
+
+static void heap_sift_up(rx_runloop* loop, size_t i) {
+    uint32_t slot = loop->heap[i];
+    uint64_t deadline = loop->slots[slot].deadline;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap_deadline(loop, parent) <= deadline) break;
+        heap_set(loop, i, loop->heap[parent]);
+        i = parent;
+    }
+    heap_set(loop, i, slot);
+}
+
+static void heap_sift_down(rx_runloop* loop, size_t i) {
+    uint32_t slot = loop->heap[i];
+    uint64_t deadline = loop->slots[slot].deadline;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= loop->heap_count) break;
+        if (child + 1 < loop->heap_count && heap_deadline(loop, child + 1) < heap_deadline(loop, child)) {
+            child++;
+        }
+        if (heap_deadline(loop, child) >= deadline) break;
+        heap_set(loop, i, loop->heap[child]);
+        i = child;
+    }
+    heap_set(loop, i, slot);
+}
+
+static void heap_remove(rx_runloop* loop, size_t i) {
+    loop->heap_count--;
+    if (i == loop->heap_count) return;
+    uint32_t moved = loop->heap[loop->heap_count];
+    heap_set(loop, i, moved);
+    heap_sift_down(loop, i);
+    heap_sift_up(loop, (size_t)loop->slots[moved].heap_index);
+}
+
+static bool timers_grow(rx_runloop* loop) {
+    size_t cap = loop->slot_capacity ? loop->slot_capacity * 2 : 32;
+    rx_timer_slot* slots = (rx_timer_slot*)realloc(loop->slots, sizeof(rx_timer_slot) * cap);
+    if (!slots) return false;
+    loop->slots = slots;
+    uint32_t* free_slots = (uint32_t*)realloc(loop->free_slots, sizeof(uint32_t) * cap);
+    if (!free_slots) return false;
+    loop->free_slots = free_slots;
+    uint32_t* heap = (uint32_t*)realloc(loop->heap, sizeof(uint32_t) * cap);
+    if (!heap) return false;
+    loop->heap = heap;
+    loop->slot_capacity = cap;
+    return true;
+}
+
+/*
+ * Round due up to a power-of-two grid no coarser than the timer's slack.
+ * Grids nest, so timers with different periods still share wakeups on the
+ * coarser grid's points.
+ */
+static uint64_t timer_coalesce(const rx_runloop* loop, uint64_t due, uint64_t period) {
+    if (loop->config.precise_timers) return due;
+    uint64_t slack = period / RX_RUNLOOP_TIMER_SLACK_DIV;
+    if (slack > RX_RUNLOOP_TIMER_SLACK_MAX_MS * NS_PER_MS) slack = RX_RUNLOOP_TIMER_SLACK_MAX_MS * NS_PER_MS;
+    if (slack < NS_PER_MS) return due;
+    uint64_t grid = NS_PER_MS;
+    while (grid * 2 <= slack) grid *= 2;
+    return (due + grid - 1) / grid * grid;
+}
+
+static inline rx_timer_id timer_make_id(uint32_t slot, uint32_t generation) {
+    return ((uint64_t)generation << 32) | (uint64_t)(slot + 1);
+}
+
+rx_timer_id rx_runloop_add_timer(rx_runloop* loop, uint64_t delay_ms, uint64_t interval_ms,
+                                 rx_timer_fn fn, void* user_data) {
+    if (!loop || !fn) return 0;
+
+    uint32_t slot;
+    if (loop->free_count > 0) {
+        slot = loop->free_slots[--loop->free_count];
+    } else {
+        if (loop->slot_count == loop->slot_capacity && !timers_grow(loop)) return 0;
+        slot = (uint32_t)loop->slot_count++;
+        loop->slots[slot].generation = 0;
+    }
+
+    rx_timer_slot* t = &loop->slots[slot];
+    t->due = rx_clock_ns() + delay_ms * NS_PER_MS;
+    t->interval = interval_ms * NS_PER_MS;
+    t->deadline = timer_coalesce(loop, t->due, delay_ms * NS_PER_MS);
+    t->fn = fn;
+    t->user_data = user_data;
+    t->generation++;
+
+    loop->heap[loop->heap_count] = slot;
+    t->heap_index = (int32_t)loop->heap_count++;
+    heap_sift_up(loop, (size_t)t->heap_index);
+
+    return timer_make_id(slot, t->generation);
+}
+
+static rx_timer_slot* timer_lookup(rx_runloop* loop, rx_timer_id id) {
+    uint32_t slot = (uint32_t)(id & 0xFFFFFFFFu) - 1;
+    if (id == 0 || slot >= loop->slot_count) return NULL;
+    rx_timer_slot* t = &loop->slots[slot];
+    if (t->heap_index < 0 || t->generation != (uint32_t)(id >> 32)) return NULL;
+    return t;
+}
+
+static void timer_free(rx_runloop* loop, rx_timer_slot* t) {
+    t->heap_index = -1;
+    loop->free_slots[loop->free_count++] = (uint32_t)(t - loop->slots);
+}
+
+bool rx_runloop_cancel_timer(rx_runloop* loop, rx_timer_id id) {
+    if (!loop) return false;
+    rx_timer_slot* t = timer_lookup(loop, id);
+    if (!t) return false;
+    heap_remove(loop, (size_t)t->heap_index);
+    timer_free(loop, t);
+    return true;
+}
+
+/* Fire everything due by now. Timers armed by callbacks wait for the next
+ * pass, so a zero-delay timer can't starve the loop. */
+static void timers_fire(rx_runloop* loop, uint64_t now) {
+    if (loop->heap_count > 0 && heap_deadline(loop, 0) <= now) loop->timer_wakeups++;
+    while (loop->heap_count > 0) {
+        rx_timer_slot* t = &loop->slots[loop->heap[0]];
+        if (t->deadline > now) break;
+
+        rx_timer_fn fn = t->fn;
+        void* user_data = t->user_data;
+        loop->timers_fired++;
+        if (t->interval > 0) {
+            /* Re-arm from the requested time so rounding doesn't drift */
+            t->due += t->interval;
+            /* Fell behind (sleep, debugger): don't replay missed ticks */
+            if (t->due <= now) t->due = now + t->interval;
+            t->deadline = timer_coalesce(loop, t->due, t->interval);
+            heap_sift_down(loop, 0);
+        } else {
+            heap_remove(loop, 0);
+            timer_free(loop, t);
+        }
+        fn(user_data);
+    }
+}
+
+/* ============================================================================
+ * Run Loop Lifecycle
+ * ============================================================================ */
+
+rx_runloop* rx_runloop_create(const rx_runloop_hooks* hooks, const rx_runloop_config* config) {
+    rx_runloop* loop = (rx_runloop*)calloc(1, sizeof(rx_runloop));
+    if (!loop) return NULL;
+
+    rx_runloop_configure(loop, hooks, config);
+    loop->dirty = true;
+    pthread_mutex_init(&loop->post_lock, NULL);
+    pthread_cond_init(&loop->post_cond, NULL);
+
+    return loop;
+}
+
+void rx_runloop_destroy(rx_runloop* loop) {
+    if (!loop) return;
+    if (main_loop == loop) main_loop = NULL;
+    free(loop->slots);
+    free(loop->free_slots);
+    free(loop->heap);
+    free(loop->frame_requests);
+    free(loop->posted);
+    pthread_mutex_destroy(&loop->post_lock);
+    pthread_cond_destroy(&loop->post_cond);
+    free(loop);
+}
+
+rx_runloop* rx_runloop_main(void) {
+    if (!main_loop) {
+        main_loop = rx_runloop_create(NULL, NULL);
+    }
+    return main_loop;
+}
+
+void rx_runloop_configure(rx_runloop* loop, const rx_runloop_hooks* hooks,
+                          const rx_runloop_config* config) {
+    if (!loop) return;
+    if (hooks) loop->hooks = *hooks;
+    else memset(&loop->hooks, 0, sizeof(loop->hooks));
+    if (config) loop->config = *config;
+    else loop->config = (rx_runloop_config){ .max_fps = 0, .vsync = false };
+}
+
+void rx_runloop_request_frame(rx_runloop* loop) {
+    if (loop) loop->dirty = true;
+}
+
+bool rx_runloop_on_next_frame(rx_runloop* loop, rx_frame_fn fn, void* user_data) {
+    if (!loop || !fn) return false;
+    if (loop->frame_request_count == loop->frame_request_capacity) {
+        size_t cap = loop->frame_request_capacity ? loop->frame_request_capacity * 2 : 16;
+        rx_frame_request* r = (rx_frame_request*)realloc(loop->frame_requests, sizeof(rx_frame_request) * cap);
+        if (!r) return false;
+        loop->frame_requests = r;
+        loop->frame_request_capacity = cap;
+    }
+    loop->frame_requests[loop->frame_request_count++] = (rx_frame_request){ fn, user_data };
+    return true;
+}
+
+/* ============================================================================
+ * Cross-Thread Posts
+ * ============================================================================ */
+
+bool rx_runloop_post(rx_runloop* loop, rx_timer_fn fn, void* user_data) {
+    if (!loop || !fn) return false;
+    pthread_mutex_lock(&loop->post_lock);
+    if (loop->posted_count == loop->posted_capacity) {
+        size_t cap = loop->posted_capacity ? loop->posted_capacity * 2 : 16;
+        rx_posted_call* p = (rx_posted_call*)realloc(loop->posted, sizeof(rx_posted_call) * cap);
+        if (!p) {
+            pthread_mutex_unlock(&loop->post_lock);
+            return false;
+        }
+        loop->posted = p;
+        loop->posted_capacity = cap;
+    }
+    loop->posted[loop->posted_count++] = (rx_posted_call){ fn, user_data };
+    pthread_cond_signal(&loop->post_cond);
+    pthread_mutex_unlock(&loop->post_lock);
+
+    if (loop->hooks.wake) loop->hooks.wake(loop->hooks.ctx);
+    return true;
+}
+
+void rx_runloop_hold(rx_runloop* loop) {
+    if (!loop) return;
+    pthread_mutex_lock(&loop->post_lock);
+    loop->holds++;
+    pthread_mutex_unlock(&loop->post_lock);
+}
+
+void rx_runloop_unhold(rx_runloop* loop) {
+    if (!loop) return;
+    pthread_mutex_lock(&loop->post_lock);
+    if (loop->holds > 0) loop->holds--;
+    pthread_cond_signal(&loop->post_cond);
+    pthread_mutex_unlock(&loop->post_lock);
+    if (loop->hooks.wake) loop->hooks.wake(loop->hooks.ctx);
+}
+
+/* Run what was posted before this call; later posts wait for the next pass */
+static void posted_run(rx_runloop* loop) {
+    pthread_mutex_lock(&loop->post_lock);
+    size_t count = loop->posted_count;
+    if (count == 0) {
+        pthread_mutex_unlock(&loop->post_lock);
+        return;
+    }
+    rx_posted_call* calls = loop->posted;
+    loop->posted = NULL;
+    loop->posted_count = 0;
+    loop->posted_capacity = 0;
+    pthread_mutex_unlock(&loop->post_lock);
+
+    for (size_t i = 0; i < count; i++) calls[i].fn(calls[i].user_data);
+    free(calls);
+}
+
+static bool posted_pending(rx_runloop* loop, size_t* holds) {
+    pthread_mutex_lock(&loop->post_lock);
+    bool pending = loop->posted_count > 0;
+    if (holds) *holds = loop->holds;
+    pthread_mutex_unlock(&loop->post_lock);
+    return pending;
+}
+
+/* Sleep for at most ns (UINT64_MAX: until a post), returning early on a post */
+static void posted_wait(rx_runloop* loop, uint64_t ns) {
+    pthread_mutex_lock(&loop->post_lock);
+    if (loop->posted_count == 0) {
+        if (ns == UINT64_MAX) {
+            pthread_cond_wait(&loop->post_cond, &loop->post_lock);
+        } else {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            uint64_t deadline = (uint64_t)ts.tv_nsec + ns % NS_PER_SEC;
+            ts.tv_sec += (time_t)(ns / NS_PER_SEC + deadline / NS_PER_SEC);
+            ts.tv_nsec = (long)(deadline % NS_PER_SEC);
+            pthread_cond_timedwait(&loop->post_cond, &loop->post_lock, &ts);
+        }
+    }
+    pthread_mutex_unlock(&loop->post_lock);
+}
+
+/* ============================================================================
+ * Frame Scheduling
+ * ============================================================================ */
+
+static float refresh_rate(const rx_runloop* loop) {
+    float hz = loop->hooks.refresh_rate ? loop->hooks.refresh_rate(loop->hooks.ctx) : 0;
+    return hz > 0 ? hz : RX_RUNLOOP_DEFAULT_REFRESH;
+}
+
+static bool animations_running(void) {
+    rx_animator* animator = rx_animator_shared();
+    return animator && !animator->paused && animator->animation_count > 0;
+}
+
+static bool wants_frame(const rx_runloop* loop) {
+    return loop->dirty || loop->frame_request_count > 0 || animations_running();
+}
+
+/*
+ * Animation dt: clamped after stalls, nominal after idle, and with vsync
+ * snapped to whole refresh intervals so jitter in wakeups doesn't show up
+ * as uneven motion.
+ */
+static float frame_dt(const rx_runloop* loop, uint64_t now, float interval) {
+    if (loop->last_frame == 0) return interval;
+    float dt = (float)((double)(now - loop->last_frame) * 1e-9);
+    if (loop->config.vsync) {
+        float n = roundf(dt / interval);
+        dt = (n < 1 ? 1 : n) * interval;
+    }
+    return dt > RX_RUNLOOP_MAX_FRAME_DT ? RX_RUNLOOP_MAX_FRAME_DT : dt;
+}
+
+static void run_frame(rx_runloop* loop, uint64_t now) {
+    float hz = refresh_rate(loop);
+    float fps = loop->config.max_fps > 0 && loop->config.max_fps < hz ? loop->config.max_fps : hz;
+    float dt = frame_dt(loop, now, 1.0f / hz);
+    RX_FRAME_BEGIN();
+
+    /* Requests made from inside a callback go to the following frame */
+    size_t count = loop->frame_request_count;
+    for (size_t i = 0; i < count; i++) {
+        loop->frame_requests[i].fn(loop->frame_requests[i].user_data, dt);
+    }
+    if (count > 0) {
+        memmove(loop->frame_requests, loop->frame_requests + count,
+                sizeof(rx_frame_request) * (loop->frame_request_count - count));
+        loop->frame_request_count -= count;
+    }
+
+    rx_animator_update(rx_animator_shared(), dt);
+    loop->dirty = false;
+    if (loop->hooks.frame) loop->hooks.frame(loop->hooks.ctx, dt);
+    loop->frames++;
+    RX_FRAME_END();
+
+    loop->last_frame = now;
+    /* A blocking present already paces at the refresh rate */
+    if (loop->config.vsync && fps >= hz) {
+        loop->next_frame = now;
+    } else {
+        loop->next_frame = now + (uint64_t)((double)NS_PER_SEC / fps);
+    }
+}
+
+uint64_t rx_runloop_time_to_work(rx_runloop* loop) {
+    if (!loop) return UINT64_MAX;
+    if (posted_pending(loop, NULL)) return 0;
+
+    uint64_t now = rx_clock_ns();
+    uint64_t wait = UINT64_MAX;
+
+    if (loop->heap_count > 0) {
+        uint64_t deadline = heap_deadline(loop, 0);
+        wait = deadline > now ? deadline - now : 0;
+    }
+    if (wants_frame(loop)) {
+        uint64_t frame_wait = loop->next_frame > now ? loop->next_frame - now : 0;
+        if (frame_wait < wait) wait = frame_wait;
+    }
+
+    /* Compositor-side animations report completion on this thread */
+    if (loop->compositor_animations > 0) {
+        uint64_t poll = (uint64_t)((double)NS_PER_SEC / refresh_rate(loop));
+        if (poll < wait) wait = poll;
+    }
+    return wait;
+}
+
+bool rx_runloop_iterate(rx_runloop* loop) {
+    if (!loop) return false;
+    bool keep_going = true;
+
+    posted_run(loop);
+
+    uint64_t now = rx_clock_ns();
+    timers_fire(loop, now);
+
+    rx_compositor* comp = rx_compositor_active();
+    loop->compositor_animations = comp ? rx_compositor_collect(comp) : 0;
+
+    if (wants_frame(loop)) {
+        if (now >= loop->next_frame) run_frame(loop, now);
+    } else {
+        loop->last_frame = 0;
+    }
+
+    uint64_t wait = rx_runloop_time_to_work(loop);
+    uint64_t before = rx_clock_ns();
+
+    if (loop->hooks.wait_events) {
+        int timeout_ms;
+        if (wait == UINT64_MAX) timeout_ms = -1;
+        else if (wait / NS_PER_MS >= INT_MAX) timeout_ms = INT_MAX;
+        else timeout_ms = (int)((wait + NS_PER_MS - 1) / NS_PER_MS);
+        keep_going = loop->hooks.wait_events(loop->hooks.ctx, timeout_ms);
+    } else {
+        size_t holds = 0;
+        bool pending = posted_pending(loop, &holds);
+        if (wait == UINT64_MAX && holds == 0 && !pending) {
+            /* No event source, nothing scheduled or outstanding: done */
+            keep_going = false;
+        } else if (wait > 0) {
+            posted_wait(loop, wait);
+        }
+    }
+
+    loop->idle_ns += rx_clock_ns() - before;
+    return keep_going;
+}
+
+void rx_runloop_run(rx_runloop* loop) {
+    if (!loop) return;
+    loop->running = true;
+    while (loop->running) {
+        if (!rx_runloop_iterate(loop)) break;
+    }
+    loop->running = false;
+}
+
+void rx_runloop_stop(rx_runloop* loop) {
+    if (loop) loop->running = false;
+}
@@ -0,0 +1,173 @@
+/*
+ * REOX Run Loop
+ * Frame scheduling, timers and idle sleep for the UI thread
+ *
+ * Features:
+ * - Monotonic clock
+ * - Min-heap of timers (one-shot and repeating), with deadlines rounded
+ *   to a grid so timers due close together fire in one wakeup
+ * - Frames only when something is dirty, animating or has asked for the
+ *   next frame; otherwise the loop sleeps until the next timer or event
+ * - Frame-rate cap and vsync-aligned frame deltas for the animator
+ * - Callbacks posted from other threads, run on the loop's thread
+ *
+ * The loop does not know about windows. A platform supplies hooks to wait
+ * for events and to draw a frame.
+ */
+
+#ifndef REOX_RUNLOOP_H
+#define REOX_RUNLOOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Clock
+ * ============================================================================ */
+
+extern uint64_t rx_clock_ns(void);
+extern double rx_clock_seconds(void);
+extern void rx_clock_sleep_ns(uint64_t ns);
+
+/* ============================================================================
+ * Run Loop Types
+ * ============================================================================ */
+
+#define RX_RUNLOOP_DEFAULT_REFRESH 60.0f
+#define RX_RUNLOOP_MAX_FRAME_DT 0.1f    /* Animation dt clamp after a stall */
+/* A timer may fire up to period / SLACK_DIV late, at most SLACK_MAX_MS,
+ * so that it lands on a shared grid point */
+#define RX_RUNLOOP_TIMER_SLACK_DIV 16
+#define RX_RUNLOOP_TIMER_SLACK_MAX_MS 250
+
+typedef uint64_t rx_timer_id;           /* 0 is never a valid id */
+typedef void (*rx_timer_fn)(void* user_data);
+typedef void (*rx_frame_fn)(void* user_data, float dt);
+
+typedef struct rx_runloop_hooks {
+    /* Block for input up to timeout_ms (-1: until an event, 0: poll), handle
+     * it and return false to quit. NULL: sleep, and stop once idle. */
+    bool (*wait_events)(void* ctx, int timeout_ms);
+    /* Lay out, draw and present one frame */
+    void (*frame)(void* ctx, float dt);
+    /* Display refresh rate in Hz (optional) */
+    float (*refresh_rate)(void* ctx);
+    /* Any thread: make a blocked wait_events return (optional; without it
+     * posted callbacks wait for the current timeout) */
+    void (*wake)(void* ctx);
+    void* ctx;
+} rx_runloop_hooks;
+
+typedef struct rx_runloop_config {
+    float max_fps;            /* 0: display refresh rate */
+    bool vsync;               /* Present blocks on vblank */
+    bool precise_timers;      /* Fire at the exact deadline, no coalescing */
+} rx_runloop_config;
+
+typedef struct rx_timer_slot {
+    uint64_t deadline;        /* rx_clock_ns, due rounded up to the grid */
+    uint64_t due;             /* Requested time */
+    uint64_t interval;        /* 0: one-shot */
+    rx_timer_fn fn;
+    void* user_data;
+    uint32_t generation;
+    int32_t heap_index;       /* -1: free */
+} rx_timer_slot;
+
+typedef struct rx_frame_request {
+    rx_frame_fn fn;
+    void* user_data;
+} rx_frame_request;
+
+typedef struct rx_posted_call {
+    rx_timer_fn fn;
+    void* user_data;
+} rx_posted_call;
+
+typedef struct rx_runloop {
+    rx_runloop_hooks hooks;
+    rx_runloop_config config;
+
+    /* Timers: slots addressed by id, heap of slot indices by deadline */
+    rx_timer_slot* slots;
+    uint32_t* free_slots;
+    uint32_t* heap;
+    size_t slot_count, slot_capacity;
+    size_t free_count;
+    size_t heap_count;
+
+    /* One-shot callbacks for the next frame (requestAnimationFrame) */
+    rx_frame_request* frame_requests;
+    size_t frame_request_count, frame_request_capacity;
+
+    /* Calls posted from other threads, guarded by post_lock */
+    pthread_mutex_t post_lock;
+    pthread_cond_t post_cond;       /* Signalled on post when there is no wait_events */
+    rx_posted_call* posted;
+    size_t posted_count, posted_capacity;
+    size_t holds;                   /* Outstanding work that will post back */
+
+    bool dirty;
+    bool running;
+    size_t compositor_animations;   /* From the last rx_compositor_collect */
+    uint64_t last_frame;      /* 0: idle, next frame gets a nominal dt */
+    uint64_t next_frame;
+
+    /* Statistics */
+    uint64_t frames;
+    uint64_t idle_ns;
+    uint64_t timer_wakeups;   /* Passes that fired at least one timer */
+    uint64_t timers_fired;
+} rx_runloop;
+
+/* ============================================================================
+ * Run Loop API
+ * ============================================================================ */
+
+extern rx_runloop* rx_runloop_create(const rx_runloop_hooks* hooks, const rx_runloop_config* config);
+extern void rx_runloop_destroy(rx_runloop* loop);
+
+/* Loop used by app_run, rx_app_run and the timer wrappers */
+extern rx_runloop* rx_runloop_main(void);
+extern void rx_runloop_configure(rx_runloop* loop, const rx_runloop_hooks* hooks,
+                                 const rx_runloop_config* config);
+
+/* Timers fire on the loop's thread; a repeating timer re-arms before its
+ * callback runs, so the callback may cancel it */
+extern rx_timer_id rx_runloop_add_timer(rx_runloop* loop, uint64_t delay_ms, uint64_t interval_ms,
+                                        rx_timer_fn fn, void* user_data);
+extern bool rx_runloop_cancel_timer(rx_runloop* loop, rx_timer_id id);
+
+/* Something changed: draw a frame at the next opportunity */
+extern void rx_runloop_request_frame(rx_runloop* loop);
+/* Call fn with the frame delta just before the next frame is drawn */
+extern bool rx_runloop_on_next_frame(rx_runloop* loop, rx_frame_fn fn, void* user_data);
+
+/*
+ * Any thread: run fn(user_data) on the loop's thread at its next
+ * iteration, in post order. A hold keeps a loop without an event source
+ * from exiting while work on another thread is still going to post back.
+ */
+extern bool rx_runloop_post(rx_runloop* loop, rx_timer_fn fn, void* user_data);
+extern void rx_runloop_hold(rx_runloop* loop);
+extern void rx_runloop_unhold(rx_runloop* loop);
+
+/* One iteration: timers, maybe a frame, then wait. False to quit. */
+extern bool rx_runloop_iterate(rx_runloop* loop);
+extern void rx_runloop_run(rx_runloop* loop);
+extern void rx_runloop_stop(rx_runloop* loop);
+
+/* Nanoseconds until the loop has work (timer or frame); UINT64_MAX if none */
+extern uint64_t rx_runloop_time_to_work(rx_runloop* loop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REOX_RUNLOOP_H */
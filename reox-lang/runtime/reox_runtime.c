@@ -7,49 +7,320 @@
  */
 
 #include "reox_runtime.h"
+#include "reox_frame_stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <math.h>
 #include <ctype.h>
+#include <stdatomic.h>
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
 
 /* ============================================================================
- * Print Functions
+ * Output Buffer
  * ============================================================================ */
 
-void println(rx_string s) {
-    if (RX_LIKELY(s != NULL)) {
-        puts(s);
+static char out_inline[RX_OUTPUT_BUFFER_DEFAULT];
+static char* out_buf = out_inline;
+static size_t out_size = RX_OUTPUT_BUFFER_DEFAULT;
+static size_t out_len;
+static int out_tty = -1;            /* -1: not checked yet */
+static atomic_flag out_lock = ATOMIC_FLAG_INIT;
+
+/*
+ * The lock only covers the buffer. A drain copies the bytes out into an
+ * out_pending under it and writes them after releasing it; drains take
+ * tickets under the lock and write in ticket order, so output keeps the
+ * order it was buffered in while other threads go on appending.
+ */
+static uint64_t out_tickets;        /* Under out_lock */
+static _Atomic uint64_t out_served;
+
+typedef struct out_pending {
+    char local[1024];
+    char* data;
+    size_t len, capacity;
+    bool taken;                     /* Holds a ticket: out_emit must run */
+    uint64_t ticket;
+} out_pending;
+
+#define OUT_PENDING_INIT { {0}, NULL, 0, 0, false, 0 }
+
+static inline void out_acquire(void) {
+    while (atomic_flag_test_and_set_explicit(&out_lock, memory_order_acquire)) {
+    }
+}
+
+static inline void out_release(void) {
+    atomic_flag_clear_explicit(&out_lock, memory_order_release);
+}
+
+static void out_wait_turn(const out_pending* p) {
+    while (atomic_load_explicit(&out_served, memory_order_acquire) != p->ticket) {
+    }
+}
+
+/* Lock held. Without memory for the copy, waits its turn and writes in place */
+static void out_take(out_pending* p, const char* s, size_t len) {
+    if (!p->taken) {
+        p->taken = true;
+        p->ticket = out_tickets++;
+        p->data = p->local;
+        p->capacity = sizeof(p->local);
+    }
+    if (len > p->capacity - p->len) {
+        size_t cap = p->capacity * 2 > p->len + len ? p->capacity * 2 : p->len + len;
+        char* data = (char*)malloc(cap);
+        if (RX_UNLIKELY(!data)) {
+            out_wait_turn(p);
+            fwrite(p->data, 1, p->len, stdout);
+            fwrite(s, 1, len, stdout);
+            p->len = 0;
+            return;
+        }
+        memcpy(data, p->data, p->len);
+        if (p->data != p->local) free(p->data);
+        p->data = data;
+        p->capacity = cap;
+    }
+    memcpy(p->data + p->len, s, len);
+    p->len += len;
+}
+
+static void out_drain(out_pending* p) {
+    out_take(p, out_buf, out_len);
+    out_len = 0;
+}
+
+/* Lock released: write and flush in ticket order */
+static void out_emit(out_pending* p) {
+    if (!p->taken) return;
+    out_wait_turn(p);
+    if (p->len) fwrite(p->data, 1, p->len, stdout);
+    fflush(stdout);
+    atomic_store_explicit(&out_served, p->ticket + 1, memory_order_release);
+    if (p->data != p->local) free(p->data);
+}
+
+static void out_exit_flush(void) {
+    rx_flush();
+}
+
+static RX_COLD void out_init(void) {
+    out_tty = isatty(fileno(stdout)) ? 1 : 0;
+    atexit(out_exit_flush);
+}
+
+/* Append under the lock; line flushes only when stdout is a terminal */
+static void out_write(out_pending* p, const char* s, size_t len) {
+    if (RX_UNLIKELY(out_tty < 0)) out_init();
+    if (RX_UNLIKELY(len > out_size - out_len)) {
+        out_drain(p);
+        if (len > out_size) {
+            out_take(p, s, len);
+            return;
+        }
+    }
+    memcpy(out_buf + out_len, s, len);
+    out_len += len;
+    if (out_tty && memchr(s, '\n', len)) out_drain(p);
+}
+
+static void out_put(const char* s, size_t len) {
+    out_pending p = OUT_PENDING_INIT;
+    out_acquire();
+    out_write(&p, s, len);
+    out_release();
+    out_emit(&p);
+}
+
+void rx_flush(void) {
+    out_pending p = OUT_PENDING_INIT;
+    out_acquire();
+    out_drain(&p);
+    out_release();
+    out_emit(&p);
+}
+
+void rx_set_output_buffer(size_t size) {
+    out_pending p = OUT_PENDING_INIT;
+    out_acquire();
+    out_drain(&p);
+    char* buf = out_inline;
+    if (size > sizeof(out_inline)) {
+        buf = (char*)malloc(size);
+        if (!buf) {
+            buf = out_inline;
+            size = sizeof(out_inline);
+        }
+    }
+    char* old = out_buf != out_inline ? out_buf : NULL;
+    out_buf = buf;
+    out_size = size;
+    out_release();
+    out_emit(&p);
+    free(old);
+}
+
+/* ============================================================================
+ * Number Formatting
+ * ============================================================================ */
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Digits of v, right-aligned ending at end; returns the first digit */
+static char* format_digits(char* end, uint64_t v) {
+    while (v >= 100) {
+        unsigned d = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--end = digit_pairs[d + 1];
+        *--end = digit_pairs[d];
+    }
+    if (v >= 10) {
+        *--end = digit_pairs[v * 2 + 1];
+        *--end = digit_pairs[v * 2];
     } else {
-        puts("(null)");
+        *--end = (char)('0' + v);
     }
+    return end;
 }
 
-void print(rx_string s) {
-    if (RX_LIKELY(s != NULL)) {
-        fputs(s, stdout);
+int rx_format_int(char* out, rx_int n) {
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    uint64_t v = n < 0 ? 0 - (uint64_t)n : (uint64_t)n;
+    char* p = format_digits(end, v);
+    if (n < 0) *--p = '-';
+    int len = (int)(end - p);
+    memcpy(out, p, (size_t)len);
+    out[len] = '\0';
+    return len;
+}
+
+static const double pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+};
+
+/*
+ * %g keeps 6 significant digits and uses fixed notation for exponents -4
+ * to 5. That range is formatted here by scaling to a 6-digit integer;
+ * values whose rounding is within reach of a tie, and everything outside
+ * the range, go to snprintf so the output always matches it.
+ */
+int rx_format_float(char* out, rx_float n) {
+    double a = n < 0 ? -n : n;
+    if (a == 0) {
+        const char* zero = signbit(n) ? "-0" : "0";
+        memcpy(out, zero, strlen(zero) + 1);
+        return (int)strlen(zero);
+    }
+    if (!(a >= 1e-4 && a < 1e6)) {
+        return snprintf(out, RX_NUMBER_CHARS, "%g", n);
+    }
+
+    int exp10 = 0;
+    if (a >= 1) {
+        while (exp10 < 5 && a >= pow10_table[exp10 + 1]) exp10++;
     } else {
-        fputs("(null)", stdout);
+        exp10 = -1;
+        while (exp10 > -4 && a * pow10_table[-exp10] < 1) exp10--;
     }
+
+    int frac_digits = 5 - exp10;              /* 1..9 */
+    double scaled = a * pow10_table[frac_digits];
+    double rounded = floor(scaled + 0.5);
+    double off = scaled - floor(scaled);
+    if (fabs(off - 0.5) < 1e-6 || rounded >= 1e6 || rounded < 1e5) {
+        return snprintf(out, RX_NUMBER_CHARS, "%g", n);
+    }
+
+    /* Six digits; split into integer and fraction, trim trailing zeros */
+    char digits[8];
+    format_digits(digits + 6, (uint64_t)rounded);
+    int int_digits = exp10 + 1;               /* <= 0 means leading "0." */
+    int last = 5;
+    while (last >= int_digits && last > 0 && digits[last] == '0') last--;
+
+    char* p = out;
+    if (n < 0) *p++ = '-';
+    if (int_digits <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for (int z = int_digits; z < 0; z++) *p++ = '0';
+        for (int k = 0; k <= last; k++) *p++ = digits[k];
+    } else {
+        for (int k = 0; k < int_digits; k++) *p++ = digits[k];
+        if (last >= int_digits) {
+            *p++ = '.';
+            for (int k = int_digits; k <= last; k++) *p++ = digits[k];
+        }
+    }
+    *p = '\0';
+    return (int)(p - out);
+}
+
+/* ============================================================================
+ * Print Functions
+ * ============================================================================ */
+
+void println(rx_string s) {
+    if (RX_UNLIKELY(s == NULL)) s = "(null)";
+    size_t len = strlen(s);
+    out_pending p = OUT_PENDING_INIT;
+    out_acquire();
+    out_write(&p, s, len);
+    out_write(&p, "\n", 1);
+    out_release();
+    out_emit(&p);
+}
+
+void print(rx_string s) {
+    if (RX_UNLIKELY(s == NULL)) s = "(null)";
+    out_put(s, strlen(s));
 }
 
 void print_int(rx_int n) {
-    printf("%ld", (long)n);
+    char buf[RX_NUMBER_CHARS];
+    out_put(buf, (size_t)rx_format_int(buf, n));
 }
 
 void print_float(rx_float n) {
-    printf("%g", n);
+    char buf[RX_NUMBER_CHARS];
+    out_put(buf, (size_t)rx_format_float(buf, n));
 }
 
 void print_bool(rx_bool b) {
-    fputs(b ? "true" : "false", stdout);
+    if (b) out_put("true", 4);
+    else out_put("false", 5);
 }
 
 void printf_rx(rx_string fmt, ...) {
-    va_list args;
+    char small[256];
+    va_list args, copy;
     va_start(args, fmt);
-    vprintf(fmt, args);
+    va_copy(copy, args);
+    int len = vsnprintf(small, sizeof(small), fmt, args);
+    if (len >= (int)sizeof(small)) {
+        char* big = (char*)malloc((size_t)len + 1);
+        if (big) {
+            vsnprintf(big, (size_t)len + 1, fmt, copy);
+            out_put(big, (size_t)len);
+            free(big);
+        }
+    } else if (len > 0) {
+        out_put(small, (size_t)len);
+    }
+    va_end(copy);
     va_end(args);
 }
 
@@ -57,66 +328,104 @@ void printf_rx(rx_string fmt, ...) {
  * String Functions
  * ============================================================================ */
 
-rx_str str_new(const char* s) {
-    rx_str result;
-    if (RX_UNLIKELY(s == NULL)) {
-        result.data = NULL;
-        result.len = 0;
-        result.capacity = 0;
-        return result;
+static inline bool str_is_small(const rx_str* s) {
+    return s->small.tag <= RX_STR_SMALL;
+}
+
+static inline void str_set_len(rx_str* s, size_t len) {
+    if (str_is_small(s)) {
+        s->small.tag = (uint8_t)len;
+        s->small.data[len] = '\0';
+    } else {
+        s->heap.len = len;
+        s->heap.ptr[len] = '\0';
     }
-    
-    size_t len = strlen(s);
-    result.len = len;
-    result.capacity = len + 1;
-    result.data = (char*)malloc(result.capacity);
-    if (RX_LIKELY(result.data != NULL)) {
-        memcpy(result.data, s, len + 1);
+}
+
+/* Fresh string with room for len bytes; contents and terminator are the
+ * caller's. NULL (and "" in out) if the allocation fails. */
+static char* str_init(rx_str* out, size_t len) {
+    memset(out, 0, sizeof(*out));
+    if (len <= RX_STR_SMALL) {
+        out->small.tag = (uint8_t)len;
+        return out->small.data;
+    }
+    if (RX_UNLIKELY(len >= UINT32_MAX)) return NULL;
+    char* data = (char*)malloc(len + 1);
+    if (RX_UNLIKELY(!data)) return NULL;
+    out->heap.ptr = data;
+    out->heap.len = len;
+    out->heap.capacity = (uint32_t)(len + 1);
+    out->small.tag = RX_STR_HEAP;
+    return data;
+}
+
+/* Make s writable with room for len bytes; interned strings are copied */
+static bool str_reserve(rx_str* s, size_t len) {
+    if (str_is_small(s) && len <= RX_STR_SMALL) return true;
+    if (s->small.tag == RX_STR_HEAP && len < s->heap.capacity) return true;
+
+    size_t cur = str_len(s);
+    size_t capacity = (len + 1) * 2;
+    if (RX_UNLIKELY(capacity > UINT32_MAX)) capacity = len + 1;
+    if (RX_UNLIKELY(capacity > UINT32_MAX)) return false;
+
+    char* data;
+    if (s->small.tag == RX_STR_HEAP) {
+        data = (char*)realloc(s->heap.ptr, capacity);
+        if (RX_UNLIKELY(!data)) return false;
+    } else {
+        data = (char*)malloc(capacity);
+        if (RX_UNLIKELY(!data)) return false;
+        memcpy(data, str_data(s), cur + 1);
+    }
+    s->heap.ptr = data;
+    s->heap.len = cur;
+    s->heap.capacity = (uint32_t)capacity;
+    s->small.tag = RX_STR_HEAP;
+    return true;
+}
+
+rx_str str_from(const char* s, size_t len) {
+    rx_str result;
+    char* data = str_init(&result, s ? len : 0);
+    if (RX_LIKELY(data != NULL)) {
+        if (s) memcpy(data, s, len);
+        data[s ? len : 0] = '\0';
     }
     return result;
 }
 
+rx_str str_new(const char* s) {
+    return str_from(s, s ? strlen(s) : 0);
+}
+
 rx_str str_with_capacity(size_t capacity) {
     rx_str result;
-    result.len = 0;
-    result.capacity = capacity > 0 ? capacity : 16;
-    result.data = (char*)malloc(result.capacity);
-    if (RX_LIKELY(result.data != NULL)) {
-        result.data[0] = '\0';
-    }
+    memset(&result, 0, sizeof(result));
+    if (capacity > RX_STR_SMALL + 1) str_reserve(&result, capacity - 1);
     return result;
 }
 
 void str_free(rx_str* s) {
-    if (s && s->data) {
-        free(s->data);
-        s->data = NULL;
-        s->len = 0;
-        s->capacity = 0;
-    }
+    if (!s) return;
+    if (s->small.tag == RX_STR_HEAP) free(s->heap.ptr);
+    memset(s, 0, sizeof(*s));
 }
 
 size_t str_len(const rx_str* s) {
-    return s ? s->len : 0;
+    if (!s) return 0;
+    return str_is_small(s) ? s->small.tag : s->heap.len;
 }
 
 rx_str str_concat(const rx_str* a, const rx_str* b) {
+    size_t a_len = str_len(a), b_len = str_len(b);
     rx_str result;
-    size_t total_len = (a ? a->len : 0) + (b ? b->len : 0);
-    result.len = total_len;
-    result.capacity = total_len + 1;
-    result.data = (char*)malloc(result.capacity);
-    
-    if (RX_LIKELY(result.data != NULL)) {
-        size_t pos = 0;
-        if (a && a->data) {
-            memcpy(result.data, a->data, a->len);
-            pos = a->len;
-        }
-        if (b && b->data) {
-            memcpy(result.data + pos, b->data, b->len);
-        }
-        result.data[total_len] = '\0';
+    char* data = str_init(&result, a_len + b_len);
+    if (RX_LIKELY(data != NULL)) {
+        memcpy(data, str_data(a), a_len);
+        memcpy(data + a_len, str_data(b), b_len);
+        data[a_len + b_len] = '\0';
     }
     return result;
 }
@@ -124,53 +433,38 @@ rx_str str_concat(const rx_str* a, const rx_str* b) {
 void str_append(rx_str* s, const char* suffix) {
     if (RX_UNLIKELY(!s || !suffix)) return;
     
+    size_t len = str_len(s);
     size_t suffix_len = strlen(suffix);
-    size_t new_len = s->len + suffix_len;
+    if (RX_UNLIKELY(!str_reserve(s, len + suffix_len))) return;
     
-    if (new_len + 1 > s->capacity) {
-        size_t new_capacity = (new_len + 1) * 2;
-        char* new_data = (char*)realloc(s->data, new_capacity);
-        if (RX_UNLIKELY(!new_data)) return;
-        s->data = new_data;
-        s->capacity = new_capacity;
-    }
-    
-    memcpy(s->data + s->len, suffix, suffix_len + 1);
-    s->len = new_len;
+    memcpy((char*)str_data(s) + len, suffix, suffix_len);
+    str_set_len(s, len + suffix_len);
 }
 
 int str_cmp(const rx_str* a, const rx_str* b) {
-    if (!a || !a->data) return b && b->data ? -1 : 0;
-    if (!b || !b->data) return 1;
-    return strcmp(a->data, b->data);
+    size_t a_len = str_len(a), b_len = str_len(b);
+    int c = memcmp(str_data(a), str_data(b), a_len < b_len ? a_len : b_len);
+    if (c != 0) return c;
+    return a_len < b_len ? -1 : a_len > b_len;
 }
 
 bool str_eq(const rx_str* a, const rx_str* b) {
-    return str_cmp(a, b) == 0;
+    if (str_is_interned(a) && str_is_interned(b)) {
+        return a->heap.ptr == b->heap.ptr;
+    }
+    size_t len = str_len(a);
+    return len == str_len(b) && memcmp(str_data(a), str_data(b), len) == 0;
 }
 
 rx_str str_substr(const rx_str* s, size_t start, size_t len) {
-    rx_str result = {NULL, 0, 0};
-    if (RX_UNLIKELY(!s || !s->data || start >= s->len)) return result;
-    
-    if (start + len > s->len) {
-        len = s->len - start;
-    }
-    
-    result.len = len;
-    result.capacity = len + 1;
-    result.data = (char*)malloc(result.capacity);
-    if (RX_LIKELY(result.data != NULL)) {
-        memcpy(result.data, s->data + start, len);
-        result.data[len] = '\0';
-    }
-    return result;
+    return str_view_to_str(str_view_substr(str_view(s), start, len));
 }
 
 int64_t str_find(const rx_str* s, const char* needle) {
-    if (RX_UNLIKELY(!s || !s->data || !needle)) return -1;
-    char* found = strstr(s->data, needle);
-    return found ? (int64_t)(found - s->data) : -1;
+    if (RX_UNLIKELY(!s || !needle)) return -1;
+    const char* data = str_data(s);
+    const char* found = strstr(data, needle);
+    return found ? (int64_t)(found - data) : -1;
 }
 
 bool str_contains(const rx_str* s, const char* needle) {
@@ -178,103 +472,277 @@ bool str_contains(const rx_str* s, const char* needle) {
 }
 
 bool str_starts_with(const rx_str* s, const char* prefix) {
-    if (RX_UNLIKELY(!s || !s->data || !prefix)) return false;
-    size_t prefix_len = strlen(prefix);
-    if (prefix_len > s->len) return false;
-    return memcmp(s->data, prefix, prefix_len) == 0;
+    if (RX_UNLIKELY(!s || !prefix)) return false;
+    return str_view_starts_with(str_view(s), str_view_of(prefix));
 }
 
 bool str_ends_with(const rx_str* s, const char* suffix) {
-    if (RX_UNLIKELY(!s || !s->data || !suffix)) return false;
-    size_t suffix_len = strlen(suffix);
-    if (suffix_len > s->len) return false;
-    return memcmp(s->data + s->len - suffix_len, suffix, suffix_len) == 0;
+    if (RX_UNLIKELY(!s || !suffix)) return false;
+    return str_view_ends_with(str_view(s), str_view_of(suffix));
 }
 
 rx_str str_to_upper(const rx_str* s) {
-    rx_str result = {NULL, 0, 0};
-    if (RX_UNLIKELY(!s || !s->data)) return result;
-    
-    result.len = s->len;
-    result.capacity = s->len + 1;
-    result.data = (char*)malloc(result.capacity);
-    if (RX_LIKELY(result.data != NULL)) {
-        for (size_t i = 0; i < s->len; i++) {
-            result.data[i] = (char)toupper((unsigned char)s->data[i]);
+    size_t len = str_len(s);
+    const char* src = str_data(s);
+    rx_str result;
+    char* data = str_init(&result, len);
+    if (RX_LIKELY(data != NULL)) {
+        for (size_t i = 0; i < len; i++) {
+            data[i] = (char)toupper((unsigned char)src[i]);
         }
-        result.data[s->len] = '\0';
+        data[len] = '\0';
     }
     return result;
 }
 
 rx_str str_to_lower(const rx_str* s) {
-    rx_str result = {NULL, 0, 0};
-    if (RX_UNLIKELY(!s || !s->data)) return result;
-    
-    result.len = s->len;
-    result.capacity = s->len + 1;
-    result.data = (char*)malloc(result.capacity);
-    if (RX_LIKELY(result.data != NULL)) {
-        for (size_t i = 0; i < s->len; i++) {
-            result.data[i] = (char)tolower((unsigned char)s->data[i]);
+    size_t len = str_len(s);
+    const char* src = str_data(s);
+    rx_str result;
+    char* data = str_init(&result, len);
+    if (RX_LIKELY(data != NULL)) {
+        for (size_t i = 0; i < len; i++) {
+            data[i] = (char)tolower((unsigned char)src[i]);
         }
-        result.data[s->len] = '\0';
+        data[len] = '\0';
     }
     return result;
 }
 
 rx_str str_trim(const rx_str* s) {
-    rx_str result = {NULL, 0, 0};
-    if (RX_UNLIKELY(!s || !s->data)) return result;
-    
-    size_t start = 0;
-    while (start < s->len && isspace((unsigned char)s->data[start])) {
-        start++;
-    }
-    
-    size_t end = s->len;
-    while (end > start && isspace((unsigned char)s->data[end - 1])) {
-        end--;
-    }
-    
-    return str_substr(s, start, end - start);
+    return str_view_to_str(str_view_trim(str_view(s)));
 }
 
 rx_array str_split(const rx_str* s, char delimiter) {
     rx_array result = array_new(sizeof(rx_str), 8);
-    if (RX_UNLIKELY(!s || !s->data)) return result;
+    if (RX_UNLIKELY(!s)) return result;
     
-    size_t start = 0;
-    for (size_t i = 0; i <= s->len; i++) {
-        if (i == s->len || s->data[i] == delimiter) {
-            rx_str part = str_substr(s, start, i - start);
-            array_push(&result, &part);
-            start = i + 1;
-        }
+    rx_str_split_iter it = str_split_iter(str_view(s), delimiter);
+    rx_str_view field;
+    while (str_split_next(&it, &field)) {
+        rx_str part = str_view_to_str(field);
+        array_push(&result, &part);
     }
     return result;
 }
 
+/* Numbers always fit the inline buffer, so no allocation */
 rx_str int_to_str(rx_int n) {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%ld", (long)n);
-    return str_new(buffer);
+    char buffer[RX_NUMBER_CHARS];
+    return str_from(buffer, (size_t)rx_format_int(buffer, n));
 }
 
 rx_str float_to_str(rx_float n) {
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "%g", n);
-    return str_new(buffer);
+    char buffer[RX_NUMBER_CHARS];
+    int len = rx_format_float(buffer, n);
+    return str_from(buffer, len > 0 ? (size_t)len : 0);
 }
 
 rx_int str_to_int(const rx_str* s) {
-    if (RX_UNLIKELY(!s || !s->data)) return 0;
-    return (rx_int)atoll(s->data);
+    return (rx_int)atoll(str_data(s));
 }
 
 rx_float str_to_float(const rx_str* s) {
-    if (RX_UNLIKELY(!s || !s->data)) return 0.0;
-    return atof(s->data);
+    return atof(str_data(s));
+}
+
+/* ============================================================================
+ * String Views
+ * ============================================================================ */
+
+rx_str_view str_view(const rx_str* s) {
+    return (rx_str_view){ str_data(s), str_len(s) };
+}
+
+rx_str_view str_view_of(const char* s) {
+    return s ? (rx_str_view){ s, strlen(s) } : (rx_str_view){ "", 0 };
+}
+
+rx_str_view str_view_substr(rx_str_view v, size_t start, size_t len) {
+    if (RX_UNLIKELY(start >= v.len)) return (rx_str_view){ v.data + v.len, 0 };
+    if (len > v.len - start) {
+        len = v.len - start;
+    }
+    return (rx_str_view){ v.data + start, len };
+}
+
+rx_str_view str_view_trim(rx_str_view v) {
+    size_t start = 0;
+    size_t end = v.len;
+    while (start < end && isspace((unsigned char)v.data[start])) {
+        start++;
+    }
+    while (end > start && isspace((unsigned char)v.data[end - 1])) {
+        end--;
+    }
+    return (rx_str_view){ v.data + start, end - start };
+}
+
+int64_t str_view_find(rx_str_view v, rx_str_view needle) {
+    if (needle.len == 0) return 0;
+    if (needle.len > v.len) return -1;
+    const char* p = v.data;
+    const char* last = v.data + v.len - needle.len;
+    while (p <= last) {
+        p = (const char*)memchr(p, needle.data[0], (size_t)(last - p) + 1);
+        if (!p) return -1;
+        if (memcmp(p, needle.data, needle.len) == 0) return (int64_t)(p - v.data);
+        p++;
+    }
+    return -1;
+}
+
+bool str_view_eq(rx_str_view a, rx_str_view b) {
+    return a.len == b.len && memcmp(a.data, b.data, a.len) == 0;
+}
+
+bool str_view_starts_with(rx_str_view v, rx_str_view prefix) {
+    return prefix.len <= v.len && memcmp(v.data, prefix.data, prefix.len) == 0;
+}
+
+bool str_view_ends_with(rx_str_view v, rx_str_view suffix) {
+    return suffix.len <= v.len &&
+           memcmp(v.data + v.len - suffix.len, suffix.data, suffix.len) == 0;
+}
+
+rx_str str_view_to_str(rx_str_view v) {
+    return str_from(v.data, v.len);
+}
+
+const char* str_view_to_cstr(rx_str_view v, rx_str* scratch) {
+    if (RX_UNLIKELY(!scratch)) return NULL;
+    /* v may point into scratch, whose buffer reserving can move */
+    const char* old = str_data(scratch);
+    bool aliased = v.data >= old && v.data <= old + str_len(scratch);
+    size_t offset = aliased ? (size_t)(v.data - old) : 0;
+    if (RX_UNLIKELY(!str_reserve(scratch, v.len))) return NULL;
+    char* data = (char*)str_data(scratch);
+    memmove(data, aliased ? data + offset : v.data, v.len);
+    str_set_len(scratch, v.len);
+    return data;
+}
+
+rx_array str_view_split(rx_str_view v, char delimiter) {
+    rx_array result = array_new(sizeof(rx_str_view), 8);
+    rx_str_split_iter it = str_split_iter(v, delimiter);
+    rx_str_view field;
+    while (str_split_next(&it, &field)) {
+        array_push(&result, &field);
+    }
+    return result;
+}
+
+rx_str_split_iter str_split_iter(rx_str_view v, char delimiter) {
+    return (rx_str_split_iter){ v.data, v.len, 0, delimiter };
+}
+
+bool str_split_next(rx_str_split_iter* it, rx_str_view* out) {
+    if (RX_UNLIKELY(!it || it->pos > it->len)) return false;
+    const char* start = it->data + it->pos;
+    size_t left = it->len - it->pos;
+    const char* end = (const char*)memchr(start, it->delimiter, left);
+    size_t field = end ? (size_t)(end - start) : left;
+    if (out) *out = (rx_str_view){ start, field };
+    it->pos += field + 1;     /* Past the end after the last field */
+    return true;
+}
+
+/* ============================================================================
+ * String Interning
+ * ============================================================================ */
+
+typedef struct intern_entry {
+    uint64_t hash;
+    char* data;             /* NULL: empty slot */
+    size_t len;
+} intern_entry;
+
+static intern_entry* intern_slots;
+static size_t intern_capacity;      /* Power of two */
+static size_t intern_count;
+static atomic_flag intern_lock = ATOMIC_FLAG_INIT;
+
+/* FNV-1a */
+static uint64_t intern_hash(const char* s, size_t len) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static bool intern_grow(void) {
+    size_t capacity = intern_capacity ? intern_capacity * 2 : 256;
+    intern_entry* slots = (intern_entry*)calloc(capacity, sizeof(intern_entry));
+    if (!slots) return false;
+    for (size_t i = 0; i < intern_capacity; i++) {
+        intern_entry* e = &intern_slots[i];
+        if (!e->data) continue;
+        size_t j = (size_t)e->hash & (capacity - 1);
+        while (slots[j].data) j = (j + 1) & (capacity - 1);
+        slots[j] = *e;
+    }
+    free(intern_slots);
+    intern_slots = slots;
+    intern_capacity = capacity;
+    return true;
+}
+
+/* The table's copy of s, added if new; NULL if out of memory */
+static const char* intern_find(const char* s, size_t len) {
+    uint64_t hash = intern_hash(s, len);
+    const char* found = NULL;
+
+    while (atomic_flag_test_and_set_explicit(&intern_lock, memory_order_acquire)) {
+    }
+    if ((intern_count + 1) * 4 > intern_capacity * 3 && !intern_grow()) {
+        atomic_flag_clear_explicit(&intern_lock, memory_order_release);
+        return NULL;
+    }
+    size_t i = (size_t)hash & (intern_capacity - 1);
+    for (;; i = (i + 1) & (intern_capacity - 1)) {
+        intern_entry* e = &intern_slots[i];
+        if (!e->data) {
+            char* data = (char*)malloc(len + 1);
+            if (data) {
+                memcpy(data, s, len);
+                data[len] = '\0';
+                *e = (intern_entry){ hash, data, len };
+                intern_count++;
+            }
+            found = data;
+            break;
+        }
+        if (e->hash == hash && e->len == len && memcmp(e->data, s, len) == 0) {
+            found = e->data;
+            break;
+        }
+    }
+    atomic_flag_clear_explicit(&intern_lock, memory_order_release);
+    return found;
+}
+
+rx_str str_intern_len(const char* s, size_t len) {
+    if (RX_UNLIKELY(!s)) len = 0;
+    const char* data = intern_find(s ? s : "", len);
+    if (RX_UNLIKELY(!data)) return str_from(s, len);   /* Plain copy instead */
+
+    rx_str result;
+    memset(&result, 0, sizeof(result));
+    result.heap.ptr = (char*)data;
+    result.heap.len = len;
+    result.small.tag = RX_STR_INTERNED;
+    return result;
+}
+
+rx_str str_intern(const char* s) {
+    return str_intern_len(s, s ? strlen(s) : 0);
+}
+
+const char* str_intern_cstr(const char* s) {
+    if (RX_UNLIKELY(!s)) s = "";
+    return intern_find(s, strlen(s));
 }
 
 /* ============================================================================
@@ -362,15 +830,19 @@ rx_float trunc_float(rx_float x) {
  * Memory Functions
  * ============================================================================ */
 
+/* Zeroed: FFI callers (reox_ffi.h) have always relied on it */
 void* rx_alloc(size_t size) {
-    return malloc(size);
+    RX_FRAME_COUNT(RX_COUNTER_ALLOCATIONS, 1);
+    return calloc(1, size);
 }
 
 void* rx_calloc(size_t count, size_t size) {
+    RX_FRAME_COUNT(RX_COUNTER_ALLOCATIONS, 1);
     return calloc(count, size);
 }
 
 void* rx_realloc(void* ptr, size_t size) {
+    RX_FRAME_COUNT(RX_COUNTER_ALLOCATIONS, 1);
     return realloc(ptr, size);
 }
 
@@ -386,6 +858,180 @@ void rx_memset(void* ptr, int value, size_t n) {
     memset(ptr, value, n);
 }
 
+/* ============================================================================
+ * Arena Allocation
+ * ============================================================================ */
+
+typedef struct rx_arena_block {
+    struct rx_arena_block* next;
+    size_t size;                  /* Usable bytes after the header */
+    size_t used;
+} rx_arena_block;
+
+struct rx_arena {
+    rx_arena_block* first;
+    rx_arena_block* current;
+    size_t block_size;
+    size_t used;                  /* In blocks before current */
+};
+
+#define ARENA_HEADER ((sizeof(rx_arena_block) + RX_ARENA_ALIGN - 1) & ~(size_t)(RX_ARENA_ALIGN - 1))
+
+static inline char* arena_base(rx_arena_block* block) {
+    return (char*)block + ARENA_HEADER;
+}
+
+rx_arena* rx_arena_create(size_t block_size) {
+    rx_arena* arena = (rx_arena*)calloc(1, sizeof(rx_arena));
+    if (!arena) return NULL;
+    arena->block_size = block_size ? block_size : RX_ARENA_BLOCK_DEFAULT;
+    return arena;
+}
+
+void rx_arena_destroy(rx_arena* arena) {
+    if (!arena) return;
+    rx_arena_block* block = arena->first;
+    while (block) {
+        rx_arena_block* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+/* Move to a block after current with room for size, making one if needed */
+static RX_NOINLINE void* arena_alloc_slow(rx_arena* arena, size_t size) {
+    rx_arena_block* prev = arena->current;
+    rx_arena_block* next = prev ? prev->next : arena->first;
+    if (!next || next->size < size) {
+        size_t usable = size > arena->block_size ? size : arena->block_size;
+        rx_arena_block* block = (rx_arena_block*)malloc(ARENA_HEADER + usable);
+        if (RX_UNLIKELY(!block)) return NULL;
+        block->size = usable;
+        block->next = next;
+        if (prev) prev->next = block;
+        else arena->first = block;
+        next = block;
+    }
+    if (prev) arena->used += prev->used;
+    next->used = size;
+    arena->current = next;
+    return arena_base(next);
+}
+
+void* rx_arena_alloc(rx_arena* arena, size_t size) {
+    if (RX_UNLIKELY(!arena)) return NULL;
+    size = (size + RX_ARENA_ALIGN - 1) & ~(size_t)(RX_ARENA_ALIGN - 1);
+    rx_arena_block* block = arena->current;
+    if (RX_LIKELY(block && block->size - block->used >= size)) {
+        void* p = arena_base(block) + block->used;
+        block->used += size;
+        return p;
+    }
+    return arena_alloc_slow(arena, size);
+}
+
+void* rx_arena_calloc(rx_arena* arena, size_t count, size_t size) {
+    if (RX_UNLIKELY(size && count > SIZE_MAX / size)) return NULL;
+    void* p = rx_arena_alloc(arena, count * size);
+    if (RX_LIKELY(p != NULL)) memset(p, 0, count * size);
+    return p;
+}
+
+char* rx_arena_strdup(rx_arena* arena, const char* s) {
+    if (!s) s = "";
+    size_t len = strlen(s);
+    char* p = (char*)rx_arena_alloc(arena, len + 1);
+    if (RX_LIKELY(p != NULL)) memcpy(p, s, len + 1);
+    return p;
+}
+
+static char* arena_vprintf(rx_arena* arena, const char* fmt, va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (RX_UNLIKELY(len < 0)) return NULL;
+    char* p = (char*)rx_arena_alloc(arena, (size_t)len + 1);
+    if (RX_LIKELY(p != NULL)) vsnprintf(p, (size_t)len + 1, fmt, args);
+    return p;
+}
+
+char* rx_arena_printf(rx_arena* arena, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    char* p = arena_vprintf(arena, fmt, args);
+    va_end(args);
+    return p;
+}
+
+rx_arena_mark rx_arena_push(rx_arena* arena) {
+    rx_arena_mark mark = { NULL, 0 };
+    if (arena && arena->current) {
+        mark.block = arena->current;
+        mark.used = arena->current->used;
+    }
+    return mark;
+}
+
+void rx_arena_pop(rx_arena* arena, rx_arena_mark mark) {
+    if (!arena) return;
+    if (!mark.block) {
+        rx_arena_reset(arena);
+        return;
+    }
+    /* Later blocks stay linked after the mark's block for reuse */
+    size_t used = 0;
+    for (rx_arena_block* b = arena->first; b && b != mark.block; b = b->next) {
+        used += b->used;
+    }
+    arena->current = (rx_arena_block*)mark.block;
+    arena->current->used = mark.used;
+    arena->used = used;
+}
+
+void rx_arena_reset(rx_arena* arena) {
+    if (!arena) return;
+    arena->current = arena->first;
+    arena->used = 0;
+    if (arena->current) arena->current->used = 0;
+}
+
+size_t rx_arena_used(const rx_arena* arena) {
+    if (!arena) return 0;
+    return arena->used + (arena->current ? arena->current->used : 0);
+}
+
+static rx_arena* frame_arena;
+
+rx_arena* rx_frame_arena(void) {
+    if (RX_UNLIKELY(!frame_arena)) frame_arena = rx_arena_create(0);
+    return frame_arena;
+}
+
+void rx_frame_arena_reset(void) {
+    rx_arena_reset(frame_arena);
+}
+
+void* rx_frame_alloc(size_t size) {
+    return rx_arena_alloc(rx_frame_arena(), size);
+}
+
+char* rx_frame_printf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    char* p = arena_vprintf(rx_frame_arena(), fmt, args);
+    va_end(args);
+    return p;
+}
+
+static _Thread_local rx_arena* scope_arena;
+
+rx_arena* rx_scope_arena(void) {
+    if (RX_UNLIKELY(!scope_arena)) scope_arena = rx_arena_create(0);
+    return scope_arena;
+}
+
 /* ============================================================================
  * Array Functions
  * ============================================================================ */
@@ -396,6 +1042,7 @@ rx_array array_new(size_t elem_size, size_t initial_capacity) {
     arr.len = 0;
     arr.capacity = initial_capacity > 0 ? initial_capacity : 8;
     arr.data = malloc(arr.capacity * elem_size);
+    if (RX_UNLIKELY(!arr.data)) arr.capacity = 0;
     return arr;
 }
 
@@ -412,22 +1059,83 @@ size_t array_len(const rx_array* arr) {
     return arr ? arr->len : 0;
 }
 
+static bool array_set_capacity(rx_array* arr, size_t capacity) {
+    if (RX_UNLIKELY(arr->elem_size && capacity > SIZE_MAX / arr->elem_size)) return false;
+    void* data = realloc(arr->data, capacity * arr->elem_size);
+    if (RX_UNLIKELY(!data && capacity)) return false;
+    arr->data = data;
+    arr->capacity = capacity;
+    return true;
+}
+
+/* Room for needed elements, growing geometrically */
+static inline bool array_grow(rx_array* arr, size_t needed) {
+    if (RX_LIKELY(needed <= arr->capacity)) return true;
+    size_t capacity = arr->capacity * 2;
+    if (capacity < needed) capacity = needed;
+    if (capacity < 8) capacity = 8;
+    return array_set_capacity(arr, capacity);
+}
+
+bool array_reserve(rx_array* arr, size_t capacity) {
+    if (RX_UNLIKELY(!arr)) return false;
+    return array_grow(arr, capacity);
+}
+
+void array_shrink(rx_array* arr) {
+    if (!arr || arr->len == arr->capacity) return;
+    if (arr->len == 0) {
+        free(arr->data);
+        arr->data = NULL;
+        arr->capacity = 0;
+        return;
+    }
+    array_set_capacity(arr, arr->len);
+}
+
+void array_clear(rx_array* arr) {
+    if (arr) arr->len = 0;
+}
+
 void array_push(rx_array* arr, const void* elem) {
     if (RX_UNLIKELY(!arr || !elem)) return;
-    
-    if (RX_UNLIKELY(arr->len >= arr->capacity)) {
-        size_t new_capacity = arr->capacity * 2;
-        void* new_data = realloc(arr->data, new_capacity * arr->elem_size);
-        if (RX_UNLIKELY(!new_data)) return;
-        arr->data = new_data;
-        arr->capacity = new_capacity;
-    }
+    if (RX_UNLIKELY(!array_grow(arr, arr->len + 1))) return;
     
     char* dest = (char*)arr->data + (arr->len * arr->elem_size);
     memcpy(dest, elem, arr->elem_size);
     arr->len++;
 }
 
+bool array_extend(rx_array* arr, const void* src, size_t count) {
+    if (RX_UNLIKELY(!arr || (!src && count))) return false;
+    if (RX_UNLIKELY(count > SIZE_MAX - arr->len)) return false;
+    if (RX_UNLIKELY(!array_grow(arr, arr->len + count))) return false;
+    
+    memcpy((char*)arr->data + arr->len * arr->elem_size, src, count * arr->elem_size);
+    arr->len += count;
+    return true;
+}
+
+bool array_insert(rx_array* arr, size_t index, const void* elem) {
+    if (RX_UNLIKELY(!arr || !elem || index > arr->len)) return false;
+    if (RX_UNLIKELY(!array_grow(arr, arr->len + 1))) return false;
+    
+    char* at = (char*)arr->data + index * arr->elem_size;
+    memmove(at + arr->elem_size, at, (arr->len - index) * arr->elem_size);
+    memcpy(at, elem, arr->elem_size);
+    arr->len++;
+    return true;
+}
+
+void array_remove_range(rx_array* arr, size_t start, size_t count) {
+    if (RX_UNLIKELY(!arr || start >= arr->len)) return;
+    if (count > arr->len - start) count = arr->len - start;
+    
+    char* at = (char*)arr->data + start * arr->elem_size;
+    memmove(at, at + count * arr->elem_size, (arr->len - start - count) * arr->elem_size);
+    arr->len -= count;
+}
+
 void array_pop(rx_array* arr, void* out_elem) {
     if (RX_UNLIKELY(!arr || arr->len == 0)) return;
     
@@ -449,6 +1157,118 @@ void array_set(rx_array* arr, size_t index, const void* elem) {
     memcpy(dest, elem, arr->elem_size);
 }
 
+/* ============================================================================
+ * Array Sorting
+ * ============================================================================ */
+
+/*
+ * Introsort over an array of T: median-of-three quicksort on the larger
+ * side iteratively, heapsort once the depth budget runs out, insertion
+ * sort below 16 elements. LESS(a, b) takes pointers to elements, so the
+ * comparator variants only ever see the array's own storage.
+ */
+#define ARRAY_SORT_SMALL 16
+
+#define DEFINE_ARRAY_SORT(name, T, LESS, CTX)                                   \
+    static void name##_sift(T* a, size_t root, size_t n, CTX) {                 \
+        (void)ctx;                                                              \
+        for (;;) {                                                              \
+            size_t child = root * 2 + 1;                                        \
+            if (child >= n) return;                                             \
+            if (child + 1 < n && LESS(&a[child], &a[child + 1])) child++;       \
+            if (!LESS(&a[root], &a[child])) return;                             \
+            T t = a[root]; a[root] = a[child]; a[child] = t;                    \
+            root = child;                                                       \
+        }                                                                       \
+    }                                                                           \
+    static void name##_heap(T* a, size_t n, CTX) {                              \
+        for (size_t i = n / 2; i-- > 0;) name##_sift(a, i, n, ctx);             \
+        for (size_t end = n; end-- > 1;) {                                      \
+            T t = a[0]; a[0] = a[end]; a[end] = t;                              \
+            name##_sift(a, 0, end, ctx);                                        \
+        }                                                                       \
+    }                                                                           \
+    static void name##_insertion(T* a, size_t n, CTX) {                         \
+        (void)ctx;                                                              \
+        for (size_t i = 1; i < n; i++) {                                        \
+            size_t j = i;                                                       \
+            while (j > 0 && LESS(&a[j], &a[j - 1])) {                           \
+                T t = a[j]; a[j] = a[j - 1]; a[j - 1] = t;                      \
+                j--;                                                            \
+            }                                                                   \
+        }                                                                       \
+    }                                                                           \
+    static void name(T* a, size_t n, CTX) {                                     \
+        int depth = 2;                                                          \
+        for (size_t m = n; m > 1; m >>= 1) depth += 2;                          \
+        while (n > ARRAY_SORT_SMALL) {                                          \
+            if (depth-- == 0) { name##_heap(a, n, ctx); return; }               \
+            /* Median of three to a[0], which is the pivot */                   \
+            size_t mid = n / 2;                                                 \
+            T t;                                                                \
+            if (LESS(&a[mid], &a[0])) { t = a[mid]; a[mid] = a[0]; a[0] = t; }  \
+            if (LESS(&a[n - 1], &a[mid])) {                                     \
+                t = a[n - 1]; a[n - 1] = a[mid]; a[mid] = t;                    \
+                if (LESS(&a[mid], &a[0])) { t = a[mid]; a[mid] = a[0]; a[0] = t; } \
+            }                                                                   \
+            t = a[mid]; a[mid] = a[0]; a[0] = t;                                \
+            /* Hoare partition around a[0]; equal keys split evenly */          \
+            size_t i = 0, j = n;                                                \
+            for (;;) {                                                          \
+                do i++; while (i < n && LESS(&a[i], &a[0]));                    \
+                do j--; while (LESS(&a[0], &a[j]));                             \
+                if (i >= j) break;                                              \
+                t = a[i]; a[i] = a[j]; a[j] = t;                                \
+            }                                                                   \
+            t = a[0]; a[0] = a[j]; a[j] = t;                                    \
+            /* Recurse into the smaller side, loop on the larger */             \
+            if (j < n - j - 1) {                                                \
+                name(a, j, ctx);                                                \
+                a += j + 1;                                                     \
+                n -= j + 1;                                                     \
+            } else {                                                            \
+                name(a + j + 1, n - j - 1, ctx);                                \
+                n = j;                                                          \
+            }                                                                   \
+        }                                                                       \
+        name##_insertion(a, n, ctx);                                            \
+    }
+
+typedef struct { uint64_t lo, hi; } sort_word16;
+
+#define LESS_CMP(x, y) (ctx((x), (y)) < 0)
+#define LESS_VALUE(x, y) (*(x) < *(y))
+/* NaN sorts last */
+#define LESS_F64(x, y) (*(x) < *(y) || (*(y) != *(y) && *(x) == *(x)))
+
+DEFINE_ARRAY_SORT(sort_cmp4, uint32_t, LESS_CMP, rx_array_cmp ctx)
+DEFINE_ARRAY_SORT(sort_cmp8, uint64_t, LESS_CMP, rx_array_cmp ctx)
+DEFINE_ARRAY_SORT(sort_cmp16, sort_word16, LESS_CMP, rx_array_cmp ctx)
+DEFINE_ARRAY_SORT(sort_i64, int64_t, LESS_VALUE, int ctx)
+DEFINE_ARRAY_SORT(sort_f64, double, LESS_F64, int ctx)
+
+void array_sort(rx_array* arr, rx_array_cmp cmp) {
+    if (RX_UNLIKELY(!arr || !cmp || arr->len < 2)) return;
+    void* data = arr->data;
+    bool aligned = ((uintptr_t)data & (arr->elem_size - 1)) == 0;
+    switch (aligned ? arr->elem_size : 0) {
+        case 4:  sort_cmp4((uint32_t*)data, arr->len, cmp); break;
+        case 8:  sort_cmp8((uint64_t*)data, arr->len, cmp); break;
+        case 16: sort_cmp16((sort_word16*)data, arr->len, cmp); break;
+        default: qsort(data, arr->len, arr->elem_size, cmp); break;
+    }
+}
+
+void array_sort_i64(rx_array* arr) {
+    if (RX_UNLIKELY(!arr || arr->len < 2 || arr->elem_size != sizeof(int64_t))) return;
+    sort_i64((int64_t*)arr->data, arr->len, 0);
+}
+
+void array_sort_f64(rx_array* arr) {
+    if (RX_UNLIKELY(!arr || arr->len < 2 || arr->elem_size != sizeof(double))) return;
+    sort_f64((double*)arr->data, arr->len, 0);
+}
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -458,12 +1278,14 @@ RX_NORETURN void rx_exit(int code) {
 }
 
 RX_NORETURN RX_COLD void rx_panic(rx_string message) {
+    rx_flush();     /* Keep earlier output ahead of the message */
     fprintf(stderr, "PANIC: %s\n", message ? message : "unknown error");
     exit(1);
 }
 
 void rx_assert(bool condition, rx_string message) {
     if (RX_UNLIKELY(!condition)) {
+        rx_flush();
         fprintf(stderr, "ASSERTION FAILED: %s\n", message ? message : "assertion failed");
         exit(1);
     }
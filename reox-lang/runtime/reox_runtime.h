@@ -52,13 +52,45 @@ typedef double rx_float;
 typedef const char* rx_string;
 typedef bool rx_bool;
 
-/* String object (heap allocated) */
+/*
+ * String object. Up to RX_STR_SMALL bytes live inside the struct with no
+ * allocation; longer ones are on the heap. Interned strings point into the
+ * global intern table and are never freed. The last byte is the tag: the
+ * small length, RX_STR_HEAP or RX_STR_INTERNED. A zeroed rx_str is "".
+ * Use str_data/str_len rather than the fields.
+ */
+#define RX_STR_SMALL     22
+#define RX_STR_HEAP      0xFF
+#define RX_STR_INTERNED  0xFE
+
 typedef struct rx_str {
-    char* data;
-    size_t len;
-    size_t capacity;
+    union {
+        struct {
+            char* ptr;
+            size_t len;
+            uint32_t capacity;    /* Bytes at ptr, NUL included */
+        } heap;
+        struct {
+            char data[RX_STR_SMALL + 1];
+            uint8_t tag;
+        } small;
+    };
 } rx_str;
 
+/* Non-owning slice of a string; not NUL-terminated */
+typedef struct rx_str_view {
+    const char* data;
+    size_t len;
+} rx_str_view;
+
+/* Streams fields of a string without allocating; see str_split_next */
+typedef struct rx_str_split_iter {
+    const char* data;
+    size_t len;
+    size_t pos;           /* Start of the next field; > len when done */
+    char delimiter;
+} rx_str_split_iter;
+
 /* Array header */
 typedef struct rx_array {
     void* data;
@@ -89,6 +121,27 @@ extern void print_bool(rx_bool b);
 /* Print formatted */
 extern void printf_rx(rx_string fmt, ...);
 
+/*
+ * Output buffering. The print functions append to one runtime buffer that
+ * goes to stdout when full, on rx_flush, and at exit. When stdout is a
+ * terminal each newline flushes as well, so interactive output appears
+ * line by line. Calls are serialized, so threads may print; stdout is
+ * written outside the buffer lock, in order. Writing to stdout directly
+ * (printf) can overtake buffered text; rx_flush first.
+ */
+#define RX_OUTPUT_BUFFER_DEFAULT (64 * 1024)
+
+extern void rx_flush(void);
+/* 0: write through on every call */
+extern void rx_set_output_buffer(size_t size);
+
+/* Number formatting used by print_int/print_float and int_to_str/
+ * float_to_str: "%ld" and "%g" output without going through printf.
+ * out needs RX_NUMBER_CHARS bytes; returns the length, NUL written. */
+#define RX_NUMBER_CHARS 32
+extern int rx_format_int(char* out, rx_int n);
+extern int rx_format_float(char* out, rx_float n);
+
 /* ============================================================================
  * Inline Math Functions (for maximum performance)
  * ============================================================================ */
@@ -156,6 +209,7 @@ extern RX_PURE rx_float trunc_float(rx_float x);
  * ============================================================================ */
 
 extern rx_str str_new(const char* s);
+extern rx_str str_from(const char* s, size_t len);
 extern rx_str str_with_capacity(size_t capacity);
 extern void str_free(rx_str* s);
 extern RX_PURE size_t str_len(const rx_str* s);
@@ -177,6 +231,60 @@ extern rx_str float_to_str(rx_float n);
 extern RX_PURE rx_int str_to_int(const rx_str* s);
 extern RX_PURE rx_float str_to_float(const rx_str* s);
 
+/* ============================================================================
+ * String Views
+ * ============================================================================ */
+
+/*
+ * Views borrow the bytes they point at: a view of an rx_str is valid until
+ * that string is modified or freed. The view variants of the functions
+ * above return slices instead of copies.
+ */
+extern RX_PURE rx_str_view str_view(const rx_str* s);
+extern RX_PURE rx_str_view str_view_of(const char* s);
+extern RX_PURE rx_str_view str_view_substr(rx_str_view v, size_t start, size_t len);
+extern RX_PURE rx_str_view str_view_trim(rx_str_view v);
+extern RX_PURE int64_t str_view_find(rx_str_view v, rx_str_view needle);
+extern RX_PURE bool str_view_eq(rx_str_view a, rx_str_view b);
+extern RX_PURE bool str_view_starts_with(rx_str_view v, rx_str_view prefix);
+extern RX_PURE bool str_view_ends_with(rx_str_view v, rx_str_view suffix);
+/* Owned copy */
+extern rx_str str_view_to_str(rx_str_view v);
+/* NUL-terminated copy in scratch, reusing its buffer across calls */
+extern const char* str_view_to_cstr(rx_str_view v, rx_str* scratch);
+/* Array of rx_str_view into s: one allocation for the array, none per field */
+extern rx_array str_view_split(rx_str_view v, char delimiter);
+
+/* Allocation-free split; yields the same fields as str_split
+ *
+ *     rx_str_split_iter it = str_split_iter(str_view(&line), ',');
+ *     rx_str_view field;
+ *     while (str_split_next(&it, &field)) { ... }
+ */
+extern rx_str_split_iter str_split_iter(rx_str_view v, char delimiter);
+extern bool str_split_next(rx_str_split_iter* it, rx_str_view* out);
+
+/* NUL-terminated contents; valid until s is modified or freed */
+RX_INLINE RX_PURE const char* str_data(const rx_str* s) {
+    if (RX_UNLIKELY(!s)) return "";
+    return s->small.tag > RX_STR_SMALL ? s->heap.ptr : s->small.data;
+}
+
+/*
+ * Intern table: one shared copy per distinct string, kept until exit.
+ * For immutable strings that are compared often, such as view labels and
+ * theme keys; str_eq on two interned strings is a pointer compare.
+ * str_free on an interned string does nothing, and modifying one copies
+ * it first. Safe to call from any thread.
+ */
+extern rx_str str_intern(const char* s);
+extern rx_str str_intern_len(const char* s, size_t len);
+/* The table's copy of s, for use as a plain C string key */
+extern const char* str_intern_cstr(const char* s);
+RX_INLINE RX_PURE bool str_is_interned(const rx_str* s) {
+    return s && s->small.tag == RX_STR_INTERNED;
+}
+
 /* ============================================================================
  * Memory Functions (inline wrappers for performance)
  * ============================================================================ */
@@ -188,6 +296,53 @@ extern void rx_free(void* ptr);
 extern void rx_memcpy(void* dest, const void* src, size_t n);
 extern void rx_memset(void* ptr, int value, size_t n);
 
+/* ============================================================================
+ * Arena Allocation
+ * ============================================================================ */
+
+/*
+ * Bump allocator for short-lived data. Allocation is a pointer bump within
+ * a block; nothing is freed individually. rx_arena_push/rx_arena_pop free
+ * everything allocated between them, and rx_arena_reset frees all of it.
+ * Blocks are kept for reuse, so a steady workload stops calling malloc
+ * after its first pass. An arena is single-threaded.
+ */
+typedef struct rx_arena rx_arena;
+
+typedef struct rx_arena_mark {
+    void* block;
+    size_t used;
+} rx_arena_mark;
+
+#define RX_ARENA_ALIGN 16
+#define RX_ARENA_BLOCK_DEFAULT (64 * 1024)
+
+/* block_size 0: RX_ARENA_BLOCK_DEFAULT */
+extern rx_arena* rx_arena_create(size_t block_size);
+extern void rx_arena_destroy(rx_arena* arena);
+/* RX_ARENA_ALIGN aligned; NULL only when out of memory */
+extern void* rx_arena_alloc(rx_arena* arena, size_t size);
+extern void* rx_arena_calloc(rx_arena* arena, size_t count, size_t size);
+extern char* rx_arena_strdup(rx_arena* arena, const char* s);
+extern char* rx_arena_printf(rx_arena* arena, const char* fmt, ...);
+extern rx_arena_mark rx_arena_push(rx_arena* arena);
+extern void rx_arena_pop(rx_arena* arena, rx_arena_mark mark);
+extern void rx_arena_reset(rx_arena* arena);
+/* Bytes handed out since the last reset */
+extern RX_PURE size_t rx_arena_used(const rx_arena* arena);
+
+/*
+ * Frame arena: scratch that lives until the end of the current frame, when
+ * rx_frame resets it. UI thread only.
+ */
+extern rx_arena* rx_frame_arena(void);
+extern void rx_frame_arena_reset(void);
+extern void* rx_frame_alloc(size_t size);
+extern char* rx_frame_printf(const char* fmt, ...);
+
+/* Per-thread arena for scope-bound allocations (compiled `scoped_alloc`) */
+extern rx_arena* rx_scope_arena(void);
+
 /* ============================================================================
  * Array Functions
  * ============================================================================ */
@@ -200,6 +355,29 @@ extern void array_pop(rx_array* arr, void* out_elem);
 extern RX_HOT void* array_get(rx_array* arr, size_t index);
 extern void array_set(rx_array* arr, size_t index, const void* elem);
 
+/*
+ * Capacity grows to max(2x, what is needed), so n pushes cost O(n) copies.
+ * array_reserve sets room up front; array_shrink returns the slack.
+ */
+extern bool array_reserve(rx_array* arr, size_t capacity);
+extern void array_shrink(rx_array* arr);
+extern void array_clear(rx_array* arr);
+/* Append count elements from src in one copy */
+extern bool array_extend(rx_array* arr, const void* src, size_t count);
+/* index may equal len (append); later elements shift up */
+extern bool array_insert(rx_array* arr, size_t index, const void* elem);
+extern void array_remove_range(rx_array* arr, size_t start, size_t count);
+
+/*
+ * Sort with a qsort-style comparator. Element sizes 4, 8 and 16 use an
+ * inlined introsort that swaps whole words; other sizes go to qsort.
+ * Not stable. The typed variants compare without a callback.
+ */
+typedef int (*rx_array_cmp)(const void* a, const void* b);
+extern void array_sort(rx_array* arr, rx_array_cmp cmp);
+extern void array_sort_i64(rx_array* arr);
+extern void array_sort_f64(rx_array* arr);
+
 /* Inline array length for hot paths */
 RX_INLINE RX_PURE size_t array_len_fast(const rx_array* arr) {
     return arr ? arr->len : 0;
@@ -210,6 +388,34 @@ RX_INLINE RX_HOT void* array_get_unchecked(rx_array* arr, size_t index) {
     return (char*)arr->data + (index * arr->elem_size);
 }
 
+/*
+ * Typed access for arrays whose element type is known at compile time;
+ * the code generator emits these. No bounds check and a constant stride,
+ * so loops over them optimize like plain C arrays. The element size must
+ * match the type.
+ */
+#define RX_ARRAY_TYPED(suffix, T)                                               \
+    RX_INLINE T* array_data_##suffix(rx_array* arr) {                          \
+        return (T*)arr->data;                                                   \
+    }                                                                           \
+    RX_INLINE T array_at_##suffix(const rx_array* arr, size_t index) {         \
+        return ((T const*)arr->data)[index];                                    \
+    }                                                                           \
+    RX_INLINE void array_put_##suffix(rx_array* arr, size_t index, T value) {  \
+        ((T*)arr->data)[index] = value;                                         \
+    }                                                                           \
+    RX_INLINE void array_push_##suffix(rx_array* arr, T value) {               \
+        if (RX_UNLIKELY(arr->len >= arr->capacity) &&                           \
+            !array_reserve(arr, arr->len + 1)) return;                          \
+        ((T*)arr->data)[arr->len++] = value;                                    \
+    }
+
+RX_ARRAY_TYPED(i64, int64_t)
+RX_ARRAY_TYPED(f64, double)
+RX_ARRAY_TYPED(bool, bool)
+RX_ARRAY_TYPED(ptr, void*)
+RX_ARRAY_TYPED(cstr, const char*)
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
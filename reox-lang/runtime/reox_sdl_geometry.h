@@ -0,0 +1,232 @@
+/**
+ * @file reox_sdl_geometry.h
+ * @brief Triangle batching for the SDL2 renderers
+ *
+ * Filled primitives are tessellated into triangles and collected in one
+ * vertex/index buffer per frame, then submitted with a single
+ * SDL_RenderGeometry call. Curved edges get a 1px feathered ring that fades
+ * to transparent, which gives anti-aliased circles and rounded corners
+ * without multisampling.
+ *
+ * Anything that draws through another SDL path (textures, clip changes,
+ * present) must call rx_geo_flush() first so draw order is preserved.
+ *
+ * A batch may be bound to a texture (a glyph atlas page). Solid shapes then
+ * sample an opaque texel block so shapes and textured quads still share one
+ * draw call; switching textures flushes.
+ *
+ * Copyright (c) 2025 KetiveeAI - Open Source (MIT License)
+ */
+
+#ifndef REOX_SDL_GEOMETRY_H
+#define REOX_SDL_GEOMETRY_H
+
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "REOX SDL renderers require SDL >= 2.0.18 (SDL_RenderGeometry)"
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Max distance between an arc and its polygon, in pixels */
+#define RX_GEO_TOLERANCE 0.25f
+#define RX_GEO_MAX_ARC_SEGMENTS 32
+
+typedef struct RxGeoBatch {
+    SDL_Vertex* verts;
+    int* indices;
+    int vert_count, vert_capacity;
+    int index_count, index_capacity;
+    SDL_Texture* texture;       /* NULL: untextured */
+    float white_u, white_v;     /* Opaque texel used by solid shapes */
+} RxGeoBatch;
+
+static inline bool rx_geo_reserve(RxGeoBatch* b, int verts, int indices) {
+    if (b->vert_count + verts > b->vert_capacity) {
+        int cap = b->vert_capacity ? b->vert_capacity : 1024;
+        while (cap < b->vert_count + verts) cap *= 2;
+        SDL_Vertex* nv = (SDL_Vertex*)realloc(b->verts, sizeof(SDL_Vertex) * cap);
+        if (!nv) return false;
+        b->verts = nv;
+        b->vert_capacity = cap;
+    }
+    if (b->index_count + indices > b->index_capacity) {
+        int cap = b->index_capacity ? b->index_capacity : 2048;
+        while (cap < b->index_count + indices) cap *= 2;
+        int* ni = (int*)realloc(b->indices, sizeof(int) * cap);
+        if (!ni) return false;
+        b->indices = ni;
+        b->index_capacity = cap;
+    }
+    return true;
+}
+
+static inline void rx_geo_flush(RxGeoBatch* b, SDL_Renderer* renderer) {
+    if (b->index_count > 0 && renderer) {
+        SDL_RenderGeometry(renderer, b->texture, b->verts, b->vert_count,
+                           b->indices, b->index_count);
+    }
+    b->vert_count = 0;
+    b->index_count = 0;
+}
+
+static inline void rx_geo_free(RxGeoBatch* b) {
+    free(b->verts);
+    free(b->indices);
+    b->verts = NULL;
+    b->indices = NULL;
+    b->vert_count = b->vert_capacity = 0;
+    b->index_count = b->index_capacity = 0;
+    b->texture = NULL;
+}
+
+static inline int rx_geo_vertex(RxGeoBatch* b, float x, float y, SDL_Color c) {
+    SDL_Vertex* v = &b->verts[b->vert_count];
+    v->position.x = x;
+    v->position.y = y;
+    v->color = c;
+    v->tex_coord.x = b->white_u;
+    v->tex_coord.y = b->white_v;
+    return b->vert_count++;
+}
+
+/* Bind texture for following shapes, flushing if it changes */
+static inline void rx_geo_set_texture(RxGeoBatch* b, SDL_Renderer* renderer, SDL_Texture* texture,
+                                      float white_u, float white_v) {
+    if (b->texture == texture) return;
+    rx_geo_flush(b, renderer);
+    b->texture = texture;
+    b->white_u = white_u;
+    b->white_v = white_v;
+}
+
+static inline void rx_geo_tri(RxGeoBatch* b, int i0, int i1, int i2) {
+    int* idx = &b->indices[b->index_count];
+    idx[0] = i0; idx[1] = i1; idx[2] = i2;
+    b->index_count += 3;
+}
+
+static inline void rx_geo_quad_idx(RxGeoBatch* b, int i0, int i1, int i2, int i3) {
+    rx_geo_tri(b, i0, i1, i2);
+    rx_geo_tri(b, i0, i2, i3);
+}
+
+/* Textured quad, uv in normalized texture coordinates */
+static inline void rx_geo_image_quad(RxGeoBatch* b, float x, float y, float w, float h,
+                                     float u0, float v0, float u1, float v1, SDL_Color c) {
+    if (w <= 0 || h <= 0 || c.a == 0) return;
+    if (!rx_geo_reserve(b, 4, 6)) return;
+    int i0 = rx_geo_vertex(b, x, y, c);
+    int i1 = rx_geo_vertex(b, x + w, y, c);
+    int i2 = rx_geo_vertex(b, x + w, y + h, c);
+    int i3 = rx_geo_vertex(b, x, y + h, c);
+    b->verts[i0].tex_coord.x = u0; b->verts[i0].tex_coord.y = v0;
+    b->verts[i1].tex_coord.x = u1; b->verts[i1].tex_coord.y = v0;
+    b->verts[i2].tex_coord.x = u1; b->verts[i2].tex_coord.y = v1;
+    b->verts[i3].tex_coord.x = u0; b->verts[i3].tex_coord.y = v1;
+    rx_geo_quad_idx(b, i0, i1, i2, i3);
+}
+
+/* Segments per quarter circle so the chord error stays under tolerance */
+static inline int rx_geo_arc_segments(float radius) {
+    if (radius <= RX_GEO_TOLERANCE) return 1;
+    float step = 2.0f * acosf(1.0f - RX_GEO_TOLERANCE / radius);
+    int n = (int)ceilf((float)M_PI * 0.5f / step);
+    if (n < 2) n = 2;
+    if (n > RX_GEO_MAX_ARC_SEGMENTS) n = RX_GEO_MAX_ARC_SEGMENTS;
+    return n;
+}
+
+/* Axis-aligned rect, no feathering (UI rects are pixel-aligned) */
+static inline void rx_geo_rect(RxGeoBatch* b, float x, float y, float w, float h, SDL_Color c) {
+    if (w <= 0 || h <= 0 || c.a == 0) return;
+    if (!rx_geo_reserve(b, 4, 6)) return;
+    int i0 = rx_geo_vertex(b, x, y, c);
+    int i1 = rx_geo_vertex(b, x + w, y, c);
+    int i2 = rx_geo_vertex(b, x + w, y + h, c);
+    int i3 = rx_geo_vertex(b, x, y + h, c);
+    rx_geo_quad_idx(b, i0, i1, i2, i3);
+}
+
+/*
+ * Rounded rect with anti-aliased corners. The outline walks the four corner
+ * arcs clockwise; each outline point gets an inner vertex (opaque, 0.5px
+ * inside) and an outer vertex (transparent, 0.5px outside). The interior is
+ * a fan from the center, the ring a triangle strip. A circle is the
+ * w == h == 2r case.
+ */
+static inline void rx_geo_rounded_rect(RxGeoBatch* b, float x, float y, float w, float h,
+                                       float radius, SDL_Color c) {
+    if (w <= 0 || h <= 0 || c.a == 0) return;
+    float r = fminf(radius, fminf(w * 0.5f, h * 0.5f));
+    if (r < 0.5f) { rx_geo_rect(b, x, y, w, h, c); return; }
+
+    int seg = rx_geo_arc_segments(r);
+    int points = 4 * (seg + 1);
+    if (!rx_geo_reserve(b, 1 + 2 * points, 9 * points)) return;
+
+    SDL_Color clear = c;
+    clear.a = 0;
+    float inner = r - 0.5f, outer = r + 0.5f;
+    float ccx[4] = { x + w - r, x + w - r, x + r, x + r };
+    float ccy[4] = { y + r, y + h - r, y + h - r, y + r };
+
+    int center = rx_geo_vertex(b, x + w * 0.5f, y + h * 0.5f, c);
+    int first = b->vert_count;
+    for (int corner = 0; corner < 4; corner++) {
+        float start = (float)M_PI * 0.5f * (float)(corner - 1);
+        for (int i = 0; i <= seg; i++) {
+            float a = start + (float)M_PI * 0.5f * (float)i / (float)seg;
+            float nx = cosf(a), ny = sinf(a);
+            rx_geo_vertex(b, ccx[corner] + nx * inner, ccy[corner] + ny * inner, c);
+            rx_geo_vertex(b, ccx[corner] + nx * outer, ccy[corner] + ny * outer, clear);
+        }
+    }
+    for (int p = 0; p < points; p++) {
+        int q = (p + 1) % points;
+        int in0 = first + 2 * p, out0 = in0 + 1;
+        int in1 = first + 2 * q, out1 = in1 + 1;
+        rx_geo_tri(b, center, in0, in1);
+        rx_geo_quad_idx(b, in0, out0, out1, in1);
+    }
+}
+
+static inline void rx_geo_circle(RxGeoBatch* b, float cx, float cy, float radius, SDL_Color c) {
+    if (radius <= 0) return;
+    rx_geo_rounded_rect(b, cx - radius, cy - radius, radius * 2, radius * 2, radius, c);
+}
+
+/* Thick line as a quad, feathered along both long edges */
+static inline void rx_geo_line(RxGeoBatch* b, float x1, float y1, float x2, float y2,
+                               float width, SDL_Color c) {
+    float dx = x2 - x1, dy = y2 - y1;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0 || c.a == 0) return;
+    if (!rx_geo_reserve(b, 8, 18)) return;
+
+    float nx = -dy / len, ny = dx / len;
+    float half = fmaxf(width, 1.0f) * 0.5f;
+    float in = half - 0.5f, out = half + 0.5f;
+    SDL_Color clear = c;
+    clear.a = 0;
+
+    int a0 = rx_geo_vertex(b, x1 - nx * out, y1 - ny * out, clear);
+    int a1 = rx_geo_vertex(b, x1 - nx * in,  y1 - ny * in,  c);
+    int a2 = rx_geo_vertex(b, x1 + nx * in,  y1 + ny * in,  c);
+    int a3 = rx_geo_vertex(b, x1 + nx * out, y1 + ny * out, clear);
+    int b0 = rx_geo_vertex(b, x2 - nx * out, y2 - ny * out, clear);
+    int b1 = rx_geo_vertex(b, x2 - nx * in,  y2 - ny * in,  c);
+    int b2 = rx_geo_vertex(b, x2 + nx * in,  y2 + ny * in,  c);
+    int b3 = rx_geo_vertex(b, x2 + nx * out, y2 + ny * out, clear);
+    rx_geo_quad_idx(b, a0, a1, b1, b0);
+    rx_geo_quad_idx(b, a1, a2, b2, b1);
+    rx_geo_quad_idx(b, a2, a3, b3, b2);
+}
+
+#endif /* REOX_SDL_GEOMETRY_H */
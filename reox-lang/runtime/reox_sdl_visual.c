@@ -12,6 +12,9 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include "reox_sdl_geometry.h"
+#include "reox_glyph_cache.h"
+#include "reox_runloop.h"
 
 /* UI Types from REOX */
 typedef struct { int64_t r, g, b, a; } Color;
@@ -53,8 +56,16 @@ static RenderView* g_root = NULL;
 static int g_win_width = 800;
 static int g_win_height = 600;
 static TTF_Font* g_font = NULL;
-static TTF_Font* g_font_large = NULL;
-static TTF_Font* g_font_small = NULL;
+static RxGeoBatch g_batch = {0};
+
+/* Glyph atlas: font_id 0 is g_font_path opened at each pixel size */
+#define MAX_FONT_SIZES 16
+static char g_font_path[512];
+static struct { int px; TTF_Font* font; } g_font_sizes[MAX_FONT_SIZES];
+static int g_font_size_count = 0;
+static rx_glyph_cache* g_glyphs = NULL;
+static SDL_Texture* g_glyph_pages[RX_GLYPH_MAX_PAGES];
+static SDL_Surface* g_glyph_surface = NULL;
 
 static View wrap_view(RenderView* v) { 
     g_views[g_view_count] = v; 
@@ -164,6 +175,98 @@ void view_add_child(View parent, View child) { RenderView* p = unwrap_view(paren
 void text_set_font_size(View v, double size) { RenderView* vw = unwrap_view(v); if (vw) vw->font_size = (float)size; }
 void text_set_color(View v, Color c) { RenderView* vw = unwrap_view(v); if (vw) { vw->text_color.r = c.r; vw->text_color.g = c.g; vw->text_color.b = c.b; vw->text_color.a = c.a; } }
 
+/* Glyph backend (SDL_ttf) */
+static TTF_Font* font_at(int px) {
+    for (int i = 0; i < g_font_size_count; i++) {
+        if (g_font_sizes[i].px == px) return g_font_sizes[i].font;
+    }
+    if (!g_font_path[0]) return NULL;
+    TTF_Font* font = TTF_OpenFont(g_font_path, px);
+    if (!font) return NULL;
+    if (g_font_size_count == MAX_FONT_SIZES) {
+        /* Drop the oldest size; its glyphs stay valid in the atlas */
+        TTF_CloseFont(g_font_sizes[0].font);
+        memmove(&g_font_sizes[0], &g_font_sizes[1], sizeof(g_font_sizes[0]) * (MAX_FONT_SIZES - 1));
+        g_font_size_count--;
+    }
+    g_font_sizes[g_font_size_count].px = px;
+    g_font_sizes[g_font_size_count].font = font;
+    g_font_size_count++;
+    return font;
+}
+
+static bool glyph_rasterize(void* ctx, uint32_t font_id, int px, uint32_t cp, rx_glyph_bitmap* out) {
+    (void)ctx; (void)font_id;
+    TTF_Font* font = font_at(px);
+    if (!font || cp > 0xFFFF || !TTF_GlyphIsProvided(font, (Uint16)cp)) return false;
+
+    int minx, maxx, miny, maxy, advance;
+    if (TTF_GlyphMetrics(font, (Uint16)cp, &minx, &maxx, &miny, &maxy, &advance) != 0) return false;
+    out->advance = (float)advance;
+    if (cp == ' ' || cp == '\t') return true;
+
+    if (g_glyph_surface) SDL_FreeSurface(g_glyph_surface);
+    SDL_Color white = {255, 255, 255, 255};
+    g_glyph_surface = TTF_RenderGlyph_Blended(font, (Uint16)cp, white);
+    if (!g_glyph_surface) return false;
+    /* Blended glyphs are line-height cells starting at the pen: no offset */
+    out->width = g_glyph_surface->w;
+    out->height = g_glyph_surface->h;
+    out->pixels = g_glyph_surface->pixels;
+    out->pitch = g_glyph_surface->pitch;
+    return true;
+}
+
+static void glyph_upload(void* ctx, int page, int x, int y, const rx_glyph_bitmap* bitmap) {
+    (void)ctx;
+    SDL_Rect rect = {x, y, bitmap->width, bitmap->height};
+    SDL_UpdateTexture(g_glyph_pages[page], &rect, bitmap->pixels, bitmap->pitch);
+    SDL_FreeSurface(g_glyph_surface);
+    g_glyph_surface = NULL;
+}
+
+static void glyph_page_evict(void* ctx, int page) {
+    (void)ctx;
+    if (g_batch.texture == g_glyph_pages[page]) rx_geo_flush(&g_batch, g_renderer);
+}
+
+static void glyph_page_created(void* ctx, int page) {
+    (void)ctx;
+    if (!g_glyph_pages[page]) {
+        g_glyph_pages[page] = SDL_CreateTexture(g_renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STATIC, RX_GLYPH_PAGE_SIZE, RX_GLYPH_PAGE_SIZE);
+        if (!g_glyph_pages[page]) return;
+        SDL_SetTextureBlendMode(g_glyph_pages[page], SDL_BLENDMODE_BLEND);
+    }
+    uint32_t* pixels = calloc(RX_GLYPH_PAGE_SIZE * RX_GLYPH_PAGE_SIZE, sizeof(uint32_t));
+    if (!pixels) return;
+    for (int y = 0; y < RX_GLYPH_WHITE_SIZE; y++)
+        for (int x = 0; x < RX_GLYPH_WHITE_SIZE; x++) pixels[y * RX_GLYPH_PAGE_SIZE + x] = 0xFFFFFFFFu;
+    SDL_UpdateTexture(g_glyph_pages[page], NULL, pixels, RX_GLYPH_PAGE_SIZE * sizeof(uint32_t));
+    free(pixels);
+}
+
+static float glyph_kerning(void* ctx, uint32_t font_id, int px, uint32_t left, uint32_t right) {
+    (void)ctx; (void)font_id;
+    TTF_Font* font = font_at(px);
+    if (!font || left > 0xFFFF || right > 0xFFFF) return 0;
+    return (float)TTF_GetFontKerningSizeGlyphs(font, (Uint16)left, (Uint16)right);
+}
+
+static float glyph_line_height(void* ctx, uint32_t font_id, int px) {
+    (void)ctx; (void)font_id;
+    TTF_Font* font = font_at(px);
+    return font ? (float)TTF_FontHeight(font) : px * 1.2f;
+}
+
+/* Rasterize glyphs at device pixels (HiDPI output / window size) */
+static void update_text_scale(void) {
+    int ww = 0, wh = 0, ow = 0, oh = 0;
+    SDL_GetWindowSize(g_window, &ww, &wh);
+    if (SDL_GetRendererOutputSize(g_renderer, &ow, &oh) != 0 || ww <= 0) return;
+    rx_glyph_cache_set_scale(g_glyphs, (float)ow / (float)ww);
+}
+
 /* App & Window */
 App app_new(const char* name) {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) { fprintf(stderr, "SDL Init failed\n"); exit(1); }
@@ -182,8 +285,7 @@ App app_new(const char* name) {
     for (int i = 0; font_paths[i]; i++) {
         g_font = TTF_OpenFont(font_paths[i], 14);
         if (g_font) {
-            g_font_large = TTF_OpenFont(font_paths[i], 24);
-            g_font_small = TTF_OpenFont(font_paths[i], 12);
+            snprintf(g_font_path, sizeof(g_font_path), "%s", font_paths[i]);
             break;
         }
     }
@@ -200,6 +302,16 @@ Window app_create_window(App a, const char* title, int64_t w, int64_t h) {
         g_win_width, g_win_height, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
     g_renderer = SDL_CreateRenderer(g_window, -1, SDL_RENDERER_ACCELERATED);
     SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+    
+    if (g_font) {
+        rx_glyph_backend backend = {
+            .rasterize = glyph_rasterize, .upload = glyph_upload, .evict = glyph_page_evict,
+            .kerning = glyph_kerning, .line_height = glyph_line_height,
+            .page_created = glyph_page_created
+        };
+        g_glyphs = rx_glyph_cache_create(&backend);
+        update_text_scale();
+    }
     return (Window){0};
 }
 
@@ -229,69 +341,49 @@ static void layout_view(RenderView* v, float x, float y, float w, float h) {
 }
 
 /* Drawing */
+static SDL_Color rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    SDL_Color c = { r, g, b, a };
+    return c;
+}
+
 static void draw_circle_filled(float cx, float cy, float r, uint8_t cr, uint8_t cg, uint8_t cb, uint8_t ca) {
-    SDL_SetRenderDrawColor(g_renderer, cr, cg, cb, ca);
-    int ri = (int)r;
-    for (int y = -ri; y <= ri; y++) {
-        for (int x = -ri; x <= ri; x++) {
-            if (x*x + y*y <= ri*ri) SDL_RenderDrawPointF(g_renderer, cx + x, cy + y);
-        }
-    }
+    rx_geo_circle(&g_batch, cx, cy, r, rgba(cr, cg, cb, ca));
 }
 
 static void draw_rounded_rect(float x, float y, float w, float h, float r, uint8_t cr, uint8_t cg, uint8_t cb, uint8_t ca) {
-    SDL_SetRenderDrawColor(g_renderer, cr, cg, cb, ca);
-    if (r <= 0) { SDL_FRect rect = {x, y, w, h}; SDL_RenderFillRectF(g_renderer, &rect); return; }
-    r = fminf(r, fminf(w/2, h/2));
-    SDL_FRect center = {x + r, y, w - 2*r, h}; SDL_RenderFillRectF(g_renderer, &center);
-    SDL_FRect left = {x, y + r, r, h - 2*r}; SDL_RenderFillRectF(g_renderer, &left);
-    SDL_FRect right = {x + w - r, y + r, r, h - 2*r}; SDL_RenderFillRectF(g_renderer, &right);
-    for (int cy = 0; cy < (int)r; cy++) {
-        for (int cx = 0; cx < (int)r; cx++) {
-            float dx = r - cx - 0.5f, dy = r - cy - 0.5f;
-            if (dx*dx + dy*dy <= r*r) {
-                SDL_RenderDrawPointF(g_renderer, x + cx, y + cy);
-                SDL_RenderDrawPointF(g_renderer, x + w - r + cx, y + cy);
-                SDL_RenderDrawPointF(g_renderer, x + cx, y + h - r + cy);
-                SDL_RenderDrawPointF(g_renderer, x + w - r + cx, y + h - r + cy);
-            }
-        }
-    }
+    rx_geo_rounded_rect(&g_batch, x, y, w, h, r, rgba(cr, cg, cb, ca));
 }
 
 static void draw_text(const char* text, float x, float y, float size, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
     if (!text || !text[0]) return;
     
-    TTF_Font* font = g_font;
-    if (size >= 20) font = g_font_large;
-    else if (size <= 12) font = g_font_small;
-    
-    if (!font) {
+    const rx_text_run* run = g_glyphs ? rx_text_run_get(g_glyphs, 0, size, text) : NULL;
+    if (!run) {
         /* Fallback: draw rectangle for each char */
-        SDL_SetRenderDrawColor(g_renderer, r, g, b, a);
         float char_w = size * 0.6f;
         float xx = x;
         for (const char* c = text; *c; c++) {
-            if (*c != ' ') {
-                SDL_FRect rect = {xx, y, char_w - 2, size};
-                SDL_RenderFillRectF(g_renderer, &rect);
-            }
+            if (*c != ' ') rx_geo_rect(&g_batch, xx, y, char_w - 2, size, rgba(r, g, b, a));
             xx += char_w;
         }
         return;
     }
     
-    SDL_Color color = {r, g, b, a};
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text, color);
-    if (!surface) return;
-    
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(g_renderer, surface);
-    if (texture) {
-        SDL_FRect dst = {x, y, (float)surface->w, (float)surface->h};
-        SDL_RenderCopyF(g_renderer, texture, NULL, &dst);
-        SDL_DestroyTexture(texture);
+    /* One quad per glyph from the atlas, batched with the surrounding shapes */
+    float inv_scale = 1.0f / g_glyphs->scale;
+    float inv_page = 1.0f / RX_GLYPH_PAGE_SIZE;
+    float white = RX_GLYPH_WHITE_SIZE * 0.5f * inv_page;
+    SDL_Color color = rgba(r, g, b, a);
+    for (int i = 0; i < run->glyph_count; i++) {
+        const rx_glyph* gl = rx_glyph_cache_get(g_glyphs, 0, run->px, run->glyphs[i].codepoint);
+        if (!gl || gl->page < 0 || !g_glyph_pages[gl->page]) continue;
+        rx_geo_set_texture(&g_batch, g_renderer, g_glyph_pages[gl->page], white, white);
+        rx_geo_image_quad(&g_batch,
+            x + (run->glyphs[i].x + gl->left) * inv_scale, y + gl->top * inv_scale,
+            gl->width * inv_scale, gl->height * inv_scale,
+            gl->x * inv_page, gl->y * inv_page,
+            (gl->x + gl->width) * inv_page, (gl->y + gl->height) * inv_page, color);
     }
-    SDL_FreeSurface(surface);
 }
 
 static void render_view(RenderView* v) {
@@ -319,9 +411,9 @@ static void render_view(RenderView* v) {
     
     /* Button */
     if (v->kind == 2 && v->label[0]) {
-        int tw = 0, th = 0;
-        TTF_Font* font = g_font;
-        if (font && TTF_SizeUTF8(font, v->label, &tw, &th) == 0) {
+        float tw = 0, th = 0;
+        if (g_glyphs) {
+            rx_text_run_measure(g_glyphs, 0, 14, v->label, &tw, &th);
             draw_text(v->label, x + (w - tw)/2, y + (h - th)/2, 14, 255, 255, 255, 255);
         } else {
             draw_text(v->label, x + v->padding + 8, y + (h - 14)/2, 14, 255, 255, 255, 255);
@@ -331,31 +423,83 @@ static void render_view(RenderView* v) {
     for (int i = 0; i < v->child_count; i++) render_view(v->children[i]);
 }
 
+static bool visual_handle_event(const SDL_Event* event) {
+    if (event->type == SDL_QUIT || (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_ESCAPE)) return false;
+    if (event->type == SDL_WINDOWEVENT) {
+        if (event->window.event == SDL_WINDOWEVENT_RESIZED) {
+            g_win_width = event->window.data1; g_win_height = event->window.data2;
+            if (g_glyphs) update_text_scale();
+            layout_view(g_root, 0, 0, (float)g_win_width, (float)g_win_height);
+        }
+        if (event->window.event == SDL_WINDOWEVENT_RESIZED || event->window.event == SDL_WINDOWEVENT_EXPOSED)
+            rx_runloop_request_frame(rx_runloop_main());
+    }
+    return true;
+}
+
+/* Block in SDL until an event or the next timer/frame, then drain */
+static bool visual_wait_events(void* ctx, int timeout_ms) {
+    (void)ctx;
+    SDL_Event event;
+    int got = timeout_ms < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, timeout_ms);
+    if (got && !visual_handle_event(&event)) return false;
+    while (SDL_PollEvent(&event)) {
+        if (!visual_handle_event(&event)) return false;
+    }
+    return true;
+}
+
+static void visual_frame(void* ctx, float dt) {
+    (void)ctx; (void)dt;
+    SDL_SetRenderDrawColor(g_renderer, 26, 27, 38, 255);
+    SDL_RenderClear(g_renderer);
+    rx_glyph_cache_begin_frame(g_glyphs);
+    render_view(g_root);
+    rx_geo_flush(&g_batch, g_renderer);
+    SDL_RenderPresent(g_renderer);
+}
+
+static void visual_wake(void* ctx) {
+    (void)ctx;
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+}
+
+static float visual_refresh_rate(void* ctx) {
+    (void)ctx;
+    SDL_DisplayMode mode;
+    int display = SDL_GetWindowDisplayIndex(g_window);
+    if (display < 0 || SDL_GetCurrentDisplayMode(display, &mode) != 0) return 0.0f;
+    return (float)mode.refresh_rate;
+}
+
 void app_run(App a) {
     (void)a;
     if (!g_root || !g_window) return;
     printf("[REOX] Visual render started\n");
     layout_view(g_root, 0, 0, (float)g_win_width, (float)g_win_height);
-    bool running = true;
-    SDL_Event event;
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) running = false;
-            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_RESIZED) {
-                g_win_width = event.window.data1; g_win_height = event.window.data2;
-                layout_view(g_root, 0, 0, (float)g_win_width, (float)g_win_height);
-            }
-        }
-        SDL_SetRenderDrawColor(g_renderer, 26, 27, 38, 255);
-        SDL_RenderClear(g_renderer);
-        render_view(g_root);
-        SDL_RenderPresent(g_renderer);
-        SDL_Delay(16);
-    }
+
+    /* Redraw only after input, resize or expose; sleep in SDL otherwise */
+    rx_runloop* loop = rx_runloop_main();
+    rx_runloop_hooks hooks = {
+        .wait_events = visual_wait_events,
+        .frame = visual_frame,
+        .refresh_rate = visual_refresh_rate,
+        .wake = visual_wake,
+        .ctx = NULL
+    };
+    rx_runloop_configure(loop, &hooks, NULL);
+    rx_runloop_request_frame(loop);
+    rx_runloop_run(loop);
+
+    rx_glyph_cache_destroy(g_glyphs);
+    for (int i = 0; i < RX_GLYPH_MAX_PAGES; i++) if (g_glyph_pages[i]) SDL_DestroyTexture(g_glyph_pages[i]);
+    for (int i = 0; i < g_font_size_count; i++) TTF_CloseFont(g_font_sizes[i].font);
     if (g_font) TTF_CloseFont(g_font);
-    if (g_font_large) TTF_CloseFont(g_font_large);
-    if (g_font_small) TTF_CloseFont(g_font_small);
     TTF_Quit();
+    rx_geo_free(&g_batch);
     SDL_DestroyRenderer(g_renderer);
     SDL_DestroyWindow(g_window);
     SDL_Quit();
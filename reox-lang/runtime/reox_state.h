@@ -8,6 +8,10 @@
  * - Efficient diffing algorithm
  * - Computed/derived state
  * - State observers/subscriptions
+ * - Worker-thread writes via a lock-free update queue
+ *
+ * Threading: everything here is owned by the UI thread, except the
+ * rx_state_post_* functions, which any thread may call.
  */
 
 #ifndef REOX_STATE_H
@@ -18,12 +22,113 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <assert.h>
+#include <stdatomic.h>
+
+/*
+ * Frame integration is opt-in, so this header still works on its own. With
+ * RX_STATE_FRAME=1 the diff and effect passes are timed as frame phases and
+ * rx_frame applies posted updates through a frame hook; that needs
+ * reox_frame_stats.c (in libreox_runtime) at link time. Without it, call
+ * rx_state_apply_posted() yourself once per frame.
+ */
+#ifndef RX_STATE_FRAME
+#define RX_STATE_FRAME 0
+#endif
+
+#if RX_STATE_FRAME
+#include "reox_frame_stats.h"
+#define RX_STATE_ZONE_BEGIN(phase)  RX_ZONE_BEGIN(phase)
+#define RX_STATE_ZONE_END(phase)    RX_ZONE_END(phase)
+#else
+#define RX_STATE_ZONE_BEGIN(phase)  ((void)0)
+#define RX_STATE_ZONE_END(phase)    ((void)0)
+#endif
 
 /* ============================================================================
- * State ID Generation
+ * Slot Table
+ *
+ * States, computeds and effects live in paged slot tables. A handle carries
+ * the slot index plus the generation the slot had when it was handed out, so
+ * lookup is a bounds check and one compare; destroyed slots bump their
+ * generation and stale handles simply miss. Records are allocated in fixed
+ * pages and never move, so pointers into them stay valid while live.
  * ============================================================================ */
 
-static int64_t rx_state_id_counter = 0;
+#define RX_SLOT_PAGE_SHIFT 8
+#define RX_SLOT_PAGE_SIZE  (1u << RX_SLOT_PAGE_SHIFT)
+#define RX_SLOT_PAGE_MASK  (RX_SLOT_PAGE_SIZE - 1)
+#define RX_SLOT_NONE       0xFFFFFFFFu
+#define RX_SLOT_GEN_MASK   0x7FFFFFFFu   /* Top generation bit is reserved for handle tags */
+
+/* Common header, must be the first member of every slotted record */
+typedef struct {
+    uint32_t generation;        /* 0 is never a live generation */
+    uint32_t link;              /* Free-list link while free, own index while live */
+    bool live;
+} rx_slot;
+
+typedef struct {
+    uint8_t** pages;
+    uint32_t page_count;
+    uint32_t count;             /* High-water mark of slots handed out */
+    uint32_t live_count;
+    uint32_t free_head;
+    size_t elem_size;
+} rx_slot_table;
+
+#define RX_SLOT_TABLE_INIT(type) { NULL, 0, 0, 0, RX_SLOT_NONE, sizeof(type) }
+
+static inline rx_slot* rx_slot_at(const rx_slot_table* t, uint32_t index) {
+    return (rx_slot*)(t->pages[index >> RX_SLOT_PAGE_SHIFT] +
+                      (size_t)(index & RX_SLOT_PAGE_MASK) * t->elem_size);
+}
+
+static inline void* rx_slot_get(const rx_slot_table* t, uint32_t index, uint32_t generation) {
+    if (index >= t->count) return NULL;
+    rx_slot* slot = rx_slot_at(t, index);
+    return (slot->live && slot->generation == generation) ? slot : NULL;
+}
+
+/* Returns a zeroed, live record and its index (or NULL on OOM) */
+static void* rx_slot_alloc(rx_slot_table* t, uint32_t* out_index) {
+    uint32_t index;
+    if (t->free_head != RX_SLOT_NONE) {
+        index = t->free_head;
+        t->free_head = rx_slot_at(t, index)->link;
+    } else {
+        if ((t->count >> RX_SLOT_PAGE_SHIFT) >= t->page_count) {
+            uint8_t** pages = (uint8_t**)realloc(t->pages, sizeof(uint8_t*) * (t->page_count + 1));
+            if (!pages) return NULL;
+            t->pages = pages;
+            t->pages[t->page_count] = (uint8_t*)calloc(RX_SLOT_PAGE_SIZE, t->elem_size);
+            if (!t->pages[t->page_count]) return NULL;
+            t->page_count++;
+        }
+        index = t->count++;
+    }
+    
+    rx_slot* slot = rx_slot_at(t, index);
+    uint32_t generation = slot->generation + 1;
+    if (generation == 0 || generation > RX_SLOT_GEN_MASK) generation = 1;
+    memset(slot, 0, t->elem_size);
+    slot->generation = generation;
+    slot->link = index;
+    slot->live = true;
+    t->live_count++;
+    
+    *out_index = index;
+    return slot;
+}
+
+static void rx_slot_release(rx_slot_table* t, uint32_t index) {
+    rx_slot* slot = rx_slot_at(t, index);
+    if (!slot->live) return;
+    slot->live = false;
+    slot->link = t->free_head;
+    t->free_head = index;
+    t->live_count--;
+}
 
 /* ============================================================================
  * State Types
@@ -37,6 +142,79 @@ typedef enum {
     RX_STATE_OBJECT
 } rx_state_type;
 
+/* Handle to a slotted record; a zeroed handle is never valid */
+typedef struct {
+    uint32_t index;
+    uint32_t generation;
+} RxStateHandle;
+
+/* Stable 64-bit id for a handle, as reported to observers and diffs */
+static inline int64_t rx_handle_id(RxStateHandle h) {
+    return ((int64_t)h.generation << 32) | (int64_t)h.index;
+}
+
+static inline RxStateHandle rx_handle_from_id(int64_t id) {
+    return (RxStateHandle){ (uint32_t)(id & 0xFFFFFFFF), (uint32_t)((uint64_t)id >> 32) };
+}
+
+static inline int64_t rx_slot_id(const rx_slot* slot) {
+    return ((int64_t)slot->generation << 32) | (int64_t)slot->link;
+}
+
+/* Computed handles are tagged so they can be used as dependencies alongside states */
+#define RX_HANDLE_COMPUTED 0x80000000u
+
+static inline bool rx_handle_is_computed(RxStateHandle h) {
+    return (h.generation & RX_HANDLE_COMPUTED) != 0;
+}
+
+/* ============================================================================
+ * Dependency Graph Edges
+ *
+ * Every state and computed keeps reverse edges to the computeds and effects
+ * that declared it as a dependency, so a change only visits what it affects.
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t index;
+    uint32_t generation;
+    bool is_effect;             /* Target lives in the effect table, else computed */
+} rx_dep_edge;
+
+typedef struct {
+    rx_dep_edge* edges;
+    int count;
+    int capacity;
+} rx_dep_list;
+
+static void rx_dep_list_add(rx_dep_list* list, rx_dep_edge edge) {
+    if (list->count >= list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 4;
+        rx_dep_edge* edges = (rx_dep_edge*)realloc(list->edges, sizeof(rx_dep_edge) * capacity);
+        if (!edges) return;
+        list->edges = edges;
+        list->capacity = capacity;
+    }
+    list->edges[list->count++] = edge;
+}
+
+static void rx_dep_list_remove(rx_dep_list* list, rx_dep_edge edge) {
+    for (int i = 0; i < list->count; i++) {
+        rx_dep_edge* e = &list->edges[i];
+        if (e->index == edge.index && e->generation == edge.generation && e->is_effect == edge.is_effect) {
+            list->edges[i] = list->edges[--list->count];
+            return;
+        }
+    }
+}
+
+static void rx_dep_list_free(rx_dep_list* list) {
+    free(list->edges);
+    list->edges = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
 /* State change callback */
 typedef void (*rx_state_callback)(int64_t state_id, void* old_value, void* new_value, void* user_data);
 
@@ -48,202 +226,359 @@ typedef struct rx_observer {
     struct rx_observer* next;
 } rx_observer;
 
-/* Base state container */
+/* ============================================================================
+ * Inline Value Storage
+ *
+ * Scalars live directly in the state record. Strings live in a pooled pair
+ * record (current + previous) with a small inline buffer each, and only spill
+ * to the heap when they outgrow it; a spilled buffer is kept and reused by
+ * later writes. RxString points into itself, so it must stay where it was
+ * initialised and never be copied by value.
+ * ============================================================================ */
+
+#define RX_STRING_INLINE 24
+
+typedef struct {
+    char* data;                 /* Inline buffer or heap spill, NUL-terminated */
+    uint32_t length;
+    uint32_t capacity;          /* Heap capacity, 0 while inline */
+    char small[RX_STRING_INLINE];
+} RxString;
+
+typedef union {
+    int64_t i;
+    double f;
+    bool b;
+} rx_scalar;
+
+typedef struct {
+    rx_slot slot;
+    RxString value;
+    RxString prev;
+} rx_string_pair;
+
+static rx_slot_table rx_string_pool = RX_SLOT_TABLE_INIT(rx_string_pair);
+
+static inline void rx_string_init(RxString* str) {
+    str->data = str->small;
+    str->small[0] = '\0';
+    str->length = 0;
+    str->capacity = 0;
+}
+
+static void rx_string_assign(RxString* str, const char* text, size_t length) {
+    size_t capacity = str->capacity ? str->capacity : RX_STRING_INLINE;
+    if (length + 1 > capacity) {
+        while (capacity < length + 1) capacity *= 2;
+        char* heap = (char*)(str->capacity ? realloc(str->data, capacity) : malloc(capacity));
+        if (!heap) return;
+        str->data = heap;
+        str->capacity = (uint32_t)capacity;
+    }
+    memmove(str->data, text, length);   /* text may point into data */
+    str->data[length] = '\0';
+    str->length = (uint32_t)length;
+}
+
+static inline void rx_string_free(RxString* str) {
+    if (str->capacity) free(str->data);
+    rx_string_init(str);
+}
+
+/* Base state container, 64 bytes for every type */
 typedef struct rx_state {
-    int64_t id;
-    rx_state_type type;
-    void* value;
-    void* prev_value;           /* For diffing */
+    rx_slot slot;
+    uint32_t dirty_next;        /* Intrusive dirty-list link (slot index) */
+    uint32_t version;           /* Bumped on every change */
+    uint8_t type;               /* rx_state_type */
     bool dirty;                 /* Needs UI update */
     rx_observer* observers;     /* Subscribers */
-    struct rx_state* next;      /* Global state list */
+    rx_dep_list dependents;     /* Computeds/effects that depend on this state */
+    union {
+        struct { rx_scalar value, prev; } scalar;
+        uint32_t string_index;  /* Slot in rx_string_pool */
+    } storage;
 } rx_state;
 
 /* Global state registry for diffing */
-static rx_state* rx_state_registry = NULL;
+static rx_slot_table rx_state_registry = RX_SLOT_TABLE_INIT(rx_state);
 static int64_t rx_observer_id_counter = 0;
 
+/* Dirty states in order of their first change since the last clear */
+static uint32_t rx_dirty_head = RX_SLOT_NONE;
+static uint32_t rx_dirty_tail = RX_SLOT_NONE;
+static int rx_dirty_count = 0;
+
+static inline rx_state* rx_state_lookup(RxStateHandle handle) {
+    return (rx_state*)rx_slot_get(&rx_state_registry, handle.index, handle.generation);
+}
+
+/* Live state of the given type; a handle used as the wrong type is a caller bug */
+static inline rx_state* rx_state_lookup_typed(RxStateHandle handle, rx_state_type type) {
+    rx_state* s = rx_state_lookup(handle);
+    if (s && s->type != (uint8_t)type) {
+        assert(!"state handle used as the wrong type");
+        return NULL;
+    }
+    return s;
+}
+
+static inline rx_state* rx_state_at(uint32_t index) {
+    return (rx_state*)rx_slot_at(&rx_state_registry, index);
+}
+
+static inline rx_string_pair* rx_state_strings(const rx_state* s) {
+    return (rx_string_pair*)rx_slot_at(&rx_string_pool, s->storage.string_index);
+}
+
+/* Value pointers as handed to observers and diffs (rx_scalar* or RxString*) */
+static inline void* rx_state_value(rx_state* s) {
+    if (s->type == RX_STATE_STRING) return &rx_state_strings(s)->value;
+    return &s->storage.scalar.value;
+}
+
+static inline void* rx_state_prev_value(rx_state* s) {
+    if (s->type == RX_STATE_STRING) return &rx_state_strings(s)->prev;
+    return &s->storage.scalar.prev;
+}
+
+/* Flag a state dirty, appending it to the dirty list on the first transition */
+static void rx_state_mark_dirty(rx_state* s) {
+    if (s->dirty) return;
+    s->dirty = true;
+    s->dirty_next = RX_SLOT_NONE;
+    
+    uint32_t index = s->slot.link;
+    if (rx_dirty_tail == RX_SLOT_NONE) {
+        rx_dirty_head = index;
+    } else {
+        rx_state_at(rx_dirty_tail)->dirty_next = index;
+    }
+    rx_dirty_tail = index;
+    rx_dirty_count++;
+}
+
+static void rx_state_unlink_dirty(rx_state* s) {
+    if (!s->dirty) return;
+    
+    uint32_t index = s->slot.link;
+    uint32_t prev = RX_SLOT_NONE;
+    uint32_t cur = rx_dirty_head;
+    while (cur != RX_SLOT_NONE && cur != index) {
+        prev = cur;
+        cur = rx_state_at(cur)->dirty_next;
+    }
+    if (cur == RX_SLOT_NONE) return;
+    
+    if (prev == RX_SLOT_NONE) rx_dirty_head = s->dirty_next;
+    else rx_state_at(prev)->dirty_next = s->dirty_next;
+    if (rx_dirty_tail == index) rx_dirty_tail = prev;
+    s->dirty = false;
+    rx_dirty_count--;
+}
+
+static void rx_graph_invalidate(const rx_dep_list* dependents);
+
+/* Record a change: mark dirty, invalidate dependents and notify observers */
+static void rx_state_changed(rx_state* s) {
+    rx_state_mark_dirty(s);
+    s->version++;
+    if (s->dependents.count > 0) rx_graph_invalidate(&s->dependents);
+    
+    rx_observer* obs = s->observers;
+    while (obs) {
+        obs->callback(rx_slot_id(&s->slot), rx_state_prev_value(s), rx_state_value(s), obs->user_data);
+        obs = obs->next;
+    }
+}
+
 /* ============================================================================
  * State Creation
  * ============================================================================ */
 
-static rx_state* rx_state_create(rx_state_type type, void* initial_value, size_t size) {
-    rx_state* s = (rx_state*)calloc(1, sizeof(rx_state));
-    s->id = rx_state_id_counter++;
-    s->type = type;
-    s->value = malloc(size);
-    s->prev_value = malloc(size);
-    memcpy(s->value, initial_value, size);
-    memcpy(s->prev_value, initial_value, size);
+#if RX_STATE_FRAME
+int rx_state_apply_posted(void);
+
+static void rx_state_frame_hook(void) {
+    rx_state_apply_posted();
+}
+#endif
+
+/* Allocate a state record; values are stored inline, no further allocation */
+static rx_state* rx_state_create(rx_state_type type) {
+#if RX_STATE_FRAME
+    /* Posts need a handle, so rx_frame picks them up from the first state on */
+    static bool hooked = false;
+    if (!hooked) hooked = rx_frame_add_hook(rx_state_frame_hook);
+#endif
+
+    uint32_t index;
+    rx_state* s = (rx_state*)rx_slot_alloc(&rx_state_registry, &index);
+    if (!s) return NULL;
+    s->type = (uint8_t)type;
+    if (type == RX_STATE_STRING) {
+        uint32_t string_index;
+        rx_string_pair* pair = (rx_string_pair*)rx_slot_alloc(&rx_string_pool, &string_index);
+        if (!pair) {
+            rx_slot_release(&rx_state_registry, index);
+            return NULL;
+        }
+        rx_string_init(&pair->value);
+        rx_string_init(&pair->prev);
+        s->storage.string_index = string_index;
+    }
     s->dirty = false;
     s->observers = NULL;
     
-    /* Add to registry */
-    s->next = rx_state_registry;
-    rx_state_registry = s;
-    
     return s;
 }
 
+/* Snapshot the current value into prev_value */
+static void rx_state_snapshot(rx_state* s) {
+    if (s->type == RX_STATE_STRING) {
+        rx_string_pair* pair = rx_state_strings(s);
+        rx_string_assign(&pair->prev, pair->value.data, pair->value.length);
+    } else {
+        s->storage.scalar.prev = s->storage.scalar.value;
+    }
+}
+
+static inline RxStateHandle rx_state_handle(const rx_state* s) {
+    return s ? rx_handle_from_id(rx_slot_id(&s->slot)) : (RxStateHandle){ 0, 0 };
+}
+
+/* Destroy a state; outstanding handles to it become invalid */
+void rx_state_destroy(RxStateHandle handle) {
+    rx_state* s = rx_state_lookup(handle);
+    if (!s) return;
+    
+    rx_state_unlink_dirty(s);
+    
+    rx_observer* obs = s->observers;
+    while (obs) {
+        rx_observer* next = obs->next;
+        free(obs);
+        obs = next;
+    }
+    if (s->type == RX_STATE_STRING) {
+        rx_string_pair* pair = rx_state_strings(s);
+        rx_string_free(&pair->value);
+        rx_string_free(&pair->prev);
+        rx_slot_release(&rx_string_pool, s->storage.string_index);
+    }
+    rx_dep_list_free(&s->dependents);
+    rx_slot_release(&rx_state_registry, handle.index);
+}
+
 /* ============================================================================
  * State Accessors (Type-safe wrappers)
  * ============================================================================ */
 
-typedef struct { int64_t id; } RxStateHandle;
-
 /* Integer State */
 RxStateHandle rx_state_int_create(int64_t initial) {
-    int64_t val = initial;
-    rx_state* s = rx_state_create(RX_STATE_INT, &val, sizeof(int64_t));
-    return (RxStateHandle){ s->id };
+    rx_state* s = rx_state_create(RX_STATE_INT);
+    if (s) s->storage.scalar.value.i = s->storage.scalar.prev.i = initial;
+    return rx_state_handle(s);
 }
 
 int64_t rx_state_int_get(RxStateHandle handle) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) return *(int64_t*)s->value;
-        s = s->next;
-    }
-    return 0;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_INT);
+    return s ? s->storage.scalar.value.i : 0;
 }
 
 void rx_state_int_set(RxStateHandle handle, int64_t value) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            int64_t* old = (int64_t*)s->value;
-            if (*old != value) {
-                memcpy(s->prev_value, s->value, sizeof(int64_t));
-                *old = value;
-                s->dirty = true;
-                
-                /* Notify observers */
-                rx_observer* obs = s->observers;
-                while (obs) {
-                    obs->callback(s->id, s->prev_value, s->value, obs->user_data);
-                    obs = obs->next;
-                }
-            }
-            return;
-        }
-        s = s->next;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_INT);
+    if (!s) return;
+    if (s->storage.scalar.value.i != value) {
+        s->storage.scalar.prev = s->storage.scalar.value;
+        s->storage.scalar.value.i = value;
+        rx_state_changed(s);
     }
 }
 
 /* Float State */
 RxStateHandle rx_state_float_create(double initial) {
-    double val = initial;
-    rx_state* s = rx_state_create(RX_STATE_FLOAT, &val, sizeof(double));
-    return (RxStateHandle){ s->id };
+    rx_state* s = rx_state_create(RX_STATE_FLOAT);
+    if (s) s->storage.scalar.value.f = s->storage.scalar.prev.f = initial;
+    return rx_state_handle(s);
 }
 
 double rx_state_float_get(RxStateHandle handle) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) return *(double*)s->value;
-        s = s->next;
-    }
-    return 0.0;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_FLOAT);
+    return s ? s->storage.scalar.value.f : 0.0;
 }
 
 void rx_state_float_set(RxStateHandle handle, double value) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            double* old = (double*)s->value;
-            if (*old != value) {
-                memcpy(s->prev_value, s->value, sizeof(double));
-                *old = value;
-                s->dirty = true;
-                
-                rx_observer* obs = s->observers;
-                while (obs) {
-                    obs->callback(s->id, s->prev_value, s->value, obs->user_data);
-                    obs = obs->next;
-                }
-            }
-            return;
-        }
-        s = s->next;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_FLOAT);
+    if (!s) return;
+    if (s->storage.scalar.value.f != value) {
+        s->storage.scalar.prev = s->storage.scalar.value;
+        s->storage.scalar.value.f = value;
+        rx_state_changed(s);
     }
 }
 
 /* Bool State */
 RxStateHandle rx_state_bool_create(bool initial) {
-    bool val = initial;
-    rx_state* s = rx_state_create(RX_STATE_BOOL, &val, sizeof(bool));
-    return (RxStateHandle){ s->id };
+    rx_state* s = rx_state_create(RX_STATE_BOOL);
+    if (s) s->storage.scalar.value.b = s->storage.scalar.prev.b = initial;
+    return rx_state_handle(s);
 }
 
 bool rx_state_bool_get(RxStateHandle handle) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) return *(bool*)s->value;
-        s = s->next;
-    }
-    return false;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_BOOL);
+    return s ? s->storage.scalar.value.b : false;
 }
 
 void rx_state_bool_set(RxStateHandle handle, bool value) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            bool* old = (bool*)s->value;
-            if (*old != value) {
-                memcpy(s->prev_value, s->value, sizeof(bool));
-                *old = value;
-                s->dirty = true;
-                
-                rx_observer* obs = s->observers;
-                while (obs) {
-                    obs->callback(s->id, s->prev_value, s->value, obs->user_data);
-                    obs = obs->next;
-                }
-            }
-            return;
-        }
-        s = s->next;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_BOOL);
+    if (!s) return;
+    if (s->storage.scalar.value.b != value) {
+        s->storage.scalar.prev = s->storage.scalar.value;
+        s->storage.scalar.value.b = value;
+        rx_state_changed(s);
     }
 }
 
 /* String State */
-typedef struct { char data[256]; } RxString;
-
 RxStateHandle rx_state_string_create(const char* initial) {
-    RxString val = {0};
-    if (initial) strncpy(val.data, initial, 255);
-    rx_state* s = rx_state_create(RX_STATE_STRING, &val, sizeof(RxString));
-    return (RxStateHandle){ s->id };
+    rx_state* s = rx_state_create(RX_STATE_STRING);
+    if (s && initial) {
+        size_t len = strlen(initial);
+        rx_string_pair* pair = rx_state_strings(s);
+        rx_string_assign(&pair->value, initial, len);
+        rx_string_assign(&pair->prev, initial, len);
+    }
+    return rx_state_handle(s);
 }
 
 const char* rx_state_string_get(RxStateHandle handle) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) return ((RxString*)s->value)->data;
-        s = s->next;
-    }
-    return "";
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_STRING);
+    return s ? rx_state_strings(s)->value.data : "";
 }
 
 void rx_state_string_set(RxStateHandle handle, const char* value) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            RxString* old = (RxString*)s->value;
-            if (strcmp(old->data, value ? value : "") != 0) {
-                memcpy(s->prev_value, s->value, sizeof(RxString));
-                strncpy(old->data, value ? value : "", 255);
-                s->dirty = true;
-                
-                rx_observer* obs = s->observers;
-                while (obs) {
-                    obs->callback(s->id, s->prev_value, s->value, obs->user_data);
-                    obs = obs->next;
-                }
-            }
-            return;
+    rx_state* s = rx_state_lookup_typed(handle, RX_STATE_STRING);
+    if (!s) return;
+    if (!value) value = "";
+    rx_string_pair* pair = rx_state_strings(s);
+    RxString* cur = &pair->value;
+    size_t len = strlen(value);
+    if (len != cur->length || memcmp(cur->data, value, len) != 0) {
+        RxString* prev = &pair->prev;
+        if (value >= prev->data && value <= prev->data + prev->length) {
+            /* New text lives in the buffer the snapshot is about to overwrite */
+            RxString tmp;
+            rx_string_init(&tmp);
+            rx_string_assign(&tmp, value, len);
+            rx_state_snapshot(s);
+            rx_string_assign(cur, tmp.data, len);
+            rx_string_free(&tmp);
+        } else {
+            rx_state_snapshot(s);
+            rx_string_assign(cur, value, len);
         }
-        s = s->next;
+        rx_state_changed(s);
     }
 }
 
@@ -252,39 +587,31 @@ void rx_state_string_set(RxStateHandle handle, const char* value) {
  * ============================================================================ */
 
 int64_t rx_state_observe(RxStateHandle handle, rx_state_callback callback, void* user_data) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            rx_observer* obs = (rx_observer*)malloc(sizeof(rx_observer));
-            obs->observer_id = rx_observer_id_counter++;
-            obs->callback = callback;
-            obs->user_data = user_data;
-            obs->next = s->observers;
-            s->observers = obs;
-            return obs->observer_id;
-        }
-        s = s->next;
-    }
-    return -1;
+    rx_state* s = rx_state_lookup(handle);
+    if (!s) return -1;
+    
+    rx_observer* obs = (rx_observer*)malloc(sizeof(rx_observer));
+    obs->observer_id = rx_observer_id_counter++;
+    obs->callback = callback;
+    obs->user_data = user_data;
+    obs->next = s->observers;
+    s->observers = obs;
+    return obs->observer_id;
 }
 
 void rx_state_unobserve(RxStateHandle handle, int64_t observer_id) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->id == handle.id) {
-            rx_observer** pp = &s->observers;
-            while (*pp) {
-                if ((*pp)->observer_id == observer_id) {
-                    rx_observer* to_free = *pp;
-                    *pp = (*pp)->next;
-                    free(to_free);
-                    return;
-                }
-                pp = &(*pp)->next;
-            }
+    rx_state* s = rx_state_lookup(handle);
+    if (!s) return;
+    
+    rx_observer** pp = &s->observers;
+    while (*pp) {
+        if ((*pp)->observer_id == observer_id) {
+            rx_observer* to_free = *pp;
+            *pp = (*pp)->next;
+            free(to_free);
             return;
         }
-        s = s->next;
+        pp = &(*pp)->next;
     }
 }
 
@@ -305,55 +632,83 @@ typedef struct {
     int capacity;
 } rx_diff_batch;
 
-/* Collect all dirty states */
-rx_diff_batch rx_collect_diffs(void) {
-    rx_diff_batch batch = { NULL, 0, 16 };
-    batch.diffs = (rx_state_diff*)malloc(sizeof(rx_state_diff) * batch.capacity);
+/* Reusable, caller-owned diff buffer */
+void rx_diff_batch_init(rx_diff_batch* batch, int capacity) {
+    batch->count = 0;
+    batch->capacity = capacity > 0 ? capacity : 16;
+    batch->diffs = (rx_state_diff*)malloc(sizeof(rx_state_diff) * batch->capacity);
+}
+
+void rx_diff_batch_free(rx_diff_batch* batch) {
+    free(batch->diffs);
+    batch->diffs = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+/*
+ * Collect dirty states into a caller-owned batch. Walks only the dirty list;
+ * the buffer is reused across frames and only grows when a frame has more
+ * changes than any before it.
+ */
+int rx_collect_diffs_into(rx_diff_batch* batch) {
+    batch->count = 0;
+    if (batch->capacity < rx_dirty_count) {
+        int capacity = batch->capacity > 0 ? batch->capacity : 16;
+        while (capacity < rx_dirty_count) capacity *= 2;
+        rx_state_diff* diffs = (rx_state_diff*)realloc(batch->diffs, sizeof(rx_state_diff) * capacity);
+        if (!diffs) return 0;
+        batch->diffs = diffs;
+        batch->capacity = capacity;
+    }
     
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->dirty) {
-            if (batch.count >= batch.capacity) {
-                batch.capacity *= 2;
-                batch.diffs = (rx_state_diff*)realloc(batch.diffs, sizeof(rx_state_diff) * batch.capacity);
-            }
-            
-            batch.diffs[batch.count].state_id = s->id;
-            batch.diffs[batch.count].type = s->type;
-            batch.diffs[batch.count].old_value = s->prev_value;
-            batch.diffs[batch.count].new_value = s->value;
-            batch.count++;
-        }
-        s = s->next;
+    RX_STATE_ZONE_BEGIN(RX_PHASE_STATE_DIFF);
+
+    for (uint32_t i = rx_dirty_head; i != RX_SLOT_NONE; i = rx_state_at(i)->dirty_next) {
+        rx_state* s = rx_state_at(i);
+        rx_state_diff* d = &batch->diffs[batch->count++];
+        d->state_id = rx_slot_id(&s->slot);
+        d->type = s->type;
+        d->old_value = rx_state_prev_value(s);
+        d->new_value = rx_state_value(s);
     }
+    RX_STATE_ZONE_END(RX_PHASE_STATE_DIFF);
     
+    return batch->count;
+}
+
+/* Collect all dirty states into a freshly allocated batch (caller frees diffs) */
+rx_diff_batch rx_collect_diffs(void) {
+    rx_diff_batch batch;
+    rx_diff_batch_init(&batch, rx_dirty_count);
+    rx_collect_diffs_into(&batch);
     return batch;
 }
 
 /* Clear dirty flags after applying diffs */
 void rx_clear_dirty(void) {
-    rx_state* s = rx_state_registry;
-    while (s) {
-        if (s->dirty) {
-            s->dirty = false;
-            /* Update prev_value to current */
-            size_t size = 0;
-            switch (s->type) {
-                case RX_STATE_INT: size = sizeof(int64_t); break;
-                case RX_STATE_FLOAT: size = sizeof(double); break;
-                case RX_STATE_BOOL: size = sizeof(bool); break;
-                case RX_STATE_STRING: size = sizeof(RxString); break;
-                default: break;
-            }
-            if (size > 0) memcpy(s->prev_value, s->value, size);
-        }
-        s = s->next;
+    uint32_t i = rx_dirty_head;
+    while (i != RX_SLOT_NONE) {
+        rx_state* s = rx_state_at(i);
+        i = s->dirty_next;
+        s->dirty = false;
+        s->dirty_next = RX_SLOT_NONE;
+        /* Update prev_value to current */
+        rx_state_snapshot(s);
     }
+    rx_dirty_head = RX_SLOT_NONE;
+    rx_dirty_tail = RX_SLOT_NONE;
+    rx_dirty_count = 0;
+}
+
+/* Number of states currently marked dirty */
+int rx_state_dirty_count(void) {
+    return rx_dirty_count;
 }
 
 /* Print diff for debugging */
 void rx_print_diff(rx_state_diff* diff) {
-    printf("[DIFF] State #%ld: ", diff->state_id);
+    printf("[DIFF] State #%u: ", rx_handle_from_id(diff->state_id).index);
     switch (diff->type) {
         case RX_STATE_INT:
             printf("%ld -> %ld\n", *(int64_t*)diff->old_value, *(int64_t*)diff->new_value);
@@ -383,48 +738,134 @@ void rx_print_diff(rx_state_diff* diff) {
 typedef double (*rx_compute_fn)(void* user_data);
 
 typedef struct rx_computed {
-    int64_t id;
+    rx_slot slot;
     RxStateHandle* dependencies;
+    uint32_t* dep_versions;     /* Dependency versions seen at last evaluation */
     int dep_count;
     rx_compute_fn compute;
     void* user_data;
     double cached_value;
     bool needs_recompute;
-    struct rx_computed* next;
+    uint32_t level;             /* 1 + deepest dependency; states are level 0 */
+    uint32_t version;           /* Bumped when cached_value actually changes */
+    rx_dep_list dependents;
 } rx_computed;
 
-static rx_computed* rx_computed_registry = NULL;
+static rx_slot_table rx_computed_registry = RX_SLOT_TABLE_INIT(rx_computed);
+
+static inline rx_computed* rx_computed_lookup(RxStateHandle handle) {
+    if (!rx_handle_is_computed(handle)) return NULL;
+    return (rx_computed*)rx_slot_get(&rx_computed_registry, handle.index,
+                                     handle.generation & ~RX_HANDLE_COMPUTED);
+}
+
+static rx_dep_list* rx_node_dependents(RxStateHandle handle) {
+    if (rx_handle_is_computed(handle)) {
+        rx_computed* c = rx_computed_lookup(handle);
+        return c ? &c->dependents : NULL;
+    }
+    rx_state* s = rx_state_lookup(handle);
+    return s ? &s->dependents : NULL;
+}
 
+static uint32_t rx_node_level(RxStateHandle handle) {
+    rx_computed* c = rx_computed_lookup(handle);
+    return c ? c->level : 0;
+}
+
+static uint32_t rx_node_pull_version(RxStateHandle handle);
+
+/*
+ * Bring a stale computed up to date. All declared dependencies are pulled
+ * first, so a clean computed always has clean inputs; the compute function
+ * only runs if one of them actually changed since the last evaluation.
+ */
+static void rx_computed_refresh(rx_computed* c) {
+    if (!c->needs_recompute) return;
+    c->needs_recompute = false;
+    
+    bool inputs_changed = false;
+    for (int i = 0; i < c->dep_count; i++) {
+        uint32_t v = rx_node_pull_version(c->dependencies[i]);
+        if (v != c->dep_versions[i]) {
+            c->dep_versions[i] = v;
+            inputs_changed = true;
+        }
+    }
+    if (!inputs_changed) return;
+    
+    double value = c->compute(c->user_data);
+    if (value != c->cached_value) {
+        c->cached_value = value;
+        c->version++;
+    }
+}
+
+static uint32_t rx_node_pull_version(RxStateHandle handle) {
+    if (rx_handle_is_computed(handle)) {
+        rx_computed* c = rx_computed_lookup(handle);
+        if (!c) return 0;
+        rx_computed_refresh(c);
+        return c->version;
+    }
+    rx_state* s = rx_state_lookup(handle);
+    return s ? s->version : 0;
+}
+
+/* Wire a node's dependencies: record reverse edges, versions and its level */
+static uint32_t rx_graph_link(RxStateHandle* deps, uint32_t* versions, int dep_count, rx_dep_edge self) {
+    uint32_t level = 0;
+    for (int i = 0; i < dep_count; i++) {
+        rx_dep_list* list = rx_node_dependents(deps[i]);
+        if (list) rx_dep_list_add(list, self);
+        versions[i] = rx_node_pull_version(deps[i]);
+        uint32_t dep_level = rx_node_level(deps[i]);
+        if (dep_level > level) level = dep_level;
+    }
+    return level + 1;
+}
+
+static void rx_graph_unlink(RxStateHandle* deps, int dep_count, rx_dep_edge self) {
+    for (int i = 0; i < dep_count; i++) {
+        rx_dep_list* list = rx_node_dependents(deps[i]);
+        if (list) rx_dep_list_remove(list, self);
+    }
+}
+
+/* Dependencies may be state handles or other computed handles */
 RxStateHandle rx_computed_create(RxStateHandle* deps, int dep_count, rx_compute_fn compute, void* user_data) {
-    rx_computed* c = (rx_computed*)calloc(1, sizeof(rx_computed));
-    c->id = rx_state_id_counter++;
+    uint32_t index;
+    rx_computed* c = (rx_computed*)rx_slot_alloc(&rx_computed_registry, &index);
+    if (!c) return (RxStateHandle){ 0, 0 };
     c->dep_count = dep_count;
     c->dependencies = (RxStateHandle*)malloc(sizeof(RxStateHandle) * dep_count);
+    c->dep_versions = (uint32_t*)malloc(sizeof(uint32_t) * dep_count);
     memcpy(c->dependencies, deps, sizeof(RxStateHandle) * dep_count);
     c->compute = compute;
     c->user_data = user_data;
+    c->level = rx_graph_link(c->dependencies, c->dep_versions, dep_count,
+                             (rx_dep_edge){ index, c->slot.generation, false });
     c->cached_value = compute(user_data);
     c->needs_recompute = false;
     
-    c->next = rx_computed_registry;
-    rx_computed_registry = c;
-    
-    return (RxStateHandle){ c->id };
+    return (RxStateHandle){ index, c->slot.generation | RX_HANDLE_COMPUTED };
 }
 
 double rx_computed_get(RxStateHandle handle) {
-    rx_computed* c = rx_computed_registry;
-    while (c) {
-        if (c->id == handle.id) {
-            if (c->needs_recompute) {
-                c->cached_value = c->compute(c->user_data);
-                c->needs_recompute = false;
-            }
-            return c->cached_value;
-        }
-        c = c->next;
-    }
-    return 0.0;
+    rx_computed* c = rx_computed_lookup(handle);
+    if (!c) return 0.0;
+    rx_computed_refresh(c);
+    return c->cached_value;
+}
+
+void rx_computed_destroy(RxStateHandle handle) {
+    rx_computed* c = rx_computed_lookup(handle);
+    if (!c) return;
+    rx_graph_unlink(c->dependencies, c->dep_count, (rx_dep_edge){ handle.index, c->slot.generation, false });
+    free(c->dependencies);
+    free(c->dep_versions);
+    rx_dep_list_free(&c->dependents);
+    rx_slot_release(&rx_computed_registry, handle.index);
 }
 
 /* ============================================================================
@@ -434,55 +875,172 @@ double rx_computed_get(RxStateHandle handle) {
 typedef void (*rx_effect_fn)(void* user_data);
 
 typedef struct rx_effect {
-    int64_t id;
+    rx_slot slot;
     RxStateHandle* dependencies;
+    uint32_t* dep_versions;
     int dep_count;
     rx_effect_fn effect;
     void* user_data;
-    struct rx_effect* next;
+    uint32_t level;
+    bool queued;                /* Already in the pending queue */
 } rx_effect;
 
-static rx_effect* rx_effect_registry = NULL;
+static rx_slot_table rx_effect_registry = RX_SLOT_TABLE_INIT(rx_effect);
+
+/* Effects reached by invalidation, waiting for rx_run_effects */
+static RxStateHandle* rx_pending_effects = NULL;
+static int rx_pending_count = 0;
+static int rx_pending_capacity = 0;
+
+static inline rx_effect* rx_effect_lookup(uint32_t index, uint32_t generation) {
+    return (rx_effect*)rx_slot_get(&rx_effect_registry, index, generation);
+}
+
+static void rx_effect_enqueue(rx_effect* e, uint32_t index) {
+    if (e->queued) return;
+    if (rx_pending_count >= rx_pending_capacity) {
+        int capacity = rx_pending_capacity ? rx_pending_capacity * 2 : 16;
+        RxStateHandle* q = (RxStateHandle*)realloc(rx_pending_effects, sizeof(RxStateHandle) * capacity);
+        if (!q) return;
+        rx_pending_effects = q;
+        rx_pending_capacity = capacity;
+    }
+    e->queued = true;
+    rx_pending_effects[rx_pending_count++] = (RxStateHandle){ index, e->slot.generation };
+}
+
+/* ============================================================================
+ * Change Propagation
+ *
+ * A change marks every downstream computed stale and queues every downstream
+ * effect, without evaluating anything. A computed that is already stale is
+ * not descended into again: its dependents are stale or queued already.
+ * Values are pulled lazily in dependency order, which keeps reads glitch-free.
+ * ============================================================================ */
+
+static rx_dep_edge* rx_graph_stack = NULL;
+static int rx_graph_stack_capacity = 0;
+
+static bool rx_graph_stack_reserve(int needed) {
+    if (needed <= rx_graph_stack_capacity) return true;
+    int capacity = rx_graph_stack_capacity ? rx_graph_stack_capacity : 64;
+    while (capacity < needed) capacity *= 2;
+    rx_dep_edge* stack = (rx_dep_edge*)realloc(rx_graph_stack, sizeof(rx_dep_edge) * capacity);
+    if (!stack) return false;
+    rx_graph_stack = stack;
+    rx_graph_stack_capacity = capacity;
+    return true;
+}
+
+static void rx_graph_invalidate(const rx_dep_list* dependents) {
+    if (!rx_graph_stack_reserve(dependents->count)) return;
+    int top = 0;
+    for (int i = 0; i < dependents->count; i++) {
+        rx_graph_stack[top++] = dependents->edges[i];
+    }
+    
+    while (top > 0) {
+        rx_dep_edge edge = rx_graph_stack[--top];
+        if (edge.is_effect) {
+            rx_effect* e = rx_effect_lookup(edge.index, edge.generation);
+            if (e) rx_effect_enqueue(e, edge.index);
+            continue;
+        }
+        
+        rx_computed* c = (rx_computed*)rx_slot_get(&rx_computed_registry, edge.index, edge.generation);
+        if (!c || c->needs_recompute) continue;
+        c->needs_recompute = true;
+        
+        if (!rx_graph_stack_reserve(top + c->dependents.count)) return;
+        for (int d = 0; d < c->dependents.count; d++) {
+            rx_graph_stack[top++] = c->dependents.edges[d];
+        }
+    }
+}
 
+/* ============================================================================
+ * Effect API
+ * ============================================================================ */
+
+/* Dependencies may be state handles or computed handles */
 int64_t rx_effect_create(RxStateHandle* deps, int dep_count, rx_effect_fn effect, void* user_data) {
-    rx_effect* e = (rx_effect*)calloc(1, sizeof(rx_effect));
-    e->id = rx_state_id_counter++;
+    uint32_t index;
+    rx_effect* e = (rx_effect*)rx_slot_alloc(&rx_effect_registry, &index);
+    if (!e) return -1;
     e->dep_count = dep_count;
     e->dependencies = (RxStateHandle*)malloc(sizeof(RxStateHandle) * dep_count);
+    e->dep_versions = (uint32_t*)malloc(sizeof(uint32_t) * dep_count);
     memcpy(e->dependencies, deps, sizeof(RxStateHandle) * dep_count);
     e->effect = effect;
     e->user_data = user_data;
-    
-    e->next = rx_effect_registry;
-    rx_effect_registry = e;
+    e->level = rx_graph_link(e->dependencies, e->dep_versions, dep_count,
+                             (rx_dep_edge){ index, e->slot.generation, true });
     
     /* Run effect immediately */
     effect(user_data);
     
-    return e->id;
+    return rx_handle_id((RxStateHandle){ index, e->slot.generation });
 }
 
-/* Run effects for dirty dependencies */
+void rx_effect_destroy(int64_t effect_id) {
+    RxStateHandle h = rx_handle_from_id(effect_id);
+    rx_effect* e = rx_effect_lookup(h.index, h.generation);
+    if (!e) return;
+    rx_graph_unlink(e->dependencies, e->dep_count, (rx_dep_edge){ h.index, h.generation, true });
+    free(e->dependencies);
+    free(e->dep_versions);
+    rx_slot_release(&rx_effect_registry, h.index);
+}
+
+/*
+ * Run queued effects in topological (level) order. Each effect runs at most
+ * once per call, and only if one of its inputs actually changed value; effects
+ * re-queued by state writes made from inside an effect wait for the next call.
+ */
 void rx_run_effects(void) {
-    rx_effect* e = rx_effect_registry;
-    while (e) {
-        bool should_run = false;
-        for (int i = 0; i < e->dep_count; i++) {
-            rx_state* s = rx_state_registry;
-            while (s) {
-                if (s->id == e->dependencies[i].id && s->dirty) {
-                    should_run = true;
-                    break;
-                }
-                s = s->next;
+    int count = rx_pending_count;
+    if (count == 0) return;
+    RX_STATE_ZONE_BEGIN(RX_PHASE_EFFECTS);
+    
+    /* Stable insertion sort by level; the queue is small */
+    for (int i = 1; i < count; i++) {
+        RxStateHandle h = rx_pending_effects[i];
+        rx_effect* e = rx_effect_lookup(h.index, h.generation);
+        uint32_t level = e ? e->level : 0;
+        int j = i - 1;
+        while (j >= 0) {
+            rx_effect* p = rx_effect_lookup(rx_pending_effects[j].index, rx_pending_effects[j].generation);
+            if ((p ? p->level : 0) <= level) break;
+            rx_pending_effects[j + 1] = rx_pending_effects[j];
+            j--;
+        }
+        rx_pending_effects[j + 1] = h;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        RxStateHandle h = rx_pending_effects[i];
+        rx_effect* e = rx_effect_lookup(h.index, h.generation);
+        if (!e) continue;
+        e->queued = false;
+        
+        bool inputs_changed = false;
+        for (int d = 0; d < e->dep_count; d++) {
+            uint32_t v = rx_node_pull_version(e->dependencies[d]);
+            if (v != e->dep_versions[d]) {
+                e->dep_versions[d] = v;
+                inputs_changed = true;
             }
-            if (should_run) break;
         }
-        if (should_run) {
+        if (inputs_changed) {
             e->effect(e->user_data);
         }
-        e = e->next;
     }
+    
+    /* Keep effects queued during this pass for the next one */
+    memmove(rx_pending_effects, rx_pending_effects + count,
+            sizeof(RxStateHandle) * (rx_pending_count - count));
+    rx_pending_count -= count;
+    RX_STATE_ZONE_END(RX_PHASE_EFFECTS);
 }
 
 /* ============================================================================
@@ -490,6 +1048,7 @@ void rx_run_effects(void) {
  * ============================================================================ */
 
 static bool rx_batch_mode = false;
+static rx_diff_batch rx_commit_batch = { NULL, 0, 0 };
 
 void rx_batch_begin(void) {
     rx_batch_mode = true;
@@ -499,22 +1058,128 @@ void rx_batch_commit(void) {
     rx_batch_mode = false;
     
     /* Collect and apply diffs */
-    rx_diff_batch batch = rx_collect_diffs();
+    rx_diff_batch* batch = &rx_commit_batch;
+    rx_collect_diffs_into(batch);
     
-    if (batch.count > 0) {
-        printf("[STATE] Committing %d changes:\n", batch.count);
-        for (int i = 0; i < batch.count; i++) {
-            rx_print_diff(&batch.diffs[i]);
-        }
-        
+    if (batch->count > 0) {
         /* Run effects */
         rx_run_effects();
         
         /* Clear dirty flags */
         rx_clear_dirty();
     }
+}
+
+/* ============================================================================
+ * Cross-Thread Updates
+ *
+ * Worker threads never touch the registry. They post typed mutations into a
+ * lock-free multi-producer/single-consumer queue (Vyukov's intrusive MPSC
+ * list), and the UI thread applies them at the start of a frame inside one
+ * implicit batch. Producers pay one allocation and one atomic exchange.
+ * ============================================================================ */
+
+typedef struct rx_state_update {
+    _Atomic(struct rx_state_update*) next;
+    RxStateHandle handle;
+    rx_state_type type;
+    rx_scalar value;
+    char text[];                /* String payload for RX_STATE_STRING */
+} rx_state_update;
+
+static rx_state_update rx_update_stub;
+static _Atomic(rx_state_update*) rx_update_head = &rx_update_stub;
+static rx_state_update* rx_update_tail = &rx_update_stub;
+
+static void rx_update_push(rx_state_update* u) {
+    atomic_store_explicit(&u->next, NULL, memory_order_relaxed);
+    rx_state_update* prev = atomic_exchange_explicit(&rx_update_head, u, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, u, memory_order_release);
+}
+
+/* Consumer side only; returns NULL when empty or a producer is mid-push */
+static rx_state_update* rx_update_pop(void) {
+    rx_state_update* tail = rx_update_tail;
+    rx_state_update* next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    
+    if (tail == &rx_update_stub) {
+        if (!next) return NULL;
+        rx_update_tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+    if (next) {
+        rx_update_tail = next;
+        return tail;
+    }
+    if (tail != atomic_load_explicit(&rx_update_head, memory_order_acquire)) return NULL;
+    
+    rx_update_push(&rx_update_stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        rx_update_tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+static bool rx_state_post(RxStateHandle handle, rx_state_type type, rx_scalar value, const char* text) {
+    size_t len = text ? strlen(text) + 1 : 0;
+    rx_state_update* u = (rx_state_update*)malloc(sizeof(rx_state_update) + len);
+    if (!u) return false;
+    u->handle = handle;
+    u->type = type;
+    u->value = value;
+    if (text) memcpy(u->text, text, len);
+    rx_update_push(u);
+    return true;
+}
+
+/* Thread-safe writes; applied on the UI thread by rx_state_apply_posted() */
+bool rx_state_post_int(RxStateHandle handle, int64_t value) {
+    return rx_state_post(handle, RX_STATE_INT, (rx_scalar){ .i = value }, NULL);
+}
+
+bool rx_state_post_float(RxStateHandle handle, double value) {
+    return rx_state_post(handle, RX_STATE_FLOAT, (rx_scalar){ .f = value }, NULL);
+}
+
+bool rx_state_post_bool(RxStateHandle handle, bool value) {
+    return rx_state_post(handle, RX_STATE_BOOL, (rx_scalar){ .b = value }, NULL);
+}
+
+bool rx_state_post_string(RxStateHandle handle, const char* value) {
+    return rx_state_post(handle, RX_STATE_STRING, (rx_scalar){ .i = 0 }, value ? value : "");
+}
+
+/*
+ * Apply every posted update in post order inside one batch, so observers fire
+ * as usual and effects run once for the lot. Call on the UI thread at the
+ * start of a frame (with RX_STATE_FRAME=1, rx_frame does this through a frame
+ * hook registered when the first state is created). Returns the number of
+ * updates applied.
+ */
+int rx_state_apply_posted(void) {
+    rx_state_update* u = rx_update_pop();
+    if (!u) return 0;
+    
+    int applied = 0;
+    rx_batch_begin();
+    while (u) {
+        switch (u->type) {
+            case RX_STATE_INT:    rx_state_int_set(u->handle, u->value.i); break;
+            case RX_STATE_FLOAT:  rx_state_float_set(u->handle, u->value.f); break;
+            case RX_STATE_BOOL:   rx_state_bool_set(u->handle, u->value.b); break;
+            case RX_STATE_STRING: rx_state_string_set(u->handle, u->text); break;
+            default: break;
+        }
+        free(u);
+        applied++;
+        u = rx_update_pop();
+    }
+    rx_batch_commit();
     
-    free(batch.diffs);
+    return applied;
 }
 
 #endif /* REOX_STATE_H */
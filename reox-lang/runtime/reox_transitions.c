@@ -4,10 +4,23 @@
  */
 
 #include "reox_transitions.h"
+#include "reox_compositor.h"
+#include "reox_frame_stats.h"
+#include "reox_runloop.h"
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define RX_PARTICLES_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define RX_PARTICLES_NEON 1
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -52,6 +65,155 @@ rx_transition_config rx_transition_smooth(void) {
     };
 }
 
+/* ============================================================================
+ * Screen Builder
+ * One thread builds and lays out prepared screens, in request order
+ * ============================================================================ */
+
+typedef enum build_state {
+    BUILD_QUEUED,
+    BUILD_RUNNING,
+    BUILD_DONE
+} build_state;
+
+typedef struct rx_screen_build {
+    rx_screen_build_fn fn;
+    void* user_data;
+    rx_size size;
+    rx_view* view;
+    rx_runloop* loop;         /* Woken when the screen is ready */
+    build_state state;
+    bool abandoned;           /* Transition gone: the builder frees the screen */
+    struct rx_screen_build* next;
+} rx_screen_build;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    bool started;
+    rx_screen_build* head;
+    rx_screen_build* tail;
+} builder = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false, NULL, NULL };
+
+/* UI thread: a sleeping loop draws the frame that picks the screen up */
+static void build_landed(void* user_data) {
+    rx_runloop* loop = (rx_runloop*)user_data;
+    rx_runloop_request_frame(loop);
+    rx_runloop_unhold(loop);
+}
+
+static void* builder_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&builder.lock);
+    for (;;) {
+        while (!builder.head) pthread_cond_wait(&builder.work, &builder.lock);
+        rx_screen_build* b = builder.head;
+        builder.head = b->next;
+        if (!builder.head) builder.tail = NULL;
+        b->state = BUILD_RUNNING;
+        pthread_mutex_unlock(&builder.lock);
+        
+        rx_view* view = b->fn(b->user_data, b->size);
+        if (view) view_layout(view, b->size);
+        
+        pthread_mutex_lock(&builder.lock);
+        rx_runloop* loop = b->loop;
+        if (b->abandoned) {
+            pthread_mutex_unlock(&builder.lock);
+            view_free(view);
+            free(b);
+            rx_runloop_unhold(loop);
+        } else {
+            b->view = view;
+            b->state = BUILD_DONE;
+            pthread_mutex_unlock(&builder.lock);
+            if (!rx_runloop_post(loop, build_landed, loop)) rx_runloop_unhold(loop);
+        }
+        pthread_mutex_lock(&builder.lock);
+    }
+    return NULL;
+}
+
+static rx_screen_build* build_queue(rx_screen_build_fn fn, void* user_data, rx_size size) {
+    rx_screen_build* b = (rx_screen_build*)calloc(1, sizeof(rx_screen_build));
+    if (!b) return NULL;
+    b->fn = fn;
+    b->user_data = user_data;
+    b->size = size;
+    b->loop = rx_runloop_main();
+    
+    pthread_mutex_lock(&builder.lock);
+    if (!builder.started) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, builder_main, NULL) != 0) {
+            pthread_mutex_unlock(&builder.lock);
+            free(b);
+            return NULL;
+        }
+        pthread_detach(thread);
+        builder.started = true;
+    }
+    rx_runloop_hold(b->loop);
+    if (builder.tail) builder.tail->next = b;
+    else builder.head = b;
+    builder.tail = b;
+    pthread_cond_signal(&builder.work);
+    pthread_mutex_unlock(&builder.lock);
+    return b;
+}
+
+/* The built screen (NULL if build returned none) once done; false before */
+static bool build_take(rx_screen_build* b, rx_view** view) {
+    pthread_mutex_lock(&builder.lock);
+    bool done = b->state == BUILD_DONE;
+    pthread_mutex_unlock(&builder.lock);
+    if (!done) return false;
+    *view = b->view;
+    free(b);
+    return true;
+}
+
+static void build_abandon(rx_screen_build* b) {
+    pthread_mutex_lock(&builder.lock);
+    switch (b->state) {
+        case BUILD_QUEUED: {
+            rx_screen_build** link = &builder.head;
+            rx_screen_build* prev = NULL;
+            while (*link != b) {
+                prev = *link;
+                link = &(*link)->next;
+            }
+            *link = b->next;
+            if (builder.tail == b) builder.tail = prev;
+            pthread_mutex_unlock(&builder.lock);
+            rx_runloop_unhold(b->loop);
+            free(b);
+            return;
+        }
+        case BUILD_RUNNING:
+            b->abandoned = true;
+            pthread_mutex_unlock(&builder.lock);
+            return;
+        case BUILD_DONE:
+            /* build_landed still releases the hold */
+            pthread_mutex_unlock(&builder.lock);
+            view_free(b->view);
+            free(b);
+            return;
+    }
+    pthread_mutex_unlock(&builder.lock);
+}
+
+/* Window-space frame: view frames are relative to the parent */
+static rx_rect window_frame(const rx_view* view) {
+    rx_rect f = view->box.frame;
+    for (const rx_view* p = view->parent; p; p = p->parent) {
+        f.x += p->box.frame.x;
+        f.y += p->box.frame.y;
+    }
+    return f;
+}
+
 /* ============================================================================
  * Page Transition Implementation
  * ============================================================================ */
@@ -70,12 +232,141 @@ rx_page_transition* rx_page_transition_create(rx_view* from, rx_view* to, rx_tra
     return trans;
 }
 
+/*
+ * Layer values of the views at eased progress e for transitions that only
+ * move, fade or scale whole pages. Returns 0 for those that need per-frame
+ * work on the UI thread.
+ */
+static int transition_layer_values(const rx_page_transition* trans, float e,
+                                   rx_view** views, rx_animatable_property* props, float* values) {
+    rx_view* from = trans->from_view;
+    rx_view* to = trans->to_view;
+    views[0] = to;
+    views[1] = from;
+    
+    switch (trans->config.type) {
+        case RX_TRANS_FADE:
+        case RX_TRANS_CROSSFADE:
+            props[0] = props[1] = RX_PROP_OPACITY;
+            values[0] = e;
+            values[1] = 1.0f - e;
+            return 2;
+        case RX_TRANS_SLIDE_LEFT:
+            props[0] = props[1] = RX_PROP_X;
+            values[0] = to->box.frame.width * (1.0f - e);
+            values[1] = -from->box.frame.width * e;
+            return 2;
+        case RX_TRANS_SLIDE_RIGHT:
+            props[0] = props[1] = RX_PROP_X;
+            values[0] = -to->box.frame.width * (1.0f - e);
+            values[1] = from->box.frame.width * e;
+            return 2;
+        case RX_TRANS_SLIDE_UP:
+            props[0] = props[1] = RX_PROP_Y;
+            values[0] = to->box.frame.height * (1.0f - e);
+            values[1] = -from->box.frame.height * e;
+            return 2;
+        case RX_TRANS_SLIDE_DOWN:
+            props[0] = props[1] = RX_PROP_Y;
+            values[0] = -to->box.frame.height * (1.0f - e);
+            values[1] = from->box.frame.height * e;
+            return 2;
+        case RX_TRANS_ZOOM_IN:
+            props[0] = RX_PROP_SCALE;
+            values[0] = 0.8f + 0.2f * e;
+            return 1;
+        case RX_TRANS_ZOOM_OUT:
+            views[0] = from;
+            props[0] = RX_PROP_SCALE;
+            values[0] = 1.0f - 0.2f * e;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Hand the whole transition to the compositor (values are linear in the
+ * eased progress, so the compositor's easing reproduces them) */
+static bool transition_offload(rx_page_transition* trans) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp || !trans->from_view || !trans->to_view) return false;
+    
+    rx_view* views[2];
+    rx_animatable_property props[2];
+    float start[2], end[2];
+    int n = transition_layer_values(trans, 0.0f, views, props, start);
+    if (n == 0) return false;
+    transition_layer_values(trans, 1.0f, views, props, end);
+    
+    for (int i = 0; i < n; i++) {
+        if (!rx_compositor_animate(comp, views[i], props[i], start[i], end[i],
+                                   trans->config.duration, trans->config.easing, trans->config.delay)) {
+            for (int j = 0; j < i; j++) rx_compositor_cancel(comp, views[j]);
+            return false;
+        }
+    }
+    
+    /* Pages under anything else layered (shared elements), incoming on top */
+    rx_compositor_lower(comp, trans->to_view);
+    rx_compositor_lower(comp, trans->from_view);
+    return true;
+}
+
+/* Outgoing screen as a layer from the first frame: it is not relaid out or
+ * repainted again while the transition runs */
+static void transition_hold_from(rx_page_transition* trans) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp || !trans->from_view || trans->_from_pinned) return;
+    if (rx_compositor_promote(comp, trans->from_view) == RX_LAYER_INVALID) return;
+    rx_compositor_lower(comp, trans->from_view);
+    trans->_from_pinned = true;
+}
+
+/* Running animations or identity-idle collection take over the layer */
+static void transition_release_from(rx_page_transition* trans) {
+    if (!trans->_from_pinned) return;
+    rx_compositor_unpin(rx_compositor_active(), trans->from_view);
+    trans->_from_pinned = false;
+}
+
+/* Pick up a prepared screen; true once the transition can run */
+static bool transition_take_build(rx_page_transition* trans) {
+    rx_view* view;
+    if (!build_take(trans->_build, &view)) return false;
+    trans->_build = NULL;
+    trans->to_view = view;
+    if (view && trans->on_ready) trans->on_ready(view, trans->user_data);
+    
+    if (trans->config.delay < 0) trans->config.delay = 0;
+    trans->composited = transition_offload(trans);
+    if (trans->composited) transition_release_from(trans);
+    return true;
+}
+
+/* Pin composited layers at progress (interactive scrubbing, finish) */
+static void transition_snap(rx_page_transition* trans) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp || !trans->composited) return;
+    
+    rx_view* views[2];
+    rx_animatable_property props[2];
+    float values[2];
+    int n = transition_layer_values(trans, rx_ease(trans->config.easing, trans->progress),
+                                    views, props, values);
+    for (int i = 0; i < n; i++) {
+        rx_compositor_animate(comp, views[i], props[i], values[i], values[i], 0.0f, RX_EASE_LINEAR, 0.0f);
+    }
+}
+
 void rx_page_transition_start(rx_page_transition* trans) {
     if (!trans) return;
     
     trans->progress = 0.0f;
     trans->completed = false;
     trans->cancelled = false;
+    transition_hold_from(trans);
+    trans->composited = !trans->_build && transition_offload(trans);
+    if (trans->composited) transition_release_from(trans);
     
     if (trans->on_start) {
         trans->on_start(trans->user_data);
@@ -85,6 +376,13 @@ void rx_page_transition_start(rx_page_transition* trans) {
 void rx_page_transition_update(rx_page_transition* trans, float dt) {
     if (!trans || trans->completed || trans->cancelled) return;
     
+    /* Incoming screen still building: the delay runs meanwhile */
+    if (trans->_build) {
+        trans->config.delay -= dt;
+        transition_take_build(trans);
+        return;
+    }
+    
     /* Handle delay */
     if (trans->config.delay > 0) {
         trans->config.delay -= dt;
@@ -102,8 +400,8 @@ void rx_page_transition_update(rx_page_transition* trans, float dt) {
     /* Apply easing */
     float eased = rx_ease(trans->config.easing, trans->progress);
     
-    /* Apply transition based on type */
-    if (trans->from_view && trans->to_view) {
+    /* Apply transition based on type (composited ones move by themselves) */
+    if (trans->from_view && trans->to_view && !trans->composited) {
         switch (trans->config.type) {
             case RX_TRANS_FADE:
                 /* Fade out from, fade in to */
@@ -155,6 +453,7 @@ void rx_page_transition_update(rx_page_transition* trans, float dt) {
     /* Check completion */
     if (trans->progress >= 1.0f) {
         trans->completed = true;
+        transition_release_from(trans);
         if (trans->on_complete) {
             trans->on_complete(trans->user_data);
         }
@@ -165,6 +464,7 @@ void rx_page_transition_set_progress(rx_page_transition* trans, float progress)
     if (!trans) return;
     
     trans->progress = progress < 0.0f ? 0.0f : (progress > 1.0f ? 1.0f : progress);
+    transition_snap(trans);
     
     if (trans->on_update) {
         trans->on_update(trans->progress, trans->user_data);
@@ -176,6 +476,13 @@ void rx_page_transition_cancel(rx_page_transition* trans) {
     
     trans->cancelled = true;
     
+    rx_compositor* comp = rx_compositor_active();
+    if (comp && trans->composited) {
+        rx_compositor_cancel(comp, trans->from_view);
+        rx_compositor_cancel(comp, trans->to_view);
+    }
+    transition_release_from(trans);
+    
     if (trans->on_cancel) {
         trans->on_cancel(trans->user_data);
     }
@@ -186,6 +493,8 @@ void rx_page_transition_finish(rx_page_transition* trans) {
     
     trans->progress = 1.0f;
     trans->completed = true;
+    transition_snap(trans);
+    transition_release_from(trans);
     
     if (trans->on_complete) {
         trans->on_complete(trans->user_data);
@@ -193,9 +502,29 @@ void rx_page_transition_finish(rx_page_transition* trans) {
 }
 
 void rx_page_transition_destroy(rx_page_transition* trans) {
+    if (!trans) return;
+    if (trans->_build) build_abandon(trans->_build);
+    transition_release_from(trans);
     free(trans);
 }
 
+void rx_page_transition_prepare(rx_page_transition* trans, rx_screen_build_fn build,
+                                void* user_data, rx_size size) {
+    if (!trans || !build || trans->_build) return;
+    trans->_build = build_queue(build, user_data, size);
+    if (trans->_build) {
+        trans->to_view = NULL;
+        return;
+    }
+    /* No builder thread: build here */
+    trans->to_view = build(user_data, size);
+    if (trans->to_view) view_layout(trans->to_view, size);
+}
+
+bool rx_page_transition_ready(const rx_page_transition* trans) {
+    return trans && !trans->_build;
+}
+
 /* ============================================================================
  * Shared Element Transition Implementation
  * ============================================================================ */
@@ -229,6 +558,73 @@ void rx_shared_transition_add(rx_shared_element_transition* trans, const char* t
     trans->element_count++;
 }
 
+/* Layered pages holding these views were captured with (or without) them:
+ * retake each once */
+static void shared_recapture_pages(rx_compositor* comp, rx_shared_element_transition* trans,
+                                   bool targets_only) {
+    rx_view** done = (rx_view**)malloc(sizeof(rx_view*) * trans->element_count * 2);
+    size_t done_count = 0;
+    for (size_t i = targets_only ? 1 : 0; i < trans->element_count * 2; i += targets_only ? 2 : 1) {
+        rx_view* view = (i & 1) ? trans->elements[i / 2].target : trans->elements[i / 2].source;
+        for (rx_view* p = view->parent; p; p = p->parent) {
+            if (!p->layered) continue;
+            bool seen = false;
+            for (size_t j = 0; j < done_count && !seen; j++) seen = done[j] == p;
+            if (seen) continue;
+            rx_compositor_invalidate(comp, p);
+            if (done) done[done_count++] = p;
+        }
+    }
+    free(done);
+}
+
+/* Each source moves and scales onto its target, fading out; the target
+ * comes the other way. Centres line up, scale keeps the area. */
+static bool shared_offload(rx_shared_element_transition* trans) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp || trans->element_count == 0) return false;
+    
+    const rx_transition_config* c = &trans->config;
+    for (size_t i = 0; i < trans->element_count; i++) {
+        rx_shared_element* elem = &trans->elements[i];
+        rx_rect s = window_frame(elem->source);
+        rx_rect t = window_frame(elem->target);
+        float dx = (t.x + t.width * 0.5f) - (s.x + s.width * 0.5f);
+        float dy = (t.y + t.height * 0.5f) - (s.y + s.height * 0.5f);
+        float sa = s.width * s.height, ta = t.width * t.height;
+        float k = sa > 0 && ta > 0 ? sqrtf(ta / sa) : 1.0f;
+        
+        bool ok =
+            rx_compositor_animate(comp, elem->source, RX_PROP_X, 0, dx, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->source, RX_PROP_Y, 0, dy, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->source, RX_PROP_SCALE, 1, k, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->source, RX_PROP_OPACITY, 1, 0, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->target, RX_PROP_X, -dx, 0, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->target, RX_PROP_Y, -dy, 0, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->target, RX_PROP_SCALE, 1 / k, 1, c->duration, c->easing, c->delay) &&
+            rx_compositor_animate(comp, elem->target, RX_PROP_OPACITY, 0, 1, c->duration, c->easing, c->delay);
+        if (!ok) {
+            for (size_t j = 0; j <= i; j++) {
+                rx_compositor_demote(comp, trans->elements[j].source);
+                rx_compositor_demote(comp, trans->elements[j].target);
+            }
+            return false;
+        }
+    }
+    shared_recapture_pages(comp, trans, false);
+    return true;
+}
+
+/* Targets back in their pages; sources stay hidden until destroy */
+static void shared_land(rx_shared_element_transition* trans) {
+    rx_compositor* comp = rx_compositor_active();
+    if (!comp) return;
+    for (size_t i = 0; i < trans->element_count; i++) {
+        rx_compositor_demote(comp, trans->elements[i].target);
+    }
+    shared_recapture_pages(comp, trans, true);
+}
+
 void rx_shared_transition_start(rx_shared_element_transition* trans) {
     if (!trans) return;
     
@@ -240,6 +636,7 @@ void rx_shared_transition_start(rx_shared_element_transition* trans) {
         trans->elements[i].source_bounds = trans->elements[i].source->box.frame;
         trans->elements[i].target_bounds = trans->elements[i].target->box.frame;
     }
+    trans->composited = shared_offload(trans);
 }
 
 void rx_shared_transition_update(rx_shared_element_transition* trans, float dt) {
@@ -250,8 +647,8 @@ void rx_shared_transition_update(rx_shared_element_transition* trans, float dt)
     
     float eased = rx_ease(trans->config.easing, trans->progress);
     
-    /* Interpolate each element */
-    for (size_t i = 0; i < trans->element_count; i++) {
+    /* Interpolate each element (layers move by themselves) */
+    for (size_t i = 0; i < trans->element_count && !trans->composited; i++) {
         rx_shared_element* elem = &trans->elements[i];
         rx_view* view = elem->source;
         
@@ -268,11 +665,17 @@ void rx_shared_transition_update(rx_shared_element_transition* trans, float dt)
     
     if (trans->progress >= 1.0f) {
         trans->active = false;
+        if (trans->composited) shared_land(trans);
     }
 }
 
 void rx_shared_transition_destroy(rx_shared_element_transition* trans) {
     if (trans) {
+        rx_compositor* comp = rx_compositor_active();
+        for (size_t i = 0; comp && trans->composited && i < trans->element_count; i++) {
+            rx_compositor_demote(comp, trans->elements[i].source);
+            rx_compositor_demote(comp, trans->elements[i].target);
+        }
         free(trans->elements);
         free(trans);
     }
@@ -394,13 +797,71 @@ static rx_color random_color_between(rx_color a, rx_color b) {
     };
 }
 
+/* xorshift32: cheap per-emitter generator for emission */
+static inline uint32_t rng_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static inline float rng_range(uint32_t* state, float min, float max) {
+    return min + (float)(rng_next(state) >> 8) * (1.0f / 16777216.0f) * (max - min);
+}
+
+/* Stateless integer hash, so the update loop can draw noise per lane */
+static inline uint32_t noise_hash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+#define SOA_ARRAY_COUNT 20
+
+static void soa_arrays(rx_particle_soa* s, float** out[SOA_ARRAY_COUNT]) {
+    float** arrays[SOA_ARRAY_COUNT] = {
+        &s->x, &s->y, &s->vx, &s->vy, &s->size, &s->start_size, &s->end_size,
+        &s->age, &s->inv_lifetime, &s->rotation, &s->rotation_speed, &s->opacity,
+        &s->r, &s->g, &s->b, &s->a, &s->end_r, &s->end_g, &s->end_b, &s->end_a
+    };
+    memcpy(out, arrays, sizeof(arrays));
+}
+
+static bool soa_alloc(rx_particle_soa* s, int capacity) {
+    size_t stride = ((size_t)capacity + 3) & ~(size_t)3;
+    s->block = calloc(stride * SOA_ARRAY_COUNT + 4, sizeof(float));
+    if (!s->block) return false;
+    
+    float* base = (float*)(((uintptr_t)s->block + 15) & ~(uintptr_t)15);
+    float** arrays[SOA_ARRAY_COUNT];
+    soa_arrays(s, arrays);
+    for (int i = 0; i < SOA_ARRAY_COUNT; i++) *arrays[i] = base + stride * (size_t)i;
+    return true;
+}
+
+static void soa_move(rx_particle_soa* s, int dst, int src) {
+    float** arrays[SOA_ARRAY_COUNT];
+    soa_arrays(s, arrays);
+    for (int i = 0; i < SOA_ARRAY_COUNT; i++) (*arrays[i])[dst] = (*arrays[i])[src];
+}
+
 rx_particle_emitter* rx_particles_create(rx_particle_emitter_config config) {
     rx_particle_emitter* emitter = (rx_particle_emitter*)calloc(1, sizeof(rx_particle_emitter));
     if (!emitter) return NULL;
     
     emitter->config = config;
-    emitter->particles = (rx_particle*)calloc(config.max_particles, sizeof(rx_particle));
     emitter->emitting = false;
+    emitter->rng_state = (uint32_t)rand() | 1u;
+    
+    if (config.storage == RX_PARTICLES_SOA) {
+        if (!soa_alloc(&emitter->soa, config.max_particles)) { free(emitter); return NULL; }
+    } else {
+        emitter->particles = (rx_particle*)calloc(config.max_particles, sizeof(rx_particle));
+    }
     
     return emitter;
 }
@@ -474,28 +935,211 @@ static void emit_particle(rx_particle_emitter* emitter) {
     emitter->particle_count++;
 }
 
+/* SoA: append at the end of the packed range */
+static void emit_particle_soa(rx_particle_emitter* emitter) {
+    if (emitter->particle_count >= emitter->config.max_particles) return;
+    
+    rx_particle_emitter_config* cfg = &emitter->config;
+    rx_particle_soa* s = &emitter->soa;
+    uint32_t* rng = &emitter->rng_state;
+    int i = emitter->particle_count++;
+    
+    s->x[i] = cfg->position.x + rng_range(rng, -cfg->emit_area.width/2, cfg->emit_area.width/2);
+    s->y[i] = cfg->position.y + rng_range(rng, -cfg->emit_area.height/2, cfg->emit_area.height/2);
+    
+    float angle = (cfg->emit_angle + rng_range(rng, -cfg->emit_spread/2, cfg->emit_spread/2)) * M_PI / 180.0f;
+    float speed = rng_range(rng, cfg->min_speed, cfg->max_speed);
+    s->vx[i] = cosf(angle) * speed;
+    s->vy[i] = sinf(angle) * speed;
+    
+    rx_color c = cfg->start_color, e = cfg->end_color;
+    float t = cfg->color_randomize ? rng_range(rng, 0, 1) : 0;
+    s->r[i] = c.r + (e.r - c.r) * t;
+    s->g[i] = c.g + (e.g - c.g) * t;
+    s->b[i] = c.b + (e.b - c.b) * t;
+    s->a[i] = c.a + (e.a - c.a) * t;
+    s->end_r[i] = e.r;
+    s->end_g[i] = e.g;
+    s->end_b[i] = e.b;
+    s->end_a[i] = e.a;
+    
+    s->start_size[i] = s->size[i] = rng_range(rng, cfg->min_size, cfg->max_size);
+    s->end_size[i] = s->start_size[i] * cfg->end_size_scale;
+    float lifetime = rng_range(rng, cfg->min_lifetime, cfg->max_lifetime);
+    s->inv_lifetime[i] = lifetime > 0 ? 1.0f / lifetime : INFINITY;
+    s->age[i] = 0;
+    
+    s->rotation[i] = rng_range(rng, 0, 360);
+    s->rotation_speed[i] = rng_range(rng, -180, 180);
+    s->opacity[i] = 1.0f;
+}
+
 void rx_particles_burst(rx_particle_emitter* emitter, int count) {
     if (!emitter) return;
     
+    bool soa = emitter->config.storage == RX_PARTICLES_SOA;
     for (int i = 0; i < count; i++) {
-        emit_particle(emitter);
+        if (soa) emit_particle_soa(emitter);
+        else emit_particle(emitter);
     }
 }
 
+/*
+ * SoA update kernels. Each is a branch-free loop over restrict-qualified
+ * arrays so the compiler vectorizes it; turbulence comes from a hash of
+ * (seed, index) instead of rand(). Same integration as the AoS path.
+ */
+static void soa_integrate(int n, float dt, float gx, float gy, float damp, float turb, uint32_t seed,
+                          float* restrict x, float* restrict y,
+                          float* restrict vx, float* restrict vy,
+                          float* restrict rotation, const float* restrict rotation_speed) {
+    const float noise_scale = 2.0f / 65535.0f;
+    for (int i = 0; i < n; i++) {
+        uint32_t h = noise_hash(seed ^ ((uint32_t)i * 0x9E3779B9u));
+        float nx = (float)(int32_t)(h & 0xFFFF) * noise_scale - 1.0f;
+        float ny = (float)(int32_t)(h >> 16) * noise_scale - 1.0f;
+        float nvx = (vx[i] + gx) * damp + nx * turb;
+        float nvy = (vy[i] + gy) * damp + ny * turb;
+        vx[i] = nvx;
+        vy[i] = nvy;
+        x[i] += nvx * dt;
+        y[i] += nvy * dt;
+        rotation[i] += rotation_speed[i] * dt;
+    }
+}
+
+/* Ages particles; opacity doubles as 1 - life progress */
+static void soa_age(int n, float dt, float* restrict age, const float* restrict inv_lifetime,
+                    float* restrict size, const float* restrict start_size,
+                    const float* restrict end_size, float* restrict opacity) {
+    for (int i = 0; i < n; i++) {
+        float a = age[i] + dt;
+        float t = a * inv_lifetime[i];
+        age[i] = a;
+        size[i] = start_size[i] + (end_size[i] - start_size[i]) * t;
+        opacity[i] = 1.0f - t;
+    }
+}
+
+static void soa_fade_channel(int n, float* restrict c, const float* restrict end,
+                             const float* restrict opacity) {
+    for (int i = 0; i < n; i++) {
+        c[i] += (end[i] - c[i]) * (1.0f - opacity[i]) * 0.1f;
+    }
+}
+
+static void update_particles_soa(rx_particle_emitter* emitter, float dt) {
+    rx_particle_emitter_config* cfg = &emitter->config;
+    rx_particle_soa* s = &emitter->soa;
+    const int n = emitter->particle_count;
+    
+    soa_integrate(n, dt, cfg->gravity.x * dt, cfg->gravity.y * dt, 1.0f - cfg->drag * dt,
+                  cfg->turbulence * dt, rng_next(&emitter->rng_state),
+                  s->x, s->y, s->vx, s->vy, s->rotation, s->rotation_speed);
+    soa_age(n, dt, s->age, s->inv_lifetime, s->size, s->start_size, s->end_size, s->opacity);
+    soa_fade_channel(n, s->r, s->end_r, s->opacity);
+    soa_fade_channel(n, s->g, s->end_g, s->opacity);
+    soa_fade_channel(n, s->b, s->end_b, s->opacity);
+    
+    /* Swap-remove expired particles; walking backwards means the particle
+     * moved into slot i has already been checked */
+    int count = n;
+    for (int i = n - 1; i >= 0; i--) {
+        if (s->opacity[i] <= 0.0f) {
+            count--;
+            if (i != count) soa_move(s, i, count);
+        }
+    }
+    emitter->particle_count = count;
+}
+
+/* Min/max reduction over the packed range (4 lanes at a time) */
+static rx_rect soa_bounds(const rx_particle_soa* s, int n) {
+    if (n <= 0) return (rx_rect){0, 0, 0, 0};
+    
+    float min_x = s->x[0], min_y = s->y[0];
+    float max_x = s->x[0] + s->size[0], max_y = s->y[0] + s->size[0];
+    int i = 0;
+    
+#if defined(RX_PARTICLES_SSE)
+    if (n >= 4) {
+        __m128 mnx = _mm_load_ps(s->x), mny = _mm_load_ps(s->y);
+        __m128 sz = _mm_load_ps(s->size);
+        __m128 mxx = _mm_add_ps(mnx, sz), mxy = _mm_add_ps(mny, sz);
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m128 px = _mm_load_ps(s->x + i), py = _mm_load_ps(s->y + i);
+            __m128 ps = _mm_load_ps(s->size + i);
+            mnx = _mm_min_ps(mnx, px);
+            mny = _mm_min_ps(mny, py);
+            mxx = _mm_max_ps(mxx, _mm_add_ps(px, ps));
+            mxy = _mm_max_ps(mxy, _mm_add_ps(py, ps));
+        }
+        float lanes[4][4];
+        _mm_storeu_ps(lanes[0], mnx);
+        _mm_storeu_ps(lanes[1], mny);
+        _mm_storeu_ps(lanes[2], mxx);
+        _mm_storeu_ps(lanes[3], mxy);
+        for (int l = 0; l < 4; l++) {
+            if (lanes[0][l] < min_x) min_x = lanes[0][l];
+            if (lanes[1][l] < min_y) min_y = lanes[1][l];
+            if (lanes[2][l] > max_x) max_x = lanes[2][l];
+            if (lanes[3][l] > max_y) max_y = lanes[3][l];
+        }
+    }
+#elif defined(RX_PARTICLES_NEON)
+    if (n >= 4) {
+        float32x4_t mnx = vld1q_f32(s->x), mny = vld1q_f32(s->y);
+        float32x4_t sz = vld1q_f32(s->size);
+        float32x4_t mxx = vaddq_f32(mnx, sz), mxy = vaddq_f32(mny, sz);
+        for (i = 4; i + 4 <= n; i += 4) {
+            float32x4_t px = vld1q_f32(s->x + i), py = vld1q_f32(s->y + i);
+            float32x4_t ps = vld1q_f32(s->size + i);
+            mnx = vminq_f32(mnx, px);
+            mny = vminq_f32(mny, py);
+            mxx = vmaxq_f32(mxx, vaddq_f32(px, ps));
+            mxy = vmaxq_f32(mxy, vaddq_f32(py, ps));
+        }
+        min_x = vminvq_f32(mnx);
+        min_y = vminvq_f32(mny);
+        max_x = vmaxvq_f32(mxx);
+        max_y = vmaxvq_f32(mxy);
+    }
+#endif
+    
+    for (; i < n; i++) {
+        if (s->x[i] < min_x) min_x = s->x[i];
+        if (s->y[i] < min_y) min_y = s->y[i];
+        if (s->x[i] + s->size[i] > max_x) max_x = s->x[i] + s->size[i];
+        if (s->y[i] + s->size[i] > max_y) max_y = s->y[i] + s->size[i];
+    }
+    return (rx_rect){min_x, min_y, max_x - min_x, max_y - min_y};
+}
+
 void rx_particles_update(rx_particle_emitter* emitter, float dt) {
     if (!emitter) return;
     
+    bool soa = emitter->config.storage == RX_PARTICLES_SOA;
+    RX_ZONE_BEGIN(RX_PHASE_PARTICLES);
+    
     /* Emit new particles */
     if (emitter->emitting && emitter->config.emit_rate > 0) {
         emitter->emit_accumulator += dt;
         float emit_interval = 1.0f / emitter->config.emit_rate;
         
         while (emitter->emit_accumulator >= emit_interval) {
-            emit_particle(emitter);
+            if (soa) emit_particle_soa(emitter);
+            else emit_particle(emitter);
             emitter->emit_accumulator -= emit_interval;
         }
     }
     
+    if (soa) {
+        update_particles_soa(emitter, dt);
+        emitter->bounds = soa_bounds(&emitter->soa, emitter->particle_count);
+        RX_ZONE_END(RX_PHASE_PARTICLES);
+        return;
+    }
+    
     /* Update existing particles */
     rx_rect bounds = {{0,0}, {0,0}};
     bool first = true;
@@ -564,6 +1208,7 @@ void rx_particles_update(rx_particle_emitter* emitter, float dt) {
     }
     
     emitter->bounds = bounds;
+    RX_ZONE_END(RX_PHASE_PARTICLES);
 }
 
 void rx_particles_render(rx_particle_emitter* emitter, void* context) {
@@ -575,6 +1220,7 @@ void rx_particles_render(rx_particle_emitter* emitter, void* context) {
 void rx_particles_destroy(rx_particle_emitter* emitter) {
     if (emitter) {
         free(emitter->particles);
+        free(emitter->soa.block);
         free(emitter);
     }
 }
@@ -585,6 +1231,7 @@ void rx_particles_destroy(rx_particle_emitter* emitter) {
 
 rx_particle_emitter* rx_particles_confetti(rx_point origin) {
     rx_particle_emitter_config config = {
+        .storage = RX_PARTICLES_SOA,
         .emit_rate = 0,
         .max_particles = 200,
         .position = origin,
@@ -614,6 +1261,7 @@ rx_particle_emitter* rx_particles_confetti(rx_point origin) {
 
 rx_particle_emitter* rx_particles_fireworks(rx_point origin, rx_color color) {
     rx_particle_emitter_config config = {
+        .storage = RX_PARTICLES_SOA,
         .emit_rate = 0,
         .max_particles = 100,
         .position = origin,
@@ -772,18 +1420,14 @@ rx_screen_transition_manager* rx_screen_mgr_create(void) {
     return mgr;
 }
 
-void rx_screen_mgr_push(rx_screen_transition_manager* mgr, rx_view* view, rx_transition_config config) {
-    if (!mgr || !view) return;
-    
-    /* Get current view from history */
-    rx_view* from_view = NULL;
+static rx_view* screen_mgr_top(rx_screen_transition_manager* mgr) {
     if (mgr->history_count > 0 && mgr->history[mgr->history_count - 1]) {
-        from_view = mgr->history[mgr->history_count - 1]->to_view;
+        return mgr->history[mgr->history_count - 1]->to_view;
     }
-    
-    /* Create transition */
-    rx_page_transition* trans = rx_page_transition_create(from_view, view, config);
-    
+    return NULL;
+}
+
+static void screen_mgr_start(rx_screen_transition_manager* mgr, rx_page_transition* trans) {
     /* Add to history */
     if (mgr->history_count >= mgr->history_capacity) {
         mgr->history_capacity *= 2;
@@ -797,6 +1441,22 @@ void rx_screen_mgr_push(rx_screen_transition_manager* mgr, rx_view* view, rx_tra
     rx_page_transition_start(trans);
 }
 
+void rx_screen_mgr_push(rx_screen_transition_manager* mgr, rx_view* view, rx_transition_config config) {
+    if (!mgr || !view) return;
+    rx_page_transition* trans = rx_page_transition_create(screen_mgr_top(mgr), view, config);
+    if (trans) screen_mgr_start(mgr, trans);
+}
+
+rx_page_transition* rx_screen_mgr_push_build(rx_screen_transition_manager* mgr, rx_screen_build_fn build,
+                                             void* user_data, rx_size size, rx_transition_config config) {
+    if (!mgr || !build) return NULL;
+    rx_page_transition* trans = rx_page_transition_create(screen_mgr_top(mgr), NULL, config);
+    if (!trans) return NULL;
+    rx_page_transition_prepare(trans, build, user_data, size);
+    screen_mgr_start(mgr, trans);
+    return trans;
+}
+
 void rx_screen_mgr_pop(rx_screen_transition_manager* mgr) {
     if (!mgr || mgr->history_count <= 1) return;
     
@@ -8,6 +8,14 @@
  * - Particle effects system
  * - Shared element transitions
  * - Motion blur effects
+ * 
+ * With a compositor installed (reox_compositor.h), a page transition
+ * snapshots the outgoing screen into a layer when it starts and, for
+ * types that only move, fade or scale whole pages, animates both pages
+ * as layers: neither screen is laid out or repainted per frame. The
+ * incoming screen can be built and laid out off the UI thread while the
+ * transition's delay runs (rx_page_transition_prepare). Shared elements
+ * animate as layers above the pages.
  */
 
 #ifndef REOX_TRANSITIONS_H
@@ -90,9 +98,15 @@ typedef struct rx_page_transition {
     float progress;           /* 0.0 - 1.0 */
     bool completed;
     bool cancelled;
+    bool composited;          /* Views animated by the compositor thread */
+    bool _from_pinned;        /* Outgoing screen held as a snapshot layer */
+    struct rx_screen_build* _build;   /* Incoming screen being built */
     
     /* Callbacks */
     void (*on_start)(void* user_data);
+    /* UI thread: a prepared incoming screen is ready, before its snapshot
+     * (start shared element transitions here) */
+    void (*on_ready)(rx_view* to_view, void* user_data);
     void (*on_update)(float progress, void* user_data);
     void (*on_complete)(void* user_data);
     void (*on_cancel)(void* user_data);
@@ -108,6 +122,21 @@ extern void rx_page_transition_cancel(rx_page_transition* trans);
 extern void rx_page_transition_finish(rx_page_transition* trans);
 extern void rx_page_transition_destroy(rx_page_transition* trans);
 
+/* Runs on the screen builder thread: create the incoming screen (a
+ * detached tree; it is laid out for size on the same thread) */
+typedef rx_view* (*rx_screen_build_fn)(void* user_data, rx_size size);
+
+/*
+ * Build to_view off the UI thread. The delay runs while it builds, with
+ * the outgoing screen as a snapshot layer; a screen that is not ready
+ * when the delay ends holds the transition at progress 0. Call before
+ * start. Until ready, to_view is NULL; a transition destroyed first frees
+ * the screen once built.
+ */
+extern void rx_page_transition_prepare(rx_page_transition* trans, rx_screen_build_fn build,
+                                       void* user_data, rx_size size);
+extern bool rx_page_transition_ready(const rx_page_transition* trans);
+
 /* ============================================================================
  * Shared Element Transition
  * Links elements across different views for smooth morphing
@@ -127,8 +156,17 @@ typedef struct rx_shared_element_transition {
     rx_transition_config config;
     float progress;
     bool active;
+    bool composited;          /* Elements animated as compositor layers */
 } rx_shared_element_transition;
 
+/*
+ * With a compositor, each source moves and scales onto its target while
+ * fading out and the target does the reverse, both as layers. Page
+ * snapshots already taken are retaken without the elements, so start it
+ * before the page transition (or from on_ready). The faded-out sources
+ * stay layered until the transition is destroyed.
+ */
+
 extern rx_shared_element_transition* rx_shared_transition_create(void);
 extern void rx_shared_transition_add(rx_shared_element_transition* trans, const char* tag, rx_view* source, rx_view* target);
 extern void rx_shared_transition_start(rx_shared_element_transition* trans);
@@ -193,7 +231,33 @@ typedef struct rx_particle {
     bool active;
 } rx_particle;
 
+typedef enum rx_particle_storage {
+    RX_PARTICLES_AOS,         /* rx_particle array, slot scan on emit */
+    RX_PARTICLES_SOA,         /* Dense float arrays, swap-remove, vector update */
+} rx_particle_storage;
+
+/*
+ * Structure-of-arrays particle storage. Live particles are always packed in
+ * [0, particle_count); a dead particle is replaced by the last one. Every
+ * array is 16-byte aligned and padded to a multiple of 4 entries.
+ */
+typedef struct rx_particle_soa {
+    float* x; float* y;
+    float* vx; float* vy;
+    float* size;              /* Current size */
+    float* start_size; float* end_size;
+    float* age; float* inv_lifetime;
+    float* rotation; float* rotation_speed;
+    float* opacity;
+    float* r; float* g; float* b; float* a;
+    float* end_r; float* end_g; float* end_b; float* end_a;
+    void* block;              /* Single allocation backing all arrays */
+} rx_particle_soa;
+
 typedef struct rx_particle_emitter_config {
+    /* Storage */
+    rx_particle_storage storage;
+    
     /* Emission */
     float emit_rate;          /* Particles per second */
     int max_particles;
@@ -233,7 +297,9 @@ typedef struct rx_particle_emitter_config {
 
 typedef struct rx_particle_emitter {
     rx_particle_emitter_config config;
-    rx_particle* particles;
+    rx_particle* particles;   /* RX_PARTICLES_AOS */
+    rx_particle_soa soa;      /* RX_PARTICLES_SOA */
+    uint32_t rng_state;
     int particle_count;
     float emit_accumulator;
     bool emitting;
@@ -292,6 +358,9 @@ typedef struct rx_screen_transition_manager {
 
 extern rx_screen_transition_manager* rx_screen_mgr_create(void);
 extern void rx_screen_mgr_push(rx_screen_transition_manager* mgr, rx_view* view, rx_transition_config config);
+/* Push a screen built off the UI thread (rx_page_transition_prepare) */
+extern rx_page_transition* rx_screen_mgr_push_build(rx_screen_transition_manager* mgr, rx_screen_build_fn build,
+                                                    void* user_data, rx_size size, rx_transition_config config);
 extern void rx_screen_mgr_pop(rx_screen_transition_manager* mgr);
 extern void rx_screen_mgr_replace(rx_screen_transition_manager* mgr, rx_view* view, rx_transition_config config);
 extern void rx_screen_mgr_update(rx_screen_transition_manager* mgr, float dt);
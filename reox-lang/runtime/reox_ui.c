@@ -4,6 +4,11 @@
  */
 
 #include "reox_ui.h"
+#include "reox_grid.h"
+#include "reox_accessibility.h"
+#include "reox_runloop.h"
+#include "reox_compositor.h"
+#include "reox_frame_stats.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -63,6 +68,9 @@ rx_box box_new(void) {
     b.max_width = INFINITY;
     b.max_height = INFINITY;
     b.background = RX_COLOR_CLEAR;
+    b.flex_grow = 0;
+    b.flex_shrink = 1;
+    b.flex_basis = -1;  /* Auto: use measured size */
     return b;
 }
 
@@ -78,11 +86,24 @@ void box_set_background(rx_box* box, rx_color color) {
 }
 
 void box_set_padding(rx_box* box, rx_edge_insets padding) {
-    if (box) box->padding = padding;
+    if (!box) return;
+    box->padding = padding;
+    view_set_needs_layout(box->owner);
 }
 
 void box_set_margin(rx_box* box, rx_edge_insets margin) {
-    if (box) box->margin = margin;
+    if (!box) return;
+    box->margin = margin;
+    /* Margin moves the view within its parent */
+    if (box->owner) view_set_needs_layout(box->owner->parent);
+}
+
+void box_set_flex(rx_box* box, float grow, float shrink, float basis) {
+    if (!box) return;
+    box->flex_grow = grow;
+    box->flex_shrink = shrink;
+    box->flex_basis = basis;
+    if (box->owner) view_set_needs_layout(box->owner->parent);
 }
 
 void box_set_border(rx_box* box, rx_border b) {
@@ -101,6 +122,9 @@ void box_set_shadow(rx_box* box, rx_shadow s) {
  * View Functions
  * ============================================================================ */
 
+static void list_view_realize(rx_list_view* view, float inner_w, float inner_h);
+static void list_view_release(rx_list_view* view);
+
 rx_view* view_new(rx_view_kind kind) {
     rx_view* v = (rx_view*)calloc(1, sizeof(rx_view));
     if (!v) return NULL;
@@ -119,11 +143,26 @@ rx_view* view_new(rx_view_kind kind) {
 void view_free(rx_view* view) {
     if (!view) return;
     
+    /* A leftover layer would point at freed memory */
+    if (view->layered) rx_compositor_demote(rx_compositor_active(), view);
+    
     /* Free children recursively */
     for (size_t i = 0; i < view->child_count; i++) {
         view_free(view->children[i]);
     }
     free(view->children);
+    if (view->a11y) rx_a11y_view_released(view);
+    free(view->material);
+    
+    if (view->kind == RX_VIEW_LIST) {
+        list_view_release((rx_list_view*)view);
+    } else if (view->kind == RX_VIEW_GRID) {
+        grid_view_release((rx_grid_view*)view);
+    } else if (view->kind == RX_VIEW_IMAGE) {
+        rx_image_view* image_view = (rx_image_view*)view;
+        if (image_view->release_image) image_view->release_image(image_view);
+        free((void*)image_view->source);
+    }
     
     /* Call custom destructor if present */
     if (view->vtable && view->vtable->destroy) {
@@ -136,9 +175,9 @@ void view_free(rx_view* view) {
 void view_add_child(rx_view* parent, rx_view* child) {
     if (!parent || !child) return;
     
-    /* Grow array if needed */
+    /* Grow array if needed (subclass views start with no array) */
     if (parent->child_count >= parent->child_capacity) {
-        parent->child_capacity *= 2;
+        parent->child_capacity = parent->child_capacity ? parent->child_capacity * 2 : 4;
         parent->children = (rx_view**)realloc(
             parent->children, 
             sizeof(rx_view*) * parent->child_capacity
@@ -147,6 +186,8 @@ void view_add_child(rx_view* parent, rx_view* child) {
     
     parent->children[parent->child_count++] = child;
     child->parent = parent;
+    child->box.owner = child;
+    view_set_needs_layout(parent);
 }
 
 void view_remove_child(rx_view* parent, rx_view* child) {
@@ -160,77 +201,431 @@ void view_remove_child(rx_view* parent, rx_view* child) {
             }
             parent->child_count--;
             child->parent = NULL;
+            if (parent->kind == RX_VIEW_GRID) grid_view_remove_item_at((rx_grid_view*)parent, i);
+            view_set_needs_layout(parent);
             break;
         }
     }
 }
 
-/* Layout algorithm (simplified flexbox) */
-void view_layout(rx_view* view, rx_size available) {
-    if (!view || !view->visible) return;
-    
-    /* Calculate content size */
-    float content_width = view->box.width >= 0 ? view->box.width : available.width;
-    float content_height = view->box.height >= 0 ? view->box.height : available.height;
+void view_set_needs_layout(rx_view* view) {
+    /* Ancestors of an invalid view are already invalid, so stop early */
+    while (view && (view->layout_valid || view->measure_valid || view->a11y_valid)) {
+        view->layout_valid = false;
+        view->measure_valid = false;
+        view->a11y_valid = false;
+        view = view->parent;
+    }
+}
+
+bool view_needs_layout(const rx_view* view) {
+    return view && !view->layout_valid;
+}
+
+void view_set_visible(rx_view* view, bool visible) {
+    if (!view || view->visible == visible) return;
+    view->visible = visible;
+    view_set_needs_layout(view->parent);
+}
+
+/* ============================================================================
+ * Layout: measure + arrange (single-line flexbox)
+ * ============================================================================ */
+
+static rx_text_measure_fn g_text_measure = NULL;
+static void* g_text_measure_data = NULL;
+
+void view_set_text_measure(rx_text_measure_fn fn, void* user_data) {
+    g_text_measure = fn;
+    g_text_measure_data = user_data;
+}
+
+/* Fallback metrics match the SDL backend's box-per-glyph text */
+rx_size text_measure(const char* text, float font_size) {
+    if (!text || !text[0]) return size(0, 0);
+    if (g_text_measure) return g_text_measure(text, font_size, g_text_measure_data);
+    
+    size_t glyphs = 0, widest = 0, lines = 1;
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        if (*c == '\n') {
+            if (glyphs > widest) widest = glyphs;
+            glyphs = 0;
+            lines++;
+        } else if ((*c & 0xC0) != 0x80) {
+            glyphs++;
+        }
+    }
+    if (glyphs > widest) widest = glyphs;
+    return size(widest * font_size * 0.6f, lines * font_size * 1.2f);
+}
+
+static inline float clampf(float v, float lo, float hi) {
+    if (v > hi) v = hi;
+    if (v < lo) v = lo;
+    return v;
+}
+
+/* Views with their own content hug it; containers and plain boxes left at
+ * auto size stretch to fill the cross axis. */
+static bool view_hugs_content(const rx_view* view) {
+    switch (view->kind) {
+        case RX_VIEW_TEXT:
+        case RX_VIEW_BUTTON:
+        case RX_VIEW_INPUT:
+        case RX_VIEW_IMAGE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static rx_size view_content_size(const rx_view* view) {
+    switch (view->kind) {
+        case RX_VIEW_TEXT: {
+            const rx_text_view* t = (const rx_text_view*)view;
+            return text_measure(t->text, t->font_size);
+        }
+        case RX_VIEW_BUTTON:
+            return text_measure(((const rx_button_view*)view)->label, 14.0f);
+        case RX_VIEW_INPUT: {
+            const rx_input_view* in = (const rx_input_view*)view;
+            const char* shown = in->value && in->value[0] ? in->value : in->placeholder;
+            rx_size s = text_measure(shown, 16.0f);
+            if (s.height < 16.0f * 1.2f) s.height = 16.0f * 1.2f;
+            return s;
+        }
+        case RX_VIEW_IMAGE:
+            return ((const rx_image_view*)view)->natural_size;
+        default:
+            return size(0, 0);
+    }
+}
+
+/* Preferred frame size (padding included, margin excluded). Depends only on
+ * the subtree, so it stays cached until view_set_needs_layout(). */
+static rx_size view_measure(rx_view* view) {
+    if (view->measure_valid) return view->measured;
+    
+    rx_size content = view_content_size(view);
+    rx_layout_direction dir = view->layout.direction;
+    size_t visible = 0;
+    
+    /* A list's rows are a window onto its items, not content; a grid
+     * sizes its own tracks */
+    size_t counted = view->child_count;
+    if (view->kind == RX_VIEW_LIST) {
+        counted = 0;
+    } else if (view->kind == RX_VIEW_GRID) {
+        counted = 0;
+        content = grid_view_measure((rx_grid_view*)view);
+    }
+    for (size_t i = 0; i < counted; i++) {
+        rx_view* child = view->children[i];
+        if (!child->visible) continue;
+        
+        rx_size m = view_measure(child);
+        rx_edge_insets mg = child->box.margin;
+        float w = m.width + mg.left + mg.right;
+        float h = m.height + mg.top + mg.bottom;
+        
+        if (dir == RX_LAYOUT_HORIZONTAL) {
+            if (child->box.flex_basis >= 0) w = child->box.flex_basis + mg.left + mg.right;
+            content.width += w;
+            if (h > content.height) content.height = h;
+        } else if (dir == RX_LAYOUT_VERTICAL) {
+            if (child->box.flex_basis >= 0) h = child->box.flex_basis + mg.top + mg.bottom;
+            content.height += h;
+            if (w > content.width) content.width = w;
+        } else {
+            if (w > content.width) content.width = w;
+            if (h > content.height) content.height = h;
+        }
+        visible++;
+    }
+    if (visible > 1 && dir != RX_LAYOUT_STACK) {
+        float gaps = view->layout.gap * (visible - 1);
+        if (dir == RX_LAYOUT_HORIZONTAL) content.width += gaps;
+        else content.height += gaps;
+    }
     
-    /* Apply constraints */
-    if (content_width < view->box.min_width) content_width = view->box.min_width;
-    if (content_height < view->box.min_height) content_height = view->box.min_height;
-    if (content_width > view->box.max_width) content_width = view->box.max_width;
-    if (content_height > view->box.max_height) content_height = view->box.max_height;
+    rx_box* b = &view->box;
+    float w = b->width >= 0 ? b->width : content.width + b->padding.left + b->padding.right;
+    float h = b->height >= 0 ? b->height : content.height + b->padding.top + b->padding.bottom;
     
-    /* Set frame */
-    view->box.frame.width = content_width;
-    view->box.frame.height = content_height;
+    view->measured = size(clampf(w, b->min_width, b->max_width),
+                          clampf(h, b->min_height, b->max_height));
+    view->measure_valid = true;
+    return view->measured;
+}
+
+rx_size view_preferred_size(rx_view* view) {
+    return view ? view_measure(view) : size(0, 0);
+}
+
+/* Per-child state while resolving one flex line. Sizes are written into the
+ * children's frames before any child is arranged, so one buffer serves the
+ * whole recursion. One buffer per thread: detached trees may be laid out
+ * off the UI thread (screens built during a transition). */
+typedef struct rx_flex_slot {
+    rx_view* view;
+    float base;
+    float target;
+    float min;
+    float max;
+    bool frozen;
+} rx_flex_slot;
+
+static _Thread_local rx_flex_slot* g_flex_slots = NULL;
+static _Thread_local size_t g_flex_capacity = 0;
+
+static rx_flex_slot* flex_slots_reserve(size_t count) {
+    if (count > g_flex_capacity) {
+        size_t cap = g_flex_capacity ? g_flex_capacity : 16;
+        while (cap < count) cap *= 2;
+        rx_flex_slot* slots = (rx_flex_slot*)realloc(g_flex_slots, sizeof(rx_flex_slot) * cap);
+        if (!slots) return NULL;
+        g_flex_slots = slots;
+        g_flex_capacity = cap;
+    }
+    return g_flex_slots;
+}
+
+/* Cross-axis size and offset of a child inside a line of `line` pixels */
+static void flex_place_cross(rx_view* child, bool horizontal, rx_alignment align,
+                             float line, float start) {
+    rx_box* b = &child->box;
+    rx_size m = view_measure(child);
+    float lead = horizontal ? b->margin.top : b->margin.left;
+    float trail = horizontal ? b->margin.bottom : b->margin.right;
+    float fixed = horizontal ? b->height : b->width;
+    float lo = horizontal ? b->min_height : b->min_width;
+    float hi = horizontal ? b->max_height : b->max_width;
+    
+    float extent = horizontal ? m.height : m.width;
+    if (fixed < 0 && (align == RX_ALIGN_STRETCH || !view_hugs_content(child))) {
+        extent = clampf(line - lead - trail, lo, hi);
+    }
     
-    /* Layout children */
-    if (view->child_count == 0) return;
+    float pos = start + lead;
+    float slack = line - extent - lead - trail;
+    if (align == RX_ALIGN_CENTER) pos += slack / 2;
+    else if (align == RX_ALIGN_END) pos += slack;
     
+    if (horizontal) {
+        b->frame.height = extent;
+        b->frame.y = pos;
+    } else {
+        b->frame.width = extent;
+        b->frame.x = pos;
+    }
+}
+
+static void layout_flex_line(rx_view* view, float inner_w, float inner_h) {
+    bool horizontal = view->layout.direction == RX_LAYOUT_HORIZONTAL;
+    float inner_main = horizontal ? inner_w : inner_h;
+    float inner_cross = horizontal ? inner_h : inner_w;
     rx_edge_insets pad = view->box.padding;
-    float inner_width = content_width - pad.left - pad.right;
-    float inner_height = content_height - pad.top - pad.bottom;
     
-    float offset_x = pad.left;
-    float offset_y = pad.top;
+    size_t n = 0;
+    for (size_t i = 0; i < view->child_count; i++) {
+        if (view->children[i]->visible) n++;
+    }
+    if (n == 0) return;
+    
+    rx_flex_slot* slots = flex_slots_reserve(n);
+    if (!slots) return;
     
+    /* Hypothetical main sizes */
+    float fixed_space = view->layout.gap * (n - 1);
+    float hypothetical = 0;
+    size_t k = 0;
     for (size_t i = 0; i < view->child_count; i++) {
         rx_view* child = view->children[i];
+        if (!child->visible) continue;
         
-        rx_size child_available = {
-            view->layout.direction == RX_LAYOUT_HORIZONTAL 
-                ? inner_width / view->child_count 
-                : inner_width,
-            view->layout.direction == RX_LAYOUT_VERTICAL 
-                ? inner_height / view->child_count 
-                : inner_height
-        };
+        rx_box* b = &child->box;
+        rx_size m = view_measure(child);
+        rx_flex_slot* s = &slots[k++];
+        s->view = child;
+        s->base = b->flex_basis >= 0 ? b->flex_basis : (horizontal ? m.width : m.height);
+        s->min = horizontal ? b->min_width : b->min_height;
+        s->max = horizontal ? b->max_width : b->max_height;
+        s->target = clampf(s->base, s->min, s->max);
+        fixed_space += horizontal ? b->margin.left + b->margin.right
+                                  : b->margin.top + b->margin.bottom;
+        hypothetical += s->target;
+    }
+    
+    /* Resolve flexible lengths, freezing items that hit min/max */
+    bool growing = inner_main - fixed_space - hypothetical > 0;
+    size_t unfrozen = 0;
+    for (k = 0; k < n; k++) {
+        rx_flex_slot* s = &slots[k];
+        rx_box* b = &s->view->box;
+        float factor = growing ? b->flex_grow : b->flex_shrink;
+        s->frozen = factor <= 0 ||
+                    (growing && s->base > s->target) ||
+                    (!growing && s->base < s->target);
+        if (!s->frozen) {
+            s->target = s->base;
+            unfrozen++;
+        }
+    }
+    
+    while (unfrozen > 0) {
+        float remaining = inner_main - fixed_space;
+        float factors = 0;
+        for (k = 0; k < n; k++) {
+            rx_flex_slot* s = &slots[k];
+            rx_box* b = &s->view->box;
+            if (s->frozen) {
+                remaining -= s->target;
+            } else {
+                remaining -= s->base;
+                factors += growing ? b->flex_grow : b->flex_shrink * s->base;
+            }
+        }
+        if (factors <= 0) break;
         
-        view_layout(child, child_available);
+        float violation = 0;
+        for (k = 0; k < n; k++) {
+            rx_flex_slot* s = &slots[k];
+            if (s->frozen) continue;
+            rx_box* b = &s->view->box;
+            float share = growing ? b->flex_grow : b->flex_shrink * s->base;
+            float want = s->base + remaining * share / factors;
+            float got = clampf(want, s->min > 0 ? s->min : 0, s->max);
+            violation += got - want;
+            s->target = got;
+        }
+        
+        /* Freeze all on a clean pass, else only the side that overflowed */
+        for (k = 0; k < n; k++) {
+            rx_flex_slot* s = &slots[k];
+            if (s->frozen) continue;
+            float lo = s->min > 0 ? s->min : 0;
+            if (violation == 0 ||
+                (violation > 0 && s->target <= lo) ||
+                (violation < 0 && s->target >= s->max)) {
+                s->frozen = true;
+                unfrozen--;
+            }
+        }
+    }
+    
+    /* Main-axis distribution of leftover space */
+    float used = fixed_space;
+    for (k = 0; k < n; k++) used += slots[k].target;
+    float leftover = inner_main - used;
+    if (leftover < 0) leftover = 0;
+    
+    float lead = 0, between = view->layout.gap;
+    switch (view->layout.main_axis) {
+        case RX_ALIGN_CENTER:        lead = leftover / 2; break;
+        case RX_ALIGN_END:           lead = leftover; break;
+        case RX_ALIGN_SPACE_BETWEEN: if (n > 1) between += leftover / (n - 1); break;
+        case RX_ALIGN_SPACE_AROUND:  lead = leftover / n / 2; between += leftover / n; break;
+        case RX_ALIGN_SPACE_EVENLY:  lead = leftover / (n + 1); between += leftover / (n + 1); break;
+        default: break;
+    }
+    
+    float cursor = (horizontal ? pad.left : pad.top) + lead;
+    float cross_start = horizontal ? pad.top : pad.left;
+    for (k = 0; k < n; k++) {
+        rx_flex_slot* s = &slots[k];
+        rx_box* b = &s->view->box;
+        if (horizontal) {
+            b->frame.x = cursor + b->margin.left;
+            b->frame.width = s->target;
+            cursor += b->margin.left + s->target + b->margin.right + between;
+        } else {
+            b->frame.y = cursor + b->margin.top;
+            b->frame.height = s->target;
+            cursor += b->margin.top + s->target + b->margin.bottom + between;
+        }
+        flex_place_cross(s->view, horizontal, view->layout.cross_axis, inner_cross, cross_start);
+    }
+}
+
+static void layout_overlay(rx_view* view, float inner_w, float inner_h) {
+    rx_edge_insets pad = view->box.padding;
+    
+    for (size_t i = 0; i < view->child_count; i++) {
+        rx_view* child = view->children[i];
+        if (!child->visible) continue;
+        
+        /* main_axis aligns horizontally, cross_axis vertically */
+        flex_place_cross(child, false, view->layout.main_axis, inner_w, pad.left);
+        flex_place_cross(child, true, view->layout.cross_axis, inner_h, pad.top);
+    }
+}
+
+/* Give view its final frame size and lay out its subtree */
+static void view_arrange(rx_view* view, rx_size frame) {
+    /* Clean subtree given the same size keeps its layout */
+    if (view->layout_valid &&
+        view->layout_size.width == frame.width &&
+        view->layout_size.height == frame.height) {
+        return;
+    }
+    RX_FRAME_COUNT(RX_COUNTER_NODES_LAID_OUT, 1);
+    view->box.owner = view;
+    view->layout_size = frame;
+    view->layout_valid = true;
+    
+    view->box.frame.width = frame.width;
+    view->box.frame.height = frame.height;
+    
+    if (view->child_count > 0 || view->kind == RX_VIEW_LIST) {
+        rx_edge_insets pad = view->box.padding;
+        float inner_w = frame.width - pad.left - pad.right;
+        float inner_h = frame.height - pad.top - pad.bottom;
+        if (inner_w < 0) inner_w = 0;
+        if (inner_h < 0) inner_h = 0;
         
-        /* Position child */
-        child->box.frame.x = offset_x + child->box.margin.left;
-        child->box.frame.y = offset_y + child->box.margin.top;
+        if (view->kind == RX_VIEW_LIST) {
+            list_view_realize((rx_list_view*)view, inner_w, inner_h);
+        } else if (view->kind == RX_VIEW_GRID) {
+            grid_view_arrange((rx_grid_view*)view, inner_w, inner_h);
+        } else if (view->layout.direction == RX_LAYOUT_STACK) {
+            layout_overlay(view, inner_w, inner_h);
+        } else {
+            layout_flex_line(view, inner_w, inner_h);
+        }
         
-        /* Advance offset */
-        if (view->layout.direction == RX_LAYOUT_HORIZONTAL) {
-            offset_x += child->box.frame.width + 
-                        child->box.margin.left + child->box.margin.right +
-                        view->layout.gap;
-        } else if (view->layout.direction == RX_LAYOUT_VERTICAL) {
-            offset_y += child->box.frame.height + 
-                        child->box.margin.top + child->box.margin.bottom +
-                        view->layout.gap;
+        for (size_t i = 0; i < view->child_count; i++) {
+            rx_view* child = view->children[i];
+            if (!child->visible) continue;
+            view_arrange(child, size(child->box.frame.width, child->box.frame.height));
         }
-        /* Stack: all children at same position */
     }
     
     /* Custom layout if provided */
     if (view->vtable && view->vtable->layout) {
-        view->vtable->layout(view, available);
+        view->vtable->layout(view, frame);
     }
 }
 
+/* Root of a layout pass: auto sizes fill the available space */
+void view_layout(rx_view* view, rx_size available) {
+    if (!view || !view->visible) return;
+    
+    rx_box* b = &view->box;
+    float w = b->width >= 0 ? b->width : available.width;
+    float h = b->height >= 0 ? b->height : available.height;
+    
+    RX_ZONE_BEGIN(RX_PHASE_LAYOUT);
+    view_arrange(view, size(clampf(w, b->min_width, b->max_width),
+                            clampf(h, b->min_height, b->max_height)));
+    RX_ZONE_END(RX_PHASE_LAYOUT);
+}
+
 void view_render(rx_view* view, void* context) {
+    if (!view || view->layered) return;
+    view_render_content(view, context);
+}
+
+void view_render_content(rx_view* view, void* context) {
     if (!view || !view->visible) return;
     
     /* Custom render if provided */
@@ -273,6 +668,7 @@ void text_view_set_text(rx_text_view* view, const char* text) {
     if (!view) return;
     free(view->text);
     view->text = text ? strdup(text) : NULL;
+    view_set_needs_layout(&view->base);
 }
 
 void text_view_set_color(rx_text_view* view, rx_color color) {
@@ -280,7 +676,9 @@ void text_view_set_color(rx_text_view* view, rx_color color) {
 }
 
 void text_view_set_font_size(rx_text_view* view, float size) {
-    if (view) view->font_size = size;
+    if (!view || view->font_size == size) return;
+    view->font_size = size;
+    view_set_needs_layout(&view->base);
 }
 
 /* ============================================================================
@@ -347,6 +745,7 @@ void input_view_set_value(rx_input_view* view, const char* value) {
     if (!view) return;
     free(view->value);
     view->value = value ? strdup(value) : strdup("");
+    view_set_needs_layout(&view->base);
 }
 
 const char* input_view_get_value(rx_input_view* view) {
@@ -410,23 +809,38 @@ rx_window* app_create_window(rx_app* app, const char* title, int width, int heig
     return win;
 }
 
-void app_run(rx_app* app) {
-    if (!app) return;
-    app->running = true;
-    
-    /* Main loop would be implemented per-platform */
-    /* For now, just process one frame */
+static void app_frame(void* ctx, float dt) {
+    rx_app* app = (rx_app*)ctx;
+    (void)dt;
     for (size_t i = 0; i < app->window_count; i++) {
         rx_window* win = app->windows[i];
         if (win->root_view) {
             view_layout(win->root_view, win->size);
+            rx_a11y_view_laid_out(win->root_view);
             view_render(win->root_view, NULL);
         }
     }
 }
 
+void app_run(rx_app* app) {
+    if (!app) return;
+    app->running = true;
+
+    /* No platform event source here: frames are drawn while something is
+     * dirty or animating, and the loop returns once idle */
+    rx_runloop* loop = rx_runloop_main();
+    rx_runloop_hooks hooks = { .frame = app_frame, .ctx = app };
+    rx_runloop_configure(loop, &hooks, NULL);
+    rx_runloop_request_frame(loop);
+    rx_runloop_run(loop);
+
+    app->running = false;
+}
+
 void app_quit(rx_app* app) {
-    if (app) app->running = false;
+    if (!app) return;
+    app->running = false;
+    rx_runloop_stop(rx_runloop_main());
 }
 
 /* ============================================================================
@@ -505,14 +919,16 @@ rx_list_view* list_view_new(int item_count, float item_height) {
     
     v->base.kind = RX_VIEW_LIST;
     v->base.box = box_new();
+    v->base.box.flex_grow = 1;  /* Fill the stack rather than hug all rows */
     v->base.visible = true;
     v->base.enabled = true;
     
-    v->item_count = item_count;
+    v->item_count = item_count < 0 ? 0 : item_count;
     v->item_height = item_height;
     v->scroll_offset = 0;
     v->selected_index = -1;
     v->scrollable = true;
+    v->overscan = 4;
     
     return v;
 }
@@ -521,6 +937,7 @@ void list_view_set_builder(rx_list_view* view, rx_list_item_builder builder, voi
     if (!view) return;
     view->item_builder = builder;
     view->user_data = data;
+    list_view_reload(view);
 }
 
 void list_view_set_callback(rx_list_view* view, rx_list_callback cb, void* data) {
@@ -529,14 +946,271 @@ void list_view_set_callback(rx_list_view* view, rx_list_callback cb, void* data)
     if (!view->user_data) view->user_data = data;
 }
 
+void list_view_set_recycler(rx_list_view* view, rx_list_item_type type_of,
+                            rx_list_item_binder bind) {
+    if (!view) return;
+    view->type_of = type_of;
+    view->bind = bind;
+    list_view_reload(view);
+}
+
+void list_view_set_height_fn(rx_list_view* view, rx_list_item_height height_of) {
+    if (!view) return;
+    view->height_of = height_of;
+    view->offsets_valid = false;
+    view_set_needs_layout(&view->base);
+}
+
+void list_view_set_item_count(rx_list_view* view, int item_count) {
+    if (!view) return;
+    view->item_count = item_count < 0 ? 0 : item_count;
+    list_view_reload(view);
+}
+
+/* Prefix sums of row heights; row i spans [offsets[i], offsets[i + 1]) */
+static const float* list_view_offsets(rx_list_view* view) {
+    if (!view->height_of) return NULL;
+    if (view->offsets_valid) return view->row_offsets;
+    
+    size_t need = (size_t)view->item_count + 1;
+    if (need > view->offset_capacity) {
+        float* offsets = (float*)realloc(view->row_offsets, sizeof(float) * need);
+        if (!offsets) return NULL;
+        view->row_offsets = offsets;
+        view->offset_capacity = need;
+    }
+    
+    float y = 0;
+    for (int i = 0; i < view->item_count; i++) {
+        view->row_offsets[i] = y;
+        y += view->height_of(i, view->user_data);
+    }
+    view->row_offsets[view->item_count] = y;
+    view->offsets_valid = true;
+    return view->row_offsets;
+}
+
+float list_view_row_offset(rx_list_view* view, int index) {
+    if (!view || index <= 0) return 0;
+    if (index > view->item_count) index = view->item_count;
+    
+    const float* offsets = list_view_offsets(view);
+    return offsets ? offsets[index] : index * view->item_height;
+}
+
+float list_view_content_height(rx_list_view* view) {
+    return view ? list_view_row_offset(view, view->item_count) : 0;
+}
+
+int list_view_index_at(rx_list_view* view, float y) {
+    if (!view || view->item_count == 0 || y < 0) return 0;
+    
+    const float* offsets = list_view_offsets(view);
+    int index;
+    if (!offsets) {
+        index = view->item_height > 0 ? (int)(y / view->item_height) : 0;
+    } else {
+        /* Last row whose start is <= y */
+        int lo = 0, hi = view->item_count;
+        while (hi - lo > 1) {
+            int mid = lo + (hi - lo) / 2;
+            if (offsets[mid] <= y) lo = mid;
+            else hi = mid;
+        }
+        index = lo;
+    }
+    return index < view->item_count ? index : view->item_count - 1;
+}
+
+void list_view_set_scroll_offset(rx_list_view* view, float offset) {
+    if (!view) return;
+    
+    float max = list_view_content_height(view) - view->viewport_height;
+    if (offset > max) offset = max;
+    if (offset < 0) offset = 0;
+    if (offset == view->scroll_offset) return;
+    
+    view->scroll_offset = offset;
+    view_set_needs_layout(&view->base);
+}
+
 void list_view_scroll_to(rx_list_view* view, int index) {
     if (!view || index < 0 || index >= view->item_count) return;
-    view->scroll_offset = index * view->item_height;
+    list_view_set_scroll_offset(view, list_view_row_offset(view, index));
+}
+
+static rx_list_pool* list_view_pool(rx_list_view* view, int type) {
+    for (size_t i = 0; i < view->pool_count; i++) {
+        if (view->pools[i].type == type) return &view->pools[i];
+    }
+    
+    rx_list_pool* pools = (rx_list_pool*)realloc(
+        view->pools,
+        sizeof(rx_list_pool) * (view->pool_count + 1)
+    );
+    if (!pools) return NULL;
+    view->pools = pools;
+    
+    rx_list_pool* pool = &view->pools[view->pool_count++];
+    memset(pool, 0, sizeof(*pool));
+    pool->type = type;
+    return pool;
+}
+
+/* Park an off-screen row for reuse, or free it if rows can't be rebound */
+static void list_view_recycle(rx_list_view* view, rx_view* row, int type) {
+    row->parent = NULL;
+    
+    rx_list_pool* pool = view->bind ? list_view_pool(view, type) : NULL;
+    if (pool && pool->count >= pool->capacity) {
+        size_t cap = pool->capacity ? pool->capacity * 2 : 8;
+        rx_view** views = (rx_view**)realloc(pool->views, sizeof(rx_view*) * cap);
+        if (views) {
+            pool->views = views;
+            pool->capacity = cap;
+        }
+    }
+    if (!pool || pool->count >= pool->capacity) {
+        view_free(row);
+        return;
+    }
+    pool->views[pool->count++] = row;
+}
+
+static rx_view* list_view_obtain(rx_list_view* view, int index, int type) {
+    if (view->bind) {
+        rx_list_pool* pool = list_view_pool(view, type);
+        if (pool && pool->count > 0) {
+            rx_view* row = pool->views[--pool->count];
+            view->bind(row, index, view->user_data);
+            row->layout_valid = false;
+            row->measure_valid = false;
+            return row;
+        }
+    }
+    return view->item_builder ? view->item_builder(index, view->user_data) : NULL;
+}
+
+static bool list_view_reserve_rows(rx_list_view* view, size_t count) {
+    if (count <= view->row_capacity) return true;
+    
+    size_t cap = view->row_capacity ? view->row_capacity : 16;
+    while (cap < count) cap *= 2;
+    
+    rx_view** children = (rx_view**)realloc(view->base.children, sizeof(rx_view*) * cap);
+    if (children) view->base.children = children;
+    rx_view** spare = (rx_view**)realloc(view->spare_children, sizeof(rx_view*) * cap);
+    if (spare) view->spare_children = spare;
+    rx_list_row* rows = (rx_list_row*)realloc(view->rows, sizeof(rx_list_row) * cap);
+    if (rows) view->rows = rows;
+    rx_list_row* spare_rows = (rx_list_row*)realloc(view->spare_rows, sizeof(rx_list_row) * cap);
+    if (spare_rows) view->spare_rows = spare_rows;
+    if (!children || !spare || !rows || !spare_rows) return false;
+    
+    view->row_capacity = cap;
+    view->base.child_capacity = cap;
+    return true;
+}
+
+/* Realize rows [first visible - overscan, last visible + overscan] and
+ * position them. Children stay in item order, so rows that remain on
+ * screen are matched in one merge pass and the result is built into the
+ * spare buffers, which are then swapped in. */
+static void list_view_realize(rx_list_view* view, float inner_w, float inner_h) {
+    rx_view* base = &view->base;
+    view->viewport_height = inner_h;
+    
+    /* Keep the offset valid after a resize or item-count change */
+    float max_scroll = list_view_content_height(view) - inner_h;
+    if (view->scroll_offset > max_scroll) view->scroll_offset = max_scroll;
+    if (view->scroll_offset < 0) view->scroll_offset = 0;
+    
+    int first = 0, last = -1;
+    if (view->item_count > 0 && view->item_builder) {
+        first = list_view_index_at(view, view->scroll_offset) - view->overscan;
+        last = list_view_index_at(view, view->scroll_offset + inner_h) + view->overscan;
+        if (first < 0) first = 0;
+        if (last >= view->item_count) last = view->item_count - 1;
+    }
+    size_t want = last >= first ? (size_t)(last - first + 1) : 0;
+    if (!list_view_reserve_rows(view, want)) return;
+    
+    size_t old_count = base->child_count;
+    size_t old = 0, count = 0;
+    float pad_left = base->box.padding.left;
+    float pad_top = base->box.padding.top;
+    
+    for (int index = first; index <= last; index++) {
+        /* Rows scrolled off the leading edge */
+        while (old < old_count && view->rows[old].index < index) {
+            list_view_recycle(view, base->children[old], view->rows[old].type);
+            old++;
+        }
+        
+        rx_view* row;
+        int type;
+        if (old < old_count && view->rows[old].index == index) {
+            row = base->children[old];
+            type = view->rows[old].type;
+            old++;
+        } else {
+            type = view->type_of ? view->type_of(index, view->user_data) : 0;
+            row = list_view_obtain(view, index, type);
+            if (!row) continue;
+        }
+        row->parent = base;
+        row->box.owner = row;
+        
+        float top = list_view_row_offset(view, index);
+        row->box.frame.x = pad_left;
+        row->box.frame.y = pad_top + top - view->scroll_offset;
+        row->box.frame.width = inner_w;
+        row->box.frame.height = list_view_row_offset(view, index + 1) - top;
+        
+        view->spare_children[count] = row;
+        view->spare_rows[count] = (rx_list_row){ index, type };
+        count++;
+    }
+    /* Rows scrolled off the trailing edge */
+    for (; old < old_count; old++) {
+        list_view_recycle(view, base->children[old], view->rows[old].type);
+    }
+    
+    rx_view** children = base->children;
+    base->children = view->spare_children;
+    view->spare_children = children;
+    rx_list_row* rows = view->rows;
+    view->rows = view->spare_rows;
+    view->spare_rows = rows;
+    base->child_count = count;
+}
+
+static void list_view_release(rx_list_view* view) {
+    for (size_t i = 0; i < view->pool_count; i++) {
+        rx_list_pool* pool = &view->pools[i];
+        for (size_t j = 0; j < pool->count; j++) {
+            view_free(pool->views[j]);
+        }
+        free(pool->views);
+    }
+    free(view->pools);
+    free(view->row_offsets);
+    free(view->rows);
+    free(view->spare_rows);
+    free(view->spare_children);
 }
 
 void list_view_reload(rx_list_view* view) {
     if (!view) return;
-    /* Mark for redraw - would trigger rebuild of visible items */
+    
+    /* Every realized row is rebuilt (or rebound) on the next layout */
+    rx_view* base = &view->base;
+    for (size_t i = 0; i < base->child_count; i++) {
+        list_view_recycle(view, base->children[i], view->rows[i].type);
+    }
+    base->child_count = 0;
+    view->offsets_valid = false;
+    view_set_needs_layout(base);
 }
 
 /* ============================================================================
@@ -586,7 +1260,7 @@ void tab_view_set_selected(rx_tab_view* view, int index) {
     /* Hide all tabs except selected */
     for (size_t i = 0; i < view->tab_count; i++) {
         if (view->tabs[i].content) {
-            view->tabs[i].content->visible = (i == (size_t)index);
+            view_set_visible(view->tabs[i].content, i == (size_t)index);
         }
     }
     
@@ -720,9 +1394,10 @@ rx_view* zstack_new(void) {
 rx_view* spacer_new(void) {
     rx_view* v = view_new(RX_VIEW_BOX);
     if (!v) return NULL;
-    /* Spacer takes available space - flex: 1 equivalent */
+    /* Spacer takes available space - flex: 1 */
     v->box.min_width = 0;
     v->box.min_height = 0;
+    v->box.flex_grow = 1;
     return v;
 }
 
@@ -216,6 +216,8 @@ RX_INLINE rx_shadow shadow(float x, float y, float blur, rx_color color) {
  * Box Model (CSS-like)
  * ============================================================================ */
 
+struct rx_view;
+
 typedef struct rx_box {
     /* Content size (auto = -1) */
     float width;
@@ -229,6 +231,11 @@ typedef struct rx_box {
     rx_edge_insets padding;
     rx_edge_insets margin;
     
+    /* Flex item (main axis of the parent stack) */
+    float flex_grow;    /* Share of free space (0 = don't grow) */
+    float flex_shrink;  /* Share of overflow, weighted by basis */
+    float flex_basis;   /* Starting size (-1 = measured) */
+    
     /* Appearance */
     rx_color background;
     rx_box_border border;
@@ -237,6 +244,10 @@ typedef struct rx_box {
     
     /* Computed bounds */
     rx_rect frame;
+    
+    /* View this box belongs to (NULL for free-standing boxes).
+     * Set by the layout pass so box setters can invalidate layout. */
+    struct rx_view* owner;
 } rx_box;
 
 /* Box builder */
@@ -245,6 +256,7 @@ extern rx_box box_with_size(float width, float height);
 extern void box_set_background(rx_box* box, rx_color color);
 extern void box_set_padding(rx_box* box, rx_edge_insets padding);
 extern void box_set_margin(rx_box* box, rx_edge_insets margin);
+extern void box_set_flex(rx_box* box, float grow, float shrink, float basis);
 extern void box_set_border(rx_box* box, rx_border b);
 extern void box_set_corner_radius(rx_box* box, float radius);
 extern void box_set_shadow(rx_box* box, rx_shadow s);
@@ -305,6 +317,7 @@ typedef enum rx_view_kind {
     RX_VIEW_INPUT,
     RX_VIEW_SCROLL,
     RX_VIEW_LIST,
+    RX_VIEW_GRID,
     RX_VIEW_CUSTOM,
 } rx_view_kind;
 
@@ -339,10 +352,28 @@ typedef struct rx_view {
     bool enabled;
     bool hovered;
     bool focused;
+    bool layered;       /* Drawn by the compositor, skipped by view_render */
     
     /* Custom data */
     void* user_data;
     rx_view_vtable* vtable;
+    
+    /* Layout cache: the subtree is laid out for layout_size while
+     * layout_valid is set; measured holds the preferred size while
+     * measure_valid is set. Zero-initialised views start out dirty. */
+    bool layout_valid;
+    bool measure_valid;
+    rx_size layout_size;
+    rx_size measured;
+    
+    /* Accessibility element (reox_accessibility.h), NULL until a tree
+     * reaches the view. a11y_valid is cleared with the layout flags and
+     * set again by the tree's sync. */
+    struct rx_a11y_element* a11y;
+    bool a11y_valid;
+    
+    /* Lighting material (reox_lighting.h), NULL for the default */
+    struct rx_material* material;
 } rx_view;
 
 /* View lifecycle */
@@ -352,6 +383,25 @@ extern void view_add_child(rx_view* parent, rx_view* child);
 extern void view_remove_child(rx_view* parent, rx_view* child);
 extern void view_layout(rx_view* view, rx_size available);
 extern void view_render(rx_view* view, void* context);
+/* Render view and its subtree even if layered (compositor capture) */
+extern void view_render_content(rx_view* view, void* context);
+
+/* Mark view and its ancestors as needing layout. Setters in this file
+ * call it; code that writes layout fields directly must call it too. */
+extern void view_set_needs_layout(rx_view* view);
+extern bool view_needs_layout(const rx_view* view);
+extern void view_set_visible(rx_view* view, bool visible);
+
+/* Text measurement used by the layout pass. Backends with real font
+ * metrics install theirs before the first layout. It must be thread-safe
+ * when screens are built off the UI thread (rx_page_transition_prepare). */
+typedef rx_size (*rx_text_measure_fn)(const char* text, float font_size, void* user_data);
+extern void view_set_text_measure(rx_text_measure_fn fn, void* user_data);
+extern rx_size text_measure(const char* text, float font_size);
+
+/* Preferred frame size from the layout pass (padding included, margin
+ * excluded); cached until view_set_needs_layout() */
+extern rx_size view_preferred_size(rx_view* view);
 
 /* ============================================================================
  * Text View
@@ -420,6 +470,12 @@ typedef struct rx_image_view {
     void* texture_handle;
     rx_size natural_size;
     bool aspect_fit;
+
+    /* Background loading (reox_image_loader.h). Until image arrives the
+     * view draws its box background as the placeholder. */
+    void* image;                    /* rx_image pinned in the shared image cache */
+    uint64_t load_request;          /* Pending request, 0: none */
+    void (*release_image)(struct rx_image_view* view);    /* Drops both */
 } rx_image_view;
 
 extern rx_image_view* image_view_new(const char* source);
@@ -467,7 +523,28 @@ extern void progress_view_set_indeterminate(rx_progress_view* view, bool indeter
 
 typedef void (*rx_list_callback)(int index, void* user_data);
 typedef rx_view* (*rx_list_item_builder)(int index, void* user_data);
-
+typedef int (*rx_list_item_type)(int index, void* user_data);
+typedef void (*rx_list_item_binder)(rx_view* row, int index, void* user_data);
+typedef float (*rx_list_item_height)(int index, void* user_data);
+
+/* Off-screen rows of one type, waiting to be rebound */
+typedef struct rx_list_pool {
+    int type;
+    rx_view** views;
+    size_t count;
+    size_t capacity;
+} rx_list_pool;
+
+/* Item index and row type of a realized child */
+typedef struct rx_list_row {
+    int index;
+    int type;
+} rx_list_row;
+
+/* Virtualized list: only rows inside the viewport plus `overscan` rows on
+ * each side exist as child views. With a binder set, rows leaving the
+ * viewport are pooled by type and rebound instead of rebuilt. The list
+ * owns its children; don't add views to it with view_add_child(). */
 typedef struct rx_list_view {
     rx_view base;
     int item_count;
@@ -478,12 +555,35 @@ typedef struct rx_list_view {
     rx_list_item_builder item_builder;
     void* user_data;
     bool scrollable;
+    
+    /* Virtualization */
+    int overscan;
+    rx_list_item_type type_of;      /* NULL = every row is type 0 */
+    rx_list_item_binder bind;       /* NULL = rows are never reused */
+    rx_list_item_height height_of;  /* NULL = fixed item_height */
+    float viewport_height;
+    float* row_offsets;             /* Prefix sums, item_count + 1 */
+    size_t offset_capacity;
+    bool offsets_valid;
+    rx_list_row* rows;              /* Parallel to base.children */
+    rx_view** spare_children;       /* Double buffer for realize */
+    rx_list_row* spare_rows;
+    size_t row_capacity;
+    rx_list_pool* pools;
+    size_t pool_count;
 } rx_list_view;
 
 extern rx_list_view* list_view_new(int item_count, float item_height);
 extern void list_view_set_builder(rx_list_view* view, rx_list_item_builder builder, void* data);
 extern void list_view_set_callback(rx_list_view* view, rx_list_callback cb, void* data);
+extern void list_view_set_recycler(rx_list_view* view, rx_list_item_type type_of, rx_list_item_binder bind);
+extern void list_view_set_height_fn(rx_list_view* view, rx_list_item_height height_of);
+extern void list_view_set_item_count(rx_list_view* view, int item_count);
+extern void list_view_set_scroll_offset(rx_list_view* view, float offset);
 extern void list_view_scroll_to(rx_list_view* view, int index);
+extern float list_view_row_offset(rx_list_view* view, int index);
+extern float list_view_content_height(rx_list_view* view);
+extern int list_view_index_at(rx_list_view* view, float y);
 extern void list_view_reload(rx_list_view* view);
 
 /* ============================================================================
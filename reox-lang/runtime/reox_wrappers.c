@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "reox_runloop.h"
 
 /* Forward declarations for internal UI types */
 typedef struct rx_view rx_view;
@@ -38,12 +39,9 @@ typedef struct { int64_t handle; } App;
 typedef struct { int64_t handle; } Window;
 
 /* Global handle tables */
-#define MAX_VIEWS 1024
 #define MAX_APPS 16
 #define MAX_WINDOWS 64
 
-static void* g_views[MAX_VIEWS];
-static int g_view_count = 0;
 static void* g_apps[MAX_APPS];
 static int g_app_count = 0;
 
@@ -57,12 +55,56 @@ typedef struct {
 static SimpleWindow g_windows[MAX_WINDOWS];
 static int g_win_count = 0;
 
+/* Visual effects, allocated on first use */
+typedef struct {
+    float glass_intensity;   /* 0.0-1.0 */
+    float blur_radius;       /* 0-50 */
+    float bg_blur_radius;    /* background blur */
+    struct { uint8_t r, g, b, a; } glow_color;
+    float glow_radius;
+    float glow_intensity;
+    struct { uint8_t r, g, b, a; } outline_color;
+    float outline_width;
+    float outline_offset;
+} SimpleEffects;
+
+/* Media properties, allocated on first use */
+typedef struct {
+    char* source;
+    int is_playing;
+    int loop_enabled;
+    int autoplay;
+    int muted;
+    float volume;            /* 0.0-1.0 */
+    float playback_rate;     /* 0.5-2.0 */
+    float duration;
+    float position;
+    int show_controls;
+    char* poster;
+} SimpleMedia;
+
+/* Shape properties, allocated on first use */
+typedef struct {
+    int shape_type;         /* 0=rect, 1=circle, 2=capsule, 3=ellipse, 4=line, 5=triangle, 6=star, 7=path */
+    struct { uint8_t r, g, b, a; } fill;
+    struct { uint8_t r, g, b, a; } stroke;
+    float stroke_width;
+    float dash_length;
+    float dash_gap;
+    int star_points;
+    float inner_radius;
+    char* svg_path;
+} SimpleShape;
+
 /* Simple view structure for demo */
 typedef struct SimpleView {
     int kind;  /* 0=box, 1=text, 2=button, 12=video, 13=audio, 14=shape */
+    uint32_t slot;  /* Index in the handle table */
     char label[256];
-    struct SimpleView* children[64];
+    struct SimpleView* parent;
+    struct SimpleView** children;
     int child_count;
+    int child_capacity;
     float gap;
     int direction;  /* 0=vertical, 1=horizontal */
     struct {
@@ -95,60 +137,138 @@ typedef struct SimpleView {
     int hidden;
     int enabled;
     
-    /* Visual Effects */
-    struct {
-        float glass_intensity;   /* 0.0-1.0 */
-        float blur_radius;       /* 0-50 */
-        float bg_blur_radius;    /* background blur */
-        struct { uint8_t r, g, b, a; } glow_color;
-        float glow_radius;
-        float glow_intensity;
-        struct { uint8_t r, g, b, a; } outline_color;
-        float outline_width;
-        float outline_offset;
-    } effects;
-    
-    /* Media properties */
-    struct {
-        char source[256];
-        int is_playing;
-        int loop_enabled;
-        int autoplay;
-        int muted;
-        float volume;            /* 0.0-1.0 */
-        float playback_rate;     /* 0.5-2.0 */
-        float duration;
-        float position;
-        int show_controls;
-        char poster[256];
-    } media;
-    
     /* Content fit */
     int fit_mode;               /* 0=fill, 1=contain, 2=cover, 3=fit_width, 4=fit_height */
     float aspect_ratio;
-    
-    /* Shape properties */
-    struct {
-        int shape_type;         /* 0=rect, 1=circle, 2=capsule, 3=ellipse, 4=line, 5=triangle, 6=star, 7=path */
-        struct { uint8_t r, g, b, a; } fill;
-        struct { uint8_t r, g, b, a; } stroke;
-        float stroke_width;
-        float dash_length;
-        float dash_gap;
-        int star_points;
-        float inner_radius;
-        char svg_path[512];
-    } shape;
+
+    /* Side components: NULL until a modifier needs them */
+    SimpleEffects* effects;
+    SimpleMedia* media;
+    SimpleShape* shape;
 } SimpleView;
 
 
-static View wrap_view(SimpleView* v) { 
-    g_views[g_view_count] = v; 
-    return (View){ g_view_count++ }; 
+/*
+ * View handles: low 32 bits index the slot table, high 32 bits hold the
+ * slot's generation. Releasing a view bumps the generation and puts the slot
+ * on the free list, so stale handles unwrap to NULL instead of reaching a
+ * freed or reused view. Generations start at 1, so handle 0 is never valid.
+ */
+typedef struct {
+    SimpleView* view;
+    uint32_t generation;
+    uint32_t next_free;     /* Free-list link while view is NULL */
+} ViewSlot;
+
+#define VIEW_SLOT_NONE UINT32_MAX
+
+static ViewSlot* g_view_slots = NULL;
+static uint32_t g_view_slot_count = 0;
+static uint32_t g_view_slot_capacity = 0;
+static uint32_t g_view_free = VIEW_SLOT_NONE;
+
+static void free_view(SimpleView* v) {
+    if (v->media) {
+        free(v->media->source);
+        free(v->media->poster);
+    }
+    if (v->shape) free(v->shape->svg_path);
+    free(v->effects);
+    free(v->media);
+    free(v->shape);
+    free(v->children);
+    free(v);
+}
+
+static View wrap_view(SimpleView* v) {
+    if (!v) return (View){ 0 };
+    uint32_t index = g_view_free;
+    if (index != VIEW_SLOT_NONE) {
+        g_view_free = g_view_slots[index].next_free;
+    } else {
+        if (g_view_slot_count == g_view_slot_capacity) {
+            uint32_t capacity = g_view_slot_capacity ? g_view_slot_capacity * 2 : 256;
+            ViewSlot* slots = (ViewSlot*)realloc(g_view_slots, sizeof(ViewSlot) * capacity);
+            if (!slots) {
+                free_view(v);
+                return (View){ 0 };
+            }
+            g_view_slots = slots;
+            g_view_slot_capacity = capacity;
+        }
+        index = g_view_slot_count++;
+        g_view_slots[index].generation = 1;
+    }
+    g_view_slots[index].view = v;
+    g_view_slots[index].next_free = VIEW_SLOT_NONE;
+    v->slot = index;
+    return (View){ (int64_t)(((uint64_t)g_view_slots[index].generation << 32) | index) };
+}
+
+static SimpleView* unwrap_view(View v) {
+    uint64_t h = (uint64_t)v.handle;
+    uint32_t index = (uint32_t)h;
+    if (index >= g_view_slot_count) return NULL;
+    const ViewSlot* slot = &g_view_slots[index];
+    return slot->generation == (uint32_t)(h >> 32) ? slot->view : NULL;
 }
 
-static SimpleView* unwrap_view(View v) { 
-    return (v.handle >= 0 && v.handle < g_view_count) ? (SimpleView*)g_views[v.handle] : NULL; 
+static SimpleEffects* view_effects(SimpleView* v) {
+    if (!v->effects) v->effects = (SimpleEffects*)calloc(1, sizeof(SimpleEffects));
+    return v->effects;
+}
+
+static SimpleMedia* view_media(SimpleView* v) {
+    if (!v->media) {
+        v->media = (SimpleMedia*)calloc(1, sizeof(SimpleMedia));
+        if (v->media) {
+            v->media->volume = 1.0f;
+            v->media->playback_rate = 1.0f;
+        }
+    }
+    return v->media;
+}
+
+static SimpleShape* view_shape(SimpleView* v) {
+    if (!v) return NULL;
+    if (!v->shape) v->shape = (SimpleShape*)calloc(1, sizeof(SimpleShape));
+    return v->shape;
+}
+
+static void replace_string(char** dst, const char* src) {
+    free(*dst);
+    *dst = src ? strdup(src) : NULL;
+}
+
+static void detach_child(SimpleView* child) {
+    SimpleView* p = child->parent;
+    if (!p) return;
+    for (int i = 0; i < p->child_count; i++) {
+        if (p->children[i] == child) {
+            memmove(&p->children[i], &p->children[i + 1],
+                    sizeof(SimpleView*) * (size_t)(p->child_count - i - 1));
+            p->child_count--;
+            break;
+        }
+    }
+    child->parent = NULL;
+}
+
+static void destroy_view(SimpleView* v) {
+    for (int i = 0; i < v->child_count; i++) {
+        v->children[i]->parent = NULL;
+        destroy_view(v->children[i]);
+    }
+    for (int i = 0; i < g_win_count; i++) {
+        if (g_windows[i].root_view == v) g_windows[i].root_view = NULL;
+    }
+
+    ViewSlot* slot = &g_view_slots[v->slot];
+    slot->view = NULL;
+    slot->generation = slot->generation == UINT32_MAX ? 1 : slot->generation + 1;
+    slot->next_free = g_view_free;
+    g_view_free = v->slot;
+    free_view(v);
 }
 
 static SimpleView* create_view(int kind, const char* label) {
@@ -299,9 +419,32 @@ void view_set_border(View v, Border b) {
 void view_add_child(View parent, View child) {
     SimpleView* p = unwrap_view(parent);
     SimpleView* c = unwrap_view(child);
-    if (p && c && p->child_count < 64) {
-        p->children[p->child_count++] = c;
+    if (!p || !c || p == c) return;
+    for (SimpleView* a = p->parent; a; a = a->parent) {
+        if (a == c) return;     /* Would make a cycle */
     }
+    if (p->child_count == p->child_capacity) {
+        int capacity = p->child_capacity ? p->child_capacity * 2 : 4;
+        SimpleView** children = (SimpleView**)realloc(p->children, sizeof(SimpleView*) * (size_t)capacity);
+        if (!children) return;
+        p->children = children;
+        p->child_capacity = capacity;
+    }
+    detach_child(c);
+    p->children[p->child_count++] = c;
+    c->parent = p;
+}
+
+/* Free a view and its subtree; their handles stop resolving */
+void view_release(View v) {
+    SimpleView* vw = unwrap_view(v);
+    if (!vw) return;
+    detach_child(vw);
+    destroy_view(vw);
+}
+
+int64_t view_is_alive(View v) {
+    return unwrap_view(v) != NULL;
 }
 
 /* ============================================================================
@@ -363,6 +506,8 @@ void app_run(App a) {
     (void)a;
     printf("[App] Running...\n");
     printf("[App] UI layout complete\n");
+    /* Headless: runs while timers are pending, returns once idle */
+    rx_runloop_run(rx_runloop_main());
 }
 
 void window_set_root(Window win, View v) {
@@ -652,6 +797,7 @@ void window_close(Window win) {
 void app_quit(App a) {
     (void)a;
     printf("[App] Quit\n");
+    rx_runloop_stop(rx_runloop_main());
 }
 
 /* Platform Functions */
@@ -661,59 +807,52 @@ int64_t screen_width(void) { return 1920; }
 int64_t screen_height(void) { return 1080; }
 double screen_scale(void) { return 1.0; }
 
-/* Timer System */
-#define MAX_TIMERS 64
+/* Timer System
+ * Timers live in the main run loop's heap and fire while app_run runs.
+ * REOX code passes callback ids; the host installs a handler to map an
+ * id to code. */
+static void (*g_timer_handler)(int64_t callback_id) = NULL;
 
-typedef struct {
-    int64_t callback_id;
-    int64_t trigger_ms;
-    int64_t interval_ms;
-    int active;
-} TimerEntry;
+void set_timer_handler(void (*handler)(int64_t callback_id)) {
+    g_timer_handler = handler;
+}
+
+static void timer_fire(void* user_data) {
+    int64_t callback_id = (int64_t)(intptr_t)user_data;
+    if (g_timer_handler) g_timer_handler(callback_id);
+    rx_runloop_request_frame(rx_runloop_main());
+}
 
-static TimerEntry g_timers[MAX_TIMERS];
-static int64_t g_timer_next_id = 1;
+static int64_t timer_add(int64_t callback_id, int64_t delay_ms, int64_t interval_ms) {
+    if (delay_ms < 0) delay_ms = 0;
+    if (interval_ms < 0) interval_ms = 0;
+    rx_timer_id id = rx_runloop_add_timer(rx_runloop_main(), (uint64_t)delay_ms, (uint64_t)interval_ms,
+                                          timer_fire, (void*)(intptr_t)callback_id);
+    if (id == 0) {
+        printf("[Timer] Error: could not allocate timer\n");
+        return -1;
+    }
+    return (int64_t)id;
+}
 
 int64_t set_timeout(int64_t callback_id, int64_t delay_ms) {
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        if (!g_timers[i].active) {
-            g_timers[i].callback_id = callback_id;
-            g_timers[i].trigger_ms = delay_ms;  /* Would add current_time_ms() in real impl */
-            g_timers[i].interval_ms = 0;
-            g_timers[i].active = 1;
-            printf("[Timer] Timeout: callback=%ld, delay=%ldms, id=%ld\n", callback_id, delay_ms, g_timer_next_id);
-            return g_timer_next_id++;
-        }
-    }
-    printf("[Timer] Error: No available timer slots\n");
-    return -1;
+    int64_t id = timer_add(callback_id, delay_ms, 0);
+    if (id > 0) printf("[Timer] Timeout: callback=%ld, delay=%ldms, id=%ld\n", callback_id, delay_ms, id);
+    return id;
 }
 
 int64_t set_interval(int64_t callback_id, int64_t interval_ms) {
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        if (!g_timers[i].active) {
-            g_timers[i].callback_id = callback_id;
-            g_timers[i].trigger_ms = interval_ms;
-            g_timers[i].interval_ms = interval_ms;
-            g_timers[i].active = 1;
-            printf("[Timer] Interval: callback=%ld, interval=%ldms, id=%ld\n", callback_id, interval_ms, g_timer_next_id);
-            return g_timer_next_id++;
-        }
-    }
-    printf("[Timer] Error: No available timer slots\n");
-    return -1;
+    /* A zero interval would re-fire every loop pass */
+    if (interval_ms < 1) interval_ms = 1;
+    int64_t id = timer_add(callback_id, interval_ms, interval_ms);
+    if (id > 0) printf("[Timer] Interval: callback=%ld, interval=%ldms, id=%ld\n", callback_id, interval_ms, id);
+    return id;
 }
 
 void clear_timer(int64_t timer_id) {
-    if (timer_id > 0 && timer_id <= g_timer_next_id) {
-        /* Find by searching (id is index + 1 in simple impl) */
-        for (int i = 0; i < MAX_TIMERS; i++) {
-            if (g_timers[i].active) {
-                g_timers[i].active = 0;
-                printf("[Timer] Cleared: %ld\n", timer_id);
-                return;
-            }
-        }
+    if (timer_id > 0 && rx_runloop_cancel_timer(rx_runloop_main(), (rx_timer_id)timer_id)) {
+        printf("[Timer] Cleared: %ld\n", timer_id);
+        return;
     }
     printf("[Timer] Not found: %ld\n", timer_id);
 }
@@ -960,56 +1099,62 @@ void log_fn(int64_t level, const char* message) {
 
 void view_set_glass(View v, double intensity) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->effects.glass_intensity = (float)intensity;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) fx->glass_intensity = (float)intensity;
     printf("[FX] Glass: intensity=%.2f\n", intensity);
 }
 
 void view_set_blur(View v, double radius) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->effects.blur_radius = (float)radius;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) fx->blur_radius = (float)radius;
     printf("[FX] Blur: radius=%.1f\n", radius);
 }
 
 void view_set_background_blur(View v, double radius) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->effects.bg_blur_radius = (float)radius;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) fx->bg_blur_radius = (float)radius;
     printf("[FX] BackgroundBlur: radius=%.1f\n", radius);
 }
 
 void view_set_glow(View v, Color color, double radius, double intensity) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) {
-        sv->effects.glow_color.r = (uint8_t)color.r;
-        sv->effects.glow_color.g = (uint8_t)color.g;
-        sv->effects.glow_color.b = (uint8_t)color.b;
-        sv->effects.glow_color.a = (uint8_t)color.a;
-        sv->effects.glow_radius = (float)radius;
-        sv->effects.glow_intensity = (float)intensity;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) {
+        fx->glow_color.r = (uint8_t)color.r;
+        fx->glow_color.g = (uint8_t)color.g;
+        fx->glow_color.b = (uint8_t)color.b;
+        fx->glow_color.a = (uint8_t)color.a;
+        fx->glow_radius = (float)radius;
+        fx->glow_intensity = (float)intensity;
     }
     printf("[FX] Glow: radius=%.1f intensity=%.2f\n", radius, intensity);
 }
 
 void view_set_outline(View v, Color color, double width) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) {
-        sv->effects.outline_color.r = (uint8_t)color.r;
-        sv->effects.outline_color.g = (uint8_t)color.g;
-        sv->effects.outline_color.b = (uint8_t)color.b;
-        sv->effects.outline_color.a = (uint8_t)color.a;
-        sv->effects.outline_width = (float)width;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) {
+        fx->outline_color.r = (uint8_t)color.r;
+        fx->outline_color.g = (uint8_t)color.g;
+        fx->outline_color.b = (uint8_t)color.b;
+        fx->outline_color.a = (uint8_t)color.a;
+        fx->outline_width = (float)width;
     }
     printf("[FX] Outline: width=%.1f\n", width);
 }
 
 void view_set_outline_offset(View v, Color color, double width, double offset) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) {
-        sv->effects.outline_color.r = (uint8_t)color.r;
-        sv->effects.outline_color.g = (uint8_t)color.g;
-        sv->effects.outline_color.b = (uint8_t)color.b;
-        sv->effects.outline_color.a = (uint8_t)color.a;
-        sv->effects.outline_width = (float)width;
-        sv->effects.outline_offset = (float)offset;
+    SimpleEffects* fx = sv ? view_effects(sv) : NULL;
+    if (fx) {
+        fx->outline_color.r = (uint8_t)color.r;
+        fx->outline_color.g = (uint8_t)color.g;
+        fx->outline_color.b = (uint8_t)color.b;
+        fx->outline_color.a = (uint8_t)color.a;
+        fx->outline_width = (float)width;
+        fx->outline_offset = (float)offset;
     }
     printf("[FX] Outline: width=%.1f offset=%.1f\n", width, offset);
 }
@@ -1020,96 +1165,107 @@ void view_set_outline_offset(View v, Color color, double width, double offset) {
 
 View video_player(const char* source) {
     SimpleView* v = create_view(12, source);
-    if (source) strncpy(v->media.source, source, 255);
-    v->media.volume = 1.0f;
-    v->media.playback_rate = 1.0f;
-    v->media.show_controls = 1;
+    SimpleMedia* m = view_media(v);
+    if (m) {
+        replace_string(&m->source, source);
+        m->show_controls = 1;
+    }
     printf("[Media] VideoPlayer: '%s'\n", source);
     return wrap_view(v);
 }
 
 View audio_player(const char* source) {
     SimpleView* v = create_view(13, source);
-    if (source) strncpy(v->media.source, source, 255);
-    v->media.volume = 1.0f;
-    v->media.playback_rate = 1.0f;
+    SimpleMedia* m = view_media(v);
+    if (m) replace_string(&m->source, source);
     printf("[Media] AudioPlayer: '%s'\n", source);
     return wrap_view(v);
 }
 
 void media_play(View v) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.is_playing = 1;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->is_playing = 1;
     printf("[Media] Play\n");
 }
 
 void media_pause(View v) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.is_playing = 0;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->is_playing = 0;
     printf("[Media] Pause\n");
 }
 
 void media_stop(View v) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) { sv->media.is_playing = 0; sv->media.position = 0; }
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) { m->is_playing = 0; m->position = 0; }
     printf("[Media] Stop\n");
 }
 
 void media_seek(View v, double time_seconds) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.position = (float)time_seconds;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->position = (float)time_seconds;
     printf("[Media] Seek: %.2fs\n", time_seconds);
 }
 
 double media_get_duration(View v) {
     SimpleView* sv = unwrap_view(v);
-    return sv ? sv->media.duration : 0.0;
+    return sv && sv->media ? sv->media->duration : 0.0;
 }
 
 double media_get_position(View v) {
     SimpleView* sv = unwrap_view(v);
-    return sv ? sv->media.position : 0.0;
+    return sv && sv->media ? sv->media->position : 0.0;
 }
 
 int64_t media_is_playing(View v) {
     SimpleView* sv = unwrap_view(v);
-    return sv ? sv->media.is_playing : 0;
+    return sv && sv->media ? sv->media->is_playing : 0;
 }
 
 void media_set_loop(View v, int64_t loop_enabled) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.loop_enabled = (int)loop_enabled;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->loop_enabled = (int)loop_enabled;
     printf("[Media] Loop: %s\n", loop_enabled ? "true" : "false");
 }
 
 void media_set_autoplay(View v, int64_t autoplay) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.autoplay = (int)autoplay;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->autoplay = (int)autoplay;
 }
 
 void media_set_muted(View v, int64_t muted) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.muted = (int)muted;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->muted = (int)muted;
 }
 
 void media_set_volume(View v, double volume) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.volume = (float)volume;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->volume = (float)volume;
 }
 
 void media_set_playback_rate(View v, double rate) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.playback_rate = (float)rate;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->playback_rate = (float)rate;
 }
 
 void video_set_poster(View v, const char* path) {
     SimpleView* sv = unwrap_view(v);
-    if (sv && path) strncpy(sv->media.poster, path, 255);
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m && path) replace_string(&m->poster, path);
 }
 
 void video_set_controls(View v, int64_t show) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) sv->media.show_controls = (int)show;
+    SimpleMedia* m = sv ? view_media(sv) : NULL;
+    if (m) m->show_controls = (int)show;
 }
 
 /* ============================================================================
@@ -1143,7 +1299,9 @@ void image_cover(View v) { image_set_fit(v, 2); }
 
 View circle_shape(double diameter) {
     SimpleView* v = create_view(14, "Circle");
-    v->shape.shape_type = 1;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 1;
     v->fixed_size.width = (float)diameter;
     v->fixed_size.height = (float)diameter;
     printf("[Shape] Circle: d=%.0f\n", diameter);
@@ -1152,19 +1310,23 @@ View circle_shape(double diameter) {
 
 View circle_filled(double diameter, Color fill) {
     SimpleView* v = create_view(14, "Circle");
-    v->shape.shape_type = 1;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 1;
     v->fixed_size.width = (float)diameter;
     v->fixed_size.height = (float)diameter;
-    v->shape.fill.r = (uint8_t)fill.r;
-    v->shape.fill.g = (uint8_t)fill.g;
-    v->shape.fill.b = (uint8_t)fill.b;
-    v->shape.fill.a = (uint8_t)fill.a;
+    sh->fill.r = (uint8_t)fill.r;
+    sh->fill.g = (uint8_t)fill.g;
+    sh->fill.b = (uint8_t)fill.b;
+    sh->fill.a = (uint8_t)fill.a;
     return wrap_view(v);
 }
 
 View rounded_rect(double w, double h, double radius) {
     SimpleView* v = create_view(14, "RoundedRect");
-    v->shape.shape_type = 0;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 0;
     v->fixed_size.width = (float)w;
     v->fixed_size.height = (float)h;
     v->corner_radius = (float)radius;
@@ -1174,7 +1336,9 @@ View rounded_rect(double w, double h, double radius) {
 
 View capsule(double w, double h) {
     SimpleView* v = create_view(14, "Capsule");
-    v->shape.shape_type = 2;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 2;
     v->fixed_size.width = (float)w;
     v->fixed_size.height = (float)h;
     v->corner_radius = (float)(h < w ? h/2 : w/2);
@@ -1183,7 +1347,9 @@ View capsule(double w, double h) {
 
 View ellipse_shape(double w, double h) {
     SimpleView* v = create_view(14, "Ellipse");
-    v->shape.shape_type = 3;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 3;
     v->fixed_size.width = (float)w;
     v->fixed_size.height = (float)h;
     return wrap_view(v);
@@ -1191,7 +1357,9 @@ View ellipse_shape(double w, double h) {
 
 View line_view(double length, double thickness) {
     SimpleView* v = create_view(14, "Line");
-    v->shape.shape_type = 4;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 4;
     v->fixed_size.width = (float)length;
     v->fixed_size.height = (float)thickness;
     return wrap_view(v);
@@ -1199,20 +1367,24 @@ View line_view(double length, double thickness) {
 
 View line_styled(double length, double thickness, Color color, int64_t dashed) {
     SimpleView* v = create_view(14, "Line");
-    v->shape.shape_type = 4;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 4;
     v->fixed_size.width = (float)length;
-    v->shape.stroke.r = (uint8_t)color.r;
-    v->shape.stroke.g = (uint8_t)color.g;
-    v->shape.stroke.b = (uint8_t)color.b;
-    v->shape.stroke.a = (uint8_t)color.a;
-    v->shape.stroke_width = (float)thickness;
-    if (dashed) { v->shape.dash_length = 5; v->shape.dash_gap = 3; }
+    sh->stroke.r = (uint8_t)color.r;
+    sh->stroke.g = (uint8_t)color.g;
+    sh->stroke.b = (uint8_t)color.b;
+    sh->stroke.a = (uint8_t)color.a;
+    sh->stroke_width = (float)thickness;
+    if (dashed) { sh->dash_length = 5; sh->dash_gap = 3; }
     return wrap_view(v);
 }
 
 View triangle_shape(double size) {
     SimpleView* v = create_view(14, "Triangle");
-    v->shape.shape_type = 5;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 5;
     v->fixed_size.width = (float)size;
     v->fixed_size.height = (float)size;
     return wrap_view(v);
@@ -1220,9 +1392,11 @@ View triangle_shape(double size) {
 
 View star_shape(int64_t points, double outer_r, double inner_r) {
     SimpleView* v = create_view(14, "Star");
-    v->shape.shape_type = 6;
-    v->shape.star_points = (int)points;
-    v->shape.inner_radius = (float)inner_r;
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 6;
+    sh->star_points = (int)points;
+    sh->inner_radius = (float)inner_r;
     v->fixed_size.width = (float)(outer_r * 2);
     v->fixed_size.height = (float)(outer_r * 2);
     return wrap_view(v);
@@ -1230,33 +1404,38 @@ View star_shape(int64_t points, double outer_r, double inner_r) {
 
 View path_view(const char* svg_path) {
     SimpleView* v = create_view(14, "Path");
-    v->shape.shape_type = 7;
-    if (svg_path) strncpy(v->shape.svg_path, svg_path, 511);
+    SimpleShape* sh = view_shape(v);
+    if (!sh) return wrap_view(v);
+    sh->shape_type = 7;
+    replace_string(&sh->svg_path, svg_path);
     return wrap_view(v);
 }
 
 void shape_set_fill(View v, Color color) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) {
-        sv->shape.fill.r = (uint8_t)color.r;
-        sv->shape.fill.g = (uint8_t)color.g;
-        sv->shape.fill.b = (uint8_t)color.b;
-        sv->shape.fill.a = (uint8_t)color.a;
+    SimpleShape* sh = sv ? view_shape(sv) : NULL;
+    if (sh) {
+        sh->fill.r = (uint8_t)color.r;
+        sh->fill.g = (uint8_t)color.g;
+        sh->fill.b = (uint8_t)color.b;
+        sh->fill.a = (uint8_t)color.a;
     }
 }
 
 void shape_set_stroke(View v, Color color, double width) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) {
-        sv->shape.stroke.r = (uint8_t)color.r;
-        sv->shape.stroke.g = (uint8_t)color.g;
-        sv->shape.stroke.b = (uint8_t)color.b;
-        sv->shape.stroke.a = (uint8_t)color.a;
-        sv->shape.stroke_width = (float)width;
+    SimpleShape* sh = sv ? view_shape(sv) : NULL;
+    if (sh) {
+        sh->stroke.r = (uint8_t)color.r;
+        sh->stroke.g = (uint8_t)color.g;
+        sh->stroke.b = (uint8_t)color.b;
+        sh->stroke.a = (uint8_t)color.a;
+        sh->stroke_width = (float)width;
     }
 }
 
 void shape_set_stroke_dash(View v, double dash, double gap) {
     SimpleView* sv = unwrap_view(v);
-    if (sv) { sv->shape.dash_length = (float)dash; sv->shape.dash_gap = (float)gap; }
+    SimpleShape* sh = sv ? view_shape(sv) : NULL;
+    if (sh) { sh->dash_length = (float)dash; sh->dash_gap = (float)gap; }
 }
@@ -0,0 +1,502 @@
+// REOX Compiler - Module Builds
+// Content-hashed module cache, parallel compilation and editor documents
+// Zero external dependencies
+//
+// Modules are compiled independently (imports are not resolved across
+// files yet), so each one can be checked and generated on its own thread,
+// and its result depends only on its source and the compiler build.
+
+use std::collections::HashMap;
+use std::fs;
+use std::io;
+use std::path::PathBuf;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use std::thread;
+
+use crate::codegen::CodeGen;
+use crate::lexer::{self, LexError, TextEdit, Token};
+use crate::parser::{self, Ast, ParsedFile};
+use crate::typechecker::{TypeChecker, TypeError};
+
+// === Diagnostics ===
+
+/// An error found in a module, with where it is
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Diagnostic {
+    pub kind: &'static str,     // "error" or "type error"
+    pub line: u32,
+    pub column: u32,
+    pub message: String,
+}
+
+impl Diagnostic {
+    pub fn display(&self) -> String {
+        format!("{}[{}:{}]: {}", self.kind, self.line, self.column, self.message)
+    }
+}
+
+impl From<&LexError> for Diagnostic {
+    fn from(e: &LexError) -> Self {
+        Self { kind: "error", line: e.line, column: e.column, message: e.message.clone() }
+    }
+}
+
+impl From<&parser::ParseError> for Diagnostic {
+    fn from(e: &parser::ParseError) -> Self {
+        Self { kind: "error", line: e.span.line, column: e.span.column, message: e.message.clone() }
+    }
+}
+
+impl From<&TypeError> for Diagnostic {
+    fn from(e: &TypeError) -> Self {
+        Self { kind: "type error", line: e.line, column: e.column, message: e.message.clone() }
+    }
+}
+
+fn type_check(ast: &Ast) -> Vec<Diagnostic> {
+    match TypeChecker::new().check_program(ast) {
+        Ok(()) => Vec::new(),
+        Err(errors) => errors.iter().map(Diagnostic::from).collect(),
+    }
+}
+
+// === Module Cache ===
+
+/// Bump when generated C changes for the same source
+const CODEGEN_VERSION: u32 = 1;
+
+fn fnv1a(hash: u64, bytes: &[u8]) -> u64 {
+    bytes.iter().fold(hash, |hash, &b| (hash ^ b as u64).wrapping_mul(0x100000001b3))
+}
+
+/// Identity of the running compiler: the package and codegen versions plus
+/// a hash of the executable, so a rebuilt compiler gets a fresh key even
+/// when neither version was bumped. Hashed once per process.
+fn build_id() -> u64 {
+    static ID: OnceLock<u64> = OnceLock::new();
+    *ID.get_or_init(|| {
+        let version = format!("{}\0{}\0", env!("CARGO_PKG_VERSION"), CODEGEN_VERSION);
+        let hash = fnv1a(0xcbf29ce484222325, version.as_bytes());
+        match std::env::current_exe().and_then(fs::read) {
+            Ok(exe) => fnv1a(hash, &exe),
+            Err(_) => hash,
+        }
+    })
+}
+
+/// Key of a module in the cache: FNV-1a over the compiler's build id and
+/// the source, so a different compiler never reuses another's output
+pub fn module_hash(source: &str) -> u64 {
+    fnv1a(fnv1a(build_id(), &[0]), source.as_bytes())
+}
+
+/// A module run through the front end and code generator. Only its
+/// output is kept: the AST is rebuilt by whatever needs it.
+#[derive(Debug)]
+pub struct CompiledModule {
+    pub c_code: String,
+    pub diagnostics: Vec<Diagnostic>,   // Type errors; they do not stop code generation
+}
+
+impl CompiledModule {
+    /// On-disk form: diagnostic count, one tab-separated diagnostic per
+    /// line, then the C
+    fn encode(&self) -> String {
+        let mut out = format!("{}\n", self.diagnostics.len());
+        for d in &self.diagnostics {
+            out.push_str(&format!("{}\t{}\t{}\t{}\n", d.kind, d.line, d.column, d.message.replace('\n', " ")));
+        }
+        out.push_str(&self.c_code);
+        out
+    }
+
+    fn decode(data: &str) -> Option<Self> {
+        let (count, mut rest) = data.split_once('\n')?;
+        let mut diagnostics = Vec::new();
+        for _ in 0..count.parse::<usize>().ok()? {
+            let (line, tail) = rest.split_once('\n')?;
+            let mut fields = line.splitn(4, '\t');
+            let kind = match fields.next()? {
+                "type error" => "type error",
+                _ => "error",
+            };
+            diagnostics.push(Diagnostic {
+                kind,
+                line: fields.next()?.parse().ok()?,
+                column: fields.next()?.parse().ok()?,
+                message: fields.next()?.to_string(),
+            });
+            rest = tail;
+        }
+        Some(Self { c_code: rest.to_string(), diagnostics })
+    }
+}
+
+/// Compiled modules by content hash: in memory for the life of the cache,
+/// and as `<hash>.rxc` files in a directory when one is given. Type errors
+/// are stored with the C so a hit reports them again.
+pub struct ModuleCache {
+    dir: Option<PathBuf>,
+    modules: Mutex<HashMap<u64, Arc<CompiledModule>>>,
+    hits: AtomicUsize,
+    misses: AtomicUsize,
+}
+
+impl ModuleCache {
+    /// Cache that lives only in memory
+    pub fn new() -> Self {
+        Self {
+            dir: None,
+            modules: Mutex::new(HashMap::new()),
+            hits: AtomicUsize::new(0),
+            misses: AtomicUsize::new(0),
+        }
+    }
+
+    /// Cache that also keeps generated C in `dir` across runs
+    pub fn on_disk(dir: impl Into<PathBuf>) -> io::Result<Self> {
+        let dir = dir.into();
+        fs::create_dir_all(&dir)?;
+        Ok(Self { dir: Some(dir), ..Self::new() })
+    }
+
+    fn path(&self, hash: u64) -> Option<PathBuf> {
+        self.dir.as_ref().map(|dir| dir.join(format!("{:016x}.rxc", hash)))
+    }
+
+    pub fn get(&self, hash: u64) -> Option<Arc<CompiledModule>> {
+        let in_memory = self.modules.lock().unwrap().get(&hash).cloned();
+        let found = in_memory.or_else(|| {
+            let module = Arc::new(CompiledModule::decode(&fs::read_to_string(self.path(hash)?).ok()?)?);
+            self.modules.lock().unwrap().insert(hash, module.clone());
+            Some(module)
+        });
+        let counter = if found.is_some() { &self.hits } else { &self.misses };
+        counter.fetch_add(1, Ordering::Relaxed);
+        found
+    }
+
+    /// Store a module. A failed disk write only costs a recompile next run.
+    pub fn insert(&self, hash: u64, module: CompiledModule) -> Arc<CompiledModule> {
+        if let Some(path) = self.path(hash) {
+            // Write then rename, so a reader never sees half a file
+            static TMP_ID: AtomicU64 = AtomicU64::new(0);
+            let tmp = path.with_extension(format!(
+                "{}.{}.tmp",
+                std::process::id(),
+                TMP_ID.fetch_add(1, Ordering::Relaxed)
+            ));
+            if fs::write(&tmp, module.encode()).and_then(|_| fs::rename(&tmp, &path)).is_err() {
+                let _ = fs::remove_file(&tmp);
+            }
+        }
+        let module = Arc::new(module);
+        self.modules.lock().unwrap().insert(hash, module.clone());
+        module
+    }
+
+    pub fn hits(&self) -> usize {
+        self.hits.load(Ordering::Relaxed)
+    }
+
+    pub fn misses(&self) -> usize {
+        self.misses.load(Ordering::Relaxed)
+    }
+}
+
+impl Default for ModuleCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+// === Building ===
+
+/// One source file to compile to one C file
+#[derive(Debug, Clone)]
+pub struct BuildJob {
+    pub input: String,
+    pub output: String,
+}
+
+/// What happened to one job
+#[derive(Debug)]
+pub struct BuildResult {
+    pub input: String,
+    pub output: String,
+    pub diagnostics: Vec<Diagnostic>,
+    pub cached: bool,
+    pub written: bool,          // False if the output already held this C
+    pub error: Option<String>,  // Set when no C could be produced or written
+}
+
+/// Lex, parse, check and generate one module. Lex and parse errors stop
+/// it; type errors are kept with the module and C is still generated.
+pub fn compile_module(source: &str) -> Result<CompiledModule, Vec<Diagnostic>> {
+    let tokens = lexer::tokenize(source).map_err(|e| vec![Diagnostic::from(&e)])?;
+    let parsed = parser::parse_file(&tokens);
+    if !parsed.errors.is_empty() {
+        return Err(parsed.errors.iter().map(Diagnostic::from).collect());
+    }
+    let diagnostics = type_check(&parsed.program);
+    let c_code = CodeGen::new().generate(&parsed.program);
+    Ok(CompiledModule { c_code, diagnostics })
+}
+
+/// Write `content` to `path` unless it already holds exactly that, so
+/// build tools see an unchanged timestamp. True if written.
+pub fn write_if_changed(path: &str, content: &str) -> io::Result<bool> {
+    if fs::read(path).map_or(false, |old| old == content.as_bytes()) {
+        return Ok(false);
+    }
+    fs::write(path, content)?;
+    Ok(true)
+}
+
+fn build_one(job: &BuildJob, cache: &ModuleCache, emit: bool) -> BuildResult {
+    let mut result = BuildResult {
+        input: job.input.clone(),
+        output: job.output.clone(),
+        diagnostics: Vec::new(),
+        cached: false,
+        written: false,
+        error: None,
+    };
+
+    let source = match fs::read_to_string(&job.input) {
+        Ok(source) => source,
+        Err(e) => {
+            result.error = Some(format!("failed to read '{}': {}", job.input, e));
+            return result;
+        }
+    };
+
+    let hash = module_hash(&source);
+    let module = match cache.get(hash) {
+        Some(module) => {
+            result.cached = true;
+            module
+        }
+        None => match compile_module(&source) {
+            Ok(module) => cache.insert(hash, module),
+            Err(diagnostics) => {
+                result.diagnostics = diagnostics;
+                result.error = Some(format!("could not compile '{}'", job.input));
+                return result;
+            }
+        },
+    };
+    result.diagnostics = module.diagnostics.clone();
+
+    if emit {
+        match write_if_changed(&job.output, &module.c_code) {
+            Ok(written) => result.written = written,
+            Err(e) => result.error = Some(format!("code generation failed: {}", e)),
+        }
+    }
+    result
+}
+
+/// Threads to use when none are asked for
+pub fn default_jobs() -> usize {
+    thread::available_parallelism().map_or(1, |n| n.get())
+}
+
+/// Compile every job on up to `threads` threads, results in job order.
+/// With `emit` false only diagnostics are produced (nothing is written).
+pub fn build(jobs: &[BuildJob], cache: &ModuleCache, threads: usize, emit: bool) -> Vec<BuildResult> {
+    let threads = threads.clamp(1, jobs.len().max(1));
+    if threads == 1 {
+        return jobs.iter().map(|job| build_one(job, cache, emit)).collect();
+    }
+
+    // Threads take the next job as they finish, so one large module does
+    // not hold up a queue of small ones
+    let next = AtomicUsize::new(0);
+    let results: Vec<Mutex<Option<BuildResult>>> = jobs.iter().map(|_| Mutex::new(None)).collect();
+    thread::scope(|scope| {
+        for _ in 0..threads {
+            scope.spawn(|| loop {
+                let i = next.fetch_add(1, Ordering::Relaxed);
+                let Some(job) = jobs.get(i) else { break };
+                *results[i].lock().unwrap() = Some(build_one(job, cache, emit));
+            });
+        }
+    });
+    results.into_iter().map(|r| r.into_inner().unwrap().expect("every job runs")).collect()
+}
+
+// === Editor Documents ===
+
+/// An open file in an editor. Tokens and declarations are kept between
+/// edits, so each change re-lexes and re-parses only around itself; type
+/// checking still runs over the whole (single-module) program.
+pub struct Document {
+    source: String,
+    syntax: Result<(Vec<Token>, ParsedFile), LexError>,
+}
+
+impl Document {
+    pub fn new(source: impl Into<String>) -> Self {
+        let source = source.into();
+        let syntax = Self::parse(&source);
+        Self { source, syntax }
+    }
+
+    fn parse(source: &str) -> Result<(Vec<Token>, ParsedFile), LexError> {
+        let tokens = lexer::tokenize(source)?;
+        let parsed = parser::parse_file(&tokens);
+        Ok((tokens, parsed))
+    }
+
+    pub fn source(&self) -> &str {
+        &self.source
+    }
+
+    /// Parsed declarations, or None while the source does not lex
+    pub fn parsed(&self) -> Option<&ParsedFile> {
+        self.syntax.as_ref().ok().map(|(_, parsed)| parsed)
+    }
+
+    /// Apply an edit (byte offsets into the current source)
+    pub fn edit(&mut self, edit: &TextEdit) {
+        let syntax = std::mem::replace(&mut self.syntax, Err(LexError::new("", 0, 0)));
+        match syntax {
+            Ok((tokens, parsed)) => match lexer::relex(&self.source, &tokens, edit) {
+                Ok(relexed) => {
+                    let parsed = parsed.reparse(&relexed.tokens, &relexed.edit);
+                    self.source = relexed.source;
+                    self.syntax = Ok((relexed.tokens, parsed));
+                }
+                Err(e) => {
+                    self.source = edit.apply(&self.source);
+                    self.syntax = Err(e);
+                }
+            },
+            // Nothing to reuse from a source that did not lex
+            Err(_) => {
+                self.source = edit.apply(&self.source);
+                self.syntax = Self::parse(&self.source);
+            }
+        }
+    }
+
+    /// Lex, parse and type errors for the current source
+    pub fn diagnostics(&self) -> Vec<Diagnostic> {
+        match &self.syntax {
+            Err(e) => vec![Diagnostic::from(e)],
+            Ok((_, parsed)) => {
+                let mut diagnostics: Vec<Diagnostic> = parsed.errors.iter().map(Diagnostic::from).collect();
+                if diagnostics.is_empty() {
+                    diagnostics = type_check(&parsed.program);
+                }
+                diagnostics
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const SOURCE: &str = "fn add(a: int, b: int) -> int {\n    return a + b;\n}\n\nfn main() {\n    let x: int = add(1, 2);\n}\n";
+
+    fn scratch_dir(name: &str) -> PathBuf {
+        let dir = std::env::temp_dir().join(format!("reoxc-build-{}-{}", name, std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        fs::create_dir_all(&dir).unwrap();
+        dir
+    }
+
+    #[test]
+    fn test_module_hash_changes_with_source() {
+        assert_eq!(module_hash(SOURCE), module_hash(SOURCE));
+        assert_ne!(module_hash(SOURCE), module_hash("fn main() { }"));
+    }
+
+    #[test]
+    fn test_build_uses_cache() {
+        let dir = scratch_dir("cache");
+        let jobs: Vec<BuildJob> = (0..4).map(|i| {
+            let input = dir.join(format!("m{}.rx", i));
+            fs::write(&input, format!("{}\nfn f{}() {{ }}\n", SOURCE, i)).unwrap();
+            BuildJob {
+                input: input.to_string_lossy().into_owned(),
+                output: dir.join(format!("m{}.c", i)).to_string_lossy().into_owned(),
+            }
+        }).collect();
+
+        let cache = ModuleCache::on_disk(dir.join("cache")).unwrap();
+        let first = build(&jobs, &cache, 4, true);
+        assert!(first.iter().all(|r| r.error.is_none() && !r.cached && r.written));
+        assert_eq!(cache.misses(), 4);
+
+        // A fresh cache on the same directory finds every module on disk,
+        // and outputs that already match are left alone
+        let cache = ModuleCache::on_disk(dir.join("cache")).unwrap();
+        let second = build(&jobs, &cache, 2, true);
+        assert!(second.iter().all(|r| r.cached && !r.written));
+        for (job, r) in jobs.iter().zip(&second) {
+            assert_eq!(job.input, r.input);
+        }
+
+        let _ = fs::remove_dir_all(&dir);
+    }
+
+    #[test]
+    fn test_cached_diagnostics() {
+        let dir = scratch_dir("diagnostics");
+        let input = dir.join("warn.rx");
+        fs::write(&input, "fn main() {\n    println(\"hi\");\n}\n").unwrap();
+        let job = BuildJob {
+            input: input.to_string_lossy().into_owned(),
+            output: dir.join("warn.c").to_string_lossy().into_owned(),
+        };
+        let first = build(&[job.clone()], &ModuleCache::on_disk(dir.join("cache")).unwrap(), 1, true).remove(0);
+        let second = build(&[job], &ModuleCache::on_disk(dir.join("cache")).unwrap(), 1, true).remove(0);
+        assert_eq!(first.diagnostics.len(), 1);
+        assert!(second.cached);
+        assert_eq!(first.diagnostics, second.diagnostics);
+        let _ = fs::remove_dir_all(&dir);
+    }
+
+    #[test]
+    fn test_build_reports_errors() {
+        let dir = scratch_dir("errors");
+        let input = dir.join("bad.rx");
+        fs::write(&input, "fn main() { let = 1; }\n").unwrap();
+        let job = BuildJob {
+            input: input.to_string_lossy().into_owned(),
+            output: dir.join("bad.c").to_string_lossy().into_owned(),
+        };
+        let cache = ModuleCache::new();
+        let result = build(&[job], &cache, 1, true).remove(0);
+        assert!(result.error.is_some());
+        assert_eq!(result.diagnostics.len(), 1);
+        assert!(!dir.join("bad.c").exists());
+        let _ = fs::remove_dir_all(&dir);
+    }
+
+    #[test]
+    fn test_document_edits() {
+        let mut doc = Document::new(SOURCE);
+        assert!(doc.diagnostics().is_empty());
+
+        // Break the return statement, then fix it again
+        let at = SOURCE.find("a + b").unwrap();
+        doc.edit(&TextEdit::new(at + 2, at + 3, ""));
+        assert_eq!(doc.diagnostics().len(), 1);
+        doc.edit(&TextEdit::new(at + 2, at + 2, "*"));
+        assert!(doc.diagnostics().is_empty());
+        assert_eq!(doc.parsed().unwrap().reparsed, 1);
+
+        // An unterminated string, then the closing quote
+        doc.edit(&TextEdit::new(0, 0, "\""));
+        assert_eq!(doc.diagnostics()[0].message, "unterminated string literal");
+        doc.edit(&TextEdit::new(0, 1, ""));
+        assert!(doc.diagnostics().is_empty());
+        assert_eq!(doc.source(), SOURCE.replacen("a + b", "a * b", 1));
+    }
+}
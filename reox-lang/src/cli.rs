@@ -12,6 +12,7 @@ use std::path::Path;
 #[derive(Debug, Clone)]
 pub enum CliCommand {
     Compile(Args),
+    Check(Args),
     Init { template: String, name: Option<String> },
     New { name: String, template: String },
     Help,
@@ -21,8 +22,9 @@ pub enum CliCommand {
 /// Compiler arguments
 #[derive(Debug, Clone)]
 pub struct Args {
-    pub input: String,
+    pub inputs: Vec<String>,
     pub output: Option<String>,
+    pub out_dir: Option<String>,
     pub emit: EmitType,
     pub opt_level: OptLevel,
     pub lto: bool,
@@ -30,6 +32,8 @@ pub struct Args {
     pub verbose: bool,
     pub runtime_path: Option<String>,
     pub run: bool,
+    pub jobs: usize,                    // 0 = one per CPU
+    pub cache_dir: Option<String>,      // None = no on-disk cache
 }
 
 /// Output type
@@ -86,6 +90,7 @@ pub fn parse_cli() -> Result<CliCommand, String> {
     match args[1].as_str() {
         "init" => return parse_init(&args[2..]),
         "new" => return parse_new(&args[2..]),
+        "check" => return parse_compile_args(&args[2..]).map(CliCommand::Check),
         "help" | "--help" | "-h" => return Ok(CliCommand::Help),
         "version" | "--version" | "-V" => return Ok(CliCommand::Version),
         _ => {}
@@ -161,8 +166,9 @@ fn parse_new(args: &[String]) -> Result<CliCommand, String> {
 }
 
 fn parse_compile_args(args: &[String]) -> Result<Args, String> {
-    let mut input: Option<String> = None;
+    let mut inputs: Vec<String> = Vec::new();
     let mut output: Option<String> = None;
+    let mut out_dir: Option<String> = None;
     let mut emit = EmitType::C;
     let mut opt_level = OptLevel::O2;
     let mut lto = false;
@@ -170,6 +176,8 @@ fn parse_compile_args(args: &[String]) -> Result<Args, String> {
     let mut verbose = false;
     let mut runtime_path: Option<String> = None;
     let mut run = false;
+    let mut jobs = 0;
+    let mut cache_dir: Option<String> = None;
 
     let mut i = 0;
     while i < args.len() {
@@ -183,6 +191,29 @@ fn parse_compile_args(args: &[String]) -> Result<Args, String> {
                 }
                 output = Some(args[i].clone());
             }
+            "--out-dir" => {
+                i += 1;
+                if i >= args.len() {
+                    return Err("expected directory after --out-dir".to_string());
+                }
+                out_dir = Some(args[i].clone());
+            }
+            "-j" | "--jobs" => {
+                i += 1;
+                if i >= args.len() {
+                    return Err("expected thread count after --jobs".to_string());
+                }
+                jobs = args[i].parse()
+                    .map_err(|_| format!("invalid thread count: {}", args[i]))?;
+            }
+            "--cache-dir" => {
+                i += 1;
+                if i >= args.len() {
+                    return Err("expected directory after --cache-dir".to_string());
+                }
+                cache_dir = Some(args[i].clone());
+            }
+            "--no-cache" => cache_dir = None,
             "--emit" => {
                 i += 1;
                 if i >= args.len() {
@@ -227,29 +258,38 @@ fn parse_compile_args(args: &[String]) -> Result<Args, String> {
                 if arg.starts_with('-') {
                     return Err(format!("unknown option: {}", arg));
                 }
-                if input.is_some() {
-                    return Err("multiple input files not supported".to_string());
-                }
-                input = Some(arg.clone());
+                inputs.push(arg.clone());
             }
         }
 
         i += 1;
     }
 
-    let input = input.ok_or("no input file specified")?;
+    if inputs.is_empty() {
+        return Err("no input file specified".to_string());
+    }
     
     // Validate file extension (.rx or .reox)
-    if !input.ends_with(".rx") && !input.ends_with(".reox") {
-        return Err(format!(
-            "invalid file extension: '{}'. Expected .rx or .reox",
-            input
-        ));
+    for input in &inputs {
+        if !input.ends_with(".rx") && !input.ends_with(".reox") {
+            return Err(format!(
+                "invalid file extension: '{}'. Expected .rx or .reox",
+                input
+            ));
+        }
+    }
+
+    if inputs.len() > 1 && output.is_some() {
+        return Err("-o needs a single input; use --out-dir for several".to_string());
+    }
+    if inputs.len() > 1 && run {
+        return Err("--run needs a single input".to_string());
     }
 
     Ok(Args {
-        input,
+        inputs,
         output,
+        out_dir,
         emit,
         opt_level,
         lto,
@@ -257,6 +297,8 @@ fn parse_compile_args(args: &[String]) -> Result<Args, String> {
         verbose,
         runtime_path,
         run,
+        jobs,
+        cache_dir,
     })
 }
 
@@ -328,16 +370,18 @@ pub fn print_usage() {
     println!();
     println!("USAGE:");
     println!("    reoxc <COMMAND>");
-    println!("    reoxc [OPTIONS] <INPUT>");
+    println!("    reoxc [OPTIONS] <INPUT>...");
     println!();
     println!("COMMANDS:");
     println!("    init          Initialize a new project in current directory");
     println!("    new <name>    Create a new named project");
+    println!("    check         Report errors in <INPUT>... without generating code");
     println!("    help          Show this help message");
     println!("    version       Show version information");
     println!();
     println!("COMPILE OPTIONS:");
     println!("    -o, --output <FILE>    Output file path");
+    println!("    --out-dir <DIR>        Directory for outputs (default: current)");
     println!("    --emit <TYPE>          Output type: c, obj, exe (default: c)");
     println!();
     println!("  Optimization:");
@@ -349,6 +393,11 @@ pub fn print_usage() {
     println!("    --lto                  Enable Link-Time Optimization");
     println!("    --strip                Strip symbols from output");
     println!();
+    println!("  Build:");
+    println!("    -j, --jobs <N>         Modules compiled in parallel (default: one per CPU)");
+    println!("    --cache-dir <DIR>      Keep compiled modules in <DIR> between runs (default: off)");
+    println!("    --no-cache             Turn off an earlier --cache-dir");
+    println!();
     println!("  Other:");
     println!("    --runtime <PATH>       Path to runtime library");
     println!("    --run, -r              Run immediately (interpreter mode)");
@@ -362,6 +411,7 @@ pub fn print_usage() {
     println!("    reoxc main.rx -o main.c              Generate C code");
     println!("    reoxc app.reox --emit exe -o app     Compile to executable");
     println!("    reoxc main.rx --emit exe -O3 --lto   Full optimization");
+    println!("    reoxc src/*.rx --out-dir build -j 8  Compile many modules in parallel");
     println!();
     println!("FILE EXTENSIONS:");
     println!("    .rx      REOX source file (short form)");
@@ -393,11 +443,12 @@ pub fn compile_c_to_exe(
     cmd.arg("-o").arg(output);
     cmd.arg(c_file);
     
-    // Link runtime and math
+    // Link runtime, math and pthreads (compositor thread)
     if let Some(ref runtime) = args.runtime_path {
         cmd.arg(format!("{}/libreox_runtime.a", runtime));
     }
     cmd.arg("-lm");
+    cmd.arg("-pthread");
     
     // Section garbage collection
     cmd.arg("-Wl,--gc-sections");
@@ -442,4 +493,22 @@ mod tests {
         assert_eq!(OptLevel::O3.to_flag(), "-O3");
         assert_eq!(OptLevel::Os.to_flag(), "-Os");
     }
+
+    fn args(list: &[&str]) -> Vec<String> {
+        list.iter().map(|s| s.to_string()).collect()
+    }
+
+    #[test]
+    fn test_multiple_inputs() {
+        let parsed = parse_compile_args(&args(&["a.rx", "b.reox", "-j", "4", "--out-dir", "out"])).unwrap();
+        assert_eq!(parsed.inputs, ["a.rx", "b.reox"]);
+        assert_eq!(parsed.jobs, 4);
+        assert_eq!(parsed.out_dir.as_deref(), Some("out"));
+        assert!(parsed.cache_dir.is_none());
+
+        assert!(parse_compile_args(&args(&["a.rx", "b.rx", "-o", "x.c"])).is_err());
+        assert!(parse_compile_args(&args(&["a.rx", "b.rx", "--run"])).is_err());
+        assert_eq!(parse_compile_args(&args(&["a.rx", "--cache-dir", "c"])).unwrap().cache_dir.as_deref(), Some("c"));
+        assert!(parse_compile_args(&args(&["a.rx", "--cache-dir", "c", "--no-cache"])).unwrap().cache_dir.is_none());
+    }
 }
@@ -8,6 +8,7 @@ use crate::parser::{
     ReturnStmt, IfStmt, WhileStmt, ForStmt, GuardStmt, DeferStmt,
     TryCatchStmt, ThrowStmt,
 };
+use std::collections::HashMap;
 use std::io::{self, Write};
 
 /// Code generator state
@@ -15,6 +16,18 @@ pub struct CodeGen {
     output: String,
     indent: usize,
     defer_stack: Vec<Block>,  // Track deferred blocks for cleanup
+    scope_arena: bool,        // Current function uses scoped_alloc
+    ret_type: String,         // C return type of the current function
+    functions: HashMap<String, FnInfo>,
+    structs: HashMap<String, Vec<(String, Type)>>,
+    locals: Vec<HashMap<String, Local>>,  // Typed locals, innermost scope last
+}
+
+/// A local and its type, if known. Array parameters are passed by pointer.
+#[derive(Clone)]
+struct Local {
+    ty: Option<Type>,
+    by_ref: bool,
 }
 
 impl CodeGen {
@@ -23,6 +36,11 @@ impl CodeGen {
             output: String::new(),
             indent: 0,
             defer_stack: Vec::new(),
+            scope_arena: false,
+            ret_type: String::new(),
+            functions: HashMap::new(),
+            structs: HashMap::new(),
+            locals: Vec::new(),
         }
     }
 
@@ -67,6 +85,14 @@ impl CodeGen {
         self.emit_line("#include \"reox_nxrender_bridge.h\"");  // NXRender integration
         self.emit_line("");
 
+        self.functions = analyze_functions(ast);
+        for decl in &ast.declarations {
+            if let Decl::Struct(s) = decl {
+                let fields = s.fields.iter().map(|f| (f.name.clone(), f.ty.clone())).collect();
+                self.structs.insert(s.name.clone(), fields);
+            }
+        }
+
         // Forward declarations for structs
         for decl in &ast.declarations {
             if let Decl::Struct(s) = decl {
@@ -146,12 +172,38 @@ impl CodeGen {
     }
 
     fn gen_fn_prototype(&mut self, f: &FnDecl) {
+        let signature = self.fn_signature(f);
+        self.emit_line(&format!("{};", signature));
+    }
+
+    /// Linkage, effect attribute, return type and parameters, shared by the
+    /// prototype and the definition. Functions without `pub` are static
+    /// inline so the C compiler can inline or drop them without warning
+    /// about unused ones. Read-only array parameters are const, and in
+    /// functions that write no memory every pointer parameter is also
+    /// restrict.
+    fn fn_signature(&self, f: &FnDecl) -> String {
         let ret_type = f.return_type.as_ref()
             .map(|t| self.type_to_c(t))
             .unwrap_or_else(|| "void".to_string());
+        let info = &self.functions[&f.name];
 
-        let params: Vec<String> = f.params.iter()
-            .map(|p| format!("{} {}", self.type_to_c(&p.ty), p.name))
+        let linkage = if info.exported { "" } else { "static inline " };
+        let returns = !matches!(f.return_type, None | Some(Type::Void));
+        let attr = match info.effect {
+            Effect::Const if returns => "RX_CONST ",
+            Effect::Pure if returns => "RX_PURE ",
+            _ => "",
+        };
+        let restrict = if info.effect <= Effect::Pure { " restrict" } else { "" };
+
+        let params: Vec<String> = f.params.iter().enumerate()
+            .map(|(i, p)| match &p.ty {
+                Type::Array(_) if info.readonly[i] => format!("const rx_array*{} {}", restrict, p.name),
+                Type::Array(_) => format!("rx_array* {}", p.name),
+                Type::String => format!("const char*{} {}", restrict, p.name),
+                ty => format!("{} {}", self.type_to_c(ty), p.name),
+            })
             .collect();
 
         let params_str = if params.is_empty() {
@@ -160,7 +212,7 @@ impl CodeGen {
             params.join(", ")
         };
 
-        self.emit_line(&format!("{} {}({});", ret_type, f.name, params_str));
+        format!("{}{}{} {}({})", linkage, attr, ret_type, f.name, params_str)
     }
 
     fn gen_function(&mut self, f: &FnDecl) {
@@ -171,22 +223,26 @@ impl CodeGen {
             .map(|t| self.type_to_c(t))
             .unwrap_or_else(|| "void".to_string());
 
-        let params: Vec<String> = f.params.iter()
-            .map(|p| format!("{} {}", self.type_to_c(&p.ty), p.name))
-            .collect();
-
-        let params_str = if params.is_empty() {
-            "void".to_string()
-        } else {
-            params.join(", ")
-        };
-
-        self.emit_line(&format!("{} {}({}) {{", ret_type, f.name, params_str));
+        let signature = self.fn_signature(f);
+        self.emit_line(&format!("{} {{", signature));
         self.indent();
+
+        let params = f.params.iter()
+            .map(|p| (p.name.clone(), Local { ty: Some(p.ty.clone()), by_ref: matches!(p.ty, Type::Array(_)) }))
+            .collect();
+        self.locals = vec![params];
+        
+        // scoped_alloc memory lives on the thread's scope arena until return
+        self.scope_arena = block_calls(&f.body, "scoped_alloc");
+        self.ret_type = ret_type;
+        if self.scope_arena {
+            self.emit_line("rx_arena_mark _scope = rx_arena_push(rx_scope_arena());");
+        }
+        
         self.gen_block(&f.body);
         
         // Emit any remaining deferred cleanup at function end (for void functions)
-        if !self.defer_stack.is_empty() {
+        if !self.defer_stack.is_empty() || self.scope_arena {
             self.emit_deferred_cleanup();
         }
         
@@ -195,9 +251,105 @@ impl CodeGen {
     }
 
     fn gen_block(&mut self, block: &Block) {
+        self.locals.push(HashMap::new());
         for stmt in &block.statements {
             self.gen_statement(stmt);
         }
+        self.locals.pop();
+    }
+
+    fn local(&self, name: &str) -> Option<&Local> {
+        self.locals.iter().rev().find_map(|scope| scope.get(name))
+    }
+
+    fn declare_local(&mut self, name: &str, ty: Option<Type>) {
+        if let Some(scope) = self.locals.last_mut() {
+            scope.insert(name.to_string(), Local { ty, by_ref: false });
+        }
+    }
+
+    /// Element type of a local known to be an array
+    fn array_elem(&self, expr: &Expr) -> Option<Type> {
+        match expr {
+            Expr::Identifier(name, _) => match self.local(name) {
+                Some(Local { ty: Some(Type::Array(elem)), .. }) => Some((**elem).clone()),
+                _ => None,
+            },
+            _ => None,
+        }
+    }
+
+    /// C expression for a pointer to the array held in `name`
+    fn array_ref(&self, name: &str) -> String {
+        match self.local(name) {
+            Some(l) if l.by_ref => name.to_string(),
+            _ => format!("&{}", name),
+        }
+    }
+
+    /// Static type of an expression from declarations alone, for untyped lets
+    fn infer(&self, expr: &Expr) -> Option<Type> {
+        match expr {
+            Expr::Literal(Literal::Int(..)) => Some(Type::Int),
+            Expr::Literal(Literal::Float(..)) => Some(Type::Float),
+            Expr::Literal(Literal::String(..)) => Some(Type::String),
+            Expr::Literal(Literal::Bool(..)) => Some(Type::Bool),
+            Expr::Identifier(name, _) => self.local(name).and_then(|l| l.ty.clone()),
+            Expr::Binary(l, op, r, _) => match op {
+                BinOp::Eq | BinOp::Ne | BinOp::Lt | BinOp::Gt | BinOp::Le | BinOp::Ge
+                | BinOp::And | BinOp::Or => Some(Type::Bool),
+                _ => match (self.infer(l)?, self.infer(r)?) {
+                    (Type::Int, Type::Int) => Some(Type::Int),
+                    (Type::Float, Type::Float) | (Type::Int, Type::Float) | (Type::Float, Type::Int)
+                        if !matches!(op, BinOp::Mod | BinOp::BitwiseAnd | BinOp::BitwiseOr
+                            | BinOp::BitwiseXor | BinOp::ShiftLeft | BinOp::ShiftRight) => Some(Type::Float),
+                    _ => None,
+                },
+            },
+            Expr::Unary(UnaryOp::Not, _, _) => Some(Type::Bool),
+            Expr::Unary(_, operand, _) => self.infer(operand),
+            Expr::Call(callee, _, _) => match callee.as_ref() {
+                Expr::Identifier(name, _) => self.functions.get(name).and_then(|f| f.ret.clone()),
+                _ => None,
+            },
+            Expr::Index(arr, _, _) => self.array_elem(arr),
+            Expr::Member(obj, field, _) => match self.infer(obj)? {
+                Type::Named(s) => self.structs.get(&s)?.iter()
+                    .find(|(name, _)| name == field)
+                    .map(|(_, ty)| ty.clone()),
+                _ => None,
+            },
+            Expr::StructLit(name, _, _) => Some(Type::Named(name.clone())),
+            Expr::ArrayLit(items, _) => Some(Type::Array(Box::new(self.infer(items.first()?)?))),
+            Expr::Match(_, arms, _) => arms.first().and_then(|arm| self.infer(&arm.body)),
+            _ => None,
+        }
+    }
+
+    /// `[a, b, c]` as a fresh rx_array built in a statement expression. The
+    /// element type comes from the context when known, else from the first
+    /// element; an empty literal with neither holds ints.
+    fn gen_array_lit(&mut self, elements: &[Expr], elem: Option<Type>) {
+        let elem = elem
+            .or_else(|| elements.first().and_then(|e| self.infer(e)))
+            .unwrap_or(Type::Int);
+        let c_type = self.type_to_c(&elem);
+        self.emit(&format!("({{ rx_array _lit = array_new(sizeof({}), {}); ", c_type, elements.len()));
+        for e in elements {
+            match array_suffix(&elem) {
+                Some(suffix) => {
+                    self.emit(&format!("array_push_{}(&_lit, ", suffix));
+                    self.gen_expr(e);
+                    self.emit("); ");
+                }
+                None => {
+                    self.emit(&format!("array_push(&_lit, &({}){{", c_type));
+                    self.gen_expr(e);
+                    self.emit("}); ");
+                }
+            }
+        }
+        self.emit("_lit; })");
     }
 
     fn gen_statement(&mut self, stmt: &Stmt) {
@@ -258,6 +410,10 @@ impl CodeGen {
             self.dedent();
             self.emit_line("}");
         }
+        // Pushed on entry, so released after every defer ran
+        if self.scope_arena {
+            self.emit_line("rx_arena_pop(rx_scope_arena(), _scope);");
+        }
     }
     
     fn gen_try_catch(&mut self, t: &TryCatchStmt) {
@@ -288,24 +444,51 @@ impl CodeGen {
     }
 
     fn gen_let(&mut self, l: &LetStmt) {
-        let c_type = l.ty.as_ref()
+        let ty = l.ty.clone().or_else(|| l.init.as_ref().and_then(|e| self.infer(e)));
+        let c_type = ty.as_ref()
             .map(|t| self.type_to_c(t))
-            .unwrap_or_else(|| "auto".to_string()); // C23 auto or infer from init
+            .unwrap_or_else(|| "auto".to_string()); // C23 auto when the init can't be typed
 
         self.emit_indent();
         self.emit(&format!("{} {}", c_type, l.name));
 
-        if let Some(init) = &l.init {
-            self.emit(" = ");
-            self.gen_expr(init);
+        match (&l.init, &ty) {
+            (Some(Expr::ArrayLit(items, _)), Some(Type::Array(elem))) => {
+                self.emit(" = ");
+                self.gen_array_lit(items, Some((**elem).clone()));
+            }
+            (Some(init), _) => {
+                self.emit(" = ");
+                self.gen_expr(init);
+            }
+            (None, _) => {}
         }
 
         self.emit(";\n");
+        // Declared after the init, which may read a shadowed outer binding
+        self.declare_local(&l.name, ty);
     }
 
     fn gen_return(&mut self, r: &ReturnStmt) {
+        // The value may read scoped memory: compute it before releasing
+        if self.scope_arena {
+            if let Some(value) = &r.value {
+                self.emit_line("{");
+                self.indent();
+                self.emit_indent();
+                self.emit(&format!("{} _ret = ", self.ret_type));
+                self.gen_expr(value);
+                self.emit(";\n");
+                self.emit_deferred_cleanup();
+                self.emit_line("return _ret;");
+                self.dedent();
+                self.emit_line("}");
+                return;
+            }
+        }
+        
         // Emit deferred cleanup before return (in reverse order)
-        if !self.defer_stack.is_empty() {
+        if !self.defer_stack.is_empty() || self.scope_arena {
             self.emit_deferred_cleanup();
         }
         
@@ -350,9 +533,13 @@ impl CodeGen {
     }
 
     fn gen_for(&mut self, f: &ForStmt) {
+        // Scope for the loop variable
+        self.locals.push(HashMap::new());
+        let elem = self.array_elem(&f.iterable);
         match &f.iterable {
             Expr::Range(start, end, _) => {
                 // Optimized C loop: for (int64_t i = start; i <= end; ++i)
+                self.declare_local(&f.var, Some(Type::Int));
                 self.emit_indent();
                 self.emit(&format!("for (int64_t {} = ", f.var));
                 self.gen_expr(start);
@@ -364,34 +551,128 @@ impl CodeGen {
                 self.dedent();
                 self.emit_line("}");
             }
+            Expr::Call(callee, args, _)
+                if args.len() == 2
+                    && matches!(callee.as_ref(), Expr::Identifier(name, _) if name == "str_split")
+                    && !block_escapes(&f.var, &f.body) =>
+            {
+                self.declare_local(&f.var, Some(Type::String));
+                self.gen_for_split(f, &args[0], &args[1]);
+            }
+            Expr::Identifier(name, _) if elem.is_some() => {
+                // Array of known element type: index it in place through
+                // the typed accessor, no copy of the array header
+                let elem = elem.unwrap();
+                let array = self.array_ref(name);
+                let index_name = format!("_i_{}", f.var);
+                let c_type = self.type_to_c(&elem);
+                let (open, close) = self.array_access(&array, &elem);
+                self.declare_local(&f.var, Some(elem));
+                self.emit_line(&format!("for (size_t {i} = 0; {i} < ({a})->len; ++{i}) {{",
+                    i = index_name, a = array));
+                self.indent();
+                self.emit_line(&format!("{} {} = {}{}{};", c_type, f.var, open, index_name, close));
+                self.gen_block(&f.body);
+                self.dedent();
+                self.emit_line("}");
+            }
             _ => {
-                // Default array iteration (simplified for C)
-                // Assuming iterable is an array pointer or similar convention
-                // This would typically rely on a runtime iterator or Array struct in C
-                self.emit_indent();
-                // Create unique iterator name
+                self.declare_local(&f.var, Some(Type::Int));
+                // Runtime rx_array of int elements: read through the typed
+                // accessor, a plain indexed load with no bounds check
                 let iter_name = format!("_iter_{}", f.var);
-                self.emit(&format!("array_t* {} = ", iter_name));
+                let index_name = format!("_i_{}", f.var);
+                self.emit_line("{");
+                self.indent();
+                self.emit_indent();
+                self.emit(&format!("rx_array {} = ", iter_name));
                 self.gen_expr(&f.iterable);
                 self.emit(";\n");
                 
-                self.emit_indent();
-                self.emit(&format!("for (int64_t _i = 0; _i < {}->length; ++_i) {{\n", iter_name));
+                self.emit_line(&format!("for (size_t {i} = 0; {i} < {a}.len; ++{i}) {{",
+                    i = index_name, a = iter_name));
                 self.indent();
-                self.emit_indent();
-                // Extract item
-                self.emit(&format!("int64_t {} = {}->data[_i];\n", f.var, iter_name));
+                self.emit_line(&format!("int64_t {} = array_at_i64(&{}, {});",
+                    f.var, iter_name, index_name));
                 self.gen_block(&f.body);
                 self.dedent();
                 self.emit_line("}");
+                self.dedent();
+                self.emit_line("}");
             }
         }
+        self.locals.pop();
+    }
+
+    /// Text around the index of a typed read of an array element: the
+    /// runtime's inline accessor for scalars, a cast data pointer for structs
+    fn array_access(&self, array: &str, elem: &Type) -> (String, String) {
+        match array_suffix(elem) {
+            Some(suffix) => (format!("array_at_{}({}, ", suffix, array), ")".to_string()),
+            None => (format!("((const {}*)({})->data)[", self.type_to_c(elem), array), "]".to_string()),
+        }
+    }
+
+    /// `for field in str_split(s, d)` whose field never outlives an
+    /// iteration: walk the string with the runtime's split iterator instead
+    /// of building an array of copies. Each field is copied into one reused
+    /// scratch string to get a C string; fields up to RX_STR_SMALL bytes
+    /// never touch the heap.
+    fn gen_for_split(&mut self, f: &ForStmt, source: &Expr, delimiter: &Expr) {
+        let iter_name = format!("_split_{}", f.var);
+        let field_name = format!("_field_{}", f.var);
+        let scratch_name = format!("_scratch_{}", f.var);
+
+        self.emit_line("{");
+        self.indent();
+        self.emit_indent();
+        self.emit(&format!("rx_str_split_iter {} = str_split_iter(str_view_of(", iter_name));
+        self.gen_expr(source);
+        self.emit("), ");
+        self.gen_delimiter(delimiter);
+        self.emit(");\n");
+        self.emit_line(&format!("rx_str {} = {{0}};", scratch_name));
+        self.emit_line(&format!("rx_str_view {};", field_name));
+        self.emit_line(&format!("while (str_split_next(&{}, &{})) {{", iter_name, field_name));
+        self.indent();
+        self.emit_line(&format!("const char* {} = str_view_to_cstr({}, &{});",
+            f.var, field_name, scratch_name));
+        self.gen_block(&f.body);
+        self.dedent();
+        self.emit_line("}");
+        self.emit_line(&format!("str_free(&{});", scratch_name));
+        self.dedent();
+        self.emit_line("}");
+    }
+
+    /// Split delimiters are single chars in C; REOX passes a string
+    fn gen_delimiter(&mut self, delimiter: &Expr) {
+        if let Expr::Literal(Literal::String(s, _)) = delimiter {
+            let mut chars = s.chars();
+            if let (Some(ch), None) = (chars.next(), chars.next()) {
+                if ch.is_ascii() {
+                    let escaped = match ch {
+                        '\'' => "\\'".to_string(),
+                        '"' => "\"".to_string(),
+                        _ => self.escape_string(&ch.to_string()),
+                    };
+                    self.emit(&format!("'{}'", escaped));
+                    return;
+                }
+            }
+        }
+        self.emit("(");
+        self.gen_expr(delimiter);
+        self.emit(")[0]");
     }
 
     fn gen_expr(&mut self, expr: &Expr) {
         match expr {
             Expr::Literal(lit) => self.gen_literal(lit),
-            Expr::Identifier(name, _) => self.emit(name),
+            Expr::Identifier(name, _) => match self.local(name) {
+                Some(l) if l.by_ref => self.emit(&format!("(*{})", name)),
+                _ => self.emit(name),
+            },
             Expr::Binary(left, op, right, _) => {
                 self.emit("(");
                 self.gen_expr(left);
@@ -463,6 +744,16 @@ impl CodeGen {
                             self.emit(")");
                             return;
                         }
+                        "scoped_alloc" => {
+                            self.emit("rx_arena_alloc(rx_scope_arena(), ");
+                            if !args.is_empty() {
+                                self.gen_expr(&args[0]);
+                            } else {
+                                self.emit("0");
+                            }
+                            self.emit(")");
+                            return;
+                        }
                         "hstack" => {
                             self.emit("reox_hstack(");
                             if !args.is_empty() {
@@ -491,10 +782,22 @@ impl CodeGen {
                         "color_background" => { self.emit("(rx_color){28, 28, 30, 255}"); return; }
                         "color_surface" => { self.emit("(rx_color){44, 44, 46, 255}"); return; }
                         "color_text" => { self.emit("(rx_color){255, 255, 255, 255}"); return; }
+                        "len" if args.len() == 1 && !self.functions.contains_key(name)
+                            && self.array_elem(&args[0]).is_some() =>
+                        {
+                            let Expr::Identifier(array, _) = &args[0] else { unreachable!() };
+                            self.emit(&format!("(int64_t)array_len_fast({})", self.array_ref(array)));
+                            return;
+                        }
                         // Standard function - emit as-is
                         _ => {}
                     }
                 }
+                // User functions take array parameters by pointer
+                let params = match callee.as_ref() {
+                    Expr::Identifier(name, _) => self.functions.get(name).map(|f| f.params.clone()),
+                    _ => None,
+                };
                 // Default: emit as regular function call
                 self.gen_expr(callee);
                 self.emit("(");
@@ -502,7 +805,25 @@ impl CodeGen {
                     if i > 0 {
                         self.emit(", ");
                     }
-                    self.gen_expr(arg);
+                    let elem = match params.as_ref().and_then(|p| p.get(i)) {
+                        Some(Type::Array(elem)) => Some((**elem).clone()),
+                        _ => None,
+                    };
+                    let by_ref = elem.is_some();
+                    match arg {
+                        Expr::Identifier(name, _) if by_ref => self.emit(&self.array_ref(name)),
+                        Expr::ArrayLit(items, _) if by_ref => {
+                            self.emit("(rx_array[]){");
+                            self.gen_array_lit(items, elem);
+                            self.emit("}");
+                        }
+                        _ if by_ref => {
+                            self.emit("(rx_array[]){");
+                            self.gen_expr(arg);
+                            self.emit("}");
+                        }
+                        _ => self.gen_expr(arg),
+                    }
                 }
                 self.emit(")");
             }
@@ -510,12 +831,43 @@ impl CodeGen {
                 self.gen_expr(obj);
                 self.emit(&format!(".{}", field));
             }
+            Expr::Index(arr, idx, _) if self.array_elem(arr).is_some() => {
+                let Expr::Identifier(name, _) = arr.as_ref() else { unreachable!() };
+                let elem = self.array_elem(arr).unwrap();
+                let (open, close) = self.array_access(&self.array_ref(name), &elem);
+                self.emit(&open);
+                self.gen_expr(idx);
+                self.emit(&close);
+            }
             Expr::Index(arr, idx, _) => {
                 self.gen_expr(arr);
                 self.emit("[");
                 self.gen_expr(idx);
                 self.emit("]");
             }
+            Expr::Assign(target, value, _) if matches!(target.as_ref(),
+                Expr::Index(arr, _, _) if self.array_elem(arr).is_some()) =>
+            {
+                let Expr::Index(arr, idx, _) = target.as_ref() else { unreachable!() };
+                let Expr::Identifier(name, _) = arr.as_ref() else { unreachable!() };
+                let elem = self.array_elem(arr).unwrap();
+                let array = self.array_ref(name);
+                match array_suffix(&elem) {
+                    Some(suffix) => {
+                        self.emit(&format!("array_put_{}({}, ", suffix, array));
+                        self.gen_expr(idx);
+                        self.emit(", ");
+                        self.gen_expr(value);
+                        self.emit(")");
+                    }
+                    None => {
+                        self.emit(&format!("(({}*)({})->data)[", self.type_to_c(&elem), array));
+                        self.gen_expr(idx);
+                        self.emit("] = ");
+                        self.gen_expr(value);
+                    }
+                }
+            }
             Expr::Assign(target, value, _) => {
                 self.gen_expr(target);
                 self.emit(" = ");
@@ -532,16 +884,7 @@ impl CodeGen {
                 }
                 self.emit("}");
             }
-            Expr::ArrayLit(elements, _) => {
-                self.emit("{");
-                for (i, elem) in elements.iter().enumerate() {
-                    if i > 0 {
-                        self.emit(", ");
-                    }
-                    self.gen_expr(elem);
-                }
-                self.emit("}");
-            }
+            Expr::ArrayLit(elements, _) => self.gen_array_lit(elements, None),
             Expr::Match(scrutinee, arms, _) => {
                 // Generate match as a series of if-else chains
                 // For simple integer patterns, could use switch but if-else is more general
@@ -710,7 +1053,7 @@ impl CodeGen {
             Type::Bool => "bool".to_string(),
             Type::Void => "void".to_string(),
             Type::Named(name) => name.clone(),
-            Type::Array(inner) => format!("{}*", self.type_to_c(inner)),
+            Type::Array(_) => "rx_array".to_string(),
         }
     }
 
@@ -746,6 +1089,373 @@ impl CodeGen {
     }
 }
 
+/// Runtime accessor suffix for arrays of `elem` (array_at_i64 etc.)
+fn array_suffix(elem: &Type) -> Option<&'static str> {
+    match elem {
+        Type::Int => Some("i64"),
+        Type::Float => Some("f64"),
+        Type::Bool => Some("bool"),
+        Type::String => Some("cstr"),
+        _ => None,
+    }
+}
+
+// ============================================================================
+// Effect Analysis
+// ============================================================================
+
+/// What a function may touch besides its locals, weakest first. Const reads
+/// only its arguments, Pure may also read memory but writes none.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+enum Effect {
+    Const,
+    Pure,
+    Impure,
+}
+
+/// What codegen knows about a user function
+#[derive(Debug, Clone)]
+struct FnInfo {
+    params: Vec<Type>,
+    ret: Option<Type>,
+    effect: Effect,
+    readonly: Vec<bool>,  // Per parameter: an array never written through
+    exported: bool,       // `pub` or main: keeps external linkage
+}
+
+/// Runtime functions that only compute from their arguments
+const CONST_CALLS: &[&str] = &[
+    "abs_int", "min_int", "max_int", "min_float", "max_float", "clamp_int", "clamp_float",
+];
+
+/// Runtime functions that read memory but never write it
+const PURE_CALLS: &[&str] = &["strlen", "strcmp", "strncmp", "len"];
+
+/// Effects and read-only array parameters of every user function. Starts
+/// from the most optimistic answer and weakens it until nothing changes,
+/// so recursive functions like fib still come out Const.
+fn analyze_functions(ast: &Ast) -> HashMap<String, FnInfo> {
+    let fns: Vec<&FnDecl> = ast.declarations.iter()
+        .filter_map(|d| if let Decl::Function(f) = d { Some(f) } else { None })
+        .collect();
+
+    let mut table: HashMap<String, FnInfo> = fns.iter()
+        .map(|f| (f.name.clone(), FnInfo {
+            params: f.params.iter().map(|p| p.ty.clone()).collect(),
+            ret: f.return_type.clone(),
+            effect: Effect::Const,
+            readonly: f.params.iter().map(|p| matches!(p.ty, Type::Array(_))).collect(),
+            exported: f.is_pub || f.name == "main",
+        }))
+        .collect();
+
+    loop {
+        let mut changed = false;
+        for f in &fns {
+            let mut scan = EffectScan {
+                table: &table,
+                arrays: f.params.iter()
+                    .filter(|p| matches!(p.ty, Type::Array(_)))
+                    .map(|p| p.name.clone())
+                    .collect(),
+                written: Vec::new(),
+            };
+            let mut effect = scan.block(&f.body);
+            // Anything but scalars is, or may hide, a pointer
+            if f.params.iter().any(|p| !matches!(p.ty, Type::Int | Type::Float | Type::Bool)) {
+                effect = effect.max(Effect::Pure);
+            }
+            if f.is_async || f.name == "main" {
+                effect = Effect::Impure;
+            }
+            let written = scan.written;
+
+            let info = table.get_mut(&f.name).unwrap();
+            let readonly: Vec<bool> = f.params.iter().zip(&info.readonly)
+                .map(|(p, &ro)| ro && !written.contains(&p.name))
+                .collect();
+            let effect = info.effect.max(effect);
+            if effect != info.effect || readonly != info.readonly {
+                info.effect = effect;
+                info.readonly = readonly;
+                changed = true;
+            }
+        }
+        if !changed {
+            return table;
+        }
+    }
+}
+
+/// One pass over a function body. Conservative: loops that may not end,
+/// writes other than to locals and calls to unknown functions are Impure,
+/// and an array parameter used any way but read is counted as written.
+struct EffectScan<'a> {
+    table: &'a HashMap<String, FnInfo>,
+    arrays: Vec<String>,   // Array parameter names
+    written: Vec<String>,  // Array parameters that may be written through
+}
+
+impl<'a> EffectScan<'a> {
+    fn block(&mut self, block: &Block) -> Effect {
+        block.statements.iter().fold(Effect::Const, |e, stmt| e.max(self.stmt(stmt)))
+    }
+
+    fn stmt(&mut self, stmt: &Stmt) -> Effect {
+        match stmt {
+            Stmt::Let(l) => l.init.as_ref().map_or(Effect::Const, |e| self.expr(e)),
+            Stmt::Expr(e) => self.expr(e),
+            Stmt::Return(r) => r.value.as_ref().map_or(Effect::Const, |e| self.expr(e)),
+            Stmt::If(i) => {
+                let e = self.expr(&i.condition).max(self.block(&i.then_block));
+                e.max(i.else_block.as_ref().map_or(Effect::Const, |b| self.block(b)))
+            }
+            // The attributes promise the function returns
+            Stmt::While(w) => {
+                self.expr(&w.condition);
+                self.block(&w.body);
+                Effect::Impure
+            }
+            Stmt::For(f) => {
+                let iterable = match &f.iterable {
+                    Expr::Range(start, end, _) => self.expr(start).max(self.expr(end)),
+                    Expr::Identifier(name, _) if self.arrays.contains(name) => Effect::Pure,
+                    e => self.expr(e).max(Effect::Pure),
+                };
+                iterable.max(self.block(&f.body))
+            }
+            Stmt::Block(b) => self.block(b),
+            Stmt::Break(_) | Stmt::Continue(_) => Effect::Const,
+            Stmt::Guard(g) => self.expr(&g.condition).max(self.block(&g.else_block)),
+            Stmt::Defer(d) => self.block(&d.body),
+            Stmt::TryCatch(t) => self.block(&t.try_block).max(self.block(&t.catch_block)),
+            Stmt::Throw(t) => {
+                self.expr(&t.value);
+                Effect::Impure
+            }
+        }
+    }
+
+    fn array_param(&self, expr: &Expr) -> Option<String> {
+        match expr {
+            Expr::Identifier(name, _) if self.arrays.contains(name) => Some(name.clone()),
+            _ => None,
+        }
+    }
+
+    /// A write to `target`: free for a local, a memory write otherwise
+    fn store(&mut self, target: &Expr) -> Effect {
+        match target {
+            Expr::Identifier(name, _) => {
+                if self.arrays.contains(name) {
+                    self.written.push(name.clone());
+                }
+                Effect::Const
+            }
+            Expr::Index(arr, idx, _) => {
+                if let Some(name) = self.array_param(arr) {
+                    self.written.push(name);
+                } else {
+                    self.expr(arr);
+                }
+                self.expr(idx);
+                Effect::Impure
+            }
+            e => {
+                self.expr(e);
+                Effect::Impure
+            }
+        }
+    }
+
+    fn expr(&mut self, expr: &Expr) -> Effect {
+        match expr {
+            Expr::Literal(_) | Expr::Nil(_) => Effect::Const,
+            Expr::Identifier(name, _) => {
+                // Copied or passed on somewhere unknown
+                if self.arrays.contains(name) {
+                    self.written.push(name.clone());
+                }
+                Effect::Const
+            }
+            Expr::Index(arr, idx, _) => {
+                let base = if self.array_param(arr).is_some() { Effect::Const } else { self.expr(arr) };
+                base.max(self.expr(idx)).max(Effect::Pure)
+            }
+            Expr::Call(callee, args, _) => {
+                let Expr::Identifier(name, _) = callee.as_ref() else {
+                    self.expr(callee);
+                    for a in args { self.expr(a); }
+                    return Effect::Impure;
+                };
+                let info = self.table.get(name);
+                let mut effect = match info {
+                    Some(f) => f.effect,
+                    None if CONST_CALLS.contains(&name.as_str()) => Effect::Const,
+                    None if PURE_CALLS.contains(&name.as_str()) => Effect::Pure,
+                    None => Effect::Impure,
+                };
+                for (i, a) in args.iter().enumerate() {
+                    // Handing an array parameter to a read-only parameter reads it
+                    let reads = match (self.array_param(a), info) {
+                        (Some(_), Some(f)) => f.readonly.get(i).copied().unwrap_or(false),
+                        (Some(_), None) => PURE_CALLS.contains(&name.as_str()),
+                        (None, _) => false,
+                    };
+                    effect = effect.max(if reads { Effect::Pure } else { self.expr(a) });
+                }
+                effect
+            }
+            Expr::Assign(target, value, _) | Expr::CompoundAssign(target, _, value, _) => {
+                self.expr(value).max(self.store(target))
+            }
+            Expr::PreIncrement(e, _) | Expr::PreDecrement(e, _)
+            | Expr::PostIncrement(e, _) | Expr::PostDecrement(e, _) => self.store(e),
+            Expr::Unary(_, e, _) | Expr::Member(e, _, _) | Expr::OptionalChain(e, _, _) => self.expr(e),
+            Expr::Binary(a, _, b, _) | Expr::NullCoalesce(a, b, _) => self.expr(a).max(self.expr(b)),
+            Expr::StructLit(_, fields, _) => {
+                fields.iter().fold(Effect::Const, |e, (_, v)| e.max(self.expr(v)))
+            }
+            Expr::ArrayLit(items, _) => items.iter().fold(Effect::Const, |e, v| e.max(self.expr(v))),
+            Expr::Match(e, arms, _) => {
+                arms.iter().fold(self.expr(e), |acc, arm| acc.max(self.expr(&arm.body)))
+            }
+            // rx_range allocates; closures and awaits run arbitrary code
+            Expr::Range(a, b, _) => {
+                self.expr(a);
+                self.expr(b);
+                Effect::Impure
+            }
+            Expr::Await(e, _) => {
+                self.expr(e);
+                Effect::Impure
+            }
+            Expr::TrailingClosure(..) => Effect::Impure,
+        }
+    }
+}
+
+// ============================================================================
+// Escape Analysis
+// ============================================================================
+
+/// C functions known not to keep a pointer to their string arguments
+const NON_RETAINING_CALLS: &[&str] = &[
+    "print", "println", "printf_rx", "strlen", "strcmp", "strncmp",
+    "atoi", "atol", "atoll", "atof",
+];
+
+/// Whether `var` may outlive the current iteration of `block`. Conservative:
+/// any use other than an argument to a non-retaining call or an operand of
+/// a comparison counts, and so does anything that leaves the function.
+fn block_escapes(var: &str, block: &Block) -> bool {
+    block.statements.iter().any(|stmt| stmt_escapes(var, stmt))
+}
+
+fn stmt_escapes(var: &str, stmt: &Stmt) -> bool {
+    match stmt {
+        Stmt::Let(l) => l.name == var || l.init.as_ref().map_or(false, |e| expr_escapes(var, e)),
+        Stmt::Expr(e) => expr_escapes(var, e),
+        // Leaving early would skip the scratch cleanup
+        Stmt::Return(_) | Stmt::Throw(_) | Stmt::Defer(_) | Stmt::TryCatch(_) => true,
+        Stmt::If(i) => {
+            expr_escapes(var, &i.condition)
+                || block_escapes(var, &i.then_block)
+                || i.else_block.as_ref().map_or(false, |b| block_escapes(var, b))
+        }
+        Stmt::While(w) => expr_escapes(var, &w.condition) || block_escapes(var, &w.body),
+        Stmt::For(f) => f.var == var || expr_escapes(var, &f.iterable) || block_escapes(var, &f.body),
+        Stmt::Block(b) => block_escapes(var, b),
+        Stmt::Guard(g) => expr_escapes(var, &g.condition) || block_escapes(var, &g.else_block),
+        Stmt::Break(_) | Stmt::Continue(_) => false,
+    }
+}
+
+/// Whether `block` calls `name` anywhere, nested blocks included
+fn block_calls(block: &Block, name: &str) -> bool {
+    block.statements.iter().any(|stmt| stmt_calls(stmt, name))
+}
+
+fn stmt_calls(stmt: &Stmt, name: &str) -> bool {
+    match stmt {
+        Stmt::Let(l) => l.init.as_ref().map_or(false, |e| expr_calls(e, name)),
+        Stmt::Expr(e) => expr_calls(e, name),
+        Stmt::Return(r) => r.value.as_ref().map_or(false, |e| expr_calls(e, name)),
+        Stmt::Throw(t) => expr_calls(&t.value, name),
+        Stmt::If(i) => {
+            expr_calls(&i.condition, name)
+                || block_calls(&i.then_block, name)
+                || i.else_block.as_ref().map_or(false, |b| block_calls(b, name))
+        }
+        Stmt::While(w) => expr_calls(&w.condition, name) || block_calls(&w.body, name),
+        Stmt::For(f) => expr_calls(&f.iterable, name) || block_calls(&f.body, name),
+        Stmt::Block(b) | Stmt::Defer(DeferStmt { body: b, .. }) => block_calls(b, name),
+        Stmt::Guard(g) => expr_calls(&g.condition, name) || block_calls(&g.else_block, name),
+        Stmt::TryCatch(t) => block_calls(&t.try_block, name) || block_calls(&t.catch_block, name),
+        Stmt::Break(_) | Stmt::Continue(_) => false,
+    }
+}
+
+fn expr_calls(expr: &Expr, name: &str) -> bool {
+    match expr {
+        Expr::Call(callee, args, _) => {
+            matches!(callee.as_ref(), Expr::Identifier(n, _) if n == name)
+                || expr_calls(callee, name)
+                || args.iter().any(|a| expr_calls(a, name))
+        }
+        Expr::Identifier(..) | Expr::Literal(_) | Expr::Nil(_) => false,
+        Expr::Unary(_, e, _) | Expr::Member(e, _, _) | Expr::OptionalChain(e, _, _)
+        | Expr::Await(e, _) | Expr::PreIncrement(e, _) | Expr::PreDecrement(e, _)
+        | Expr::PostIncrement(e, _) | Expr::PostDecrement(e, _) => expr_calls(e, name),
+        Expr::Binary(a, _, b, _) | Expr::Index(a, b, _) | Expr::Assign(a, b, _)
+        | Expr::CompoundAssign(a, _, b, _) | Expr::NullCoalesce(a, b, _) | Expr::Range(a, b, _) => {
+            expr_calls(a, name) || expr_calls(b, name)
+        }
+        Expr::StructLit(_, fields, _) => fields.iter().any(|(_, e)| expr_calls(e, name)),
+        Expr::ArrayLit(items, _) => items.iter().any(|e| expr_calls(e, name)),
+        Expr::Match(e, arms, _) => expr_calls(e, name) || arms.iter().any(|arm| expr_calls(&arm.body, name)),
+        // Runs in its own scope
+        Expr::TrailingClosure(..) => false,
+    }
+}
+
+fn is_var(var: &str, expr: &Expr) -> bool {
+    matches!(expr, Expr::Identifier(name, _) if name == var)
+}
+
+fn expr_escapes(var: &str, expr: &Expr) -> bool {
+    match expr {
+        Expr::Identifier(name, _) => name == var,
+        Expr::Literal(_) | Expr::Nil(_) => false,
+        Expr::Call(callee, args, _) => {
+            let non_retaining = matches!(callee.as_ref(),
+                Expr::Identifier(name, _) if NON_RETAINING_CALLS.contains(&name.as_str()));
+            expr_escapes(var, callee)
+                || args.iter().any(|a| !(non_retaining && is_var(var, a)) && expr_escapes(var, a))
+        }
+        Expr::Binary(l, op, r, _) => {
+            let compare = matches!(op,
+                BinOp::Eq | BinOp::Ne | BinOp::Lt | BinOp::Gt | BinOp::Le | BinOp::Ge);
+            (!(compare && is_var(var, l)) && expr_escapes(var, l))
+                || (!(compare && is_var(var, r)) && expr_escapes(var, r))
+        }
+        Expr::Unary(_, e, _) | Expr::Member(e, _, _) | Expr::OptionalChain(e, _, _)
+        | Expr::Await(e, _) | Expr::PreIncrement(e, _) | Expr::PreDecrement(e, _)
+        | Expr::PostIncrement(e, _) | Expr::PostDecrement(e, _) => expr_escapes(var, e),
+        Expr::Index(a, b, _) | Expr::Assign(a, b, _) | Expr::CompoundAssign(a, _, b, _)
+        | Expr::NullCoalesce(a, b, _) | Expr::Range(a, b, _) => {
+            expr_escapes(var, a) || expr_escapes(var, b)
+        }
+        Expr::StructLit(_, fields, _) => fields.iter().any(|(_, e)| expr_escapes(var, e)),
+        Expr::ArrayLit(items, _) => items.iter().any(|e| expr_escapes(var, e)),
+        Expr::Match(e, arms, _) => {
+            expr_escapes(var, e) || arms.iter().any(|arm| expr_escapes(var, &arm.body))
+        }
+        // Closures may run after the loop
+        Expr::TrailingClosure(..) => true,
+    }
+}
+
 impl Default for CodeGen {
     fn default() -> Self {
         Self::new()
@@ -858,4 +1568,196 @@ mod tests {
 
         assert!(output.contains("while ((i < 10))"));
     }
+
+    #[test]
+    fn test_split_loop_uses_views() {
+        let source = r#"
+            fn fields(line: string) {
+                for field in str_split(line, ",") {
+                    println(field);
+                }
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(output.contains("str_split_iter(str_view_of(line), ',')"));
+        assert!(output.contains("const char* field = str_view_to_cstr(_field_field, &_scratch_field);"));
+        assert!(output.contains("str_free(&_scratch_field);"));
+    }
+
+    #[test]
+    fn test_split_loop_escaping_field_keeps_copies() {
+        let source = r#"
+            fn first(line: string) -> string {
+                for field in str_split(line, ",") {
+                    return field;
+                }
+                return "";
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(!output.contains("str_split_iter"));
+    }
+
+    #[test]
+    fn test_array_loop_uses_typed_access() {
+        let source = r#"
+            fn total(items: int) -> int {
+                let mut sum: int = 0;
+                for x in (items) {
+                    sum = sum + x;
+                }
+                return sum;
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(output.contains("rx_array _iter_x = items;"));
+        assert!(output.contains("for (size_t _i_x = 0; _i_x < _iter_x.len; ++_i_x) {"));
+        assert!(output.contains("int64_t x = array_at_i64(&_iter_x, _i_x);"));
+    }
+
+    #[test]
+    fn test_scoped_alloc_uses_scope_arena() {
+        let source = r#"
+            fn checksum(n: int) -> int {
+                let buf = scoped_alloc(n);
+                return fill(buf, n);
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(output.contains("rx_arena_mark _scope = rx_arena_push(rx_scope_arena());"));
+        assert!(output.contains("rx_arena_alloc(rx_scope_arena(), n)"));
+        let ret = output.find("int64_t _ret = fill(buf, n);").unwrap();
+        let pop = output.find("rx_arena_pop(rx_scope_arena(), _scope);").unwrap();
+        assert!(ret < pop);
+    }
+
+    #[test]
+    fn test_effects_and_linkage() {
+        let source = r#"
+            fn fib(n: int) -> int {
+                if n < 2 {
+                    return n;
+                }
+                return fib(n - 1) + fib(n - 2);
+            }
+            fn greet(name: string) -> int {
+                println(name);
+                return 0;
+            }
+            pub fn answer() -> int {
+                return fib(9) + 8;
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(output.contains("static inline RX_CONST int64_t fib(int64_t n);"));
+        assert!(output.contains("static inline int64_t greet(const char* name) {"));
+        assert!(output.contains("\nRX_CONST int64_t answer(void) {"));
+    }
+
+    #[test]
+    fn test_array_params_use_typed_access() {
+        let source = r#"
+            fn sum(items: [float]) -> float {
+                let mut total: float = 0.0;
+                for x in (items) {
+                    total = total + x;
+                }
+                return total;
+            }
+            fn scale(items: [float], k: float) {
+                let mut i = 0;
+                while i < len(items) {
+                    items[i] = items[i] * k;
+                    i += 1;
+                }
+            }
+            fn run(items: [float]) -> float {
+                scale(items, 2.0);
+                return sum(items);
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let mut codegen = CodeGen::new();
+        let output = codegen.generate(&ast);
+
+        assert!(output.contains("static inline RX_PURE double sum(const rx_array* restrict items)"));
+        assert!(output.contains("double x = array_at_f64(items, _i_x);"));
+        assert!(output.contains("static inline void scale(rx_array* items, double k)"));
+        assert!(output.contains("int64_t i = 0;"));
+        assert!(output.contains("(i < (int64_t)array_len_fast(items))"));
+        assert!(output.contains("array_put_f64(items, i, (array_at_f64(items, i) * k));"));
+        assert!(output.contains("static inline double run(rx_array* items)"));
+    }
+
+    #[test]
+    fn test_array_literal_compiles_and_runs() {
+        let source = r#"
+            fn sum(items: [int]) -> int {
+                let mut total: int = 0;
+                for x in (items) {
+                    total = total + x;
+                }
+                return total;
+            }
+
+            pub fn main() -> int {
+                let xs: [int] = [1, 2, 3];
+                let ys: [float] = [1, 2.5];
+                let zs = [10, 20];
+                print_int(sum(xs) + sum([4, 5]) + zs[1]);
+                print(" ");
+                print_float(ys[0] + ys[1]);
+                println("");
+                return 0;
+            }
+        "#;
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        let output = CodeGen::new().generate(&ast);
+        assert!(output.contains("rx_array xs = ({ rx_array _lit = array_new(sizeof(int64_t), 3); array_push_i64(&_lit, 1);"));
+        assert!(output.contains("array_push_f64(&_lit, 1);"));
+
+        // Needs a C compiler; the check above still runs without one
+        let runtime = concat!(env!("CARGO_MANIFEST_DIR"), "/runtime");
+        let dir = std::env::temp_dir().join(format!("reox-array-lit-{}", std::process::id()));
+        std::fs::create_dir_all(&dir).unwrap();
+        let c_file = dir.join("main.c");
+        let exe = dir.join("main");
+        std::fs::write(&c_file, &output).unwrap();
+        let status = std::process::Command::new("cc")
+            .args(["-std=gnu11", "-Wall", "-Wno-main", "-Werror", "-I", runtime])
+            .arg(&c_file)
+            .arg(format!("{}/reox_runtime.c", runtime))
+            .arg(format!("{}/reox_frame_stats.c", runtime))
+            .args(["-lm", "-pthread", "-o"])
+            .arg(&exe)
+            .status();
+        let Ok(status) = status else { return };
+        assert!(status.success(), "generated C failed to compile");
+        let run = std::process::Command::new(&exe).output().unwrap();
+        std::fs::remove_dir_all(&dir).ok();
+        assert!(run.status.success());
+        assert_eq!(String::from_utf8_lossy(&run.stdout), "35 3.5\n");
+    }
 }
@@ -0,0 +1,483 @@
+// REOX Bytecode - Compiles the AST to stack-machine code for the VM
+//
+// Locals are resolved to frame slots at compile time, functions and natives
+// to table indices, and literals go into a shared constant pool, so the VM
+// never looks a name up while running.
+
+use super::{Environment, Value};
+use crate::parser::*;
+use std::collections::HashMap;
+
+pub type Native = fn(Vec<Value>) -> Value;
+
+#[derive(Debug, Clone, Copy)]
+pub enum Op {
+    Const(u32),
+    Int(i64),
+    Nil,
+    Pop,
+    Dup,
+    Load(u16),
+    Store(u16),             // Pops into the slot
+    Bin(BinOp),
+    Neg,
+    Not,
+    BitNot,
+    Truthy,                 // Top becomes Bool(top.is_truthy())
+    Jump(u32),
+    JumpIfFalse(u32),       // Pops
+    JumpIfTrue(u32),        // Pops
+    And(u32),               // Falsy top: replace with false and jump, else pop
+    Or(u32),                // Truthy top: replace with true and jump, else pop
+    JumpIfNotNil(u32),      // Keeps a non-nil top, pops nil
+    Call(u32, u8),          // User function, argc
+    Native(u32, u8),
+    CallValue(u16, u8, Option<u32>), // Local holding a native; else the named function
+    Return,
+    Array(u32),             // Element count
+    Struct(u32, u32, u32),  // Name const, first key const, field count
+    Index,
+    IndexLocal(u16),        // Indexes the slot without copying it
+    Member(u32),
+    MemberLocal(u16, u32),
+    OptMember(u32),
+    Len(u16),               // len(local) without copying it
+    IncLocal(u16, i64, bool), // slot, delta, push the old value (x++)
+    Range,
+    MatchLit(u32, u32),     // Literal const; jump if the top doesn't match
+    ForNext(u16, u16, u16, u32), // iterable, index, variable slots; exit
+    TryBegin(u32),          // Catch target
+    TryEnd,
+    Throw,
+    Fail(u32),              // Runtime error with a const message
+}
+
+#[derive(Debug, Clone)]
+pub struct Function {
+    pub name: String,
+    pub arity: usize,
+    pub slots: usize,
+    pub code: Vec<Op>,
+}
+
+#[derive(Debug, Clone)]
+pub struct Program {
+    pub functions: Vec<Function>,
+    pub natives: Vec<Native>,
+    pub consts: Vec<Value>,
+    pub main: Option<u32>,
+}
+
+#[derive(Debug, Clone)]
+pub struct CompileError { pub message: String }
+
+struct Loop {
+    start: usize,
+    breaks: Vec<usize>,
+    try_depth: usize,
+}
+
+struct FnCompiler<'a> {
+    functions: &'a HashMap<String, u32>,
+    natives: &'a HashMap<String, u32>,
+    native_fns: &'a [Native],
+    consts: &'a mut Vec<Value>,
+    strings: &'a mut HashMap<String, u32>,
+    code: Vec<Op>,
+    scopes: Vec<Vec<(String, u16)>>,
+    next_slot: usize,
+    max_slots: usize,
+    loops: Vec<Loop>,
+    try_depth: usize,
+}
+
+pub fn compile(ast: &Ast) -> Result<Program, CompileError> {
+    let env = Environment::new();
+    let mut natives = Vec::new();
+    let mut native_index = HashMap::new();
+    for (name, v) in &env.scopes[0] {
+        if let Value::NativeAction(f) = v {
+            native_index.insert(name.clone(), natives.len() as u32);
+            natives.push(*f);
+        }
+    }
+
+    // Later declarations replace earlier ones, as in the tree-walker
+    let mut decls: Vec<&FnDecl> = Vec::new();
+    let mut function_index = HashMap::new();
+    for d in &ast.declarations {
+        if let Decl::Function(f) = d {
+            if let Some(&i) = function_index.get(&f.name) { decls[i as usize] = f; }
+            else { function_index.insert(f.name.clone(), decls.len() as u32); decls.push(f); }
+        }
+    }
+
+    let mut consts = Vec::new();
+    let mut strings = HashMap::new();
+    let mut functions = Vec::with_capacity(decls.len());
+    for f in &decls {
+        let mut c = FnCompiler {
+            functions: &function_index, natives: &native_index, native_fns: &natives,
+            consts: &mut consts, strings: &mut strings,
+            code: Vec::new(), scopes: vec![Vec::new()], next_slot: 0, max_slots: 0,
+            loops: Vec::new(), try_depth: 0,
+        };
+        for p in &f.params { c.declare(&p.name)?; }
+        c.block(&f.body, true)?;
+        c.emit(Op::Return);
+        functions.push(Function { name: f.name.clone(), arity: f.params.len(), slots: c.max_slots, code: c.code });
+    }
+
+    Ok(Program { main: function_index.get("main").copied(), functions, natives, consts })
+}
+
+impl<'a> FnCompiler<'a> {
+    fn emit(&mut self, op: Op) -> usize { self.code.push(op); self.code.len() - 1 }
+    fn here(&self) -> u32 { self.code.len() as u32 }
+
+    fn patch(&mut self, at: usize) {
+        let to = self.here();
+        self.code[at] = match self.code[at] {
+            Op::Jump(_) => Op::Jump(to),
+            Op::JumpIfFalse(_) => Op::JumpIfFalse(to),
+            Op::JumpIfTrue(_) => Op::JumpIfTrue(to),
+            Op::And(_) => Op::And(to),
+            Op::Or(_) => Op::Or(to),
+            Op::JumpIfNotNil(_) => Op::JumpIfNotNil(to),
+            Op::MatchLit(c, _) => Op::MatchLit(c, to),
+            Op::ForNext(i, x, v, _) => Op::ForNext(i, x, v, to),
+            Op::TryBegin(_) => Op::TryBegin(to),
+            op => op,
+        };
+    }
+
+    fn constant(&mut self, v: Value) -> u32 {
+        self.consts.push(v);
+        (self.consts.len() - 1) as u32
+    }
+
+    fn string(&mut self, s: &str) -> u32 {
+        if let Some(&i) = self.strings.get(s) { return i; }
+        let i = self.constant(Value::String(s.to_string()));
+        self.strings.insert(s.to_string(), i);
+        i
+    }
+
+    fn fail(&mut self, message: &str) { let c = self.string(message); self.emit(Op::Fail(c)); }
+
+    fn declare(&mut self, name: &str) -> Result<u16, CompileError> {
+        if self.next_slot >= u16::MAX as usize {
+            return Err(CompileError { message: "too many locals".into() });
+        }
+        let slot = self.next_slot as u16;
+        self.next_slot += 1;
+        self.max_slots = self.max_slots.max(self.next_slot);
+        self.scopes.last_mut().unwrap().push((name.to_string(), slot));
+        Ok(slot)
+    }
+
+    fn resolve(&self, name: &str) -> Option<u16> {
+        self.scopes.iter().rev().find_map(|s| s.iter().rev().find(|(n, _)| n == name).map(|(_, slot)| *slot))
+    }
+
+    fn begin_scope(&mut self) { self.scopes.push(Vec::new()); }
+    fn end_scope(&mut self) {
+        let scope = self.scopes.pop().unwrap();
+        self.next_slot -= scope.len();
+    }
+
+    // ============ Statements ============
+    // keep: leave the statement's value on the stack (a block's value is its
+    // last statement's, which makes it a function's implicit return value)
+
+    fn block(&mut self, b: &Block, keep: bool) -> Result<(), CompileError> {
+        self.begin_scope();
+        if b.statements.is_empty() && keep { self.emit(Op::Nil); }
+        let last = b.statements.len().saturating_sub(1);
+        for (i, s) in b.statements.iter().enumerate() {
+            self.stmt(s, keep && i == last)?;
+            if matches!(s, Stmt::Return(_)) { break; }
+        }
+        self.end_scope();
+        Ok(())
+    }
+
+    fn nil_if(&mut self, keep: bool) { if keep { self.emit(Op::Nil); } }
+
+    fn stmt(&mut self, s: &Stmt, keep: bool) -> Result<(), CompileError> {
+        match s {
+            Stmt::Let(l) => {
+                match &l.init { Some(e) => self.expr(e)?, None => { self.emit(Op::Nil); } }
+                let slot = self.declare(&l.name)?;
+                self.emit(Op::Store(slot));
+                self.nil_if(keep);
+            },
+            Stmt::Expr(e) => { self.expr(e)?; if !keep { self.emit(Op::Pop); } },
+            Stmt::Return(r) => {
+                match &r.value { Some(e) => self.expr(e)?, None => { self.emit(Op::Nil); } }
+                self.emit(Op::Return);
+            },
+            Stmt::If(i) => {
+                self.expr(&i.condition)?;
+                let to_else = self.emit(Op::JumpIfFalse(0));
+                self.block(&i.then_block, keep)?;
+                let to_end = self.emit(Op::Jump(0));
+                self.patch(to_else);
+                match &i.else_block { Some(b) => self.block(b, keep)?, None => self.nil_if(keep) }
+                self.patch(to_end);
+            },
+            Stmt::While(w) => {
+                let start = self.code.len();
+                self.expr(&w.condition)?;
+                let exit = self.emit(Op::JumpIfFalse(0));
+                self.loop_body(start, &w.body)?;
+                self.emit(Op::Jump(start as u32));
+                self.patch(exit);
+                self.end_loop(keep);
+            },
+            Stmt::For(f) => {
+                self.begin_scope();
+                self.expr(&f.iterable)?;
+                let iter = self.declare("")?;
+                self.emit(Op::Store(iter));
+                let index = self.declare("")?;
+                self.emit(Op::Int(0));
+                self.emit(Op::Store(index));
+                let var = self.declare(&f.var)?;
+                let start = self.code.len();
+                let exit = self.emit(Op::ForNext(iter, index, var, 0));
+                self.loop_body(start, &f.body)?;
+                self.emit(Op::Jump(start as u32));
+                self.patch(exit);
+                self.end_loop(keep);
+                self.end_scope();
+            },
+            Stmt::Block(b) => self.block(b, keep)?,
+            Stmt::Break(_) | Stmt::Continue(_) => {
+                if let Some(depth) = self.loops.last().map(|l| l.try_depth) {
+                    for _ in depth..self.try_depth { self.emit(Op::TryEnd); }
+                    if matches!(s, Stmt::Break(_)) {
+                        let at = self.emit(Op::Jump(0));
+                        self.loops.last_mut().unwrap().breaks.push(at);
+                    } else {
+                        let start = self.loops.last().unwrap().start as u32;
+                        self.emit(Op::Jump(start));
+                    }
+                }
+                self.nil_if(keep);
+            },
+            Stmt::Guard(g) => {
+                self.expr(&g.condition)?;
+                let skip = self.emit(Op::JumpIfTrue(0));
+                self.block(&g.else_block, false)?;
+                self.patch(skip);
+                self.nil_if(keep);
+            },
+            // Runs in place, as in the tree-walker
+            Stmt::Defer(d) => { self.block(&d.body, false)?; self.nil_if(keep); },
+            Stmt::TryCatch(tc) => {
+                let begin = self.emit(Op::TryBegin(0));
+                self.try_depth += 1;
+                self.block(&tc.try_block, keep)?;
+                self.try_depth -= 1;
+                self.emit(Op::TryEnd);
+                let to_end = self.emit(Op::Jump(0));
+                // The VM pushes the error message before jumping here
+                self.patch(begin);
+                self.begin_scope();
+                match &tc.catch_var {
+                    Some(var) => { let slot = self.declare(var)?; self.emit(Op::Store(slot)); },
+                    None => { self.emit(Op::Pop); }
+                }
+                self.block(&tc.catch_block, keep)?;
+                self.end_scope();
+                self.patch(to_end);
+            },
+            Stmt::Throw(t) => { self.expr(&t.value)?; self.emit(Op::Throw); },
+        }
+        Ok(())
+    }
+
+    fn loop_body(&mut self, start: usize, body: &Block) -> Result<(), CompileError> {
+        self.loops.push(Loop { start, breaks: Vec::new(), try_depth: self.try_depth });
+        self.block(body, false)
+    }
+
+    fn end_loop(&mut self, keep: bool) {
+        let lp = self.loops.pop().unwrap();
+        for at in lp.breaks { self.patch(at); }
+        self.nil_if(keep);
+    }
+
+    // ============ Expressions ============
+
+    fn expr(&mut self, e: &Expr) -> Result<(), CompileError> {
+        match e {
+            Expr::Literal(Literal::Int(i, _)) => { self.emit(Op::Int(*i)); },
+            Expr::Literal(Literal::Float(f, _)) => { let c = self.constant(Value::Float(*f)); self.emit(Op::Const(c)); },
+            Expr::Literal(Literal::String(s, _)) => { let c = self.string(s); self.emit(Op::Const(c)); },
+            Expr::Literal(Literal::Bool(b, _)) => { let c = self.constant(Value::Bool(*b)); self.emit(Op::Const(c)); },
+            Expr::Nil(_) => { self.emit(Op::Nil); },
+            Expr::Identifier(n, _) => {
+                if let Some(slot) = self.resolve(n) { self.emit(Op::Load(slot)); }
+                else if let Some(&i) = self.natives.get(n) {
+                    let c = self.constant(Value::NativeAction(self.native_fns[i as usize]));
+                    self.emit(Op::Const(c));
+                } else { self.fail(&format!("undefined: {}", n)); }
+            },
+            Expr::Binary(l, op, r, _) => match op {
+                BinOp::And | BinOp::Or => {
+                    self.expr(l)?;
+                    let at = self.emit(if *op == BinOp::And { Op::And(0) } else { Op::Or(0) });
+                    self.expr(r)?;
+                    self.emit(Op::Truthy);
+                    self.patch(at);
+                },
+                _ => { self.expr(l)?; self.expr(r)?; self.emit(Op::Bin(*op)); }
+            },
+            Expr::Unary(op, x, _) => {
+                self.expr(x)?;
+                self.emit(match op { UnaryOp::Neg => Op::Neg, UnaryOp::Not => Op::Not, UnaryOp::BitwiseNot => Op::BitNot });
+            },
+            Expr::Call(callee, args, _) => self.call(callee, args)?,
+            Expr::Member(o, f, _) => {
+                let c = self.string(f);
+                match self.local_of(o) {
+                    Some(slot) => { self.emit(Op::MemberLocal(slot, c)); },
+                    None => { self.expr(o)?; self.emit(Op::Member(c)); }
+                }
+            },
+            Expr::OptionalChain(o, f, _) => {
+                self.expr(o)?;
+                let c = self.string(f);
+                self.emit(Op::OptMember(c));
+            },
+            Expr::Index(a, i, _) => match self.local_of(a) {
+                Some(slot) => { self.expr(i)?; self.emit(Op::IndexLocal(slot)); },
+                None => { self.expr(a)?; self.expr(i)?; self.emit(Op::Index); }
+            },
+            Expr::Assign(t, v, _) => {
+                self.expr(v)?;
+                match t.as_ref() {
+                    Expr::Identifier(n, _) => match self.resolve(n) {
+                        Some(slot) => { self.emit(Op::Dup); self.emit(Op::Store(slot)); },
+                        None => self.fail("undefined variable"),
+                    },
+                    _ => self.fail("invalid assignment target"),
+                }
+            },
+            Expr::CompoundAssign(t, op, v, _) => {
+                let slot = match t.as_ref() {
+                    Expr::Identifier(n, _) => self.resolve(n),
+                    _ => { self.fail("invalid compound assignment target"); return Ok(()); }
+                };
+                let Some(slot) = slot else { self.fail("undefined"); return Ok(()); };
+                let op = match op {
+                    CompoundOp::AddEq => BinOp::Add, CompoundOp::SubEq => BinOp::Sub,
+                    CompoundOp::MulEq => BinOp::Mul, CompoundOp::DivEq => BinOp::Div,
+                    CompoundOp::ModEq => BinOp::Mod,
+                };
+                self.emit(Op::Load(slot));
+                self.expr(v)?;
+                self.emit(Op::Bin(op));
+                self.emit(Op::Dup);
+                self.emit(Op::Store(slot));
+            },
+            Expr::PreIncrement(t, _) => self.increment(t, 1, false, "increment")?,
+            Expr::PreDecrement(t, _) => self.increment(t, -1, false, "decrement")?,
+            Expr::PostIncrement(t, _) => self.increment(t, 1, true, "increment")?,
+            Expr::PostDecrement(t, _) => self.increment(t, -1, true, "decrement")?,
+            Expr::ArrayLit(es, _) => {
+                for x in es { self.expr(x)?; }
+                self.emit(Op::Array(es.len() as u32));
+            },
+            Expr::StructLit(n, fs, _) => {
+                let name = self.string(n);
+                for (_, v) in fs { self.expr(v)?; }
+                // Keys are consecutive so the VM can walk them
+                let first = self.consts.len() as u32;
+                for (k, _) in fs { self.constant(Value::String(k.clone())); }
+                self.emit(Op::Struct(name, first, fs.len() as u32));
+            },
+            Expr::Match(x, arms, _) => {
+                self.expr(x)?;
+                let mut ends = Vec::new();
+                for arm in arms {
+                    let next = match &arm.pattern {
+                        Pattern::Literal(l) => {
+                            let c = self.constant(match l {
+                                Literal::Int(i, _) => Value::Int(*i), Literal::Bool(b, _) => Value::Bool(*b),
+                                Literal::Float(f, _) => Value::Float(*f), Literal::String(s, _) => Value::String(s.clone()),
+                            });
+                            Some(self.emit(Op::MatchLit(c, 0)))
+                        },
+                        Pattern::Wildcard | Pattern::Identifier(_) => None,
+                    };
+                    self.emit(Op::Pop);
+                    self.expr(&arm.body)?;
+                    ends.push(self.emit(Op::Jump(0)));
+                    match next { Some(at) => self.patch(at), None => break }
+                }
+                self.emit(Op::Pop);
+                self.emit(Op::Nil);
+                for at in ends { self.patch(at); }
+            },
+            Expr::NullCoalesce(l, r, _) => {
+                self.expr(l)?;
+                let at = self.emit(Op::JumpIfNotNil(0));
+                self.expr(r)?;
+                self.patch(at);
+            },
+            // The closure is a callback the interpreter doesn't run
+            Expr::TrailingClosure(call, _, _) => self.expr(call)?,
+            Expr::Await(inner, _) => self.expr(inner)?,
+            Expr::Range(s, e, _) => { self.expr(s)?; self.expr(e)?; self.emit(Op::Range); },
+        }
+        Ok(())
+    }
+
+    fn local_of(&self, e: &Expr) -> Option<u16> {
+        if let Expr::Identifier(n, _) = e { self.resolve(n) } else { None }
+    }
+
+    fn increment(&mut self, t: &Expr, delta: i64, post: bool, what: &str) -> Result<(), CompileError> {
+        match t {
+            Expr::Identifier(n, _) => match self.resolve(n) {
+                Some(slot) => { self.emit(Op::IncLocal(slot, delta, post)); },
+                None => self.fail("undefined"),
+            },
+            _ => self.fail(&format!("invalid {} target", what)),
+        }
+        Ok(())
+    }
+
+    fn call(&mut self, callee: &Expr, args: &[Expr]) -> Result<(), CompileError> {
+        let Expr::Identifier(n, _) = callee else {
+            self.fail("unknown function");
+            return Ok(());
+        };
+        if args.len() > u8::MAX as usize {
+            return Err(CompileError { message: format!("too many arguments to {}", n) });
+        }
+        // Natives shadow functions; a local holding a native shadows both
+        let local = self.resolve(n);
+        if local.is_none() && n == "len" && args.len() == 1 {
+            if let Some(slot) = self.local_of(&args[0]) {
+                self.emit(Op::Len(slot));
+                return Ok(());
+            }
+        }
+        for a in args { self.expr(a)?; }
+        let argc = args.len() as u8;
+        let function = self.functions.get(n).copied();
+        match (local, self.natives.get(n)) {
+            (Some(slot), _) => { self.emit(Op::CallValue(slot, argc, function)); },
+            (None, Some(&i)) => { self.emit(Op::Native(i, argc)); },
+            (None, None) => match function {
+                Some(f) => { self.emit(Op::Call(f, argc)); },
+                None => self.fail("unknown function"),
+            },
+        }
+        Ok(())
+    }
+}
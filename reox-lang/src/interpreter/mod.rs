@@ -5,6 +5,9 @@
 use crate::parser::*;
 use std::collections::HashMap;
 
+pub mod bytecode;
+pub mod vm;
+
 #[derive(Debug, Clone)]
 pub enum Value {
     Nil, Bool(bool), Int(i64), Float(f64), String(String),
@@ -638,7 +641,7 @@ impl Interpreter {
             Expr::Binary(l, o, r, _) => { 
                 let lv = self.expr(l)?; 
                 let rv = self.expr(r)?; 
-                self.binop(lv, o, rv) 
+                binop(lv, o, rv) 
             },
             Expr::Unary(o, x, _) => { 
                 let v = self.expr(x)?; 
@@ -717,11 +720,11 @@ impl Interpreter {
                     let current = self.env.get(n).ok_or_else(|| RuntimeError::new("undefined"))?;
                     let rhs = self.expr(value)?;
                     let result = match op {
-                        CompoundOp::AddEq => self.binop(current, &BinOp::Add, rhs)?,
-                        CompoundOp::SubEq => self.binop(current, &BinOp::Sub, rhs)?,
-                        CompoundOp::MulEq => self.binop(current, &BinOp::Mul, rhs)?,
-                        CompoundOp::DivEq => self.binop(current, &BinOp::Div, rhs)?,
-                        CompoundOp::ModEq => self.binop(current, &BinOp::Mod, rhs)?,
+                        CompoundOp::AddEq => binop(current, &BinOp::Add, rhs)?,
+                        CompoundOp::SubEq => binop(current, &BinOp::Sub, rhs)?,
+                        CompoundOp::MulEq => binop(current, &BinOp::Mul, rhs)?,
+                        CompoundOp::DivEq => binop(current, &BinOp::Div, rhs)?,
+                        CompoundOp::ModEq => binop(current, &BinOp::Mod, rhs)?,
                     };
                     self.env.set(n, result.clone());
                     Ok(result)
@@ -831,97 +834,105 @@ impl Interpreter {
         match p { Pattern::Wildcard | Pattern::Identifier(_) => true, Pattern::Literal(l) => match (l,v) { (Literal::Int(a,_), Value::Int(b)) => *a==*b, (Literal::Bool(a,_), Value::Bool(b)) => *a==*b, _ => false } }
     }
     
-    fn binop(&self, l: Value, o: &BinOp, r: Value) -> Result<Value, RuntimeError> {
-        Ok(match o {
-            BinOp::Add => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Int(a+b), 
-                (Value::Float(a),Value::Float(b)) => Value::Float(a+b),
-                (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 + b),
-                (Value::Float(a),Value::Int(b)) => Value::Float(a + b as f64),
-                (Value::String(a),Value::String(b)) => Value::String(a+&b), 
-                _ => return Err(RuntimeError::new("+")) 
-            },
-            BinOp::Sub => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Int(a-b), 
-                (Value::Float(a),Value::Float(b)) => Value::Float(a-b),
-                (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 - b),
-                (Value::Float(a),Value::Int(b)) => Value::Float(a - b as f64),
-                _ => return Err(RuntimeError::new("-")) 
-            },
-            BinOp::Mul => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Int(a*b), 
-                (Value::Float(a),Value::Float(b)) => Value::Float(a*b),
-                (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 * b),
-                (Value::Float(a),Value::Int(b)) => Value::Float(a * b as f64),
-                _ => return Err(RuntimeError::new("*")) 
-            },
-            BinOp::Div => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) if b!=0 => Value::Int(a/b), 
-                (Value::Float(a),Value::Float(b)) if b!=0.0 => Value::Float(a/b),
-                (Value::Int(a),Value::Float(b)) if b!=0.0 => Value::Float(a as f64 / b),
-                (Value::Float(a),Value::Int(b)) if b!=0 => Value::Float(a / b as f64),
-                _ => return Err(RuntimeError::new("/")) 
-            },
-            BinOp::Mod => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) if b!=0 => Value::Int(a%b), 
-                (Value::Float(a),Value::Float(b)) if b!=0.0 => Value::Float(a%b),
-                (Value::Int(a),Value::Float(b)) if b!=0.0 => Value::Float((a as f64) % b),
-                (Value::Float(a),Value::Int(b)) if b!=0 => Value::Float(a % (b as f64)),
-                _ => return Err(RuntimeError::new("%")) 
-            },
-            BinOp::Eq => Value::Bool(self.eq(&l,&r)), 
-            BinOp::Ne => Value::Bool(!self.eq(&l,&r)),
-            BinOp::Lt => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Bool(a<b), 
-                (Value::Float(a),Value::Float(b)) => Value::Bool(a<b),
-                (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) < b),
-                (Value::Float(a),Value::Int(b)) => Value::Bool(a < (b as f64)),
-                _ => return Err(RuntimeError::new("<")) 
-            },
-            BinOp::Gt => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Bool(a>b), 
-                (Value::Float(a),Value::Float(b)) => Value::Bool(a>b),
-                (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) > b),
-                (Value::Float(a),Value::Int(b)) => Value::Bool(a > (b as f64)),
-                _ => return Err(RuntimeError::new(">")) 
-            },
-            BinOp::Le => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Bool(a<=b), 
-                (Value::Float(a),Value::Float(b)) => Value::Bool(a<=b),
-                (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) <= b),
-                (Value::Float(a),Value::Int(b)) => Value::Bool(a <= (b as f64)),
-                _ => return Err(RuntimeError::new("<=")) 
-            },
-            BinOp::Ge => match (l,r) { 
-                (Value::Int(a),Value::Int(b)) => Value::Bool(a>=b), 
-                (Value::Float(a),Value::Float(b)) => Value::Bool(a>=b),
-                (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) >= b),
-                (Value::Float(a),Value::Int(b)) => Value::Bool(a >= (b as f64)),
-                _ => return Err(RuntimeError::new(">=")) 
-            },
-            BinOp::And => Value::Bool(l.is_truthy() && r.is_truthy()), 
-            BinOp::Or => Value::Bool(l.is_truthy() || r.is_truthy()),
-            // Bitwise operators
-            BinOp::BitwiseAnd => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a&b), _ => return Err(RuntimeError::new("&")) },
-            BinOp::BitwiseOr => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a|b), _ => return Err(RuntimeError::new("|")) },
-            BinOp::BitwiseXor => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a^b), _ => return Err(RuntimeError::new("^")) },
-            BinOp::ShiftLeft => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a<<b), _ => return Err(RuntimeError::new("<<")) },
-            BinOp::ShiftRight => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a>>b), _ => return Err(RuntimeError::new(">>")) },
-        })
-    }
-    
-    fn eq(&self, a: &Value, b: &Value) -> bool { 
-        match (a,b) { 
-            (Value::Nil,Value::Nil) => true, 
-            (Value::Bool(a),Value::Bool(b)) => a==b, 
-            (Value::Int(a),Value::Int(b)) => a==b, 
-            (Value::Float(a),Value::Float(b)) => (a - b).abs() < f64::EPSILON,
-            (Value::String(a),Value::String(b)) => a==b, 
-            _ => false 
-        } 
-    }
+}
+
+pub(crate) fn binop(l: Value, o: &BinOp, r: Value) -> Result<Value, RuntimeError> {
+    Ok(match o {
+        BinOp::Add => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Int(a+b), 
+            (Value::Float(a),Value::Float(b)) => Value::Float(a+b),
+            (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 + b),
+            (Value::Float(a),Value::Int(b)) => Value::Float(a + b as f64),
+            (Value::String(a),Value::String(b)) => Value::String(a+&b), 
+            _ => return Err(RuntimeError::new("+")) 
+        },
+        BinOp::Sub => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Int(a-b), 
+            (Value::Float(a),Value::Float(b)) => Value::Float(a-b),
+            (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 - b),
+            (Value::Float(a),Value::Int(b)) => Value::Float(a - b as f64),
+            _ => return Err(RuntimeError::new("-")) 
+        },
+        BinOp::Mul => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Int(a*b), 
+            (Value::Float(a),Value::Float(b)) => Value::Float(a*b),
+            (Value::Int(a),Value::Float(b)) => Value::Float(a as f64 * b),
+            (Value::Float(a),Value::Int(b)) => Value::Float(a * b as f64),
+            _ => return Err(RuntimeError::new("*")) 
+        },
+        BinOp::Div => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) if b!=0 => Value::Int(a/b), 
+            (Value::Float(a),Value::Float(b)) if b!=0.0 => Value::Float(a/b),
+            (Value::Int(a),Value::Float(b)) if b!=0.0 => Value::Float(a as f64 / b),
+            (Value::Float(a),Value::Int(b)) if b!=0 => Value::Float(a / b as f64),
+            _ => return Err(RuntimeError::new("/")) 
+        },
+        BinOp::Mod => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) if b!=0 => Value::Int(a%b), 
+            (Value::Float(a),Value::Float(b)) if b!=0.0 => Value::Float(a%b),
+            (Value::Int(a),Value::Float(b)) if b!=0.0 => Value::Float((a as f64) % b),
+            (Value::Float(a),Value::Int(b)) if b!=0 => Value::Float(a % (b as f64)),
+            _ => return Err(RuntimeError::new("%")) 
+        },
+        BinOp::Eq => Value::Bool(values_eq(&l,&r)), 
+        BinOp::Ne => Value::Bool(!values_eq(&l,&r)),
+        BinOp::Lt => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Bool(a<b), 
+            (Value::Float(a),Value::Float(b)) => Value::Bool(a<b),
+            (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) < b),
+            (Value::Float(a),Value::Int(b)) => Value::Bool(a < (b as f64)),
+            _ => return Err(RuntimeError::new("<")) 
+        },
+        BinOp::Gt => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Bool(a>b), 
+            (Value::Float(a),Value::Float(b)) => Value::Bool(a>b),
+            (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) > b),
+            (Value::Float(a),Value::Int(b)) => Value::Bool(a > (b as f64)),
+            _ => return Err(RuntimeError::new(">")) 
+        },
+        BinOp::Le => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Bool(a<=b), 
+            (Value::Float(a),Value::Float(b)) => Value::Bool(a<=b),
+            (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) <= b),
+            (Value::Float(a),Value::Int(b)) => Value::Bool(a <= (b as f64)),
+            _ => return Err(RuntimeError::new("<=")) 
+        },
+        BinOp::Ge => match (l,r) { 
+            (Value::Int(a),Value::Int(b)) => Value::Bool(a>=b), 
+            (Value::Float(a),Value::Float(b)) => Value::Bool(a>=b),
+            (Value::Int(a),Value::Float(b)) => Value::Bool((a as f64) >= b),
+            (Value::Float(a),Value::Int(b)) => Value::Bool(a >= (b as f64)),
+            _ => return Err(RuntimeError::new(">=")) 
+        },
+        BinOp::And => Value::Bool(l.is_truthy() && r.is_truthy()), 
+        BinOp::Or => Value::Bool(l.is_truthy() || r.is_truthy()),
+        // Bitwise operators
+        BinOp::BitwiseAnd => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a&b), _ => return Err(RuntimeError::new("&")) },
+        BinOp::BitwiseOr => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a|b), _ => return Err(RuntimeError::new("|")) },
+        BinOp::BitwiseXor => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a^b), _ => return Err(RuntimeError::new("^")) },
+        BinOp::ShiftLeft => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a<<b), _ => return Err(RuntimeError::new("<<")) },
+        BinOp::ShiftRight => match (l,r) { (Value::Int(a),Value::Int(b)) => Value::Int(a>>b), _ => return Err(RuntimeError::new(">>")) },
+    })
+}
+
+fn values_eq(a: &Value, b: &Value) -> bool { 
+    match (a,b) { 
+        (Value::Nil,Value::Nil) => true, 
+        (Value::Bool(a),Value::Bool(b)) => a==b, 
+        (Value::Int(a),Value::Int(b)) => a==b, 
+        (Value::Float(a),Value::Float(b)) => (a - b).abs() < f64::EPSILON,
+        (Value::String(a),Value::String(b)) => a==b, 
+        _ => false 
+    } 
 }
 
 impl Default for Interpreter { fn default() -> Self { Self::new() } }
 
-pub fn eval(ast: &Ast) -> Result<Value, RuntimeError> { Interpreter::new().eval(ast) }
+/// Compile to bytecode and run on the VM; the tree-walker takes programs
+/// the compiler can't handle
+pub fn eval(ast: &Ast) -> Result<Value, RuntimeError> {
+    match bytecode::compile(ast) {
+        Ok(program) => vm::run(&program),
+        Err(_) => Interpreter::new().eval(ast),
+    }
+}
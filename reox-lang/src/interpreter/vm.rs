@@ -0,0 +1,437 @@
+// REOX VM - Runs compiled bytecode on one value stack
+//
+// A frame's locals are a fixed window of the stack starting at its base;
+// temporaries live above them. Try handlers record the stack and frame
+// depth to unwind to, so runtime errors from any depth reach the nearest
+// catch.
+
+use super::bytecode::{Op, Program};
+use super::{binop, RuntimeError, Value};
+use crate::parser::BinOp;
+use std::collections::HashMap;
+
+const MAX_FRAMES: usize = 10_000;
+
+struct Frame { func: u32, ip: usize, base: usize }
+struct Handler { catch_ip: usize, frames: usize, stack: usize }
+
+pub struct Vm<'p> {
+    program: &'p Program,
+    stack: Vec<Value>,
+    frames: Vec<Frame>,
+    handlers: Vec<Handler>,
+}
+
+/// Run main() and return its value, or Nil without one
+pub fn run(program: &Program) -> Result<Value, RuntimeError> {
+    match program.main {
+        Some(main) => Vm::new(program).call(main, Vec::new()),
+        None => Ok(Value::Nil),
+    }
+}
+
+impl<'p> Vm<'p> {
+    pub fn new(program: &'p Program) -> Self {
+        Self { program, stack: Vec::with_capacity(256), frames: Vec::new(), handlers: Vec::new() }
+    }
+
+    /// Call a compiled function by index
+    pub fn call(&mut self, func: u32, args: Vec<Value>) -> Result<Value, RuntimeError> {
+        let argc = args.len();
+        self.stack.extend(args);
+        self.enter(func, argc)?;
+        self.execute()
+    }
+
+    fn enter(&mut self, func: u32, argc: usize) -> Result<(), RuntimeError> {
+        if self.frames.len() >= MAX_FRAMES { return Err(RuntimeError::new("stack overflow")); }
+        let f = &self.program.functions[func as usize];
+        let base = self.stack.len() - argc;
+        // Missing arguments are nil and extra ones are dropped
+        self.stack.truncate(base + argc.min(f.arity));
+        self.stack.resize(base + f.slots, Value::Nil);
+        self.frames.push(Frame { func, ip: 0, base });
+        Ok(())
+    }
+
+    fn execute(&mut self) -> Result<Value, RuntimeError> {
+        let entry = self.frames.len() - 1;
+        loop {
+            match self.step(entry) {
+                Ok(Some(v)) => return Ok(v),
+                Ok(None) => {},
+                Err(e) => {
+                    // Unwind to the nearest handler set up by this call
+                    match self.handlers.last() {
+                        Some(h) if h.frames > entry => {
+                            let h = self.handlers.pop().unwrap();
+                            self.frames.truncate(h.frames);
+                            self.stack.truncate(h.stack);
+                            self.stack.push(Value::String(e.message));
+                            self.frames.last_mut().unwrap().ip = h.catch_ip;
+                        },
+                        _ => {
+                            self.frames.truncate(entry);
+                            return Err(e);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    fn pop(&mut self) -> Value { self.stack.pop().unwrap_or(Value::Nil) }
+
+    fn top(&mut self) -> &mut Value { self.stack.last_mut().unwrap() }
+
+    /// Run until the entry frame returns (Some) or an error is raised
+    fn step(&mut self, entry: usize) -> Result<Option<Value>, RuntimeError> {
+        let program = self.program;
+        let frame = self.frames.last().unwrap();
+        let mut code = &program.functions[frame.func as usize].code[..];
+        let mut ip = frame.ip;
+        let mut base = frame.base;
+
+        macro_rules! save { () => { self.frames.last_mut().unwrap().ip = ip; } }
+        macro_rules! raise { ($e:expr) => {{ save!(); return Err($e); }} }
+
+        loop {
+            let op = code[ip];
+            ip += 1;
+            match op {
+                Op::Const(c) => self.stack.push(program.consts[c as usize].clone()),
+                Op::Int(i) => self.stack.push(Value::Int(i)),
+                Op::Nil => self.stack.push(Value::Nil),
+                Op::Pop => { self.stack.pop(); },
+                Op::Dup => { let v = self.top().clone(); self.stack.push(v); },
+                Op::Load(s) => { let v = self.stack[base + s as usize].clone(); self.stack.push(v); },
+                Op::Store(s) => { let v = self.pop(); self.stack[base + s as usize] = v; },
+                Op::Bin(op) => {
+                    let r = self.pop();
+                    let l = self.top();
+                    // Int and float arithmetic and comparisons stay in place
+                    let fast = match (&*l, &r) {
+                        (Value::Int(a), Value::Int(b)) => int_op(op, *a, *b),
+                        (Value::Float(a), Value::Float(b)) => float_op(op, *a, *b),
+                        _ => None,
+                    };
+                    match fast {
+                        Some(v) => *l = v,
+                        None => {
+                            let lv = std::mem::replace(l, Value::Nil);
+                            match binop(lv, &op, r) { Ok(v) => *self.top() = v, Err(e) => raise!(e) }
+                        }
+                    }
+                },
+                Op::Neg => match self.top() {
+                    Value::Int(i) => *i = i.wrapping_neg(),
+                    Value::Float(f) => *f = -*f,
+                    _ => raise!(RuntimeError::new("cannot negate")),
+                },
+                Op::Not => { let t = self.top(); *t = Value::Bool(!t.is_truthy()); },
+                Op::BitNot => match self.top() {
+                    Value::Int(i) => *i = !*i,
+                    _ => raise!(RuntimeError::new("bitwise not requires int")),
+                },
+                Op::Truthy => { let t = self.top(); *t = Value::Bool(t.is_truthy()); },
+                Op::Jump(to) => ip = to as usize,
+                Op::JumpIfFalse(to) => if !self.pop().is_truthy() { ip = to as usize },
+                Op::JumpIfTrue(to) => if self.pop().is_truthy() { ip = to as usize },
+                Op::And(to) => {
+                    if self.top().is_truthy() { self.stack.pop(); }
+                    else { *self.top() = Value::Bool(false); ip = to as usize; }
+                },
+                Op::Or(to) => {
+                    if self.top().is_truthy() { *self.top() = Value::Bool(true); ip = to as usize; }
+                    else { self.stack.pop(); }
+                },
+                Op::JumpIfNotNil(to) => {
+                    if matches!(self.top(), Value::Nil) { self.stack.pop(); } else { ip = to as usize; }
+                },
+                Op::Call(f, argc) => {
+                    save!();
+                    self.enter(f, argc as usize)?;
+                    let frame = self.frames.last().unwrap();
+                    code = &program.functions[frame.func as usize].code[..];
+                    ip = 0;
+                    base = frame.base;
+                },
+                Op::Native(n, argc) => {
+                    let args = self.stack.split_off(self.stack.len() - argc as usize);
+                    self.stack.push(program.natives[n as usize](args));
+                },
+                Op::CallValue(s, argc, func) => {
+                    if let Value::NativeAction(f) = self.stack[base + s as usize] {
+                        let args = self.stack.split_off(self.stack.len() - argc as usize);
+                        self.stack.push(f(args));
+                    } else if let Some(f) = func {
+                        save!();
+                        self.enter(f, argc as usize)?;
+                        let frame = self.frames.last().unwrap();
+                        code = &program.functions[frame.func as usize].code[..];
+                        ip = 0;
+                        base = frame.base;
+                    } else {
+                        raise!(RuntimeError::new("unknown function"));
+                    }
+                },
+                Op::Return => {
+                    let result = self.pop();
+                    let depth = self.frames.len();
+                    while self.handlers.last().map_or(false, |h| h.frames >= depth) { self.handlers.pop(); }
+                    self.frames.pop();
+                    self.stack.truncate(base);
+                    if self.frames.len() == entry { return Ok(Some(result)); }
+                    self.stack.push(result);
+                    let frame = self.frames.last().unwrap();
+                    code = &program.functions[frame.func as usize].code[..];
+                    ip = frame.ip;
+                    base = frame.base;
+                },
+                Op::Array(n) => {
+                    let items = self.stack.split_off(self.stack.len() - n as usize);
+                    self.stack.push(Value::Array(items));
+                },
+                Op::Struct(name, first, n) => {
+                    let values = self.stack.split_off(self.stack.len() - n as usize);
+                    let mut fields = HashMap::with_capacity(n as usize);
+                    for (i, v) in values.into_iter().enumerate() {
+                        if let Value::String(k) = &program.consts[first as usize + i] { fields.insert(k.clone(), v); }
+                    }
+                    let name = match &program.consts[name as usize] { Value::String(s) => s.clone(), _ => String::new() };
+                    self.stack.push(Value::Struct { name, fields });
+                },
+                Op::Index => {
+                    let i = self.pop();
+                    let a = self.pop();
+                    match index(&a, &i) { Ok(v) => self.stack.push(v), Err(e) => raise!(e) }
+                },
+                Op::IndexLocal(s) => {
+                    let i = self.pop();
+                    match index(&self.stack[base + s as usize], &i) { Ok(v) => self.stack.push(v), Err(e) => raise!(e) }
+                },
+                Op::Member(c) => {
+                    let o = self.pop();
+                    match member(&o, &program.consts[c as usize]) { Ok(v) => self.stack.push(v), Err(e) => raise!(e) }
+                },
+                Op::MemberLocal(s, c) => {
+                    match member(&self.stack[base + s as usize], &program.consts[c as usize]) {
+                        Ok(v) => self.stack.push(v),
+                        Err(e) => raise!(e),
+                    }
+                },
+                Op::OptMember(c) => {
+                    let o = self.pop();
+                    let Value::String(f) = &program.consts[c as usize] else { continue };
+                    match o {
+                        Value::Nil => self.stack.push(Value::Nil),
+                        Value::Struct { fields, .. } => self.stack.push(fields.get(f).cloned().unwrap_or(Value::Nil)),
+                        _ => raise!(RuntimeError::new("optional chain on non-struct")),
+                    }
+                },
+                Op::Len(s) => {
+                    let n = match &self.stack[base + s as usize] {
+                        Value::Array(v) => v.len(), Value::String(v) => v.len(), Value::Map(m) => m.len(), _ => 0,
+                    };
+                    self.stack.push(Value::Int(n as i64));
+                },
+                Op::IncLocal(s, delta, post) => {
+                    let slot = &mut self.stack[base + s as usize];
+                    let Value::Int(old) = *slot else {
+                        raise!(RuntimeError::new(if delta > 0 { "increment requires int" } else { "decrement requires int" }))
+                    };
+                    *slot = Value::Int(old.wrapping_add(delta));
+                    self.stack.push(Value::Int(if post { old } else { old.wrapping_add(delta) }));
+                },
+                Op::Range => {
+                    let e = self.pop();
+                    let s = self.pop();
+                    match (s, e) {
+                        (Value::Int(from), Value::Int(to)) => self.stack.push(Value::Array((from..=to).map(Value::Int).collect())),
+                        _ => raise!(RuntimeError::new("range requires int bounds")),
+                    }
+                },
+                Op::MatchLit(c, to) => {
+                    let hit = match (&program.consts[c as usize], self.stack.last()) {
+                        (Value::Int(a), Some(Value::Int(b))) => a == b,
+                        (Value::Bool(a), Some(Value::Bool(b))) => a == b,
+                        _ => false,
+                    };
+                    if !hit { ip = to as usize; }
+                },
+                Op::ForNext(it, ix, var, exit) => {
+                    let i = match self.stack[base + ix as usize] { Value::Int(i) => i as usize, _ => usize::MAX };
+                    let next = match &self.stack[base + it as usize] {
+                        Value::Array(items) => items.get(i).cloned(),
+                        _ => None,
+                    };
+                    match next {
+                        Some(v) => {
+                            self.stack[base + var as usize] = v;
+                            self.stack[base + ix as usize] = Value::Int(i as i64 + 1);
+                        },
+                        None => ip = exit as usize,
+                    }
+                },
+                Op::TryBegin(catch_ip) => {
+                    self.handlers.push(Handler { catch_ip: catch_ip as usize, frames: self.frames.len(), stack: self.stack.len() });
+                },
+                Op::TryEnd => { self.handlers.pop(); },
+                Op::Throw => { let v = self.pop(); raise!(RuntimeError::new(format!("{}", v))) },
+                Op::Fail(c) => raise!(RuntimeError::new(format!("{}", program.consts[c as usize]))),
+            }
+        }
+    }
+}
+
+fn int_op(op: BinOp, a: i64, b: i64) -> Option<Value> {
+    Some(match op {
+        BinOp::Add => Value::Int(a.wrapping_add(b)),
+        BinOp::Sub => Value::Int(a.wrapping_sub(b)),
+        BinOp::Mul => Value::Int(a.wrapping_mul(b)),
+        BinOp::Lt => Value::Bool(a < b),
+        BinOp::Le => Value::Bool(a <= b),
+        BinOp::Gt => Value::Bool(a > b),
+        BinOp::Ge => Value::Bool(a >= b),
+        BinOp::Eq => Value::Bool(a == b),
+        BinOp::Ne => Value::Bool(a != b),
+        _ => return None,
+    })
+}
+
+fn float_op(op: BinOp, a: f64, b: f64) -> Option<Value> {
+    Some(match op {
+        BinOp::Add => Value::Float(a + b),
+        BinOp::Sub => Value::Float(a - b),
+        BinOp::Mul => Value::Float(a * b),
+        BinOp::Lt => Value::Bool(a < b),
+        BinOp::Le => Value::Bool(a <= b),
+        BinOp::Gt => Value::Bool(a > b),
+        BinOp::Ge => Value::Bool(a >= b),
+        _ => return None,
+    })
+}
+
+fn index(a: &Value, i: &Value) -> Result<Value, RuntimeError> {
+    match (a, i) {
+        (Value::Array(arr), Value::Int(idx)) => arr.get(*idx as usize).cloned().ok_or_else(|| RuntimeError::new("index out of bounds")),
+        (Value::Map(m), Value::String(k)) => Ok(m.get(k).cloned().unwrap_or(Value::Nil)),
+        _ => Err(RuntimeError::new("invalid indexing")),
+    }
+}
+
+fn member(o: &Value, field: &Value) -> Result<Value, RuntimeError> {
+    let Value::String(f) = field else { return Err(RuntimeError::new("invalid member")) };
+    match o {
+        Value::Struct { fields, .. } => fields.get(f).cloned().ok_or_else(|| RuntimeError::new(format!("undefined field: {}", f))),
+        _ => Err(RuntimeError::new("member access on non-struct")),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::interpreter::bytecode::compile;
+    use crate::lexer::tokenize;
+    use crate::parser::parse;
+
+    fn run_src(source: &str) -> Result<Value, RuntimeError> {
+        let tokens = tokenize(source).unwrap();
+        let ast = parse(&tokens);
+        run(&compile(&ast).map_err(|e| RuntimeError::new(e.message))?)
+    }
+
+    fn int(source: &str) -> i64 {
+        match run_src(source) { Ok(Value::Int(i)) => i, other => panic!("expected int, got {:?}", other.map(|v| v.to_string())) }
+    }
+
+    #[test]
+    fn test_recursion_and_early_return() {
+        let source = r#"
+            fn fib(n: int) -> int {
+                if n < 2 {
+                    return n;
+                }
+                return fib(n - 1) + fib(n - 2);
+            }
+            fn main() -> int {
+                return fib(20);
+            }
+        "#;
+        assert_eq!(int(source), 6765);
+    }
+
+    #[test]
+    fn test_loops() {
+        let source = r#"
+            fn main() -> int {
+                let sum = 0;
+                let i = 0;
+                while i < 100 {
+                    i = i + 1;
+                    if i % 2 == 1 { sum = sum + i; }
+                }
+                let items = [1, 2, 3, 4];
+                for x in (items) {
+                    sum = sum + x * len(items);
+                }
+                for k in ([1, 2, 3]) {
+                    sum = sum + items[k];
+                }
+                return sum;
+            }
+        "#;
+        assert_eq!(int(source), 2500 + 40 + 9);
+    }
+
+    #[test]
+    fn test_try_catch_unwinds_calls() {
+        let source = r#"
+            fn check(n: int) -> int {
+                if n > 2 {
+                    throw "too big";
+                }
+                return n;
+            }
+            fn main() -> int {
+                let total = 0;
+                for n in ([0, 1, 2, 3, 4]) {
+                    try {
+                        total = total + check(n);
+                    } catch e {
+                        total = total + 100;
+                    }
+                }
+                return total;
+            }
+        "#;
+        assert_eq!(int(source), 3 + 200);
+    }
+
+    #[test]
+    fn test_locals_are_block_scoped() {
+        let source = r#"
+            fn main() -> int {
+                let x = 1;
+                if true {
+                    let x = 2;
+                    x = x + 10;
+                }
+                let r = match (x) { 1 => 7, _ => 0 };
+                return r + x;
+            }
+        "#;
+        assert_eq!(int(source), 8);
+    }
+
+    #[test]
+    fn test_runtime_error() {
+        let source = r#"
+            fn main() {
+                let a = [1];
+                return a[3];
+            }
+        "#;
+        assert_eq!(run_src(source).unwrap_err().message, "index out of bounds");
+    }
+}
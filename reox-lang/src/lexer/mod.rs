@@ -38,6 +38,7 @@ pub struct Lexer<'a> {
     line: u32,
     column: u32,
     current_pos: usize,
+    offset: usize,      // Byte offset of `chars` in `source`
 }
 
 impl<'a> Lexer<'a> {
@@ -48,12 +49,28 @@ impl<'a> Lexer<'a> {
             line: 1,
             column: 1,
             current_pos: 0,
+            offset: 0,
+        }
+    }
+
+    /// Lexer that starts at byte `pos` of `source`, which is at `line`:`column`.
+    /// `pos` must be where a token (or the whitespace before one) starts.
+    fn resume(source: &'a str, pos: usize, line: u32, column: u32) -> Self {
+        Self {
+            source,
+            chars: source[pos..].char_indices().peekable(),
+            line,
+            column,
+            // Where a full lex would stand: on the last character consumed
+            current_pos: source[..pos].char_indices().next_back().map_or(0, |(i, _)| i),
+            offset: pos,
         }
     }
 
     /// Advance to next character
     fn advance(&mut self) -> Option<(usize, char)> {
         if let Some((pos, ch)) = self.chars.next() {
+            let pos = pos + self.offset;
             self.current_pos = pos;
             if ch == '\n' {
                 self.line += 1;
@@ -544,6 +561,158 @@ pub fn tokenize(source: &str) -> Result<Vec<Token>, LexError> {
     Ok(tokens)
 }
 
+// === Incremental Lexing ===
+
+/// A text edit: replace bytes `start..end` of the old source with `text`
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct TextEdit {
+    pub start: usize,
+    pub end: usize,
+    pub text: String,
+}
+
+impl TextEdit {
+    pub fn new(start: usize, end: usize, text: impl Into<String>) -> Self {
+        Self { start, end, text: text.into() }
+    }
+
+    /// The source with this edit applied
+    pub fn apply(&self, source: &str) -> String {
+        let mut out = String::with_capacity(source.len() - (self.end - self.start) + self.text.len());
+        out.push_str(&source[..self.start]);
+        out.push_str(&self.text);
+        out.push_str(&source[self.end..]);
+        out
+    }
+}
+
+/// How the spans of everything after an edit moved
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SpanShift {
+    pub from: usize,    // Old byte offset where the edit ended
+    pub bytes: isize,
+    pub lines: i32,
+    pub line: u32,      // Old line the edit ended on; the only line whose columns move
+    pub columns: i32,
+}
+
+impl SpanShift {
+    /// Move a span from the old source to the new one.
+    /// Only spans that start at or after `from` are touched.
+    pub fn apply(&self, span: &mut Span) {
+        if span.start < self.from {
+            return;
+        }
+        span.start = (span.start as isize + self.bytes) as usize;
+        span.end = (span.end as isize + self.bytes) as usize;
+        if span.line == 0 {
+            return; // EOF carries no line
+        }
+        if span.line == self.line {
+            span.column = (span.column as i32 + self.columns) as u32;
+        }
+        span.line = (span.line as i32 + self.lines) as u32;
+    }
+}
+
+/// Which tokens an edit replaced: old `start..old_end` became new `start..new_end`.
+/// Tokens before `start` are untouched; the ones after moved by `shift`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct TokenEdit {
+    pub start: usize,
+    pub old_end: usize,
+    pub new_end: usize,
+    pub shift: SpanShift,
+}
+
+/// Result of re-lexing an edited source
+#[derive(Debug, Clone)]
+pub struct Relexed {
+    pub source: String,
+    pub tokens: Vec<Token>,
+    pub edit: TokenEdit,
+}
+
+/// Column of byte `pos` in `source`, as the lexer counts them
+fn column_at(source: &str, pos: usize) -> u32 {
+    let line_start = source[..pos].rfind('\n').map_or(0, |i| i + 1);
+    source[line_start..pos].chars().count() as u32 + 1
+}
+
+fn count_lines(text: &str) -> i32 {
+    text.bytes().filter(|&b| b == b'\n').count() as i32
+}
+
+/// Re-lex `old_source` (whose tokens are `old_tokens`) after `edit`.
+///
+/// Lexing restarts at the last token that ends before the edit; one that
+/// touches it may have grown (`ab` + `c`). It stops as soon as it produces a
+/// token at the same place, past the edit, as an old one: a token depends only
+/// on the text from where it starts, so everything after is the old tokens
+/// moved. Typing inside a function re-lexes a few tokens, not the file.
+pub fn relex(old_source: &str, old_tokens: &[Token], edit: &TextEdit) -> Result<Relexed, LexError> {
+    let source = edit.apply(old_source);
+    let inserted_end = edit.start + edit.text.len();
+
+    let first = old_tokens
+        .iter()
+        .rposition(|t| t.kind != TokenKind::Eof && t.span.end < edit.start)
+        .unwrap_or(0);
+    let mut lexer = match old_tokens.get(first) {
+        Some(t) if t.kind != TokenKind::Eof && t.span.start <= edit.start => {
+            Lexer::resume(&source, t.span.start, t.span.line, t.span.column)
+        }
+        _ => Lexer::new(&source),
+    };
+    let restart = lexer.offset;
+    let restart_line = lexer.line;
+
+    let shift = SpanShift {
+        from: edit.end,
+        bytes: inserted_end as isize - edit.end as isize,
+        lines: count_lines(&edit.text) - count_lines(&old_source[edit.start..edit.end]),
+        line: restart_line + count_lines(&old_source[restart..edit.end]) as u32,
+        columns: column_at(&source, inserted_end) as i32 - column_at(old_source, edit.end) as i32,
+    };
+
+    let mut tokens = old_tokens[..first].to_vec();
+    let mut old = first;
+    loop {
+        let token = lexer.next_token()?;
+        if token.kind == TokenKind::Eof {
+            tokens.push(token);
+            break;
+        }
+        if token.span.start >= inserted_end {
+            let at = (token.span.start as isize - shift.bytes) as usize;
+            while old < old_tokens.len() && old_tokens[old].kind != TokenKind::Eof && old_tokens[old].span.start < at {
+                old += 1;
+            }
+            if old < old_tokens.len() && old_tokens[old].kind != TokenKind::Eof && old_tokens[old].span.start == at {
+                let new_end = tokens.len();
+                tokens.extend(old_tokens[old..].iter().map(|t| {
+                    let mut t = t.clone();
+                    shift.apply(&mut t.span);
+                    t
+                }));
+                return Ok(Relexed {
+                    source,
+                    tokens,
+                    edit: TokenEdit { start: first, old_end: old, new_end, shift },
+                });
+            }
+        }
+        tokens.push(token);
+    }
+
+    let new_end = tokens.len();
+    Ok(Relexed {
+        source,
+        tokens,
+        edit: TokenEdit { start: first, old_end: old_tokens.len(), new_end, shift },
+    })
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -803,4 +972,60 @@ mod tests {
         assert_eq!(tokens[6].kind, TokenKind::Typealias);
         assert_eq!(tokens[7].kind, TokenKind::Nil);
     }
+
+    const EDIT_SOURCE: &str = "fn add(a: int, b: int) -> int {\n    return a + b;\n}\n\n/* note */\nfn main() {\n    let x = add(1, 22);\n}\n";
+
+    fn assert_relex(source: &str, edit: TextEdit) -> TokenEdit {
+        let old = tokenize(source).unwrap();
+        let relexed = relex(source, &old, &edit).unwrap();
+        assert_eq!(relexed.source, edit.apply(source));
+        assert_eq!(relexed.tokens, tokenize(&relexed.source).unwrap(), "edit {:?}", edit);
+        relexed.edit
+    }
+
+    #[test]
+    fn test_relex_matches_tokenize() {
+        let len = EDIT_SOURCE.len();
+        let texts = ["", "x", "1", "\n", "  ", "\"s\"", "}\n", "/*", "*/", "0x1F", "let y = 2;\n"];
+        for start in 0..=len {
+            for end in start..=(start + 3).min(len) {
+                for text in texts {
+                    let edit = TextEdit::new(start, end, text);
+                    let old = tokenize(EDIT_SOURCE).unwrap();
+                    let new_source = edit.apply(EDIT_SOURCE);
+                    if let Ok(expected) = tokenize(&new_source) {
+                        let relexed = relex(EDIT_SOURCE, &old, &edit).unwrap();
+                        assert_eq!(relexed.tokens, expected, "edit {:?}", edit);
+                    }
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_relex_stops_after_edit() {
+        // Renaming `b` in the first function re-lexes only around it
+        let at = EDIT_SOURCE.find("b: int").unwrap();
+        let edit = assert_relex(EDIT_SOURCE, TextEdit::new(at, at + 1, "bee"));
+        assert!(edit.old_end - edit.start <= 3, "{:?}", edit);
+        assert_eq!(edit.old_end - edit.start, edit.new_end - edit.start);
+        assert_eq!(edit.shift.bytes, 2);
+        assert_eq!(edit.shift.lines, 0);
+    }
+
+    #[test]
+    fn test_relex_shifts_lines() {
+        let at = EDIT_SOURCE.find("return").unwrap();
+        let edit = assert_relex(EDIT_SOURCE, TextEdit::new(at, at, "let t = 0;\n    "));
+        assert_eq!(edit.shift.lines, 1);
+        assert!(edit.new_end - edit.start <= 8, "{:?}", edit);
+    }
+
+    #[test]
+    fn test_relex_comment_opened() {
+        // Opening a block comment swallows the rest of the file
+        let at = EDIT_SOURCE.find("return").unwrap();
+        let edit = assert_relex(EDIT_SOURCE, TextEdit::new(at, at, "/*"));
+        assert_eq!(edit.old_end, tokenize(EDIT_SOURCE).unwrap().len());
+    }
 }
@@ -9,13 +9,15 @@ pub mod profiler;
 pub mod interpreter;
 pub mod stdlib;
 pub mod cli;
+pub mod build;
 pub mod templates;
 
 // Re-export main types for convenience
-pub use lexer::{Token, TokenKind, Span, tokenize, LexError};
-pub use parser::{Ast, parse};
+pub use lexer::{Token, TokenKind, Span, tokenize, relex, TextEdit, LexError};
+pub use parser::{Ast, parse, parse_file, ParsedFile};
 pub use typechecker::check;
 pub use codegen::generate;
 pub use interpreter::{Interpreter, Value, eval};
 pub use cli::{CliCommand, Args, parse_cli, parse_args};
+pub use build::{ModuleCache, Document};
 pub use templates::{Template, ProjectConfig, create_project};
@@ -3,18 +3,12 @@
 
 #![allow(unused_imports)]
 
-mod lexer;
-mod parser;
-mod typechecker;
-mod codegen;
-mod cli;
-mod interpreter;
-mod stdlib;
-mod templates;
+use reoxc::{lexer, parser, cli, build, interpreter, templates};
 
 use std::env;
 use std::process;
-use std::path::Path;
+use std::collections::HashMap;
+use std::path::{Path, PathBuf};
 
 fn main() {
     let result = cli::parse_cli();
@@ -44,6 +38,9 @@ fn handle_command(cmd: cli::CliCommand) -> Result<(), String> {
                 compile(&args)
             }
         }
+        cli::CliCommand::Check(args) => {
+            check(&args)
+        }
         cli::CliCommand::Init { template, name } => {
             init_project(&template, name.as_deref())
         }
@@ -129,8 +126,9 @@ fn new_project(name: &str, template_name: &str) -> Result<(), String> {
 
 fn run(args: &cli::Args) -> Result<(), String> {
     // Read source file
-    let source = std::fs::read_to_string(&args.input)
-        .map_err(|e| format!("failed to read '{}': {}", args.input, e))?;
+    let input = &args.inputs[0];
+    let source = std::fs::read_to_string(input)
+        .map_err(|e| format!("failed to read '{}': {}", input, e))?;
 
     // Lexical analysis
     let tokens = lexer::tokenize(&source)
@@ -148,34 +146,97 @@ fn run(args: &cli::Args) -> Result<(), String> {
 }
 
 fn compile(args: &cli::Args) -> Result<(), String> {
-    // Read source file
-    let source = std::fs::read_to_string(&args.input)
-        .map_err(|e| format!("failed to read '{}': {}", args.input, e))?;
-
-    // Lexical analysis
-    let tokens = lexer::tokenize(&source)
-        .map_err(|e| e.display())?;
-
-    // Parse
-    let ast = parser::parse(&tokens);
-
-    // Type check
-    let checked_ast = typechecker::check(&ast);
+    if let Some(dir) = &args.out_dir {
+        std::fs::create_dir_all(dir)
+            .map_err(|e| format!("failed to create '{}': {}", dir, e))?;
+    }
 
-    // Generate code
-    let output_path = args.output.clone()
-        .unwrap_or_else(|| {
-            let stem = std::path::Path::new(&args.input)
+    // <stem>.c in the output directory, or the current one
+    let jobs: Vec<build::BuildJob> = args.inputs.iter().map(|input| {
+        let output = args.output.clone().unwrap_or_else(|| {
+            let stem = Path::new(input)
                 .file_stem()
                 .and_then(|s| s.to_str())
                 .unwrap_or("output");
-            format!("{}.c", stem)
+            let file = format!("{}.c", stem);
+            match &args.out_dir {
+                Some(dir) => Path::new(dir).join(file).to_string_lossy().into_owned(),
+                None => file,
+            }
         });
+        build::BuildJob { input: input.clone(), output }
+    }).collect();
+
+    // Inputs with the same name in different directories would overwrite
+    // each other's C
+    let mut outputs: HashMap<PathBuf, &str> = HashMap::new();
+    for job in &jobs {
+        if let Some(other) = outputs.insert(output_key(&job.output), &job.input) {
+            return Err(format!(
+                "'{}' and '{}' would both be compiled to '{}'",
+                other, job.input, job.output
+            ));
+        }
+    }
+
+    let results = build_jobs(args, &jobs, true)?;
+    for result in &results {
+        if result.error.is_none() {
+            let note = if result.cached { " (cached)" } else { "" };
+            println!("compiled: {} -> {}{}", result.input, result.output, note);
+        }
+    }
+    finish(&results)
+}
 
-    codegen::generate(&checked_ast, &output_path)
-        .map_err(|e| format!("code generation failed: {}", e))?;
+/// Where an output path really points, so `out/a.c` and `./out/a.c` match
+fn output_key(output: &str) -> PathBuf {
+    let path = Path::new(output);
+    let dir = match path.parent() {
+        Some(dir) if !dir.as_os_str().is_empty() => dir,
+        _ => Path::new("."),
+    };
+    match (std::fs::canonicalize(dir), path.file_name()) {
+        (Ok(dir), Some(name)) => dir.join(name),
+        _ => path.to_path_buf(),
+    }
+}
 
-    println!("compiled: {} -> {}", args.input, output_path);
+fn check(args: &cli::Args) -> Result<(), String> {
+    let jobs: Vec<build::BuildJob> = args.inputs.iter()
+        .map(|input| build::BuildJob { input: input.clone(), output: String::new() })
+        .collect();
+    let results = build_jobs(args, &jobs, false)?;
+    finish(&results)
+}
 
-    Ok(())
+fn build_jobs(args: &cli::Args, jobs: &[build::BuildJob], emit: bool) -> Result<Vec<build::BuildResult>, String> {
+    let cache = match &args.cache_dir {
+        Some(dir) => build::ModuleCache::on_disk(dir)
+            .map_err(|e| format!("failed to create cache '{}': {}", dir, e))?,
+        None => build::ModuleCache::new(),
+    };
+    let threads = if args.jobs == 0 { build::default_jobs() } else { args.jobs };
+
+    let results = build::build(jobs, &cache, threads, emit);
+
+    for result in &results {
+        let prefix = if jobs.len() > 1 { format!("{}: ", result.input) } else { String::new() };
+        for diagnostic in &result.diagnostics {
+            eprintln!("{}{}", prefix, diagnostic.display());
+        }
+    }
+    if args.verbose {
+        eprintln!("cache: {} hit, {} miss ({} threads)", cache.hits(), cache.misses(), threads);
+    }
+    Ok(results)
+}
+
+/// First error, once every module has reported
+fn finish(results: &[build::BuildResult]) -> Result<(), String> {
+    match results.iter().filter_map(|r| r.error.clone()).collect::<Vec<_>>().as_slice() {
+        [] => Ok(()),
+        [only] => Err(only.clone()),
+        [first, rest @ ..] => Err(format!("{} (and {} more)", first, rest.len())),
+    }
 }
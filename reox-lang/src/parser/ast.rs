@@ -3,7 +3,7 @@
 
 #![allow(dead_code)]
 
-use crate::lexer::Span;
+use crate::lexer::{Span, SpanShift};
 
 /// A complete program (list of declarations)
 #[derive(Debug, Clone)]
@@ -28,6 +28,7 @@ pub struct FnDecl {
     pub return_type: Option<Type>,
     pub body: Block,
     pub is_async: bool,
+    pub is_pub: bool,       // Visible to other translation units
     pub span: Span,
 }
 
@@ -301,3 +302,178 @@ pub enum Pattern {
     Wildcard,
 }
 
+
+// === Span Shifting ===
+// Declarations reused across an edit keep their nodes; only spans move
+
+impl Decl {
+    pub fn shift_spans(&mut self, shift: &SpanShift) {
+        match self {
+            Decl::Function(f) => {
+                shift.apply(&mut f.span);
+                shift_params(&mut f.params, shift);
+                f.body.shift_spans(shift);
+            }
+            Decl::Struct(s) => {
+                shift.apply(&mut s.span);
+                for field in &mut s.fields {
+                    shift.apply(&mut field.span);
+                }
+            }
+            Decl::Import(i) => shift.apply(&mut i.span),
+            Decl::Extern(e) => {
+                shift.apply(&mut e.span);
+                shift_params(&mut e.params, shift);
+            }
+        }
+    }
+}
+
+fn shift_params(params: &mut [Param], shift: &SpanShift) {
+    for param in params {
+        shift.apply(&mut param.span);
+    }
+}
+
+impl Block {
+    pub fn shift_spans(&mut self, shift: &SpanShift) {
+        shift.apply(&mut self.span);
+        for stmt in &mut self.statements {
+            stmt.shift_spans(shift);
+        }
+    }
+}
+
+impl Stmt {
+    pub fn shift_spans(&mut self, shift: &SpanShift) {
+        match self {
+            Stmt::Let(s) => {
+                shift.apply(&mut s.span);
+                if let Some(init) = &mut s.init {
+                    init.shift_spans(shift);
+                }
+            }
+            Stmt::Expr(e) => e.shift_spans(shift),
+            Stmt::Return(s) => {
+                shift.apply(&mut s.span);
+                if let Some(value) = &mut s.value {
+                    value.shift_spans(shift);
+                }
+            }
+            Stmt::If(s) => {
+                shift.apply(&mut s.span);
+                s.condition.shift_spans(shift);
+                s.then_block.shift_spans(shift);
+                if let Some(block) = &mut s.else_block {
+                    block.shift_spans(shift);
+                }
+            }
+            Stmt::While(s) => {
+                shift.apply(&mut s.span);
+                s.condition.shift_spans(shift);
+                s.body.shift_spans(shift);
+            }
+            Stmt::For(s) => {
+                shift.apply(&mut s.span);
+                s.iterable.shift_spans(shift);
+                s.body.shift_spans(shift);
+            }
+            Stmt::Block(b) => b.shift_spans(shift),
+            Stmt::Break(span) | Stmt::Continue(span) => shift.apply(span),
+            Stmt::Guard(s) => {
+                shift.apply(&mut s.span);
+                s.condition.shift_spans(shift);
+                s.else_block.shift_spans(shift);
+            }
+            Stmt::Defer(s) => {
+                shift.apply(&mut s.span);
+                s.body.shift_spans(shift);
+            }
+            Stmt::TryCatch(s) => {
+                shift.apply(&mut s.span);
+                s.try_block.shift_spans(shift);
+                s.catch_block.shift_spans(shift);
+            }
+            Stmt::Throw(s) => {
+                shift.apply(&mut s.span);
+                s.value.shift_spans(shift);
+            }
+        }
+    }
+}
+
+impl Expr {
+    pub fn shift_spans(&mut self, shift: &SpanShift) {
+        match self {
+            Expr::Literal(lit) => lit.shift_spans(shift),
+            Expr::Identifier(_, span) | Expr::Nil(span) => shift.apply(span),
+            Expr::Binary(l, _, r, span)
+            | Expr::Index(l, r, span)
+            | Expr::Assign(l, r, span)
+            | Expr::CompoundAssign(l, _, r, span)
+            | Expr::NullCoalesce(l, r, span)
+            | Expr::Range(l, r, span) => {
+                l.shift_spans(shift);
+                r.shift_spans(shift);
+                shift.apply(span);
+            }
+            Expr::Unary(_, e, span)
+            | Expr::Member(e, _, span)
+            | Expr::PreIncrement(e, span)
+            | Expr::PreDecrement(e, span)
+            | Expr::PostIncrement(e, span)
+            | Expr::PostDecrement(e, span)
+            | Expr::OptionalChain(e, _, span)
+            | Expr::Await(e, span) => {
+                e.shift_spans(shift);
+                shift.apply(span);
+            }
+            Expr::Call(callee, args, span) => {
+                callee.shift_spans(shift);
+                for arg in args {
+                    arg.shift_spans(shift);
+                }
+                shift.apply(span);
+            }
+            Expr::StructLit(_, fields, span) => {
+                for (_, value) in fields {
+                    value.shift_spans(shift);
+                }
+                shift.apply(span);
+            }
+            Expr::ArrayLit(items, span) => {
+                for item in items {
+                    item.shift_spans(shift);
+                }
+                shift.apply(span);
+            }
+            Expr::Match(subject, arms, span) => {
+                subject.shift_spans(shift);
+                for arm in arms {
+                    if let Pattern::Literal(lit) = &mut arm.pattern {
+                        lit.shift_spans(shift);
+                    }
+                    arm.body.shift_spans(shift);
+                    shift.apply(&mut arm.span);
+                }
+                shift.apply(span);
+            }
+            Expr::TrailingClosure(callee, block, span) => {
+                callee.shift_spans(shift);
+                block.shift_spans(shift);
+                shift.apply(span);
+            }
+        }
+    }
+}
+
+impl Literal {
+    pub fn shift_spans(&mut self, shift: &SpanShift) {
+        match self {
+            Literal::Int(_, span)
+            | Literal::Float(_, span)
+            | Literal::String(_, span)
+            | Literal::Bool(_, span) => shift.apply(span),
+        }
+    }
+}
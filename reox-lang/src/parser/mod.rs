@@ -6,7 +6,9 @@ mod ast;
 
 pub use ast::*;
 
-use crate::lexer::{Token, TokenKind, Span};
+use std::ops::Range;
+
+use crate::lexer::{Token, TokenKind, Span, TokenEdit};
 
 /// Parser error
 #[derive(Debug, Clone)]
@@ -102,6 +104,40 @@ impl<'a> Parser<'a> {
         Ok(Program { declarations })
     }
 
+    /// Parse one declaration; on error, skip to where the next one starts
+    fn parse_item(&mut self) -> Result<Decl, ParseError> {
+        let start = self.current;
+        match self.parse_declaration() {
+            Ok(decl) => Ok(decl),
+            Err(e) => {
+                self.synchronize(start);
+                Err(e)
+            }
+        }
+    }
+
+    /// Skip to a declaration keyword that follows a `}` or `;`
+    fn synchronize(&mut self, start: usize) {
+        if self.current == start {
+            self.advance();
+        }
+        while !self.is_at_end() {
+            let after_end = matches!(
+                self.tokens[self.current - 1].kind,
+                TokenKind::RBrace | TokenKind::Semicolon
+            );
+            let starts_decl = matches!(
+                self.peek_kind(),
+                TokenKind::Fn | TokenKind::Async | TokenKind::Pub
+                    | TokenKind::Struct | TokenKind::Import | TokenKind::Extern
+            );
+            if after_end && starts_decl {
+                return;
+            }
+            self.advance();
+        }
+    }
+
     fn parse_declaration(&mut self) -> Result<Decl, ParseError> {
         match self.peek_kind() {
             TokenKind::Fn => self.parse_fn_decl(false).map(Decl::Function),
@@ -116,6 +152,20 @@ impl<'a> Parser<'a> {
                     ))
                 }
             }
+            TokenKind::Pub => {
+                self.advance(); // consume 'pub'
+                let is_async = self.match_token(&[TokenKind::Async]);
+                if self.check(&TokenKind::Fn) {
+                    let mut f = self.parse_fn_decl(is_async)?;
+                    f.is_pub = true;
+                    Ok(Decl::Function(f))
+                } else {
+                    Err(ParseError::new(
+                        "expected 'fn' after 'pub'",
+                        self.peek().span,
+                    ))
+                }
+            }
             TokenKind::Struct => self.parse_struct_decl().map(Decl::Struct),
             TokenKind::Import => self.parse_import_decl().map(Decl::Import),
             TokenKind::Extern => self.parse_extern_decl().map(Decl::Extern),
@@ -150,6 +200,7 @@ impl<'a> Parser<'a> {
             return_type,
             body,
             is_async,
+            is_pub: false,
             span: start_span,
         })
     }
@@ -953,10 +1004,133 @@ pub fn parse(tokens: &[Token]) -> Ast {
     }
 }
 
+// === Incremental Parsing ===
+
+/// A parse that goes on past errors and remembers which tokens each
+/// declaration came from, so an edit re-parses only the declarations it
+/// touched. Declarations and error regions tile the tokens before EOF.
+#[derive(Debug, Clone)]
+pub struct ParsedFile {
+    pub program: Program,
+    pub errors: Vec<ParseError>,
+    pub reparsed: usize,                // Items parsed to produce this file
+    decl_tokens: Vec<Range<usize>>,     // Parallel to program.declarations
+    error_tokens: Vec<Range<usize>>,    // Parallel to errors
+}
+
+type Item = (Range<usize>, Result<Decl, ParseError>);
+
+impl ParsedFile {
+    fn new() -> Self {
+        Self {
+            program: Program { declarations: Vec::new() },
+            errors: Vec::new(),
+            reparsed: 0,
+            decl_tokens: Vec::new(),
+            error_tokens: Vec::new(),
+        }
+    }
+
+    fn push(&mut self, (tokens, item): Item) {
+        match item {
+            Ok(decl) => {
+                self.program.declarations.push(decl);
+                self.decl_tokens.push(tokens);
+            }
+            Err(e) => {
+                self.errors.push(e);
+                self.error_tokens.push(tokens);
+            }
+        }
+    }
+
+    /// Items in token order
+    fn into_items(self) -> Vec<Item> {
+        let mut decls = self.decl_tokens.into_iter().zip(self.program.declarations.into_iter().map(Ok)).peekable();
+        let mut errors = self.error_tokens.into_iter().zip(self.errors.into_iter().map(Err)).peekable();
+        let mut items = Vec::new();
+        loop {
+            let take_decl = match (decls.peek(), errors.peek()) {
+                (Some(d), Some(e)) => d.0.start < e.0.start,
+                (Some(_), None) => true,
+                (None, Some(_)) => false,
+                (None, None) => break,
+            };
+            items.extend(if take_decl { decls.next() } else { errors.next() });
+        }
+        items
+    }
+
+    /// Re-parse after the tokens changed by `edit` (from `lexer::relex`).
+    ///
+    /// Items that end before the edit are kept as they are, and items that
+    /// start after it are kept with their spans moved. Parsing starts at the
+    /// first item the edit touched and runs until it lands on the start of a
+    /// kept item; one it runs over (a deleted `}`) is parsed again.
+    pub fn reparse(self, tokens: &[Token], edit: &TokenEdit) -> ParsedFile {
+        let moved = |at: usize| (at as isize + edit.new_end as isize - edit.old_end as isize) as usize;
+
+        let mut before = Vec::new();
+        let mut after = Vec::new();
+        let mut start = edit.start;
+        for (range, item) in self.into_items() {
+            if range.end < edit.start {
+                before.push((range, item));
+            } else if range.start > edit.old_end {
+                after.push((range, item));
+            } else {
+                start = start.min(range.start);
+            }
+        }
+
+        let mut file = ParsedFile::new();
+        for item in before {
+            file.push(item);
+        }
+
+        let mut parser = Parser { tokens, current: start };
+        let mut after = after.into_iter().peekable();
+        loop {
+            while after.peek().map_or(false, |(r, _)| moved(r.start) < parser.current) {
+                after.next();
+            }
+            if parser.is_at_end() || after.peek().map_or(false, |(r, _)| moved(r.start) == parser.current) {
+                break;
+            }
+            let from = parser.current;
+            let item = parser.parse_item();
+            file.push((from..parser.current, item));
+            file.reparsed += 1;
+        }
+
+        for (range, mut item) in after {
+            match &mut item {
+                Ok(decl) => decl.shift_spans(&edit.shift),
+                Err(e) => edit.shift.apply(&mut e.span),
+            }
+            file.push((moved(range.start)..moved(range.end), item));
+        }
+        file
+    }
+}
+
+/// Parse tokens, recovering from errors at declaration boundaries
+pub fn parse_file(tokens: &[Token]) -> ParsedFile {
+    let mut parser = Parser::new(tokens);
+    let mut file = ParsedFile::new();
+    while !parser.is_at_end() {
+        let from = parser.current;
+        let item = parser.parse_item();
+        file.push((from..parser.current, item));
+        file.reparsed += 1;
+    }
+    file
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::lexer::tokenize;
+    use crate::lexer::{relex, tokenize, TextEdit};
 
     #[test]
     fn test_parse_simple_function() {
@@ -1318,4 +1492,68 @@ mod tests {
             _ => panic!("expected async function"),
         }
     }
+
+    const EDIT_SOURCE: &str = "struct Point { x: int, y: int }\n\nfn add(a: int, b: int) -> int {\n    return a + b;\n}\n\nfn main() {\n    let p = Point { x: 1, y: 2 };\n    print(add(p.x, 22));\n}\n";
+
+    fn reparse_source(source: &str, edit: TextEdit) -> (ParsedFile, ParsedFile) {
+        let tokens = tokenize(source).unwrap();
+        let relexed = relex(source, &tokens, &edit).unwrap();
+        let incremental = parse_file(&tokens).reparse(&relexed.tokens, &relexed.edit);
+        (incremental, parse_file(&relexed.tokens))
+    }
+
+    fn assert_same(incremental: &ParsedFile, full: &ParsedFile) {
+        assert_eq!(format!("{:?}", incremental.program), format!("{:?}", full.program));
+        assert_eq!(format!("{:?}", incremental.errors), format!("{:?}", full.errors));
+        assert_eq!(incremental.decl_tokens, full.decl_tokens);
+        assert_eq!(incremental.error_tokens, full.error_tokens);
+    }
+
+    #[test]
+    fn test_parse_file_recovers() {
+        let tokens = tokenize("fn a() { let = ; }\nfn b() { }\nstruct { }\nfn c() { }").unwrap();
+        let file = parse_file(&tokens);
+        assert_eq!(file.errors.len(), 2);
+        let names: Vec<_> = file.program.declarations.iter().filter_map(|d| match d {
+            Decl::Function(f) => Some(f.name.as_str()),
+            _ => None,
+        }).collect();
+        assert_eq!(names, ["b", "c"]);
+    }
+
+    #[test]
+    fn test_reparse_matches_parse() {
+        let len = EDIT_SOURCE.len();
+        let texts = ["", "x", "}", "{", ";", "\n", "fn f() { }\n", "let q = 1;"];
+        for start in 0..=len {
+            for end in start..=(start + 2).min(len) {
+                for text in texts {
+                    let edit = TextEdit::new(start, end, text);
+                    if tokenize(&edit.apply(EDIT_SOURCE)).is_err() {
+                        continue;
+                    }
+                    let (incremental, full) = reparse_source(EDIT_SOURCE, edit);
+                    assert_same(&incremental, &full);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_reparse_only_touched_decl() {
+        let at = EDIT_SOURCE.find("a + b").unwrap();
+        let (incremental, full) = reparse_source(EDIT_SOURCE, TextEdit::new(at, at + 1, "a * 2 +\n   "));
+        assert_same(&incremental, &full);
+        assert_eq!(incremental.reparsed, 1);
+        assert_eq!(full.reparsed, 3);
+    }
+
+    #[test]
+    fn test_reparse_deleted_brace() {
+        // Without the closing brace, `add` runs into `main`
+        let at = EDIT_SOURCE.find("}\n\nfn main").unwrap();
+        let (incremental, full) = reparse_source(EDIT_SOURCE, TextEdit::new(at, at + 1, ""));
+        assert_same(&incremental, &full);
+        assert!(!incremental.errors.is_empty());
+    }
 }
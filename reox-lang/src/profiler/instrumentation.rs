@@ -4,6 +4,7 @@
 #![allow(dead_code, unused_imports)]
 
 use crate::parser::{Ast, Decl, FnDecl};
+use std::collections::HashMap;
 
 /// Instrumentation mode
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -16,101 +17,48 @@ pub enum InstrumentMode {
     Full,
 }
 
-/// Generate instrumented C code with profiling hooks
+/// Generate instrumented C code with profiling hooks.
+/// Every instrumented function is a call site with a fixed index into the
+/// generated site table, so the runtime never looks a name up.
 pub struct Instrumentor {
     mode: InstrumentMode,
+    file: String,
+    sites: Vec<(String, u32)>,          // Name and line, by site index
+    site_index: HashMap<String, u32>,
 }
 
 impl Instrumentor {
     pub fn new(mode: InstrumentMode) -> Self {
-        Self { mode }
+        Self { mode, file: String::new(), sites: Vec::new(), site_index: HashMap::new() }
     }
 
-    /// Generate profiling header includes
+    /// Number the functions of `ast`, in declaration order
+    pub fn assign_sites(&mut self, ast: &Ast, file: &str) {
+        self.file = file.to_string();
+        for decl in &ast.declarations {
+            if let Decl::Function(f) = decl {
+                if !self.site_index.contains_key(&f.name) {
+                    self.site_index.insert(f.name.clone(), self.sites.len() as u32);
+                    self.sites.push((f.name.clone(), f.span.line));
+                }
+            }
+        }
+    }
+
+    /// Generate the profiler include and this file's site table
     pub fn emit_header(&self) -> String {
         if self.mode == InstrumentMode::None {
             return String::new();
         }
 
-        r#"
-// Profiling macros
-#ifndef RX_PROFILE_ENABLED
-#define RX_PROFILE_ENABLED 1
-#endif
-
-#if RX_PROFILE_ENABLED
-#include <time.h>
-#include <stdio.h>
-
-typedef struct {
-    const char* name;
-    clock_t start;
-    unsigned long calls;
-    double total_ms;
-} rx_profile_entry;
-
-#define RX_MAX_PROFILE_ENTRIES 256
-static rx_profile_entry rx_profile_data[RX_MAX_PROFILE_ENTRIES];
-static int rx_profile_count = 0;
-
-static inline int rx_profile_find(const char* name) {
-    for (int i = 0; i < rx_profile_count; i++) {
-        if (rx_profile_data[i].name == name) return i;
-    }
-    if (rx_profile_count < RX_MAX_PROFILE_ENTRIES) {
-        rx_profile_data[rx_profile_count].name = name;
-        rx_profile_data[rx_profile_count].calls = 0;
-        rx_profile_data[rx_profile_count].total_ms = 0;
-        return rx_profile_count++;
-    }
-    return -1;
-}
-
-#define RX_PROFILE_ENTER(name) \
-    static const char* _rx_fn_name = name; \
-    clock_t _rx_start = clock();
-
-#define RX_PROFILE_EXIT() \
-    do { \
-        clock_t _rx_end = clock(); \
-        int _rx_idx = rx_profile_find(_rx_fn_name); \
-        if (_rx_idx >= 0) { \
-            rx_profile_data[_rx_idx].calls++; \
-            rx_profile_data[_rx_idx].total_ms += \
-                1000.0 * (_rx_end - _rx_start) / CLOCKS_PER_SEC; \
-        } \
-    } while(0)
-
-static void rx_profile_report(void) {
-    fprintf(stderr, "\n=== REOX Profile Report ===\n");
-    fprintf(stderr, "%-30s %10s %12s %12s\n", 
-            "Function", "Calls", "Total (ms)", "Avg (ms)");
-    fprintf(stderr, "%-30s %10s %12s %12s\n",
-            "--------", "-----", "----------", "--------");
-    for (int i = 0; i < rx_profile_count; i++) {
-        double avg = rx_profile_data[i].calls > 0 
-            ? rx_profile_data[i].total_ms / rx_profile_data[i].calls 
-            : 0;
-        fprintf(stderr, "%-30s %10lu %12.3f %12.6f\n",
-                rx_profile_data[i].name,
-                rx_profile_data[i].calls,
-                rx_profile_data[i].total_ms,
-                avg);
-    }
-    fprintf(stderr, "===========================\n");
-}
-
-// Auto-report at exit
-__attribute__((destructor))
-static void rx_profile_cleanup(void) {
-    rx_profile_report();
-}
-
-#else
-#define RX_PROFILE_ENTER(name)
-#define RX_PROFILE_EXIT()
-#endif
-"#.to_string()
+        let mut out = String::from("\n// Profiling (see reox_profile.h)\n#include \"reox_profile.h\"\n");
+        if !self.sites.is_empty() {
+            let entries: Vec<String> = self.sites.iter()
+                .map(|(name, line)| format!("    {{\"{}\", \"{}\", {}}}", name, c_escape(&self.file), line))
+                .collect();
+            out.push_str(&format!("RX_PROFILE_SITES(\n{}\n)\n", entries.join(",\n")));
+        }
+        out
     }
 
     /// Instrument a function with profiling hooks
@@ -118,14 +66,21 @@ static void rx_profile_cleanup(void) {
         if self.mode == InstrumentMode::None {
             return (String::new(), String::new());
         }
+        let Some(site) = self.site_index.get(&fn_decl.name) else {
+            return (String::new(), String::new());
+        };
 
-        let enter = format!("RX_PROFILE_ENTER(\"{}\");", fn_decl.name);
-        let exit = "RX_PROFILE_EXIT();".to_string();
+        let enter = format!("RX_PROFILE_ENTER({});", site);
+        let exit = format!("RX_PROFILE_EXIT({});", site);
 
         (enter, exit)
     }
 }
 
+fn c_escape(s: &str) -> String {
+    s.replace('\\', "\\\\").replace('"', "\\\"")
+}
+
 /// Instrumentation options for code generation
 #[derive(Debug, Clone)]
 pub struct InstrumentOptions {
@@ -143,3 +98,34 @@ impl Default for InstrumentOptions {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::lexer::tokenize;
+    use crate::parser::parse;
+
+    #[test]
+    fn test_sites_are_indexed() {
+        let source = r#"
+            fn fib(n: int) -> int {
+                return n;
+            }
+            fn main() {
+                fib(3);
+            }
+        "#;
+        let ast = parse(&tokenize(source).unwrap());
+        let mut inst = Instrumentor::new(InstrumentMode::Functions);
+        inst.assign_sites(&ast, "fib.rx");
+
+        let header = inst.emit_header();
+        assert!(header.contains("#include \"reox_profile.h\""));
+        assert!(header.contains("{\"fib\", \"fib.rx\", 2},\n    {\"main\", \"fib.rx\", 5}"));
+
+        let Decl::Function(main) = &ast.declarations[1] else { panic!() };
+        let (enter, exit) = inst.instrument_function(main);
+        assert_eq!(enter, "RX_PROFILE_ENTER(1);");
+        assert_eq!(exit, "RX_PROFILE_EXIT(1);");
+    }
+}
@@ -8,7 +8,7 @@ mod reporter;
 pub use instrumentation::*;
 pub use reporter::*;
 
-use std::collections::HashMap;
+use std::collections::{HashMap, VecDeque};
 use std::time::{Duration, Instant};
 
 /// Profiler configuration
@@ -22,6 +22,8 @@ pub struct ProfilerConfig {
     pub sample_rate: u32,
     /// Output format
     pub output_format: OutputFormat,
+    /// Most recent calls kept for trace output (0 = none)
+    pub trace_capacity: usize,
 }
 
 impl Default for ProfilerConfig {
@@ -31,6 +33,7 @@ impl Default for ProfilerConfig {
             trace_memory: false,
             sample_rate: 1,
             output_format: OutputFormat::Text,
+            trace_capacity: 65536,
         }
     }
 }
@@ -41,6 +44,8 @@ pub enum OutputFormat {
     Text,
     Json,
     Flamegraph,
+    /// Chrome trace / Perfetto JSON
+    ChromeTrace,
 }
 
 /// A single profiling event
@@ -53,6 +58,15 @@ pub struct ProfileEvent {
     pub children: Vec<String>,
 }
 
+/// One completed call, for trace output
+#[derive(Debug, Clone)]
+pub struct TraceEvent {
+    pub name: String,
+    /// Since the profiler started
+    pub start: Duration,
+    pub duration: Duration,
+}
+
 /// Function statistics
 #[derive(Debug, Clone, Default)]
 pub struct FunctionStats {
@@ -93,6 +107,7 @@ pub struct Profiler {
     config: ProfilerConfig,
     functions: HashMap<String, FunctionStats>,
     call_stack: Vec<(String, Instant)>,
+    events: VecDeque<TraceEvent>,  // Ring of the last trace_capacity calls
     start_time: Instant,
     total_allocations: u64,
     total_bytes_allocated: u64,
@@ -104,6 +119,7 @@ impl Profiler {
             config,
             functions: HashMap::new(),
             call_stack: Vec::new(),
+            events: VecDeque::new(),
             start_time: Instant::now(),
             total_allocations: 0,
             total_bytes_allocated: 0,
@@ -126,10 +142,21 @@ impl Profiler {
         
         if let Some((name, start)) = self.call_stack.pop() {
             let duration = start.elapsed();
+
+            if self.config.trace_capacity > 0 {
+                if self.events.len() == self.config.trace_capacity {
+                    self.events.pop_front();
+                }
+                self.events.push_back(TraceEvent {
+                    name: name.clone(),
+                    start: start - self.start_time,
+                    duration,
+                });
+            }
             
             let stats = self.functions
                 .entry(name)
-                .or_insert_with(|| FunctionStats::new(""));
+                .or_insert_with_key(|name| FunctionStats::new(name));
             stats.record(duration);
         }
     }
@@ -153,6 +180,7 @@ impl Profiler {
             functions,
             total_allocations: self.total_allocations,
             total_bytes_allocated: self.total_bytes_allocated,
+            events: self.events.iter().cloned().collect(),
         }
     }
 }
@@ -164,4 +192,6 @@ pub struct ProfilingSummary {
     pub functions: Vec<FunctionStats>,
     pub total_allocations: u64,
     pub total_bytes_allocated: u64,
+    /// Most recent calls, oldest first
+    pub events: Vec<TraceEvent>,
 }
@@ -3,7 +3,7 @@
 
 #![allow(dead_code, unused_imports)]
 
-use super::{ProfilingSummary, FunctionStats, OutputFormat};
+use super::{ProfilingSummary, FunctionStats, OutputFormat, TraceEvent};
 use std::fmt::Write;
 
 /// Generate a text report
@@ -93,15 +93,38 @@ pub fn generate_flamegraph_output(summary: &ProfilingSummary) -> String {
     output
 }
 
+/// Generate a Chrome trace / Perfetto JSON file (chrome://tracing, ui.perfetto.dev)
+pub fn generate_chrome_trace(summary: &ProfilingSummary) -> String {
+    let mut output = String::new();
+
+    writeln!(output, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[").unwrap();
+    for (i, event) in summary.events.iter().enumerate() {
+        let comma = if i + 1 < summary.events.len() { "," } else { "" };
+        writeln!(output, "{{\"name\":\"{}\",\"cat\":\"reox\",\"ph\":\"X\",\"ts\":{:.3},\"dur\":{:.3},\"pid\":1,\"tid\":1}}{}",
+                 json_escape(&event.name),
+                 event.start.as_secs_f64() * 1_000_000.0,
+                 event.duration.as_secs_f64() * 1_000_000.0,
+                 comma).unwrap();
+    }
+    writeln!(output, "]}}").unwrap();
+
+    output
+}
+
 /// Format report based on output format
 pub fn format_report(summary: &ProfilingSummary, format: OutputFormat) -> String {
     match format {
         OutputFormat::Text => generate_text_report(summary),
         OutputFormat::Json => generate_json_report(summary),
         OutputFormat::Flamegraph => generate_flamegraph_output(summary),
+        OutputFormat::ChromeTrace => generate_chrome_trace(summary),
     }
 }
 
+fn json_escape(s: &str) -> String {
+    s.replace('\\', "\\\\").replace('"', "\\\"")
+}
+
 fn truncate(s: &str, max_len: usize) -> String {
     if s.len() <= max_len {
         s.to_string()
@@ -132,10 +155,31 @@ mod tests {
             ],
             total_allocations: 10,
             total_bytes_allocated: 1024,
+            events: Vec::new(),
         };
 
         let report = generate_text_report(&summary);
         assert!(report.contains("main"));
         assert!(report.contains("100.000"));
     }
+
+    #[test]
+    fn test_chrome_trace() {
+        let summary = ProfilingSummary {
+            total_time: Duration::from_millis(3),
+            functions: Vec::new(),
+            total_allocations: 0,
+            total_bytes_allocated: 0,
+            events: vec![
+                TraceEvent { name: "fib".to_string(), start: Duration::from_micros(10), duration: Duration::from_micros(5) },
+                TraceEvent { name: "main".to_string(), start: Duration::ZERO, duration: Duration::from_micros(20) },
+            ],
+        };
+
+        let trace = generate_chrome_trace(&summary);
+        assert!(trace.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        assert!(trace.contains("{\"name\":\"fib\",\"cat\":\"reox\",\"ph\":\"X\",\"ts\":10.000,\"dur\":5.000,\"pid\":1,\"tid\":1},"));
+        assert!(trace.contains("\"name\":\"main\""));
+        assert!(trace.trim_end().ends_with("]}"));
+    }
 }
@@ -18,10 +18,18 @@ int64_t my_print(int64_t msg_ptr) {
     return 0;
 }
 
+/* Mixed integer and floating-point arguments */
+double my_mix(int64_t a, double b, float c, int64_t d) {
+    return (double)a + b * (double)c + (double)d;
+}
+
 /* Register C functions */
 static RxFFIFunc c_functions[] = {
     {"my_add", (void*)my_add, "ii->i"},
     {"my_print", (void*)my_print, "s->v"},
+    {"my_mix", (void*)my_mix, "idfi->d"},
+    /* More arguments than fit in registers: must be rejected, not parsed */
+    {"my_long", (void*)my_add, "iiiiiiiiddddddddddddddddi->i"},
 };
 
 int main(int argc, char* argv[]) {
@@ -30,8 +38,8 @@ int main(int argc, char* argv[]) {
     printf("=== REOX Hybrid FFI Test ===\n\n");
     
     /* Register C functions */
-    rx_ffi_register(c_functions, 2);
-    printf("Registered %d C functions for REOX\n", 2);
+    rx_ffi_register(c_functions, 4);
+    printf("Registered %d C functions for REOX\n", 4);
     
     /* Test calling FFI functions */
     int64_t args[] = {10, 32};
@@ -41,7 +49,31 @@ int main(int argc, char* argv[]) {
     /* Print message */
     int64_t msg_args[] = {(int64_t)(uintptr_t)"Hello from REOX!"};
     rx_ffi_call("my_print", msg_args, 1);
+
+    /* Resolve once, then call with typed arguments */
+    static RxFFIHandle mix;
+    RxFFIValue mix_args[4];
+    mix_args[0].i = 1;
+    mix_args[1].d = 2.5;
+    mix_args[2].f = 4.0f;
+    mix_args[3].i = 3;
+    RxFFIValue mix_ret;
+    if (rx_ffi_invoke(rx_ffi_cached(&mix, "my_mix"), mix_args, 4, &mix_ret)) {
+        printf("my_mix(1, 2.5, 4.0, 3) = %g\n", mix_ret.d);
+    } else {
+        printf("my_mix: typed calls unsupported on this platform\n");
+    }
     
+    /* Over-long signature: registered, but never callable */
+    int64_t long_args[RX_FFI_MAX_ARGS] = {0};
+    RxFFIValue long_ret;
+    if (rx_ffi_invoke(rx_ffi_resolve("my_long"), NULL, 0, &long_ret) ||
+        rx_ffi_call("my_long", long_args, RX_FFI_MAX_ARGS) != 0) {
+        printf("my_long: over-long signature was accepted\n");
+        return 1;
+    }
+    printf("my_long: over-long signature rejected\n");
+
     /* Test app with null backend */
     printf("\nCreating app with null backend...\n");
     RxApp* app = rx_app_create("Test App", 800, 600, &rx_backend_null);